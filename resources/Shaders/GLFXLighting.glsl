@@ -22,13 +22,29 @@ struct VSOutput1
 /* Vertex shader */
 /*****************/
 
-uniform mat4 uWVP;
+// Shared by all the programs, the layout must match PackedCamera::Block
+layout (std140, row_major) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 eyePosition;
+    vec4 frustumPlanes[6];
+    vec4 viewport;
+    float time;
+} uCamera;
+
 uniform mat4 uWorld;
 
 shader VSmain(in vec3 pPosition, in vec2 pTexCoords, in vec3 pNormal, out VSOutput pVSOutput)
 {
-    gl_Position = uWVP * vec4(pPosition, 1.0f);
-    pVSOutput.worldPosition = (uWorld * vec4(pPosition, 1.0f)).xyz;
+    vec4 lWorldPosition = uWorld * vec4(pPosition, 1.0f);
+
+    gl_Position = uCamera.viewProjection * lWorldPosition;
+    pVSOutput.worldPosition = lWorldPosition.xyz;
     pVSOutput.textureCoords = pTexCoords;
     pVSOutput.normal = (uWorld * vec4(pNormal, 0.0f)).xyz;
 }
@@ -74,14 +90,18 @@ struct SpotLight
     float cutoff; /* directly the cosine of the angle!!! */
 };
 
-uniform PointLight uPointLight[maxPointLights];
-uniform SpotLight uSpotLight[maxSpotLights];
-uniform int uPointLightCount;
-uniform int uSpotLightCount;
-uniform DirectionalLight uDirectionalLight;
+// Shared by all the lighting programs, the layout must match PackedLights::Block
+layout (std140) uniform LightBlock
+{
+    DirectionalLight uDirectionalLight;
+    PointLight uPointLight[maxPointLights];
+    SpotLight uSpotLight[maxSpotLights];
+    int uPointLightCount;
+    int uSpotLightCount;
+};
+
 uniform sampler2D uSampler;
 uniform int uUseSampler;
-uniform vec3 uEyeWorldPos;
 uniform float uMaterialSpecularIntensity;
 uniform float uMaterialSpecularPower;
 uniform vec4 uColor;
@@ -98,7 +118,7 @@ vec4 calcLightInternal(BaseLight pLight, vec3 pLightDirection, VSOutput1 pFSInpu
     {
         lDiffuseColor = vec4(pLight.color, 1.0f) * pLight.diffuseIntensity * lDiffuseFactor;
 
-        vec3 lVertexToEye = normalize(uEyeWorldPos - pFSInput.worldPosition);
+        vec3 lVertexToEye = normalize(uCamera.eyePosition.xyz - pFSInput.worldPosition);
         vec3 lReflectedLight = reflect(pLightDirection, pFSInput.normal);
         lReflectedLight = normalize(lReflectedLight);
         float lSpecularFactor = dot(lVertexToEye, lReflectedLight);
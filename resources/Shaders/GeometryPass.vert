@@ -3,9 +3,12 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 textureCoords;
 layout (location = 2) in vec3 normal;
+layout (location = 4) in mat4 instanceWVP;
+layout (location = 8) in mat4 instanceWorld;
 
 uniform mat4 uWVP;
 uniform mat4 uWorld;
+uniform bool uInstanced;
 
 out vec2 texCoord0;
 out vec3 normal0;
@@ -13,8 +16,11 @@ out vec3 worldPos0;
 
 void main()
 {
-    gl_Position = uWVP * vec4(position, 1.0);
+    mat4 lWVP = uInstanced ? instanceWVP : uWVP;
+    mat4 lWorld = uInstanced ? instanceWorld : uWorld;
+
+    gl_Position = lWVP * vec4(position, 1.0);
     texCoord0 = textureCoords;
-    normal0 = (uWorld * vec4(normal, 0.0)).xyz;
-    worldPos0 = (uWorld * vec4(position, 1.0)).xyz;
+    normal0 = (lWorld * vec4(normal, 0.0)).xyz;
+    worldPos0 = (lWorld * vec4(position, 1.0)).xyz;
 }
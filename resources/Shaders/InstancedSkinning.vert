@@ -0,0 +1,79 @@
+#version 330
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 textureCoords;
+layout (location = 2) in vec3 normal;
+layout (location = 3) in vec3 tangent;
+layout (location = 4) in mat4 wvp;
+layout (location = 8) in mat4 world;
+layout (location = 12) in uvec4 boneData0;
+layout (location = 13) in uvec4 boneData1;
+layout (location = 14) in vec4 animation; /* first frame, frame count, frames per second, frame offset */
+
+uniform mat4 uLightWVP;
+
+// Baked frames of all the clips, one row per frame and 3 RGBA32F texels per bone
+uniform sampler2D uBakedAnimation;
+uniform float uTime;
+
+out vec4 lightSpacePos;
+out vec2 texCoord0;
+out vec3 normal0;
+out vec3 worldPos0;
+out vec3 tangent0;
+flat out int instanceID;
+
+// Packed bones of the vertex (see PackedBoneData): uBoneInfluences IDs followed by uBoneInfluences unsigned normalized
+// weights, each value uses uBoneIndexBits bits starting with the lowest bits of each word
+uniform int uBoneInfluences;
+uniform int uBoneIndexBits;
+
+uint boneField(int pIndex)
+{
+    int lPerWord = 32 / uBoneIndexBits;
+    int lWord = pIndex / lPerWord;
+    uint lBits = lWord < 4 ? boneData0[lWord] : boneData1[lWord - 4];
+
+    return (lBits >> uint((pIndex % lPerWord) * uBoneIndexBits)) & ((1u << uint(uBoneIndexBits)) - 1u);
+}
+
+mat4 bone(int pFrame, int pBone)
+{
+    int lTexel = pBone * 3;
+
+    return transpose(mat4(texelFetch(uBakedAnimation, ivec2(lTexel, pFrame), 0),
+                          texelFetch(uBakedAnimation, ivec2(lTexel + 1, pFrame), 0),
+                          texelFetch(uBakedAnimation, ivec2(lTexel + 2, pFrame), 0),
+                          vec4(0.0, 0.0, 0.0, 1.0)));
+}
+
+mat4 skin(int pFrame)
+{
+    float lMaxWeight = float((1 << uBoneIndexBits) - 1);
+    mat4 lBoneTransform = mat4(0.0);
+
+    for (int i = 0; i < uBoneInfluences; ++i)
+        lBoneTransform += bone(pFrame, int(boneField(i))) * (float(boneField(uBoneInfluences + i)) / lMaxWeight);
+
+    return lBoneTransform;
+}
+
+void main()
+{
+    // Loop over the intervals between the frames of the clip and interpolate the two closest frames
+    float lFrame = mod(uTime * animation.z + animation.w, animation.y - 1.0);
+    float lFrame0 = floor(lFrame);
+    int lFirstFrame = int(animation.x);
+
+    mat4 lBoneTransform = mix(skin(lFirstFrame + int(lFrame0)), skin(lFirstFrame + int(lFrame0) + 1), lFrame - lFrame0);
+
+    vec4 lPos = lBoneTransform * vec4(position, 1.0);
+    gl_Position = wvp * lPos;
+    lightSpacePos = uLightWVP * lPos;
+
+    texCoord0 = textureCoords;
+    normal0 = (world * (lBoneTransform * vec4(normal, 0.0))).xyz;
+    worldPos0 = (world * lPos).xyz;
+    tangent0 = (world * (lBoneTransform * vec4(tangent, 0.0))).xyz;
+    instanceID = gl_InstanceID;
+}
@@ -5,7 +5,21 @@ layout (location = 1) in vec2 textureCoords;
 layout (location = 2) in vec3 normal;
 layout (location = 3) in vec3 tangent;
 
-uniform mat4 uWVP;
+// Shared by all the programs, the layout must match PackedCamera::Block
+layout (std140, row_major) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 eyePosition;
+    vec4 frustumPlanes[6];
+    vec4 viewport;
+    float time;
+} uCamera;
+
 uniform mat4 uLightWVP;
 uniform mat4 uWorld;
 
@@ -17,10 +31,12 @@ out vec3 tangent0;
 
 void main()
 {
-    gl_Position = uWVP * vec4(position, 1.0);
+    vec4 lWorldPos = uWorld * vec4(position, 1.0);
+
+    gl_Position = uCamera.viewProjection * lWorldPos;
     lightSpacePos = uLightWVP * vec4(position, 1.0);
     texCoord0 = textureCoords;
     normal0 = (uWorld * vec4(normal, 0.0)).xyz;
     tangent0 = (uWorld * vec4(tangent, 0.0)).xyz;
-    worldPos0 = (uWorld * vec4(position, 1.0)).xyz;
+    worldPos0 = lWorldPos.xyz;
 }
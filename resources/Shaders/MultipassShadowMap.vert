@@ -3,15 +3,21 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 texCoord;
 layout (location = 2) in vec3 normal;
+layout (location = 4) in mat4 instanceWVP;
+layout (location = 8) in mat4 instanceWorld;
 
 uniform mat4 uWVP;
 uniform mat4 uWorld;
+uniform bool uInstanced;
 
 out vec3 worldPos0;
 
 void main()
 {
+    mat4 lWVP = uInstanced ? instanceWVP : uWVP;
+    mat4 lWorld = uInstanced ? instanceWorld : uWorld;
+
     vec4 lPos = vec4(position, 1.0f);
-    gl_Position = uWVP * lPos;
-    worldPos0 = (uWorld * lPos).xyz;
+    gl_Position = lWVP * lPos;
+    worldPos0 = (lWorld * lPos).xyz;
 }
@@ -1,10 +1,13 @@
 #version 330
 
 layout (location = 0) in vec3 position;
+layout (location = 4) in mat4 instanceWVP;
 
 uniform mat4 uWVP;
+uniform bool uInstanced;
 
 void main()
 {
-    gl_Position = uWVP * vec4(position, 1.0f);
+    mat4 lWVP = uInstanced ? instanceWVP : uWVP;
+    gl_Position = lWVP * vec4(position, 1.0f);
 }
@@ -49,16 +49,35 @@ struct SpotLight
     float cutoff; /* directly the cosine of the angle!!! */
 };
 
+// Shared by all the programs, the layout must match PackedCamera::Block
+layout (std140, row_major) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 eyePosition;
+    vec4 frustumPlanes[6];
+    vec4 viewport;
+    float time;
+} uCamera;
+
 uniform int uShaderType;
-uniform PointLight uPointLight[maxPointLights];
-uniform SpotLight uSpotLight[maxSpotLights];
-uniform int uPointLightCount;
-uniform int uSpotLightCount;
-uniform DirectionalLight uDirectionalLight;
+// Shared by all the lighting programs, the layout must match PackedLights::Block
+layout (std140) uniform LightBlock
+{
+    DirectionalLight uDirectionalLight;
+    PointLight uPointLight[maxPointLights];
+    SpotLight uSpotLight[maxSpotLights];
+    int uPointLightCount;
+    int uSpotLightCount;
+};
+
 uniform sampler2D uSampler;
 uniform int uUseSampler;
 uniform sampler2D uAOMap;
-uniform vec3 uEyeWorldPos;
 uniform float uMaterialSpecularIntensity;
 uniform float uMaterialSpecularPower;
 uniform vec2 uScreenSize;
@@ -84,7 +103,7 @@ vec4 calcLightInternal(BaseLight pLight, vec3 pLightDirection, vec3 pNormal)
     {
         lDiffuseColor = vec4(pLight.color, 1.0f) * pLight.diffuseIntensity * lDiffuseFactor;
 
-        vec3 lVertexToEye = normalize(uEyeWorldPos - worldPos0);
+        vec3 lVertexToEye = normalize(uCamera.eyePosition.xyz - worldPos0);
         vec3 lReflectedLight = reflect(pLightDirection,pNormal);
         lReflectedLight = normalize(lReflectedLight);
         float lSpecularFactor = dot(lVertexToEye, lReflectedLight);
@@ -4,7 +4,21 @@ layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 textureCoords;
 layout (location = 2) in vec3 normal;
 
-uniform mat4 uWVP;
+// Shared by all the programs, the layout must match PackedCamera::Block
+layout (std140, row_major) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 eyePosition;
+    vec4 frustumPlanes[6];
+    vec4 viewport;
+    float time;
+} uCamera;
+
 uniform mat4 uWorld;
 
 out vec2 texCoord0;
@@ -13,8 +27,10 @@ out vec3 worldPos0;
 
 void main()
 {
-    gl_Position = uWVP * vec4(position, 1.0f);
+    vec4 lWorldPos = uWorld * vec4(position, 1.0f);
+
+    gl_Position = uCamera.viewProjection * lWorldPos;
     texCoord0 = textureCoords;
     normal0 = (uWorld * vec4(normal, 0.0f)).xyz;
-    worldPos0 = (uWorld * vec4(position, 1.0f)).xyz;
+    worldPos0 = lWorldPos.xyz;
 }
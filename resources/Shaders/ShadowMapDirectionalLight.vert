@@ -3,10 +3,13 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 texCoord;
 layout (location = 2) in vec3 normal;
+layout (location = 4) in mat4 instanceWVP;
 
 uniform mat4 uWVP;
+uniform bool uInstanced;
 
 void main()
 {
-    gl_Position = uWVP * vec4(position, 1.0);
+    mat4 lWVP = uInstanced ? instanceWVP : uWVP;
+    gl_Position = lWVP * vec4(position, 1.0);
 }
@@ -3,10 +3,13 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 textureCoords;
 layout (location = 2) in vec3 normal;
+layout (location = 4) in mat4 instanceWVP;
+layout (location = 8) in mat4 instanceWorld;
 
 uniform mat4 uWVP;
 uniform mat4 uLightWVP;
 uniform mat4 uWorld;
+uniform bool uInstanced;
 
 out vec4 lightSpacePos0;
 out vec2 texCoord0;
@@ -15,10 +18,13 @@ out vec3 worldPos0;
 
 void main()
 {
+    mat4 lWVP = uInstanced ? instanceWVP : uWVP;
+    mat4 lWorld = uInstanced ? instanceWorld : uWorld;
+
     vec4 lPosition = vec4(position, 1.0);
-    gl_Position = uWVP * lPosition;
+    gl_Position = lWVP * lPosition;
     lightSpacePos0 = uLightWVP * lPosition;
     texCoord0 = textureCoords;
-    normal0 = (uWorld * vec4(normal, 0.0)).xyz;
-    worldPos0 = (uWorld * lPosition).xyz;
+    normal0 = (lWorld * vec4(normal, 0.0)).xyz;
+    worldPos0 = (lWorld * lPosition).xyz;
 }
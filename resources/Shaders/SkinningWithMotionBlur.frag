@@ -45,18 +45,51 @@ struct SpotLight
     float cutoff; /* directly the cosine of the angle!!! */
 };
 
-uniform PointLight uPointLight[maxPointLights];
-uniform SpotLight uSpotLight[maxSpotLights];
-uniform int uPointLightCount;
-uniform int uSpotLightCount;
-uniform DirectionalLight uDirectionalLight;
+// Shared by all the lighting programs, the layout must match PackedLights::Block
+layout (std140) uniform LightBlock
+{
+    DirectionalLight uDirectionalLight;
+    PointLight uPointLight[maxPointLights];
+    SpotLight uSpotLight[maxSpotLights];
+    int uPointLightCount;
+    int uSpotLightCount;
+};
+
+// Shared by all the programs, the layout must match PackedCamera::Block
+layout (std140, row_major) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 eyePosition;
+    vec4 frustumPlanes[6];
+    vec4 viewport;
+    float time;
+} uCamera;
+
+// Shared by the clustered lighting programs, the layout must match ClusteredLightBuffer::Block
+layout (std140) uniform ClusterBlock
+{
+    ivec4 gridSize;         // Number of clusters along x, y and z, w is the number of lights
+    vec4 depthSlicing;      // The slice of a view depth d is log(d) * x + y
+    ivec4 firstTexels;      // First texel of the lights and first item of the frame
+} uClusters;
+
+// 4 texels per light, see LightClusters::LightData
+uniform samplerBuffer uClusterLights;
+
+// Index of the first light index and number of lights of each cluster, followed by the light indices
+uniform usamplerBuffer uClusterItems;
+
 uniform sampler2D uSampler;
 uniform int uUseSampler;
 uniform sampler2D uShadowMap;
 uniform int uUseShadowMap;
 uniform sampler2D uNormalMap;
 uniform int uUseNormalMap;
-uniform vec3 uEyeWorldPos;
 uniform float uMaterialSpecularIntensity;
 uniform float uMaterialSpecularPower;
 
@@ -77,6 +110,33 @@ float calcShadowFactor(vec4 pLightSpacePos)
         return 1.0f;
 }
 
+int clusterIndex(vec3 pWorldPos)
+{
+    float lDepth = (uCamera.view * vec4(pWorldPos, 1.0f)).z;
+    int lSlice = clamp(int(log(max(lDepth, 1.0e-4f)) * uClusters.depthSlicing.x + uClusters.depthSlicing.y), 0, uClusters.gridSize.z - 1);
+    ivec2 lTile = clamp(ivec2(gl_FragCoord.xy / uCamera.viewport.zw * vec2(uClusters.gridSize.xy)), ivec2(0), uClusters.gridSize.xy - 1);
+
+    return (lSlice * uClusters.gridSize.y + lTile.y) * uClusters.gridSize.x + lTile.x;
+}
+
+SpotLight clusterLight(int pLight)
+{
+    int lTexel = uClusters.firstTexels.x + 4 * pLight;
+    vec4 lColor = texelFetch(uClusterLights, lTexel);
+    vec4 lPosition = texelFetch(uClusterLights, lTexel + 1);
+    vec4 lAttenuation = texelFetch(uClusterLights, lTexel + 2);
+    vec4 lDirection = texelFetch(uClusterLights, lTexel + 3);
+
+    SpotLight lLight;
+    lLight.basepl.base = BaseLight(lColor.rgb, lColor.a, lPosition.w);
+    lLight.basepl.attenuation = Attenuation(lAttenuation.x, lAttenuation.y, lAttenuation.z);
+    lLight.basepl.position = lPosition.xyz;
+    lLight.direction = lDirection.xyz;
+    lLight.cutoff = lAttenuation.w; /* -2 for a point light */
+
+    return lLight;
+}
+
 vec4 calcLightInternal(BaseLight pLight, vec3 pLightDirection, vec3 pNormal, float pShadowFactor)
 {
     vec4 lAmbientColor = vec4(pLight.color, 1.0f) * pLight.ambientIntensity;
@@ -89,7 +149,7 @@ vec4 calcLightInternal(BaseLight pLight, vec3 pLightDirection, vec3 pNormal, flo
     {
         lDiffuseColor = vec4(pLight.color, 1.0f) * pLight.diffuseIntensity * lDiffuseFactor;
 
-        vec3 lVertexToEye = normalize(uEyeWorldPos - worldPos0);
+        vec3 lVertexToEye = normalize(uCamera.eyePosition.xyz - worldPos0);
         vec3 lReflectedLight = reflect(pLightDirection,pNormal);
         lReflectedLight = normalize(lReflectedLight);
         float lSpecularFactor = dot(lVertexToEye, lReflectedLight);
@@ -172,14 +232,19 @@ void main(void)
 
     vec4 lTotalLight = calcDirectionalLight(lNormal);
 
-    for(int i = 0; i < uPointLightCount; i++)
-    {
-        lTotalLight += calcPointLight(uPointLight[i], lNormal, lightSpacePos);
-    }
+    // Only the point and spot lights reaching the cluster of the fragment
+    int lItem = uClusters.firstTexels.y + 2 * clusterIndex(worldPos0);
+    int lFirst = uClusters.firstTexels.y + int(texelFetch(uClusterItems, lItem).r);
+    int lCount = int(texelFetch(uClusterItems, lItem + 1).r);
 
-    for(int i = 0; i < uSpotLightCount; i++)
+    for(int i = 0; i < lCount; i++)
     {
-        lTotalLight += calcSpotLight(uSpotLight[i], lNormal, lightSpacePos);
+        SpotLight lLight = clusterLight(int(texelFetch(uClusterItems, lFirst + i).r));
+
+        if (lLight.cutoff < -1.0f)
+            lTotalLight += calcPointLight(lLight.basepl, lNormal, lightSpacePos);
+        else
+            lTotalLight += calcSpotLight(lLight, lNormal, lightSpacePos);
     }
 
     vec4 lSampledColor = vec4(1.0f, 1.0f, 1.0f, 1.0f);
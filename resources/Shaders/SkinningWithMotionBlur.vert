@@ -4,18 +4,38 @@ layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 textureCoords;
 layout (location = 2) in vec3 normal;
 layout (location = 3) in vec3 tangent;
-layout (location = 12) in ivec4 boneID;
-layout (location = 13) in vec4 boneWeight;
+layout (location = 12) in uvec4 boneData0;
+layout (location = 13) in uvec4 boneData1;
 /*layout (location = 4) in ivec4 boneID;
  layout (location = 5) in vec4 boneWeight;*/ /*This configuration is used with MeshAOS because there is no instance rendering implemented yet */
 
-const int MAX_BONES = 100;
+// Shared by all the programs, the layout must match PackedCamera::Block
+layout (std140, row_major) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 eyePosition;
+    vec4 frustumPlanes[6];
+    vec4 viewport;
+    float time;
+} uCamera;
 
-uniform mat4 uWVP;
 uniform mat4 uLightWVP;
 uniform mat4 uWorld;
-uniform mat4 uBone[MAX_BONES];
-uniform mat4 uPreviousBone[MAX_BONES];
+
+// Bone palettes of all the instances, each matrix is stored as 4 rows of RGBA32F texels
+uniform samplerBuffer uBonePalette;
+uniform samplerBuffer uPreviousBonePalette;
+uniform int uBoneCount;
+uniform int uPaletteInstance;
+
+// First texel of the palettes of this frame, the texture buffers are ring buffers (see DynamicRingBuffer)
+uniform int uPaletteOffset;
+uniform int uPreviousPaletteOffset;
 
 out vec4 lightSpacePos;
 out vec2 texCoord0;
@@ -25,15 +45,48 @@ out vec3 tangent0;
 out vec4 clipSpacePos0;
 out vec4 clipSpacePreviousPos0;
 
+// Packed bones of the vertex (see PackedBoneData): uBoneInfluences IDs followed by uBoneInfluences unsigned normalized
+// weights, each value uses uBoneIndexBits bits starting with the lowest bits of each word
+uniform int uBoneInfluences;
+uniform int uBoneIndexBits;
+
+uint boneField(int pIndex)
+{
+    int lPerWord = 32 / uBoneIndexBits;
+    int lWord = pIndex / lPerWord;
+    uint lBits = lWord < 4 ? boneData0[lWord] : boneData1[lWord - 4];
+
+    return (lBits >> uint((pIndex % lPerWord) * uBoneIndexBits)) & ((1u << uint(uBoneIndexBits)) - 1u);
+}
+
+mat4 bone(samplerBuffer pPalette, int pOffset, int pBone)
+{
+    int lTexel = pOffset + ((uPaletteInstance + gl_InstanceID) * uBoneCount + pBone) * 4;
+
+    return transpose(mat4(texelFetch(pPalette, lTexel),
+                          texelFetch(pPalette, lTexel + 1),
+                          texelFetch(pPalette, lTexel + 2),
+                          texelFetch(pPalette, lTexel + 3)));
+}
+
+mat4 skin(samplerBuffer pPalette, int pOffset)
+{
+    float lMaxWeight = float((1 << uBoneIndexBits) - 1);
+    mat4 lBoneTransform = mat4(0.0);
+
+    for (int i = 0; i < uBoneInfluences; ++i)
+        lBoneTransform += bone(pPalette, pOffset, int(boneField(i))) * (float(boneField(uBoneInfluences + i)) / lMaxWeight);
+
+    return lBoneTransform;
+}
+
 void main()
 {
-    mat4 lBoneTransform = uBone[boneID[0]] * boneWeight[0];
-    lBoneTransform 	   += uBone[boneID[1]] * boneWeight[1];
-    lBoneTransform 	   += uBone[boneID[2]] * boneWeight[2];
-    lBoneTransform 	   += uBone[boneID[3]] * boneWeight[3];
+    mat4 lBoneTransform = skin(uBonePalette, uPaletteOffset);
 
     vec4 lPos = lBoneTransform * vec4(position, 1.0);
-    vec4 lClipSpacePos = uWVP * lPos;
+    vec4 lWorldPos = uWorld * lPos;
+    vec4 lClipSpacePos = uCamera.viewProjection * lWorldPos;
     gl_Position = lClipSpacePos;
     lightSpacePos = uLightWVP * lPos;
 
@@ -45,14 +98,11 @@ void main()
     vec4 lTangent = lBoneTransform * vec4(tangent, 0.0);
     tangent0 = (uWorld * lTangent).xyz;
 
-    worldPos0 = (uWorld * lPos).xyz;
+    worldPos0 = lWorldPos.xyz;
 
-    mat4 lPreviousBoneTransform = uPreviousBone[boneID[0]] * boneWeight[0];
-    lPreviousBoneTransform 	   += uPreviousBone[boneID[1]] * boneWeight[1];
-    lPreviousBoneTransform 	   += uPreviousBone[boneID[2]] * boneWeight[2];
-    lPreviousBoneTransform 	   += uPreviousBone[boneID[3]] * boneWeight[3];
+    mat4 lPreviousBoneTransform = skin(uPreviousBonePalette, uPreviousPaletteOffset);
 
     clipSpacePos0 = lClipSpacePos;
     vec4 lPreviousPos = lPreviousBoneTransform * vec4(position, 1.0f);
-    clipSpacePreviousPos0 = uWVP * lPreviousPos;
+    clipSpacePreviousPos0 = uCamera.viewProjection * uWorld * lPreviousPos;
 }
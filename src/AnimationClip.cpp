@@ -0,0 +1,228 @@
+//===============================================================================================//
+/*!
+ *  \file      AnimationClip.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "AnimationClip.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#include "Exceptions.hpp"
+
+using std::vector;
+using miniGL::AnimationClip;
+using miniGL::AnimationCursor;
+using miniGL::LocalPose;
+using miniGL::Exceptions;
+
+AnimationClip::AnimationClip(float pTicksPerSecond, float pDuration)
+:mTicksPerSecond(pTicksPerSecond != 0.0f ? pTicksPerSecond : 25.0f),
+ mDuration(pDuration)
+{
+}
+
+unsigned int AnimationClip::addChannel(Channel && pChannel)
+{
+    if (pChannel.positionTimes.empty() || pChannel.positionTimes.size() != pChannel.positions.size())
+        throw Exceptions("No position keys found for animation", __FILE__, __LINE__);
+
+    if (pChannel.rotationTimes.empty() || pChannel.rotationTimes.size() != pChannel.rotations.size())
+        throw Exceptions("No rotation keys found for animation", __FILE__, __LINE__);
+
+    if (pChannel.scalingTimes.empty() || pChannel.scalingTimes.size() != pChannel.scalings.size())
+        throw Exceptions("No scaling keys found for animation", __FILE__, __LINE__);
+
+    mChannels.push_back(std::move(pChannel));
+
+    return static_cast<unsigned int>(mChannels.size()) - 1;
+}
+
+unsigned int AnimationClip::channelNode(unsigned int pIndex) const
+{
+    return channel(pIndex).node;
+}
+
+unsigned int AnimationClip::channelCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mChannels.size());
+}
+
+const AnimationClip::Channel & AnimationClip::channel(unsigned int pIndex) const
+{
+    assert(pIndex < mChannels.size() && "Channel index out of boundaries");
+    return mChannels[pIndex];
+}
+
+float AnimationClip::ticksPerSecond(void) const noexcept
+{
+    return mTicksPerSecond;
+}
+
+float AnimationClip::duration(void) const noexcept
+{
+    return mDuration;
+}
+
+float AnimationClip::animationTime(float pTime) const noexcept
+{
+    return mDuration > 0.0f ? fmod(pTime * mTicksPerSecond, mDuration) : 0.0f;
+}
+
+mat4f AnimationClip::localTransform(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor) const
+{
+    vec3f lPosition;
+    quatf lRotation;
+    vec3f lScaling;
+
+    _sample(pChannel, pAnimationTime, pCursor, lPosition, lRotation, lScaling);
+
+    return compose(lPosition, lRotation, lScaling);
+}
+
+void AnimationClip::sample(float pAnimationTime, AnimationCursor & pCursor, LocalPose & pPose) const
+{
+    if (pCursor.channelCount() != channelCount())
+        pCursor.reset(channelCount());
+
+    vec3f lPosition;
+    quatf lRotation;
+    vec3f lScaling;
+
+    // Only the animated nodes are modified, the others keep the transformation already in the pose
+    for (unsigned int i = 0; i < channelCount(); ++i)
+    {
+        _sample(i, pAnimationTime, pCursor, lPosition, lRotation, lScaling);
+        pPose.transform(channelNode(i), lPosition, lRotation, lScaling);
+    }
+}
+
+void AnimationClip::clear(void)
+{
+    mChannels.clear();
+    mTicksPerSecond = 25.0f;
+    mDuration = 0.0f;
+}
+
+size_t AnimationClip::byteSize(void) const noexcept
+{
+    size_t lSize = 0;
+
+    for (const Channel & rChannel : mChannels)
+    {
+        lSize += sizeof(float) * (rChannel.positionTimes.size() + rChannel.rotationTimes.size() + rChannel.scalingTimes.size());
+        lSize += sizeof(vec3f) * (rChannel.positions.size() + rChannel.scalings.size());
+        lSize += sizeof(quatf) * rChannel.rotations.size();
+    }
+
+    return lSize;
+}
+
+mat4f AnimationClip::compose(const vec3f & pPosition, const quatf & pRotation, const vec3f & pScaling)
+{
+    // Combine translation * rotation * scaling directly instead of multiplying three 4x4 matrices
+    const float x = pRotation.x(), y = pRotation.y(), z = pRotation.z(), w = pRotation.w();
+    const float sx = pScaling.x(), sy = pScaling.y(), sz = pScaling.z();
+
+    mat4f lRes;
+
+    lRes(0,0) = (1.0f - 2.0f * (y*y + z*z)) * sx;   lRes(0,1) = 2.0f * (x*y - w*z) * sy;            lRes(0,2) = 2.0f * (x*z + w*y) * sz;            lRes(0,3) = pPosition.x();
+    lRes(1,0) = 2.0f * (x*y + w*z) * sx;            lRes(1,1) = (1.0f - 2.0f * (x*x + z*z)) * sy;   lRes(1,2) = 2.0f * (y*z - w*x) * sz;            lRes(1,3) = pPosition.y();
+    lRes(2,0) = 2.0f * (x*z - w*y) * sx;            lRes(2,1) = 2.0f * (y*z + w*x) * sy;            lRes(2,2) = (1.0f - 2.0f * (x*x + y*y)) * sz;   lRes(2,3) = pPosition.z();
+    lRes(3,0) = 0.0f;                               lRes(3,1) = 0.0f;                               lRes(3,2) = 0.0f;                               lRes(3,3) = 1.0f;
+
+    return lRes;
+}
+
+void AnimationClip::_sample(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor, vec3f & pPosition, quatf & pRotation, vec3f & pScaling) const
+{
+    const Channel & rChannel = mChannels[pChannel];
+
+    // At least 2 values are necessary to interpolate
+    vec3f lScaling = rChannel.scalings[0];
+
+    if (rChannel.scalingTimes.size() > 1)
+    {
+        const unsigned int lKey = pCursor.scalingKey(pChannel, rChannel.scalingTimes, pAnimationTime);
+        const float lFactor = _factor(rChannel.scalingTimes, lKey, pAnimationTime);
+
+        lScaling = rChannel.scalings[lKey] + (rChannel.scalings[lKey + 1] - rChannel.scalings[lKey]) * lFactor;
+    }
+
+    quatf lRotation = rChannel.rotations[0];
+
+    if (rChannel.rotationTimes.size() > 1)
+    {
+        const unsigned int lKey = pCursor.rotationKey(pChannel, rChannel.rotationTimes, pAnimationTime);
+        const float lFactor = _factor(rChannel.rotationTimes, lKey, pAnimationTime);
+
+        lRotation = slerp(rChannel.rotations[lKey], rChannel.rotations[lKey + 1], lFactor);
+    }
+
+    vec3f lPosition = rChannel.positions[0];
+
+    if (rChannel.positionTimes.size() > 1)
+    {
+        const unsigned int lKey = pCursor.positionKey(pChannel, rChannel.positionTimes, pAnimationTime);
+        const float lFactor = _factor(rChannel.positionTimes, lKey, pAnimationTime);
+
+        lPosition = rChannel.positions[lKey] + (rChannel.positions[lKey + 1] - rChannel.positions[lKey]) * lFactor;
+    }
+
+    pPosition = lPosition;
+    pRotation = lRotation;
+    pScaling = lScaling;
+}
+
+float AnimationClip::_factor(const vector<float> & pTimes, unsigned int pKey, float pAnimationTime)
+{
+    assert(pKey + 1 < pTimes.size());
+
+    const float lDeltaTime = pTimes[pKey + 1] - pTimes[pKey];
+
+    if (lDeltaTime <= 0.0f)
+        return 0.0f;
+
+    // The cursor clamps the key to the range of the animation, so does the factor
+    const float lFactor = (pAnimationTime - pTimes[pKey]) / lDeltaTime;
+
+    return std::min(std::max(lFactor, 0.0f), 1.0f);
+}
+
+quatf AnimationClip::slerp(const quatf & pStart, const quatf & pEnd, float pFactor)
+{
+    float lCosOmega = pStart.x() * pEnd.x() + pStart.y() * pEnd.y() + pStart.z() * pEnd.z() + pStart.w() * pEnd.w();
+
+    // Take the shortest arc between the two rotations
+    float lSign = 1.0f;
+
+    if (lCosOmega < 0.0f)
+    {
+        lCosOmega = -lCosOmega;
+        lSign = -1.0f;
+    }
+
+    float lStartScale = 1.0f - pFactor;
+    float lEndScale = pFactor;
+
+    // Fall back to a linear interpolation when the quaternions are very close
+    if (1.0f - lCosOmega > 0.0001f)
+    {
+        const float lOmega = acos(lCosOmega);
+        const float lSinOmega = sin(lOmega);
+
+        lStartScale = sin((1.0f - pFactor) * lOmega) / lSinOmega;
+        lEndScale = sin(pFactor * lOmega) / lSinOmega;
+    }
+
+    lEndScale *= lSign;
+
+    return quatf(lStartScale * pStart.x() + lEndScale * pEnd.x(),
+                 lStartScale * pStart.y() + lEndScale * pEnd.y(),
+                 lStartScale * pStart.z() + lEndScale * pEnd.z(),
+                 lStartScale * pStart.w() + lEndScale * pEnd.w());
+}
@@ -0,0 +1,174 @@
+//===============================================================================================//
+/*!
+ *  \file      AnimationClip.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Algebra.hpp"
+#include "AnimationCursor.hpp"
+#include "LocalPose.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores the keys of a skeletal animation
+     *  \details A clip contains one channel per animated node of a Skeleton. Each channel stores its position,
+     *           rotation and scaling keys as structure of arrays (the times are kept apart from the values), so
+     *           that the search for the current key only reads contiguous floats. The clip does not depend on
+     *           the library used to import the animation.
+     */
+    class AnimationClip
+    {
+    public:
+        struct Channel
+        {
+            unsigned int node;
+            std::vector<float> positionTimes;
+            std::vector<vec3f> positions;
+            std::vector<float> rotationTimes;
+            std::vector<quatf> rotations;
+            std::vector<float> scalingTimes;
+            std::vector<vec3f> scalings;
+        };
+
+    public:
+        /*!
+         *  \brief Default constructor
+         */
+        AnimationClip(void) = default;
+
+        /*!
+         *  \brief Constructor with the time parameters of the animation
+         *  @param pTicksPerSecond is the number of ticks in one second
+         *  @param pDuration is the duration of the animation in ticks
+         */
+        AnimationClip(float pTicksPerSecond, float pDuration);
+
+        /*!
+         *  \brief Add a channel to the clip
+         *  @param pChannel contains the keys of one node, each type of key must contain at least one value
+         *  @return the index of the new channel
+         */
+        unsigned int addChannel(Channel && pChannel);
+
+        /*!
+         *  \brief Get the number of channels
+         *  @return the number of channels in the clip
+         */
+        unsigned int channelCount(void) const noexcept;
+
+        /*!
+         *  \brief Get a channel (read only)
+         *  @param pIndex is the index of the channel
+         *  @return a const reference on the channel
+         */
+        const Channel & channel(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the node animated by a channel
+         *  @param pIndex is the index of the channel
+         *  @return the index of the node in the Skeleton
+         */
+        unsigned int channelNode(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the number of ticks in one second
+         *  @return the number of ticks in one second
+         */
+        float ticksPerSecond(void) const noexcept;
+
+        /*!
+         *  \brief Get the duration of the animation
+         *  @return the duration in ticks
+         */
+        float duration(void) const noexcept;
+
+        /*!
+         *  \brief Convert a time in seconds to a time in ticks, looping over the duration of the animation
+         *  @param pTime is in seconds
+         *  @return the time stamp in the animation
+         */
+        float animationTime(float pTime) const noexcept;
+
+        /*!
+         *  \brief Interpolate the keys of a channel and combine them in a single transformation
+         *  @param pChannel is the index of the channel
+         *  @param pAnimationTime is the current time stamp in the animation
+         *  @param pCursor is used to find the keys of the channel
+         *  @return the transformation translation * rotation * scaling of the node for the current time stamp
+         */
+        mat4f localTransform(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor) const;
+
+        /*!
+         *  \brief Interpolate the keys of all the channels and write them in a pose
+         *  @param pAnimationTime is the current time stamp in the animation
+         *  @param pCursor is used to find the keys of the channels
+         *  @param pPose contains the local transformation of each node, only the animated nodes are modified
+         */
+        void sample(float pAnimationTime, AnimationCursor & pCursor, LocalPose & pPose) const;
+
+        /*!
+         *  \brief Remove all the channels
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Get the memory used by the keys of the clip
+         *  @return the size in bytes of the times and values of all the channels
+         */
+        std::size_t byteSize(void) const noexcept;
+
+        /*!
+         *  \brief Combine a translation, a rotation and a scaling in a single transformation
+         *  @param pPosition is the translation
+         *  @param pRotation is a unit quaternion
+         *  @param pScaling is the scaling along each axis
+         *  @return the transformation translation * rotation * scaling
+         */
+        static mat4f compose(const vec3f & pPosition, const quatf & pRotation, const vec3f & pScaling);
+
+        /*!
+         *  \brief Interpolate two unit quaternions along the shortest arc
+         *  @param pStart is the quaternion for a factor of 0
+         *  @param pEnd is the quaternion for a factor of 1
+         *  @param pFactor is in the range [0,1]
+         *  @return the interpolated quaternion
+         */
+        static quatf slerp(const quatf & pStart, const quatf & pEnd, float pFactor);
+
+    private:
+        /*!
+         *  \brief Helper method to interpolate the keys of a channel
+         *  @param pChannel is the index of the channel
+         *  @param pAnimationTime is the current time stamp in the animation
+         *  @param pCursor is used to find the keys of the channel
+         *  @param pPosition will contain the interpolated position
+         *  @param pRotation will contain the interpolated rotation
+         *  @param pScaling will contain the interpolated scaling
+         */
+        void _sample(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor, vec3f & pPosition, quatf & pRotation, vec3f & pScaling) const;
+
+        /*!
+         *  \brief Helper method to compute the interpolation factor between two keys
+         *  @param pTimes contains the time of each key
+         *  @param pKey is the index of the first key
+         *  @param pAnimationTime is the current time stamp
+         *  @return a factor in the range [0,1]
+         */
+        static float _factor(const std::vector<float> & pTimes, unsigned int pKey, float pAnimationTime);
+
+    private:
+        std::vector<Channel> mChannels;
+        float mTicksPerSecond = 25.0f;
+        float mDuration = 0.0f;
+
+    }; // class AnimationClip
+
+} // namespace miniGL
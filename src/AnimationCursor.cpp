@@ -0,0 +1,35 @@
+//===============================================================================================//
+/*!
+ *  \file      AnimationCursor.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "AnimationCursor.hpp"
+
+using std::vector;
+using miniGL::AnimationCursor;
+
+AnimationCursor::AnimationCursor(unsigned int pChannelCount)
+{
+    reset(pChannelCount);
+}
+
+void AnimationCursor::reset(unsigned int pChannelCount)
+{
+    mPositionKeys.assign(pChannelCount, 0);
+    mRotationKeys.assign(pChannelCount, 0);
+    mScalingKeys.assign(pChannelCount, 0);
+    mDecodedKeys.clear();
+}
+
+unsigned int AnimationCursor::channelCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mPositionKeys.size());
+}
+
+unsigned int AnimationCursor::findKey(const vector<float> & pTimes, float pTime, unsigned int pPreviousKey)
+{
+    return findKey(pTimes.data(), static_cast<unsigned int>(pTimes.size()), pTime, pPreviousKey);
+}
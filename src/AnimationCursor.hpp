@@ -0,0 +1,233 @@
+//===============================================================================================//
+/*!
+ *  \file      AnimationCursor.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+#include "Algebra.hpp"
+
+// Key index of the decoded keys of a track that was not decoded yet
+#define ANIMATION_CURSOR_NO_KEY 0xFFFFFFFF
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class keeps track of the keyframes used during the previous sampling of an animation
+     *  \details For each channel of an animation, the cursor stores the index of the last position, rotation
+     *           and scaling keys. When the animation is played forward, the next key is found by looking at the
+     *           current and following keys only. On a seek or a loop, the key is found with a binary search.
+     */
+    class AnimationCursor
+    {
+    public:
+        //! Keys decompressed by a CompressedClip around the current time of a channel, reused until the cursor moves to the next keys
+        struct DecodedKeys
+        {
+            unsigned int positionKey = ANIMATION_CURSOR_NO_KEY;
+            unsigned int rotationKey = ANIMATION_CURSOR_NO_KEY;
+            unsigned int scalingKey = ANIMATION_CURSOR_NO_KEY;
+            vec3f positions[2];
+            quatf rotations[2];
+            vec3f scalings[2];
+        };
+
+    public:
+        /*!
+         *  \brief Default constructor
+         */
+        AnimationCursor(void) = default;
+
+        /*!
+         *  \brief Constructor with the number of channels
+         *  @param pChannelCount is the number of channels in the animation sampled with this cursor
+         */
+        explicit AnimationCursor(unsigned int pChannelCount);
+
+        /*!
+         *  \brief Set the number of channels and move all the keys back to the start of the animation
+         *  @param pChannelCount is the number of channels in the animation sampled with this cursor
+         */
+        void reset(unsigned int pChannelCount);
+
+        /*!
+         *  \brief Get the number of channels handled by this cursor
+         *  @return the number of channels
+         */
+        unsigned int channelCount(void) const noexcept;
+
+        /*!
+         *  \brief Find the position key to use at the current time and save it for the next call
+         *  @param pChannel is the index of the channel in the animation
+         *  @param pTimes contains the time of each position key of the channel (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1]
+         */
+        unsigned int positionKey(unsigned int pChannel, const std::vector<float> & pTimes, float pTime);
+
+        /*!
+         *  \brief Find the rotation key to use at the current time and save it for the next call
+         *  @param pChannel is the index of the channel in the animation
+         *  @param pTimes contains the time of each rotation key of the channel (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1]
+         */
+        unsigned int rotationKey(unsigned int pChannel, const std::vector<float> & pTimes, float pTime);
+
+        /*!
+         *  \brief Find the scaling key to use at the current time and save it for the next call
+         *  @param pChannel is the index of the channel in the animation
+         *  @param pTimes contains the time of each scaling key of the channel (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1]
+         */
+        unsigned int scalingKey(unsigned int pChannel, const std::vector<float> & pTimes, float pTime);
+
+        /*!
+         *  \brief Find the key to use at a given time, starting from a previously used key
+         *  @param pTimes contains the sorted times of the keys (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation
+         *  @param pPreviousKey is the key returned by the previous call for the same channel
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1], clamped to [0, pTimes.size() - 2]
+         */
+        static unsigned int findKey(const std::vector<float> & pTimes, float pTime, unsigned int pPreviousKey);
+
+        /*!
+         *  \brief Find the key to use at a given time in an array of times, starting from a previously used key
+         *  @param pTimes points to the sorted times of the keys, e.g. floats or quantized integers
+         *  @param pCount is the number of keys (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation, in the same unit as pTimes
+         *  @param pPreviousKey is the key returned by the previous call for the same channel
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1], clamped to [0, pCount - 2]
+         */
+        template<typename T>
+        static unsigned int findKey(const T* pTimes, unsigned int pCount, float pTime, unsigned int pPreviousKey);
+
+        /*!
+         *  \brief Find the position key to use at the current time in an array of times and save it for the next call
+         *  @param pChannel is the index of the channel in the animation
+         *  @param pTimes points to the times of the position keys of the channel
+         *  @param pCount is the number of keys (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation, in the same unit as pTimes
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1]
+         */
+        template<typename T>
+        unsigned int positionKey(unsigned int pChannel, const T* pTimes, unsigned int pCount, float pTime);
+
+        /*!
+         *  \brief Find the rotation key to use at the current time in an array of times and save it for the next call
+         *  @param pChannel is the index of the channel in the animation
+         *  @param pTimes points to the times of the rotation keys of the channel
+         *  @param pCount is the number of keys (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation, in the same unit as pTimes
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1]
+         */
+        template<typename T>
+        unsigned int rotationKey(unsigned int pChannel, const T* pTimes, unsigned int pCount, float pTime);
+
+        /*!
+         *  \brief Find the scaling key to use at the current time in an array of times and save it for the next call
+         *  @param pChannel is the index of the channel in the animation
+         *  @param pTimes points to the times of the scaling keys of the channel
+         *  @param pCount is the number of keys (at least 2 keys)
+         *  @param pTime is the current time stamp in the animation, in the same unit as pTimes
+         *  @return the index i such that pTimes[i] <= pTime < pTimes[i + 1]
+         */
+        template<typename T>
+        unsigned int scalingKey(unsigned int pChannel, const T* pTimes, unsigned int pCount, float pTime);
+
+        /*!
+         *  \brief Get the keys decompressed during the previous sampling of a channel
+         *  \details The memory is only allocated by the first call after a reset, the cursors of uncompressed clips do not use it
+         *  @param pChannel is the index of the channel in the animation
+         *  @return a reference on the decoded keys, their key indices are ANIMATION_CURSOR_NO_KEY after a reset
+         */
+        DecodedKeys & decodedKeys(unsigned int pChannel);
+
+    private:
+        std::vector<unsigned int> mPositionKeys;
+        std::vector<unsigned int> mRotationKeys;
+        std::vector<unsigned int> mScalingKeys;
+        std::vector<DecodedKeys> mDecodedKeys;
+
+    }; // class AnimationCursor
+
+    inline unsigned int AnimationCursor::positionKey(unsigned int pChannel, const std::vector<float> & pTimes, float pTime)
+    {
+        mPositionKeys[pChannel] = findKey(pTimes, pTime, mPositionKeys[pChannel]);
+        return mPositionKeys[pChannel];
+    }
+
+    inline unsigned int AnimationCursor::rotationKey(unsigned int pChannel, const std::vector<float> & pTimes, float pTime)
+    {
+        mRotationKeys[pChannel] = findKey(pTimes, pTime, mRotationKeys[pChannel]);
+        return mRotationKeys[pChannel];
+    }
+
+    inline unsigned int AnimationCursor::scalingKey(unsigned int pChannel, const std::vector<float> & pTimes, float pTime)
+    {
+        mScalingKeys[pChannel] = findKey(pTimes, pTime, mScalingKeys[pChannel]);
+        return mScalingKeys[pChannel];
+    }
+
+    inline AnimationCursor::DecodedKeys & AnimationCursor::decodedKeys(unsigned int pChannel)
+    {
+        if (mDecodedKeys.size() != mPositionKeys.size())
+            mDecodedKeys.assign(mPositionKeys.size(), DecodedKeys());
+
+        return mDecodedKeys[pChannel];
+    }
+
+    template<typename T>
+    unsigned int AnimationCursor::findKey(const T* pTimes, unsigned int pCount, float pTime, unsigned int pPreviousKey)
+    {
+        assert(pCount >= 2 && "At least 2 keys are necessary to find a key to interpolate from");
+
+        const unsigned int lLastKey = pCount - 2;
+
+        // Monotonic playback: the time is still between the same keys or has moved to the next interval
+        if (pPreviousKey <= lLastKey && pTimes[pPreviousKey] <= pTime)
+        {
+            if (pTime < pTimes[pPreviousKey + 1])
+                return pPreviousKey;
+
+            if (pPreviousKey < lLastKey && pTime < pTimes[pPreviousKey + 2])
+                return pPreviousKey + 1;
+        }
+
+        // Seek or loop: look for the first key strictly after pTime in [1, lLastKey], the key to use is the one just before.
+        // Times before the first key return 0 and times after the last key return lLastKey.
+        const T* lNext = std::upper_bound(pTimes + 1, pTimes + lLastKey + 1, pTime);
+
+        return static_cast<unsigned int>(lNext - pTimes) - 1;
+    }
+
+    template<typename T>
+    inline unsigned int AnimationCursor::positionKey(unsigned int pChannel, const T* pTimes, unsigned int pCount, float pTime)
+    {
+        mPositionKeys[pChannel] = findKey(pTimes, pCount, pTime, mPositionKeys[pChannel]);
+        return mPositionKeys[pChannel];
+    }
+
+    template<typename T>
+    inline unsigned int AnimationCursor::rotationKey(unsigned int pChannel, const T* pTimes, unsigned int pCount, float pTime)
+    {
+        mRotationKeys[pChannel] = findKey(pTimes, pCount, pTime, mRotationKeys[pChannel]);
+        return mRotationKeys[pChannel];
+    }
+
+    template<typename T>
+    inline unsigned int AnimationCursor::scalingKey(unsigned int pChannel, const T* pTimes, unsigned int pCount, float pTime)
+    {
+        mScalingKeys[pChannel] = findKey(pTimes, pCount, pTime, mScalingKeys[pChannel]);
+        return mScalingKeys[pChannel];
+    }
+
+} // namespace miniGL
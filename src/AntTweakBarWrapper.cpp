@@ -15,6 +15,7 @@
 #include "PointLight.hpp"
 #include "SpotLight.hpp"
 #include "Exceptions.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::to_string;
@@ -27,6 +28,7 @@ using miniGL::MeshBase;
 using miniGL::MeshAndTransform;
 using miniGL::Camera;
 using miniGL::BaseLight;
+using miniGL::GLStateCache;
 
 bool AntTweakBarWrapper::mAutoRotate = false;
 bool AntTweakBarWrapper::mResetOrientation = false;
@@ -219,6 +221,9 @@ bool AntTweakBarWrapper::passiveMouseCallback(int pX, int pY)
 void AntTweakBarWrapper::render(void)
 {
     TwDraw();
+
+    // AntTweakBar changes the OpenGL state with its own calls
+    GLStateCache::invalidate();
 }
 
 bool AntTweakBarWrapper::mouseCallback(int pButton, bool pIsPressed)
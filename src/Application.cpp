@@ -26,6 +26,15 @@
 #include "MeshSOA.hpp"
 #include "BackendGLFW.hpp"
 #include "Program.hpp"
+#include "GLStateCache.hpp"
+#include "DynamicRingBuffer.hpp"
+#include "FrameArena.hpp"
+#include "LightUniformBuffer.hpp"
+#include "CameraUniformBuffer.hpp"
+#include "ClusteredLightBuffer.hpp"
+
+// Number of frames after initializing a technique before checking that the frames do not allocate from the heap
+#define APPLICATION_WARM_UP_FRAMES 10
 
 using std::cout;
 using std::cerr;
@@ -51,6 +60,9 @@ using miniGL::Application;
 using miniGL::Exceptions;
 using miniGL::Shader;
 using miniGL::Transform;
+using miniGL::SceneGraph;
+using miniGL::SceneNodeHandle;
+using miniGL::MeshRegistry;
 using miniGL::MeshAOS;
 using miniGL::MeshSOA;
 using miniGL::Log;
@@ -63,6 +75,12 @@ using miniGL::Skinning;
 using miniGL::SilhouetteRender;
 using miniGL::BackendGLFW;
 using miniGL::Program;
+using miniGL::GLStateCache;
+using miniGL::DynamicRingBuffer;
+using miniGL::FrameArena;
+using miniGL::LightUniformBuffer;
+using miniGL::CameraUniformBuffer;
+using miniGL::ClusteredLightBuffer;
 
 Application::Application(void)
 {
@@ -71,6 +89,11 @@ Application::Application(void)
 
 Application::~Application(void)
 {
+    // Shared by the programs of all the techniques
+    LightUniformBuffer::clear();
+    CameraUniformBuffer::clear();
+    ClusteredLightBuffer::clear();
+
     mWindow->terminate();
 }
 
@@ -290,11 +313,24 @@ void Application::mouseCallBack(int pButton, bool pIsPressed)
 void Application::pickingPhaseCallback(void)
 {
     if (mPickingOn)
+    {
+        _updateTransforms();
+        mPicking3D->runningTime(mWindow->runningTime());
         mPicking3D->pickingPhase(mMeshes);
+    }
 }
 
 void Application::renderPhaseCallBack(void)
 {
+    // Count the filtered OpenGL calls of this frame only
+    GLStateCache::resetCounters();
+
+    // The temporary allocations of the previous frame are released
+    FrameArena::nextFrame();
+
+    // OpenGL work queued by the jobs, e.g. uploading the data they decoded
+    mJobSystem.runMainThreadJobs();
+
     if (mATB.autoRotateActive())
         mRotationAngle += mATB.meshRotationIncrement();
 
@@ -321,8 +357,21 @@ void Application::renderPhaseCallBack(void)
 
         if (mWindowWasResized)
             mWindowWasResized = false;
+
+        mSteadyFrameCount = 0;
     }
 
+    // The camera does not move while rendering the frame, all the programs read the same block
+    const auto lFrameBufferDims = mWindow->frameBufferDimensions();
+    CameraUniformBuffer::update(*mCamera, static_cast<unsigned int>(get<0>(lFrameBufferDims)), static_cast<unsigned int>(get<1>(lFrameBufferDims)), mWindow->runningTime());
+
+    // The lights are assigned to the clusters of this camera by the first lighting program of the frame
+    ClusteredLightBuffer::camera(*mCamera, & mJobSystem);
+
+#ifdef MINIGL_COUNT_HEAP_ALLOCATIONS
+    const unsigned long long lHeapAllocations = FrameArena::heapAllocations();
+#endif
+
     // Render the current technique
     switch (mCurrentRenderingTechniqueIndex)
     {
@@ -351,8 +400,26 @@ void Application::renderPhaseCallBack(void)
             break;
     }
 
+#ifdef MINIGL_COUNT_HEAP_ALLOCATIONS
+    // Once the containers of the technique reached their final size, rendering a frame should not allocate anymore
+    if (mSteadyFrameCount < APPLICATION_WARM_UP_FRAMES)
+    {
+        ++mSteadyFrameCount;
+    }
+    else if (mSteadyFrameCount == APPLICATION_WARM_UP_FRAMES && FrameArena::heapAllocations() != lHeapAllocations)
+    {
+        Log::consoleMessage("Heap allocations while rendering a steady frame: " + to_string(FrameArena::heapAllocations() - lHeapAllocations));
+
+        // Only reported once per technique
+        ++mSteadyFrameCount;
+    }
+#endif
+
     // Render the UI on top of the other rendering technique
     mATB.render();
+
+    // The next frame writes its dynamic data in other regions of the ring buffers
+    DynamicRingBuffer::nextFrame();
 }
 
 void Application::errorCallback(int pError, const char* pDescription)
@@ -377,9 +444,18 @@ void Application::frameBufferSizeCallback(int pWidth, int pHeight)
 
 void Application::_validateShaderWithMesh(Program* pProgram, const std::string & pName)
 {
-    mMeshes[pName].mesh->bindVAO(0);
+    const auto & rMesh = mMeshes[mMeshes.handle(pName)];
+
+    rMesh.mesh->bindVAO(0);
     pProgram->validate();
-    mMeshes[pName].mesh->unbindVAO();
+    rMesh.mesh->unbindVAO();
+}
+
+void Application::_updateTransforms(void)
+{
+    // The nodes first, the transforms attached to them read their world matrices
+    mSceneGraph.update(& mJobSystem);
+    mMeshes.updateTransforms(mCamera->viewProjection(), & mJobSystem);
 }
 
 void Application::_loadMeshes(void)
@@ -503,7 +579,11 @@ void Application::_deactivateRenderingTechniques(void)
 {
     // Remove all transforms set by the different init functions
     for (auto & mesh : mMeshes)
-        mesh.second.transform.clear();
+        mesh.transform.clear();
+
+    mSceneGraph.clear();
+    mHelicopterFlight = SceneGraph::invalidHandle();
+    mHelicopterLight = SceneGraph::invalidHandle();
 
     // Reset all the lights
     for (auto light : mLights)
@@ -581,8 +661,9 @@ void Application::_initSimpleLighting(void)
         static_pointer_cast<PointLight>(mLights[i])->attenuation(SpotLight::ATTENUATION_TYPE::LINEAR, 0.1f);
     }
 
+    // Follows the helicopter, see _renderSimpleLighting
     static_pointer_cast<PointLight>(mLights[1])->color(vec3f(0.0f, 1.0f, 0.0f));
-    static_pointer_cast<PointLight>(mLights[1])->position(vec3f(-10.0f, 5.0f, -10.0f));
+    static_pointer_cast<PointLight>(mLights[1])->position(vec3f(-6.0f, 2.5f, -9.0f));
 
     static_pointer_cast<PointLight>(mLights[2])->color(vec3f(0.0f, 0.0f, 1.0f));
     static_pointer_cast<PointLight>(mLights[2])->position(vec3f(10.0f, 5.0f, -10.0f));
@@ -609,66 +690,80 @@ void Application::_initSimpleLighting(void)
 
     // Configure meshes to illustrate the shadow with shadow map
     const auto lFloorMeshName = string("quad");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
-        lFloorMeshIterator->second.transform.emplace_back();
-        lFloorMeshIterator->second.transform.back().scaling(20.0f, 20.0f, 20.0f);
-        lFloorMeshIterator->second.transform.back().translation(0.0f, -1.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().rotation(90.0f, 0.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.emplace_back();
+        mMeshes[lFloorMeshHandle].transform.back().scaling(20.0f, 20.0f, 20.0f);
+        mMeshes[lFloorMeshHandle].transform.back().translation(0.0f, -1.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().rotation(90.0f, 0.0f, 0.0f);
     }
 
     const auto lMeshName = string("spaceShip");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
-        lMeshIterator->second.transform.emplace_back();
-        lMeshIterator->second.transform.back().scaling(0.1f, 0.1f, 0.1f);
-        lMeshIterator->second.transform.back().translation(5.0f, 0.0f, 3.0f);
+        mMeshes[lMeshHandle].transform.emplace_back();
+        mMeshes[lMeshHandle].transform.back().scaling(0.1f, 0.1f, 0.1f);
+        mMeshes[lMeshHandle].transform.back().translation(5.0f, 0.0f, 3.0f);
     }
 
     // Create cube to illustrate bump mapping
     const auto lCubeMeshName = string("cube");
-    auto lCubeMeshIterator = mMeshes.find(lCubeMeshName);
+    const auto lCubeMeshHandle = mMeshes.handle(lCubeMeshName);
 
-    if (lCubeMeshIterator != mMeshes.end())
+    if (lCubeMeshHandle != MeshRegistry::invalidHandle())
     {
-        lCubeMeshIterator->second.transform.emplace_back();
-        lCubeMeshIterator->second.transform.back().translation(7.0f, 3.0f, -6.0f);
+        mMeshes[lCubeMeshHandle].transform.emplace_back();
+        mMeshes[lCubeMeshHandle].transform.back().translation(7.0f, 3.0f, -6.0f);
     }
 
     const string lJeepMeshName("jeep");
-    auto lJeepMeshIterator = mMeshes.find(lJeepMeshName);
+    const auto lJeepMeshHandle = mMeshes.handle(lJeepMeshName);
 
-    if (lJeepMeshIterator != mMeshes.end())
+    if (lJeepMeshHandle != MeshRegistry::invalidHandle())
     {
-        lJeepMeshIterator->second.transform.emplace_back();
-        lJeepMeshIterator->second.transform.back().translation(-9.0f, 0.5f, 6.0f);
-        lJeepMeshIterator->second.transform.back().scaling(0.01f, 0.01f, 0.01f);
+        mMeshes[lJeepMeshHandle].transform.emplace_back();
+        mMeshes[lJeepMeshHandle].transform.back().translation(-9.0f, 0.5f, 6.0f);
+        mMeshes[lJeepMeshHandle].transform.back().scaling(0.01f, 0.01f, 0.01f);
     }
 
+    // The helicopter flies around the center of the scene, its point light hangs below it
+    mHelicopterFlight = mSceneGraph.add();
+    const SceneNodeHandle lHelicopterNode = mSceneGraph.add(mHelicopterFlight);
+    mHelicopterLight = mSceneGraph.add(lHelicopterNode);
+
+    Transform lLocal;
+    lLocal.translation(-6.0f, 4.0f, -9.0f);
+    mSceneGraph.local(lHelicopterNode, lLocal.final());
+
+    lLocal.translation(0.0f, -1.5f, 0.0f);
+    mSceneGraph.local(mHelicopterLight, lLocal.final());
+
     const string lHelicopterMeshName("helicopter");
-    auto lHelicopterMeshIterator = mMeshes.find(lHelicopterMeshName);
+    const auto lHelicopterMeshHandle = mMeshes.handle(lHelicopterMeshName);
 
-    if (lHelicopterMeshIterator != mMeshes.end())
+    if (lHelicopterMeshHandle != MeshRegistry::invalidHandle())
     {
-        lHelicopterMeshIterator->second.transform.emplace_back();
-        lHelicopterMeshIterator->second.transform.back().translation(-6.0f, 4.0f, -9.0f);
-        lHelicopterMeshIterator->second.transform.back().scaling(0.04f, 0.04f, 0.04f);
+        mMeshes[lHelicopterMeshHandle].transform.emplace_back();
+        mMeshes[lHelicopterMeshHandle].transform.back().scaling(0.04f, 0.04f, 0.04f);
+        mMeshes[lHelicopterMeshHandle].transform.back().parent(& mSceneGraph, lHelicopterNode);
     }
 
     // Create and initialize the simple lighting technique
-    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>();
+    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>(mJobSystem);
     mSimpleLightingWithShadow->init(4u, mWindow->frameBufferDimensions());
     mSimpleLightingWithShadow->camera(mCamera);
     mSimpleLightingWithShadow->floor(lFloorMeshName);
     mSimpleLightingWithShadow->addMeshToRender(lMeshName);
     mSimpleLightingWithShadow->addMeshToRender(lCubeMeshName);
-    mSimpleLightingWithShadow->addMeshToRender(lJeepMeshName);
     mSimpleLightingWithShadow->addMeshToRender(lHelicopterMeshName);
     mSimpleLightingWithShadow->lightToUseDuringRender(1, 2, 3, 4, 5);
+
+    // The jeep never moves, it is merged in a single vertex buffer
+    mSimpleLightingWithShadow->addStaticMeshToRender(lJeepMeshName);
 }
 
 void Application::_initSkybox(void)
@@ -770,9 +865,9 @@ void Application::_init3DPicking(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lSpiderMeshName = string("spider");
-    auto lSpiderMeshIterator = mMeshes.find(lSpiderMeshName);
+    const auto lSpiderMeshHandle = mMeshes.handle(lSpiderMeshName);
 
-    if (lSpiderMeshIterator != mMeshes.end())
+    if (lSpiderMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(0.02f, 0.02f, 0.02f);
@@ -781,30 +876,30 @@ void Application::_init3DPicking(void)
         lTransform.rotation(0.0f, lRotationY, 0.0f);
         lTransform.translation(-6.0f, 0.8f, -5.0f);
 
-        lSpiderMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lSpiderMeshHandle].transform.push_back(lTransform);
 
         lTransform.translation(-2.0f, 0.8f, -5.0f);
-        lSpiderMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lSpiderMeshHandle].transform.push_back(lTransform);
     }
 
     // Configure meshes to illustrate the shadow with shadow map
     const auto lFloorMeshName = string("quad");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
-        lFloorMeshIterator->second.transform.emplace_back();
-        lFloorMeshIterator->second.transform.back().scaling(20.0f, 20.0f, 20.0f);
-        lFloorMeshIterator->second.transform.back().translation(0.0f, 0.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().rotation(90.0f, 0.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.emplace_back();
+        mMeshes[lFloorMeshHandle].transform.back().scaling(20.0f, 20.0f, 20.0f);
+        mMeshes[lFloorMeshHandle].transform.back().translation(0.0f, 0.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().rotation(90.0f, 0.0f, 0.0f);
     }
 
-    mPicking3D = make_unique<Picking3D>();
+    mPicking3D = make_unique<Picking3D>(mJobSystem);
     mPicking3D->init(mWindow->frameBufferDimensions(), mWindow->windowDimensions());
     mPicking3D->camera(mCamera);
     mPicking3D->meshToRender(lSpiderMeshName);
 
-    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>();
+    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>(mJobSystem);
     mSimpleLightingWithShadow->init(4u, mWindow->frameBufferDimensions());
     mSimpleLightingWithShadow->camera(mCamera);
     mSimpleLightingWithShadow->floor(lFloorMeshName);
@@ -836,15 +931,15 @@ void Application::_initTessellation(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lMeshName = string("terrain");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(10.0f, 10.0f, 10.0f);
         lTransform.translation(-25.0f, 0.0f, 0.0f);
 
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
     }
 
     mTessellation = make_unique<Tessellation>();
@@ -893,20 +988,20 @@ void Application::_initTessellationPN(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lMeshName = string("monkey");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(3.0f, 3.0f, 3.0f);
         lTransform.translation(-5.0f, 15.0f, 0.0f);
         lTransform.rotation(-90.0f, 0.0f, 0.0f);
 
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
 
         lTransform.translation(5.0f, 15.0f, 0.0f);
 
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
     }
 
     mTessellationPN = make_unique<TessellationPN>();
@@ -955,15 +1050,15 @@ void Application::_initInstancedRendering(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lMeshName = string("spider - instanced rendering");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(0.005f, 0.005f, 0.005f);
         lTransform.rotation(0.0f, 90.0f, 0.0f);
 
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
     }
 
 //    _validateShaderWithMesh(mInstancedLighting, lName);
@@ -1059,15 +1154,15 @@ void Application::_initGLFXExample(void)
 
     for (size_t i = 0; i < lPositions.size(); ++i)
     {
-        auto lMeshIterator = mMeshes.find(lMeshNames[i]);
+        const auto lMeshHandle = mMeshes.handle(lMeshNames[i]);
 
-        if (lMeshIterator != mMeshes.end())
+        if (lMeshHandle != MeshRegistry::invalidHandle())
         {
             Transform lTransform;
             lTransform.scaling(0.2f, 0.2f, 0.2f);
             lTransform.translation(lPositions[i].x(), lPositions[i].y(), lPositions[i].z());
 
-            lMeshIterator->second.transform.push_back(lTransform);
+            mMeshes[lMeshHandle].transform.push_back(lTransform);
 
             mGLFXTechnique->addMeshToRender(lMeshNames[i]);
             mGLFXTechnique->addUniformColor(lColors[i].x(), lColors[i].y(), lColors[i].z());
@@ -1130,26 +1225,26 @@ void Application::_initDeferredShading(void)
 //    _validateShaderWithMesh(mDSGeometryPass,string("box"));
 
     const auto lMeshName = string("box");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
 
         lTransform.translation(0.0f, 0.0f, 5.0f);
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
 
         lTransform.translation(6.0f, 1.0f, 10.0f);
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
 
         lTransform.translation(-5.0f, -1.0f, 12.0f);
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
 
         lTransform.translation(4.0f, 4.0f, 15.0f);
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
 
         lTransform.translation(-4.0f, 2.0f, 20.0f);
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
     }
 
     mDeferredShading = make_unique<DeferredShadingTechnique>();
@@ -1202,19 +1297,19 @@ void Application::_initSkeletalAnimation(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lMeshName = string("bobLamp");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(0.1f, 0.1f, 0.1f);
         lTransform.translation(0.0f, 0.0f, 6.0f);
         lTransform.rotation(270.0f, 180.0f, 0.0f);
 
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
     }
 
-    mSkinningTechnique = make_unique<SkinningTechnique>();
+    mSkinningTechnique = make_unique<SkinningTechnique>(mJobSystem);
     mSkinningTechnique->init(2, 1, false);
     mSkinningTechnique->camera(mCamera);
     mSkinningTechnique->addMeshToRender(lMeshName);
@@ -1272,38 +1367,38 @@ void Application::_initSilhouetteDetection(void)
 
     // Create normal cube to be renderer with simple lighting with shadows
     const auto lGraphicsCubeMeshName = string("cube");
-    auto lGraphicsCubeMeshIterator = mMeshes.find(lGraphicsCubeMeshName);
+    const auto lGraphicsCubeMeshHandle = mMeshes.handle(lGraphicsCubeMeshName);
 
-    if (lGraphicsCubeMeshIterator != mMeshes.end())
+    if (lGraphicsCubeMeshHandle != MeshRegistry::invalidHandle())
     {
-        lGraphicsCubeMeshIterator->second.transform.emplace_back();
-        lGraphicsCubeMeshIterator->second.transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
+        mMeshes[lGraphicsCubeMeshHandle].transform.emplace_back();
+        mMeshes[lGraphicsCubeMeshHandle].transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
     }
 
     // Create cube with adjacencies to be able to compute the silhouette in silhouette technique
     const auto lCubeMeshName = string("cubeWithAdjacencies");
-    auto lCubeMeshIterator = mMeshes.find(lCubeMeshName);
+    const auto lCubeMeshHandle = mMeshes.handle(lCubeMeshName);
 
-    if (lCubeMeshIterator != mMeshes.end())
+    if (lCubeMeshHandle != MeshRegistry::invalidHandle())
     {
-        lCubeMeshIterator->second.transform.emplace_back();
-        lCubeMeshIterator->second.transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
+        mMeshes[lCubeMeshHandle].transform.emplace_back();
+        mMeshes[lCubeMeshHandle].transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
     }
 
     // Simple lighting with shadows REQUIRES a floor
     const auto lFloorMeshName = string("quad");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
-        lFloorMeshIterator->second.transform.emplace_back();
-        lFloorMeshIterator->second.transform.back().scaling(20.0f, 20.0f, 20.0f);
-        lFloorMeshIterator->second.transform.back().translation(0.0f, -1.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().rotation(90.0f, 0.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.emplace_back();
+        mMeshes[lFloorMeshHandle].transform.back().scaling(20.0f, 20.0f, 20.0f);
+        mMeshes[lFloorMeshHandle].transform.back().translation(0.0f, -1.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().rotation(90.0f, 0.0f, 0.0f);
     }
 
     // Create and initialize the simple lighting technique
-    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>();
+    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>(mJobSystem);
     mSimpleLightingWithShadow->init(4u, mWindow->frameBufferDimensions());
     mSimpleLightingWithShadow->camera(mCamera);
     mSimpleLightingWithShadow->addMeshToRender(lGraphicsCubeMeshName);
@@ -1344,40 +1439,40 @@ void Application::_initShadowVolume(void)
 
     // Create cube to illustrate bump mapping
     const auto lCubeAdjacenciesMeshName = string("cubeWithAdjacencies");
-    auto lCubeAdjacenciesMeshIterator = mMeshes.find(lCubeAdjacenciesMeshName);
+    const auto lCubeAdjacenciesMeshHandle = mMeshes.handle(lCubeAdjacenciesMeshName);
 
     const float lCubeTranslationX = 7.0f, lCubeTranslationY = 3.0f, lTranslationZ = -6.0f;
 
-    if (lCubeAdjacenciesMeshIterator != mMeshes.end())
+    if (lCubeAdjacenciesMeshHandle != MeshRegistry::invalidHandle())
     {
-        lCubeAdjacenciesMeshIterator->second.transform.emplace_back();
-        lCubeAdjacenciesMeshIterator->second.transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
+        mMeshes[lCubeAdjacenciesMeshHandle].transform.emplace_back();
+        mMeshes[lCubeAdjacenciesMeshHandle].transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
     }
 
     // Create cube to illustrate bump mapping
     const auto lCubeMeshName = string("cube");
-    auto lCubeMeshIterator = mMeshes.find(lCubeMeshName);
+    const auto lCubeMeshHandle = mMeshes.handle(lCubeMeshName);
 
-    if (lCubeMeshIterator != mMeshes.end())
+    if (lCubeMeshHandle != MeshRegistry::invalidHandle())
     {
-        lCubeMeshIterator->second.transform.emplace_back();
-        lCubeMeshIterator->second.transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
+        mMeshes[lCubeMeshHandle].transform.emplace_back();
+        mMeshes[lCubeMeshHandle].transform.back().translation(lCubeTranslationX, lCubeTranslationY, lTranslationZ);
     }
 
     // Configure two meshes to illustrate the shadow with shadow map
     const auto lFloorMeshName = string("quad");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
-        lFloorMeshIterator->second.transform.emplace_back();
-        lFloorMeshIterator->second.transform.back().scaling(20.0f, 20.0f, 20.0f);
-        lFloorMeshIterator->second.transform.back().translation(0.0f, -1.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().rotation(90.0f, 0.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.emplace_back();
+        mMeshes[lFloorMeshHandle].transform.back().scaling(20.0f, 20.0f, 20.0f);
+        mMeshes[lFloorMeshHandle].transform.back().translation(0.0f, -1.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().rotation(90.0f, 0.0f, 0.0f);
     }
 
     // Create and initialize the shadow volume technique
-    mShadowVolumeTechnique = make_unique<ShadowVolumeTechnique>();
+    mShadowVolumeTechnique = make_unique<ShadowVolumeTechnique>(mJobSystem);
     mShadowVolumeTechnique->init(1u, mWindow->frameBufferDimensions());
     mShadowVolumeTechnique->addMeshWithAdjacenciesToRender(lCubeAdjacenciesMeshName);
     mShadowVolumeTechnique->addMeshToRender(lCubeMeshName);
@@ -1431,19 +1526,19 @@ void Application::_initSkeletalAnimationWithMotionBlur(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lMeshName = string("bobLamp");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(0.1f, 0.1f, 0.1f);
         lTransform.translation(0.0f, 0.0f, 6.0f);
         lTransform.rotation(270.0f, 180.0f, 0.0f);
 
-        lMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lMeshHandle].transform.push_back(lTransform);
     }
 
-    mSkinningTechnique = make_unique<SkinningTechnique>();
+    mSkinningTechnique = make_unique<SkinningTechnique>(mJobSystem);
     mSkinningTechnique->init(2, 1, true, mWindow->frameBufferDimensions());
     mSkinningTechnique->camera(mCamera);
     mSkinningTechnique->addMeshToRender(lMeshName);
@@ -1475,31 +1570,31 @@ void Application::_initMultipassShadowMapping(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lMeshName = string("sphere");
-    auto lCubeMeshIterator = mMeshes.find(lMeshName);
+    const auto lCubeMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lCubeMeshIterator != mMeshes.end())
+    if (lCubeMeshHandle != MeshRegistry::invalidHandle())
     {
-        lCubeMeshIterator->second.transform.emplace_back();
-        lCubeMeshIterator->second.transform.back().translation(0.0f, 3.0f, 0.0f);
+        mMeshes[lCubeMeshHandle].transform.emplace_back();
+        mMeshes[lCubeMeshHandle].transform.back().translation(0.0f, 3.0f, 0.0f);
 
-        lCubeMeshIterator->second.transform.emplace_back();
-        lCubeMeshIterator->second.transform.back().translation(0.0f, 5.0f, 3.0f);
+        mMeshes[lCubeMeshHandle].transform.emplace_back();
+        mMeshes[lCubeMeshHandle].transform.back().translation(0.0f, 5.0f, 3.0f);
     }
 
     // Configure two meshes to illustrate the shadow with shadow map
     const auto lFloorMeshName = string("quad_r");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(10.0f, 10.0f, 10.0f);
         lTransform.rotation(90.0f, 0.0f, 0.0f);
-        lFloorMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lFloorMeshHandle].transform.push_back(lTransform);
 
         lTransform.rotation(0.0f, 0.0f, 0.0f);
         lTransform.translation(0.0f, 6.0f, 7.0f);
-        lFloorMeshIterator->second.transform.push_back(lTransform);
+        mMeshes[lFloorMeshHandle].transform.push_back(lTransform);
     }
 
     mMultipassShadowMapTechnique = make_unique<MultipassShadowMapTechnique>();
@@ -1555,13 +1650,13 @@ void Application::_initSSAO(void)
     mCamera->up(vec3f(0.0f, 1.0f, 0.0f));
 
     const auto lMeshName = string("jeep");
-    auto lMeshIterator = mMeshes.find(lMeshName);
+    const auto lMeshHandle = mMeshes.handle(lMeshName);
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
-        lMeshIterator->second.transform.emplace_back();
-        lMeshIterator->second.transform.back().scaling(0.05f, 0.05f, 0.05f);
-        lMeshIterator->second.transform.back().rotation(0.0f, 180.0f, 0.0f);
+        mMeshes[lMeshHandle].transform.emplace_back();
+        mMeshes[lMeshHandle].transform.back().scaling(0.05f, 0.05f, 0.05f);
+        mMeshes[lMeshHandle].transform.back().rotation(0.0f, 180.0f, 0.0f);
     }
 
     mSSAOTechnique = make_unique<SSAOTechnique>();
@@ -1597,25 +1692,25 @@ void Application::_initShadowMapDirectionalLight(void)
 
     for (unsigned int i = 0; i < lMeshNames.size(); ++i)
     {
-        auto lMeshIterator = mMeshes.find(lMeshNames[i]);
+        const auto lMeshHandle = mMeshes.handle(lMeshNames[i]);
 
-        if (lMeshIterator != mMeshes.end())
+        if (lMeshHandle != MeshRegistry::invalidHandle())
         {
-            lMeshIterator->second.transform.emplace_back();
-            lMeshIterator->second.transform.back().translation(0.0f, 0.0f, 3.0f + static_cast<float>(i) * 30.0f);
+            mMeshes[lMeshHandle].transform.emplace_back();
+            mMeshes[lMeshHandle].transform.back().translation(0.0f, 0.0f, 3.0f + static_cast<float>(i) * 30.0f);
         }
     }
 
     // Configure mesh to illustrate the shadow with shadow map
     const auto lFloorMeshName = string("quad");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
-        lFloorMeshIterator->second.transform.emplace_back();
-        lFloorMeshIterator->second.transform.back().scaling(50.0f, 100.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().translation(0.0f, -1.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().rotation(90.0f, 0.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.emplace_back();
+        mMeshes[lFloorMeshHandle].transform.back().scaling(50.0f, 100.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().translation(0.0f, -1.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().rotation(90.0f, 0.0f, 0.0f);
     }
 
     mCamera->orthogonalProjectionParameterCount(1);
@@ -1661,25 +1756,25 @@ void Application::_initCascadedShadowMapping(void)
 
     for (unsigned int i = 0; i < lMeshNames.size(); ++i)
     {
-        auto lMeshIterator = mMeshes.find(lMeshNames[i]);
+        const auto lMeshHandle = mMeshes.handle(lMeshNames[i]);
 
-        if (lMeshIterator != mMeshes.end())
+        if (lMeshHandle != MeshRegistry::invalidHandle())
         {
-            lMeshIterator->second.transform.emplace_back();
-            lMeshIterator->second.transform.back().translation(0.0f, 0.0f, 3.0f + static_cast<float>(i) * 30.0f);
+            mMeshes[lMeshHandle].transform.emplace_back();
+            mMeshes[lMeshHandle].transform.back().translation(0.0f, 0.0f, 3.0f + static_cast<float>(i) * 30.0f);
         }
     }
 
     // Configure mesh to illustrate the shadow with shadow map
     const auto lFloorMeshName = string("quad");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
-        lFloorMeshIterator->second.transform.emplace_back();
-        lFloorMeshIterator->second.transform.back().scaling(50.0f, 100.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().translation(0.0f, -1.0f, 1.0f);
-        lFloorMeshIterator->second.transform.back().rotation(90.0f, 0.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.emplace_back();
+        mMeshes[lFloorMeshHandle].transform.back().scaling(50.0f, 100.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().translation(0.0f, -1.0f, 1.0f);
+        mMeshes[lFloorMeshHandle].transform.back().rotation(90.0f, 0.0f, 0.0f);
     }
 
     mCamera->orthogonalProjectionParameterCount(3);
@@ -1744,69 +1839,69 @@ void Application::_initMultipleExamples(void)
 
 
     const auto lFloorMeshName = string("quad");
-    auto lFloorMeshIterator = mMeshes.find(lFloorMeshName);
+    const auto lFloorMeshHandle = mMeshes.handle(lFloorMeshName);
 
-    if (lFloorMeshIterator != mMeshes.end())
+    if (lFloorMeshHandle != MeshRegistry::invalidHandle())
     {
-        lFloorMeshIterator->second.transform.emplace_back();
-        lFloorMeshIterator->second.transform.back().scaling(40.0f, 20.0f, 50.0f);
-        lFloorMeshIterator->second.transform.back().translation(-20.0f, -1.0f, 0.0f);
-        lFloorMeshIterator->second.transform.back().rotation(90.0f, 0.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.emplace_back();
+        mMeshes[lFloorMeshHandle].transform.back().scaling(40.0f, 20.0f, 50.0f);
+        mMeshes[lFloorMeshHandle].transform.back().translation(-20.0f, -1.0f, 0.0f);
+        mMeshes[lFloorMeshHandle].transform.back().rotation(90.0f, 0.0f, 0.0f);
     }
 
     // Container to store all the names of the meshes that will be rendered with the simple lighting technique
     vector<string> lSimpleLightingMeshNames;
 
     lSimpleLightingMeshNames.emplace_back("spaceShip");
-    auto lMeshIterator = mMeshes.find(lSimpleLightingMeshNames.back());
+    const auto lMeshHandle = mMeshes.handle(lSimpleLightingMeshNames.back());
 
-    if (lMeshIterator != mMeshes.end())
+    if (lMeshHandle != MeshRegistry::invalidHandle())
     {
-        lMeshIterator->second.transform.emplace_back();
-        lMeshIterator->second.transform.back().scaling(0.1f, 0.1f, 0.1f);
-        lMeshIterator->second.transform.back().translation(5.0f, 0.0f, 3.0f);
+        mMeshes[lMeshHandle].transform.emplace_back();
+        mMeshes[lMeshHandle].transform.back().scaling(0.1f, 0.1f, 0.1f);
+        mMeshes[lMeshHandle].transform.back().translation(5.0f, 0.0f, 3.0f);
     }
 
     lSimpleLightingMeshNames.emplace_back("cube");
-    auto lCubeMeshIterator = mMeshes.find(lSimpleLightingMeshNames.back());
+    const auto lCubeMeshHandle = mMeshes.handle(lSimpleLightingMeshNames.back());
 
-    if (lCubeMeshIterator != mMeshes.end())
+    if (lCubeMeshHandle != MeshRegistry::invalidHandle())
     {
-        lCubeMeshIterator->second.transform.emplace_back();
-        lCubeMeshIterator->second.transform.back().translation(7.0f, 3.0f, -6.0f);
+        mMeshes[lCubeMeshHandle].transform.emplace_back();
+        mMeshes[lCubeMeshHandle].transform.back().translation(7.0f, 3.0f, -6.0f);
     }
 
     lSimpleLightingMeshNames.emplace_back("jeep");
-    auto lJeepMeshIterator = mMeshes.find(lSimpleLightingMeshNames.back());
+    const auto lJeepMeshHandle = mMeshes.handle(lSimpleLightingMeshNames.back());
 
-    if (lJeepMeshIterator != mMeshes.end())
+    if (lJeepMeshHandle != MeshRegistry::invalidHandle())
     {
-        lJeepMeshIterator->second.transform.emplace_back();
-        lJeepMeshIterator->second.transform.back().translation(-9.0f, 0.5f, 6.0f);
-        lJeepMeshIterator->second.transform.back().scaling(0.01f, 0.01f, 0.01f);
+        mMeshes[lJeepMeshHandle].transform.emplace_back();
+        mMeshes[lJeepMeshHandle].transform.back().translation(-9.0f, 0.5f, 6.0f);
+        mMeshes[lJeepMeshHandle].transform.back().scaling(0.01f, 0.01f, 0.01f);
     }
 
     lSimpleLightingMeshNames.emplace_back("helicopter");
-    auto lHelicopterMeshIterator = mMeshes.find(lSimpleLightingMeshNames.back());
+    const auto lHelicopterMeshHandle = mMeshes.handle(lSimpleLightingMeshNames.back());
 
-    if (lHelicopterMeshIterator != mMeshes.end())
+    if (lHelicopterMeshHandle != MeshRegistry::invalidHandle())
     {
-        lHelicopterMeshIterator->second.transform.emplace_back();
-        lHelicopterMeshIterator->second.transform.back().translation(-6.0f, 4.0f, -9.0f);
-        lHelicopterMeshIterator->second.transform.back().scaling(0.04f, 0.04f, 0.04f);
+        mMeshes[lHelicopterMeshHandle].transform.emplace_back();
+        mMeshes[lHelicopterMeshHandle].transform.back().translation(-6.0f, 4.0f, -9.0f);
+        mMeshes[lHelicopterMeshHandle].transform.back().scaling(0.04f, 0.04f, 0.04f);
     }
 
     // Create and initialize the simple lighting technique
-    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>();
+    mSimpleLightingWithShadow = make_unique<SimpleLightingWithShadow>(mJobSystem);
     mSimpleLightingWithShadow->init(4u, mWindow->frameBufferDimensions());
     mSimpleLightingWithShadow->camera(mCamera);
     mSimpleLightingWithShadow->floor(lFloorMeshName);
     mSimpleLightingWithShadow->lightToUseDuringRender(1, 2, 3, 4, 5);
 
     lSimpleLightingMeshNames.emplace_back("spider");
-    auto lSpiderPickingIterator = mMeshes.find(lSimpleLightingMeshNames.back());
+    const auto lSpiderPickingHandle = mMeshes.handle(lSimpleLightingMeshNames.back());
 
-    if (lSpiderPickingIterator != mMeshes.end())
+    if (lSpiderPickingHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(0.02f, 0.02f, 0.02f);
@@ -1815,10 +1910,10 @@ void Application::_initMultipleExamples(void)
         lTransform.rotation(0.0f, lRotationY, 0.0f);
         lTransform.translation(-6.0f, 0.8f, -5.0f);
 
-        lSpiderPickingIterator->second.transform.push_back(lTransform);
+        mMeshes[lSpiderPickingHandle].transform.push_back(lTransform);
 
         lTransform.translation(-2.0f, 0.8f, -5.0f);
-        lSpiderPickingIterator->second.transform.push_back(lTransform);
+        mMeshes[lSpiderPickingHandle].transform.push_back(lTransform);
     }
 
     // Particle system example
@@ -1828,7 +1923,7 @@ void Application::_initMultipleExamples(void)
     mCurrentTime = high_resolution_clock::now();
 
     // 3D picking example
-    mPicking3D = make_unique<Picking3D>();
+    mPicking3D = make_unique<Picking3D>(mJobSystem);
     mPicking3D->init(mWindow->frameBufferDimensions(), mWindow->windowDimensions());
     mPicking3D->camera(mCamera);
     mPicking3D->meshToRender(lSimpleLightingMeshNames.back());
@@ -1850,15 +1945,15 @@ void Application::_initMultipleExamples(void)
 
     for (size_t i = 0; i < lPositions.size(); ++i)
     {
-        auto lMeshIterator = mMeshes.find(lMeshNames[i]);
+        const auto lMeshHandle = mMeshes.handle(lMeshNames[i]);
 
-        if (lMeshIterator != mMeshes.end())
+        if (lMeshHandle != MeshRegistry::invalidHandle())
         {
             Transform lTransform;
             lTransform.scaling(0.2f, 0.2f, 0.2f);
             lTransform.translation(lPositions[i].x(), lPositions[i].y(), lPositions[i].z());
 
-            lMeshIterator->second.transform.push_back(lTransform);
+            mMeshes[lMeshHandle].transform.push_back(lTransform);
 
             mGLFXTechnique->addMeshToRender(lMeshNames[i]);
             mGLFXTechnique->addUniformColor(lColors[i].x(), lColors[i].y(), lColors[i].z());
@@ -1867,15 +1962,15 @@ void Application::_initMultipleExamples(void)
 
     // Instanced rendering example
     const auto lSpiderName = string("spider - instanced rendering");
-    auto lSpiderIterator = mMeshes.find(lSpiderName);
+    const auto lSpiderHandle = mMeshes.handle(lSpiderName);
 
-    if (lSpiderIterator != mMeshes.end())
+    if (lSpiderHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(0.005f, 0.005f, 0.005f);
         lTransform.rotation(0.0f, 90.0f, 0.0f);
 
-        lSpiderIterator->second.transform.push_back(lTransform);
+        mMeshes[lSpiderHandle].transform.push_back(lTransform);
     }
 
     //    _validateShaderWithMesh(mInstancedLighting, lName);
@@ -1931,15 +2026,15 @@ void Application::_initMultipleExamples(void)
 
     // Tessellationb example
     const auto lMeshName = string("terrain");
-    auto lTerranIterator = mMeshes.find(lMeshName);
+    const auto lTerranHandle = mMeshes.handle(lMeshName);
 
-    if (lTerranIterator != mMeshes.end())
+    if (lTerranHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(10.0f, 1.0f, 20.0f);
         lTransform.translation(30.0f, -2.0f, 0.0f);
 
-        lTerranIterator->second.transform.push_back(lTransform);
+        mMeshes[lTerranHandle].transform.push_back(lTransform);
     }
 
     mTessellation = make_unique<Tessellation>();
@@ -1951,20 +2046,20 @@ void Application::_initMultipleExamples(void)
 
     // Tessellation Point Normal example
     const auto lMonkeyName = string("monkey");
-    auto lMonkeyIterator = mMeshes.find(lMonkeyName);
+    const auto lMonkeyHandle = mMeshes.handle(lMonkeyName);
 
-    if (lMonkeyIterator != mMeshes.end())
+    if (lMonkeyHandle != MeshRegistry::invalidHandle())
     {
         Transform lTransform;
         lTransform.scaling(3.0f, 3.0f, 3.0f);
         lTransform.translation(-5.0f, 20.0f, 0.0f);
         lTransform.rotation(-90.0f, 0.0f, 0.0f);
 
-        lMonkeyIterator->second.transform.push_back(lTransform);
+        mMeshes[lMonkeyHandle].transform.push_back(lTransform);
 
         lTransform.translation(5.0f, 20.0f, 0.0f);
 
-        lMonkeyIterator->second.transform.push_back(lTransform);
+        mMeshes[lMonkeyHandle].transform.push_back(lTransform);
     }
 
     mTessellationPN = make_unique<TessellationPN>();
@@ -2024,13 +2119,13 @@ void Application::_initATB(void)
 
 void Application::_renderSimpleLighting(void)
 {
-    // Name of meshes to rotate
-    const auto & lNames = mSimpleLightingWithShadow->meshToRenderNames();
-
-    for (const auto it : lNames)
+    // Meshes to rotate
+    for (const auto lHandle : mSimpleLightingWithShadow->meshToRenderHandles(mMeshes))
     {
-        for (auto & transform : mMeshes.at(it).transform)
+        for (unsigned int i = 0; i < mMeshes[lHandle].transform.size(); ++i)
         {
+            auto transform = mMeshes[lHandle].transform[i];
+
             // Make the mesh rotate
             transform.rotation(0.0f, mRotationAngle, 0.0f);
 
@@ -2041,6 +2136,22 @@ void Application::_renderSimpleLighting(void)
         }
     }
 
+    // Only _initSimpleLighting creates the nodes of the helicopter
+    if (mHelicopterFlight != SceneGraph::invalidHandle())
+    {
+        Transform lFlight;
+        lFlight.rotation(0.0f, mRotationAngle, 0.0f);
+        mSceneGraph.local(mHelicopterFlight, lFlight.final());
+    }
+
+    _updateTransforms();
+
+    if (mHelicopterLight != SceneGraph::invalidHandle())
+    {
+        const mat4f & rLightWorld = mSceneGraph.world(mHelicopterLight);
+        static_pointer_cast<PointLight>(mLights[1])->position(vec3f(rLightWorld(0,3), rLightWorld(1,3), rLightWorld(2,3)));
+    }
+
     mSimpleLightingWithShadow->render(mMeshes, mLights);
 }
 
@@ -2056,20 +2167,20 @@ void Application::_renderParticleSystem(void)
 
     mCurrentTime = lNow;
 
-    auto lVP = mCamera->projection() * mCamera->view();
+    auto lVP = mCamera->viewProjection();
 
     mParticleSystem->render(lDeltaTime, lVP, mCamera->position());
 }
 
 void Application::_render3DPicking(void)
 {
-    // Name of meshes to rotate
-    const auto & lNames = mSimpleLightingWithShadow->meshToRenderNames();
-
-    for (const auto it : lNames)
+    // Meshes to rotate
+    for (const auto lHandle : mSimpleLightingWithShadow->meshToRenderHandles(mMeshes))
     {
-        for (auto & transform : mMeshes.at(it).transform)
+        for (unsigned int i = 0; i < mMeshes[lHandle].transform.size(); ++i)
         {
+            auto transform = mMeshes[lHandle].transform[i];
+
             // Make the mesh rotate
             transform.rotation(0.0f, mRotationAngle - 90.0f, 0.0f);
 
@@ -2092,6 +2203,8 @@ void Application::_render3DPicking(void)
     static_pointer_cast<PointLight>(mLights[3])->position(vec3f(7.0f + lRadius * cosf(lAngle + M_PI),               2.0f, -7.0f + lRadius * sinf(lAngle + M_PI)));
     static_pointer_cast<PointLight>(mLights[4])->position(vec3f(7.0f + lRadius * cosf(lAngle + 3.0f * M_PI / 2.0f), 2.0f, -7.0f + lRadius * sinf(lAngle + 3.0f * M_PI / 2.0f)));
 
+    _updateTransforms();
+
     /** \bug Some triangles are not highlighted */
     // We MUST render the triangle illustrating the 3D picking BEFORE rendering the corresponding mesh, otherwise, we won't see it. Not sure why...
     if (mCtrlKeyPressed)
@@ -2102,17 +2215,21 @@ void Application::_render3DPicking(void)
 
 void Application::_renderTessellation(void)
 {
+    _updateTransforms();
+
     mTessellation->render(mMeshes, mLights);
 }
 
 void Application::_renderTessellationPN(void)
 {
+    _updateTransforms();
+
     mTessellationPN->render(mMeshes, mLights);
 }
 
 void Application::_renderInstancedRendering(void)
 {
-    auto & lMesh = mMeshes.at("spider - instanced rendering");
+    auto & lMesh = mMeshes[mInstancedLighting->meshToRenderHandles(mMeshes)[0]];
     lMesh.transform[0].rotation(0.0f, 90.0f + mRotationAngle, 0.0f);
 
     // Update the orientation
@@ -2121,16 +2238,16 @@ void Application::_renderInstancedRendering(void)
     lMesh.transform[0].rotation(lTmpRotation);
 
     mInstancedLighting->instanceVelocitiesMultiplier(sinf(mRotationAngle.toRadian()));
+    _updateTransforms();
+
     mInstancedLighting->render(mMeshes, mLights);
 }
 
 void Application::_renderGLFXExample(void)
 {
-    const array<string, 4> lMeshNames = {{string("letter g"), string("letter l"), string("letter f"), string("letter x")}};
-
-    for (const auto name : lMeshNames)
+    for (const auto lHandle : mGLFXTechnique->meshToRenderHandles(mMeshes))
     {
-        auto & lMesh = mMeshes.at(name);
+        auto & lMesh = mMeshes[lHandle];
         const degreef lInitialAngle = 180.0f;
         lMesh.transform[0].rotation(0.0f, lInitialAngle + mRotationAngle, 0.0f);
 
@@ -2140,16 +2257,19 @@ void Application::_renderGLFXExample(void)
         lMesh.transform[0].rotation(lTmpRotation);
     }
 
+    _updateTransforms();
+
     mGLFXTechnique->render(mMeshes, mLights);
 }
 
 void Application::_renderDeferredShading(void)
 {
-    const auto & lNames = mDeferredShading->meshToRenderNames();
-    auto & lMesh = mMeshes.at(lNames[0]);
+    auto & lMesh = mMeshes[mDeferredShading->meshToRenderHandles(mMeshes)[0]];
 
-    for (auto & transform : lMesh.transform)
+    for (unsigned int i = 0; i < lMesh.transform.size(); ++i)
     {
+        auto transform = lMesh.transform[i];
+
         // Make the mesh rotate
         transform.rotation(0.0f, mRotationAngle + 90.0f, 0.0f);
 
@@ -2159,13 +2279,14 @@ void Application::_renderDeferredShading(void)
         transform.rotation(lTmpRotation);
     }
 
+    _updateTransforms();
+
     mDeferredShading->render(mMeshes, mLights);
 }
 
 void Application::_renderSkeletalAnimation(void)
 {
-    const auto & lNames = mSkinningTechnique->meshToRenderNames();
-    auto & lMesh = mMeshes.at(lNames[0]);
+    auto & lMesh = mMeshes[mSkinningTechnique->meshToRenderHandles(mMeshes)[0]];
     lMesh.transform[0].rotation(90.0f, 0.0f + mRotationAngle, 0.0f);
 
     // Update the orientation
@@ -2174,14 +2295,15 @@ void Application::_renderSkeletalAnimation(void)
     lMesh.transform[0].rotation(lTmpRotation);
 
     mSkinningTechnique->runningTime(mWindow->runningTime());
+    _updateTransforms();
+
     mSkinningTechnique->render(mMeshes, mLights);
 }
 
 void Application::_renderSilhouetteDetection(void)
 {
     // Update the orientation of the mesh from silhouette technique
-    const auto & lSilhouetteNames = mSilhouetteTechnique->meshToRenderNames();
-    auto & lSilhouetteMesh = mMeshes.at(lSilhouetteNames[0]);
+    auto & lSilhouetteMesh = mMeshes[mSilhouetteTechnique->meshToRenderHandles(mMeshes)[0]];
     lSilhouetteMesh.transform[0].rotation(0.0f, 0.0f + mRotationAngle, 0.0f);
 
     auto lTmpRotation = lSilhouetteMesh.transform[0].rotation();
@@ -2189,14 +2311,15 @@ void Application::_renderSilhouetteDetection(void)
     lSilhouetteMesh.transform[0].rotation(lTmpRotation);
 
     // Update the orientation of the mesh from lighting technique
-    const auto & lLightingNames = mSimpleLightingWithShadow->meshToRenderNames();
-    auto & lLightingMesh = mMeshes.at(lLightingNames[0]);
+    auto & lLightingMesh = mMeshes[mSimpleLightingWithShadow->meshToRenderHandles(mMeshes)[0]];
     lLightingMesh.transform[0].rotation(0.0f, 0.0f + mRotationAngle, 0.0f);
 
     lTmpRotation = lLightingMesh.transform[0].rotation();
     lTmpRotation = lTmpRotation * mMeshOrientation;
     lLightingMesh.transform[0].rotation(lTmpRotation);
 
+    _updateTransforms();
+
     // YOU MUST CALL _renderSimpleLighting to show the cube graphically to be able to use the silhouette
     // rendering on top of it.
     mSimpleLightingWithShadow->render(mMeshes, mLights);
@@ -2207,8 +2330,7 @@ void Application::_renderSilhouetteDetection(void)
 void Application::_renderShadowVolume(void)
 {
     // Udpate the mesh used for graphics
-    const auto & lNames = mShadowVolumeTechnique->meshToRenderNames();
-    auto & lMesh = mMeshes.at(lNames[0]);
+    auto & lMesh = mMeshes[mShadowVolumeTechnique->meshToRenderHandles(mMeshes)[0]];
     lMesh.transform[0].rotation(0.0f, 0.0f + mRotationAngle, 0.0f);
 
     // Update the orientation
@@ -2217,25 +2339,28 @@ void Application::_renderShadowVolume(void)
     lMesh.transform[0].rotation(lTmpRotation);
 
     // Update the mesh with adjacencies used for shadow
-    const auto & lNamesWithAdjacencies = mShadowVolumeTechnique->meshWithAdjacenciesNames();
-    auto & lMeshWithAdjacencies = mMeshes.at(lNamesWithAdjacencies[0]);
+    auto & lMeshWithAdjacencies = mMeshes[mShadowVolumeTechnique->meshWithAdjacenciesHandles(mMeshes)[0]];
     lMeshWithAdjacencies.transform[0].rotation(0.0f, 0.0f + mRotationAngle, 0.0f);
 
     auto lTmpRotation2 = lMeshWithAdjacencies.transform[0].rotation();
     lTmpRotation2 = lTmpRotation2 * mMeshOrientation;
     lMeshWithAdjacencies.transform[0].rotation(lTmpRotation2);
 
+    mShadowVolumeTechnique->runningTime(mWindow->runningTime());
+    _updateTransforms();
+
     mShadowVolumeTechnique->render(mMeshes, mLights);
 }
 
 void Application::_renderMultipassShadowMapping(void)
 {
     // Udpate the mesh used for graphics
-    const auto & lNames = mMultipassShadowMapTechnique->meshToRenderNames();
-    auto & lMesh = mMeshes.at(lNames[0]);
+    auto & lMesh = mMeshes[mMultipassShadowMapTechnique->meshToRenderHandles(mMeshes)[0]];
 
-    for (auto & transform : lMesh.transform)
+    for (unsigned int i = 0; i < lMesh.transform.size(); ++i)
     {
+        auto transform = lMesh.transform[i];
+
         // Make the mesh rotate
         transform.rotation(0.0f, mRotationAngle, 0.0f);
 
@@ -2245,17 +2370,20 @@ void Application::_renderMultipassShadowMapping(void)
         transform.rotation(lTmpRotation);
     }
 
+    _updateTransforms();
+
     mMultipassShadowMapTechnique->render(mMeshes, mLights);
 }
 
 void Application::_renderSSAO(void)
 {
     // Udpate the mesh used for graphics
-    const auto & lNames = mSSAOTechnique->meshToRenderNames();
-    auto & lMesh = mMeshes.at(lNames[0]);
+    auto & lMesh = mMeshes[mSSAOTechnique->meshToRenderHandles(mMeshes)[0]];
 
-    for (auto & transform : lMesh.transform)
+    for (unsigned int i = 0; i < lMesh.transform.size(); ++i)
     {
+        auto transform = lMesh.transform[i];
+
         // Make the mesh rotate
         transform.rotation(0.0f, mRotationAngle, 0.0f);
 
@@ -2265,14 +2393,16 @@ void Application::_renderSSAO(void)
         transform.rotation(lTmpRotation);
     }
 
+    _updateTransforms();
+
     mSSAOTechnique->render(mMeshes, mLights);
 }
 
 void Application::_renderShadowMapDirectionalLight(void)
 {
-    for (const auto name : mShadowMapDirectionalLightTechnique->meshToRenderNames())
+    for (const auto lHandle : mShadowMapDirectionalLightTechnique->meshToRenderHandles(mMeshes))
     {
-        auto & lMesh = mMeshes.at(name);
+        auto & lMesh = mMeshes[lHandle];
         lMesh.transform[0].rotation(0.0f, mRotationAngle, 0.0f);
 
         // Update the orientation
@@ -2281,14 +2411,16 @@ void Application::_renderShadowMapDirectionalLight(void)
         lMesh.transform[0].rotation(lTmpRotation);
     }
 
+    _updateTransforms();
+
     mShadowMapDirectionalLightTechnique->render(mMeshes, mLights);
 }
 
 void Application::_renderCascadedShadowMapping(void)
 {
-    for (const auto name : mCascadedShadowMapDirectionalLightTechnique->meshToRenderNames())
+    for (const auto lHandle : mCascadedShadowMapDirectionalLightTechnique->meshToRenderHandles(mMeshes))
     {
-        auto & lMesh = mMeshes.at(name);
+        auto & lMesh = mMeshes[lHandle];
         lMesh.transform[0].rotation(0.0f, mRotationAngle, 0.0f);
 
         // Update the orientation
@@ -2297,6 +2429,8 @@ void Application::_renderCascadedShadowMapping(void)
         lMesh.transform[0].rotation(lTmpRotation);
     }
 
+    _updateTransforms();
+
     mCascadedShadowMapDirectionalLightTechnique->render(mMeshes, mLights);
 }
 
@@ -10,7 +10,6 @@
 
 #include <iostream>
 #include <array>
-#include <map>
 #include <vector>
 #include <string>
 #include <chrono>
@@ -24,7 +23,9 @@
 #include "Texture.hpp"
 #include "SimpleLightingWithShadow.hpp"
 #include "MeshBase.hpp"
-#include "MeshAndTransform.hpp"
+#include "MeshRegistry.hpp"
+#include "SceneGraph.hpp"
+#include "JobSystem.hpp"
 #include "Skybox.hpp"
 #include "BillboardList.hpp"
 #include "ParticleSystem.hpp"
@@ -131,8 +132,15 @@ namespace miniGL
         void _validateShaderWithMesh(Program* pProgram, const std::string & pName);
 
         /*!
-         *  \brief Create a new mesh and stores the pointer in the map containing all the meshes. Calls load on the newly allocated mesh.
-         *         If a mesh with the same same was already in the map, delete the newly created pointer
+         *  \brief Helper method to compute the world matrices of the scene graph nodes and the world and WVP matrices of
+         *         the transforms that changed, once the meshes of the current technique were moved and before rendering
+         *         them. Calling it again in the same frame only updates the transforms modified in between.
+         */
+        void _updateTransforms(void);
+
+        /*!
+         *  \brief Create a new mesh and stores it in the registry containing all the meshes. Calls load on the newly allocated mesh.
+         *         If a mesh with the same same was already in the registry, delete the newly created pointer
          *  @param pName is the name of the mesh
          *  @param pFile is the filename to load the mesh
          *  @param pFrontFace is either GL_CW or GL_CCW
@@ -383,7 +391,11 @@ namespace miniGL
 
         AntTweakBarWrapper mATB;
 
-        std::map<std::string, MeshAndTransform> mMeshes;
+        MeshRegistry mMeshes;
+        SceneGraph mSceneGraph;
+        SceneNodeHandle mHelicopterFlight = SceneGraph::invalidHandle();    //!< Turns around the scene, parent of the helicopter
+        SceneNodeHandle mHelicopterLight = SceneGraph::invalidHandle();     //!< Below the helicopter, where its point light is
+        JobSystem mJobSystem;
         std::vector<std::shared_ptr<BaseLight>> mLights;
 
         std::chrono::high_resolution_clock::time_point mCurrentTime;
@@ -394,6 +406,7 @@ namespace miniGL
         float mCameraStep = 1.0f;
         int mCurrentRenderingTechniqueIndex = 0;
         int mPreviousRenderingTechniqueIndex = 0;
+        unsigned int mSteadyFrameCount = 0;     //!< Frames rendered since the current technique was initialized
         bool mCtrlKeyPressed = false;
         bool mPickingOn = false;
         bool mIsWireframe = false;
@@ -411,12 +424,12 @@ namespace miniGL
         MeshAndTransform lMeshContainer;
 
         lMeshContainer.mesh = std::make_shared<T>(pName);
-        auto lResult = mMeshes.emplace(pName, lMeshContainer);
+        const MeshHandle lHandle = mMeshes.add(pName, lMeshContainer);
 
-        if (lResult.second)
+        if (lHandle != MeshRegistry::invalidHandle())
         {
-            mMeshes[pName].mesh->load(pFile.c_str(), pOption);
-            mMeshes[pName].mesh->frontFace(pFrontFace);
+            mMeshes[lHandle].mesh->load(pFile.c_str(), pOption);
+            mMeshes[lHandle].mesh->frontFace(pFrontFace);
         }
         else
         {
@@ -0,0 +1,148 @@
+//===============================================================================================//
+/*!
+ *  \file      BakedAnimation.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "BakedAnimation.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#include "AnimationCursor.hpp"
+#include "GLUtils.hpp"
+#include "GLStateCache.hpp"
+
+using std::vector;
+using miniGL::BakedAnimation;
+using miniGL::CompressedClip;
+using miniGL::AnimationCursor;
+using miniGL::Skeleton;
+using miniGL::GLStateCache;
+
+BakedAnimation::~BakedAnimation(void)
+{
+    if (mTexture != 0)
+        GLStateCache::deleteTextures(1, & mTexture);
+}
+
+void BakedAnimation::bake(const Skeleton & pSkeleton, const vector<const CompressedClip*> & pClips, float pSampleRate)
+{
+    assert(pSampleRate > 0.0f && "The sample rate must be positive");
+
+    mClips.clear();
+    mFrames.clear();
+    mBoneCount = pSkeleton.boneCount();
+    mFrameCount = 0;
+
+    for (const CompressedClip* rClip : pClips)
+    {
+        assert(rClip != nullptr);
+
+        const float lDuration = rClip->duration() / rClip->ticksPerSecond();
+
+        // The first and the last frames are the start and the end of the clip, so that looping wraps exactly
+        const unsigned int lFrameCount = std::max(2u, static_cast<unsigned int>(std::ceil(lDuration * pSampleRate)) + 1);
+
+        mClips.push_back({mFrameCount, lFrameCount, lDuration});
+        mFrameCount += lFrameCount;
+    }
+
+    mFrames.resize(static_cast<size_t>(mFrameCount) * mBoneCount * 12);
+
+    AnimationCursor lCursor;
+    vector<mat4f> lNodeTransforms;
+    vector<mat4f> lBoneTransforms(mBoneCount);
+
+    for (unsigned int i = 0; i < pClips.size(); ++i)
+    {
+        const CompressedClip & rClip = *pClips[i];
+        const ClipRange & rRange = mClips[i];
+
+        lCursor.reset(rClip.channelCount());
+
+        for (unsigned int j = 0; j < rRange.frameCount; ++j)
+        {
+            const float lTime = rClip.duration() * static_cast<float>(j) / static_cast<float>(rRange.frameCount - 1);
+
+            pSkeleton.pose(rClip, lTime, lCursor, lNodeTransforms, lBoneTransforms.data());
+
+            float* lFrame = mFrames.data() + static_cast<size_t>(rRange.firstFrame + j) * mBoneCount * 12;
+
+            // The last row of an affine transformation is always (0, 0, 0, 1), it is not stored
+            for (unsigned int k = 0; k < mBoneCount; ++k)
+            {
+                for (unsigned int row = 0; row < 3; ++row)
+                {
+                    for (unsigned int col = 0; col < 4; ++col)
+                        *lFrame++ = lBoneTransforms[k](row, col);
+                }
+            }
+        }
+    }
+}
+
+void BakedAnimation::upload(void)
+{
+    if (mTexture == 0)
+    {
+        glGenTextures(1, & mTexture); checkOpenGLState;
+    }
+
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, mBoneCount * 3, mFrameCount, 0, GL_RGBA, GL_FLOAT, mFrames.data()); checkOpenGLState;
+
+    // The shader interpolates the frames itself with texelFetch
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    checkOpenGLState;
+
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+}
+
+void BakedAnimation::bind(GLenum pTextureUnit) const
+{
+    GLStateCache::activeTexture(pTextureUnit);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTexture);
+}
+
+vec4f BakedAnimation::instanceAttribute(unsigned int pClip, float pSpeed, float pTimeOffset) const
+{
+    const ClipRange & rRange = clip(pClip);
+
+    // Number of intervals between the frames played per second
+    const float lFrameRate = rRange.duration > 0.0f ? static_cast<float>(rRange.frameCount - 1) / rRange.duration : 0.0f;
+
+    return vec4f(static_cast<float>(rRange.firstFrame), static_cast<float>(rRange.frameCount), lFrameRate * pSpeed, lFrameRate * pTimeOffset);
+}
+
+const BakedAnimation::ClipRange & BakedAnimation::clip(unsigned int pClip) const
+{
+    assert(pClip < mClips.size() && "Clip index out of boundaries");
+    return mClips[pClip];
+}
+
+unsigned int BakedAnimation::clipCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mClips.size());
+}
+
+unsigned int BakedAnimation::boneCount(void) const noexcept
+{
+    return mBoneCount;
+}
+
+unsigned int BakedAnimation::frameCount(void) const noexcept
+{
+    return mFrameCount;
+}
+
+const vector<float> & BakedAnimation::frames(void) const noexcept
+{
+    return mFrames;
+}
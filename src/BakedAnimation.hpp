@@ -0,0 +1,112 @@
+//===============================================================================================//
+/*!
+ *  \file      BakedAnimation.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+
+#include "Algebra.hpp"
+#include "CompressedClip.hpp"
+#include "Skeleton.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class samples animation clips at a fixed rate and stores the bone transformations in a texture
+     *  \details Each row of the texture is one frame of one clip. A bone takes 3 RGBA32F texels holding the first
+     *           3 rows of its (affine) transformation, so a row is 3 * boneCount() texels wide. The clips are
+     *           stacked on top of each other. The instanced skinning shader reads the two frames around the
+     *           current time of an instance and interpolates them, so the CPU does no animation work per frame.
+     */
+    class BakedAnimation
+    {
+    public:
+        struct ClipRange
+        {
+            unsigned int firstFrame;
+            unsigned int frameCount;
+            float duration;
+        };
+
+    public:
+        /*!
+         *  \brief Destructor
+         */
+        ~BakedAnimation(void);
+
+        /*!
+         *  \brief Sample the clips and store the frames in memory, the previous frames are removed
+         *  @param pSkeleton is the skeleton animated by the clips
+         *  @param pClips contains the clips to bake, they must reference nodes of the skeleton
+         *  @param pSampleRate is the number of frames per second (at least 2 frames are stored per clip)
+         */
+        void bake(const Skeleton & pSkeleton, const std::vector<const CompressedClip*> & pClips, float pSampleRate = 30.0f);
+
+        /*!
+         *  \brief Create (or update) the texture with the baked frames
+         */
+        void upload(void);
+
+        /*!
+         *  \brief Bind the texture so that the shader can read from it
+         *  @param pTextureUnit is the texture unit, e.g. GL_TEXTURE0, ...
+         */
+        void bind(GLenum pTextureUnit) const;
+
+        /*!
+         *  \brief Get the per instance attribute to play a clip
+         *  @param pClip is the index of the clip in the container given to bake
+         *  @param pSpeed is the playback speed of the instance (1 for the original speed)
+         *  @param pTimeOffset is added to the time of the instance, in seconds
+         *  @return the first frame, the number of frames, the number of frames per second (scaled by the speed)
+         *          and the frame offset of the instance
+         */
+        vec4f instanceAttribute(unsigned int pClip, float pSpeed = 1.0f, float pTimeOffset = 0.0f) const;
+
+        /*!
+         *  \brief Get the frames of a clip in the texture
+         *  @param pClip is the index of the clip in the container given to bake
+         *  @return the first frame, the number of frames and the duration in seconds of the clip
+         */
+        const ClipRange & clip(unsigned int pClip) const;
+
+        /*!
+         *  \brief Get the number of baked clips
+         *  @return the number of clips
+         */
+        unsigned int clipCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bones in each frame
+         *  @return the number of bones of the skeleton
+         */
+        unsigned int boneCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of frames of all the clips, i.e. the height of the texture
+         *  @return the number of frames
+         */
+        unsigned int frameCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the baked frames (read only)
+         *  @return frameCount() * boneCount() * 12 floats, i.e. 3 rows of 4 floats per bone
+         */
+        const std::vector<float> & frames(void) const noexcept;
+
+    private:
+        std::vector<ClipRange> mClips;
+        std::vector<float> mFrames;
+        unsigned int mBoneCount = 0;
+        unsigned int mFrameCount = 0;
+        GLuint mTexture = 0;
+
+    }; // class BakedAnimation
+
+} // namespace miniGL
@@ -10,12 +10,15 @@
 
 #include <cassert>
 
+#include "GLStateCache.hpp"
+
 using std::tuple;
 using std::make_tuple;
 using std::chrono::high_resolution_clock;
 using std::chrono::duration_cast;
 using miniGL::CallbacksInterface;
 using miniGL::BaseBackend;
+using miniGL::GLStateCache;
 
 CallbacksInterface* BaseBackend::mCallbacks = nullptr;
 
@@ -94,10 +97,10 @@ tuple<int, int, int, int> BaseBackend::pixelColor(int pX, int pY)
 void BaseBackend::defaultConfiguration(void) const
 {
     // Default global configuration
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
-    glEnable(GL_CULL_FACE);
-    glFrontFace(GL_CCW);
-    glCullFace(GL_BACK);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthMask(GL_TRUE);
+    GLStateCache::depthFunc(GL_LESS);
+    GLStateCache::enable(GL_CULL_FACE);
+    GLStateCache::frontFace(GL_CCW);
+    GLStateCache::cullFace(GL_BACK);
 }
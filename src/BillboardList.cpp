@@ -13,6 +13,7 @@
 
 #include "GLUtils.hpp"
 #include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
 
 using std::vector;
 using std::string;
@@ -21,6 +22,7 @@ using std::make_unique;
 using miniGL::BillboardList;
 using miniGL::MeshBase;
 using miniGL::Camera;
+using miniGL::GLStateCache;
 
 BillboardList::~BillboardList(void)
 {
@@ -60,7 +62,7 @@ void BillboardList::render(void)
 {
     mRenderer.use();
 
-    const auto lVP = mCamera->projection() * mCamera->view();
+    const auto lVP = mCamera->viewProjection();
 
     mRenderer.VP(lVP);
     mRenderer.eyeWorldPosition(mCamera->position());
@@ -68,11 +70,10 @@ void BillboardList::render(void)
     mBillboardTexture->bind(COLOR_TEXTURE_UNIT);
 
     // Save the current orientation
-    GLint lFrontFaceOrientation;
-    glGetIntegerv(GL_FRONT_FACE, & lFrontFaceOrientation);
+    const GLenum lFrontFaceOrientation = GLStateCache::frontFace();
 
     // Use the clockwise orientation to render the billboards
-    glFrontFace(GL_CW);
+    GLStateCache::frontFace(GL_CW);
 
     glBindVertexArray(mVAO);
 
@@ -82,7 +83,7 @@ void BillboardList::render(void)
     glBindVertexArray(0);
 
     // Restore the original orientation
-    glFrontFace(lFrontFaceOrientation);
+    GLStateCache::frontFace(lFrontFaceOrientation);
 }
 
 void BillboardList::camera(shared_ptr<Camera> pCamera)
@@ -0,0 +1,88 @@
+//===============================================================================================//
+/*!
+ *  \file      BonePaletteBuffer.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "BonePaletteBuffer.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#include "GLUtils.hpp"
+#include "GLStateCache.hpp"
+
+// Number of matrices that a frame can write before the ring buffer grows
+#define BONE_PALETTE_RING_MATRICES 4096
+
+using miniGL::BonePaletteBuffer;
+using miniGL::GLStateCache;
+using miniGL::DynamicRingBuffer;
+
+BonePaletteBuffer::~BonePaletteBuffer(void)
+{
+    if (mTexture != 0)
+        GLStateCache::deleteTextures(1, & mTexture);
+}
+
+void BonePaletteBuffer::init(void)
+{
+    mBuffer.init(GL_TEXTURE_BUFFER, sizeof(mat4f) * BONE_PALETTE_RING_MATRICES);
+
+    glGenTextures(1, & mTexture); checkOpenGLState;
+    _attach();
+
+    mSize = 0;
+    mOffset = 0;
+}
+
+void BonePaletteBuffer::update(const mat4f* pTransforms, unsigned int pCount)
+{
+    assert(mTexture != 0 && "The bone palette buffer must be initialized before being updated");
+
+    static_assert(sizeof(mat4f) == 16 * sizeof(GLfloat), "The bone matrices are uploaded as 16 contiguous floats");
+
+    if (pCount > 0)
+    {
+        // Aligned on a matrix, so that the offset is a whole number of texels
+        const DynamicRingBuffer::Allocation lAllocation = mBuffer.allocate(sizeof(mat4f) * pCount, sizeof(mat4f));
+
+        std::memcpy(lAllocation.data, pTransforms, sizeof(mat4f) * pCount);
+        mBuffer.commit(lAllocation);
+
+        // The ring buffer grew, its buffer object was replaced
+        if (mBuffer.id() != mAttachedBuffer)
+            _attach();
+
+        mOffset = static_cast<unsigned int>(lAllocation.offset / (4 * sizeof(GLfloat)));
+    }
+
+    mSize = pCount;
+}
+
+void BonePaletteBuffer::bind(GLenum pTextureUnit) const
+{
+    GLStateCache::activeTexture(pTextureUnit);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, mTexture);
+}
+
+unsigned int BonePaletteBuffer::size(void) const noexcept
+{
+    return mSize;
+}
+
+unsigned int BonePaletteBuffer::offset(void) const noexcept
+{
+    return mOffset;
+}
+
+void BonePaletteBuffer::_attach(void)
+{
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, mTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, mBuffer.id()); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, 0);
+
+    mAttachedBuffer = mBuffer.id();
+}
@@ -0,0 +1,78 @@
+//===============================================================================================//
+/*!
+ *  \file      BonePaletteBuffer.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include "Algebra.hpp"
+#include "DynamicRingBuffer.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores the bone transformations of many skinned instances in a texture buffer
+     *  \details Each matrix takes 4 RGBA32F texels (one per row, as stored in mat4f). The shaders read the
+     *           palette with texelFetch, so the number of bones is not limited by the size of a uniform array
+     *           and all the palettes of a frame are sent with a single upload. The buffer is a DynamicRingBuffer:
+     *           each update writes in the region of the current frame and the shaders add offset() to the texels.
+     */
+    class BonePaletteBuffer
+    {
+    public:
+        /*!
+         *  \brief Destructor
+         */
+        ~BonePaletteBuffer(void);
+
+        /*!
+         *  \brief Create the ring buffer and the texture reading from it
+         */
+        void init(void);
+
+        /*!
+         *  \brief Write the palettes of the current frame, once per frame
+         *  @param pTransforms points to the bone transformations of all the instances
+         *  @param pCount is the number of matrices
+         */
+        void update(const mat4f* pTransforms, unsigned int pCount);
+
+        /*!
+         *  \brief Bind the texture so that the shader can read from it
+         *  @param pTextureUnit is the texture unit, e.g. GL_TEXTURE0, ...
+         */
+        void bind(GLenum pTextureUnit) const;
+
+        /*!
+         *  \brief Get the number of matrices in the buffer
+         *  @return the number of matrices uploaded by the last call to update
+         */
+        unsigned int size(void) const noexcept;
+
+        /*!
+         *  \brief Get where the matrices of the last update start in the texture
+         *  @return the index of the first texel
+         */
+        unsigned int offset(void) const noexcept;
+
+    private:
+        /*!
+         *  \brief Make the texture read from the current buffer object of the ring buffer
+         */
+        void _attach(void);
+
+    private:
+        DynamicRingBuffer mBuffer;
+        GLuint mTexture = 0;
+        GLuint mAttachedBuffer = 0;     //!< Buffer object read by the texture
+        unsigned int mSize = 0;
+        unsigned int mOffset = 0;
+
+    }; // class BonePaletteBuffer
+
+} // namespace miniGL
@@ -0,0 +1,193 @@
+//===============================================================================================//
+/*!
+ *  \file      CPUSkinning.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "CPUSkinning.hpp"
+
+#include <cassert>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define MINIGL_CPU_SKINNING_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MINIGL_CPU_SKINNING_SSE2
+#endif
+
+using std::vector;
+using miniGL::CPUSkinning;
+using miniGL::PackedBoneData;
+using miniGL::JobSystem;
+
+void CPUSkinning::init(const vector<vec3f> & pPositions, const vector<vec3f> & pNormals, const PackedBoneData & pBones)
+{
+    assert(pPositions.size() == pNormals.size() && pPositions.size() == pBones.vertexCount() && "Each vertex needs a position, a normal and its bones");
+
+    mPositions = pPositions;
+    mNormals = pNormals;
+    mInfluences = pBones.influences();
+
+    // Decode the bones once, so that skinning uses the same weights as the shaders without unpacking them for each pose
+    mBoneIDs.resize(pBones.vertexCount() * mInfluences);
+    mBoneWeights.resize(pBones.vertexCount() * mInfluences);
+
+    for (unsigned int i = 0; i < pBones.vertexCount(); ++i)
+    {
+        for (unsigned int j = 0; j < mInfluences; ++j)
+        {
+            mBoneIDs[i * mInfluences + j] = pBones.id(i, j);
+            mBoneWeights[i * mInfluences + j] = pBones.weight(i, j);
+        }
+    }
+}
+
+unsigned int CPUSkinning::vertexCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mPositions.size());
+}
+
+void CPUSkinning::skin(const mat4f* pTransforms, unsigned int pBoneCount, vec3f* pPositions, vec3f* pNormals, JobSystem* pJobSystem)
+{
+    // Store the columns of the matrices, so that blending and transforming only need multiplications and additions of 4 floats
+    mColumns.resize(pBoneCount * 16);
+
+    for (unsigned int i = 0; i < pBoneCount; ++i)
+    {
+        float* rColumns = mColumns.data() + i * 16;
+
+        for (unsigned int col = 0; col < 4; ++col)
+        {
+            for (unsigned int row = 0; row < 3; ++row)
+                rColumns[col * 4 + row] = pTransforms[i](row, col);
+
+            rColumns[col * 4 + 3] = 0.0f;
+        }
+    }
+
+#ifndef NDEBUG
+    for (auto lID : mBoneIDs)
+        assert(lID < pBoneCount && "Bone ID out of boundaries");
+#endif
+
+    if (pJobSystem != nullptr)
+        pJobSystem->parallelFor(vertexCount(), [this, pPositions, pNormals](unsigned int pBegin, unsigned int pEnd){ _skin(pBegin, pEnd, pPositions, pNormals); });
+    else
+        _skin(0, vertexCount(), pPositions, pNormals);
+}
+
+void CPUSkinning::clear(void)
+{
+    mPositions.clear();
+    mNormals.clear();
+    mBoneIDs.clear();
+    mBoneWeights.clear();
+    mColumns.clear();
+}
+
+void CPUSkinning::_skin(unsigned int pBegin, unsigned int pEnd, vec3f* pPositions, vec3f* pNormals) const
+{
+    unsigned int i = pBegin;
+
+#if defined(MINIGL_CPU_SKINNING_AVX)
+    // Two vertices per iteration, one in each 128 bit lane
+    float lResult[8];
+
+    for (; i + 2 <= pEnd; i += 2)
+    {
+        __m256 c[4] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+
+        for (unsigned int k = 0; k < mInfluences; ++k)
+        {
+            const float* rFirst = mColumns.data() + mBoneIDs[i * mInfluences + k] * 16;
+            const float* rSecond = mColumns.data() + mBoneIDs[(i + 1) * mInfluences + k] * 16;
+            const __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(mBoneWeights[i * mInfluences + k])), _mm_set1_ps(mBoneWeights[(i + 1) * mInfluences + k]), 1);
+
+            for (unsigned int col = 0; col < 4; ++col)
+            {
+                const __m256 lColumn = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(rFirst + col * 4)), _mm_loadu_ps(rSecond + col * 4), 1);
+                c[col] = _mm256_add_ps(c[col], _mm256_mul_ps(lColumn, w));
+            }
+        }
+
+        const vec3f & rP0 = mPositions[i];
+        const vec3f & rP1 = mPositions[i + 1];
+        const vec3f & rN0 = mNormals[i];
+        const vec3f & rN1 = mNormals[i + 1];
+
+        __m256 lPosition = _mm256_add_ps(c[3], _mm256_mul_ps(c[0], _mm256_set_ps(rP1.x(), rP1.x(), rP1.x(), rP1.x(), rP0.x(), rP0.x(), rP0.x(), rP0.x())));
+        lPosition = _mm256_add_ps(lPosition, _mm256_mul_ps(c[1], _mm256_set_ps(rP1.y(), rP1.y(), rP1.y(), rP1.y(), rP0.y(), rP0.y(), rP0.y(), rP0.y())));
+        lPosition = _mm256_add_ps(lPosition, _mm256_mul_ps(c[2], _mm256_set_ps(rP1.z(), rP1.z(), rP1.z(), rP1.z(), rP0.z(), rP0.z(), rP0.z(), rP0.z())));
+
+        _mm256_storeu_ps(lResult, lPosition);
+        pPositions[i] = vec3f(lResult[0], lResult[1], lResult[2]);
+        pPositions[i + 1] = vec3f(lResult[4], lResult[5], lResult[6]);
+
+        __m256 lNormal = _mm256_mul_ps(c[0], _mm256_set_ps(rN1.x(), rN1.x(), rN1.x(), rN1.x(), rN0.x(), rN0.x(), rN0.x(), rN0.x()));
+        lNormal = _mm256_add_ps(lNormal, _mm256_mul_ps(c[1], _mm256_set_ps(rN1.y(), rN1.y(), rN1.y(), rN1.y(), rN0.y(), rN0.y(), rN0.y(), rN0.y())));
+        lNormal = _mm256_add_ps(lNormal, _mm256_mul_ps(c[2], _mm256_set_ps(rN1.z(), rN1.z(), rN1.z(), rN1.z(), rN0.z(), rN0.z(), rN0.z(), rN0.z())));
+
+        _mm256_storeu_ps(lResult, lNormal);
+        pNormals[i] = vec3f(lResult[0], lResult[1], lResult[2]);
+        pNormals[i + 1] = vec3f(lResult[4], lResult[5], lResult[6]);
+    }
+#endif
+
+#if defined(MINIGL_CPU_SKINNING_AVX) || defined(MINIGL_CPU_SKINNING_SSE2)
+    // The 4th component is not written to the output because it would overwrite the next vertex, maybe owned by another thread
+    float lVertex[4];
+
+    for (; i < pEnd; ++i)
+    {
+        __m128 c[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+
+        for (unsigned int k = 0; k < mInfluences; ++k)
+        {
+            const float* rColumns = mColumns.data() + mBoneIDs[i * mInfluences + k] * 16;
+            const __m128 w = _mm_set1_ps(mBoneWeights[i * mInfluences + k]);
+
+            for (unsigned int col = 0; col < 4; ++col)
+                c[col] = _mm_add_ps(c[col], _mm_mul_ps(_mm_loadu_ps(rColumns + col * 4), w));
+        }
+
+        const vec3f & rP = mPositions[i];
+        const vec3f & rN = mNormals[i];
+
+        const __m128 lPosition = _mm_add_ps(_mm_add_ps(c[3], _mm_mul_ps(c[0], _mm_set1_ps(rP.x()))), _mm_add_ps(_mm_mul_ps(c[1], _mm_set1_ps(rP.y())), _mm_mul_ps(c[2], _mm_set1_ps(rP.z()))));
+        _mm_storeu_ps(lVertex, lPosition);
+        pPositions[i] = vec3f(lVertex[0], lVertex[1], lVertex[2]);
+
+        const __m128 lNormal = _mm_add_ps(_mm_mul_ps(c[0], _mm_set1_ps(rN.x())), _mm_add_ps(_mm_mul_ps(c[1], _mm_set1_ps(rN.y())), _mm_mul_ps(c[2], _mm_set1_ps(rN.z()))));
+        _mm_storeu_ps(lVertex, lNormal);
+        pNormals[i] = vec3f(lVertex[0], lVertex[1], lVertex[2]);
+    }
+#else
+    for (; i < pEnd; ++i)
+    {
+        float c[16] = {};
+
+        for (unsigned int k = 0; k < mInfluences; ++k)
+        {
+            const float* rColumns = mColumns.data() + mBoneIDs[i * mInfluences + k] * 16;
+            const float w = mBoneWeights[i * mInfluences + k];
+
+            for (unsigned int j = 0; j < 16; ++j)
+                c[j] += rColumns[j] * w;
+        }
+
+        const vec3f & rP = mPositions[i];
+        const vec3f & rN = mNormals[i];
+
+        pPositions[i] = vec3f(c[0] * rP.x() + c[4] * rP.y() + c[8] * rP.z() + c[12],
+                              c[1] * rP.x() + c[5] * rP.y() + c[9] * rP.z() + c[13],
+                              c[2] * rP.x() + c[6] * rP.y() + c[10] * rP.z() + c[14]);
+
+        pNormals[i] = vec3f(c[0] * rN.x() + c[4] * rN.y() + c[8] * rN.z(),
+                            c[1] * rN.x() + c[5] * rN.y() + c[9] * rN.z(),
+                            c[2] * rN.x() + c[6] * rN.y() + c[10] * rN.z());
+    }
+#endif
+}
@@ -0,0 +1,78 @@
+//===============================================================================================//
+/*!
+ *  \file      CPUSkinning.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include "Algebra.hpp"
+#include "PackedBoneData.hpp"
+#include "JobSystem.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class deforms the vertices of a skinned mesh on the CPU
+     *  \details It is used by the techniques that need the animated geometry without running Skinning.vert, e.g.
+     *           shadow volumes, picking or bounds. The bind pose is copied once, and for each pose the bone matrices
+     *           are blended per vertex with SIMD instructions (2 vertices per iteration with AVX, 1 with SSE2, scalar
+     *           code otherwise). The vertices can be split between the threads of a JobSystem.
+     */
+    class CPUSkinning
+    {
+    public:
+        /*!
+         *  \brief Copy the bind pose of the vertices
+         *  @param pPositions contains the position of each vertex
+         *  @param pNormals contains the normal of each vertex
+         *  @param pBones contains the bone IDs and weights of each vertex
+         */
+        void init(const std::vector<vec3f> & pPositions, const std::vector<vec3f> & pNormals, const PackedBoneData & pBones);
+
+        /*!
+         *  \brief Get the number of vertices
+         *  @return the number of vertices copied by init
+         */
+        unsigned int vertexCount(void) const noexcept;
+
+        /*!
+         *  \brief Deform the vertices with a pose
+         *  @param pTransforms contains the transformation of each bone, e.g. computed by Skeleton::pose
+         *  @param pBoneCount is the number of matrices in pTransforms
+         *  @param pPositions points to an array with room for vertexCount() positions
+         *  @param pNormals points to an array with room for vertexCount() normals (not normalized)
+         *  @param pJobSystem splits the vertices between several threads, or nullptr to skin them on the calling thread
+         */
+        void skin(const mat4f* pTransforms, unsigned int pBoneCount, vec3f* pPositions, vec3f* pNormals, JobSystem* pJobSystem = nullptr);
+
+        /*!
+         *  \brief Remove all the vertices
+         */
+        void clear(void);
+
+    private:
+        /*!
+         *  \brief Helper method to deform a range of vertices
+         *  @param pBegin is the index of the first vertex
+         *  @param pEnd is the index after the last vertex
+         *  @param pPositions points to the deformed positions
+         *  @param pNormals points to the deformed normals
+         */
+        void _skin(unsigned int pBegin, unsigned int pEnd, vec3f* pPositions, vec3f* pNormals) const;
+
+    private:
+        std::vector<vec3f> mPositions;
+        std::vector<vec3f> mNormals;
+        std::vector<unsigned int> mBoneIDs;     //!< mInfluences bone IDs per vertex
+        std::vector<float> mBoneWeights;        //!< mInfluences weights per vertex
+        std::vector<float> mColumns;            //!< 4 columns of 4 floats per bone (x, y, z, 0), the last one is the translation
+        unsigned int mInfluences = 4;
+
+    }; // class CPUSkinning
+
+} // namespace miniGL
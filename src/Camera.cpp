@@ -21,6 +21,7 @@ using miniGL::Exceptions;
 Camera::Camera(void)
 :mView(1.0)
 ,mProjection(1.0)
+,mViewProjection(1.0)
 ,mMouseRotation(1.0)
 ,mPosition(0.0f)
 ,mLookAt({0.0f, 0.0f, 1.0f})
@@ -37,6 +38,7 @@ Camera::Camera(void)
 //,mMouseLeftButtonPressed(false)
 ,mViewHasChanged(true)
 ,mProjectionHasChanged(true)
+,mViewProjectionHasChanged(true)
 {
     vec3f lHorizontalTarget({mLookAt.x(), 0.0f, mLookAt.z()});
     lHorizontalTarget.normalize();
@@ -76,6 +78,7 @@ Camera::Camera(const Camera & pCamera)
 
     mView = pCamera.mView;
     mProjection = pCamera.mProjection;
+    mViewProjection = pCamera.mViewProjection;
 
     mMouseRotation = pCamera.mMouseRotation;
 
@@ -102,6 +105,7 @@ Camera::Camera(const Camera & pCamera)
 
     mViewHasChanged = pCamera.mViewHasChanged;
     mProjectionHasChanged = pCamera.mProjectionHasChanged;
+    mViewProjectionHasChanged = pCamera.mViewProjectionHasChanged;
 }
 
 Camera Camera::operator=(const Camera & pCamera)
@@ -114,6 +118,7 @@ Camera Camera::operator=(const Camera & pCamera)
 
         mView = pCamera.mView;
         mProjection = pCamera.mProjection;
+        mViewProjection = pCamera.mViewProjection;
 
         mMouseRotation = pCamera.mMouseRotation;
 
@@ -140,6 +145,7 @@ Camera Camera::operator=(const Camera & pCamera)
 
         mViewHasChanged = pCamera.mViewHasChanged;
         mProjectionHasChanged = pCamera.mProjectionHasChanged;
+        mViewProjectionHasChanged = pCamera.mViewProjectionHasChanged;
     }
 
     return *this;
@@ -191,6 +197,7 @@ const mat4f & Camera::view(void)
     {
         _updateView();
         mViewHasChanged = false;
+        mViewProjectionHasChanged = true;
     }
 
     return mView;
@@ -202,11 +209,27 @@ const mat4f & Camera::projection(void)
     {
         _updateProjection();
         mProjectionHasChanged = false;
+        mViewProjectionHasChanged = true;
     }
 
     return mProjection;
 }
 
+const mat4f & Camera::viewProjection(void)
+{
+    // Updating the view or the projection raises mViewProjectionHasChanged
+    const mat4f & lProjection = projection();
+    const mat4f & lView = view();
+
+    if (mViewProjectionHasChanged)
+    {
+        mViewProjection = lProjection * lView;
+        mViewProjectionHasChanged = false;
+    }
+
+    return mViewProjection;
+}
+
 mat4f Camera::orthogonalProjection(size_t pIndex)
 {
     assert(pIndex < mOrthogonalProjection.size());
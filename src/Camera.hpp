@@ -118,6 +118,12 @@ namespace miniGL
          */
         const mat4f & projection(void);
 
+        /*!
+         *  \brief Get the product of the projection and view matrices, only computed again when one of them changed
+         *  @return a 4x4 matrix transforming world coordinates into the clip coordinates of the camera
+         */
+        const mat4f & viewProjection(void);
+
         /*!
          *  \brief Get an orthogonal projection matrix
          *  @param pIndex allows to select which orthogonal projection to get
@@ -241,6 +247,7 @@ namespace miniGL
 
         mat4f mView;
         mat4f mProjection;
+        mat4f mViewProjection;
 
         mat4f mMouseRotation;
 
@@ -270,6 +277,7 @@ namespace miniGL
 
         bool mViewHasChanged;
         bool mProjectionHasChanged;
+        bool mViewProjectionHasChanged;
 
     }; // class Camera
 
@@ -0,0 +1,69 @@
+//===============================================================================================//
+/*!
+ *  \file      CameraUniformBuffer.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "CameraUniformBuffer.hpp"
+
+#include "EngineCommon.hpp"
+#include "GLUtils.hpp"
+
+using miniGL::CameraUniformBuffer;
+using miniGL::PackedCamera;
+using miniGL::Camera;
+
+GLuint CameraUniformBuffer::mBuffer = 0;
+PackedCamera CameraUniformBuffer::mPackedCamera;
+
+bool CameraUniformBuffer::attach(GLuint pProgram)
+{
+    const GLuint lBlockIndex = glGetUniformBlockIndex(pProgram, "CameraBlock");
+
+    if (lBlockIndex == GL_INVALID_INDEX)
+        return false;
+
+    // GLSL 3.30 cannot set the binding point in the shader
+    glUniformBlockBinding(pProgram, lBlockIndex, CAMERA_UNIFORM_BLOCK_BINDING); checkOpenGLState;
+
+    return true;
+}
+
+void CameraUniformBuffer::update(Camera & pCamera, unsigned int pWidth, unsigned int pHeight, float pTime)
+{
+    if (mBuffer == 0)
+    {
+        glGenBuffers(1, & mBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(PackedCamera::Block), nullptr, GL_DYNAMIC_DRAW);
+
+        // The binding point is only used by this buffer, it is bound once
+        glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BLOCK_BINDING, mBuffer); checkOpenGLState;
+    }
+
+    mPackedCamera.pack(pCamera, pWidth, pHeight, pTime);
+
+    if (mPackedCamera.dirtySize() == 0)
+        return;
+
+    const unsigned char* lData = reinterpret_cast<const unsigned char*>(& mPackedCamera.block());
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, mPackedCamera.dirtyOffset(), mPackedCamera.dirtySize(), lData + mPackedCamera.dirtyOffset()); checkOpenGLState;
+
+    mPackedCamera.clean();
+}
+
+void CameraUniformBuffer::clear(void)
+{
+    if (mBuffer == 0)
+        return;
+
+    glDeleteBuffers(1, & mBuffer);
+    mBuffer = 0;
+
+    // Everything is uploaded again in the next buffer
+    mPackedCamera = PackedCamera();
+}
@@ -0,0 +1,55 @@
+//===============================================================================================//
+/*!
+ *  \file      CameraUniformBuffer.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include "Camera.hpp"
+#include "PackedCamera.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class is the uniform buffer object with the camera parameters read by the programs
+     *  \details The CameraBlock uniform block of every program is attached to the CAMERA_UNIFORM_BLOCK_BINDING binding
+     *           point when the program is linked. The block is updated once per frame, before rendering the current
+     *           technique, so the programs only receive the world matrices of the meshes. Like LightUniformBuffer, the
+     *           methods are static since there is a single OpenGL context.
+     */
+    class CameraUniformBuffer
+    {
+    public:
+        /*!
+         *  \brief Attach the CameraBlock uniform block of a program to the binding point of the buffer
+         *  @param pProgram is a linked program
+         *  @return false if the program does not have a CameraBlock uniform block
+         */
+        static bool attach(GLuint pProgram);
+
+        /*!
+         *  \brief Update the camera read by the next draw calls, the buffer is created on the first call
+         *  @param pCamera is the camera of the frame
+         *  @param pWidth is the width of the viewport in pixels
+         *  @param pHeight is the height of the viewport in pixels
+         *  @param pTime is the running time in seconds
+         */
+        static void update(Camera & pCamera, unsigned int pWidth, unsigned int pHeight, float pTime);
+
+        /*!
+         *  \brief Delete the buffer, e.g. before destroying the OpenGL context
+         */
+        static void clear(void);
+
+    private:
+        static GLuint mBuffer;
+        static PackedCamera mPackedCamera;
+
+    }; // class CameraUniformBuffer
+
+} // namespace miniGL
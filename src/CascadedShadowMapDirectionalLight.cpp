@@ -51,6 +51,7 @@ void CascadedShadowMapDirectionalLight::init(const std::string & pPathVS, const
     use();
 
     mWVPLocation = Program::uniformLocation("uWVP");
+    mInstancedLocation = Program::uniformLocation("uInstanced");
 
     // Check if we correctly initialized the uniform variables
     if (!checkUniformLocations())
@@ -62,7 +63,13 @@ void CascadedShadowMapDirectionalLight::WVP(const mat4f & pWVP)
     glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f &>(pWVP).data());
 }
 
+void CascadedShadowMapDirectionalLight::instanced(bool pValue)
+{
+    glUniform1i(mInstancedLocation, pValue ? 1 : 0);
+}
+
 bool CascadedShadowMapDirectionalLight::checkUniformLocations(void) const
 {
-    return mWVPLocation != Constants::invalidUniformLocation<GLuint>();
+    return (mWVPLocation != Constants::invalidUniformLocation<GLuint>() &&
+            mInstancedLocation != Constants::invalidUniformLocation<GLuint>());
 }
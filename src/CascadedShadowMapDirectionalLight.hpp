@@ -43,6 +43,13 @@ namespace miniGL
          */
         void WVP(const mat4f & pWVP);
 
+        /*!
+         *  \brief Choose where the vertex shader reads the matrices
+         *  @param pValue is true to read them from the instance streams of the mesh (see MeshBase::instancing),
+         *         false to read them from the uniforms
+         */
+        void instanced(bool pValue);
+
     private:
         /*!
          *  \brief Implementation of a virtual method from Program
@@ -51,6 +58,7 @@ namespace miniGL
 
     private:
         GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mInstancedLocation = Constants::invalidUniformLocation<GLuint>();
 
     }; // class CascadedShadowMapDirectionalLight
 
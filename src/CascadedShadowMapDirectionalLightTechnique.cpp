@@ -8,13 +8,14 @@
 
 #include "CascadedShadowMapDirectionalLightTechnique.hpp"
 
+#include <functional>
 #include <numeric>
 
 #include "Exceptions.hpp"
 #include "EngineCommon.hpp"
 #include "DirectionalLight.hpp"
+#include "GLStateCache.hpp"
 
-using std::map;
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -27,8 +28,12 @@ using std::numeric_limits;
 using miniGL::CascadedShadowMapDirectionalLightTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
 using miniGL::DirectionalLight;
+using miniGL::GLStateCache;
+using miniGL::DrawList;
+using miniGL::DrawPacket;
 
 CascadedShadowMapDirectionalLightTechnique::CascadedShadowMapDirectionalLightTechnique(void)
 :RenderingTechniqueBase("CascadedShadowMapDirectionalLightTechnique")
@@ -56,6 +61,10 @@ void CascadedShadowMapDirectionalLightTechnique::init(const tuple<unsigned int,
     mCascadedShadowMapDirectionalLightLighting->materialSpecularIntensity(0.0f);
     mCascadedShadowMapDirectionalLightLighting->materialSpecularPower(0.0f);
 
+    // Set by the draw list when replaying the packets
+    mWVPLocation = mCascadedShadowMapDirectionalLightLighting->uniformLocation("uWVP");
+    mWorldLocation = mCascadedShadowMapDirectionalLightLighting->uniformLocation("uWorld");
+
     // Limits of each cascade between near and far planes in the frustrum
     mCascadeEnds[0] = mCamera->nearPlane();
     mCascadeEnds[1] = 25.0f;
@@ -70,25 +79,26 @@ void CascadedShadowMapDirectionalLightTechnique::init(const tuple<unsigned int,
     }
 }
 
-void CascadedShadowMapDirectionalLightTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void CascadedShadowMapDirectionalLightTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     // Find the graphical meshes to render
-    auto lMeshReferences = findMeshesToRender(pMeshes);
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
 
     // Find the mesh representing the "floor"
-    auto lFloorIterator = pMeshes.find(mFloorMeshName);
-    assert(lFloorIterator != pMeshes.end());
+    const auto & rFloor = mFloorMesh.meshes(pMeshes);
+    assert(rFloor.size() == 1 && "The floor is not in the mesh registry");
 
     assert(pLights[0]->type() == BaseLight::EType::DIRECTIONAL);
     auto lDirectionalLight = static_pointer_cast<DirectionalLight>(pLights[0]);
 
     _shadowPass(lMeshReferences, lDirectionalLight);
-    _renderPass(lMeshReferences, lFloorIterator, lDirectionalLight);
+    _renderPass(lMeshReferences, *rFloor[0], lDirectionalLight);
 }
 
 void CascadedShadowMapDirectionalLightTechnique::floor(const string & pName)
 {
-    mFloorMeshName = pName;
+    mFloorMesh.clear();
+    mFloorMesh.add(pName);
 }
 void CascadedShadowMapDirectionalLightTechnique::_computeOrthogonalProjection(shared_ptr<DirectionalLight> pLight)
 {
@@ -160,7 +170,7 @@ void CascadedShadowMapDirectionalLightTechnique::_computeOrthogonalProjection(sh
     }
 }
 
-void CascadedShadowMapDirectionalLightTechnique::_shadowPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, shared_ptr<DirectionalLight> pLight)
+void CascadedShadowMapDirectionalLightTechnique::_shadowPass(const vector<const MeshAndTransform*> & pMeshes, shared_ptr<DirectionalLight> pLight)
 {
     _computeOrthogonalProjection(pLight);
 
@@ -178,24 +188,21 @@ void CascadedShadowMapDirectionalLightTechnique::_shadowPass(vector<map<string,
         mCascadedShadowMapFBO->bindForWriting(i);
         glClear(GL_DEPTH_BUFFER_BIT);
 
-        for (auto it : pMeshIterators)
-        {
-            for (auto transform : it->second.transform)
-            {
-                mat4f lWorld = transform.final();
-                mat4f lWVP = lTmpCamera.orthogonalProjection(i) * lTmpCamera.view() * lWorld;
+        // Each cascade only renders the meshes inside its own light frustum
+        const mat4f lLightViewProjection = lTmpCamera.orthogonalProjection(i) * lTmpCamera.view();
 
-                mCascadedShadowMapDirectionalLight->WVP(lWVP);
+        cull(pMeshes, lLightViewProjection, mVisibleTransforms);
 
-                it->second.mesh->render();
-            }
-        }
+        renderInstanced(mVisibleTransforms, lLightViewProjection, [this](bool pInstanced){ mCascadedShadowMapDirectionalLight->instanced(pInstanced); }, [this](const mat4f & pWVP, const mat4f &)
+        {
+            mCascadedShadowMapDirectionalLight->WVP(pWVP);
+        });
     }
 }
 
-void CascadedShadowMapDirectionalLightTechnique::_renderPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, map<string, MeshAndTransform>::const_iterator & pFloorIterator, shared_ptr<DirectionalLight> pLight)
+void CascadedShadowMapDirectionalLightTechnique::_renderPass(const vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, shared_ptr<DirectionalLight> pLight)
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     mCascadedShadowMapDirectionalLightLighting->use();
@@ -210,7 +217,7 @@ void CascadedShadowMapDirectionalLightTechnique::_renderPass(vector<map<string,
     lTmpCamera.up(vec3f(0.0f, 1.0f, 0.0f));
 
     // Configure the WVP for the light with the orthogonal projection
-    mat4f lWorld = pFloorIterator->second.transform[0].final();
+    mat4f lWorld = pFloor.transform.world(0);
 
     for (size_t i = 0; i < mCascadedShadowMapFBO->size(); i++)
     {
@@ -222,24 +229,39 @@ void CascadedShadowMapDirectionalLightTechnique::_renderPass(vector<map<string,
     mCascadedShadowMapDirectionalLightLighting->updateDirectionalLightState(pLight);
 
     // Configure the WVP for the quad, with the normal perspective projection of the camera
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    mat4f lWVP = pFloor.transform.WVP(0);
     mCascadedShadowMapDirectionalLightLighting->world(lWorld);
     mCascadedShadowMapDirectionalLightLighting->WVP(lWVP);
 
     // Render the shadow on the floor
-    pFloorIterator->second.mesh->render();
+    pFloor.mesh->render();
 
-    for (auto it : pMeshIterators)
-    {
-        for (auto transform : it->second.transform)
-        {
-            mat4f lWorld = transform.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view()  * lWorld;
+    const mat4f lViewProjection = mCamera->viewProjection();
 
-            mCascadedShadowMapDirectionalLightLighting->world(lWorld);
-            mCascadedShadowMapDirectionalLightLighting->WVP(lWVP);
+    cull(pMeshes, lViewProjection, mVisibleTransforms);
 
-            it->second.mesh->render();
-        }
-    }
+    DrawPacket lPacket;
+    lPacket.program = mCascadedShadowMapDirectionalLightLighting->id();
+    lPacket.matrixLocations[0] = mWVPLocation;
+    lPacket.matrixLocations[1] = mWorldLocation;
+    lPacket.matrixCount = 2;
+
+    auto lRecordItem = [this, lPacket](unsigned int pItem, DrawList::Recorder & rRecorder)
+    {
+        const MeshAndTransform & rMesh = *mVisibleTransforms[pItem].mesh;
+        const unsigned int lTransform = mVisibleTransforms[pItem].transform;
+        const mat4f lMatrices[] = { rMesh.transform.WVP(lTransform), rMesh.transform.world(lTransform) };
+
+        DrawPacket lMeshPacket = lPacket;
+        lMeshPacket.depth = lMatrices[0](3,3);
+        lMeshPacket.matrixOffset = rRecorder.matrices(lMatrices, 2);
+        rMesh.mesh->record(rRecorder, lMeshPacket);
+    };
+
+    // By reference, std::function would copy the captures on the heap
+    mDrawList.record(static_cast<unsigned int>(mVisibleTransforms.size()), std::cref(lRecordItem));
+
+    // Grouped by VAO and texture, then front to back
+    mDrawList.sort();
+    mDrawList.submit();
 }
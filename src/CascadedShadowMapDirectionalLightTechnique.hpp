@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "CascadedShadowMapFBO.hpp"
@@ -18,6 +17,7 @@
 #include "MeshAndTransform.hpp"
 #include "BaseLight.hpp"
 #include "Constants.hpp"
+#include "DrawList.hpp"
 
 namespace miniGL
 {
@@ -44,7 +44,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Set the name of the mesh representing the "floor"
@@ -62,19 +62,22 @@ namespace miniGL
         /*!
          *  \brief Helper function
          */
-        void _shadowPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::shared_ptr<DirectionalLight> pLight);
+        void _shadowPass(const std::vector<const MeshAndTransform*> & pMeshes, std::shared_ptr<DirectionalLight> pLight);
 
         /*!
          *  \brief Helper function
          */
-        void _renderPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::map<std::string, MeshAndTransform>::const_iterator & pFloorIterator, std::shared_ptr<DirectionalLight> pLight);
+        void _renderPass(const std::vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, std::shared_ptr<DirectionalLight> pLight);
 
     private:
         std::unique_ptr<CascadedShadowMapFBO> mCascadedShadowMapFBO;
         std::unique_ptr<CascadedShadowMapDirectionalLight> mCascadedShadowMapDirectionalLight;
         std::unique_ptr<CascadedShadowMapDirectionalLightLighting> mCascadedShadowMapDirectionalLightLighting;
         std::array<float, 4> mCascadeEnds;
-        std::string mFloorMeshName;
+        MeshSelection mFloorMesh;
+        DrawList mDrawList;
+        GLint mWVPLocation = -1;
+        GLint mWorldLocation = -1;
     }; // class CascadedShadowMapDirectionalLightTechnique
 
 } // namespace miniGL
@@ -14,11 +14,13 @@
 #include "Exceptions.hpp"
 #include "GLUtils.hpp"
 #include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::to_string;
 using miniGL::CascadedShadowMapFBO;
 using miniGL::Exceptions;
+using miniGL::GLStateCache;
 
 CascadedShadowMapFBO::CascadedShadowMapFBO(void)
 :mFBO(0),
@@ -30,10 +32,10 @@ mShadowMap{{0, 0, 0}}
 CascadedShadowMapFBO::~CascadedShadowMapFBO(void)
 {
     if (mFBO != 0)
-        glDeleteFramebuffers(1, & mFBO);
+        GLStateCache::deleteFramebuffers(1, & mFBO);
 
     if (mShadowMap[0] != 0)
-        glDeleteTextures(mShadowMap.size(), mShadowMap.data());
+        GLStateCache::deleteTextures(mShadowMap.size(), mShadowMap.data());
 }
 
 void CascadedShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
@@ -46,7 +48,7 @@ void CascadedShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowH
 
     for (auto it : mShadowMap)
     {
-        glBindTexture(GL_TEXTURE_2D, it); checkOpenGLState;
+        GLStateCache::bindTexture(GL_TEXTURE_2D, it); checkOpenGLState;
         glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32, pWindowWidth, pWindowHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr); checkOpenGLState;
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); checkOpenGLState;
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); checkOpenGLState;
@@ -55,7 +57,7 @@ void CascadedShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowH
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); checkOpenGLState;
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
 
     // Draw the result of the depth test into the texture associated to the frame buffer
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, mShadowMap[0], 0); checkOpenGLState;
@@ -80,20 +82,20 @@ void CascadedShadowMapFBO::bindForWriting(unsigned int pCascadeIndex)
 {
     assert(pCascadeIndex < mShadowMap.size() && "Wrong cascade index in shadow map");
 
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, mShadowMap[pCascadeIndex], 0);
 }
 
 void CascadedShadowMapFBO::bindForReading(void)
 {
-    glActiveTexture(CASCADE_SHADOW_TEXTURE_UNIT0);
-    glBindTexture(GL_TEXTURE_2D, mShadowMap[0]);
+    GLStateCache::activeTexture(CASCADE_SHADOW_TEXTURE_UNIT0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mShadowMap[0]);
 
-    glActiveTexture(CASCADE_SHADOW_TEXTURE_UNIT1);
-    glBindTexture(GL_TEXTURE_2D, mShadowMap[1]);
+    GLStateCache::activeTexture(CASCADE_SHADOW_TEXTURE_UNIT1);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mShadowMap[1]);
 
-    glActiveTexture(CASCADE_SHADOW_TEXTURE_UNIT2);
-    glBindTexture(GL_TEXTURE_2D, mShadowMap[2]);
+    GLStateCache::activeTexture(CASCADE_SHADOW_TEXTURE_UNIT2);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mShadowMap[2]);
 }
 
 size_t CascadedShadowMapFBO::size(void) const noexcept
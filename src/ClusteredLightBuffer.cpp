@@ -0,0 +1,170 @@
+//===============================================================================================//
+/*!
+ *  \file      ClusteredLightBuffer.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "ClusteredLightBuffer.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#include "EngineCommon.hpp"
+#include "GLUtils.hpp"
+#include "GLStateCache.hpp"
+
+// Number of bytes of lights and items that a frame can write before the ring buffer grows
+#define CLUSTERED_LIGHT_RING_SIZE (256 * 1024)
+
+using std::vector;
+using std::shared_ptr;
+using miniGL::ClusteredLightBuffer;
+using miniGL::LightClusters;
+using miniGL::DynamicRingBuffer;
+using miniGL::GLStateCache;
+using miniGL::BaseLight;
+using miniGL::Camera;
+using miniGL::JobSystem;
+
+LightClusters ClusteredLightBuffer::mClusters;
+DynamicRingBuffer ClusteredLightBuffer::mBuffer;
+GLuint ClusteredLightBuffer::mUniformBuffer = 0;
+GLuint ClusteredLightBuffer::mLightsTexture = 0;
+GLuint ClusteredLightBuffer::mItemsTexture = 0;
+GLuint ClusteredLightBuffer::mAttachedBuffer = 0;
+mat4f ClusteredLightBuffer::mView;
+mat4f ClusteredLightBuffer::mProjection;
+float ClusteredLightBuffer::mNearPlane = 0.0f;
+float ClusteredLightBuffer::mFarPlane = 0.0f;
+JobSystem* ClusteredLightBuffer::mJobSystem = nullptr;
+vector<unsigned int> ClusteredLightBuffer::mBuiltIndices;
+bool ClusteredLightBuffer::mStale = true;
+
+bool ClusteredLightBuffer::attach(GLuint pProgram)
+{
+    const GLuint lBlockIndex = glGetUniformBlockIndex(pProgram, "ClusterBlock");
+
+    if (lBlockIndex == GL_INVALID_INDEX)
+        return false;
+
+    // GLSL 3.30 cannot set the binding point nor the texture units in the shader
+    glUniformBlockBinding(pProgram, lBlockIndex, CLUSTERS_UNIFORM_BLOCK_BINDING); checkOpenGLState;
+    glUniform1i(glGetUniformLocation(pProgram, "uClusterLights"), CLUSTER_LIGHTS_TEXTURE_UNIT_INDEX);
+    glUniform1i(glGetUniformLocation(pProgram, "uClusterItems"), CLUSTER_ITEMS_TEXTURE_UNIT_INDEX); checkOpenGLState;
+
+    return true;
+}
+
+void ClusteredLightBuffer::camera(Camera & pCamera, JobSystem* pJobSystem)
+{
+    mView = pCamera.view();
+    mProjection = pCamera.projection();
+    mNearPlane = pCamera.nearPlane();
+    mFarPlane = pCamera.farPlane();
+    mJobSystem = pJobSystem;
+
+    // The lights can also move from one frame to the next
+    mStale = true;
+}
+
+void ClusteredLightBuffer::update(const vector<shared_ptr<BaseLight>> & pLights, const vector<unsigned int> & pIndices)
+{
+    assert(mFarPlane > 0.0f && "The camera of the frame must be set before updating the clusters");
+
+    if (mUniformBuffer == 0)
+        _init();
+
+    // The techniques rendering several programs with the same lights only build the clusters once
+    if (mStale || pIndices != mBuiltIndices)
+    {
+        mClusters.build(mView, mProjection, mNearPlane, mFarPlane, pLights, pIndices, mJobSystem);
+
+        mBuiltIndices = pIndices;
+        mStale = false;
+
+        const vector<LightClusters::LightData> & rLights = mClusters.lights();
+        const vector<unsigned int> & rItems = mClusters.items();
+
+        const GLsizeiptr lLightsSize = static_cast<GLsizeiptr>(sizeof(LightClusters::LightData) * rLights.size());
+        const GLsizeiptr lItemsSize = static_cast<GLsizeiptr>(sizeof(unsigned int) * rItems.size());
+
+        // A single allocation, so that both textures read from the same buffer object
+        const DynamicRingBuffer::Allocation lAllocation = mBuffer.allocate(lLightsSize + lItemsSize, sizeof(LightClusters::LightData));
+        unsigned char* lData = static_cast<unsigned char*>(lAllocation.data);
+
+        if (lLightsSize > 0)
+            std::memcpy(lData, rLights.data(), static_cast<std::size_t>(lLightsSize));
+
+        std::memcpy(lData + lLightsSize, rItems.data(), static_cast<std::size_t>(lItemsSize));
+        mBuffer.commit(lAllocation);
+
+        // The ring buffer grew, its buffer object was replaced
+        if (mBuffer.id() != mAttachedBuffer)
+            _attach();
+
+        const Block lBlock =
+        {
+            { LIGHT_CLUSTERS_X, LIGHT_CLUSTERS_Y, LIGHT_CLUSTERS_Z, static_cast<int>(rLights.size()) },
+            { mClusters.depthScale(), mClusters.depthBias(), 0.0f, 0.0f },
+            { static_cast<int>(lAllocation.offset / sizeof(LightClusters::LightData)), static_cast<int>((lAllocation.offset + lLightsSize) / sizeof(unsigned int)), 0, 0 }
+        };
+
+        glBindBuffer(GL_UNIFORM_BUFFER, mUniformBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Block), & lBlock); checkOpenGLState;
+    }
+
+    GLStateCache::activeTexture(CLUSTER_LIGHTS_TEXTURE_UNIT);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, mLightsTexture);
+    GLStateCache::activeTexture(CLUSTER_ITEMS_TEXTURE_UNIT);
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, mItemsTexture);
+}
+
+void ClusteredLightBuffer::clear(void)
+{
+    if (mUniformBuffer == 0)
+        return;
+
+    glDeleteBuffers(1, & mUniformBuffer);
+    mUniformBuffer = 0;
+
+    GLStateCache::deleteTextures(1, & mLightsTexture);
+    GLStateCache::deleteTextures(1, & mItemsTexture);
+    mLightsTexture = 0;
+    mItemsTexture = 0;
+
+    mBuffer.clear();
+    mAttachedBuffer = 0;
+
+    // Everything is built again in the next buffers
+    mBuiltIndices.clear();
+    mStale = true;
+}
+
+void ClusteredLightBuffer::_init(void)
+{
+    mBuffer.init(GL_TEXTURE_BUFFER, CLUSTERED_LIGHT_RING_SIZE);
+
+    glGenTextures(1, & mLightsTexture);
+    glGenTextures(1, & mItemsTexture); checkOpenGLState;
+    _attach();
+
+    glGenBuffers(1, & mUniformBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, mUniformBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), nullptr, GL_DYNAMIC_DRAW);
+
+    // The binding point is only used by this buffer, it is bound once
+    glBindBufferBase(GL_UNIFORM_BUFFER, CLUSTERS_UNIFORM_BLOCK_BINDING, mUniformBuffer); checkOpenGLState;
+}
+
+void ClusteredLightBuffer::_attach(void)
+{
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, mLightsTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, mBuffer.id());
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, mItemsTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, mBuffer.id()); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_BUFFER, 0);
+
+    mAttachedBuffer = mBuffer.id();
+}
@@ -0,0 +1,99 @@
+//===============================================================================================//
+/*!
+ *  \file      ClusteredLightBuffer.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <vector>
+
+#include "Algebra.hpp"
+#include "Camera.hpp"
+#include "BaseLight.hpp"
+#include "JobSystem.hpp"
+#include "LightClusters.hpp"
+#include "DynamicRingBuffer.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class holds the light clusters read by the clustered lighting programs
+     *  \details The lights and the lists of lights of the clusters are written in a DynamicRingBuffer read through two
+     *           texture buffers, and the ClusterBlock uniform block gives the grid and where the data of the frame
+     *           starts in the textures. The clusters are built at most once per frame and per selection of lights,
+     *           the first time a lighting program updates its lights. Like LightUniformBuffer, the methods are static
+     *           since there is a single OpenGL context.
+     */
+    class ClusteredLightBuffer
+    {
+    public:
+        /*!
+         *  \brief Attach the ClusterBlock uniform block and the light textures of a program
+         *  @param pProgram is a linked program, currently in use
+         *  @return false if the program does not have a ClusterBlock uniform block
+         */
+        static bool attach(GLuint pProgram);
+
+        /*!
+         *  \brief Set the camera of the frame, the clusters are built again on the next update
+         *  @param pCamera is the camera of the frame
+         *  @param pJobSystem builds the clusters in parallel, or nullptr to use the calling thread
+         */
+        static void camera(Camera & pCamera, JobSystem* pJobSystem);
+
+        /*!
+         *  \brief Update the clusters read by the next draw calls and bind their textures, the buffers are created on the first call
+         *  @param pLights contains all the lights of the scene
+         *  @param pIndices are the indices in pLights of the lights to use, all their point and spot lights are shaded
+         */
+        static void update(const std::vector<std::shared_ptr<BaseLight>> & pLights, const std::vector<unsigned int> & pIndices);
+
+        /*!
+         *  \brief Delete the buffers and the textures, e.g. before destroying the OpenGL context
+         */
+        static void clear(void);
+
+    private:
+        //! std140 layout of the ClusterBlock uniform block
+        struct Block
+        {
+            int gridSize[4];            //!< Number of clusters along x, y and z, then number of lights
+            float depthSlicing[4];      //!< Scale and bias giving the slice from the logarithm of the view depth
+            int firstTexels[4];         //!< First texel of the lights and first item of the frame
+        };
+
+        /*!
+         *  \brief Helper method to create the buffers and the textures
+         */
+        static void _init(void);
+
+        /*!
+         *  \brief Helper method to make the textures read from the current buffer object of the ring buffer
+         */
+        static void _attach(void);
+
+    private:
+        static LightClusters mClusters;
+        static DynamicRingBuffer mBuffer;
+        static GLuint mUniformBuffer;
+        static GLuint mLightsTexture;
+        static GLuint mItemsTexture;
+        static GLuint mAttachedBuffer;      //!< Buffer object read by the textures
+
+        static mat4f mView;
+        static mat4f mProjection;
+        static float mNearPlane;
+        static float mFarPlane;
+        static JobSystem* mJobSystem;
+
+        static std::vector<unsigned int> mBuiltIndices;     //!< Selection of the last build
+        static bool mStale;                                 //!< The camera changed since the last build
+
+    }; // class ClusteredLightBuffer
+
+} // namespace miniGL
@@ -0,0 +1,490 @@
+//===============================================================================================//
+/*!
+ *  \file      CompressedClip.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "CompressedClip.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MINIGL_COMPRESSED_CLIP_SSE2
+#endif
+
+using std::vector;
+using std::uint16_t;
+using miniGL::CompressedClip;
+using miniGL::AnimationClip;
+using miniGL::AnimationCursor;
+using miniGL::LocalPose;
+
+/*!
+ *  \brief The 3 smallest components of a unit quaternion are in [-1/sqrt(2), 1/sqrt(2)] and are stored on 15 bits
+ */
+#define SMALLEST_THREE_RANGE    0.70710678f
+#define SMALLEST_THREE_STEPS    32767.0f
+
+/*!
+ *  \brief Number of values added after the last key so that the SIMD loads of 2 keys stay in the buffers
+ */
+#define KEY_PADDING             4
+
+CompressedClip::CompressedClip(const AnimationClip & pClip, const Tolerances & pTolerances)
+{
+    compress(pClip, pTolerances);
+}
+
+void CompressedClip::compress(const AnimationClip & pClip, const Tolerances & pTolerances)
+{
+    clear();
+
+    mTicksPerSecond = pClip.ticksPerSecond();
+    mDuration = pClip.duration();
+    mTimeScale = mDuration > 0.0f ? 65535.0f / mDuration : 0.0f;
+
+    auto lQuantizeTime = [this](float pTime)
+    {
+        return static_cast<uint16_t>(std::round(std::min(std::max(pTime, 0.0f), mDuration) * mTimeScale));
+    };
+
+    // Save the kept keys of a position or scaling track, normalized over the range of each component
+    auto lQuantize3D = [&lQuantizeTime](const vector<float> & pTimes, const vector<vec3f> & pValues, const vector<unsigned int> & pKeys, vector<uint16_t> & pQuantizedTimes, vector<uint16_t> & pQuantizedValues, float* pMin, float* pStep)
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            float lMin = pValues[pKeys[0]][i];
+            float lMax = lMin;
+
+            for (unsigned int lKey : pKeys)
+            {
+                lMin = std::min(lMin, pValues[lKey][i]);
+                lMax = std::max(lMax, pValues[lKey][i]);
+            }
+
+            pMin[i] = lMin;
+            pStep[i] = (lMax - lMin) / 65535.0f;
+        }
+
+        pMin[3] = 0.0f;
+        pStep[3] = 0.0f;
+
+        for (unsigned int lKey : pKeys)
+        {
+            pQuantizedTimes.push_back(lQuantizeTime(pTimes[lKey]));
+
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                const float lValue = pStep[i] > 0.0f ? (pValues[lKey][i] - pMin[i]) / pStep[i] : 0.0f;
+                pQuantizedValues.push_back(static_cast<uint16_t>(std::round(std::min(std::max(lValue, 0.0f), 65535.0f))));
+            }
+        }
+    };
+
+    for (unsigned int i = 0; i < pClip.channelCount(); ++i)
+    {
+        const AnimationClip::Channel & rSource = pClip.channel(i);
+
+        Channel lChannel;
+        lChannel.node = rSource.node;
+
+        const vector<unsigned int> lPositionKeys = _reduce(rSource.positionTimes, rSource.positions, pTolerances.position);
+        lChannel.position = {static_cast<unsigned int>(mPositionTimes.size()), static_cast<unsigned int>(lPositionKeys.size())};
+        lQuantize3D(rSource.positionTimes, rSource.positions, lPositionKeys, mPositionTimes, mPositions, lChannel.positionMin, lChannel.positionStep);
+
+        const vector<unsigned int> lScalingKeys = _reduce(rSource.scalingTimes, rSource.scalings, pTolerances.scaling);
+        lChannel.scaling = {static_cast<unsigned int>(mScalingTimes.size()), static_cast<unsigned int>(lScalingKeys.size())};
+        lQuantize3D(rSource.scalingTimes, rSource.scalings, lScalingKeys, mScalingTimes, mScalings, lChannel.scalingMin, lChannel.scalingStep);
+
+        const vector<unsigned int> lRotationKeys = _reduce(rSource.rotationTimes, rSource.rotations, pTolerances.rotation);
+        lChannel.rotation = {static_cast<unsigned int>(mRotationTimes.size()), static_cast<unsigned int>(lRotationKeys.size())};
+
+        for (unsigned int lKey : lRotationKeys)
+        {
+            mRotationTimes.push_back(lQuantizeTime(rSource.rotationTimes[lKey]));
+
+            // Smallest three: drop the largest component, it is recomputed from the unit length.
+            // The quaternion is negated if necessary so that the dropped component is positive.
+            const quatf & rRotation = rSource.rotations[lKey];
+            float lComponents[4] = {rRotation.x(), rRotation.y(), rRotation.z(), rRotation.w()};
+
+            unsigned int lLargest = 0;
+
+            for (unsigned int j = 1; j < 4; ++j)
+            {
+                if (std::abs(lComponents[j]) > std::abs(lComponents[lLargest]))
+                    lLargest = j;
+            }
+
+            const float lSign = lComponents[lLargest] < 0.0f ? -1.0f : 1.0f;
+
+            uint16_t lQuantized[3];
+
+            for (unsigned int j = 0, k = 0; j < 4; ++j)
+            {
+                if (j == lLargest)
+                    continue;
+
+                const float lValue = (lSign * lComponents[j] + SMALLEST_THREE_RANGE) / (2.0f * SMALLEST_THREE_RANGE) * SMALLEST_THREE_STEPS;
+                lQuantized[k++] = static_cast<uint16_t>(std::round(std::min(std::max(lValue, 0.0f), SMALLEST_THREE_STEPS)));
+            }
+
+            // The index of the dropped component is stored in the lowest bit of the first two values
+            mRotations.push_back(static_cast<uint16_t>((lQuantized[0] << 1) | (lLargest & 1)));
+            mRotations.push_back(static_cast<uint16_t>((lQuantized[1] << 1) | (lLargest >> 1)));
+            mRotations.push_back(static_cast<uint16_t>(lQuantized[2] << 1));
+        }
+
+        mChannels.push_back(lChannel);
+    }
+
+    mPositions.resize(mPositions.size() + KEY_PADDING, 0);
+    mRotations.resize(mRotations.size() + KEY_PADDING, 0);
+    mScalings.resize(mScalings.size() + KEY_PADDING, 0);
+
+    mPositionTimes.shrink_to_fit();
+    mPositions.shrink_to_fit();
+    mRotationTimes.shrink_to_fit();
+    mRotations.shrink_to_fit();
+    mScalingTimes.shrink_to_fit();
+    mScalings.shrink_to_fit();
+}
+
+unsigned int CompressedClip::channelCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mChannels.size());
+}
+
+unsigned int CompressedClip::channelNode(unsigned int pIndex) const
+{
+    assert(pIndex < mChannels.size() && "Channel index out of boundaries");
+    return mChannels[pIndex].node;
+}
+
+float CompressedClip::ticksPerSecond(void) const noexcept
+{
+    return mTicksPerSecond;
+}
+
+float CompressedClip::duration(void) const noexcept
+{
+    return mDuration;
+}
+
+float CompressedClip::animationTime(float pTime) const noexcept
+{
+    return mDuration > 0.0f ? fmod(pTime * mTicksPerSecond, mDuration) : 0.0f;
+}
+
+mat4f CompressedClip::localTransform(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor) const
+{
+    vec3f lPosition;
+    quatf lRotation;
+    vec3f lScaling;
+
+    _sample(pChannel, pAnimationTime, pCursor, lPosition, lRotation, lScaling);
+
+    return AnimationClip::compose(lPosition, lRotation, lScaling);
+}
+
+void CompressedClip::sample(float pAnimationTime, AnimationCursor & pCursor, LocalPose & pPose) const
+{
+    if (pCursor.channelCount() != channelCount())
+        pCursor.reset(channelCount());
+
+    vec3f lPosition;
+    quatf lRotation;
+    vec3f lScaling;
+
+    // Only the animated nodes are modified, the others keep the transformation already in the pose
+    for (unsigned int i = 0; i < channelCount(); ++i)
+    {
+        _sample(i, pAnimationTime, pCursor, lPosition, lRotation, lScaling);
+        pPose.transform(channelNode(i), lPosition, lRotation, lScaling);
+    }
+}
+
+unsigned int CompressedClip::keyCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mPositionTimes.size() + mRotationTimes.size() + mScalingTimes.size());
+}
+
+size_t CompressedClip::byteSize(void) const noexcept
+{
+    size_t lSize = sizeof(Channel) * mChannels.size();
+
+    lSize += sizeof(uint16_t) * (mPositionTimes.size() + mPositions.size());
+    lSize += sizeof(uint16_t) * (mRotationTimes.size() + mRotations.size());
+    lSize += sizeof(uint16_t) * (mScalingTimes.size() + mScalings.size());
+
+    return lSize;
+}
+
+void CompressedClip::clear(void)
+{
+    mChannels.clear();
+    mPositionTimes.clear();
+    mPositions.clear();
+    mRotationTimes.clear();
+    mRotations.clear();
+    mScalingTimes.clear();
+    mScalings.clear();
+    mTicksPerSecond = 25.0f;
+    mDuration = 0.0f;
+    mTimeScale = 0.0f;
+}
+
+void CompressedClip::_sample(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor, vec3f & pPosition, quatf & pRotation, vec3f & pScaling) const
+{
+    const Channel & rChannel = mChannels[pChannel];
+    AnimationCursor::DecodedKeys & rDecoded = pCursor.decodedKeys(pChannel);
+
+    // The keys are searched directly in the quantized times
+    const float lTime = pAnimationTime * mTimeScale;
+
+    // The keys are only decoded when the cursor moves to the next ones, in between they are interpolated like the keys of
+    // an AnimationClip. A track with a single key always uses the key 0 and a factor of 0.
+    unsigned int lKey = 0;
+    float lFactor = 0.0f;
+
+    if (rChannel.scaling.count > 1)
+    {
+        const uint16_t* lTimes = mScalingTimes.data() + rChannel.scaling.first;
+
+        lKey = pCursor.scalingKey(pChannel, lTimes, rChannel.scaling.count, lTime);
+        lFactor = _factor(lTimes, lKey, lTime);
+    }
+
+    if (rDecoded.scalingKey != lKey)
+    {
+        _decode(mScalings.data() + 3 * (rChannel.scaling.first + lKey), rChannel.scalingMin, rChannel.scalingStep, rDecoded.scalings[0], rDecoded.scalings[1]);
+        rDecoded.scalingKey = lKey;
+    }
+
+    pScaling = rDecoded.scalings[0] + (rDecoded.scalings[1] - rDecoded.scalings[0]) * lFactor;
+
+    lKey = 0;
+    lFactor = 0.0f;
+
+    if (rChannel.rotation.count > 1)
+    {
+        const uint16_t* lTimes = mRotationTimes.data() + rChannel.rotation.first;
+
+        lKey = pCursor.rotationKey(pChannel, lTimes, rChannel.rotation.count, lTime);
+        lFactor = _factor(lTimes, lKey, lTime);
+    }
+
+    if (rDecoded.rotationKey != lKey)
+    {
+        _decode(mRotations.data() + 3 * (rChannel.rotation.first + lKey), rDecoded.rotations[0], rDecoded.rotations[1]);
+        rDecoded.rotationKey = lKey;
+    }
+
+    pRotation = _nlerp(rDecoded.rotations[0], rDecoded.rotations[1], lFactor);
+
+    lKey = 0;
+    lFactor = 0.0f;
+
+    if (rChannel.position.count > 1)
+    {
+        const uint16_t* lTimes = mPositionTimes.data() + rChannel.position.first;
+
+        lKey = pCursor.positionKey(pChannel, lTimes, rChannel.position.count, lTime);
+        lFactor = _factor(lTimes, lKey, lTime);
+    }
+
+    if (rDecoded.positionKey != lKey)
+    {
+        _decode(mPositions.data() + 3 * (rChannel.position.first + lKey), rChannel.positionMin, rChannel.positionStep, rDecoded.positions[0], rDecoded.positions[1]);
+        rDecoded.positionKey = lKey;
+    }
+
+    pPosition = rDecoded.positions[0] + (rDecoded.positions[1] - rDecoded.positions[0]) * lFactor;
+}
+
+template<typename T>
+vector<unsigned int> CompressedClip::_reduce(const vector<float> & pTimes, const vector<T> & pValues, float pTolerance)
+{
+    assert(!pValues.empty() && pTimes.size() == pValues.size());
+
+    vector<unsigned int> lKeys = {0};
+
+    const unsigned int lCount = static_cast<unsigned int>(pValues.size());
+
+    // A constant track only needs its first key
+    bool lConstant = true;
+
+    for (unsigned int i = 1; i < lCount && lConstant; ++i)
+        lConstant = _error(pValues[0], pValues[0], 0.0f, pValues[i]) <= pTolerance;
+
+    if (lConstant)
+        return lKeys;
+
+    // Extend the segment starting at the last kept key as long as it approximates all the keys it covers
+    unsigned int lStart = 0;
+
+    for (unsigned int lEnd = 2; lEnd < lCount; ++lEnd)
+    {
+        const float lDeltaTime = pTimes[lEnd] - pTimes[lStart];
+        bool lApproximated = true;
+
+        for (unsigned int i = lStart + 1; i < lEnd && lApproximated; ++i)
+        {
+            const float lFactor = lDeltaTime > 0.0f ? (pTimes[i] - pTimes[lStart]) / lDeltaTime : 0.0f;
+            lApproximated = _error(pValues[lStart], pValues[lEnd], lFactor, pValues[i]) <= pTolerance;
+        }
+
+        if (!lApproximated)
+        {
+            lStart = lEnd - 1;
+            lKeys.push_back(lStart);
+        }
+    }
+
+    lKeys.push_back(lCount - 1);
+
+    return lKeys;
+}
+
+float CompressedClip::_error(const vec3f & pStart, const vec3f & pEnd, float pFactor, const vec3f & pValue)
+{
+    const vec3f lDelta = pStart + (pEnd - pStart) * pFactor - pValue;
+
+    return static_cast<float>(lDelta.length());
+}
+
+float CompressedClip::_error(const quatf & pStart, const quatf & pEnd, float pFactor, const quatf & pValue)
+{
+    const quatf lRotation = _nlerp(pStart, pEnd, pFactor);
+
+    const float lDot = lRotation.x() * pValue.x() + lRotation.y() * pValue.y() + lRotation.z() * pValue.z() + lRotation.w() * pValue.w();
+    const float lSign = lDot < 0.0f ? -1.0f : 1.0f;
+
+    // The distance between the quaternions is more accurate than acos(dot) for small angles
+    const float x = lRotation.x() - lSign * pValue.x();
+    const float y = lRotation.y() - lSign * pValue.y();
+    const float z = lRotation.z() - lSign * pValue.z();
+    const float w = lRotation.w() - lSign * pValue.w();
+
+    return 4.0f * asin(std::min(0.5f * std::sqrt(x*x + y*y + z*z + w*w), 1.0f));
+}
+
+void CompressedClip::_decode(const uint16_t* pKeys, const float* pMin, const float* pStep, vec3f & pStart, vec3f & pEnd)
+{
+#ifdef MINIGL_COMPRESSED_CLIP_SSE2
+    // Load the 3 components of both keys (and one ignored value), widen them to 32 bits and convert them back to their range
+    const __m128i lZero = _mm_setzero_si128();
+    const __m128 lStart = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pKeys)), lZero));
+    const __m128 lEnd = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pKeys + 3)), lZero));
+
+    const __m128 lMin = _mm_loadu_ps(pMin);
+    const __m128 lStep = _mm_loadu_ps(pStep);
+
+    float lRes[8];
+    _mm_storeu_ps(lRes, _mm_add_ps(lMin, _mm_mul_ps(lStart, lStep)));
+    _mm_storeu_ps(lRes + 4, _mm_add_ps(lMin, _mm_mul_ps(lEnd, lStep)));
+
+    pStart = vec3f(lRes[0], lRes[1], lRes[2]);
+    pEnd = vec3f(lRes[4], lRes[5], lRes[6]);
+#else
+    float lRes[6];
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        lRes[i] = pMin[i] + static_cast<float>(pKeys[i]) * pStep[i];
+        lRes[i + 3] = pMin[i] + static_cast<float>(pKeys[i + 3]) * pStep[i];
+    }
+
+    pStart = vec3f(lRes[0], lRes[1], lRes[2]);
+    pEnd = vec3f(lRes[3], lRes[4], lRes[5]);
+#endif
+}
+
+void CompressedClip::_decode(const uint16_t* pKeys, quatf & pStart, quatf & pEnd)
+{
+    float lSmallest[8];
+
+#ifdef MINIGL_COMPRESSED_CLIP_SSE2
+    // Remove the bit used by the index of the largest component and convert the 15 bit values of both keys at once
+    const __m128i lZero = _mm_setzero_si128();
+    const __m128i lStart = _mm_unpacklo_epi16(_mm_srli_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pKeys)), 1), lZero);
+    const __m128i lEnd = _mm_unpacklo_epi16(_mm_srli_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pKeys + 3)), 1), lZero);
+
+    const __m128 lScale = _mm_set1_ps(2.0f * SMALLEST_THREE_RANGE / SMALLEST_THREE_STEPS);
+    const __m128 lOffset = _mm_set1_ps(-SMALLEST_THREE_RANGE);
+
+    const __m128 lStartValues = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(lStart), lScale), lOffset);
+    const __m128 lEndValues = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(lEnd), lScale), lOffset);
+
+    // Sum the squares of the 3 components of each key to recompute both dropped components with one square root
+    const __m128 lStartSquares = _mm_mul_ps(lStartValues, lStartValues);
+    const __m128 lEndSquares = _mm_mul_ps(lEndValues, lEndValues);
+    const __m128 lLow = _mm_unpacklo_ps(lStartSquares, lEndSquares);
+    const __m128 lHigh = _mm_unpackhi_ps(lStartSquares, lEndSquares);
+    const __m128 lSums = _mm_add_ps(_mm_add_ps(lLow, _mm_movehl_ps(lLow, lLow)), lHigh);
+    const __m128 lLargest = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), lSums), _mm_setzero_ps()));
+
+    _mm_storeu_ps(lSmallest, lStartValues);
+    _mm_storeu_ps(lSmallest + 4, lEndValues);
+
+    float lDropped[4];
+    _mm_storeu_ps(lDropped, lLargest);
+
+    lSmallest[3] = lDropped[0];
+    lSmallest[7] = lDropped[1];
+#else
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        lSmallest[i] = static_cast<float>(pKeys[i] >> 1) * (2.0f * SMALLEST_THREE_RANGE / SMALLEST_THREE_STEPS) - SMALLEST_THREE_RANGE;
+        lSmallest[i + 4] = static_cast<float>(pKeys[i + 3] >> 1) * (2.0f * SMALLEST_THREE_RANGE / SMALLEST_THREE_STEPS) - SMALLEST_THREE_RANGE;
+    }
+
+    for (unsigned int i = 0; i < 8; i += 4)
+        lSmallest[i + 3] = std::sqrt(std::max(1.0f - lSmallest[i] * lSmallest[i] - lSmallest[i + 1] * lSmallest[i + 1] - lSmallest[i + 2] * lSmallest[i + 2], 0.0f));
+#endif
+
+    // Position of each component of the quaternion in the decoded values, the dropped component comes last
+    static const unsigned int lOrder[4][4] = {{3, 0, 1, 2}, {0, 3, 1, 2}, {0, 1, 3, 2}, {0, 1, 2, 3}};
+
+    const unsigned int* lStartOrder = lOrder[(pKeys[0] & 1) | ((pKeys[1] & 1) << 1)];
+    const unsigned int* lEndOrder = lOrder[(pKeys[3] & 1) | ((pKeys[4] & 1) << 1)];
+
+    pStart = quatf(lSmallest[lStartOrder[0]], lSmallest[lStartOrder[1]], lSmallest[lStartOrder[2]], lSmallest[lStartOrder[3]]);
+    pEnd = quatf(lSmallest[4 + lEndOrder[0]], lSmallest[4 + lEndOrder[1]], lSmallest[4 + lEndOrder[2]], lSmallest[4 + lEndOrder[3]]);
+}
+
+quatf CompressedClip::_nlerp(const quatf & pStart, const quatf & pEnd, float pFactor)
+{
+    const float lDot = pStart.x() * pEnd.x() + pStart.y() * pEnd.y() + pStart.z() * pEnd.z() + pStart.w() * pEnd.w();
+
+    // Take the shortest arc between the two rotations
+    const float lStartScale = 1.0f - pFactor;
+    const float lEndScale = lDot < 0.0f ? -pFactor : pFactor;
+
+    const float x = lStartScale * pStart.x() + lEndScale * pEnd.x();
+    const float y = lStartScale * pStart.y() + lEndScale * pEnd.y();
+    const float z = lStartScale * pStart.z() + lEndScale * pEnd.z();
+    const float w = lStartScale * pStart.w() + lEndScale * pEnd.w();
+
+    const float lInverseLength = 1.0f / std::sqrt(x*x + y*y + z*z + w*w);
+
+    return quatf(x * lInverseLength, y * lInverseLength, z * lInverseLength, w * lInverseLength);
+}
+
+float CompressedClip::_factor(const uint16_t* pTimes, unsigned int pKey, float pTime)
+{
+    const float lDeltaTime = static_cast<float>(pTimes[pKey + 1]) - static_cast<float>(pTimes[pKey]);
+
+    if (lDeltaTime <= 0.0f)
+        return 0.0f;
+
+    // The cursor clamps the key to the range of the animation, so does the factor
+    const float lFactor = (pTime - static_cast<float>(pTimes[pKey])) / lDeltaTime;
+
+    return std::min(std::max(lFactor, 0.0f), 1.0f);
+}
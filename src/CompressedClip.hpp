@@ -0,0 +1,245 @@
+//===============================================================================================//
+/*!
+ *  \file      CompressedClip.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Algebra.hpp"
+#include "AnimationClip.hpp"
+#include "AnimationCursor.hpp"
+#include "LocalPose.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores a compressed copy of an AnimationClip
+     *  \details The keys that can be interpolated from their neighbours within a tolerance are removed. The
+     *           remaining keys are quantized: the times and the components of the positions and scalings use
+     *           16 bits normalized over their range, the rotations use 48 bits (smallest three components of the
+     *           quaternion). The keys of all the channels are stored in one block per type of key, the times
+     *           apart from the values, and two consecutive keys are decompressed together with SIMD instructions.
+     *           The decompressed keys are kept in the AnimationCursor, a forward playback only decodes the keys
+     *           when it reaches the next ones.
+     */
+    class CompressedClip
+    {
+    public:
+        struct Tolerances
+        {
+            Tolerances(float pPosition = 0.001f, float pRotation = 0.001f, float pScaling = 0.001f)
+            :position(pPosition), rotation(pRotation), scaling(pScaling)
+            {
+            }
+
+            float position;     //!< Maximum distance between a removed position key and the interpolated value
+            float rotation;     //!< Maximum angle in radians between a removed rotation key and the interpolated value
+            float scaling;      //!< Maximum distance between a removed scaling key and the interpolated value
+        };
+
+    public:
+        /*!
+         *  \brief Default constructor
+         */
+        CompressedClip(void) = default;
+
+        /*!
+         *  \brief Constructor compressing a clip
+         *  @param pClip is the clip to compress
+         *  @param pTolerances are the maximum errors allowed when removing keys
+         */
+        explicit CompressedClip(const AnimationClip & pClip, const Tolerances & pTolerances = Tolerances());
+
+        /*!
+         *  \brief Replace the content of this clip with a compressed copy of a clip
+         *  @param pClip is the clip to compress
+         *  @param pTolerances are the maximum errors allowed when removing keys
+         */
+        void compress(const AnimationClip & pClip, const Tolerances & pTolerances = Tolerances());
+
+        /*!
+         *  \brief Get the number of channels
+         *  @return the number of channels in the clip
+         */
+        unsigned int channelCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the node animated by a channel
+         *  @param pIndex is the index of the channel
+         *  @return the index of the node in the Skeleton
+         */
+        unsigned int channelNode(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the number of ticks in one second
+         *  @return the number of ticks in one second
+         */
+        float ticksPerSecond(void) const noexcept;
+
+        /*!
+         *  \brief Get the duration of the animation
+         *  @return the duration in ticks
+         */
+        float duration(void) const noexcept;
+
+        /*!
+         *  \brief Convert a time in seconds to a time in ticks, looping over the duration of the animation
+         *  @param pTime is in seconds
+         *  @return the time stamp in the animation
+         */
+        float animationTime(float pTime) const noexcept;
+
+        /*!
+         *  \brief Interpolate the keys of a channel and combine them in a single transformation
+         *  @param pChannel is the index of the channel
+         *  @param pAnimationTime is the current time stamp in the animation
+         *  @param pCursor is used to find the keys of the channel
+         *  @return the transformation translation * rotation * scaling of the node for the current time stamp
+         */
+        mat4f localTransform(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor) const;
+
+        /*!
+         *  \brief Interpolate the keys of all the channels and write them in a pose
+         *  @param pAnimationTime is the current time stamp in the animation
+         *  @param pCursor is used to find the keys of the channels
+         *  @param pPose contains the local transformation of each node, only the animated nodes are modified
+         */
+        void sample(float pAnimationTime, AnimationCursor & pCursor, LocalPose & pPose) const;
+
+        /*!
+         *  \brief Get the number of keys kept after the compression
+         *  @return the number of position, rotation and scaling keys of all the channels
+         */
+        unsigned int keyCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the memory used by the compressed keys
+         *  @return the size in bytes of the times, values and ranges of all the channels
+         */
+        std::size_t byteSize(void) const noexcept;
+
+        /*!
+         *  \brief Remove all the channels
+         */
+        void clear(void);
+
+    private:
+        struct Track
+        {
+            unsigned int first;
+            unsigned int count;
+        };
+
+        struct Channel
+        {
+            unsigned int node;
+            Track position;
+            Track rotation;
+            Track scaling;
+            float positionMin[4];
+            float positionStep[4];
+            float scalingMin[4];
+            float scalingStep[4];
+        };
+
+    private:
+        /*!
+         *  \brief Helper method to interpolate the keys of a channel
+         *  @param pChannel is the index of the channel
+         *  @param pAnimationTime is the current time stamp in the animation
+         *  @param pCursor is used to find the keys of the channel
+         *  @param pPosition will contain the interpolated position
+         *  @param pRotation will contain the interpolated rotation
+         *  @param pScaling will contain the interpolated scaling
+         */
+        void _sample(unsigned int pChannel, float pAnimationTime, AnimationCursor & pCursor, vec3f & pPosition, quatf & pRotation, vec3f & pScaling) const;
+
+        /*!
+         *  \brief Helper method to find the keys that cannot be interpolated from the other keys
+         *  @param pTimes contains the time of each key
+         *  @param pValues contains the value of each key
+         *  @param pTolerance is the maximum error allowed when removing a key
+         *  @return the sorted indices of the keys to keep (only the first one for a constant track)
+         */
+        template<typename T>
+        static std::vector<unsigned int> _reduce(const std::vector<float> & pTimes, const std::vector<T> & pValues, float pTolerance);
+
+        /*!
+         *  \brief Helper method to compute the distance between a key and a linear interpolation
+         *  @param pStart is the value for a factor of 0
+         *  @param pEnd is the value for a factor of 1
+         *  @param pFactor is the interpolation factor
+         *  @param pValue is the value of the key
+         *  @return the distance between the interpolated value and the key
+         */
+        static float _error(const vec3f & pStart, const vec3f & pEnd, float pFactor, const vec3f & pValue);
+
+        /*!
+         *  \brief Helper method to compute the angle between a key and an interpolated rotation
+         *  @param pStart is the rotation for a factor of 0
+         *  @param pEnd is the rotation for a factor of 1
+         *  @param pFactor is the interpolation factor
+         *  @param pValue is the rotation of the key
+         *  @return the angle in radians between the interpolated rotation and the key
+         */
+        static float _error(const quatf & pStart, const quatf & pEnd, float pFactor, const quatf & pValue);
+
+        /*!
+         *  \brief Helper method to decompress 2 consecutive quantized 3D keys
+         *  @param pKeys points to the 3 components of the first key, followed by the next key
+         *  @param pMin is the value of a quantized component equal to 0 (4 floats, the last one is ignored)
+         *  @param pStep is the value of one quantization step (4 floats, the last one is ignored)
+         *  @param pStart will contain the first value
+         *  @param pEnd will contain the second value
+         */
+        static void _decode(const std::uint16_t* pKeys, const float* pMin, const float* pStep, vec3f & pStart, vec3f & pEnd);
+
+        /*!
+         *  \brief Helper method to decompress 2 consecutive rotation keys
+         *  @param pKeys points to the 3 components of the first key, followed by the next key
+         *  @param pStart will contain the first rotation
+         *  @param pEnd will contain the second rotation
+         */
+        static void _decode(const std::uint16_t* pKeys, quatf & pStart, quatf & pEnd);
+
+        /*!
+         *  \brief Helper method to interpolate two unit quaternions linearly along the shortest arc and normalize the result
+         *  \details The keys are reduced with the same interpolation, so it is cheaper than a slerp without adding any error
+         *  @param pStart is the quaternion for a factor of 0
+         *  @param pEnd is the quaternion for a factor of 1
+         *  @param pFactor is in the range [0,1]
+         *  @return the interpolated quaternion
+         */
+        static quatf _nlerp(const quatf & pStart, const quatf & pEnd, float pFactor);
+
+        /*!
+         *  \brief Helper method to compute the interpolation factor between two quantized times
+         *  @param pTimes points to the times of the track
+         *  @param pKey is the index of the first key
+         *  @param pTime is the current quantized time
+         *  @return a factor in the range [0,1]
+         */
+        static float _factor(const std::uint16_t* pTimes, unsigned int pKey, float pTime);
+
+    private:
+        std::vector<Channel> mChannels;
+        std::vector<std::uint16_t> mPositionTimes;
+        std::vector<std::uint16_t> mPositions;
+        std::vector<std::uint16_t> mRotationTimes;
+        std::vector<std::uint16_t> mRotations;
+        std::vector<std::uint16_t> mScalingTimes;
+        std::vector<std::uint16_t> mScalings;
+        float mTicksPerSecond = 25.0f;
+        float mDuration = 0.0f;
+        float mTimeScale = 0.0f;
+
+    }; // class CompressedClip
+
+} // namespace miniGL
@@ -13,9 +13,11 @@
 
 #include "GLUtils.hpp"
 #include "Exceptions.hpp"
+#include "GLStateCache.hpp"
 
 using miniGL::CubemapTexture;
 using miniGL::Exceptions;
+using miniGL::GLStateCache;
 using Magick::Image;
 using Magick::Blob;
 
@@ -40,7 +42,7 @@ CubemapTexture::~CubemapTexture(void)
 {
     if(mTextureObject != 0)
     {
-        glDeleteTextures(1, & mTextureObject); checkOpenGLState;
+        GLStateCache::deleteTextures(1, & mTextureObject); checkOpenGLState;
     }
 }
 
@@ -60,7 +62,7 @@ void CubemapTexture::load(const std::initializer_list<std::string> & pFilenames)
     assert(mFilenamesSet);
 
     glGenTextures(1, & mTextureObject); checkOpenGLState;
-    glBindTexture(GL_TEXTURE_CUBE_MAP, mTextureObject); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_CUBE_MAP, mTextureObject); checkOpenGLState;
 
     Blob lBlob;
 
@@ -13,6 +13,8 @@
 #include <GL/glew.h>
 #include <Magick++.h>
 
+#include "GLStateCache.hpp"
+
 namespace miniGL
 {
     /*!
@@ -71,8 +73,8 @@ namespace miniGL
 
     inline void CubemapTexture::bind(GLenum pTextureUnit)
     {
-        glActiveTexture(pTextureUnit);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, mTextureObject);
+        GLStateCache::activeTexture(pTextureUnit);
+        GLStateCache::bindTexture(GL_TEXTURE_CUBE_MAP, mTextureObject);
     }
 
 } // namespace miniGL
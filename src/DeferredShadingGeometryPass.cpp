@@ -42,6 +42,7 @@ void DeferredShadingGeometryPass::init(void)
     use();
 
     mWVPLocation = Program::uniformLocation("uWVP");
+    mInstancedLocation = Program::uniformLocation("uInstanced");
     mWorldLocation = Program::uniformLocation("uWorld");
     mColorTextureLocation = Program::uniformLocation("uColorMap");
 
@@ -55,6 +56,11 @@ void DeferredShadingGeometryPass::WVP(const mat4f & pWVP)
     glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
 }
 
+void DeferredShadingGeometryPass::instanced(bool pValue)
+{
+    glUniform1i(mInstancedLocation, pValue ? 1 : 0);
+}
+
 void DeferredShadingGeometryPass::worldMatrix(const mat4f & pWorld)
 {
     glUniformMatrix4fv(mWorldLocation, 1, GL_TRUE, const_cast<mat4f&>(pWorld).data());
@@ -69,5 +75,6 @@ bool DeferredShadingGeometryPass::checkUniformLocations(void) const
 {
     return (mWVPLocation != Constants::invalidUniformLocation<GLuint>() &&
             mWorldLocation != Constants::invalidUniformLocation<GLuint>() &&
+            mInstancedLocation != Constants::invalidUniformLocation<GLuint>() &&
             mColorTextureLocation != Constants::invalidUniformLocation<GLuint>());
 }
@@ -40,6 +40,13 @@ namespace miniGL
          */
         void WVP(const mat4f & pWVP);
 
+        /*!
+         *  \brief Choose where the vertex shader reads the matrices
+         *  @param pValue is true to read them from the instance streams of the mesh (see MeshBase::instancing),
+         *         false to read them from the uniforms
+         */
+        void instanced(bool pValue);
+
         /*!
          *  \brief Set the world matrix
          *  @param pWorld is a 4x4 matrix
@@ -60,6 +67,7 @@ namespace miniGL
 
     private:
         GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mInstancedLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mWorldLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mColorTextureLocation = Constants::invalidUniformLocation<GLuint>();
 
@@ -15,8 +15,8 @@
 #include "SpotLight.hpp"
 #include "PointLight.hpp"
 #include "GLUtils.hpp"
+#include "GLStateCache.hpp"
 
-using std::map;
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -29,10 +29,12 @@ using miniGL::DeferredShadingTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshSOA;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
 using miniGL::PointLight;
 using miniGL::DirectionalLight;
 using miniGL::SpotLight;
+using miniGL::GLStateCache;
 
 DeferredShadingTechnique::DeferredShadingTechnique(void)
 :RenderingTechniqueBase("DeferredShadingTechnique")
@@ -42,7 +44,7 @@ DeferredShadingTechnique::DeferredShadingTechnique(void)
 DeferredShadingTechnique::~DeferredShadingTechnique()
 {
     // Re activate glDepthMask to be able to use the depth test (which is the default behaviour)
-    glDepthMask(GL_TRUE);
+    GLStateCache::depthMask(GL_TRUE);
 }
 
 void DeferredShadingTechnique::init(unsigned int pPointLightCount, unsigned int pSpotLightCount, const tuple<unsigned int, unsigned int> & pFramebufferDimensions)
@@ -103,10 +105,10 @@ void DeferredShadingTechnique::init(unsigned int pPointLightCount, unsigned int
     mSphere.mesh->frontFace(GL_CW);
 }
 
-void DeferredShadingTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void DeferredShadingTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     // Find the meshes to render
-    auto lMeshReferences = findMeshesToRender(pMeshes);
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
 
     mGeometryBuffers->startFrame();
 
@@ -116,7 +118,7 @@ void DeferredShadingTechnique::render(const map<string, MeshAndTransform> & pMes
     // We need stencil to be enabled in the stencil pass to get the stencil buffer
     // updated and we also need it in the light pass because we render the light
     // only if the stencil passes.
-    glEnable(GL_STENCIL_TEST);
+    GLStateCache::enable(GL_STENCIL_TEST);
 
     // Process the point lights
     for (const auto it : pLights)
@@ -142,7 +144,7 @@ void DeferredShadingTechnique::render(const map<string, MeshAndTransform> & pMes
 
     // The directional light does not need a stencil test because its volume
     // is unlimited and the final pass simply copies the texture.
-    glDisable(GL_STENCIL_TEST);
+    GLStateCache::disable(GL_STENCIL_TEST);
 
     // Process the directional light
     _directionalLightPass(pLights);
@@ -150,35 +152,30 @@ void DeferredShadingTechnique::render(const map<string, MeshAndTransform> & pMes
     _finalPass();
 }
 
-void DeferredShadingTechnique::_geometryPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators)
+void DeferredShadingTechnique::_geometryPass(const vector<const MeshAndTransform*> & pMeshes)
 {
     mDSGeometryPass->use();
     mGeometryBuffers->bindForGeometryPass();
 
     // Only the geometry pass updates the depth buffer
-    glDepthMask(GL_TRUE);
+    GLStateCache::depthMask(GL_TRUE);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::enable(GL_DEPTH_TEST);
 
-    for (const auto it : pMeshIterators)
-    {
-        for (auto trans : it->second.transform)
-        {
-            mat4f lWorld = trans.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
-
-            mDSGeometryPass->worldMatrix(lWorld);
-            mDSGeometryPass->WVP(lWVP);
+    const mat4f lViewProjection = mCamera->viewProjection();
 
-            glFrontFace(it->second.mesh->frontFace());
+    cull(pMeshes, lViewProjection, mVisibleTransforms);
 
-            it->second.mesh->render();
-        }
-    }
+    // One instanced draw call per mesh, the meshes set their own front face
+    renderInstanced(mVisibleTransforms, lViewProjection, [this](bool pInstanced){ mDSGeometryPass->instanced(pInstanced); }, [this](const mat4f & pWVP, const mat4f & pWorld)
+    {
+        mDSGeometryPass->worldMatrix(pWorld);
+        mDSGeometryPass->WVP(pWVP);
+    });
 
     // When we get here the depth buffer is already populated and the stencil pass
     // depends on it, but it does not write to it.
-    glDepthMask(GL_FALSE);
+    GLStateCache::depthMask(GL_FALSE);
 }
 
 void DeferredShadingTechnique::_finalPass(void)
@@ -195,11 +192,11 @@ void DeferredShadingTechnique::_directionalLightPass(const vector<shared_ptr<Bas
     mDSDirectionalLightPass->use();
     mDSDirectionalLightPass->eyeWorldPosition(mCamera->position());
 
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLStateCache::disable(GL_DEPTH_TEST);
+    GLStateCache::disable(GL_CULL_FACE);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendEquation(GL_FUNC_ADD);
+    GLStateCache::blendFunc(GL_ONE, GL_ONE);
 
     for (const auto it : pLights)
     {
@@ -214,7 +211,7 @@ void DeferredShadingTechnique::_directionalLightPass(const vector<shared_ptr<Bas
         }
     }
 
-    glDisable(GL_BLEND);
+    GLStateCache::disable(GL_BLEND);
 }
 
 void DeferredShadingTechnique::_pointLightPass(const shared_ptr<PointLight> pLight)
@@ -226,13 +223,13 @@ void DeferredShadingTechnique::_pointLightPass(const shared_ptr<PointLight> pLig
 
     glStencilFunc(GL_NOTEQUAL, 0, 0xFF);
 
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLStateCache::disable(GL_DEPTH_TEST);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendEquation(GL_FUNC_ADD);
+    GLStateCache::blendFunc(GL_ONE, GL_ONE);
 
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_FRONT);
+    GLStateCache::enable(GL_CULL_FACE);
+    GLStateCache::cullFace(GL_FRONT);
 
     Transform lTransformation;
 
@@ -243,7 +240,7 @@ void DeferredShadingTechnique::_pointLightPass(const shared_ptr<PointLight> pLig
 
     lTransformation.scaling(lSphereScale, lSphereScale, lSphereScale);
     mat4f lWorld = lTransformation.final();
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    mat4f lWVP = mCamera->viewProjection() * lWorld;
 
     mDSPointLightPass->WVP(lWVP);
     mDSPointLightPass->updateLightState(*pLight);
@@ -254,8 +251,8 @@ void DeferredShadingTechnique::_pointLightPass(const shared_ptr<PointLight> pLig
     // sphere lSphereScale is function of the intensity of the point light.
     mSphere.mesh->render();
 
-    glCullFace(GL_BACK);
-    glDisable(GL_BLEND);
+    GLStateCache::cullFace(GL_BACK);
+    GLStateCache::disable(GL_BLEND);
 }
 
 void DeferredShadingTechnique::_spotLightPass(const shared_ptr<SpotLight> pLight)
@@ -267,13 +264,13 @@ void DeferredShadingTechnique::_spotLightPass(const shared_ptr<SpotLight> pLight
 
     glStencilFunc(GL_NOTEQUAL, 0, 0xFF);
 
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLStateCache::disable(GL_DEPTH_TEST);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendEquation(GL_FUNC_ADD);
+    GLStateCache::blendFunc(GL_ONE, GL_ONE);
 
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_FRONT);
+    GLStateCache::enable(GL_CULL_FACE);
+    GLStateCache::cullFace(GL_FRONT);
 
     Transform lTransformation;
 
@@ -284,7 +281,7 @@ void DeferredShadingTechnique::_spotLightPass(const shared_ptr<SpotLight> pLight
 
     lTransformation.scaling(lSphereScale, lSphereScale, lSphereScale);
     mat4f lWorld = lTransformation.final();
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    mat4f lWVP = mCamera->viewProjection() * lWorld;
 
     mDSSpotLightPass->WVP(lWVP);
     mDSSpotLightPass->updateLightState(*pLight);
@@ -295,6 +292,6 @@ void DeferredShadingTechnique::_spotLightPass(const shared_ptr<SpotLight> pLight
     // sphere lSphereScale is function of the intensity of the spot light.
     mSphere.mesh->render();
 
-    glCullFace(GL_BACK);
-    glDisable(GL_BLEND);
+    GLStateCache::cullFace(GL_BACK);
+    GLStateCache::disable(GL_BLEND);
 }
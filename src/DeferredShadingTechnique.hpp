@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "RenderingTechniqueBase.hpp"
@@ -21,6 +20,7 @@
 #include "DeferredShadingPointLightPass.hpp"
 #include "DeferredShadingSpotLightPass.hpp"
 #include "DeferredShadingNullPass.hpp"
+#include "GLStateCache.hpp"
 
 namespace miniGL
 {
@@ -55,7 +55,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
     private:
         /*!
@@ -75,7 +75,7 @@ namespace miniGL
         /*!
          *  \brief Helper method to render the VS attributes to textures
          */
-        void _geometryPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators);
+        void _geometryPass(const std::vector<const MeshAndTransform*> & pMeshes);
 
         /*!
          *  \brief Helper method to display the above mentioned textures
@@ -128,9 +128,9 @@ namespace miniGL
         // Disable color and depth write and enable stencil
         mGeometryBuffers->bindForStencilPass();
 
-        glEnable(GL_DEPTH_TEST);
+        GLStateCache::enable(GL_DEPTH_TEST);
 
-        glDisable(GL_CULL_FACE);
+        GLStateCache::disable(GL_CULL_FACE);
 
         glClear(GL_STENCIL_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
@@ -0,0 +1,155 @@
+//===============================================================================================//
+/*!
+ *  \file      DrawList.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "DrawList.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+#include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
+
+// Number of items recorded by each batch: enough work per job, and enough batches to keep the threads busy
+#define DRAW_LIST_BATCH_SIZE 8
+
+using std::function;
+using miniGL::DrawList;
+using miniGL::DrawPacket;
+using miniGL::JobSystem;
+using miniGL::RenderQueue;
+using miniGL::GLStateCache;
+
+unsigned int DrawList::Recorder::matrices(const mat4f* pMatrices, unsigned int pCount)
+{
+    assert(pCount <= DRAW_PACKET_MAX_MATRICES && "Too many matrices for a draw packet");
+
+    const unsigned int lOffset = static_cast<unsigned int>(mMatrices.size());
+    mMatrices.insert(mMatrices.end(), pMatrices, pMatrices + pCount);
+
+    return lOffset;
+}
+
+void DrawList::Recorder::draw(const DrawPacket & pPacket)
+{
+    assert(pPacket.program != 0 && "The program of a draw packet must be set");
+    assert(pPacket.vao != 0 && "The VAO of a draw packet must be set");
+    assert(pPacket.matrixOffset + pPacket.matrixCount <= mMatrices.size() && "The matrices of a draw packet must be recorded first");
+
+    mPackets.push_back(pPacket);
+}
+
+void DrawList::clear(void)
+{
+    for (unsigned int i = 0; i < mBatchCount; ++i)
+    {
+        mRecorders[i].mPackets.clear();
+        mRecorders[i].mMatrices.clear();
+    }
+
+    mQueue.clear();
+    mBatchCount = 0;
+}
+
+void DrawList::record(unsigned int pCount, const function<void(unsigned int, Recorder &)> & pTask, JobSystem* pJobSystem)
+{
+    clear();
+
+    mBatchCount = (pCount + DRAW_LIST_BATCH_SIZE - 1) / DRAW_LIST_BATCH_SIZE;
+
+    // The recorders are kept between frames, so their vectors do not allocate again
+    if (mRecorders.size() < mBatchCount)
+        mRecorders.resize(mBatchCount);
+
+    auto lRecordBatches = [this, pCount, & pTask](unsigned int pBegin, unsigned int pEnd)
+    {
+        for (unsigned int lBatch = pBegin; lBatch < pEnd; ++lBatch)
+        {
+            const unsigned int lEnd = std::min((lBatch + 1) * DRAW_LIST_BATCH_SIZE, pCount);
+
+            for (unsigned int i = lBatch * DRAW_LIST_BATCH_SIZE; i < lEnd; ++i)
+                pTask(i, mRecorders[lBatch]);
+        }
+    };
+
+    // By reference, the captures do not fit in the small buffer of std::function and would be copied on the heap
+    if (pJobSystem != nullptr)
+        pJobSystem->parallelFor(mBatchCount, std::cref(lRecordBatches));
+    else
+        lRecordBatches(0, mBatchCount);
+
+    // The recorders do not grow anymore, the queue can point on their packets
+    for (unsigned int lBatch = 0; lBatch < mBatchCount; ++lBatch)
+    {
+        const Recorder & rRecorder = mRecorders[lBatch];
+
+        for (const DrawPacket & rPacket : rRecorder.mPackets)
+            mQueue.push(rPacket, rRecorder.mMatrices.data() + rPacket.matrixOffset);
+    }
+}
+
+void DrawList::sort(void)
+{
+    mQueue.sort();
+}
+
+void DrawList::submit(void) const
+{
+    GLuint lVAO = 0;
+
+    // The state cache drops the program, front face and texture calls that do not change anything
+    for (unsigned int lIndex = 0; lIndex < mQueue.size(); ++lIndex)
+    {
+        const DrawPacket & rPacket = mQueue.packet(lIndex);
+        const mat4f* rMatrices = mQueue.matrices(lIndex);
+
+        GLStateCache::useProgram(rPacket.program);
+        GLStateCache::frontFace(rPacket.frontFace);
+
+        if (rPacket.vao != lVAO)
+        {
+            glBindVertexArray(rPacket.vao);
+            lVAO = rPacket.vao;
+        }
+
+        if (rPacket.colorTexture != 0)
+        {
+            GLStateCache::activeTexture(COLOR_TEXTURE_UNIT);
+            GLStateCache::bindTexture(GL_TEXTURE_2D, rPacket.colorTexture);
+        }
+
+        for (unsigned int i = 0; i < rPacket.matrixCount; ++i)
+            glUniformMatrix4fv(rPacket.matrixLocations[i], 1, GL_TRUE, const_cast<mat4f*>(rMatrices + i)->data());
+
+        if (rPacket.flagLocation != -1)
+            glUniform1i(rPacket.flagLocation, rPacket.flagValue);
+
+        glDrawElementsBaseVertex(rPacket.topology, rPacket.indexCount, GL_UNSIGNED_INT, reinterpret_cast<void*>(sizeof(unsigned int) * rPacket.baseIndex), rPacket.baseVertex);
+    }
+
+    glBindVertexArray(0);
+}
+
+RenderQueue::StateChanges DrawList::stateChanges(void) const
+{
+    return mQueue.stateChanges();
+}
+
+unsigned int DrawList::size(void) const noexcept
+{
+    return mQueue.size();
+}
+
+const DrawPacket & DrawList::packet(unsigned int pIndex) const
+{
+    return mQueue.packet(pIndex);
+}
+
+const mat4f* DrawList::matrices(unsigned int pIndex) const
+{
+    return mQueue.matrices(pIndex);
+}
@@ -0,0 +1,121 @@
+//===============================================================================================//
+/*!
+ *  \file      DrawList.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include <GL/glew.h>
+
+#include "Algebra.hpp"
+#include "JobSystem.hpp"
+#include "DrawPacket.hpp"
+#include "RenderQueue.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class records draw calls on several threads and submits them on the GL thread
+     *  \details The items to draw (e.g. the meshes of a technique) are split in batches, and each batch is recorded
+     *           into its own Recorder by the jobs of a JobSystem: the matrix products and the lookups of the VAOs and
+     *           textures do not need the GL context. The packets of the batches are then queued in order, so the
+     *           draw order is the same as when recording on a single thread, unless the queue is sorted to group the
+     *           packets sharing the same state. The GL thread submits the queue and skips the program, VAO, front face
+     *           and texture bindings that did not change between 2 packets.
+     */
+    class DrawList
+    {
+    public:
+        /*!
+         *  \brief Packets and uniform values recorded by one batch, only one thread writes in a Recorder at a time
+         */
+        class Recorder
+        {
+        public:
+            /*!
+             *  \brief Store the values of the matrix uniforms of the next packets
+             *  @param pMatrices points on the values
+             *  @param pCount is the number of matrices, at most DRAW_PACKET_MAX_MATRICES
+             *  @return the offset to put in DrawPacket::matrixOffset
+             */
+            unsigned int matrices(const mat4f* pMatrices, unsigned int pCount);
+
+            /*!
+             *  \brief Add a draw call
+             *  @param pPacket is a complete packet, its matrices already stored in this recorder
+             */
+            void draw(const DrawPacket & pPacket);
+
+        private:
+            friend class DrawList;
+
+            std::vector<DrawPacket> mPackets;
+            std::vector<mat4f> mMatrices;
+
+        }; // class Recorder
+
+    public:
+        /*!
+         *  \brief Remove all the packets, keeping the memory for the next frame
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Record the draw calls of a set of items, replacing the previous ones
+         *  @param pCount is the number of items
+         *  @param pTask is called once per item with the recorder of its batch, possibly from several threads at
+         *         the same time. It must not call OpenGL.
+         *  @param pJobSystem records the batches in parallel, or nullptr to record them on the calling thread
+         */
+        void record(unsigned int pCount, const std::function<void(unsigned int pItem, Recorder & pRecorder)> & pTask, JobSystem* pJobSystem = nullptr);
+
+        /*!
+         *  \brief Sort the recorded draw calls by RenderQueue::sortKey to minimize the changes of state
+         */
+        void sort(void);
+
+        /*!
+         *  \brief Issue the recorded draw calls, on the thread where the GL context is current
+         */
+        void submit(void) const;
+
+        /*!
+         *  \brief Count the state changes that the next submit will do
+         *  @return the number of changes of each state
+         */
+        RenderQueue::StateChanges stateChanges(void) const;
+
+        /*!
+         *  \brief Get the number of recorded draw calls
+         *  @return the number of packets in all the batches
+         */
+        unsigned int size(void) const noexcept;
+
+        /*!
+         *  \brief Get a recorded draw call, in submission order
+         *  @param pIndex is in the range [0, size())
+         *  @return a reference on the packet
+         */
+        const DrawPacket & packet(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the matrices of a recorded draw call
+         *  @param pIndex is in the range [0, size())
+         *  @return a pointer on the DrawPacket::matrixCount matrices of the packet
+         */
+        const mat4f* matrices(unsigned int pIndex) const;
+
+    private:
+        std::vector<Recorder> mRecorders;
+        RenderQueue mQueue;
+        unsigned int mBatchCount = 0;
+
+    }; // class DrawList
+
+} // namespace miniGL
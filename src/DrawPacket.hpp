@@ -0,0 +1,44 @@
+//===============================================================================================//
+/*!
+ *  \file      DrawPacket.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <GL/glew.h>
+
+// Number of matrix uniforms a draw packet can set, e.g. WVP, world and light WVP
+#define DRAW_PACKET_MAX_MATRICES 3
+
+namespace miniGL
+{
+    /*!
+     *  \brief   Everything the GL thread needs to issue one draw call
+     *  \details The technique fills the program and the uniform locations, the mesh fills the geometry and the texture
+     *           of each of its entries. The values of the matrix uniforms are stored in the Recorder, the packet only
+     *           keeps their offset so that it stays small. The pass and the depth are only used to sort the packets in
+     *           a RenderQueue.
+     */
+    struct DrawPacket
+    {
+        GLuint program = 0;
+        GLuint vao = 0;
+        GLenum topology = GL_TRIANGLES;
+        GLenum frontFace = GL_CCW;
+        GLsizei indexCount = 0;
+        GLuint baseIndex = 0;
+        GLint baseVertex = 0;
+        GLuint colorTexture = 0;                                    //!< Bound on COLOR_TEXTURE_UNIT, or 0 to keep the current one
+        GLint matrixLocations[DRAW_PACKET_MAX_MATRICES] = { -1, -1, -1 };
+        unsigned int matrixCount = 0;
+        unsigned int matrixOffset = 0;                              //!< Index of the first matrix in the Recorder
+        GLint flagLocation = -1;                                    //!< Integer uniform switching a feature of the shader, or -1
+        GLint flagValue = 0;
+        unsigned int pass = 0;                                      //!< Drawn before the higher passes when the packets are sorted
+        float depth = 0.0f;                                         //!< Distance to the camera, e.g. WVP(3,3), to sort front to back
+    };
+
+} // namespace miniGL
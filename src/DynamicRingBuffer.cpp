@@ -0,0 +1,205 @@
+//===============================================================================================//
+/*!
+ *  \file      DynamicRingBuffer.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "DynamicRingBuffer.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+#include "GLUtils.hpp"
+
+// Time waited by each call to glClientWaitSync, in nanoseconds
+#define DYNAMIC_RING_BUFFER_WAIT 1000000
+
+using miniGL::DynamicRingBuffer;
+
+unsigned int DynamicRingBuffer::mCurrentFrame = 0;
+
+DynamicRingBuffer::~DynamicRingBuffer(void)
+{
+    clear();
+}
+
+void DynamicRingBuffer::init(GLenum pTarget, GLsizeiptr pFrameSize)
+{
+    assert(pFrameSize > 0 && "The regions of a ring buffer cannot be empty");
+
+    mTarget = pTarget;
+
+    _create(pFrameSize);
+}
+
+DynamicRingBuffer::Allocation DynamicRingBuffer::allocate(GLsizeiptr pSize, GLsizeiptr pAlignment)
+{
+    assert(mBuffer != 0 && "The ring buffer must be initialized before allocating from it");
+    assert(pAlignment > 0 && "The alignment must be at least 1 byte");
+
+    if (mFrame != mCurrentFrame)
+        _beginFrame();
+
+    GLsizeiptr lStart = (mHead + pAlignment - 1) / pAlignment * pAlignment;
+
+    if (lStart + pSize > mFrameSize)
+    {
+        // The draw calls of this frame still read the previous buffer and its allocations may not be committed yet
+        mRetiredBuffers.push_back(mBuffer);
+        _deleteFences();
+        _create(std::max(2 * mFrameSize, pSize + pAlignment));
+
+        lStart = 0;
+    }
+
+    mHead = lStart + pSize;
+
+    Allocation lAllocation;
+    lAllocation.offset = static_cast<GLintptr>(mRegion) * mFrameSize + lStart;
+    lAllocation.size = pSize;
+    lAllocation.buffer = mBuffer;
+
+    if (mMapping != nullptr)
+    {
+        lAllocation.data = mMapping + lAllocation.offset;
+    }
+    else
+    {
+        // The fence of the region already guarantees that the GPU does not read this range anymore
+        glBindBuffer(mTarget, mBuffer);
+        lAllocation.data = glMapBufferRange(mTarget, lAllocation.offset, pSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT); checkOpenGLState;
+    }
+
+    return lAllocation;
+}
+
+void DynamicRingBuffer::commit(const Allocation & pAllocation)
+{
+    assert(pAllocation.data != nullptr && "Committing an empty allocation");
+
+    // A coherent mapping does not need to be flushed
+    if (mMapping == nullptr)
+    {
+        glBindBuffer(mTarget, pAllocation.buffer);
+        glUnmapBuffer(mTarget); checkOpenGLState;
+    }
+}
+
+void DynamicRingBuffer::clear(void)
+{
+    if (mBuffer == 0)
+        return;
+
+    for (GLuint lBuffer : mRetiredBuffers)
+        _delete(lBuffer);
+
+    mRetiredBuffers.clear();
+
+    _delete(mBuffer);
+    _deleteFences();
+
+    mBuffer = 0;
+    mMapping = nullptr;
+}
+
+GLuint DynamicRingBuffer::id(void) const noexcept
+{
+    return mBuffer;
+}
+
+bool DynamicRingBuffer::persistent(void) const noexcept
+{
+    return mMapping != nullptr;
+}
+
+void DynamicRingBuffer::nextFrame(void)
+{
+    ++mCurrentFrame;
+}
+
+void DynamicRingBuffer::_beginFrame(void)
+{
+    // The draw calls of the previous frame are all issued, the fence signals when they are done
+    if (mFences[mRegion] != nullptr)
+        glDeleteSync(mFences[mRegion]);
+
+    mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    for (GLuint lBuffer : mRetiredBuffers)
+        _delete(lBuffer);
+
+    mRetiredBuffers.clear();
+
+    mFrame = mCurrentFrame;
+    mRegion = (mRegion + 1) % DYNAMIC_RING_BUFFER_FRAMES;
+    mHead = 0;
+
+    GLsync & rFence = mFences[mRegion];
+
+    if (rFence != nullptr)
+    {
+        GLenum lStatus = GL_TIMEOUT_EXPIRED;
+
+        while (lStatus == GL_TIMEOUT_EXPIRED)
+            lStatus = glClientWaitSync(rFence, GL_SYNC_FLUSH_COMMANDS_BIT, DYNAMIC_RING_BUFFER_WAIT);
+
+        assert(lStatus != GL_WAIT_FAILED && "Waiting on the fence of a ring buffer region failed");
+
+        glDeleteSync(rFence);
+        rFence = nullptr;
+    }
+}
+
+void DynamicRingBuffer::_delete(GLuint pBuffer)
+{
+    if (mMapping != nullptr)
+    {
+        glBindBuffer(mTarget, pBuffer);
+        glUnmapBuffer(mTarget);
+        glBindBuffer(mTarget, 0);
+    }
+
+    // OpenGL keeps the storage until the draw calls reading it are done
+    glDeleteBuffers(1, & pBuffer);
+}
+
+void DynamicRingBuffer::_deleteFences(void)
+{
+    for (GLsync & rFence : mFences)
+    {
+        if (rFence != nullptr)
+        {
+            glDeleteSync(rFence);
+            rFence = nullptr;
+        }
+    }
+}
+
+void DynamicRingBuffer::_create(GLsizeiptr pFrameSize)
+{
+    const GLsizeiptr lSize = pFrameSize * DYNAMIC_RING_BUFFER_FRAMES;
+
+    mFrameSize = pFrameSize;
+    mHead = 0;
+    mFrame = mCurrentFrame;
+
+    glGenBuffers(1, & mBuffer);
+    glBindBuffer(mTarget, mBuffer);
+
+    if (GLEW_ARB_buffer_storage)
+    {
+        const GLbitfield lFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(mTarget, lSize, nullptr, lFlags); checkOpenGLState;
+        mMapping = static_cast<unsigned char*>(glMapBufferRange(mTarget, 0, lSize, lFlags)); checkOpenGLState;
+    }
+    else
+    {
+        glBufferData(mTarget, lSize, nullptr, GL_STREAM_DRAW); checkOpenGLState;
+        mMapping = nullptr;
+    }
+
+    glBindBuffer(mTarget, 0);
+}
@@ -0,0 +1,133 @@
+//===============================================================================================//
+/*!
+ *  \file      DynamicRingBuffer.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include <GL/glew.h>
+
+// Number of frames that the CPU can write while the GPU still reads the previous ones
+#define DYNAMIC_RING_BUFFER_FRAMES 3
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class is a buffer object for the data written every frame, e.g. instance matrices or bone palettes
+     *  \details The buffer is split in DYNAMIC_RING_BUFFER_FRAMES regions and each frame writes in the next region,
+     *           so the storage is never reallocated. With ARB_buffer_storage the buffer stays mapped with persistent
+     *           and coherent access: an allocation is a pointer in that mapping and the data is written directly
+     *           where the GPU reads it. Without it (e.g. OpenGL 4.1 on macOS), each allocation maps its range
+     *           without synchronization and commit unmaps it. Each ring buffer fences its own regions: the first
+     *           allocation after nextFrame fences the region of the previous frame and waits on the fence of the
+     *           region it moves to, which is usually signaled long ago.
+     */
+    class DynamicRingBuffer
+    {
+    public:
+        //! Range of the buffer where to write the data of a draw call
+        struct Allocation
+        {
+            void* data = nullptr;       //!< Where to write, valid until commit
+            GLintptr offset = 0;        //!< Offset of the data in the buffer object, for glVertexAttribPointer, ...
+            GLsizeiptr size = 0;
+            GLuint buffer = 0;          //!< Buffer object of the data, the current one unless the ring buffer grew since
+        };
+
+    public:
+        /*!
+         *  \brief Destructor, see clear
+         */
+        ~DynamicRingBuffer(void);
+
+        /*!
+         *  \brief Create the buffer object
+         *  @param pTarget is the target used to map the buffer, e.g. GL_ARRAY_BUFFER, GL_TEXTURE_BUFFER, ...
+         *  @param pFrameSize is the initial number of bytes that a frame can allocate, the buffer grows if needed
+         */
+        void init(GLenum pTarget, GLsizeiptr pFrameSize);
+
+        /*!
+         *  \brief Get a range of the region of the current frame
+         *  \details If the region is full, the buffer object is replaced by a bigger one. The previous one stays
+         *           mapped until the end of the frame, so the allocations that were not committed yet remain valid
+         *  @param pSize is the number of bytes to write
+         *  @param pAlignment is the alignment of the offset in the buffer, in bytes
+         *  @return the range to write
+         */
+        Allocation allocate(GLsizeiptr pSize, GLsizeiptr pAlignment);
+
+        /*!
+         *  \brief Make the data of an allocation visible to the next draw calls
+         *  @param pAllocation was returned by the last call to allocate
+         */
+        void commit(const Allocation & pAllocation);
+
+        /*!
+         *  \brief Unmap and delete the buffer objects and the fences, init must be called again before allocating
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Get the buffer object
+         *  @return its id, it changes when the buffer grows
+         */
+        GLuint id(void) const noexcept;
+
+        /*!
+         *  \brief Check if the buffer is persistently mapped
+         *  @return true if ARB_buffer_storage is available
+         */
+        bool persistent(void) const noexcept;
+
+        /*!
+         *  \brief Start a new frame for all the ring buffers, once per frame. Each buffer moves to its next region on its
+         *         first allocation of the frame.
+         */
+        static void nextFrame(void);
+
+    private:
+        /*!
+         *  \brief Helper method called by the first allocation of a frame: fence the region of the previous frame,
+         *         delete the buffers replaced during that frame and wait until the next region is free
+         */
+        void _beginFrame(void);
+
+        /*!
+         *  \brief Helper method to unmap and delete a buffer object
+         *  @param pBuffer is the id of the buffer
+         */
+        void _delete(GLuint pBuffer);
+
+        /*!
+         *  \brief Helper method to delete the fences of all the regions
+         */
+        void _deleteFences(void);
+
+        /*!
+         *  \brief Create the buffer object, and map it if possible
+         *  @param pFrameSize is the size of each region in bytes
+         */
+        void _create(GLsizeiptr pFrameSize);
+
+    private:
+        GLenum mTarget = GL_ARRAY_BUFFER;
+        GLuint mBuffer = 0;
+        unsigned char* mMapping = nullptr;      //!< Persistent mapping of the whole buffer, or nullptr
+        GLsizeiptr mFrameSize = 0;
+        GLsizeiptr mHead = 0;                   //!< Bytes used in the region of the current frame
+        unsigned int mFrame = 0;                //!< Frame of the last allocation
+        unsigned int mRegion = 0;               //!< Region of the current frame
+        GLsync mFences[DYNAMIC_RING_BUFFER_FRAMES] = {};
+        std::vector<GLuint> mRetiredBuffers;    //!< Buffers replaced during the current frame, still mapped
+
+        static unsigned int mCurrentFrame;
+
+    }; // class DynamicRingBuffer
+
+} // namespace miniGL
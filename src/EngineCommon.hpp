@@ -47,5 +47,33 @@
 #define CASCADE_SHADOW_TEXTURE_UNIT2            GL_TEXTURE7
 #define CASCADE_SHADOW_TEXTURE_UNIT2_INDEX      7
 
+#define BONE_PALETTE_TEXTURE_UNIT               GL_TEXTURE8
+#define BONE_PALETTE_TEXTURE_UNIT_INDEX         8
+
+#define PREVIOUS_BONE_PALETTE_TEXTURE_UNIT          GL_TEXTURE9
+#define PREVIOUS_BONE_PALETTE_TEXTURE_UNIT_INDEX    9
+
+#define BAKED_ANIMATION_TEXTURE_UNIT            GL_TEXTURE10
+#define BAKED_ANIMATION_TEXTURE_UNIT_INDEX      10
+
+#define CLUSTER_LIGHTS_TEXTURE_UNIT             GL_TEXTURE11
+#define CLUSTER_LIGHTS_TEXTURE_UNIT_INDEX       11
+
+#define CLUSTER_ITEMS_TEXTURE_UNIT              GL_TEXTURE12
+#define CLUSTER_ITEMS_TEXTURE_UNIT_INDEX        12
+
+// Binding point of the LightBlock uniform block of the lighting programs
+#define LIGHTS_UNIFORM_BLOCK_BINDING 0
+
+// Binding point of the CameraBlock uniform block, attached when linking a program
+#define CAMERA_UNIFORM_BLOCK_BINDING 1
+
+// Binding point of the ClusterBlock uniform block of the clustered lighting programs
+#define CLUSTERS_UNIFORM_BLOCK_BINDING 2
+
 #define INDEX_LOCATION  0
 #define VERTEX_LOCATION 1
+
+// First locations of the per instance WVP and world matrices, each matrix uses 4 consecutive locations
+#define INSTANCE_WVP_LOCATION   4
+#define INSTANCE_WORLD_LOCATION 8
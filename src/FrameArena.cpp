@@ -0,0 +1,177 @@
+//===============================================================================================//
+/*!
+ *  \file      FrameArena.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "FrameArena.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <new>
+
+// Size of the first block of an arena, in bytes
+#define FRAME_ARENA_CAPACITY (64 * 1024)
+
+using miniGL::FrameArena;
+
+std::atomic<unsigned int> FrameArena::mCurrentFrame(0);
+
+#ifdef MINIGL_COUNT_HEAP_ALLOCATIONS
+
+// Replace the global allocation functions to count the allocations from the heap, only when the build opts in
+static std::atomic<unsigned long long> heapAllocationCount(0);
+
+void* operator new(std::size_t pSize)
+{
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    void* lPointer = std::malloc(pSize > 0 ? pSize : 1);
+
+    if (lPointer == nullptr)
+        throw std::bad_alloc();
+
+    return lPointer;
+}
+
+void* operator new[](std::size_t pSize)
+{
+    return ::operator new(pSize);
+}
+
+void operator delete(void* pPointer) noexcept
+{
+    std::free(pPointer);
+}
+
+void operator delete[](void* pPointer) noexcept
+{
+    std::free(pPointer);
+}
+
+void operator delete(void* pPointer, std::size_t) noexcept
+{
+    std::free(pPointer);
+}
+
+void operator delete[](void* pPointer, std::size_t) noexcept
+{
+    std::free(pPointer);
+}
+
+#endif
+
+FrameArena::FrameArena(void)
+:FrameArena(0)
+{
+}
+
+FrameArena::FrameArena(std::size_t pCapacity)
+:mCapacity(pCapacity),
+ mFrame(mCurrentFrame.load(std::memory_order_relaxed))
+{
+    if (mCapacity > 0)
+        mBlock = new unsigned char[mCapacity];
+}
+
+FrameArena::~FrameArena(void)
+{
+    reset();
+    delete [] mBlock;
+}
+
+void* FrameArena::allocate(std::size_t pSize, std::size_t pAlignment)
+{
+    assert(pAlignment > 0 && "The alignment must be at least 1 byte");
+
+    // First allocation of this frame, the previous frame does not use its memory anymore
+    const unsigned int lCurrentFrame = mCurrentFrame.load(std::memory_order_relaxed);
+
+    if (mFrame != lCurrentFrame)
+    {
+        reset();
+        mFrame = lCurrentFrame;
+    }
+
+    // The blocks from new [] are only aligned for the fundamental types, so the address is aligned and not the offset
+    std::uintptr_t lAddress = reinterpret_cast<std::uintptr_t>(mBlock) + mHead;
+    std::uintptr_t lAligned = (lAddress + pAlignment - 1) / pAlignment * pAlignment;
+
+    if (mBlock == nullptr || lAligned - reinterpret_cast<std::uintptr_t>(mBlock) + pSize > mCapacity)
+    {
+        _grow(pSize + pAlignment);
+
+        lAddress = reinterpret_cast<std::uintptr_t>(mBlock);
+        lAligned = (lAddress + pAlignment - 1) / pAlignment * pAlignment;
+    }
+
+    mHead = lAligned - reinterpret_cast<std::uintptr_t>(mBlock) + pSize;
+
+    return reinterpret_cast<void*>(lAligned);
+}
+
+void FrameArena::reset(void)
+{
+    for (unsigned char* rBlock : mRetiredBlocks)
+        delete [] rBlock;
+
+    // Keep the memory of the vector, it does not allocate during the next frames
+    mRetiredBlocks.clear();
+    mRetiredSize = 0;
+    mHead = 0;
+}
+
+std::size_t FrameArena::used(void) const noexcept
+{
+    return mRetiredSize + mHead;
+}
+
+std::size_t FrameArena::capacity(void) const noexcept
+{
+    return mCapacity;
+}
+
+FrameArena & FrameArena::frame(void)
+{
+    static FrameArena lArena(FRAME_ARENA_CAPACITY);
+    return lArena;
+}
+
+FrameArena & FrameArena::local(void)
+{
+    thread_local FrameArena lArena;
+    return lArena;
+}
+
+void FrameArena::nextFrame(void)
+{
+    mCurrentFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+unsigned long long FrameArena::heapAllocations(void) noexcept
+{
+#ifdef MINIGL_COUNT_HEAP_ALLOCATIONS
+    return heapAllocationCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+void FrameArena::_grow(std::size_t pMinimumSize)
+{
+    // The allocations of this frame stay valid, the block is freed by the next reset
+    if (mBlock != nullptr)
+    {
+        mRetiredBlocks.push_back(mBlock);
+        mRetiredSize += mHead;
+    }
+
+    // Big enough for everything allocated in this frame, so the next frames only use one block
+    mCapacity = std::max(std::max(2 * mCapacity, mRetiredSize + pMinimumSize), static_cast<std::size_t>(FRAME_ARENA_CAPACITY));
+    mBlock = new unsigned char[mCapacity];
+    mHead = 0;
+}
@@ -0,0 +1,192 @@
+//===============================================================================================//
+/*!
+ *  \file      FrameArena.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class is a linear allocator for the memory that only lives during one frame
+     *  \details An allocation moves a pointer in a block of memory and deallocating does nothing: all the memory is
+     *           released at once when the arena is reset. An arena resets itself on its first allocation after a call
+     *           to nextFrame, so the data allocated during a frame must not be used in the next one. When the block is
+     *           full, a bigger one is allocated and the previous one is kept until the reset: after a few frames the
+     *           block is big enough and the arena does not allocate from the heap anymore. An arena is not thread
+     *           safe, frame() is the arena of the main thread and local() gives each job its own arena.
+     */
+    class FrameArena
+    {
+    public:
+        /*!
+         *  \brief Default constructor, the first block is allocated on the first allocation
+         */
+        FrameArena(void);
+
+        /*!
+         *  \brief Constructor
+         *  @param pCapacity is the size of the first block in bytes
+         */
+        explicit FrameArena(std::size_t pCapacity);
+
+        /*!
+         *  \brief Destructor, free all the blocks
+         */
+        ~FrameArena(void);
+
+        FrameArena(const FrameArena & pArena) = delete;
+        FrameArena & operator=(const FrameArena & pArena) = delete;
+
+        /*!
+         *  \brief Get uninitialized memory valid until the end of the frame
+         *  @param pSize is the number of bytes
+         *  @param pAlignment is the alignment of the address in bytes
+         *  @return a pointer on the memory
+         */
+        void* allocate(std::size_t pSize, std::size_t pAlignment);
+
+        /*!
+         *  \brief Get uninitialized memory for an array
+         *  @param pCount is the number of elements of the array
+         *  @return a pointer on the first element
+         */
+        template<typename T>
+        T* allocate(std::size_t pCount)
+        {
+            return static_cast<T*>(allocate(sizeof(T) * pCount, alignof(T)));
+        }
+
+        /*!
+         *  \brief Release all the allocations at once, keeping the biggest block for the next frame
+         */
+        void reset(void);
+
+        /*!
+         *  \brief Get the number of bytes allocated since the last reset, including the alignment
+         *  @return the size in bytes
+         */
+        std::size_t used(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bytes that can be allocated without allocating from the heap
+         *  @return the size of the current block
+         */
+        std::size_t capacity(void) const noexcept;
+
+        /*!
+         *  \brief Get the arena of the main thread
+         *  @return a reference on the arena
+         */
+        static FrameArena & frame(void);
+
+        /*!
+         *  \brief Get the arena of the calling thread, e.g. in the jobs of a JobSystem
+         *  @return a reference on the arena
+         */
+        static FrameArena & local(void);
+
+        /*!
+         *  \brief Start a new frame, each arena resets itself on its next allocation
+         */
+        static void nextFrame(void);
+
+        /*!
+         *  \brief Count the allocations from the heap since the program started, to check that a steady frame
+         *         does not allocate
+         *  @return the number of calls to operator new when MINIGL_COUNT_HEAP_ALLOCATIONS is defined, 0 otherwise
+         */
+        static unsigned long long heapAllocations(void) noexcept;
+
+    private:
+        /*!
+         *  \brief Helper method to replace the current block by a bigger one
+         *  @param pMinimumSize is the number of bytes that the new block must at least contain
+         */
+        void _grow(std::size_t pMinimumSize);
+
+    private:
+        unsigned char* mBlock = nullptr;
+        std::size_t mCapacity = 0;
+        std::size_t mHead = 0;
+        std::size_t mRetiredSize = 0;                   //!< Bytes used in the retired blocks
+        std::vector<unsigned char*> mRetiredBlocks;     //!< Full blocks that can still be read until the reset
+        unsigned int mFrame = 0;
+
+        static std::atomic<unsigned int> mCurrentFrame;
+
+    }; // class FrameArena
+
+    /*!
+     *  \brief   Allocator for the standard containers, taking its memory from a FrameArena
+     *  \details The containers must not outlive the frame. Growing a container leaves its previous storage in the
+     *           arena until the reset, so it is better to reserve the final size first.
+     */
+    template<typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        /*!
+         *  \brief Constructor
+         *  @param pArena gives the memory, FrameArena::frame() by default
+         */
+        explicit ArenaAllocator(FrameArena & pArena = FrameArena::frame()) noexcept
+        :mArena(& pArena)
+        {
+        }
+
+        /*!
+         *  \brief Conversion constructor, used by the containers to allocate their internal types
+         */
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U> & pAllocator) noexcept
+        :mArena(& pAllocator.arena())
+        {
+        }
+
+        T* allocate(std::size_t pCount)
+        {
+            return mArena->allocate<T>(pCount);
+        }
+
+        void deallocate(T* /*pPointer*/, std::size_t /*pCount*/) noexcept
+        {
+            // Released by FrameArena::reset
+        }
+
+        FrameArena & arena(void) const noexcept
+        {
+            return *mArena;
+        }
+
+    private:
+        FrameArena* mArena;
+
+    }; // class ArenaAllocator
+
+    template<typename T, typename U>
+    bool operator==(const ArenaAllocator<T> & pA, const ArenaAllocator<U> & pB) noexcept
+    {
+        return & pA.arena() == & pB.arena();
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const ArenaAllocator<T> & pA, const ArenaAllocator<U> & pB) noexcept
+    {
+        return !(pA == pB);
+    }
+
+    //! Vector for the temporary data of a frame
+    template<typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace miniGL
@@ -0,0 +1,141 @@
+//===============================================================================================//
+/*!
+ *  \file      Frustum.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "Frustum.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "EnumClassCast.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MINIGL_FRUSTUM_SSE2
+#endif
+
+using std::vector;
+using miniGL::Frustum;
+
+Frustum::Frustum(void)
+{
+    // Planes with a null normal and a positive distance contain every point
+    mA.fill(0.0f);
+    mB.fill(0.0f);
+    mC.fill(0.0f);
+    mD.fill(1.0f);
+}
+
+Frustum::Frustum(const mat4f & pViewProjection)
+{
+    extract(pViewProjection);
+}
+
+void Frustum::extract(const mat4f & pViewProjection)
+{
+    // A point is in the clip volume if -w <= x, y, z <= w, so each plane is the last row plus or minus another row
+    const mat4f & M = pViewProjection;
+
+    for (unsigned int i = 0; i < toUT(EPlane::COUNT); ++i)
+    {
+        const unsigned int lRow = i / 2;
+        const float lSign = i % 2 == 0 ? 1.0f : -1.0f;
+
+        const float a = M(3,0) + lSign * M(lRow,0);
+        const float b = M(3,1) + lSign * M(lRow,1);
+        const float c = M(3,2) + lSign * M(lRow,2);
+        const float d = M(3,3) + lSign * M(lRow,3);
+
+        const float lLength = std::sqrt(a * a + b * b + c * c);
+
+        assert(lLength > 0.0f && "Degenerated view projection matrix");
+
+        mA[i] = a / lLength;
+        mB[i] = b / lLength;
+        mC[i] = c / lLength;
+        mD[i] = d / lLength;
+    }
+}
+
+vec4f Frustum::plane(EPlane pPlane) const
+{
+    assert(pPlane != EPlane::COUNT && "Invalid plane");
+
+    const unsigned int i = toUT(pPlane);
+
+    return vec4f(mA[i], mB[i], mC[i], mD[i]);
+}
+
+bool Frustum::intersectSphere(const vec3f & pCenter, float pRadius) const noexcept
+{
+    for (unsigned int i = 0; i < toUT(EPlane::COUNT); ++i)
+    {
+        if (mA[i] * pCenter.x() + mB[i] * pCenter.y() + mC[i] * pCenter.z() + mD[i] < -pRadius)
+            return false;
+    }
+
+    return true;
+}
+
+bool Frustum::intersectAABB(const vec3f & pMin, const vec3f & pMax) const noexcept
+{
+    for (unsigned int i = 0; i < toUT(EPlane::COUNT); ++i)
+    {
+        // Only the corner the furthest along the normal of the plane needs to be tested
+        const float x = mA[i] >= 0.0f ? pMax.x() : pMin.x();
+        const float y = mB[i] >= 0.0f ? pMax.y() : pMin.y();
+        const float z = mC[i] >= 0.0f ? pMax.z() : pMin.z();
+
+        if (mA[i] * x + mB[i] * y + mC[i] * z + mD[i] < 0.0f)
+            return false;
+    }
+
+    return true;
+}
+
+void Frustum::cullSpheres(const float* pX, const float* pY, const float* pZ, const float* pRadius, unsigned int pCount, vector<unsigned int> & pVisible) const
+{
+    pVisible.clear();
+
+    unsigned int i = 0;
+
+#if defined(MINIGL_FRUSTUM_SSE2)
+    // 4 spheres per iteration, a sphere is culled as soon as it is behind one of the planes
+    for (; i + 4 <= pCount; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(pX + i);
+        const __m128 y = _mm_loadu_ps(pY + i);
+        const __m128 z = _mm_loadu_ps(pZ + i);
+        const __m128 lMinusRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(pRadius + i));
+
+        __m128 lOutside = _mm_setzero_ps();
+
+        for (unsigned int j = 0; j < toUT(EPlane::COUNT); ++j)
+        {
+            __m128 lDistance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(mA[j])), _mm_set1_ps(mD[j]));
+            lDistance = _mm_add_ps(lDistance, _mm_mul_ps(y, _mm_set1_ps(mB[j])));
+            lDistance = _mm_add_ps(lDistance, _mm_mul_ps(z, _mm_set1_ps(mC[j])));
+
+            lOutside = _mm_or_ps(lOutside, _mm_cmplt_ps(lDistance, lMinusRadius));
+        }
+
+        const int lMask = _mm_movemask_ps(lOutside);
+
+        for (unsigned int k = 0; k < 4; ++k)
+        {
+            if ((lMask & (1 << k)) == 0)
+                pVisible.push_back(i + k);
+        }
+    }
+#endif
+
+    for (; i < pCount; ++i)
+    {
+        if (intersectSphere(vec3f(pX[i], pY[i], pZ[i]), pRadius[i]))
+            pVisible.push_back(i);
+    }
+}
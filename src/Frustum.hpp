@@ -0,0 +1,98 @@
+//===============================================================================================//
+/*!
+ *  \file      Frustum.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Algebra.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class contains the 6 planes of a view frustum to cull bounding volumes
+     *  \details The planes are extracted from a projection * view matrix (camera or light), their normals point toward
+     *           the inside of the frustum. They are stored component by component so that cullSpheres can test 4 spheres
+     *           per iteration with SSE2 instructions (scalar code otherwise).
+     */
+    class Frustum
+    {
+    public:
+        enum class EPlane : unsigned int
+        {
+            LEFT = 0,
+            RIGHT,
+            BOTTOM,
+            TOP,
+            NEAR,
+            FAR,
+            COUNT
+        };
+
+    public:
+        /*!
+         *  \brief Default constructor, the planes do not cull anything until extract is called
+         */
+        Frustum(void);
+
+        /*!
+         *  \brief Constructor from a view projection matrix
+         *  @param pViewProjection is the projection matrix multiplied by the view matrix
+         */
+        Frustum(const mat4f & pViewProjection);
+
+        /*!
+         *  \brief Compute the planes of a view projection matrix
+         *  @param pViewProjection is the projection matrix multiplied by the view matrix
+         */
+        void extract(const mat4f & pViewProjection);
+
+        /*!
+         *  \brief Get one of the planes
+         *  @param pPlane is the name of the plane
+         *  @return (a, b, c, d) with a normalized (a, b, c), a point p is inside if a * p.x + b * p.y + c * p.z + d >= 0
+         */
+        vec4f plane(EPlane pPlane) const;
+
+        /*!
+         *  \brief Test a sphere against the frustum
+         *  @param pCenter is the center of the sphere in the space of the view projection matrix (usually world space)
+         *  @param pRadius is the radius of the sphere
+         *  @return false if the sphere is entirely outside of the frustum
+         */
+        bool intersectSphere(const vec3f & pCenter, float pRadius) const noexcept;
+
+        /*!
+         *  \brief Test an axis aligned bounding box against the frustum
+         *  @param pMin is the corner of the box with the smallest coordinates
+         *  @param pMax is the corner of the box with the largest coordinates
+         *  @return false if the box is entirely outside of the frustum
+         */
+        bool intersectAABB(const vec3f & pMin, const vec3f & pMax) const noexcept;
+
+        /*!
+         *  \brief Test many spheres against the frustum
+         *  @param pX points to the x coordinate of the center of each sphere
+         *  @param pY points to the y coordinate of the center of each sphere
+         *  @param pZ points to the z coordinate of the center of each sphere
+         *  @param pRadius points to the radius of each sphere
+         *  @param pCount is the number of spheres
+         *  @param pVisible is cleared and filled with the indices of the spheres intersecting the frustum, in increasing order
+         */
+        void cullSpheres(const float* pX, const float* pY, const float* pZ, const float* pRadius, unsigned int pCount, std::vector<unsigned int> & pVisible) const;
+
+    private:
+        std::array<float, 6> mA;
+        std::array<float, 6> mB;
+        std::array<float, 6> mC;
+        std::array<float, 6> mD;
+
+    }; // class Frustum
+
+} // namespace miniGL
@@ -13,6 +13,7 @@
 
 #include "Exceptions.hpp"
 #include "Log.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::to_string;
@@ -20,6 +21,7 @@ using std::cout;
 using std::endl;
 using miniGL::GBuffer;
 using miniGL::Log;
+using miniGL::GLStateCache;
 
 GBuffer::~GBuffer(void)
 {
@@ -27,7 +29,7 @@ GBuffer::~GBuffer(void)
     lMessage.append(__FUNCTION__);
     Log::consoleMessage(lMessage);
 
-    glDisable(GL_TEXTURE_2D);
+    GLStateCache::disable(GL_TEXTURE_2D);
 
     if (mTextures[0] != Constants::invalidBufferIndex<GLuint>())
     {
@@ -35,31 +37,31 @@ GBuffer::~GBuffer(void)
         lMessage.append(to_string(mTextures.size()));
         lMessage.append(" textures");
         Log::consoleMessage(lMessage);
-        glDeleteTextures(mTextures.size(), mTextures.data());
+        GLStateCache::deleteTextures(mTextures.size(), mTextures.data());
     }
 
     if (mDepthTexture != Constants::invalidBufferIndex<GLuint>())
     {
         Log::consoleMessage("Delete depth texture");
 
-        glDeleteTextures(1, & mDepthTexture);
+        GLStateCache::deleteTextures(1, & mDepthTexture);
     }
 
     if (mFinalTexture != Constants::invalidBufferIndex<GLuint>())
     {
         Log::consoleMessage("Delete final texture");
-        glDeleteTextures(1, & mFinalTexture);
+        GLStateCache::deleteTextures(1, & mFinalTexture);
     }
 
     if (mFBO != Constants::invalidBufferIndex<GLuint>())
-        glDeleteFramebuffers(1, & mFBO);
+        GLStateCache::deleteFramebuffers(1, & mFBO);
 }
 
 void GBuffer::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
 {
     // Create frame buffer object and bind it for following operations
     glGenFramebuffers(1, & mFBO);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
 
     // Create textures for the vertex attributes
     glGenTextures(static_cast<GLint>(mTextures.size()), mTextures.data());
@@ -73,7 +75,7 @@ void GBuffer::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
     // Define textures for the vertex attributes
     for (unsigned int i = 0; i < mTextures.size(); ++i)
     {
-        glBindTexture(GL_TEXTURE_2D, mTextures[i]);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mTextures[i]);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, pWindowWidth, pWindowHeight, 0, GL_RGB, GL_FLOAT, nullptr);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -81,12 +83,12 @@ void GBuffer::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
     }
 
     // Define a texture for the depth buffer (depth + stencil)
-    glBindTexture(GL_TEXTURE_2D, mDepthTexture);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mDepthTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH32F_STENCIL8, pWindowWidth, pWindowHeight, 0, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, nullptr);
     glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, mDepthTexture, 0);
 
     // Define a texture for the final buffer
-    glBindTexture(GL_TEXTURE_2D, mFinalTexture);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mFinalTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pWindowWidth, pWindowHeight, 0, GL_RGB, GL_FLOAT, nullptr);
     glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT4, GL_TEXTURE_2D, mFinalTexture, 0);
 
@@ -99,19 +101,19 @@ void GBuffer::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
         throw Exceptions(lMessage, __FILE__, __LINE__);
     }
 
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 }
 
 void GBuffer::startFrame(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
     glDrawBuffer(GL_COLOR_ATTACHMENT4);
     glClear(GL_COLOR_BUFFER_BIT);
 }
 
 void GBuffer::bindForGeometryPass(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
     GLenum lDrawBuffers[3] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2};
     glDrawBuffers(3, lDrawBuffers);
 }
@@ -128,14 +130,14 @@ void GBuffer::bindForLightPass(void)
 
     for (unsigned int i = 0 ; i < mTextures.size(); i++)
     {
-        glActiveTexture(GL_TEXTURE0 + i);
-        glBindTexture(GL_TEXTURE_2D, mTextures[i]);
+        GLStateCache::activeTexture(GL_TEXTURE0 + i);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mTextures[i]);
     }
 }
 
 void GBuffer::bindForFinalPass(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, mFBO);
     glReadBuffer(GL_COLOR_ATTACHMENT4);
 }
@@ -15,6 +15,7 @@
 
 #include "EnumClassCast.hpp"
 #include "Constants.hpp"
+#include "GLStateCache.hpp"
 
 namespace miniGL
 {
@@ -102,17 +103,17 @@ namespace miniGL
 
     inline void GBuffer::bindForWriting(void)
     {
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+        GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
     }
 
     inline void GBuffer::bindForReading(void)
     {
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
         for (unsigned int i = 0 ; i < mTextures.size(); i++)
         {
-            glActiveTexture(GL_TEXTURE0 + i);
-            glBindTexture(GL_TEXTURE_2D, mTextures[i]);
+            GLStateCache::activeTexture(GL_TEXTURE0 + i);
+            GLStateCache::bindTexture(GL_TEXTURE_2D, mTextures[i]);
         }
     }
 
@@ -56,12 +56,10 @@ void GLFXLighting::init(unsigned int pPointLightCount, unsigned int pSpotLightCo
     LightingBase::initLightParametersLocations();
 
     // General lighting parameters
-    mWVPLocation = ProgramGLFX::uniformLocation("uWVP");
     mWorldLocation = ProgramGLFX::uniformLocation("uWorld");
     mSamplerLocation = ProgramGLFX::uniformLocation("uSampler");
     mUseSamplerLocation = ProgramGLFX::uniformLocation("uUseSampler");
     mUniformColorLocation = ProgramGLFX::uniformLocation("uColor");
-    mEyeWorldPosLocation = ProgramGLFX::uniformLocation("uEyeWorldPos");
     mMaterialSpecularIntensityLocation = ProgramGLFX::uniformLocation("uMaterialSpecularIntensity");
     mMaterialSpecularPowerLocation = ProgramGLFX::uniformLocation("uMaterialSpecularPower");
 
@@ -81,33 +79,21 @@ bool GLFXLighting::checkUniformLocations(void) const
 {
     bool lRes = true;
 
-    lRes &= (mWVPLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mWorldLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mSamplerLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mUseSamplerLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mUniformColorLocation != Constants::invalidUniformLocation<GLuint>());
-    lRes &= (mEyeWorldPosLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mMaterialSpecularIntensityLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mMaterialSpecularPowerLocation != Constants::invalidUniformLocation<GLuint>());
 
     return lRes;
 }
 
-void GLFXLighting::eyeWorldPosition(const vec3f & pEyeWorldPos)
-{
-    glUniform3f(mEyeWorldPosLocation, pEyeWorldPos.x(), pEyeWorldPos.y(), pEyeWorldPos.z());
-}
-
 void GLFXLighting::textureUnit(unsigned int pTexUnit)
 {
     glUniform1i(mSamplerLocation, pTexUnit);
 }
 
-void GLFXLighting::WVP(const mat4f & pWVP)
-{
-    glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
-}
-
 void GLFXLighting::worldMatrix(const mat4f & pWorld)
 {
     glUniformMatrix4fv(mWorldLocation, 1, GL_TRUE, const_cast<mat4f&>(pWorld).data());
@@ -45,24 +45,12 @@ namespace miniGL
          */
         void init(unsigned int pPointLightCount, unsigned int pSpotLightCount, const std::string & pPathGLSL = std::string(R"(./Shaders/GLFXLighting.glsl)"));
 
-        /*!
-         *  \brief Set the world view projection matrix
-         *  @param pWVP is a 4x4 matrix
-         */
-        void WVP(const mat4f & pWVP);
-
         /*!
          *  \brief Set the world matrix
          *  @param pWorld is a 4x4 matrix
          */
         void worldMatrix(const mat4f & pWorld);
 
-        /*!
-         *  \brief Set the position of the camera to calculate the specular component
-         *  @param pPos is the position of the camera
-         */
-        void eyeWorldPosition(const vec3f & pPos);
-
         /*!
          *  \brief Set material specular intensity
          *  @param pValue is a parameter in the range [0,1]
@@ -105,12 +93,10 @@ namespace miniGL
 
     private:
         std::string mProgramName;
-        GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mWorldLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mSamplerLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mUseSamplerLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mUniformColorLocation = Constants::invalidUniformLocation<GLuint>();
-        GLuint mEyeWorldPosLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mMaterialSpecularIntensityLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mMaterialSpecularPowerLocation = Constants::invalidUniformLocation<GLuint>();
 
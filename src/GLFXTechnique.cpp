@@ -9,7 +9,8 @@
 
 #include "GLFXTechnique.hpp"
 
-using std::map;
+#include "GLStateCache.hpp"
+
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -17,7 +18,9 @@ using std::shared_ptr;
 using miniGL::GLFXTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
+using miniGL::GLStateCache;
 
 GLFXTechnique::GLFXTechnique(void)
 :RenderingTechniqueBase("GLFXTechnique")
@@ -30,42 +33,32 @@ void GLFXTechnique::init(unsigned int pPointLightCount, unsigned int pSpotLightC
     mGLFXLighting->init(pPointLightCount, pSpotLightCount);
 }
 
-void GLFXTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void GLFXTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     mGLFXLighting->use();
     mGLFXLighting->useSampler(false);
     mGLFXLighting->updateLightsState(pLights);
 
-    mGLFXLighting->eyeWorldPosition(mCamera->position());
-
-    glDisable(GL_CULL_FACE);
+    GLStateCache::disable(GL_CULL_FACE);
 
     size_t i = 0;
-    for (auto it = pMeshes.cbegin(); it != pMeshes.cend(); it++)
+    for (const auto rMesh : findMeshesToRender(pMeshes))
     {
-        for (const auto name : mMeshToRenderNames)
+        for (unsigned int j = 0; j < rMesh->transform.size(); ++j)
         {
-            if (it->first == name)
-            {
-                for (auto transformation : it->second.transform)
-                {
-                    mat4f lWorld = transformation.final();
-                    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+            mat4f lWorld = rMesh->transform.world(j);
 
-                    mGLFXLighting->worldMatrix(lWorld);
-                    mGLFXLighting->WVP(lWVP);
-                    mGLFXLighting->uniformColor(mUniformColors[i].x(), mUniformColors[i].y(), mUniformColors[i].z());
+            mGLFXLighting->worldMatrix(lWorld);
+            mGLFXLighting->uniformColor(mUniformColors[i].x(), mUniformColors[i].y(), mUniformColors[i].z());
 
-                    if (i < mMeshToRenderNames.size() - 1)
-                        i++;
+            if (i < mMeshesToRender.names().size() - 1)
+                i++;
 
-                    it->second.mesh->render();
-                }
-            }
+            rMesh->mesh->render();
         }
     }
 
-    glEnable(GL_CULL_FACE);
+    GLStateCache::enable(GL_CULL_FACE);
 }
 
 void GLFXTechnique::addUniformColor(float pRed, float pGreen, float pBlue)
@@ -43,7 +43,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Add a color to render the mesh associated with this tecnique. The order used to add the meshes will match the color order.
@@ -0,0 +1,421 @@
+//===============================================================================================//
+/*!
+ *  \file      GLStateCache.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "GLStateCache.hpp"
+
+#include <cassert>
+
+// Value of a state that was never set, it is not a valid enum nor an id that OpenGL generates in practice
+#define GL_STATE_CACHE_UNKNOWN 0xFFFFFFFF
+
+using miniGL::GLStateCache;
+
+GLint GLStateCache::mCapabilities[GL_STATE_CACHE_CAPABILITIES] = { -1, -1, -1, -1, -1, -1, -1 };
+GLenum GLStateCache::mBlendSource = GL_STATE_CACHE_UNKNOWN;
+GLenum GLStateCache::mBlendDestination = GL_STATE_CACHE_UNKNOWN;
+GLenum GLStateCache::mBlendEquation = GL_STATE_CACHE_UNKNOWN;
+GLenum GLStateCache::mCullFace = GL_STATE_CACHE_UNKNOWN;
+GLenum GLStateCache::mFrontFace = GL_STATE_CACHE_UNKNOWN;
+GLint GLStateCache::mDepthMask = -1;
+GLenum GLStateCache::mDepthFunc = GL_STATE_CACHE_UNKNOWN;
+GLuint GLStateCache::mProgram = GL_STATE_CACHE_UNKNOWN;
+GLenum GLStateCache::mActiveTexture = GL_STATE_CACHE_UNKNOWN;
+GLuint GLStateCache::mTextures[GL_STATE_CACHE_TEXTURE_UNITS][GL_STATE_CACHE_TARGETS] = {};         // Texture 0 is bound on a new context
+GLuint GLStateCache::mDrawFramebuffer = GL_STATE_CACHE_UNKNOWN;
+GLuint GLStateCache::mReadFramebuffer = GL_STATE_CACHE_UNKNOWN;
+unsigned int GLStateCache::mIssuedCalls[toUT(ECall::COUNT)] = {};
+unsigned int GLStateCache::mFilteredCalls[toUT(ECall::COUNT)] = {};
+
+void GLStateCache::invalidate(void)
+{
+    for (GLint & rCapability : mCapabilities)
+        rCapability = -1;
+
+    mBlendSource = GL_STATE_CACHE_UNKNOWN;
+    mBlendDestination = GL_STATE_CACHE_UNKNOWN;
+    mBlendEquation = GL_STATE_CACHE_UNKNOWN;
+    mCullFace = GL_STATE_CACHE_UNKNOWN;
+    mFrontFace = GL_STATE_CACHE_UNKNOWN;
+    mDepthMask = -1;
+    mDepthFunc = GL_STATE_CACHE_UNKNOWN;
+    mProgram = GL_STATE_CACHE_UNKNOWN;
+    mActiveTexture = GL_STATE_CACHE_UNKNOWN;
+
+    for (auto & rUnit : mTextures)
+    {
+        for (GLuint & rTexture : rUnit)
+            rTexture = GL_STATE_CACHE_UNKNOWN;
+    }
+
+    mDrawFramebuffer = GL_STATE_CACHE_UNKNOWN;
+    mReadFramebuffer = GL_STATE_CACHE_UNKNOWN;
+}
+
+void GLStateCache::enable(GLenum pCapability)
+{
+    _capability(pCapability, true);
+}
+
+void GLStateCache::disable(GLenum pCapability)
+{
+    _capability(pCapability, false);
+}
+
+bool GLStateCache::isEnabled(GLenum pCapability)
+{
+    const int lIndex = _capabilityIndex(pCapability);
+
+    if (lIndex == -1)
+        return glIsEnabled(pCapability) == GL_TRUE;
+
+    if (mCapabilities[lIndex] == -1)
+        mCapabilities[lIndex] = glIsEnabled(pCapability);
+
+    return mCapabilities[lIndex] == GL_TRUE;
+}
+
+void GLStateCache::blendFunc(GLenum pSource, GLenum pDestination)
+{
+    if (_count(ECall::BLEND, pSource == mBlendSource && pDestination == mBlendDestination))
+    {
+        glBlendFunc(pSource, pDestination);
+        mBlendSource = pSource;
+        mBlendDestination = pDestination;
+    }
+}
+
+void GLStateCache::blendEquation(GLenum pMode)
+{
+    if (_count(ECall::BLEND, pMode == mBlendEquation))
+    {
+        glBlendEquation(pMode);
+        mBlendEquation = pMode;
+    }
+}
+
+void GLStateCache::cullFace(GLenum pMode)
+{
+    if (_count(ECall::FACE, pMode == mCullFace))
+    {
+        glCullFace(pMode);
+        mCullFace = pMode;
+    }
+}
+
+GLenum GLStateCache::cullFace(void)
+{
+    if (mCullFace == GL_STATE_CACHE_UNKNOWN)
+    {
+        GLint lCullFace = GL_BACK;
+        glGetIntegerv(GL_CULL_FACE_MODE, & lCullFace);
+        mCullFace = static_cast<GLenum>(lCullFace);
+    }
+
+    return mCullFace;
+}
+
+void GLStateCache::frontFace(GLenum pMode)
+{
+    if (_count(ECall::FACE, pMode == mFrontFace))
+    {
+        glFrontFace(pMode);
+        mFrontFace = pMode;
+    }
+}
+
+GLenum GLStateCache::frontFace(void)
+{
+    if (mFrontFace == GL_STATE_CACHE_UNKNOWN)
+    {
+        GLint lFrontFace = GL_CCW;
+        glGetIntegerv(GL_FRONT_FACE, & lFrontFace);
+        mFrontFace = static_cast<GLenum>(lFrontFace);
+    }
+
+    return mFrontFace;
+}
+
+void GLStateCache::depthMask(GLboolean pFlag)
+{
+    if (_count(ECall::DEPTH_MASK, pFlag == mDepthMask))
+    {
+        glDepthMask(pFlag);
+        mDepthMask = pFlag;
+    }
+}
+
+GLboolean GLStateCache::depthMask(void)
+{
+    if (mDepthMask == -1)
+    {
+        GLboolean lDepthMask = GL_TRUE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, & lDepthMask);
+        mDepthMask = lDepthMask;
+    }
+
+    return static_cast<GLboolean>(mDepthMask);
+}
+
+void GLStateCache::depthFunc(GLenum pFunction)
+{
+    if (_count(ECall::DEPTH_FUNC, pFunction == mDepthFunc))
+    {
+        glDepthFunc(pFunction);
+        mDepthFunc = pFunction;
+    }
+}
+
+GLenum GLStateCache::depthFunc(void)
+{
+    if (mDepthFunc == GL_STATE_CACHE_UNKNOWN)
+    {
+        GLint lDepthFunc = GL_LESS;
+        glGetIntegerv(GL_DEPTH_FUNC, & lDepthFunc);
+        mDepthFunc = static_cast<GLenum>(lDepthFunc);
+    }
+
+    return mDepthFunc;
+}
+
+void GLStateCache::useProgram(GLuint pProgram)
+{
+    if (_count(ECall::PROGRAM, pProgram == mProgram))
+    {
+        glUseProgram(pProgram);
+        mProgram = pProgram;
+    }
+}
+
+GLuint GLStateCache::program(void)
+{
+    if (mProgram == GL_STATE_CACHE_UNKNOWN)
+    {
+        GLint lProgram = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, & lProgram);
+        mProgram = static_cast<GLuint>(lProgram);
+    }
+
+    return mProgram;
+}
+
+void GLStateCache::activeTexture(GLenum pTextureUnit)
+{
+    if (_count(ECall::ACTIVE_TEXTURE, pTextureUnit == mActiveTexture))
+    {
+        glActiveTexture(pTextureUnit);
+        mActiveTexture = pTextureUnit;
+    }
+}
+
+void GLStateCache::bindTexture(GLenum pTarget, GLuint pTexture)
+{
+    if (mActiveTexture == GL_STATE_CACHE_UNKNOWN)
+    {
+        GLint lActiveTexture = GL_TEXTURE0;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, & lActiveTexture);
+        mActiveTexture = static_cast<GLenum>(lActiveTexture);
+    }
+
+    const GLuint lUnit = mActiveTexture - GL_TEXTURE0;
+    const int lTarget = _targetIndex(pTarget);
+
+    // The other units and targets are not tracked, their bindings are always sent
+    if (lUnit >= GL_STATE_CACHE_TEXTURE_UNITS || lTarget == -1)
+    {
+        _count(ECall::TEXTURE, false);
+        glBindTexture(pTarget, pTexture);
+        return;
+    }
+
+    if (_count(ECall::TEXTURE, pTexture == mTextures[lUnit][lTarget]))
+    {
+        glBindTexture(pTarget, pTexture);
+        mTextures[lUnit][lTarget] = pTexture;
+    }
+}
+
+void GLStateCache::deleteTextures(GLsizei pCount, const GLuint* pTextures)
+{
+    // OpenGL unbinds a deleted texture, and can give its id to a new texture
+    for (GLsizei i = 0; i < pCount; ++i)
+    {
+        for (auto & rUnit : mTextures)
+        {
+            for (GLuint & rTexture : rUnit)
+            {
+                if (rTexture == pTextures[i])
+                    rTexture = 0;
+            }
+        }
+    }
+
+    glDeleteTextures(pCount, pTextures);
+}
+
+void GLStateCache::bindFramebuffer(GLenum pTarget, GLuint pFramebuffer)
+{
+    assert((pTarget == GL_FRAMEBUFFER || pTarget == GL_DRAW_FRAMEBUFFER || pTarget == GL_READ_FRAMEBUFFER) && "Unknown framebuffer target");
+
+    const bool lDraw = (pTarget == GL_FRAMEBUFFER || pTarget == GL_DRAW_FRAMEBUFFER);
+    const bool lRead = (pTarget == GL_FRAMEBUFFER || pTarget == GL_READ_FRAMEBUFFER);
+    const bool lIsRedundant = (!lDraw || pFramebuffer == mDrawFramebuffer) && (!lRead || pFramebuffer == mReadFramebuffer);
+
+    if (_count(ECall::FRAMEBUFFER, lIsRedundant))
+    {
+        glBindFramebuffer(pTarget, pFramebuffer);
+
+        if (lDraw)
+            mDrawFramebuffer = pFramebuffer;
+
+        if (lRead)
+            mReadFramebuffer = pFramebuffer;
+    }
+}
+
+GLuint GLStateCache::framebuffer(GLenum pTarget)
+{
+    assert((pTarget == GL_DRAW_FRAMEBUFFER || pTarget == GL_READ_FRAMEBUFFER) && "Unknown framebuffer target");
+
+    GLuint & rFramebuffer = pTarget == GL_DRAW_FRAMEBUFFER ? mDrawFramebuffer : mReadFramebuffer;
+
+    if (rFramebuffer == GL_STATE_CACHE_UNKNOWN)
+    {
+        GLint lFramebuffer = 0;
+        glGetIntegerv(pTarget == GL_DRAW_FRAMEBUFFER ? GL_DRAW_FRAMEBUFFER_BINDING : GL_READ_FRAMEBUFFER_BINDING, & lFramebuffer);
+        rFramebuffer = static_cast<GLuint>(lFramebuffer);
+    }
+
+    return rFramebuffer;
+}
+
+void GLStateCache::deleteFramebuffers(GLsizei pCount, const GLuint* pFramebuffers)
+{
+    for (GLsizei i = 0; i < pCount; ++i)
+    {
+        if (mDrawFramebuffer == pFramebuffers[i])
+            mDrawFramebuffer = 0;
+
+        if (mReadFramebuffer == pFramebuffers[i])
+            mReadFramebuffer = 0;
+    }
+
+    glDeleteFramebuffers(pCount, pFramebuffers);
+}
+
+void GLStateCache::deleteProgram(GLuint pProgram)
+{
+    // OpenGL keeps a deleted program in use until another one is used, but its id can then be given to a new program
+    if (mProgram == pProgram)
+        mProgram = GL_STATE_CACHE_UNKNOWN;
+
+    glDeleteProgram(pProgram);
+}
+
+unsigned int GLStateCache::issuedCalls(ECall pCall)
+{
+    assert(pCall != ECall::COUNT && "Not a kind of call");
+
+    return mIssuedCalls[toUT(pCall)];
+}
+
+unsigned int GLStateCache::filteredCalls(ECall pCall)
+{
+    assert(pCall != ECall::COUNT && "Not a kind of call");
+
+    return mFilteredCalls[toUT(pCall)];
+}
+
+void GLStateCache::resetCounters(void)
+{
+    for (unsigned int i = 0; i < toUT(ECall::COUNT); ++i)
+    {
+        mIssuedCalls[i] = 0;
+        mFilteredCalls[i] = 0;
+    }
+}
+
+int GLStateCache::_capabilityIndex(GLenum pCapability) noexcept
+{
+    switch (pCapability)
+    {
+        case GL_DEPTH_TEST:
+            return 0;
+
+        case GL_STENCIL_TEST:
+            return 1;
+
+        case GL_BLEND:
+            return 2;
+
+        case GL_CULL_FACE:
+            return 3;
+
+        case GL_DEPTH_CLAMP:
+            return 4;
+
+        case GL_RASTERIZER_DISCARD:
+            return 5;
+
+        case GL_SCISSOR_TEST:
+            return 6;
+
+        default:
+            return -1;
+    }
+}
+
+int GLStateCache::_targetIndex(GLenum pTarget) noexcept
+{
+    switch (pTarget)
+    {
+        case GL_TEXTURE_1D:
+            return 0;
+
+        case GL_TEXTURE_2D:
+            return 1;
+
+        case GL_TEXTURE_2D_ARRAY:
+            return 2;
+
+        case GL_TEXTURE_CUBE_MAP:
+            return 3;
+
+        case GL_TEXTURE_BUFFER:
+            return 4;
+
+        default:
+            return -1;
+    }
+}
+
+void GLStateCache::_capability(GLenum pCapability, bool pEnable)
+{
+    const int lIndex = _capabilityIndex(pCapability);
+    const GLint lValue = pEnable ? GL_TRUE : GL_FALSE;
+
+    if (_count(ECall::CAPABILITY, lIndex != -1 && mCapabilities[lIndex] == lValue))
+    {
+        if (pEnable)
+            glEnable(pCapability);
+        else
+            glDisable(pCapability);
+
+        if (lIndex != -1)
+            mCapabilities[lIndex] = lValue;
+    }
+}
+
+bool GLStateCache::_count(ECall pCall, bool pIsRedundant) noexcept
+{
+    if (pIsRedundant)
+        ++mFilteredCalls[toUT(pCall)];
+    else
+        ++mIssuedCalls[toUT(pCall)];
+
+    return !pIsRedundant;
+}
@@ -0,0 +1,265 @@
+//===============================================================================================//
+/*!
+ *  \file      GLStateCache.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <type_traits>
+
+#include <GL/glew.h>
+
+#include "EnumClassCast.hpp"
+
+// Number of texture units whose bindings are tracked, the bindings of the other units are always sent to OpenGL
+#define GL_STATE_CACHE_TEXTURE_UNITS 16
+
+// Number of capabilities and texture targets that are tracked
+#define GL_STATE_CACHE_CAPABILITIES 7
+#define GL_STATE_CACHE_TARGETS 5
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class keeps a shadow copy of the OpenGL state to drop the calls that would not change it
+     *  \details The capabilities, the blending, the face culling, the depth mask and function, the program and the
+     *           texture and framebuffer bindings must be changed with these methods instead of the gl functions,
+     *           otherwise the shadow copy is wrong. The queries read the shadow copy, so they do not stall the pipeline like
+     *           glGet does, except for a state that was never set. Like GLUtils, the methods are static: there is
+     *           a single OpenGL context.
+     */
+    class GLStateCache
+    {
+    public:
+        //! Kinds of calls, to count them separately
+        enum class ECall
+        {
+            CAPABILITY = 0,
+            BLEND,
+            FACE,
+            DEPTH_MASK,
+            DEPTH_FUNC,
+            PROGRAM,
+            ACTIVE_TEXTURE,
+            TEXTURE,
+            FRAMEBUFFER,
+            COUNT
+        };
+
+    public:
+        /*!
+         *  \brief Forget the shadow copy, e.g. after a library changed the state with its own gl calls
+         */
+        static void invalidate(void);
+
+        /*!
+         *  \brief Enable an OpenGL capability, same as glEnable
+         *  @param pCapability is e.g. GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, ...
+         */
+        static void enable(GLenum pCapability);
+
+        /*!
+         *  \brief Disable an OpenGL capability, same as glDisable
+         *  @param pCapability is e.g. GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, ...
+         */
+        static void disable(GLenum pCapability);
+
+        /*!
+         *  \brief Check if an OpenGL capability is enabled, same as glIsEnabled
+         *  @param pCapability is e.g. GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, ...
+         *  @return true if the capability is enabled
+         */
+        static bool isEnabled(GLenum pCapability);
+
+        /*!
+         *  \brief Set the blending factors, same as glBlendFunc
+         *  @param pSource is the factor of the incoming color
+         *  @param pDestination is the factor of the color in the framebuffer
+         */
+        static void blendFunc(GLenum pSource, GLenum pDestination);
+
+        /*!
+         *  \brief Set the blending equation, same as glBlendEquation
+         *  @param pMode is e.g. GL_FUNC_ADD
+         */
+        static void blendEquation(GLenum pMode);
+
+        /*!
+         *  \brief Set the faces to cull, same as glCullFace
+         *  @param pMode is GL_FRONT, GL_BACK or GL_FRONT_AND_BACK
+         */
+        static void cullFace(GLenum pMode);
+
+        /*!
+         *  \brief Get the faces to cull, replaces glGetIntegerv(GL_CULL_FACE_MODE)
+         *  @return GL_FRONT, GL_BACK or GL_FRONT_AND_BACK
+         */
+        static GLenum cullFace(void);
+
+        /*!
+         *  \brief Set the orientation of the front faces, same as glFrontFace
+         *  @param pMode is GL_CW or GL_CCW
+         */
+        static void frontFace(GLenum pMode);
+
+        /*!
+         *  \brief Get the orientation of the front faces, replaces glGetIntegerv(GL_FRONT_FACE)
+         *  @return GL_CW or GL_CCW
+         */
+        static GLenum frontFace(void);
+
+        /*!
+         *  \brief Enable or disable the writing in the depth buffer, same as glDepthMask
+         *  @param pFlag is GL_TRUE to write the depth
+         */
+        static void depthMask(GLboolean pFlag);
+
+        /*!
+         *  \brief Check if the depth is written, replaces glGetBooleanv(GL_DEPTH_WRITEMASK)
+         *  @return GL_TRUE if the depth is written
+         */
+        static GLboolean depthMask(void);
+
+        /*!
+         *  \brief Set the depth comparison, same as glDepthFunc
+         *  @param pFunction is e.g. GL_LESS, GL_LEQUAL, ...
+         */
+        static void depthFunc(GLenum pFunction);
+
+        /*!
+         *  \brief Get the depth comparison, replaces glGetIntegerv(GL_DEPTH_FUNC)
+         *  @return e.g. GL_LESS, GL_LEQUAL, ...
+         */
+        static GLenum depthFunc(void);
+
+        /*!
+         *  \brief Use a program, same as glUseProgram
+         *  @param pProgram is the id of the program
+         */
+        static void useProgram(GLuint pProgram);
+
+        /*!
+         *  \brief Get the program in use, replaces glGetIntegerv(GL_CURRENT_PROGRAM)
+         *  @return the id of the program
+         */
+        static GLuint program(void);
+
+        /*!
+         *  \brief Select the texture unit of the next bindings, same as glActiveTexture
+         *  @param pTextureUnit is GL_TEXTURE0 + the index of the unit
+         */
+        static void activeTexture(GLenum pTextureUnit);
+
+        /*!
+         *  \brief Bind a texture on the active texture unit, same as glBindTexture
+         *  @param pTarget is e.g. GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, ...
+         *  @param pTexture is the id of the texture
+         */
+        static void bindTexture(GLenum pTarget, GLuint pTexture);
+
+        /*!
+         *  \brief Delete textures and forget their bindings, same as glDeleteTextures
+         *  @param pCount is the number of textures
+         *  @param pTextures points on their ids
+         */
+        static void deleteTextures(GLsizei pCount, const GLuint* pTextures);
+
+        /*!
+         *  \brief Bind a framebuffer, same as glBindFramebuffer
+         *  @param pTarget is GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER
+         *  @param pFramebuffer is the id of the framebuffer, 0 for the default one
+         */
+        static void bindFramebuffer(GLenum pTarget, GLuint pFramebuffer);
+
+        /*!
+         *  \brief Get a bound framebuffer, replaces glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING / GL_READ_FRAMEBUFFER_BINDING)
+         *  @param pTarget is GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER
+         *  @return the id of the framebuffer, 0 for the default one
+         */
+        static GLuint framebuffer(GLenum pTarget);
+
+        /*!
+         *  \brief Delete framebuffers and forget their bindings, same as glDeleteFramebuffers
+         *  @param pCount is the number of framebuffers
+         *  @param pFramebuffers points on their ids
+         */
+        static void deleteFramebuffers(GLsizei pCount, const GLuint* pFramebuffers);
+
+        /*!
+         *  \brief Delete a program and forget it if it is in use, same as glDeleteProgram
+         *  @param pProgram is the id of the program
+         */
+        static void deleteProgram(GLuint pProgram);
+
+        /*!
+         *  \brief Get the number of calls sent to OpenGL since the last reset
+         *  @param pCall is the kind of calls
+         *  @return the number of calls that changed the state, or that could not be checked
+         */
+        static unsigned int issuedCalls(ECall pCall);
+
+        /*!
+         *  \brief Get the number of calls dropped since the last reset
+         *  @param pCall is the kind of calls
+         *  @return the number of calls that would not have changed the state
+         */
+        static unsigned int filteredCalls(ECall pCall);
+
+        /*!
+         *  \brief Set all the counters to 0, e.g. at the beginning of a frame
+         */
+        static void resetCounters(void);
+
+    private:
+        /*!
+         *  \brief Get the index of a capability in mCapabilities
+         *  @param pCapability is the OpenGL enum
+         *  @return the index, or -1 if the capability is not tracked
+         */
+        static int _capabilityIndex(GLenum pCapability) noexcept;
+
+        /*!
+         *  \brief Get the index of a texture target in mTextures
+         *  @param pTarget is the OpenGL enum
+         *  @return the index, or -1 if the target is not tracked
+         */
+        static int _targetIndex(GLenum pTarget) noexcept;
+
+        /*!
+         *  \brief Enable or disable a capability if needed
+         *  @param pCapability is the OpenGL enum
+         *  @param pEnable is true to enable it
+         */
+        static void _capability(GLenum pCapability, bool pEnable);
+
+        /*!
+         *  \brief Count a call
+         *  @param pCall is the kind of the call
+         *  @param pIsRedundant is true if the call is dropped
+         *  @return true if the call must be sent to OpenGL
+         */
+        static bool _count(ECall pCall, bool pIsRedundant) noexcept;
+
+    private:
+        static GLint mCapabilities[GL_STATE_CACHE_CAPABILITIES];                                //!< GL_TRUE, GL_FALSE or -1 if unknown
+        static GLenum mBlendSource;
+        static GLenum mBlendDestination;
+        static GLenum mBlendEquation;
+        static GLenum mCullFace;
+        static GLenum mFrontFace;
+        static GLint mDepthMask;                                                                //!< GL_TRUE, GL_FALSE or -1 if unknown
+        static GLenum mDepthFunc;
+        static GLuint mProgram;
+        static GLenum mActiveTexture;
+        static GLuint mTextures[GL_STATE_CACHE_TEXTURE_UNITS][GL_STATE_CACHE_TARGETS];          //!< Binding of each target on each unit
+        static GLuint mDrawFramebuffer;
+        static GLuint mReadFramebuffer;
+        static unsigned int mIssuedCalls[toUT(ECall::COUNT)];
+        static unsigned int mFilteredCalls[toUT(ECall::COUNT)];
+
+    }; // class GLStateCache
+
+} // namespace miniGL
@@ -11,6 +11,7 @@
 #include <iostream>
 
 #include "Log.hpp"
+#include "GLStateCache.hpp"
 
 using std::cout;
 using std::endl;
@@ -18,14 +19,7 @@ using std::string;
 using std::to_string;
 using miniGL::GLUtils;
 using miniGL::Log;
-
-GLboolean GLUtils::mDepthTestIsEnabled = false;
-GLboolean GLUtils::mDepthTestWriteMaskIsEnabled = false;
-GLboolean GLUtils::mStencilTestIsEnabled = false;
-GLboolean GLUtils::mBlendIsEnabled = false;
-GLboolean GLUtils::mCullFaceIsEnabled = false;
-GLboolean GLUtils::mTextureCubeMapIsEnabled = false;
-GLboolean GLUtils::mRasterizerDiscardIsEnabled = false;
+using miniGL::GLStateCache;
 
 void GLCheck(const string & pFile, int pLineNumber, bool pLog)
 {
@@ -141,50 +135,47 @@ void GLUtils::check(const std::string & pFile, int pLineNumber, bool pLog)
 
 GLint GLUtils::currentReadFBO(void)
 {
-    GLint lReadFBOId = -1;
-    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &lReadFBOId);
-    return lReadFBOId;
+    return static_cast<GLint>(GLStateCache::framebuffer(GL_READ_FRAMEBUFFER));
 }
 
 GLint GLUtils::currentWriteFBO(void)
 {
-    GLint lWriteFBOId = -1;
-    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &lWriteFBOId);
-    return lWriteFBOId;
+    return static_cast<GLint>(GLStateCache::framebuffer(GL_DRAW_FRAMEBUFFER));
 }
 
 void GLUtils::currentState(void)
 {
-    glGetBooleanv(GL_DEPTH_TEST, & mDepthTestIsEnabled);
-    glGetBooleanv(GL_DEPTH_WRITEMASK, & mDepthTestWriteMaskIsEnabled);
-    glGetBooleanv(GL_STENCIL_TEST, & mStencilTestIsEnabled);
-    glGetBooleanv(GL_BLEND, & mBlendIsEnabled);
-    glGetBooleanv(GL_CULL_FACE, & mCullFaceIsEnabled);
-    glGetBooleanv(GL_TEXTURE_CUBE_MAP, & mTextureCubeMapIsEnabled);
-    glGetBooleanv(GL_RASTERIZER_DISCARD, & mRasterizerDiscardIsEnabled);
+    // GLStateCache holds the state, OpenGL is only queried for what the cache has never seen
+    const bool lDepthTestIsEnabled = GLStateCache::isEnabled(GL_DEPTH_TEST);
+    const bool lDepthTestWriteMaskIsEnabled = GLStateCache::depthMask() == GL_TRUE;
+    const bool lStencilTestIsEnabled = GLStateCache::isEnabled(GL_STENCIL_TEST);
+    const bool lBlendIsEnabled = GLStateCache::isEnabled(GL_BLEND);
+    const bool lCullFaceIsEnabled = GLStateCache::isEnabled(GL_CULL_FACE);
+    const bool lTextureCubeMapIsEnabled = GLStateCache::isEnabled(GL_TEXTURE_CUBE_MAP);
+    const bool lRasterizerDiscardIsEnabled = GLStateCache::isEnabled(GL_RASTERIZER_DISCARD);
 
     cout << "====================" << endl;
     cout << "OpenGL current state" << endl;
     cout << "====================" << endl;
 
-    string state(mDepthTestIsEnabled?"ON":"OFF");
+    string state(lDepthTestIsEnabled?"ON":"OFF");
     cout << "Depth test: " << state << endl;
 
-    state.assign(mDepthTestWriteMaskIsEnabled?"ON":"OFF");
+    state.assign(lDepthTestWriteMaskIsEnabled?"ON":"OFF");
     cout << "Depth test write mask: " << state << endl;
 
-    state.assign(mStencilTestIsEnabled?"ON":"OFF");
+    state.assign(lStencilTestIsEnabled?"ON":"OFF");
     cout << "Stencil test: " << state << endl;
 
-    state.assign(mBlendIsEnabled?"ON":"OFF");
+    state.assign(lBlendIsEnabled?"ON":"OFF");
     cout << "Blend: " << state << endl;
 
-    state.assign(mCullFaceIsEnabled?"ON":"OFF");
+    state.assign(lCullFaceIsEnabled?"ON":"OFF");
     cout << "Cull face: " << state << endl;
 
-    state.assign(mTextureCubeMapIsEnabled?"ON":"OFF");
+    state.assign(lTextureCubeMapIsEnabled?"ON":"OFF");
     cout << "Texture cube map: " << state << endl;
 
-    state.assign(mRasterizerDiscardIsEnabled?"ON":"OFF");
+    state.assign(lRasterizerDiscardIsEnabled?"ON":"OFF");
     cout << "Rasterizer discard: " << state << endl;
 }
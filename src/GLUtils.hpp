@@ -47,17 +47,6 @@ namespace miniGL
          */
         static void currentState(void);
 
-    private:
-        static GLint mCurrentReadFBO;
-        static GLint mCurrentWriteFBO;
-        static GLboolean mDepthTestIsEnabled;
-        static GLboolean mDepthTestWriteMaskIsEnabled;
-        static GLboolean mStencilTestIsEnabled;
-        static GLboolean mBlendIsEnabled;
-        static GLboolean mCullFaceIsEnabled;
-        static GLboolean mTextureCubeMapIsEnabled;
-        static GLboolean mRasterizerDiscardIsEnabled;
-
     }; // class GLUtils
 
 } // namespace miniGL
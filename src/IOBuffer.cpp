@@ -12,21 +12,23 @@
 
 #include "GLUtils.hpp"
 #include "Exceptions.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::to_string;
 using miniGL::IOBuffer;
+using miniGL::GLStateCache;
 
 IOBuffer::~IOBuffer(void)
 {
     if (mFBO != 0)
-        glDeleteFramebuffers(1, & mFBO);
+        GLStateCache::deleteFramebuffers(1, & mFBO);
 
     if (mTexture != 0)
-        glDeleteTextures(1, & mTexture);
+        GLStateCache::deleteTextures(1, & mTexture);
 
     if (mDepth != 0)
-        glDeleteTextures(1, & mDepth);
+        GLStateCache::deleteTextures(1, & mDepth);
 }
 
 void IOBuffer::init(unsigned int pFrameBufferWidth, unsigned int pFrameBufferHeight, bool pDepthBuffer, GLenum pInternalType)
@@ -57,13 +59,13 @@ void IOBuffer::init(unsigned int pFrameBufferWidth, unsigned int pFrameBufferHei
 
     // Create the FBO
     glGenFramebuffers(1, & mFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, mFBO);
 
     // Create the texture
     if (mInternalType != GL_NONE)
     {
         glGenTextures(1, & mTexture);
-        glBindTexture(GL_TEXTURE_2D, mTexture);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mTexture);
         glTexImage2D(GL_TEXTURE_2D, 0, mInternalType, pFrameBufferWidth, pFrameBufferHeight, 0, lFormat, lType, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -78,7 +80,7 @@ void IOBuffer::init(unsigned int pFrameBufferWidth, unsigned int pFrameBufferHei
     if (pDepthBuffer)
     {
         glGenTextures(1, & mDepth);
-        glBindTexture(GL_TEXTURE_2D, mDepth);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mDepth);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, pFrameBufferWidth, pFrameBufferHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -97,20 +99,20 @@ void IOBuffer::init(unsigned int pFrameBufferWidth, unsigned int pFrameBufferHei
     }
 
     // Ogldev uses GL_DRAW_FRAMEBUFFER instead of GL_FRAMEBUFFER
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); checkOpenGLState;
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); checkOpenGLState;
 }
 
 void IOBuffer::bindForWritting(void)
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, mFBO);
 }
 
 void IOBuffer::bindForReading(GLenum pTextureUnit)
 {
-    glActiveTexture(pTextureUnit);
+    GLStateCache::activeTexture(pTextureUnit);
 
     if (mInternalType == GL_NONE)
-        glBindTexture(GL_TEXTURE_2D, mDepth);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mDepth);
     else
-        glBindTexture(GL_TEXTURE_2D, mTexture);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mTexture);
 }
@@ -50,7 +50,6 @@ bool InstancedLighting::checkUniformLocations(void) const
     lRes &= (mUseNormalMapLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mLightWVPLocation != Constants::invalidUniformLocation<GLuint>());
 //    lRes &= (mShadowMapSizeLocation != Constants::invalidUniformLocation<GLuint>());
-    lRes &= (mEyeWorldPosLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mMaterialSpecularIntensityLocation != Constants::invalidUniformLocation<GLuint>());
     lRes &= (mMaterialSpecularPowerLocation != Constants::invalidUniformLocation<GLuint>());
 
@@ -100,7 +99,6 @@ void InstancedLighting::init(unsigned int pPointLightCount, unsigned int pSpotLi
     mShadowMapLocation = Program::uniformLocation("uShadowMap");
 //    mShadowMapSizeLocation = Program::uniformLocation("uShadowMapSize");
     mNormalMapLocation = Program::uniformLocation("uNormalMap");
-    mEyeWorldPosLocation = Program::uniformLocation("uEyeWorldPos");
     mMaterialSpecularIntensityLocation = Program::uniformLocation("uMaterialSpecularIntensity");
     mMaterialSpecularPowerLocation = Program::uniformLocation("uMaterialSpecularPower");
 
@@ -158,8 +156,3 @@ void InstancedLighting::useNormalMap(bool pActivate)
 {
     glUniform1i(mUseNormalMapLocation, pActivate?1:0);
 }
-
-void InstancedLighting::eyeWorldPosition(const vec3f & pEyeWorldPos)
-{
-    glUniform3f(mEyeWorldPosLocation, pEyeWorldPos.x(), pEyeWorldPos.y(), pEyeWorldPos.z());
-}
@@ -72,12 +72,6 @@ namespace miniGL
          */
         void useNormalMap(bool pActivate);
 
-        /*!
-         *  \brief Set the position of the camera to calculate the specular component
-         *  @param pEyeWorldPos is the position of the camera
-         */
-        void eyeWorldPosition(const vec3f & pEyeWorldPos);
-
     private:
         /*!
          *  \brief Implementation of a virtual method from Program
@@ -92,7 +86,6 @@ namespace miniGL
         GLuint mNormalMapLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mUseNormalMapLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mLightWVPLocation = Constants::invalidUniformLocation<GLuint>();
-        GLuint mEyeWorldPosLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mMaterialSpecularIntensityLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mMaterialSpecularPowerLocation = Constants::invalidUniformLocation<GLuint>();
 
@@ -9,7 +9,6 @@
 #include "InstancedLightingTechnique.hpp"
 
 using std::vector;
-using std::map;
 using std::make_unique;
 using std::shared_ptr;
 using std::string;
@@ -18,6 +17,7 @@ using std::tuple;
 using miniGL::InstancedLightingTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
 
 InstancedLightingTechnique::InstancedLightingTechnique(void)
@@ -32,44 +32,40 @@ void InstancedLightingTechnique::init(unsigned int pPointLightCount, const tuple
     mInstancedLighting->shadowMapSize(get<0>(pFramebufferDimensions), get<1>(pFramebufferDimensions));
 }
 
-void InstancedLightingTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void InstancedLightingTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     mInstancedLighting->use();
     mInstancedLighting->useNormalMap(false);
     mInstancedLighting->useShadowMap(false);
 
-    mInstancedLighting->eyeWorldPosition(mCamera->position());
-
     mInstancedLighting->updateLightsState(pLights);
 
-    assert(mMeshToRenderNames.size() == 1 && "Rendering only one mesh for the moment");
+    assert(mMeshesToRender.names().size() == 1 && "Rendering only one mesh for the moment");
 
-    for (auto it = pMeshes.cbegin(); it != pMeshes.cend(); it++)
+    for (const auto rMesh : findMeshesToRender(pMeshes))
     {
-        for (const auto name : mMeshToRenderNames)
+        // The WVP and world matrices of the instances are written directly in the instance streams of the mesh
+        const unsigned int lCount = static_cast<unsigned int>(mInstancePositions.size());
+        const MeshBase::InstanceStreams lStreams = rMesh->mesh->mapInstances(lCount);
+
+        const mat4f lViewProjection = mCamera->viewProjection();
+
+        for (unsigned int i = 0; i < lCount; ++i)
         {
-            if (it->first == name)
-            {
-                // Container for all the WVP and world matrices that will be sent to the GPU to render the mesh at different postions
-                vector<mat4f> lWVPs(mInstancePositions.size());
-                vector<mat4f> lWorlds(mInstancePositions.size());
-
-                for (unsigned int i = 0; i < mInstancePositions.size(); ++i)
-                {
-                    auto lTransform = it->second.transform[0];
-                    const auto lUpdatedPosition = mInstancePositions[i] + (mInstanceVelocities[i] * mInstanceVelocitiesMultiplier);
-                    lTransform.translation(lUpdatedPosition.x(), lUpdatedPosition.y(), lUpdatedPosition.z());
-                    lWorlds[i] = lTransform.final();
-
-                    lWVPs[i] = mCamera->projection() * mCamera->view() * lWorlds[i];
-
-                    lWorlds[i].transpose();
-                    lWVPs[i].transpose();
-                }
-
-                it->second.mesh->render(mInstancePositions.size(), lWVPs.data(), lWorlds.data());
-            }
+            // Same rotation and scaling as the first transform, only the translation changes
+            const auto lUpdatedPosition = mInstancePositions[i] + (mInstanceVelocities[i] * mInstanceVelocitiesMultiplier);
+            mat4f lWorld = rMesh->transform.world(0);
+            lWorld(0,3) = lUpdatedPosition.x();
+            lWorld(1,3) = lUpdatedPosition.y();
+            lWorld(2,3) = lUpdatedPosition.z();
+
+            mat4f lWVP = lViewProjection * lWorld;
+
+            lStreams.worlds[i] = lWorld.transpose();
+            lStreams.WVPs[i] = lWVP.transpose();
         }
+
+        rMesh->mesh->render(lCount, lStreams.WVPs, lStreams.worlds);
     }
 }
 
@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "RenderingTechniqueBase.hpp"
@@ -43,7 +42,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Set the positions where each instance of the meshes to be rendered will be placed
@@ -0,0 +1,48 @@
+//===============================================================================================//
+/*!
+ *  \file      InstancedSkinning.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "InstancedSkinning.hpp"
+
+#include "Exceptions.hpp"
+#include "GLUtils.hpp"
+#include "EngineCommon.hpp"
+
+using std::string;
+using miniGL::InstancedSkinning;
+using miniGL::InstancedLighting;
+using miniGL::Constants;
+using miniGL::Exceptions;
+
+void InstancedSkinning::init(unsigned int pPointLightCount, unsigned int pSpotLightCount, const string & pPathVS, const string & pPathFS)
+{
+    InstancedLighting::init(pPointLightCount, pSpotLightCount, pPathVS, pPathFS);
+
+    mBakedAnimationLocation = Program::uniformLocation("uBakedAnimation");
+    mTimeLocation = Program::uniformLocation("uTime");
+    mBoneInfluencesLocation = Program::uniformLocation("uBoneInfluences");
+    mBoneIndexBitsLocation = Program::uniformLocation("uBoneIndexBits");
+
+    if (mBakedAnimationLocation == Constants::invalidUniformLocation<GLuint>() || mTimeLocation == Constants::invalidUniformLocation<GLuint>() ||
+        mBoneInfluencesLocation == Constants::invalidUniformLocation<GLuint>() || mBoneIndexBitsLocation == Constants::invalidUniformLocation<GLuint>())
+        throw Exceptions("Not all uniform locations were updated", __FILE__, __LINE__);
+
+    glUniform1i(mBakedAnimationLocation, BAKED_ANIMATION_TEXTURE_UNIT_INDEX); checkOpenGLState;
+
+    time(0.0f);
+}
+
+void InstancedSkinning::time(float pTime)
+{
+    glUniform1f(mTimeLocation, pTime);
+}
+
+void InstancedSkinning::boneFormat(unsigned int pInfluences, unsigned int pIndexBits)
+{
+    glUniform1i(mBoneInfluencesLocation, static_cast<GLint>(pInfluences));
+    glUniform1i(mBoneIndexBitsLocation, static_cast<GLint>(pIndexBits));
+}
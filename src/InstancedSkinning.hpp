@@ -0,0 +1,57 @@
+//===============================================================================================//
+/*!
+ *  \file      InstancedSkinning.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <GL/glew.h>
+#include <string>
+
+#include "InstancedLighting.hpp"
+#include "Constants.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class handles the lighting shaders for instanced rendering of skinned meshes
+     *  \details The lighting is the same as for InstancedLighting, but each instance reads its pose from a
+     *           texture of baked animations (see BakedAnimation) using its own clip and time.
+     */
+    class InstancedSkinning : public InstancedLighting
+    {
+    public:
+        /*!
+         *  \brief Init the instanced skinning technique: create, compile and link the shaders and initialize all the uniform parameters
+         *  @param pPointLightCount is the number of point lights
+         *  @param pSpotLightCount is the number of spot lights
+         *  @param pPathVS is the path to the vertex shader
+         *  @param pPathFS is the path to the fragment shader
+         */
+        void init(unsigned int pPointLightCount, unsigned int pSpotLightCount, const std::string & pPathVS = std::string(R"(./Shaders/InstancedSkinning.vert)"), const std::string & pPathFS = std::string(R"(./Shaders/InstancedLighting.frag)"));
+
+        /*!
+         *  \brief Set the time used to play the baked animations
+         *  @param pTime is in seconds
+         */
+        void time(float pTime);
+
+        /*!
+         *  \brief Set the format of the packed bone IDs and weights of the mesh (see PackedBoneData)
+         *  @param pInfluences is the number of bones per vertex, 4 or 8
+         *  @param pIndexBits is the number of bits of each ID and weight, 8 or 16
+         */
+        void boneFormat(unsigned int pInfluences, unsigned int pIndexBits);
+
+    private:
+        GLuint mBakedAnimationLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mTimeLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mBoneInfluencesLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mBoneIndexBitsLocation = Constants::invalidUniformLocation<GLuint>();
+
+    }; // class InstancedSkinning
+
+} // namespace miniGL
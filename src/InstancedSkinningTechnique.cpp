@@ -0,0 +1,130 @@
+//===============================================================================================//
+/*!
+ *  \file      InstancedSkinningTechnique.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "InstancedSkinningTechnique.hpp"
+
+#include <cassert>
+
+#include "EngineCommon.hpp"
+#include "FrameArena.hpp"
+
+using std::vector;
+using std::make_unique;
+using std::shared_ptr;
+using std::string;
+using std::get;
+using std::tuple;
+using std::make_tuple;
+using miniGL::InstancedSkinningTechnique;
+using miniGL::RenderingTechniqueBase;
+using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
+using miniGL::BaseLight;
+using miniGL::MeshBase;
+using miniGL::FrameArena;
+using miniGL::ArenaAllocator;
+using miniGL::ArenaVector;
+
+InstancedSkinningTechnique::InstancedSkinningTechnique(void)
+:RenderingTechniqueBase("InstancedSkinningTechnique")
+{
+}
+
+void InstancedSkinningTechnique::init(unsigned int pPointLightCount, const tuple<unsigned int, unsigned int> & pFramebufferDimensions, float pSampleRate)
+{
+    mInstancedSkinning = make_unique<InstancedSkinning>();
+    mInstancedSkinning->init(pPointLightCount, 0u);
+    mInstancedSkinning->shadowMapSize(get<0>(pFramebufferDimensions), get<1>(pFramebufferDimensions));
+
+    mSampleRate = pSampleRate;
+}
+
+void InstancedSkinningTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+{
+    mInstancedSkinning->use();
+    mInstancedSkinning->useNormalMap(false);
+    mInstancedSkinning->useShadowMap(false);
+
+    mInstancedSkinning->time(mRunningTime);
+
+    mInstancedSkinning->updateLightsState(pLights);
+
+    assert(mMeshesToRender.names().size() == 1 && "Rendering only one mesh for the moment");
+
+    for (const auto rMeshAndTransform : findMeshesToRender(pMeshes))
+    {
+        const MeshBase* rMesh = rMeshAndTransform->mesh.get();
+
+        // Bake the animation once, after that the CPU does not evaluate any pose
+        if (rMesh != mBakedMesh)
+        {
+            mBakedAnimation.bake(rMesh->skeleton(), {& rMesh->animationClip()}, mSampleRate);
+            mBakedAnimation.upload();
+            mBakedMesh = rMesh;
+            mUploadInstanceAnimations = true;
+        }
+
+        mBakedAnimation.bind(BAKED_ANIMATION_TEXTURE_UNIT);
+        mInstancedSkinning->boneFormat(rMesh->boneInfluences(), rMesh->boneIndexBits());
+
+        const unsigned int lInstanceCount = static_cast<unsigned int>(mInstancePositions.size());
+
+        if (mUploadInstanceAnimations)
+        {
+            // Only needed until the upload, the memory is released with the frame
+            ArenaVector<vec4f> lAnimations(lInstanceCount, ArenaAllocator<vec4f>(FrameArena::frame()));
+
+            for (unsigned int i = 0; i < lInstanceCount; ++i)
+                lAnimations[i] = mBakedAnimation.instanceAttribute(0, get<1>(mInstanceAnimations[i]), get<0>(mInstanceAnimations[i]));
+
+            rMeshAndTransform->mesh->instanceAnimations(lInstanceCount, lAnimations.data());
+            mUploadInstanceAnimations = false;
+        }
+
+        // The WVP and world matrices of the instances are written directly in the instance streams of the mesh
+        const MeshBase::InstanceStreams lStreams = rMeshAndTransform->mesh->mapInstances(lInstanceCount);
+
+        const mat4f lViewProjection = mCamera->viewProjection();
+
+        for (unsigned int i = 0; i < lInstanceCount; ++i)
+        {
+            // Same rotation and scaling as the first transform, only the translation changes
+            mat4f lWorld = rMeshAndTransform->transform.world(0);
+            lWorld(0,3) = mInstancePositions[i].x();
+            lWorld(1,3) = mInstancePositions[i].y();
+            lWorld(2,3) = mInstancePositions[i].z();
+
+            mat4f lWVP = lViewProjection * lWorld;
+
+            lStreams.worlds[i] = lWorld.transpose();
+            lStreams.WVPs[i] = lWVP.transpose();
+        }
+
+        rMeshAndTransform->mesh->render(lInstanceCount, lStreams.WVPs, lStreams.worlds);
+    }
+}
+
+void InstancedSkinningTechnique::runningTime(float pRunningTime)
+{
+    mRunningTime = pRunningTime;
+}
+
+void InstancedSkinningTechnique::instancePositions(const vector<vec3f> & pInstancePositions)
+{
+    mInstancePositions = pInstancePositions;
+    mInstanceAnimations.resize(mInstancePositions.size(), make_tuple(0.0f, 1.0f));
+    mUploadInstanceAnimations = true;
+}
+
+void InstancedSkinningTechnique::instanceAnimation(unsigned int pInstance, float pTimeOffset, float pSpeed)
+{
+    assert(pInstance < mInstanceAnimations.size() && "Instance index out of boundaries");
+
+    mInstanceAnimations[pInstance] = make_tuple(pTimeOffset, pSpeed);
+    mUploadInstanceAnimations = true;
+}
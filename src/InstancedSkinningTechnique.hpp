@@ -0,0 +1,106 @@
+//===============================================================================================//
+/*!
+ *  \file      InstancedSkinningTechnique.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+
+#include "RenderingTechniqueBase.hpp"
+#include "InstancedSkinning.hpp"
+#include "BakedAnimation.hpp"
+#include "MeshAndTransform.hpp"
+#include "BaseLight.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief  This class encapsulates all the details to render crowds of animated instances of a skinned mesh
+     *  \details The animation of the mesh is baked in a texture the first time the mesh is rendered. Then all
+     *           the instances are drawn with a single instanced draw call per entry of the mesh, each instance
+     *           playing the animation with its own speed and time offset. The mesh must be a MeshSOA loaded
+     *           with the INSTANCE_RENDERING option.
+     */
+    class InstancedSkinningTechnique : public RenderingTechniqueBase
+    {
+    public:
+        /*!
+         *  \brief Default constructor
+         */
+        InstancedSkinningTechnique(void);
+
+        /*!
+         *  \brief Initialize the rendering technique
+         *  @param pPointLightCount is the number of point lights to render
+         *  @param pFramebufferDimensions contains the width (0) and the height (1) of the framebuffer
+         *  @param pSampleRate is the number of frames per second used to bake the animation
+         */
+        void init(unsigned int pPointLightCount, const std::tuple<unsigned int, unsigned int> & pFramebufferDimensions, float pSampleRate = 30.0f);
+
+        /*!
+         *  \brief Render the meshes provided as parameter using this rendering technique
+         *  @param pMeshes is a container with all the meshes
+         *  @param pLights is a container with all the lights
+         */
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+
+        /*!
+         *  \brief Set the running time, i.e. the time since the application started
+         *  @param pRunningTime is the time in seconds
+         */
+        void runningTime(float pRunningTime);
+
+        /*!
+         *  \brief Set the positions where each instance of the meshes to be rendered will be placed
+         *  @param pInstancePositions is a container with all the positions in world space
+         */
+        void instancePositions(const std::vector<vec3f> & pInstancePositions);
+
+        /*!
+         *  \brief Set the animation state of an instance, so that the instances do not move in lockstep
+         *  @param pInstance is the index of the instance in the container of positions
+         *  @param pTimeOffset is added to the running time of the instance, in seconds
+         *  @param pSpeed is the playback speed of the instance (1 for the original speed)
+         */
+        void instanceAnimation(unsigned int pInstance, float pTimeOffset, float pSpeed = 1.0f);
+
+        /*!
+         *  \brief Set the indices of the lights that will be used when rendering using a specific technique
+         *  @param pFirstIndex is the index of the first light to be added to the rendering technique
+         */
+        template<typename T, typename... Args>
+        void lightToUseDuringRender(T pFirstIndex, Args... otherIndices)
+        {
+            mInstancedSkinning->lightToUseDuringRender(pFirstIndex);
+            lightToUseDuringRender(otherIndices...);
+        }
+
+        /*!
+         *  \brief Set the indices of the last (or unique) light that will be used when rendering using a specific technique
+         *  @param pIndex is the index of the light to be added to the rendering technique
+         */
+        template<typename T>
+        void lightToUseDuringRender(T pIndex)
+        {
+            mInstancedSkinning->lightToUseDuringRender(pIndex);
+        }
+
+    private:
+        std::vector<vec3f> mInstancePositions;
+        std::vector<std::tuple<float, float>> mInstanceAnimations;
+
+        std::unique_ptr<InstancedSkinning> mInstancedSkinning;
+        BakedAnimation mBakedAnimation;
+        const MeshBase* mBakedMesh = nullptr;
+        float mSampleRate = 30.0f;
+        float mRunningTime = 0.0f;
+        bool mUploadInstanceAnimations = true;
+
+    }; // class InstancedSkinningTechnique
+
+} // namespace miniGL
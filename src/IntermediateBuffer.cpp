@@ -9,33 +9,35 @@
 #include "IntermediateBuffer.hpp"
 
 #include "Exceptions.hpp"
+#include "GLStateCache.hpp"
 
 using miniGL::Exceptions;
 using miniGL::IntermediateBuffer;
+using miniGL::GLStateCache;
 
 IntermediateBuffer::~IntermediateBuffer(void)
 {
     if (mFBO != 0)
     {
-        glDeleteFramebuffers(1, & mFBO);
+        GLStateCache::deleteFramebuffers(1, & mFBO);
         mFBO = 0;
     }
 
     if (mColorBuffer != 0)
     {
-        glDeleteTextures(1, & mColorBuffer);
+        GLStateCache::deleteTextures(1, & mColorBuffer);
         mColorBuffer = 0;
     }
 
     if (mMotionBuffer != 0)
     {
-        glDeleteTextures(1, & mMotionBuffer);
+        GLStateCache::deleteTextures(1, & mMotionBuffer);
         mMotionBuffer = 0;
     }
 
     if (mDepthBuffer != 0)
     {
-        glDeleteTextures(1, & mDepthBuffer);
+        GLStateCache::deleteTextures(1, & mDepthBuffer);
         mDepthBuffer = 0;
     }
 }
@@ -44,7 +46,7 @@ void IntermediateBuffer::init(unsigned int pFrameBufferWidth, unsigned int pFram
 {
     // Create the FBO
     glGenFramebuffers(1, & mFBO);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
 
     // Create the different buffers associated to the FBO
     glGenTextures(1, & mColorBuffer);
@@ -52,21 +54,21 @@ void IntermediateBuffer::init(unsigned int pFrameBufferWidth, unsigned int pFram
     glGenTextures(1, & mDepthBuffer);
 
     // Color buffer
-    glBindTexture(GL_TEXTURE_2D, mColorBuffer);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mColorBuffer);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, pFrameBufferWidth, pFrameBufferHeight, 0, GL_RGB, GL_FLOAT, nullptr);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mColorBuffer, 0);
 
     // Motion buffer
-    glBindTexture(GL_TEXTURE_2D, mMotionBuffer);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mMotionBuffer);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, pFrameBufferWidth, pFrameBufferHeight, 0, GL_RG, GL_FLOAT, nullptr);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, mMotionBuffer, 0);
 
     // Color buffer
-    glBindTexture(GL_TEXTURE_2D, mDepthBuffer);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mDepthBuffer);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, pFrameBufferWidth, pFrameBufferHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -83,21 +85,21 @@ void IntermediateBuffer::init(unsigned int pFrameBufferWidth, unsigned int pFram
         throw Exceptions("IntermediateBuffer not configured properly", __FILE__, __LINE__);
 
     // Restore the default FBO
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 }
 
 void IntermediateBuffer::bindForReading(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, mColorBuffer);
+    GLStateCache::activeTexture(GL_TEXTURE0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mColorBuffer);
 
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, mMotionBuffer);
+    GLStateCache::activeTexture(GL_TEXTURE1);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mMotionBuffer);
 }
 
 void IntermediateBuffer::bindForWritting(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
 }
@@ -0,0 +1,388 @@
+//===============================================================================================//
+/*!
+ *  \file      JobSystem.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "JobSystem.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+// Index of the queue of a thread that the system does not own
+#define JOB_SYSTEM_NO_QUEUE 0xFFFFFFFF
+
+static_assert((JOB_SYSTEM_QUEUE_SIZE & (JOB_SYSTEM_QUEUE_SIZE - 1)) == 0, "The positions in the queues are wrapped with a mask");
+
+using std::vector;
+using std::thread;
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::function;
+using std::make_unique;
+using miniGL::JobSystem;
+
+// System and queue of the calling worker thread, set when the worker starts
+static thread_local const JobSystem* workerJobSystem = nullptr;
+static thread_local unsigned int workerIndex = 0;
+
+JobSystem::Counter::Counter(void) noexcept
+:mPending(0)
+{
+}
+
+JobSystem::Counter::~Counter(void)
+{
+    assert(done() && "A counter is destroyed before the end of its jobs");
+}
+
+bool JobSystem::Counter::done(void) const noexcept
+{
+    return mPending.load() == 0;
+}
+
+JobSystem::Queue::Queue(void)
+:top(0),
+ bottom(0),
+ nextSlot(0)
+{
+    for (unsigned int i = 0; i < JOB_SYSTEM_QUEUE_SIZE; ++i)
+    {
+        ring[i].store(nullptr, std::memory_order_relaxed);
+        slots[i].busy.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool JobSystem::Queue::push(Job & pJob)
+{
+    Slot & rSlot = slots[nextSlot & (JOB_SYSTEM_QUEUE_SIZE - 1)];
+
+    if (rSlot.busy.load(std::memory_order_acquire))
+        return false;
+
+    const long long lBottom = bottom.load(std::memory_order_relaxed);
+    const long long lTop = top.load(std::memory_order_acquire);
+
+    if (lBottom - lTop >= JOB_SYSTEM_QUEUE_SIZE)
+        return false;
+
+    ++nextSlot;
+    rSlot.busy.store(true, std::memory_order_relaxed);
+    rSlot.job = std::move(pJob);
+
+    // The thieves must see the job before the new bottom
+    ring[lBottom & (JOB_SYSTEM_QUEUE_SIZE - 1)].store(& rSlot, std::memory_order_relaxed);
+    bottom.store(lBottom + 1, std::memory_order_release);
+
+    return true;
+}
+
+JobSystem::Slot* JobSystem::Queue::pop(void)
+{
+    // The new bottom must be visible before reading top, a thief reads them in the opposite order
+    const long long lBottom = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(lBottom, std::memory_order_seq_cst);
+    long long lTop = top.load(std::memory_order_seq_cst);
+
+    if (lTop > lBottom)
+    {
+        bottom.store(lBottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Slot* rSlot = ring[lBottom & (JOB_SYSTEM_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+
+    // The last job, a thief may be taking it at the same time
+    if (lTop == lBottom)
+    {
+        if (!top.compare_exchange_strong(lTop, lTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            rSlot = nullptr;
+
+        bottom.store(lBottom + 1, std::memory_order_relaxed);
+    }
+
+    return rSlot;
+}
+
+JobSystem::Slot* JobSystem::Queue::steal(void)
+{
+    long long lTop = top.load(std::memory_order_seq_cst);
+    const long long lBottom = bottom.load(std::memory_order_seq_cst);
+
+    if (lTop >= lBottom)
+        return nullptr;
+
+    Slot* rSlot = ring[lTop & (JOB_SYSTEM_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+
+    if (!top.compare_exchange_strong(lTop, lTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+
+    return rSlot;
+}
+
+JobSystem::JobSystem(unsigned int pThreadCount)
+:mMainThread(std::this_thread::get_id()),
+ mQueuedJobs(0),
+ mSleepingWorkers(0)
+{
+    if (pThreadCount == 0)
+        pThreadCount = std::max(thread::hardware_concurrency(), 1u);
+
+    for (unsigned int i = 0; i < pThreadCount; ++i)
+        mQueues.push_back(make_unique<Queue>());
+
+    mWorkers.reserve(pThreadCount - 1);
+
+    for (unsigned int i = 1; i < pThreadCount; ++i)
+        mWorkers.emplace_back(&JobSystem::_work, this, i);
+}
+
+JobSystem::~JobSystem(void)
+{
+    {
+        lock_guard<mutex> lLock(mSleepMutex);
+        mStop = true;
+    }
+
+    mWakeCondition.notify_all();
+
+    for (auto & lWorker : mWorkers)
+        lWorker.join();
+}
+
+unsigned int JobSystem::threadCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mWorkers.size()) + 1;
+}
+
+void JobSystem::schedule(function<void(void)> pTask, Counter* pCounter, Counter* pDependency)
+{
+    if (pCounter != nullptr)
+        pCounter->mPending.fetch_add(1);
+
+    if (pDependency != nullptr)
+    {
+        lock_guard<mutex> lLock(pDependency->mMutex);
+
+        // The last job of the dependency decrements it under the same lock, so the job cannot be forgotten
+        if (!pDependency->done())
+        {
+            pDependency->mDependents.push_back([this, pTask, pCounter](){ _push(Job{ pTask, nullptr, 0, 0, pCounter }); });
+            return;
+        }
+    }
+
+    _push(Job{ std::move(pTask), nullptr, 0, 0, pCounter });
+}
+
+void JobSystem::scheduleOnMainThread(function<void(void)> pTask, Counter* pCounter)
+{
+    if (pCounter != nullptr)
+        pCounter->mPending.fetch_add(1);
+
+    lock_guard<mutex> lLock(mMainThreadQueue.mutex);
+    mMainThreadQueue.jobs.push_back(Job{ std::move(pTask), nullptr, 0, 0, pCounter });
+}
+
+void JobSystem::runMainThreadJobs(void)
+{
+    assert(std::this_thread::get_id() == mMainThread && "Only the main thread runs the main thread lane");
+
+    // Only the jobs already there, a job scheduling another one on the main thread does not loop forever
+    std::size_t lCount = 0;
+
+    {
+        lock_guard<mutex> lLock(mMainThreadQueue.mutex);
+        lCount = mMainThreadQueue.jobs.size();
+    }
+
+    for (std::size_t i = 0; i < lCount; ++i)
+    {
+        Job lJob;
+
+        {
+            lock_guard<mutex> lLock(mMainThreadQueue.mutex);
+
+            // wait() may have run some of them in the meantime
+            if (mMainThreadQueue.jobs.empty())
+                return;
+
+            lJob = std::move(mMainThreadQueue.jobs.front());
+            mMainThreadQueue.jobs.pop_front();
+        }
+
+        _run(lJob);
+    }
+}
+
+void JobSystem::wait(Counter & pCounter)
+{
+    const unsigned int lIndex = _threadIndex();
+
+    while (!pCounter.done())
+    {
+        if (!_runOne(lIndex))
+            std::this_thread::yield();
+    }
+
+    // The last job may still hold the lock of the counter after decrementing it, the counter can be destroyed
+    // after this point only
+    lock_guard<mutex> lLock(pCounter.mMutex);
+}
+
+void JobSystem::parallelFor(unsigned int pCount, const function<void(unsigned int, unsigned int)> & pTask)
+{
+    if (pCount == 0)
+        return;
+
+    if (mWorkers.empty())
+    {
+        pTask(0, pCount);
+        return;
+    }
+
+    // Several chunks per thread to balance the load when the items do not take the same time
+    const unsigned int lChunkSize = std::max(pCount / (threadCount() * 4), 1u);
+
+    Counter lCounter;
+
+    // The chunks point to the task, no std::function is created per chunk
+    for (unsigned int lBegin = 0; lBegin < pCount; lBegin += lChunkSize)
+    {
+        lCounter.mPending.fetch_add(1);
+        _push(Job{ nullptr, & pTask, lBegin, std::min(lBegin + lChunkSize, pCount), & lCounter });
+    }
+
+    wait(lCounter);
+}
+
+void JobSystem::_work(unsigned int pIndex)
+{
+    workerJobSystem = this;
+    workerIndex = pIndex;
+
+    while (true)
+    {
+        if (_runOne(pIndex))
+            continue;
+
+        unique_lock<mutex> lLock(mSleepMutex);
+
+        mSleepingWorkers.fetch_add(1);
+        mWakeCondition.wait(lLock, [this]{ return mStop || mQueuedJobs.load() > 0; });
+        mSleepingWorkers.fetch_sub(1);
+
+        if (mStop)
+            return;
+    }
+}
+
+bool JobSystem::_runOne(unsigned int pIndex)
+{
+    // The most recent job of the thread first, its data is still in the cache
+    Slot* rSlot = pIndex != JOB_SYSTEM_NO_QUEUE ? mQueues[pIndex]->pop() : nullptr;
+
+    if (rSlot == nullptr && pIndex == 0)
+    {
+        Job lJob;
+        bool lFound = false;
+
+        {
+            lock_guard<mutex> lLock(mMainThreadQueue.mutex);
+
+            if (!mMainThreadQueue.jobs.empty())
+            {
+                lJob = std::move(mMainThreadQueue.jobs.front());
+                mMainThreadQueue.jobs.pop_front();
+                lFound = true;
+            }
+        }
+
+        if (lFound)
+        {
+            _run(lJob);
+            return true;
+        }
+    }
+
+    // The oldest job of another thread, it is usually the biggest part of the work left
+    const unsigned int lFirst = pIndex != JOB_SYSTEM_NO_QUEUE ? pIndex : 0;
+
+    for (unsigned int i = 1; rSlot == nullptr && i <= mQueues.size(); ++i)
+    {
+        const unsigned int lVictim = (lFirst + i) % mQueues.size();
+
+        if (lVictim != pIndex)
+            rSlot = mQueues[lVictim]->steal();
+    }
+
+    if (rSlot == nullptr)
+        return false;
+
+    mQueuedJobs.fetch_sub(1);
+    _run(rSlot->job);
+
+    // The owner can reuse the slot
+    rSlot->job.task = nullptr;
+    rSlot->busy.store(false, std::memory_order_release);
+
+    return true;
+}
+
+void JobSystem::_push(Job && pJob)
+{
+    const unsigned int lIndex = _threadIndex();
+
+    if (lIndex == JOB_SYSTEM_NO_QUEUE || !mQueues[lIndex]->push(pJob))
+    {
+        _run(pJob);
+        return;
+    }
+
+    mQueuedJobs.fetch_add(1);
+
+    // A worker registers as sleeping before checking mQueuedJobs, so either it sees the job or it is notified. Taking
+    // the lock makes sure the worker is waiting when notified.
+    if (mSleepingWorkers.load() > 0)
+    {
+        {
+            lock_guard<mutex> lLock(mSleepMutex);
+        }
+
+        mWakeCondition.notify_one();
+    }
+}
+
+void JobSystem::_run(Job & pJob)
+{
+    if (pJob.range != nullptr)
+        (*pJob.range)(pJob.begin, pJob.end);
+    else
+        pJob.task();
+
+    if (pJob.counter == nullptr)
+        return;
+
+    vector<function<void(void)>> lDependents;
+
+    {
+        lock_guard<mutex> lLock(pJob.counter->mMutex);
+
+        if (pJob.counter->mPending.fetch_sub(1) == 1)
+            lDependents.swap(pJob.counter->mDependents);
+    }
+
+    for (auto & rDependent : lDependents)
+        rDependent();
+}
+
+unsigned int JobSystem::_threadIndex(void) const noexcept
+{
+    if (workerJobSystem == this)
+        return workerIndex;
+
+    return std::this_thread::get_id() == mMainThread ? 0 : JOB_SYSTEM_NO_QUEUE;
+}
@@ -0,0 +1,238 @@
+//===============================================================================================//
+/*!
+ *  \file      JobSystem.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Number of jobs that each thread can queue, a power of 2. A job scheduled on a full queue runs immediately.
+#define JOB_SYSTEM_QUEUE_SIZE 1024
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class runs the CPU work of the engine as small jobs on a set of worker threads
+     *  \details Each thread has its own lock-free deque of jobs (Chase-Lev): it pushes and pops its jobs at the bottom,
+     *           and the threads without work steal the oldest jobs at the top of the other deques. The deques and the
+     *           jobs they point to are fixed arrays of JOB_SYSTEM_QUEUE_SIZE elements, so scheduling does not allocate
+     *           (except for the captures of a large task given to schedule). The thread that creates the system takes
+     *           part in the work when it waits for a counter, so a system created with N threads starts N - 1 workers.
+     *           A thread that the system does not own runs the jobs it schedules immediately. The jobs that call OpenGL
+     *           go to a separate lane that only the main thread runs, since the context is current on this thread only.
+     */
+    class JobSystem
+    {
+    public:
+        /*!
+         *  \brief   Number of jobs that are not finished yet
+         *  \details A counter is incremented when a job is scheduled with it and decremented when the job ends. It can
+         *           be waited for, or used as a dependency of other jobs. It must stay alive until it reaches 0 and
+         *           until the jobs depending on it are started.
+         */
+        class Counter
+        {
+        public:
+            /*!
+             *  \brief Default constructor, no pending job
+             */
+            Counter(void) noexcept;
+
+            /*!
+             *  \brief Destructor, asserts that all the jobs ended
+             */
+            ~Counter(void);
+
+            Counter(const Counter & pCounter) = delete;
+            Counter & operator=(const Counter & pCounter) = delete;
+
+            /*!
+             *  \brief Check if all the jobs using this counter ended
+             *  @return true if there is no pending job
+             */
+            bool done(void) const noexcept;
+
+        private:
+            friend class JobSystem;
+
+            std::atomic<unsigned int> mPending;
+            std::mutex mMutex;
+            std::vector<std::function<void(void)>> mDependents;     //!< Jobs waiting for this counter, pushed when it reaches 0
+
+        }; // class Counter
+
+    public:
+        /*!
+         *  \brief Constructor
+         *  @param pThreadCount is the number of threads running jobs, including the calling thread which becomes the
+         *         main thread. If 0, the number of hardware threads is used.
+         */
+        explicit JobSystem(unsigned int pThreadCount = 0);
+
+        /*!
+         *  \brief Destructor, wait for the workers to finish. The scheduled jobs must be finished.
+         */
+        ~JobSystem(void);
+
+        JobSystem(const JobSystem & pJobSystem) = delete;
+        JobSystem & operator=(const JobSystem & pJobSystem) = delete;
+
+        /*!
+         *  \brief Get the number of threads running jobs, including the main thread
+         *  @return the number of threads
+         */
+        unsigned int threadCount(void) const noexcept;
+
+        /*!
+         *  \brief Schedule a job on any thread
+         *  @param pTask is the work to do, it can schedule other jobs and wait for them
+         *  @param pCounter is incremented now and decremented when the job ends, or nullptr
+         *  @param pDependency delays the job until it reaches 0, or nullptr to start the job as soon as possible
+         */
+        void schedule(std::function<void(void)> pTask, Counter* pCounter = nullptr, Counter* pDependency = nullptr);
+
+        /*!
+         *  \brief Schedule a job that must run on the main thread, e.g. a job calling OpenGL
+         *  @param pTask is the work to do
+         *  @param pCounter is incremented now and decremented when the job ends, or nullptr
+         */
+        void scheduleOnMainThread(std::function<void(void)> pTask, Counter* pCounter = nullptr);
+
+        /*!
+         *  \brief Run the jobs of the main thread lane scheduled so far, e.g. once per frame
+         */
+        void runMainThreadJobs(void);
+
+        /*!
+         *  \brief Run other jobs until all the jobs of a counter ended
+         *  @param pCounter is the counter to wait for
+         */
+        void wait(Counter & pCounter);
+
+        /*!
+         *  \brief Run a task on all the items of a range and wait for the end of the work
+         *  @param pCount is the number of items
+         *  @param pTask is called with sub-ranges [begin, end) of [0, pCount), possibly from several threads at
+         *         the same time. It can call parallelFor again.
+         */
+        void parallelFor(unsigned int pCount, const std::function<void(unsigned int pBegin, unsigned int pEnd)> & pTask);
+
+    private:
+        //! A job and the counter to decrement when it ends
+        struct Job
+        {
+            std::function<void(void)> task;                                     //!< Work of a scheduled job
+            const std::function<void(unsigned int, unsigned int)>* range;       //!< Or work of a chunk of parallelFor, called on [begin, end)
+            unsigned int begin;
+            unsigned int end;
+            Counter* counter;
+        };
+
+        //! Job of the pool of a thread
+        struct Slot
+        {
+            Job job;
+            std::atomic<bool> busy;         //!< The job is queued or running, the slot cannot be reused
+        };
+
+        //! Lock-free deque of jobs of one thread, the owner works at the bottom and the thieves at the top
+        struct Queue
+        {
+            /*!
+             *  \brief Constructor, empty deque
+             */
+            Queue(void);
+
+            /*!
+             *  \brief Copy a job in the next slot of the pool and add it at the bottom, called by the owner only
+             *  @param pJob is the job, it is moved only if the method succeeds
+             *  @return false if the deque is full or the next slot still runs a job
+             */
+            bool push(Job & pJob);
+
+            /*!
+             *  \brief Remove the most recent job, called by the owner only
+             *  @return the slot of the job, or nullptr if the deque is empty
+             */
+            Slot* pop(void);
+
+            /*!
+             *  \brief Remove the oldest job, called by any thread
+             *  @return the slot of the job, or nullptr if the deque is empty or another thread took the job first
+             */
+            Slot* steal(void);
+
+            std::atomic<long long> top;                             //!< Next job to steal
+            std::atomic<long long> bottom;                          //!< Next free position of the owner
+            std::atomic<Slot*> ring[JOB_SYSTEM_QUEUE_SIZE];
+            Slot slots[JOB_SYSTEM_QUEUE_SIZE];
+            unsigned int nextSlot;                                  //!< Next slot of the pool, used by the owner only
+        };
+
+        //! Jobs of the main thread lane, rarely used so a lock is enough
+        struct MainThreadQueue
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        /*!
+         *  \brief Loop executed by each worker thread
+         *  @param pIndex is the index of the queue of the worker
+         */
+        void _work(unsigned int pIndex);
+
+        /*!
+         *  \brief Helper method to run one job: from the queue of the thread, then from the main thread lane if
+         *         called on the main thread, then stolen from the other threads
+         *  @param pIndex is the index of the queue of the calling thread, or JOB_SYSTEM_NO_QUEUE
+         *  @return true if a job was run
+         */
+        bool _runOne(unsigned int pIndex);
+
+        /*!
+         *  \brief Helper method to add a job to the queue of the calling thread and wake up a worker, or to run it if
+         *         the queue is full or the thread is not owned by the system
+         *  @param pJob is the job to add
+         */
+        void _push(Job && pJob);
+
+        /*!
+         *  \brief Helper method to run a job and release the jobs depending on its counter
+         *  @param pJob is the job to run
+         */
+        void _run(Job & pJob);
+
+        /*!
+         *  \brief Helper method to find the queue of the calling thread
+         *  @return the index of the worker + 1, 0 for the main thread or JOB_SYSTEM_NO_QUEUE for the threads not
+         *          owned by the system
+         */
+        unsigned int _threadIndex(void) const noexcept;
+
+    private:
+        std::vector<std::thread> mWorkers;
+        std::vector<std::unique_ptr<Queue>> mQueues;    //!< One per thread, the main thread first
+        MainThreadQueue mMainThreadQueue;
+        std::thread::id mMainThread;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWakeCondition;
+        std::atomic<unsigned int> mQueuedJobs;           //!< Jobs in mQueues, the workers sleep when there is none
+        std::atomic<unsigned int> mSleepingWorkers;      //!< Workers waiting for mWakeCondition, the others need no notification
+        bool mStop = false;
+
+    }; // class JobSystem
+
+} // namespace miniGL
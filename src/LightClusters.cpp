@@ -0,0 +1,325 @@
+//===============================================================================================//
+/*!
+ *  \file      LightClusters.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "LightClusters.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "PointLight.hpp"
+#include "SpotLight.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MINIGL_LIGHT_CLUSTERS_SSE2
+#endif
+
+using std::vector;
+using std::shared_ptr;
+using miniGL::LightClusters;
+using miniGL::BaseLight;
+using miniGL::PointLight;
+using miniGL::SpotLight;
+using miniGL::JobSystem;
+
+static_assert(sizeof(LightClusters::LightData) == 16 * sizeof(float), "A light is uploaded as 4 RGBA32F texels");
+
+LightClusters::LightClusters(void)
+{
+    mSliceDepths.fill(0.0f);
+
+    for (Slice & rSlice : mSlices)
+        rSlice.counts.fill(0);
+
+    // Without lights, every cluster is empty
+    mItems.assign(2 * LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z, 0);
+}
+
+void LightClusters::build(const mat4f & pView, const mat4f & pProjection, float pNearPlane, float pFarPlane, const vector<shared_ptr<BaseLight>> & pLights, const vector<unsigned int> & pIndices, JobSystem* pJobSystem)
+{
+    assert(pNearPlane > 0.0f && pFarPlane > pNearPlane && "The slices need a perspective projection with a positive near plane");
+
+    mProjectionX = pProjection(0,0);
+    mProjectionY = pProjection(1,1);
+
+    // The slice of a view depth d is log(d / near) * Z / log(far / near)
+    const float lRatio = pFarPlane / pNearPlane;
+    mDepthScale = static_cast<float>(LIGHT_CLUSTERS_Z) / logf(lRatio);
+    mDepthBias = -logf(pNearPlane) * mDepthScale;
+
+    for (unsigned int i = 0; i <= LIGHT_CLUSTERS_Z; ++i)
+        mSliceDepths[i] = pNearPlane * powf(lRatio, static_cast<float>(i) / static_cast<float>(LIGHT_CLUSTERS_Z));
+
+    mLights.clear();
+    mSpheres.x.clear();
+    mSpheres.y.clear();
+    mSpheres.z.clear();
+    mSpheres.radius.clear();
+    mSpheres.lights.clear();
+
+    for (unsigned int lIndex : pIndices)
+    {
+        assert(lIndex < pLights.size() && "Light index out of boundaries");
+        const BaseLight & rLight = *pLights[lIndex];
+
+        // The directional light is in the LightBlock uniform block
+        if (rLight.type() != BaseLight::EType::POINT && rLight.type() != BaseLight::EType::SPOT)
+            continue;
+
+        const PointLight & rPointLight = static_cast<const PointLight &>(rLight);
+        const vec3f & rPosition = rPointLight.position();
+
+        LightData lData = {};
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            lData.color[i] = rPointLight.color()[i];
+            lData.position[i] = rPosition[i];
+        }
+
+        lData.ambientIntensity = rPointLight.ambientIntensity();
+        lData.diffuseIntensity = rPointLight.diffuseIntensity();
+        lData.constant = rPointLight.attenuation(PointLight::ATTENUATION_TYPE::CONSTANT);
+        lData.linear = rPointLight.attenuation(PointLight::ATTENUATION_TYPE::LINEAR);
+        lData.exponential = rPointLight.attenuation(PointLight::ATTENUATION_TYPE::EXPONENTIAL);
+        lData.cutoff = -2.0f;
+
+        if (rLight.type() == BaseLight::EType::SPOT)
+        {
+            const SpotLight & rSpotLight = static_cast<const SpotLight &>(rLight);
+
+            vec3f lDirection = rSpotLight.direction();
+            lDirection.normalize();
+
+            for (unsigned int i = 0; i < 3; ++i)
+                lData.direction[i] = lDirection[i];
+
+            lData.cutoff = cosf(rSpotLight.cutoff().toRadian());
+        }
+
+        mLights.push_back(lData);
+
+        // The lights that are too dim are uploaded but not listed in any cluster
+        const float lRadius = range(rPointLight);
+
+        if (lRadius > 0.0f)
+        {
+            // Center of the sphere of influence in view space
+            mSpheres.x.push_back(pView(0,0) * rPosition.x() + pView(0,1) * rPosition.y() + pView(0,2) * rPosition.z() + pView(0,3));
+            mSpheres.y.push_back(pView(1,0) * rPosition.x() + pView(1,1) * rPosition.y() + pView(1,2) * rPosition.z() + pView(1,3));
+            mSpheres.z.push_back(pView(2,0) * rPosition.x() + pView(2,1) * rPosition.y() + pView(2,2) * rPosition.z() + pView(2,3));
+            mSpheres.radius.push_back(lRadius);
+            mSpheres.lights.push_back(static_cast<unsigned int>(mLights.size() - 1));
+        }
+    }
+
+    // The slices only read the spheres and write in their own containers
+    if (pJobSystem != nullptr && !mSpheres.lights.empty())
+    {
+        pJobSystem->parallelFor(LIGHT_CLUSTERS_Z, [this](unsigned int pBegin, unsigned int pEnd)
+        {
+            for (unsigned int i = pBegin; i < pEnd; ++i)
+                _assign(i);
+        });
+    }
+    else
+    {
+        for (unsigned int i = 0; i < LIGHT_CLUSTERS_Z; ++i)
+            _assign(i);
+    }
+
+    // The lists of the clusters follow each other in the order of the clusters
+    const unsigned int lTileCount = LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y;
+    unsigned int lFirst = 2 * lTileCount * LIGHT_CLUSTERS_Z;
+
+    mItems.resize(lFirst);
+
+    for (unsigned int i = 0; i < LIGHT_CLUSTERS_Z; ++i)
+    {
+        for (unsigned int j = 0; j < lTileCount; ++j)
+        {
+            const unsigned int lCluster = i * lTileCount + j;
+
+            mItems[2 * lCluster] = lFirst;
+            mItems[2 * lCluster + 1] = mSlices[i].counts[j];
+            lFirst += mSlices[i].counts[j];
+        }
+    }
+
+    for (const Slice & rSlice : mSlices)
+        mItems.insert(mItems.end(), rSlice.indices.cbegin(), rSlice.indices.cend());
+}
+
+const vector<LightClusters::LightData> & LightClusters::lights(void) const noexcept
+{
+    return mLights;
+}
+
+const vector<unsigned int> & LightClusters::items(void) const noexcept
+{
+    return mItems;
+}
+
+float LightClusters::depthScale(void) const noexcept
+{
+    return mDepthScale;
+}
+
+float LightClusters::depthBias(void) const noexcept
+{
+    return mDepthBias;
+}
+
+unsigned int LightClusters::cluster(float pX, float pY, float pDepth) const noexcept
+{
+    const int lTileX = std::min(std::max(static_cast<int>((0.5f * pX + 0.5f) * LIGHT_CLUSTERS_X), 0), LIGHT_CLUSTERS_X - 1);
+    const int lTileY = std::min(std::max(static_cast<int>((0.5f * pY + 0.5f) * LIGHT_CLUSTERS_Y), 0), LIGHT_CLUSTERS_Y - 1);
+    const int lSlice = std::min(std::max(static_cast<int>(logf(std::max(pDepth, 1.0e-4f)) * mDepthScale + mDepthBias), 0), LIGHT_CLUSTERS_Z - 1);
+
+    return static_cast<unsigned int>((lSlice * LIGHT_CLUSTERS_Y + lTileY) * LIGHT_CLUSTERS_X + lTileX);
+}
+
+float LightClusters::range(const PointLight & pLight)
+{
+    const vec3f & rColor = pLight.color();
+    const float lIntensity = std::max(std::max(rColor.x(), rColor.y()), rColor.z()) * (pLight.ambientIntensity() + pLight.diffuseIntensity());
+
+    // The shaders divide the color by constant + linear * d + exponential * d^2
+    const float lAttenuation = lIntensity / LIGHT_CLUSTERS_THRESHOLD;
+    const float lConstant = pLight.attenuation(PointLight::ATTENUATION_TYPE::CONSTANT);
+    const float lLinear = pLight.attenuation(PointLight::ATTENUATION_TYPE::LINEAR);
+    const float lExponential = pLight.attenuation(PointLight::ATTENUATION_TYPE::EXPONENTIAL);
+
+    if (lAttenuation <= lConstant)
+        return 0.0f;
+
+    if (lExponential > 0.0f)
+        return (-lLinear + sqrtf(lLinear * lLinear + 4.0f * lExponential * (lAttenuation - lConstant))) / (2.0f * lExponential);
+
+    if (lLinear > 0.0f)
+        return (lAttenuation - lConstant) / lLinear;
+
+    return std::numeric_limits<float>::max();
+}
+
+void LightClusters::_assign(unsigned int pSlice)
+{
+    Slice & rSlice = mSlices[pSlice];
+
+    const float lNearDepth = mSliceDepths[pSlice];
+    const float lFarDepth = mSliceDepths[pSlice + 1];
+
+    // A view position (x, y, d) projects at x * P(0,0) / d, so the frustum of the slice is widest at its far depth
+    const float lHalfWidth = lFarDepth / mProjectionX;
+    const float lHalfHeight = lFarDepth / mProjectionY;
+
+    _intersect(mSpheres, vec3f(-lHalfWidth, -lHalfHeight, lNearDepth), vec3f(lHalfWidth, lHalfHeight, lFarDepth), rSlice.positions);
+    _gather(mSpheres, rSlice.positions, rSlice.spheres);
+
+    rSlice.indices.clear();
+
+    for (unsigned int lTileY = 0; lTileY < LIGHT_CLUSTERS_Y; ++lTileY)
+    {
+        // The boxes contain the tiles at both ends of the slice
+        const float lBottom = -1.0f + 2.0f * static_cast<float>(lTileY) / LIGHT_CLUSTERS_Y;
+        const float lTop = lBottom + 2.0f / LIGHT_CLUSTERS_Y;
+        const float lMinY = std::min(lBottom * lNearDepth, lBottom * lFarDepth) / mProjectionY;
+        const float lMaxY = std::max(lTop * lNearDepth, lTop * lFarDepth) / mProjectionY;
+
+        _intersect(rSlice.spheres, vec3f(-lHalfWidth, lMinY, lNearDepth), vec3f(lHalfWidth, lMaxY, lFarDepth), rSlice.positions);
+        _gather(rSlice.spheres, rSlice.positions, rSlice.row);
+
+        for (unsigned int lTileX = 0; lTileX < LIGHT_CLUSTERS_X; ++lTileX)
+        {
+            const float lLeft = -1.0f + 2.0f * static_cast<float>(lTileX) / LIGHT_CLUSTERS_X;
+            const float lRight = lLeft + 2.0f / LIGHT_CLUSTERS_X;
+            const float lMinX = std::min(lLeft * lNearDepth, lLeft * lFarDepth) / mProjectionX;
+            const float lMaxX = std::max(lRight * lNearDepth, lRight * lFarDepth) / mProjectionX;
+
+            _intersect(rSlice.row, vec3f(lMinX, lMinY, lNearDepth), vec3f(lMaxX, lMaxY, lFarDepth), rSlice.positions);
+
+            for (unsigned int lPosition : rSlice.positions)
+                rSlice.indices.push_back(rSlice.row.lights[lPosition]);
+
+            rSlice.counts[lTileY * LIGHT_CLUSTERS_X + lTileX] = static_cast<unsigned int>(rSlice.positions.size());
+        }
+    }
+}
+
+void LightClusters::_intersect(const Spheres & pSpheres, const vec3f & pMin, const vec3f & pMax, vector<unsigned int> & pPositions)
+{
+    pPositions.clear();
+
+    const unsigned int lCount = static_cast<unsigned int>(pSpheres.lights.size());
+    unsigned int i = 0;
+
+#if defined(MINIGL_LIGHT_CLUSTERS_SSE2)
+    // 4 spheres per iteration, a sphere touches the box if the point of the box closest to its center is inside
+    const __m128 lZero = _mm_setzero_ps();
+    const __m128 lMinX = _mm_set1_ps(pMin.x());
+    const __m128 lMaxX = _mm_set1_ps(pMax.x());
+    const __m128 lMinY = _mm_set1_ps(pMin.y());
+    const __m128 lMaxY = _mm_set1_ps(pMax.y());
+    const __m128 lMinZ = _mm_set1_ps(pMin.z());
+    const __m128 lMaxZ = _mm_set1_ps(pMax.z());
+
+    for (; i + 4 <= lCount; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(pSpheres.x.data() + i);
+        const __m128 y = _mm_loadu_ps(pSpheres.y.data() + i);
+        const __m128 z = _mm_loadu_ps(pSpheres.z.data() + i);
+        const __m128 lRadius = _mm_loadu_ps(pSpheres.radius.data() + i);
+
+        const __m128 lDX = _mm_max_ps(_mm_max_ps(_mm_sub_ps(lMinX, x), _mm_sub_ps(x, lMaxX)), lZero);
+        const __m128 lDY = _mm_max_ps(_mm_max_ps(_mm_sub_ps(lMinY, y), _mm_sub_ps(y, lMaxY)), lZero);
+        const __m128 lDZ = _mm_max_ps(_mm_max_ps(_mm_sub_ps(lMinZ, z), _mm_sub_ps(z, lMaxZ)), lZero);
+
+        __m128 lDistance = _mm_mul_ps(lDX, lDX);
+        lDistance = _mm_add_ps(lDistance, _mm_mul_ps(lDY, lDY));
+        lDistance = _mm_add_ps(lDistance, _mm_mul_ps(lDZ, lDZ));
+
+        const int lMask = _mm_movemask_ps(_mm_cmple_ps(lDistance, _mm_mul_ps(lRadius, lRadius)));
+
+        for (unsigned int k = 0; k < 4; ++k)
+        {
+            if ((lMask & (1 << k)) != 0)
+                pPositions.push_back(i + k);
+        }
+    }
+#endif
+
+    for (; i < lCount; ++i)
+    {
+        const float lDX = std::max(std::max(pMin.x() - pSpheres.x[i], pSpheres.x[i] - pMax.x()), 0.0f);
+        const float lDY = std::max(std::max(pMin.y() - pSpheres.y[i], pSpheres.y[i] - pMax.y()), 0.0f);
+        const float lDZ = std::max(std::max(pMin.z() - pSpheres.z[i], pSpheres.z[i] - pMax.z()), 0.0f);
+
+        if (lDX * lDX + lDY * lDY + lDZ * lDZ <= pSpheres.radius[i] * pSpheres.radius[i])
+            pPositions.push_back(i);
+    }
+}
+
+void LightClusters::_gather(const Spheres & pSource, const vector<unsigned int> & pPositions, Spheres & pDestination)
+{
+    pDestination.x.clear();
+    pDestination.y.clear();
+    pDestination.z.clear();
+    pDestination.radius.clear();
+    pDestination.lights.clear();
+
+    for (unsigned int lPosition : pPositions)
+    {
+        pDestination.x.push_back(pSource.x[lPosition]);
+        pDestination.y.push_back(pSource.y[lPosition]);
+        pDestination.z.push_back(pSource.z[lPosition]);
+        pDestination.radius.push_back(pSource.radius[lPosition]);
+        pDestination.lights.push_back(pSource.lights[lPosition]);
+    }
+}
@@ -0,0 +1,179 @@
+//===============================================================================================//
+/*!
+ *  \file      LightClusters.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Algebra.hpp"
+#include "BaseLight.hpp"
+#include "JobSystem.hpp"
+
+// Size of the grid of clusters, the tiles split the viewport and the slices split the depth exponentially
+#define LIGHT_CLUSTERS_X 16
+#define LIGHT_CLUSTERS_Y 9
+#define LIGHT_CLUSTERS_Z 24
+
+// Contribution of a light under which a fragment is out of its reach
+#define LIGHT_CLUSTERS_THRESHOLD (1.0f / 256.0f)
+
+namespace miniGL
+{
+    class PointLight;
+
+    /*!
+     *  \brief   This class assigns the point and spot lights to the clusters of the view frustum, for clustered forward shading
+     *  \details The frustum is split in LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y tiles on the screen and LIGHT_CLUSTERS_Z slices
+     *           in depth, each cluster lists the lights whose sphere of influence touches its bounding box, so the
+     *           fragments only shade the lights that can reach them. The slices are built in parallel with a JobSystem:
+     *           each slice keeps the lights touching its box, then each row of tiles the lights of the slice touching
+     *           the row, and each tile the lights of its row. The boxes are tested against 4 lights per iteration with
+     *           SSE2 instructions (scalar code otherwise). The spot lights are bounded by the sphere of their point
+     *           light. The containers keep their capacity, building the clusters of a scene that does not grow does not
+     *           allocate. The class does not call OpenGL.
+     */
+    class LightClusters
+    {
+    public:
+        //! A point or spot light, stored in 4 RGBA32F texels read by the shaders
+        struct LightData
+        {
+            float color[3];
+            float ambientIntensity;
+            float position[3];
+            float diffuseIntensity;
+            float constant;
+            float linear;
+            float exponential;
+            float cutoff;               //!< Cosine of the cutoff angle, -2 for a point light
+            float direction[3];         //!< Normalized, null for a point light
+            float padding;
+        };
+
+    public:
+        /*!
+         *  \brief Constructor, no light
+         */
+        LightClusters(void);
+
+        /*!
+         *  \brief Assign the point and spot lights of a selection to the clusters of a camera
+         *  @param pView is the view matrix of the camera, the view depth is along +z
+         *  @param pProjection is the perspective projection matrix of the camera
+         *  @param pNearPlane is the distance of the near plane
+         *  @param pFarPlane is the distance of the far plane
+         *  @param pLights contains all the lights of the scene
+         *  @param pIndices are the indices in pLights of the lights to use, the directional lights are skipped
+         *  @param pJobSystem builds the slices in parallel, or nullptr to use the calling thread
+         */
+        void build(const mat4f & pView, const mat4f & pProjection, float pNearPlane, float pFarPlane, const std::vector<std::shared_ptr<BaseLight>> & pLights, const std::vector<unsigned int> & pIndices, JobSystem* pJobSystem = nullptr);
+
+        /*!
+         *  \brief Get the lights of the last build, in the order of the selection
+         *  @return a const reference on the lights
+         */
+        const std::vector<LightData> & lights(void) const noexcept;
+
+        /*!
+         *  \brief   Get the items read by the shaders
+         *  \details The first 2 items of each cluster are the index of its first light index in the items and its number
+         *           of lights, the lists of light indices follow the clusters
+         *  @return a const reference on the items
+         */
+        const std::vector<unsigned int> & items(void) const noexcept;
+
+        /*!
+         *  \brief Get the factor of the logarithm of the view depth giving the slice
+         *  @return the scale of the slices
+         */
+        float depthScale(void) const noexcept;
+
+        /*!
+         *  \brief Get the offset giving the slice of a view depth, with depthScale
+         *  @return the bias of the slices
+         */
+        float depthBias(void) const noexcept;
+
+        /*!
+         *  \brief Get the cluster of a point, as computed by the shaders
+         *  @param pX is the x coordinate of the point in normalized device coordinates
+         *  @param pY is the y coordinate of the point in normalized device coordinates
+         *  @param pDepth is the view depth of the point
+         *  @return the index of the cluster
+         */
+        unsigned int cluster(float pX, float pY, float pDepth) const noexcept;
+
+        /*!
+         *  \brief Get the distance from which the contribution of a light is below LIGHT_CLUSTERS_THRESHOLD
+         *  @param pLight is a point or spot light
+         *  @return 0 if the light is too dim, the largest float if it is not attenuated
+         */
+        static float range(const PointLight & pLight);
+
+    private:
+        //! View space bounding spheres of lights
+        struct Spheres
+        {
+            std::vector<float> x;
+            std::vector<float> y;
+            std::vector<float> z;
+            std::vector<float> radius;
+            std::vector<unsigned int> lights;       //!< Index of each sphere in mLights
+        };
+
+        //! Lights touching a slice and lights of its clusters, reused from one build to the next
+        struct Slice
+        {
+            Spheres spheres;
+            Spheres row;
+            std::vector<unsigned int> positions;
+            std::vector<unsigned int> indices;
+            std::array<unsigned int, LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y> counts;
+        };
+
+        /*!
+         *  \brief Helper method to assign the lights to the clusters of a slice
+         *  @param pSlice is the index of the slice
+         */
+        void _assign(unsigned int pSlice);
+
+        /*!
+         *  \brief Helper method to find the spheres touching a box
+         *  @param pSpheres are the spheres to test
+         *  @param pMin is the corner of the box with the smallest coordinates
+         *  @param pMax is the corner of the box with the largest coordinates
+         *  @param pPositions receives the positions in pSpheres of the spheres touching the box, in increasing order
+         */
+        static void _intersect(const Spheres & pSpheres, const vec3f & pMin, const vec3f & pMax, std::vector<unsigned int> & pPositions);
+
+        /*!
+         *  \brief Helper method to copy some of the spheres
+         *  @param pSource contains the spheres
+         *  @param pPositions are the positions in pSource of the spheres to copy
+         *  @param pDestination receives the spheres, its previous content is removed
+         */
+        static void _gather(const Spheres & pSource, const std::vector<unsigned int> & pPositions, Spheres & pDestination);
+
+    private:
+        std::vector<LightData> mLights;
+        std::vector<unsigned int> mItems;
+
+        Spheres mSpheres;       //!< Lights reaching further than LIGHT_CLUSTERS_THRESHOLD
+
+        std::array<Slice, LIGHT_CLUSTERS_Z> mSlices;
+        std::array<float, LIGHT_CLUSTERS_Z + 1> mSliceDepths;
+        float mProjectionX = 1.0f;     //!< Element (0,0) of the projection matrix
+        float mProjectionY = 1.0f;     //!< Element (1,1) of the projection matrix
+        float mDepthScale = 0.0f;
+        float mDepthBias = 0.0f;
+
+    }; // class LightClusters
+
+} // namespace miniGL
@@ -0,0 +1,71 @@
+//===============================================================================================//
+/*!
+ *  \file      LightUniformBuffer.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "LightUniformBuffer.hpp"
+
+#include "EngineCommon.hpp"
+#include "GLUtils.hpp"
+
+using std::vector;
+using std::shared_ptr;
+using miniGL::LightUniformBuffer;
+using miniGL::PackedLights;
+using miniGL::BaseLight;
+
+GLuint LightUniformBuffer::mBuffer = 0;
+PackedLights LightUniformBuffer::mPackedLights;
+
+bool LightUniformBuffer::attach(GLuint pProgram)
+{
+    const GLuint lBlockIndex = glGetUniformBlockIndex(pProgram, "LightBlock");
+
+    if (lBlockIndex == GL_INVALID_INDEX)
+        return false;
+
+    // GLSL 3.30 cannot set the binding point in the shader
+    glUniformBlockBinding(pProgram, lBlockIndex, LIGHTS_UNIFORM_BLOCK_BINDING); checkOpenGLState;
+
+    return true;
+}
+
+void LightUniformBuffer::update(const vector<shared_ptr<BaseLight>> & pLights, const vector<unsigned int> & pIndices, unsigned int pMaxPointLights, unsigned int pMaxSpotLights)
+{
+    if (mBuffer == 0)
+    {
+        glGenBuffers(1, & mBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(PackedLights::Block), nullptr, GL_DYNAMIC_DRAW);
+
+        // The binding point is only used by this buffer, it is bound once
+        glBindBufferBase(GL_UNIFORM_BUFFER, LIGHTS_UNIFORM_BLOCK_BINDING, mBuffer); checkOpenGLState;
+    }
+
+    mPackedLights.pack(pLights, pIndices, pMaxPointLights, pMaxSpotLights);
+
+    if (mPackedLights.dirtySize() == 0)
+        return;
+
+    const unsigned char* lData = reinterpret_cast<const unsigned char*>(& mPackedLights.block());
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, mPackedLights.dirtyOffset(), mPackedLights.dirtySize(), lData + mPackedLights.dirtyOffset()); checkOpenGLState;
+
+    mPackedLights.clean();
+}
+
+void LightUniformBuffer::clear(void)
+{
+    if (mBuffer == 0)
+        return;
+
+    glDeleteBuffers(1, & mBuffer);
+    mBuffer = 0;
+
+    // Everything is uploaded again in the next buffer
+    mPackedLights = PackedLights();
+}
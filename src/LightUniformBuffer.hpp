@@ -0,0 +1,58 @@
+//===============================================================================================//
+/*!
+ *  \file      LightUniformBuffer.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "BaseLight.hpp"
+#include "PackedLights.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class is the uniform buffer object with the lights read by all the lighting programs
+     *  \details The LightBlock uniform block of the programs is attached to the LIGHTS_UNIFORM_BLOCK_BINDING binding point,
+     *           where the buffer stays bound. Updating the lights only uploads the bytes that changed since the previous
+     *           update, so the lights that did not change do not cost any OpenGL call. Like GLStateCache, the methods
+     *           are static since there is a single OpenGL context.
+     */
+    class LightUniformBuffer
+    {
+    public:
+        /*!
+         *  \brief Attach the LightBlock uniform block of a program to the binding point of the buffer
+         *  @param pProgram is a linked program
+         *  @return false if the program does not have a LightBlock uniform block
+         */
+        static bool attach(GLuint pProgram);
+
+        /*!
+         *  \brief Update the lights read by the next draw calls, the buffer is created on the first call
+         *  @param pLights contains all the lights of the scene
+         *  @param pIndices are the indices in pLights of the lights to use, in order
+         *  @param pMaxPointLights is the number of point lights that the program uses at most
+         *  @param pMaxSpotLights is the number of spot lights that the program uses at most
+         */
+        static void update(const std::vector<std::shared_ptr<BaseLight>> & pLights, const std::vector<unsigned int> & pIndices, unsigned int pMaxPointLights, unsigned int pMaxSpotLights);
+
+        /*!
+         *  \brief Delete the buffer, e.g. before destroying the OpenGL context
+         */
+        static void clear(void);
+
+    private:
+        static GLuint mBuffer;
+        static PackedLights mPackedLights;
+
+    }; // class LightUniformBuffer
+
+} // namespace miniGL
@@ -102,11 +102,9 @@ void Lighting::init(unsigned int pPointLightCount, unsigned int pSpotLightCount,
     initUniformLocation(Lighting::GENERAL_LIGHTING_PARAM::SHADOW_MAP, "uShadowMap");
     initUniformLocation(Lighting::GENERAL_LIGHTING_PARAM::SHADOW_MAP_SIZE, "uShadowMapSize");
     initUniformLocation(Lighting::GENERAL_LIGHTING_PARAM::NORMAL_MAP, "uNormalMap");
-    initUniformLocation(Lighting::GENERAL_LIGHTING_PARAM::EYE_WORLD_POS, "uEyeWorldPos");
     initUniformLocation(Lighting::GENERAL_LIGHTING_PARAM::MATERIAL_SPECULAR_INTENSITY, "uMaterialSpecularIntensity");
     initUniformLocation(Lighting::GENERAL_LIGHTING_PARAM::MATERIAL_SPECULAR_POWER, "uMaterialSpecularPower");
 
-    initUniformLocation(Lighting::NORMAL_LIGHTING_PARAM::WVP, "uWVP");
     initUniformLocation(Lighting::NORMAL_LIGHTING_PARAM::WORLD_MATRIX, "uWorld");
 
     // Use of sampler (color texture)
@@ -130,11 +128,6 @@ void Lighting::init(unsigned int pPointLightCount, unsigned int pSpotLightCount,
     useSampler(true);
 }
 
-void Lighting::WVP(const mat4f & pWVP)
-{
-    glUniformMatrix4fv(mNormalLightingParameterLocations[toUT(NORMAL_LIGHTING_PARAM::WVP)], 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
-}
-
 void Lighting::worldMatrix(const mat4f & pWorld)
 {
     glUniformMatrix4fv(mNormalLightingParameterLocations[toUT(NORMAL_LIGHTING_PARAM::WORLD_MATRIX)], 1, GL_TRUE, const_cast<mat4f&>(pWorld).data());
@@ -145,11 +138,6 @@ void Lighting::lightWVP(const mat4f & pWVP)
     glUniformMatrix4fv(mGeneralParameterLocations[toUT(GENERAL_LIGHTING_PARAM::LIGHT_WVP)], 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
 }
 
-void Lighting::eyeWorldPosition(const vec3f & pEyeWorldPos)
-{
-    glUniform3f(mGeneralParameterLocations[toUT(GENERAL_LIGHTING_PARAM::EYE_WORLD_POS)], pEyeWorldPos.x(), pEyeWorldPos.y(), pEyeWorldPos.z());
-}
-
 void Lighting::textureUnit(GENERAL_LIGHTING_PARAM pParam, unsigned int pTexUnit)
 {
     switch (pParam)
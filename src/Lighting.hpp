@@ -39,13 +39,11 @@ namespace miniGL
             USE_SHADOW_MAP,
             NORMAL_MAP,
             USE_NORMAL_MAP,
-            EYE_WORLD_POS,
             MATERIAL_SPECULAR_INTENSITY,
             MATERIAL_SPECULAR_POWER
         };
         enum class NORMAL_LIGHTING_PARAM : size_t
         {
-            WVP,
             WORLD_MATRIX,
         };
 
@@ -70,13 +68,7 @@ namespace miniGL
         void init(unsigned int pPointLightCount, unsigned int pSpotLightCount, const std::string & pPathVS = std::string(R"(./Shaders/Lighting.vert)"), const std::string & pPathFS = std::string(R"(./Shaders/Lighting.frag)"));
 
         /*!
-         *  \brief Set the world view projection matrix
-         *  @param pWVP is a 4x4 matrix
-         */
-        void WVP(const mat4f & pWVP);
-
-        /*!
-         *  \brief Set the world matrix
+         *  \brief Set the world matrix, the view projection matrix and the camera position are read from the CameraBlock uniform block
          *  @param pWorld is a 4x4 matrix
          */
         void worldMatrix(const mat4f & pWorld);
@@ -87,12 +79,6 @@ namespace miniGL
          */
         void lightWVP(const mat4f & pLightWVP);
 
-        /*!
-         *  \brief Set the position of the camera to calculate the specular component
-         *  @param pPos is the position of the camera
-         */
-        void eyeWorldPosition(const vec3f & pPos);
-
         /*!
          *  \brief Set the texture unit
          *  @param pParam is a general parameter corresponding to a texture
@@ -159,10 +145,10 @@ namespace miniGL
         void initUniformLocation(NORMAL_LIGHTING_PARAM pParameter, const char* pName);
 
     private:
-        using generalParamLoc = std::array<GLuint, 11>; // container for the general light parameter locations
+        using generalParamLoc = std::array<GLuint, 10>; // container for the general light parameter locations
 
         generalParamLoc mGeneralParameterLocations;
-        std::array<GLuint, 2> mNormalLightingParameterLocations;
+        std::array<GLuint, 1> mNormalLightingParameterLocations;
 
     }; // class Lighting
 
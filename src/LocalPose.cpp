@@ -0,0 +1,158 @@
+//===============================================================================================//
+/*!
+ *  \file      LocalPose.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "LocalPose.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "AnimationClip.hpp"
+#include "EnumClassCast.hpp"
+
+using miniGL::LocalPose;
+using miniGL::AnimationClip;
+using miniGL::toUT;
+
+void LocalPose::resize(unsigned int pNodeCount)
+{
+    const unsigned int lKept = std::min(mNodeCount, pNodeCount);
+    std::vector<float> lComponents(toUT(EComponent::COUNT) * pNodeCount, 0.0f);
+
+    // Each component is a block of nodeCount() values, so the blocks move when the number of nodes changes
+    for (unsigned int i = 0; i < toUT(EComponent::COUNT); ++i)
+    {
+        float* rBlock = lComponents.data() + i * pNodeCount;
+
+        std::copy_n(mComponents.data() + i * mNodeCount, lKept, rBlock);
+
+        if (i == toUT(EComponent::ROTATION_W) || i >= toUT(EComponent::SCALING_X))
+            std::fill(rBlock + lKept, rBlock + pNodeCount, 1.0f);
+    }
+
+    mComponents.swap(lComponents);
+    mNodeCount = pNodeCount;
+}
+
+unsigned int LocalPose::nodeCount(void) const noexcept
+{
+    return mNodeCount;
+}
+
+float* LocalPose::component(EComponent pComponent) noexcept
+{
+    return mComponents.data() + toUT(pComponent) * mNodeCount;
+}
+
+const float* LocalPose::component(EComponent pComponent) const noexcept
+{
+    return mComponents.data() + toUT(pComponent) * mNodeCount;
+}
+
+void LocalPose::transform(unsigned int pNode, const vec3f & pTranslation, const quatf & pRotation, const vec3f & pScaling)
+{
+    assert(pNode < mNodeCount && "Node index out of boundaries");
+
+    float* lData = mComponents.data() + pNode;
+
+    lData[toUT(EComponent::TRANSLATION_X) * mNodeCount] = pTranslation.x();
+    lData[toUT(EComponent::TRANSLATION_Y) * mNodeCount] = pTranslation.y();
+    lData[toUT(EComponent::TRANSLATION_Z) * mNodeCount] = pTranslation.z();
+    lData[toUT(EComponent::ROTATION_X) * mNodeCount] = pRotation.x();
+    lData[toUT(EComponent::ROTATION_Y) * mNodeCount] = pRotation.y();
+    lData[toUT(EComponent::ROTATION_Z) * mNodeCount] = pRotation.z();
+    lData[toUT(EComponent::ROTATION_W) * mNodeCount] = pRotation.w();
+    lData[toUT(EComponent::SCALING_X) * mNodeCount] = pScaling.x();
+    lData[toUT(EComponent::SCALING_Y) * mNodeCount] = pScaling.y();
+    lData[toUT(EComponent::SCALING_Z) * mNodeCount] = pScaling.z();
+}
+
+void LocalPose::transform(unsigned int pNode, const mat4f & pTransform)
+{
+    const vec3f lTranslation(pTransform(0,3), pTransform(1,3), pTransform(2,3));
+
+    // The columns of the upper 3x3 part are the axes of the node multiplied by the scaling
+    float lScaling[3];
+
+    for (unsigned int i = 0; i < 3; ++i)
+        lScaling[i] = std::sqrt(pTransform(0,i) * pTransform(0,i) + pTransform(1,i) * pTransform(1,i) + pTransform(2,i) * pTransform(2,i));
+
+    float r[3][3];
+
+    for (unsigned int row = 0; row < 3; ++row)
+    {
+        for (unsigned int col = 0; col < 3; ++col)
+            r[row][col] = lScaling[col] > 0.0f ? pTransform(row,col) / lScaling[col] : 0.0f;
+    }
+
+    // Convert the rotation matrix to a quaternion, starting from its largest component for accuracy
+    float x, y, z, w;
+    const float lTrace = r[0][0] + r[1][1] + r[2][2];
+
+    if (lTrace > 0.0f)
+    {
+        const float s = 2.0f * std::sqrt(lTrace + 1.0f);
+        w = 0.25f * s;
+        x = (r[2][1] - r[1][2]) / s;
+        y = (r[0][2] - r[2][0]) / s;
+        z = (r[1][0] - r[0][1]) / s;
+    }
+    else if (r[0][0] > r[1][1] && r[0][0] > r[2][2])
+    {
+        const float s = 2.0f * std::sqrt(1.0f + r[0][0] - r[1][1] - r[2][2]);
+        w = (r[2][1] - r[1][2]) / s;
+        x = 0.25f * s;
+        y = (r[0][1] + r[1][0]) / s;
+        z = (r[0][2] + r[2][0]) / s;
+    }
+    else if (r[1][1] > r[2][2])
+    {
+        const float s = 2.0f * std::sqrt(1.0f + r[1][1] - r[0][0] - r[2][2]);
+        w = (r[0][2] - r[2][0]) / s;
+        x = (r[0][1] + r[1][0]) / s;
+        y = 0.25f * s;
+        z = (r[1][2] + r[2][1]) / s;
+    }
+    else
+    {
+        const float s = 2.0f * std::sqrt(1.0f + r[2][2] - r[0][0] - r[1][1]);
+        w = (r[1][0] - r[0][1]) / s;
+        x = (r[0][2] + r[2][0]) / s;
+        y = (r[1][2] + r[2][1]) / s;
+        z = 0.25f * s;
+    }
+
+    transform(pNode, lTranslation, quatf(x, y, z, w), vec3f(lScaling[0], lScaling[1], lScaling[2]));
+}
+
+mat4f LocalPose::transform(unsigned int pNode) const
+{
+    return AnimationClip::compose(translation(pNode), rotation(pNode), scaling(pNode));
+}
+
+vec3f LocalPose::translation(unsigned int pNode) const
+{
+    assert(pNode < mNodeCount && "Node index out of boundaries");
+
+    return vec3f(component(EComponent::TRANSLATION_X)[pNode], component(EComponent::TRANSLATION_Y)[pNode], component(EComponent::TRANSLATION_Z)[pNode]);
+}
+
+quatf LocalPose::rotation(unsigned int pNode) const
+{
+    assert(pNode < mNodeCount && "Node index out of boundaries");
+
+    return quatf(component(EComponent::ROTATION_X)[pNode], component(EComponent::ROTATION_Y)[pNode], component(EComponent::ROTATION_Z)[pNode], component(EComponent::ROTATION_W)[pNode]);
+}
+
+vec3f LocalPose::scaling(unsigned int pNode) const
+{
+    assert(pNode < mNodeCount && "Node index out of boundaries");
+
+    return vec3f(component(EComponent::SCALING_X)[pNode], component(EComponent::SCALING_Y)[pNode], component(EComponent::SCALING_Z)[pNode]);
+}
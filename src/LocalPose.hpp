@@ -0,0 +1,118 @@
+//===============================================================================================//
+/*!
+ *  \file      LocalPose.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include "Algebra.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores the local translation, rotation and scaling of each node of a skeleton
+     *  \details The components are stored as structure of arrays: all the x translations, then all the y
+     *           translations, etc. so that the blending kernels process several nodes at once with SIMD
+     *           instructions. A pose is only converted to matrices once, after all the blending.
+     */
+    class LocalPose
+    {
+    public:
+        enum class EComponent : unsigned int
+        {
+            TRANSLATION_X   = 0,
+            TRANSLATION_Y   = 1,
+            TRANSLATION_Z   = 2,
+            ROTATION_X      = 3,
+            ROTATION_Y      = 4,
+            ROTATION_Z      = 5,
+            ROTATION_W      = 6,
+            SCALING_X       = 7,
+            SCALING_Y       = 8,
+            SCALING_Z       = 9,
+            COUNT           = 10
+        };
+
+    public:
+        /*!
+         *  \brief Set the number of nodes, the existing nodes keep their transformation and the new ones are set to the identity
+         *  @param pNodeCount is the number of nodes in the skeleton
+         */
+        void resize(unsigned int pNodeCount);
+
+        /*!
+         *  \brief Get the number of nodes
+         *  @return the number of nodes in the pose
+         */
+        unsigned int nodeCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the values of one component for all the nodes
+         *  @param pComponent is the component, e.g. TRANSLATION_X, ROTATION_W, ...
+         *  @return a pointer on nodeCount() contiguous floats
+         */
+        float* component(EComponent pComponent) noexcept;
+
+        /*!
+         *  \brief Get the values of one component for all the nodes (read only)
+         *  @param pComponent is the component, e.g. TRANSLATION_X, ROTATION_W, ...
+         *  @return a pointer on nodeCount() contiguous floats
+         */
+        const float* component(EComponent pComponent) const noexcept;
+
+        /*!
+         *  \brief Set the local transformation of a node
+         *  @param pNode is the index of the node
+         *  @param pTranslation is the translation
+         *  @param pRotation is a unit quaternion
+         *  @param pScaling is the scaling along each axis
+         */
+        void transform(unsigned int pNode, const vec3f & pTranslation, const quatf & pRotation, const vec3f & pScaling);
+
+        /*!
+         *  \brief Set the local transformation of a node from a matrix
+         *  @param pNode is the index of the node
+         *  @param pTransform is a combination of a translation, a rotation and a scaling (without shear)
+         */
+        void transform(unsigned int pNode, const mat4f & pTransform);
+
+        /*!
+         *  \brief Get the local transformation of a node
+         *  @param pNode is the index of the node
+         *  @return the transformation translation * rotation * scaling
+         */
+        mat4f transform(unsigned int pNode) const;
+
+        /*!
+         *  \brief Get the translation of a node
+         *  @param pNode is the index of the node
+         *  @return the translation
+         */
+        vec3f translation(unsigned int pNode) const;
+
+        /*!
+         *  \brief Get the rotation of a node
+         *  @param pNode is the index of the node
+         *  @return the rotation as a unit quaternion
+         */
+        quatf rotation(unsigned int pNode) const;
+
+        /*!
+         *  \brief Get the scaling of a node
+         *  @param pNode is the index of the node
+         *  @return the scaling along each axis
+         */
+        vec3f scaling(unsigned int pNode) const;
+
+    private:
+        std::vector<float> mComponents;
+        unsigned int mNodeCount = 0;
+
+    }; // class LocalPose
+
+} // namespace miniGL
@@ -15,6 +15,7 @@
 #include "Exceptions.hpp"
 #include "EngineCommon.hpp"
 #include "Log.hpp"
+#include "GLStateCache.hpp"
 
 using std::vector;
 using std::string;
@@ -25,8 +26,11 @@ using miniGL::MeshAOS;
 using miniGL::Constants;
 using miniGL::Exceptions;
 using miniGL::CallbacksRender;
+using miniGL::DrawList;
+using miniGL::DrawPacket;
 using miniGL::VertexBoneData;
 using miniGL::Log;
+using miniGL::GLStateCache;
 
 MeshAOS::MeshAOS(const std::string & pName)
 :MeshBase(pName),
@@ -50,18 +54,22 @@ bool MeshAOS::load(const char* pFile, MeshBase::EOptions pOptions)
 
     string lFilename(pFile);
 
+    // The importer owns the scene: everything needed at runtime is copied before it goes out of scope
+    Importer lImporter;
+    const aiScene* lScene = nullptr;
+
     switch (pOptions)
     {
         case EOptions::UNSET:
-            mScene = mImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs);
+            lScene = lImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs);
             break;
 
         case EOptions::COMPUTE_TANGENT_SPACE:
-            mScene = mImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+            lScene = lImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
             break;
 
         case EOptions::ADJACENCIES:
-            mScene = mImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
+            lScene = lImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
             mWithAdjacencies = true;
             break;
 
@@ -70,13 +78,17 @@ bool MeshAOS::load(const char* pFile, MeshBase::EOptions pOptions)
             break;
     }
 
-    if(!mScene)
-        throw Exceptions(mImporter.GetErrorString(), __FILE__, __LINE__);
+    if(!lScene)
+        throw Exceptions(lImporter.GetErrorString(), __FILE__, __LINE__);
+
+    bool lResult = _initFromScene(lScene, lFilename);
 
-    // Copy root node transformation as inverse transformation
-    MeshBoneData::globalInverseTransform(mScene->mRootNode->mTransformation);
+    // Copy the hierarchy and the animation once the bones of all the entries are known
+    MeshBoneData::loadSkeleton(lScene);
 
-    bool lResult = _initFromScene(mScene, lFilename);
+    // The bone IDs and weights already use the locations of the instance matrices, see _initMeshEntry
+    if (MeshBoneData::boneCount() == 0)
+        initInstanceStreams();
 
     unbindVAO();
 
@@ -85,7 +97,7 @@ bool MeshAOS::load(const char* pFile, MeshBase::EOptions pOptions)
 
 void MeshAOS::render(EPrimitiveType pPrimitive, CallbacksRender* pRenderCallbacks)
 {
-    glFrontFace(mOrientation);
+    GLStateCache::frontFace(mOrientation);
 
     for (unsigned int i = 0; i < mEntries.size(); i++)
     {
@@ -122,7 +134,7 @@ void MeshAOS::render(unsigned int pDrawIndex, unsigned int pPrimitiveIndex)
 {
     assert(pDrawIndex < mEntries.size() && "Wrong index ");
 
-    glFrontFace(mOrientation);
+    GLStateCache::frontFace(mOrientation);
 
     bindVAO(pDrawIndex);
     glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(pPrimitiveIndex * 3 * sizeof(GLuint)));
@@ -131,9 +143,47 @@ void MeshAOS::render(unsigned int pDrawIndex, unsigned int pPrimitiveIndex)
 
 void MeshAOS::render(unsigned int pCount, const mat4f* pWVPs, const mat4f* pWorlds)
 {
-    assert(false && "Instanced rendering not implemented yet!");
+    assert(instancing() && "Instanced rendering is not available for the meshes with bones");
+
+    const GLuint lBaseInstance = uploadInstances(pCount, pWVPs, pWorlds);
+
+    GLStateCache::frontFace(mOrientation);
+
+    const auto lTopology = mWithAdjacencies ? GL_TRIANGLES_ADJACENCY : GL_TRIANGLES;
+
+    for (unsigned int i = 0; i < mEntries.size(); ++i)
+    {
+        bindVAO(i);
+
+        if (mEntries[i].materialIndex < mTextures.size() && mTextures[mEntries[i].materialIndex] != nullptr)
+            mTextures[mEntries[i].materialIndex]->bind(COLOR_TEXTURE_UNIT);
+
+        if (GLEW_ARB_base_instance)
+            glDrawElementsInstancedBaseInstance(lTopology, mEntries[i].numIndices, GL_UNSIGNED_INT, 0, pCount, lBaseInstance);
+        else
+            glDrawElementsInstanced(lTopology, mEntries[i].numIndices, GL_UNSIGNED_INT, 0, pCount);
+
+        unbindVAO();
+    }
+}
+
+void MeshAOS::record(DrawList::Recorder & pRecorder, DrawPacket pPacket) const
+{
+    pPacket.topology = mWithAdjacencies ? GL_TRIANGLES_ADJACENCY : GL_TRIANGLES;
+    pPacket.frontFace = mOrientation;
+    pPacket.baseIndex = 0;
+    pPacket.baseVertex = 0;
 
-    glFrontFace(mOrientation);
+    for (unsigned int i = 0; i < mEntries.size(); ++i)
+    {
+        const unsigned int lMaterialIndex = mEntries[i].materialIndex;
+
+        pPacket.vao = mVAOs[i];
+        pPacket.indexCount = mEntries[i].numIndices;
+        pPacket.colorTexture = lMaterialIndex < mTextures.size() && mTextures[lMaterialIndex] != nullptr ? mTextures[lMaterialIndex]->id() : 0;
+
+        pRecorder.draw(pPacket);
+    }
 }
 
 bool MeshAOS::_initFromScene(const aiScene* pScene, const string & pFile)
@@ -175,6 +225,8 @@ bool MeshAOS::_initFromScene(const aiScene* pScene, const string & pFile)
         unbindVAO();
     }
 
+    initBounds(pScene);
+
     return initMaterials(pScene, pFile);
 }
 
@@ -278,6 +330,8 @@ void MeshAOS::clear(void)
     clearVAOs();
 
     mEntries.clear();
+
+    MeshBoneData::clearBones();
 }
 
 void MeshAOS::_initMeshEntry(MeshEntry & pMeshEntry, const vector<Vertex> & pVertices, const vector<unsigned int>& pIndices)
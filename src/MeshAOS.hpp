@@ -68,6 +68,11 @@ namespace miniGL
          */
         virtual void render(unsigned int pCount, const mat4f* pWVPs, const mat4f* pWorlds) final;
 
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void record(DrawList::Recorder & pRecorder, DrawPacket pPacket) const final;
+
         /*!
          *  \brief Implementation of a virtual method from MeshBase
          */
@@ -78,11 +83,56 @@ namespace miniGL
          */
         virtual void boneTransform(float pTime, std::vector<mat4f> & pTransforms) final;
 
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void boneTransform(float pTime, std::vector<mat4f> & pTransforms, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms) final;
+
         /*!
          *  \brief Implementation of a virtual method from MeshBase
          */
         virtual unsigned int boneCount(void) const noexcept final;
 
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void boneInfluences(unsigned int pCount) final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual unsigned int boneInfluences(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual unsigned int boneIndexBits(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual const Skeleton & skeleton(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual const CompressedClip & animationClip(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual unsigned int animationClipCount(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual const CompressedClip & animationClip(unsigned int pIndex) const final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual int nodeIndex(const std::string & pName) const final;
+
     private:
         struct MeshEntry
         {
@@ -130,7 +180,12 @@ namespace miniGL
 
     inline void MeshAOS::boneTransform(float pTime, std::vector<mat4f> & pTransforms)
     {
-        MeshBoneData::boneTransform(mScene, pTime, pTransforms);
+        MeshBoneData::boneTransform(pTime, pTransforms);
+    }
+
+    inline void MeshAOS::boneTransform(float pTime, std::vector<mat4f> & pTransforms, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms)
+    {
+        MeshBoneData::boneTransform(pTime, pTransforms, pCursor, pNodeTransforms);
     }
 
     inline unsigned int MeshAOS::boneCount(void) const noexcept
@@ -138,4 +193,44 @@ namespace miniGL
         return MeshBoneData::boneCount();
     }
 
+    inline void MeshAOS::boneInfluences(unsigned int pCount)
+    {
+        MeshBoneData::boneInfluences(pCount);
+    }
+
+    inline unsigned int MeshAOS::boneInfluences(void) const noexcept
+    {
+        return MeshBoneData::boneInfluences();
+    }
+
+    inline unsigned int MeshAOS::boneIndexBits(void) const noexcept
+    {
+        return MeshBoneData::boneIndexBits();
+    }
+
+    inline const Skeleton & MeshAOS::skeleton(void) const noexcept
+    {
+        return MeshBoneData::skeleton();
+    }
+
+    inline const CompressedClip & MeshAOS::animationClip(void) const noexcept
+    {
+        return MeshBoneData::animationClip();
+    }
+
+    inline unsigned int MeshAOS::animationClipCount(void) const noexcept
+    {
+        return MeshBoneData::animationClipCount();
+    }
+
+    inline const CompressedClip & MeshAOS::animationClip(unsigned int pIndex) const
+    {
+        return MeshBoneData::animationClip(pIndex);
+    }
+
+    inline int MeshAOS::nodeIndex(const std::string & pName) const
+    {
+        return MeshBoneData::nodeIndex(pName);
+    }
+
 } // namespace miniGL
@@ -10,18 +10,19 @@
 
 #include <vector>
 
-#include "Transform.hpp"
+#include "TransformStore.hpp"
 #include "MeshBase.hpp"
 
 namespace miniGL
 {
     /*!
      *  \brief   Simple container for a mesh and its associated transform
-     *  \details The mesh is stored as a shared pointer on a MeshBase but should be created using one of the derived classes
+     *  \details The mesh is stored as a shared pointer on a MeshBase but should be created using one of the derived classes.
+     *           There is one transform per instance of the mesh.
      */
     struct MeshAndTransform
     {
-        std::vector<Transform> transform;
+        TransformStore transform;
         std::shared_ptr<MeshBase> mesh;
 
     }; // struct MeshAndTransform
@@ -9,20 +9,24 @@
 #include "MeshBase.hpp"
 
 #include <cassert>
-#include <iostream>
+#include <algorithm>
 
 #include "Constants.hpp"
 #include "Exceptions.hpp"
 #include "EngineCommon.hpp"
+#include "GLUtils.hpp"
+
+// Number of instances that a mesh can draw per frame before its instance streams grow
+#define MESH_BASE_RING_INSTANCES 256
 
 using std::vector;
 using std::string;
-using std::cout;
-using std::endl;
 using Assimp::Importer;
 using miniGL::MeshBase;
 using miniGL::Constants;
 using miniGL::Exceptions;
+using miniGL::DynamicRingBuffer;
+using miniGL::StaticBatchBuilder;
 
 MeshBase::MeshBase(const std::string & pName)
 :mName(pName)
@@ -77,6 +81,16 @@ GLenum MeshBase::frontFace(void) const noexcept
     return mOrientation;
 }
 
+const vec3f & MeshBase::boundsMin(void) const noexcept
+{
+    return mBoundsMin;
+}
+
+const vec3f & MeshBase::boundsMax(void) const noexcept
+{
+    return mBoundsMax;
+}
+
 bool MeshBase::initMaterials(const aiScene* pScene, const string & pFile)
 {
     bool lInitMaterialOk = false;
@@ -134,6 +148,33 @@ void MeshBase::clearTextures(void)
     }
 }
 
+void MeshBase::initBounds(const aiScene* pScene)
+{
+    bool lFirst = true;
+
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i)
+    {
+        const aiMesh* rMesh = pScene->mMeshes[i];
+
+        for (unsigned int j = 0; j < rMesh->mNumVertices; ++j)
+        {
+            const aiVector3D & rPos = rMesh->mVertices[j];
+
+            if (lFirst)
+            {
+                mBoundsMin = vec3f(rPos.x, rPos.y, rPos.z);
+                mBoundsMax = mBoundsMin;
+                lFirst = false;
+            }
+            else
+            {
+                mBoundsMin = vec3f(std::min(mBoundsMin.x(), rPos.x), std::min(mBoundsMin.y(), rPos.y), std::min(mBoundsMin.z(), rPos.z));
+                mBoundsMax = vec3f(std::max(mBoundsMax.x(), rPos.x), std::max(mBoundsMax.y(), rPos.y), std::max(mBoundsMax.z(), rPos.z));
+            }
+        }
+    }
+}
+
 void MeshBase::clearVAOs(void)
 {
     for (auto & it : mVAOs)
@@ -144,9 +185,149 @@ void MeshBase::clearVAOs(void)
             it = 0;
         }
     }
+
+    mInstanceWVPs.clear();
+    mInstanceWorlds.clear();
+    mMappedWVPs = DynamicRingBuffer::Allocation();
+    mMappedWorlds = DynamicRingBuffer::Allocation();
+    mStreamBuffers[0] = mStreamBuffers[1] = 0;
+}
+
+void MeshBase::initInstanceStreams(void)
+{
+    // Same sizes and same allocations, so that both ring buffers keep the same offsets
+    mInstanceWVPs.init(GL_ARRAY_BUFFER, MESH_BASE_RING_INSTANCES * sizeof(mat4f));
+    mInstanceWorlds.init(GL_ARRAY_BUFFER, MESH_BASE_RING_INSTANCES * sizeof(mat4f));
+
+    // One identity matrix, so that the draw calls without instances do not read an empty stream
+    const mat4f lIdentity(1.0f);
+    uploadInstances(1, & lIdentity, & lIdentity);
+
+    for (GLuint lVAO : mVAOs)
+    {
+        if (lVAO == 0)
+            continue;
+
+        glBindVertexArray(lVAO);
+
+        // A matrix takes 4 locations, one per column, that advance once per instance
+        for (GLuint i = 0; i < 4; ++i)
+        {
+            glEnableVertexAttribArray(INSTANCE_WVP_LOCATION + i);
+            glVertexAttribDivisor(INSTANCE_WVP_LOCATION + i, 1);
+
+            glEnableVertexAttribArray(INSTANCE_WORLD_LOCATION + i);
+            glVertexAttribDivisor(INSTANCE_WORLD_LOCATION + i, 1);
+        }
+
+        checkOpenGLState;
+    }
+
+    glBindVertexArray(0);
+}
+
+MeshBase::InstanceStreams MeshBase::mapInstances(unsigned int pCount)
+{
+    assert(instancing() && "The instance streams of the mesh are not initialized");
+
+    // Aligned on a matrix, so that the offset is a whole number of instances
+    mMappedWVPs = mInstanceWVPs.allocate(sizeof(mat4f) * pCount, sizeof(mat4f));
+    mMappedWorlds = mInstanceWorlds.allocate(sizeof(mat4f) * pCount, sizeof(mat4f));
+
+    InstanceStreams lStreams;
+    lStreams.WVPs = static_cast<mat4f*>(mMappedWVPs.data);
+    lStreams.worlds = static_cast<mat4f*>(mMappedWorlds.data);
+
+    return lStreams;
+}
+
+GLuint MeshBase::uploadInstances(unsigned int pCount, const mat4f* pWVPs, const mat4f* pWorlds)
+{
+    assert(instancing() && "The instance streams of the mesh are not initialized");
+
+    const bool lMapped = mMappedWVPs.data == pWVPs && mMappedWVPs.size == static_cast<GLsizeiptr>(sizeof(mat4f) * pCount);
+    const InstanceStreams lStreams = lMapped ? InstanceStreams{ const_cast<mat4f*>(pWVPs), static_cast<mat4f*>(mMappedWorlds.data) } : mapInstances(pCount);
+
+    if (lStreams.WVPs != pWVPs)
+        std::copy(pWVPs, pWVPs + pCount, lStreams.WVPs);
+
+    if (lStreams.worlds != pWorlds)
+        std::copy(pWorlds, pWorlds + pCount, lStreams.worlds);
+
+    mInstanceWVPs.commit(mMappedWVPs);
+    mInstanceWorlds.commit(mMappedWorlds);
+
+    assert(mMappedWVPs.offset == mMappedWorlds.offset && "The instance ring buffers must stay in step");
+
+    const GLuint lWVPs = mMappedWVPs.buffer;
+    const GLuint lWorlds = mMappedWorlds.buffer;
+    const GLintptr lOffset = mMappedWVPs.offset;
+
+    mMappedWVPs = DynamicRingBuffer::Allocation();
+    mMappedWorlds = DynamicRingBuffer::Allocation();
+
+    // OpenGL 4.2, the draw call starts at the instance of the offset
+    if (GLEW_ARB_base_instance)
+    {
+        if (lWVPs != mStreamBuffers[0] || lWorlds != mStreamBuffers[1])
+            _pointInstanceStreams(lWVPs, lWorlds, 0);
+
+        return static_cast<GLuint>(lOffset / sizeof(mat4f));
+    }
+
+    // The matrices of this draw call are somewhere else in the ring buffers, the VAOs must point on them
+    _pointInstanceStreams(lWVPs, lWorlds, lOffset);
+
+    return 0;
+}
+
+bool MeshBase::batch(StaticBatchBuilder & /*pBuilder*/, const mat4f & /*pWorld*/) const
+{
+    return false;
+}
+
+void MeshBase::instanceAnimations(unsigned int /*pCount*/, const vec4f* /*pAnimations*/)
+{
+    assert(false && "The mesh does not support animated instances");
+}
+
+void MeshBase::skinOnCPU(const mat4f* /*pTransforms*/, JobSystem* /*pJobSystem*/)
+{
+}
+
+bool MeshBase::instancing(void) const noexcept
+{
+    return mInstanceWVPs.id() != 0;
 }
 
 MeshBase::EOptions MeshBase::loadOption(void) const noexcept
 {
     return mLoadOptions;
 }
+
+void MeshBase::_pointInstanceStreams(GLuint pWVPs, GLuint pWorlds, GLintptr pOffset)
+{
+    for (GLuint lVAO : mVAOs)
+    {
+        if (lVAO == 0)
+            continue;
+
+        glBindVertexArray(lVAO);
+
+        // The attribute pointers keep the buffer bound when they are specified
+        glBindBuffer(GL_ARRAY_BUFFER, pWVPs);
+
+        for (GLuint i = 0; i < 4; ++i)
+            glVertexAttribPointer(INSTANCE_WVP_LOCATION + i, 4, GL_FLOAT, GL_FALSE, sizeof(mat4f), reinterpret_cast<GLvoid*>(pOffset + sizeof(GLfloat) * i * 4));
+
+        glBindBuffer(GL_ARRAY_BUFFER, pWorlds);
+
+        for (GLuint i = 0; i < 4; ++i)
+            glVertexAttribPointer(INSTANCE_WORLD_LOCATION + i, 4, GL_FLOAT, GL_FALSE, sizeof(mat4f), reinterpret_cast<GLvoid*>(pOffset + sizeof(GLfloat) * i * 4));
+    }
+
+    glBindVertexArray(0);
+
+    mStreamBuffers[0] = pWVPs;
+    mStreamBuffers[1] = pWorlds;
+}
@@ -22,6 +22,13 @@
 #include "CallbacksRender.hpp"
 #include "Algebra.hpp"
 #include "MeshAdjacencies.hpp"
+#include "AnimationCursor.hpp"
+#include "CompressedClip.hpp"
+#include "Skeleton.hpp"
+#include "JobSystem.hpp"
+#include "DrawList.hpp"
+#include "DynamicRingBuffer.hpp"
+#include "StaticBatchBuilder.hpp"
 
 namespace miniGL
 {
@@ -46,6 +53,13 @@ namespace miniGL
             PATCH    = 0b10
         };
 
+        //! Where to write the transposed matrices of the instances of the next instanced draw call
+        struct InstanceStreams
+        {
+            mat4f* WVPs = nullptr;
+            mat4f* worlds = nullptr;
+        };
+
     public:
         /*!
          *  \brief Default constructor
@@ -105,13 +119,56 @@ namespace miniGL
         virtual void render(unsigned int pDrawIndex, unsigned int pPrimitiveIndex) = 0;
 
         /*!
-         *  \brief Apply instance rendering to the mesh
+         *  \brief Apply instance rendering to the mesh, only if instancing() is true
          *  \param pCount is the number of instances to draw
-         *  \param pWVPs is an array containing the WVP matrices for each instance (as many as pCount)
-         *  \param pWorlds is an array containing the world matrices for each instance (as many as pCount)
+         *  \param pWVPs is an array containing the transposed WVP matrices for each instance (as many as pCount)
+         *  \param pWorlds is an array containing the transposed world matrices for each instance (as many as pCount)
+         *  \note  The arrays returned by mapInstances(pCount) are drawn without being copied
          */
         virtual void render(unsigned int pCount, const mat4f* pWVPs, const mat4f* pWorlds) = 0;
 
+        /*!
+         *  \brief Get the memory of the instance streams, to write the matrices of the next instanced draw call
+         *         directly where the GPU reads them, only if instancing() is true
+         *  \param pCount is the number of instances
+         *  \return the arrays to fill and to pass to render(pCount, WVPs, worlds) before any other instanced draw call
+         */
+        InstanceStreams mapInstances(unsigned int pCount);
+
+        /*!
+         *  \brief Record the draw calls of the loaded mesh instead of rendering it, it does not call openGL
+         *  \param pRecorder receives one packet per entry of the mesh
+         *  \param pPacket has the program and the uniforms set by the technique, the mesh completes the geometry
+         *         and the texture
+         */
+        virtual void record(DrawList::Recorder & pRecorder, DrawPacket pPacket) const = 0;
+
+        /*!
+         *  \brief Add the geometry of the mesh to a static batch, for a mesh that never moves
+         *  \param pBuilder receives the vertices in world space and the triangles of each entry
+         *  \param pWorld is the world matrix of the mesh
+         *  \return false if the vertex format of the mesh cannot be batched (e.g. tangents, bones or adjacencies)
+         */
+        virtual bool batch(StaticBatchBuilder & pBuilder, const mat4f & pWorld) const;
+
+        /*!
+         *  \brief Set the animation played by each instance for the next instanced rendering of a skinned mesh
+         *  \param pCount is the number of instances
+         *  \param pAnimations is an array containing the baked animation attribute of each instance (as many as pCount),
+         *         see BakedAnimation::instanceAttribute
+         *  \note  Only the meshes that can be loaded for instance rendering with bones override it, the default asserts
+         */
+        virtual void instanceAnimations(unsigned int pCount, const vec4f* pAnimations);
+
+        /*!
+         *  \brief Deform the vertices on the CPU, so that the next draw calls use the animated mesh with shaders that do not
+         *         skin the vertices (e.g. shadow volumes or picking)
+         *  @param pTransforms contains boneCount() bone transformations (e.g. from boneTransform), or nullptr to draw the bind pose again
+         *  @param pJobSystem splits the vertices between several threads, or nullptr to skin them on the calling thread
+         *  \note  The default does nothing, the meshes that cannot be deformed on the CPU keep drawing their bind pose
+         */
+        virtual void skinOnCPU(const mat4f* pTransforms, JobSystem* pJobSystem = nullptr);
+
         /*!
          *  \brief Free all the memory loaded for the current mesh, reset all handles and state variables
          */
@@ -124,12 +181,73 @@ namespace miniGL
          */
         virtual void boneTransform(float pTime, std::vector<mat4f> & pTransforms) = 0;
 
+        /*!
+         *  \brief Get all the transformations associated to each bones for the current time
+         *  @param pTime is in seconds
+         *  @param pTransforms contains all the current transformation matrices
+         *  @param pCursor keeps the keyframes of the previous call for one animated instance, so that
+         *         a monotonic playback finds the next keys without searching the whole animation
+         *  @param pNodeTransforms is a buffer owned by the caller for the global transformation of each node, so that
+         *         a steady playback does not allocate memory
+         */
+        virtual void boneTransform(float pTime, std::vector<mat4f> & pTransforms, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms) = 0;
+
         /*!
          *  \brief Get the number of bones
          *  @param return the number of bones
          */
         virtual unsigned int boneCount(void) const noexcept = 0;
 
+        /*!
+         *  \brief Set the number of bones kept per vertex, it must be called before loading the mesh
+         *  @param pCount is 4 or 8, the weights of the other bones are shared between the strongest ones
+         */
+        virtual void boneInfluences(unsigned int pCount) = 0;
+
+        /*!
+         *  \brief Get the number of bones kept per vertex, the skinning shaders need it to decode the bone attributes
+         *  @return 4 or 8
+         */
+        virtual unsigned int boneInfluences(void) const noexcept = 0;
+
+        /*!
+         *  \brief Get the size of the bone IDs and weights, the skinning shaders need it to decode the bone attributes
+         *  @return 8 bits for meshes with up to 256 bones, 16 bits otherwise
+         */
+        virtual unsigned int boneIndexBits(void) const noexcept = 0;
+
+        /*!
+         *  \brief Get the skeleton of the mesh, used to evaluate poses outside of the mesh
+         *  @return a const reference on the skeleton (empty if the mesh has no bones)
+         */
+        virtual const Skeleton & skeleton(void) const noexcept = 0;
+
+        /*!
+         *  \brief Get the animation loaded with the mesh
+         *  @return a const reference on the compressed animation clip (without channels if the mesh is not animated)
+         */
+        virtual const CompressedClip & animationClip(void) const noexcept = 0;
+
+        /*!
+         *  \brief Get the number of animations loaded with the mesh
+         *  @return the number of animation clips, at least 1 (the first one has no channels if the mesh is not animated)
+         */
+        virtual unsigned int animationClipCount(void) const noexcept = 0;
+
+        /*!
+         *  \brief Get one of the animations loaded with the mesh, e.g. to blend several of them
+         *  @param pIndex is the index of the animation in the file
+         *  @return a const reference on the compressed animation clip
+         */
+        virtual const CompressedClip & animationClip(unsigned int pIndex) const = 0;
+
+        /*!
+         *  \brief Find a node of the skeleton by name, e.g. to build a blending mask
+         *  @param pName is the name of the node in the file
+         *  @return the index of the node in the skeleton, or -1 if there is no node with this name
+         */
+        virtual int nodeIndex(const std::string & pName) const = 0;
+
         /*!
          * \brief Get the name of the mesh (read only)
          * @return a copy of mName
@@ -160,6 +278,24 @@ namespace miniGL
          */
         EOptions loadOption(void) const noexcept;
 
+        /*!
+         * \brief Check if the mesh can be drawn with instance rendering
+         * @return true if the VAOs read the instance streams at INSTANCE_WVP_LOCATION and INSTANCE_WORLD_LOCATION
+         */
+        bool instancing(void) const noexcept;
+
+        /*!
+         * \brief Get the bounding box of the vertices in the bind pose
+         * @return the corner of the box with the smallest coordinates, in the space of the mesh
+         */
+        const vec3f & boundsMin(void) const noexcept;
+
+        /*!
+         * \brief Get the bounding box of the vertices in the bind pose
+         * @return the corner of the box with the largest coordinates, in the space of the mesh
+         */
+        const vec3f & boundsMax(void) const noexcept;
+
     protected:
         /*!
          *  \brief Helper method to load textures to openGL
@@ -174,23 +310,60 @@ namespace miniGL
         void clearTextures(void);
 
         /*!
-         *  \brief Free all the VAOs and set the handle to 0
+         *  \brief Helper method to compute the bounding box of all the vertices of the scene, used for culling
+         *  @param pScene is the scene created using assimp
+         */
+        void initBounds(const aiScene* pScene);
+
+        /*!
+         *  \brief Free all the VAOs and the instance streams, and set the handles to 0
          */
         void clearVAOs(void);
 
+        /*!
+         *  \brief Add the per instance WVP and world matrices to all the VAOs, once they are created
+         */
+        void initInstanceStreams(void);
+
+        /*!
+         *  \brief Send the matrices of the instances to draw and point the instance streams of the VAOs on them
+         *  \details With ARB_base_instance the VAOs point on the start of the ring buffers and the draw call starts at
+         *           the instance of the matrices, so the attribute pointers only change when the ring buffers grow.
+         *           Without it (e.g. OpenGL 4.1 on macOS), they are specified again for each draw call
+         *  @param pCount is the number of instances
+         *  @param pWVPs is an array containing the transposed WVP matrices (as many as pCount), copied unless it was
+         *         returned by mapInstances
+         *  @param pWorlds is an array containing the transposed world matrices (as many as pCount)
+         *  @return the base instance of the draw call, 0 without ARB_base_instance
+         */
+        GLuint uploadInstances(unsigned int pCount, const mat4f* pWVPs, const mat4f* pWorlds);
+
+    private:
+        /*!
+         *  \brief Helper method to point the instance streams of all the VAOs on the matrices
+         *  @param pWVPs is the buffer object of the WVP matrices
+         *  @param pWorlds is the buffer object of the world matrices
+         *  @param pOffset is the offset of the first instance in both buffers
+         */
+        void _pointInstanceStreams(GLuint pWVPs, GLuint pWorlds, GLintptr pOffset);
+
     protected:
         std::vector<Texture*> mTextures;
         std::string mName = std::string("");
         EOptions mLoadOptions = EOptions::UNSET;
         std::vector<GLuint> mVAOs;
+        DynamicRingBuffer mInstanceWVPs;                        //!< WVP matrices of the instances of each draw call
+        DynamicRingBuffer mInstanceWorlds;                      //!< World matrices, at the same offsets as the WVP matrices
+        DynamicRingBuffer::Allocation mMappedWVPs;              //!< Returned by mapInstances and not drawn yet
+        DynamicRingBuffer::Allocation mMappedWorlds;
+        GLuint mStreamBuffers[2] = {0, 0};                      //!< Buffers the instance streams of the VAOs point on
         GLenum mOrientation = GL_CCW;
+        vec3f mBoundsMin = vec3f(0.0f, 0.0f, 0.0f);
+        vec3f mBoundsMax = vec3f(0.0f, 0.0f, 0.0f);
 
         MeshAdjacencies mAdjacencyTool;
         bool mWithAdjacencies = false;
 
-        const aiScene* mScene = nullptr;
-        Assimp::Importer mImporter;
-
     }; // class MeshBase
 
 } // namespace miniGL
@@ -8,265 +8,193 @@
 
 #include "MeshBoneData.hpp"
 
+#include <cassert>
+
 #include "Exceptions.hpp"
-#include "Transform.hpp"
 
+using std::map;
 using std::string;
 using std::vector;
 using miniGL::MeshBoneData;
 using miniGL::Exceptions;
-using miniGL::Transform;
 using miniGL::VertexBoneData;
+using miniGL::AnimationCursor;
+using miniGL::AnimationClip;
+using miniGL::CompressedClip;
+using miniGL::Skeleton;
+using miniGL::PackedBoneData;
 
-void MeshBoneData::boneTransform(const aiScene * pScene, float pTime, std::vector<mat4f> & pTransforms)
+void MeshBoneData::boneTransform(float pTime, std::vector<mat4f> & pTransforms)
 {
-    mat4f lIdentity(1.0f);
-
-    float lTickPerSeconds = static_cast<float>(pScene->mAnimations[0]->mTicksPerSecond != 0.0 ? pScene->mAnimations[0]->mTicksPerSecond : 25.0f);
-    float lTimeInTicks = pTime * lTickPerSeconds;
-    float lAnimationTime = fmod(lTimeInTicks, static_cast<float>(pScene->mAnimations[0]->mDuration));
-
-    _readNodeHierarchy(pScene, lAnimationTime, pScene->mRootNode, lIdentity);
-
-    pTransforms.resize(mBoneCount);
-
-    for (unsigned int i = 0; i < mBoneCount; ++i)
-        pTransforms[i] = mBoneInfo[i].finalTransformation;
+    boneTransform(pTime, pTransforms, mCursor, mNodeTransforms);
 }
 
-void MeshBoneData::loadBones(unsigned int pMeshEntryBaseVertex, const aiMesh* pMesh, vector<VertexBoneData<4>> & pBones)
+void MeshBoneData::boneTransform(float pTime, std::vector<mat4f> & pTransforms, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms) const
 {
-    for (unsigned int i = 0; i < pMesh->mNumBones; ++i)
-    {
-        unsigned int lBoneIndex = 0;
-        string lBoneName(pMesh->mBones[i]->mName.data);
-
-        if (mBoneMapping.find(lBoneName) == mBoneMapping.end())
-        {
-            // Allocate an index for a new bone
-            lBoneIndex = mBoneCount;
-            mBoneCount++;
-            BoneInfo lBoneInfo;
-            mBoneInfo.push_back(lBoneInfo);
-
-            // Copy bone matrix to bone info
-            mBoneInfo[lBoneIndex].boneOffset = _convertMatrix(pMesh->mBones[i]->mOffsetMatrix);
-
-            mBoneMapping[lBoneName] = lBoneIndex;
-        }
-        else
-            lBoneIndex = mBoneMapping[lBoneName];
-
-        for (unsigned int j = 0; j < pMesh->mBones[i]->mNumWeights; ++j)
-        {
-            const unsigned int lVertexID = pMeshEntryBaseVertex + pMesh->mBones[i]->mWeights[j].mVertexId;
-            const float lWeight = pMesh->mBones[i]->mWeights[j].mWeight;
+    pTransforms.resize(mSkeleton.boneCount());
 
-            pBones[lVertexID].addBoneData(lBoneIndex, lWeight);
-        }
-    }
+    mSkeleton.pose(mClips[0], mClips[0].animationTime(pTime), pCursor, pNodeTransforms, pTransforms.data());
 }
 
-unsigned int MeshBoneData::boneCount(void) const noexcept
+void MeshBoneData::boneInfluences(unsigned int pCount)
 {
-    return mBoneCount;
+    assert((pCount == 4 || pCount == 8) && "The shaders read 4 or 8 bones per vertex");
+    mBoneInfluences = pCount;
 }
 
-void MeshBoneData::globalInverseTransform(const aiMatrix4x4 & pTransform)
+unsigned int MeshBoneData::boneInfluences(void) const noexcept
 {
-    mGlobalInverseTransform = _convertMatrix(pTransform);
-    mGlobalInverseTransform.inverse();
+    return mBoneInfluences;
 }
 
-aiVector3D MeshBoneData::_interpolatedScaling(float pAnimationTime, const aiNodeAnim * pNodeAnim)
+unsigned int MeshBoneData::boneIndexBits(void) const noexcept
 {
-    // At least 2 values are necessary to interpolate
-    if (pNodeAnim->mNumScalingKeys == 1)
-    {
-        return pNodeAnim->mScalingKeys[0].mValue;
-    }
-    else
-    {
-        unsigned int lScalingIndex = _findScaling(pAnimationTime, pNodeAnim);
-        const unsigned int lNextScalingIndex = lScalingIndex + 1;
-
-        assert(lNextScalingIndex < pNodeAnim->mNumScalingKeys);
-
-        auto lDeltaTime = static_cast<float>(pNodeAnim->mScalingKeys[lNextScalingIndex].mTime - pNodeAnim->mScalingKeys[lScalingIndex].mTime);
-
-        float lFactor = (pAnimationTime - static_cast<float>(pNodeAnim->mScalingKeys[lScalingIndex].mTime)) / lDeltaTime;
-
-        assert(0.0f <= lFactor && lFactor <= 1.0f);
-
-        const aiVector3D & lStart = pNodeAnim->mScalingKeys[lScalingIndex].mValue;
-        const aiVector3D & lEnd = pNodeAnim->mScalingKeys[lNextScalingIndex].mValue;
-
-        return lStart + lFactor * (lEnd - lStart);
-    }
+    return PackedBoneData::indexBits(mSkeleton.boneCount());
 }
 
-aiQuaternion MeshBoneData::_interpolatedRotation(float pAnimationTime, const aiNodeAnim * pNodeAnim)
+void MeshBoneData::loadSkeleton(const aiScene * pScene)
 {
-    // At least 2 values are necessary to interpolate
-    if (pNodeAnim->mNumRotationKeys == 1)
-    {
-        return pNodeAnim->mRotationKeys[0].mValue;
-    }
-    else
-    {
-        unsigned int lRotationIndex = _findRotation(pAnimationTime, pNodeAnim);
-        const unsigned int lNextRotationIndex = lRotationIndex + 1;
-
-        assert(lNextRotationIndex < pNodeAnim->mNumRotationKeys);
+    // Copy root node transformation as inverse transformation
+    mat4f lGlobalInverseTransform = _convertMatrix(pScene->mRootNode->mTransformation);
+    lGlobalInverseTransform.inverse();
+    mSkeleton.globalInverseTransform(lGlobalInverseTransform);
 
-        auto lDeltaTime = static_cast<float>(pNodeAnim->mRotationKeys[lNextRotationIndex].mTime - pNodeAnim->mRotationKeys[lRotationIndex].mTime);
+    _loadNodeHierarchy(pScene->mRootNode, -1);
 
-        float lFactor = (pAnimationTime - static_cast<float>(pNodeAnim->mRotationKeys[lRotationIndex].mTime)) / lDeltaTime;
-
-        assert(0.0f <= lFactor && lFactor <= 1.0f);
-
-        const aiQuaternion & lStart = pNodeAnim->mRotationKeys[lRotationIndex].mValue;
-        const aiQuaternion & lEnd = pNodeAnim->mRotationKeys[lNextRotationIndex].mValue;
-
-        aiQuaternion lRes;
-        aiQuaternion::Interpolate(lRes, lStart, lEnd, lFactor);
-        return lRes.Normalize();
-    }
-}
-
-aiVector3D MeshBoneData::_interpolatedPosition(float pAnimationTime, const aiNodeAnim * pNodeAnim)
-{
-    // At least 2 values are necessary to interpolate
-    if (pNodeAnim->mNumPositionKeys == 1)
+    // The bone names are only needed to attach the bones to the nodes
+    for (const auto & lBone : mBoneMapping)
     {
-        return pNodeAnim->mPositionKeys[0].mValue;
-    }
-    else
-    {
-        unsigned int lPositionIndex = _findPosition(pAnimationTime, pNodeAnim);
-        const unsigned int lNextPositionIndex = lPositionIndex + 1;
-
-        assert(lNextPositionIndex < pNodeAnim->mNumPositionKeys);
+        auto lNode = mNodeMapping.find(lBone.first);
 
-        auto lDeltaTime = static_cast<float>(pNodeAnim->mPositionKeys[lNextPositionIndex].mTime - pNodeAnim->mPositionKeys[lPositionIndex].mTime);
+        if (lNode != mNodeMapping.end())
+            mSkeleton.boneNode(lBone.second, lNode->second);
+    }
 
-        float lFactor = (pAnimationTime - static_cast<float>(pNodeAnim->mPositionKeys[lPositionIndex].mTime)) / lDeltaTime;
+    mBoneMapping.clear();
 
-        assert(0.0f <= lFactor && lFactor <= 1.0f);
+    // Keep one clip without channels for a mesh that is not animated
+    mClips.resize(1);
+    mClips[0].clear();
 
-        const aiVector3D & lStart = pNodeAnim->mPositionKeys[lPositionIndex].mValue;
-        const aiVector3D & lEnd = pNodeAnim->mPositionKeys[lNextPositionIndex].mValue;
+    if (pScene->mNumAnimations > 0)
+    {
+        mClips.clear();
+        mClips.reserve(pScene->mNumAnimations);
 
-        return lStart + lFactor * (lEnd - lStart);
+        // Only the compressed keys are kept, the clips are sampled by the cursors without decompressing them first
+        for (unsigned int i = 0; i < pScene->mNumAnimations; ++i)
+            mClips.emplace_back(_loadAnimation(pScene->mAnimations[i]));
     }
+
+    mCursor.reset(mClips[0].channelCount());
 }
 
-unsigned int MeshBoneData::_findScaling(float pAnimationTime, const aiNodeAnim * pNodeAnim)
+void MeshBoneData::clearBones(void)
 {
-    if (pNodeAnim->mNumScalingKeys <= 0)
-        throw Exceptions("No scaling keys found for animation", __FILE__, __LINE__);
-
-    for (unsigned int i = 0; i < pNodeAnim->mNumScalingKeys - 1; ++i)
-    {
-        if (pAnimationTime < static_cast<float>(pNodeAnim->mScalingKeys[i + 1].mTime))
-            return i;
-    }
-
-    throw Exceptions("Unable to find node scaling for current animation", __FILE__, __LINE__);
-
-    return 0;
+    mBoneMapping.clear();
+    mNodeMapping.clear();
+    mSkeleton.clear();
+    mClips.resize(1);
+    mClips[0].clear();
+    mCursor.reset(0);
+    mNodeTransforms.clear();
 }
 
-unsigned int MeshBoneData::_findRotation(float pAnimationTime, const aiNodeAnim * pNodeAnim)
+unsigned int MeshBoneData::boneCount(void) const noexcept
 {
-    if (pNodeAnim->mNumRotationKeys <= 0)
-        throw Exceptions("No rotation keys found for animation", __FILE__, __LINE__);
-
-    for (unsigned int i = 0; i < pNodeAnim->mNumRotationKeys - 1; ++i)
-    {
-        if (pAnimationTime < static_cast<float>(pNodeAnim->mRotationKeys[i + 1].mTime))
-            return i;
-    }
+    return mSkeleton.boneCount();
+}
 
-    throw Exceptions("Unable to find node rotation for current animation", __FILE__, __LINE__);
+const Skeleton & MeshBoneData::skeleton(void) const noexcept
+{
+    return mSkeleton;
+}
 
-    return 0;
+const CompressedClip & MeshBoneData::animationClip(void) const noexcept
+{
+    return mClips[0];
 }
 
-unsigned int MeshBoneData::_findPosition(float pAnimationTime, const aiNodeAnim * pNodeAnim)
+unsigned int MeshBoneData::animationClipCount(void) const noexcept
 {
-    for (unsigned int i = 0; i < pNodeAnim->mNumPositionKeys - 1; ++i)
-    {
-        if (pAnimationTime < static_cast<float>(pNodeAnim->mPositionKeys[i + 1].mTime))
-            return i;
-    }
+    return static_cast<unsigned int>(mClips.size());
+}
 
-    throw Exceptions("Unable to find node position for current animation", __FILE__, __LINE__);
+const CompressedClip & MeshBoneData::animationClip(unsigned int pIndex) const
+{
+    assert(pIndex < mClips.size() && "Animation index out of boundaries");
 
-    return 0;
+    return mClips[pIndex];
 }
 
-const aiNodeAnim* MeshBoneData::_findNodeAnim(const aiAnimation* pAnimation, const std::string & pNodeName)
+int MeshBoneData::nodeIndex(const string & pName) const
 {
-    for (unsigned int i = 0; i < pAnimation->mNumChannels; ++i)
-    {
-        const aiNodeAnim* rNodeAnim = pAnimation->mChannels[i];
-
-        if (string(rNodeAnim->mNodeName.data) == pNodeName)
-            return rNodeAnim;
-    }
+    auto lNode = mNodeMapping.find(pName);
 
-    return nullptr;
+    return lNode != mNodeMapping.end() ? static_cast<int>(lNode->second) : -1;
 }
 
-void MeshBoneData::_readNodeHierarchy(const aiScene * pScene, float pAnimationTime, const aiNode* pNode, const mat4f & pParentTransform)
+AnimationClip MeshBoneData::_loadAnimation(const aiAnimation * pAnimation) const
 {
-    string lNodeName(pNode->mName.data);
+    AnimationClip lClip(static_cast<float>(pAnimation->mTicksPerSecond), static_cast<float>(pAnimation->mDuration));
 
-    const aiAnimation * rAnimation = pScene->mAnimations[0];
+    for (unsigned int i = 0; i < pAnimation->mNumChannels; ++i)
+    {
+        const aiNodeAnim* rNodeAnim = pAnimation->mChannels[i];
 
-    mat4f lNodeTransformation = _convertMatrix(pNode->mTransformation);
+        // Skip the channels that do not animate a node of the hierarchy
+        auto lNode = mNodeMapping.find(string(rNodeAnim->mNodeName.data));
 
-    const aiNodeAnim* rNodeAnim = _findNodeAnim(rAnimation, lNodeName);
+        if (lNode == mNodeMapping.end())
+            continue;
 
-    if (rNodeAnim)
-    {
-        Transform lTransform;
+        AnimationClip::Channel lChannel;
+        lChannel.node = lNode->second;
 
-        // Interpolate scaling and generate scaling transformation matrix
-        aiVector3D lScaling = _interpolatedScaling(pAnimationTime, rNodeAnim);
-        lTransform.scaling(lScaling.x, lScaling.y, lScaling.z);
+        lChannel.positionTimes.reserve(rNodeAnim->mNumPositionKeys);
+        lChannel.positions.reserve(rNodeAnim->mNumPositionKeys);
 
-        // Interpolate rotation and generate rotation transformation matrix
-        aiQuaternion lRotationQ = _interpolatedRotation(pAnimationTime, rNodeAnim);
+        for (unsigned int j = 0; j < rNodeAnim->mNumPositionKeys; ++j)
+        {
+            const aiVectorKey & rKey = rNodeAnim->mPositionKeys[j];
+            lChannel.positionTimes.push_back(static_cast<float>(rKey.mTime));
+            lChannel.positions.push_back(vec3f({rKey.mValue.x, rKey.mValue.y, rKey.mValue.z}));
+        }
 
-        auto lTmpRotation = lRotationQ.GetMatrix();
-        mat4f lRotationMatrix(1.0f);
+        lChannel.rotationTimes.reserve(rNodeAnim->mNumRotationKeys);
+        lChannel.rotations.reserve(rNodeAnim->mNumRotationKeys);
 
-        lRotationMatrix(0,0) = lTmpRotation.a1; lRotationMatrix(0,1) = lTmpRotation.a2; lRotationMatrix(0,2) = lTmpRotation.a3;
-        lRotationMatrix(1,0) = lTmpRotation.b1; lRotationMatrix(1,1) = lTmpRotation.b2; lRotationMatrix(1,2) = lTmpRotation.b3;
-        lRotationMatrix(2,0) = lTmpRotation.c1; lRotationMatrix(2,1) = lTmpRotation.c2; lRotationMatrix(2,2) = lTmpRotation.c3;
+        for (unsigned int j = 0; j < rNodeAnim->mNumRotationKeys; ++j)
+        {
+            const aiQuatKey & rKey = rNodeAnim->mRotationKeys[j];
+            lChannel.rotationTimes.push_back(static_cast<float>(rKey.mTime));
+            lChannel.rotations.push_back(quatf(rKey.mValue.x, rKey.mValue.y, rKey.mValue.z, rKey.mValue.w));
+        }
 
-        lTransform.rotation(lRotationMatrix);
+        lChannel.scalingTimes.reserve(rNodeAnim->mNumScalingKeys);
+        lChannel.scalings.reserve(rNodeAnim->mNumScalingKeys);
 
-        // Interpolate translation and generate translation transformation matrix
-        aiVector3D lTranslation = _interpolatedPosition(pAnimationTime, rNodeAnim);
-        lTransform.translation(lTranslation.x, lTranslation.y, lTranslation.z);
+        for (unsigned int j = 0; j < rNodeAnim->mNumScalingKeys; ++j)
+        {
+            const aiVectorKey & rKey = rNodeAnim->mScalingKeys[j];
+            lChannel.scalingTimes.push_back(static_cast<float>(rKey.mTime));
+            lChannel.scalings.push_back(vec3f({rKey.mValue.x, rKey.mValue.y, rKey.mValue.z}));
+        }
 
-        // Combine all the transformations
-        lNodeTransformation = lTransform.final();
+        lClip.addChannel(std::move(lChannel));
     }
 
-    mat4f lGlobalTransformation = pParentTransform * lNodeTransformation;
+    return lClip;
+}
 
-    if (mBoneMapping.find(lNodeName) != mBoneMapping.end())
-    {
-        unsigned int lBoneIndex = mBoneMapping[lNodeName];
-        mBoneInfo[lBoneIndex].finalTransformation = mGlobalInverseTransform * lGlobalTransformation * mBoneInfo[lBoneIndex].boneOffset;
-    }
+void MeshBoneData::_loadNodeHierarchy(const aiNode* pNode, int pParent)
+{
+    const unsigned int lIndex = mSkeleton.addNode(pParent, _convertMatrix(pNode->mTransformation));
+
+    mNodeMapping[string(pNode->mName.data)] = lIndex;
 
     for (unsigned int i = 0; i < pNode->mNumChildren; ++i)
-        _readNodeHierarchy(pScene, pAnimationTime, pNode->mChildren[i], lGlobalTransformation);
+        _loadNodeHierarchy(pNode->mChildren[i], static_cast<int>(lIndex));
 }
 
 mat4f MeshBoneData::_convertMatrix(const aiMatrix4x4 & pMat) const
@@ -10,6 +10,7 @@
 
 #include <vector>
 #include <map>
+#include <string>
 
 #include <GL/glew.h>
 
@@ -19,103 +20,130 @@
 
 #include "Algebra.hpp"
 #include "VertexBoneData.hpp"
+#include "PackedBoneData.hpp"
+#include "AnimationCursor.hpp"
+#include "AnimationClip.hpp"
+#include "CompressedClip.hpp"
+#include "Skeleton.hpp"
 
 namespace miniGL
 {
     /*!
      *  \brief This class encapsulate all the bone processing in a mesh for skinning
-     *  \details This class is based on the Assimp library
+     *  \details The bones, the node hierarchy and the animations are read from an Assimp scene at load time
+     *           and converted to a Skeleton and CompressedClips, so that the scene can be released afterwards.
+     *           boneTransform plays the first animation, the others are sampled and blended with LocalPose.
      */
     class MeshBoneData
     {
     public:
         /*!
          *  \brief Get all the transformations associated to each bones for the current time
-         *  @param pScene is a pointer of the Assimp scene
          *  @param pTime is in seconds
          *  @param pTransforms contains all the current transformation matrices
          */
-        void boneTransform(const aiScene * pScene, float pTime, std::vector<mat4f> & pTransforms);
+        void boneTransform(float pTime, std::vector<mat4f> & pTransforms);
 
         /*!
-         *  \brief Interpolate the scaling vector according to the current time stamp
-         *  @param pOut is the interpolated scaling vector
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
+         *  \brief Get all the transformations associated to each bones for the current time
+         *  @param pTime is in seconds
+         *  @param pTransforms contains all the current transformation matrices
+         *  @param pCursor keeps the keys used during the previous call for the same animated instance
+         *  @param pNodeTransforms is a buffer owned by the caller for the global transformation of each node, it is not reallocated once it has the right size
          */
-        void loadBones(unsigned int pMeshEntryBaseVertex, const aiMesh* pMesh, std::vector<VertexBoneData<4>> & pBones);
+        void boneTransform(float pTime, std::vector<mat4f> & pTransforms, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms) const;
 
         /*!
-         *  \brief Get the number of bones in the mesh
-         *  @return the number of bones in the mesh
+         *  \brief Load the bones of a mesh entry and the bone weights of its vertices
+         *  @param pMeshEntryBaseVertex is the index of the first vertex of the mesh entry
+         *  @param pMesh is the Assimp mesh of the entry
+         *  @param pBones contains the bone indices and weights of each vertex, the SIZE strongest bones are kept and their weights normalized
          */
-        unsigned int boneCount(void) const noexcept;
+        template <unsigned int SIZE>
+        void loadBones(unsigned int pMeshEntryBaseVertex, const aiMesh* pMesh, std::vector<VertexBoneData<SIZE>> & pBones);
 
         /*!
-         *  \brief Set the global inverse transform
-         *  @return pTransform is the root node transformation (that
-         *          will be inversed and stored as the global inverse transform)
+         *  \brief Set the number of bones kept per vertex in the buffers sent to the GPU, before loading the mesh
+         *  @param pCount is 4 or 8
          */
-        void globalInverseTransform(const aiMatrix4x4 & pTransform);
+        void boneInfluences(unsigned int pCount);
 
-    private:
         /*!
-         *  \brief Helper method to interpolate the scaling vector according to the current time stamp
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
-         *  @param pNodeAnim ????????????????????
-         *  @return the interpolated scaling vector
+         *  \brief Get the number of bones kept per vertex in the buffers sent to the GPU
+         *  @return 4 or 8
          */
-        aiVector3D _interpolatedScaling(float pAnimationTime, const aiNodeAnim * pNodeAnim);
+        unsigned int boneInfluences(void) const noexcept;
 
         /*!
-         *  \brief Helper method to interpolate the rotation according to the current time stamp
-         *  @param pOut is the interpolated rotation quaternion
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
-         *  @param pNodeAnim ????????????????????
+         *  \brief Get the size of the bone IDs and weights in the buffers sent to the GPU
+         *  @return 8 or 16 bits, see PackedBoneData
          */
-        aiQuaternion _interpolatedRotation(float pAnimationTime, const aiNodeAnim * pNodeAnim);
+        unsigned int boneIndexBits(void) const noexcept;
 
         /*!
-         *  \brief Interpolate the position vector according to the current time stamp
-         *  @param pOut is the interpolated position vector
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
-         *  @param pNodeAnim ????????????????????
+         *  \brief Copy the node hierarchy and the animations of the scene. It must be called after loading
+         *         the bones of all the mesh entries, the scene is not used anymore after this call.
+         *  @param pScene is a pointer of the Assimp scene
+         */
+        void loadSkeleton(const aiScene * pScene);
+
+        /*!
+         *  \brief Remove the bones, the hierarchy and the animation
          */
-        aiVector3D _interpolatedPosition(float pAnimationTime, const aiNodeAnim * pNodeAnim);
+        void clearBones(void);
 
         /*!
-         *  \brief
-         *  @param pOut is the interpolated scaling vector
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
+         *  \brief Get the number of bones in the mesh
+         *  @return the number of bones in the mesh
          */
-        unsigned int _findScaling(float pAnimationTime, const aiNodeAnim * pNodeAnim);
+        unsigned int boneCount(void) const noexcept;
 
         /*!
-         *  \brief
-         *  @param pOut is the interpolated scaling vector
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
+         *  \brief Get the skeleton of the mesh (read only)
+         *  @return a const reference on the skeleton
          */
-        unsigned int _findRotation(float pAnimationTime, const aiNodeAnim * pNodeAnim);
+        const Skeleton & skeleton(void) const noexcept;
 
         /*!
-         *  \brief
-         *  @param pOut is the interpolated scaling vector
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
+         *  \brief Get the animation of the mesh (read only)
+         *  @return a const reference on the compressed animation clip
          */
-        unsigned int _findPosition(float pAnimationTime, const aiNodeAnim * pNodeAnim);
+        const CompressedClip & animationClip(void) const noexcept;
 
         /*!
-         *  \brief Interpolate the scaling vector according to the current time stamp
-         *  @param pOut is the interpolated scaling vector
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
+         *  \brief Get the number of animations of the mesh
+         *  @return the number of animation clips, at least 1
          */
-        const aiNodeAnim* _findNodeAnim(const aiAnimation* pAnimation, const std::string & pNodeName);
+        unsigned int animationClipCount(void) const noexcept;
 
         /*!
-         *  \brief Interpolate the scaling vector according to the current time stamp
-         *  @param pOut is the interpolated scaling vector
-         *  @param pAnimationTime is the current time stamp used to interpolate the scaling
+         *  \brief Get one of the animations of the mesh (read only)
+         *  @param pIndex is the index of the animation in the file
+         *  @return a const reference on the compressed animation clip
          */
-        void _readNodeHierarchy(const aiScene * pScene, float pAnimationTime, const aiNode* pNode, const mat4f & pParentTransform);
+        const CompressedClip & animationClip(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Find a node of the skeleton by name
+         *  @param pName is the name of the node in the file
+         *  @return the index of the node in the skeleton, or -1 if there is no node with this name
+         */
+        int nodeIndex(const std::string & pName) const;
+
+    private:
+        /*!
+         *  \brief Helper method to convert an Assimp animation, before compressing it
+         *  @param pAnimation is the animation to convert
+         *  @return a clip whose channels reference the nodes of the skeleton
+         */
+        AnimationClip _loadAnimation(const aiAnimation * pAnimation) const;
+
+        /*!
+         *  \brief Helper method to add a node and its children to the skeleton
+         *  @param pNode is the current node in the Assimp hierarchy
+         *  @param pParent is the index of the parent node in the skeleton, or -1 for the root node
+         */
+        void _loadNodeHierarchy(const aiNode* pNode, int pParent);
 
         /*!
          *  \brief Convert from aiMatrix4x4 to mat4f
@@ -125,17 +153,49 @@ namespace miniGL
         mat4f _convertMatrix(const aiMatrix4x4 & pMat) const;
 
     private:
-        struct BoneInfo
-        {
-            mat4f boneOffset;
-            mat4f finalTransformation;
-        };
-
         std::map<std::string, unsigned int> mBoneMapping;
-        unsigned int mBoneCount = 0;
-        std::vector<BoneInfo> mBoneInfo;
-        mat4f mGlobalInverseTransform;
+        unsigned int mBoneInfluences = 4;
+        std::map<std::string, unsigned int> mNodeMapping;
+        Skeleton mSkeleton;
+        std::vector<CompressedClip> mClips = std::vector<CompressedClip>(1);
+        AnimationCursor mCursor;
+        std::vector<mat4f> mNodeTransforms;
 
     }; // class MeshBoneData
 
+    template <unsigned int SIZE>
+    void MeshBoneData::loadBones(unsigned int pMeshEntryBaseVertex, const aiMesh* pMesh, std::vector<VertexBoneData<SIZE>> & pBones)
+    {
+        for (unsigned int i = 0; i < pMesh->mNumBones; ++i)
+        {
+            unsigned int lBoneIndex = 0;
+            std::string lBoneName(pMesh->mBones[i]->mName.data);
+
+            if (mBoneMapping.find(lBoneName) == mBoneMapping.end())
+            {
+                // Allocate an index for a new bone and copy its offset matrix
+                lBoneIndex = mSkeleton.addBone(_convertMatrix(pMesh->mBones[i]->mOffsetMatrix));
+
+                mBoneMapping[lBoneName] = lBoneIndex;
+            }
+            else
+                lBoneIndex = mBoneMapping[lBoneName];
+
+            for (unsigned int j = 0; j < pMesh->mBones[i]->mNumWeights; ++j)
+            {
+                const unsigned int lVertexID = pMeshEntryBaseVertex + pMesh->mBones[i]->mWeights[j].mVertexId;
+                const float lWeight = pMesh->mBones[i]->mWeights[j].mWeight;
+
+                pBones[lVertexID].addBoneData(lBoneIndex, lWeight);
+            }
+        }
+
+        // The weights of the dropped bones are shared between the remaining ones
+        if (pMesh->mNumBones > 0)
+        {
+            for (unsigned int i = 0; i < pMesh->mNumVertices; ++i)
+                pBones[pMeshEntryBaseVertex + i].normalize();
+        }
+    }
+
 } // namespace miniGL
@@ -0,0 +1,141 @@
+//===============================================================================================//
+/*!
+ *  \file      MeshRegistry.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "MeshRegistry.hpp"
+
+#include <cassert>
+#include <limits>
+
+using std::vector;
+using std::string;
+using std::numeric_limits;
+using miniGL::MeshHandle;
+using miniGL::MeshRegistry;
+using miniGL::MeshSelection;
+using miniGL::MeshAndTransform;
+using miniGL::JobSystem;
+
+MeshHandle MeshRegistry::invalidHandle(void) noexcept
+{
+    return numeric_limits<MeshHandle>::max();
+}
+
+MeshHandle MeshRegistry::add(const string & pName, const MeshAndTransform & pMesh)
+{
+    const MeshHandle lHandle = static_cast<MeshHandle>(mMeshes.size());
+
+    if (!mHandles.emplace(pName, lHandle).second)
+        return invalidHandle();
+
+    mMeshes.push_back(pMesh);
+    mNames.push_back(pName);
+
+    return lHandle;
+}
+
+MeshHandle MeshRegistry::handle(const string & pName) const
+{
+    const auto it = mHandles.find(pName);
+
+    return it != mHandles.end() ? it->second : invalidHandle();
+}
+
+const string & MeshRegistry::name(MeshHandle pHandle) const
+{
+    assert(pHandle < mNames.size() && "Invalid mesh handle");
+
+    return mNames[pHandle];
+}
+
+MeshAndTransform & MeshRegistry::operator[](MeshHandle pHandle)
+{
+    assert(pHandle < mMeshes.size() && "Invalid mesh handle");
+
+    return mMeshes[pHandle];
+}
+
+const MeshAndTransform & MeshRegistry::operator[](MeshHandle pHandle) const
+{
+    assert(pHandle < mMeshes.size() && "Invalid mesh handle");
+
+    return mMeshes[pHandle];
+}
+
+unsigned int MeshRegistry::size(void) const noexcept
+{
+    return static_cast<unsigned int>(mMeshes.size());
+}
+
+void MeshRegistry::updateTransforms(const mat4f & pViewProjection, JobSystem* pJobSystem)
+{
+    for (auto & rMesh : mMeshes)
+        rMesh.transform.update(pViewProjection, pJobSystem);
+}
+
+vector<MeshAndTransform>::iterator MeshRegistry::begin(void) noexcept
+{
+    return mMeshes.begin();
+}
+
+vector<MeshAndTransform>::iterator MeshRegistry::end(void) noexcept
+{
+    return mMeshes.end();
+}
+
+void MeshSelection::add(const string & pName)
+{
+    mNames.push_back(pName);
+    mRegistry = nullptr;
+}
+
+void MeshSelection::clear(void)
+{
+    mNames.clear();
+    mHandles.clear();
+    mMeshes.clear();
+    mRegistry = nullptr;
+}
+
+const vector<string> & MeshSelection::names(void) const noexcept
+{
+    return mNames;
+}
+
+const vector<MeshHandle> & MeshSelection::handles(const MeshRegistry & pRegistry)
+{
+    // Only look for the names again if something changed since the last call
+    if (mRegistry != & pRegistry || mRegistrySize != pRegistry.size())
+    {
+        mHandles.clear();
+
+        for (const auto & rName : mNames)
+        {
+            const MeshHandle lHandle = pRegistry.handle(rName);
+
+            if (lHandle != MeshRegistry::invalidHandle())
+                mHandles.push_back(lHandle);
+        }
+
+        mRegistry = & pRegistry;
+        mRegistrySize = pRegistry.size();
+    }
+
+    return mHandles;
+}
+
+const vector<const MeshAndTransform*> & MeshSelection::meshes(const MeshRegistry & pRegistry)
+{
+    const auto & rHandles = handles(pRegistry);
+
+    mMeshes.resize(rHandles.size());
+
+    for (unsigned int i = 0; i < rHandles.size(); ++i)
+        mMeshes[i] = & pRegistry[rHandles[i]];
+
+    return mMeshes;
+}
@@ -0,0 +1,154 @@
+//===============================================================================================//
+/*!
+ *  \file      MeshRegistry.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+#include "MeshAndTransform.hpp"
+
+namespace miniGL
+{
+    //! Index of a mesh in a MeshRegistry, it stays valid for the whole life of the registry
+    using MeshHandle = unsigned int;
+
+    /*!
+     *  \brief   This class stores all the meshes of the scene with their transforms
+     *  \details The meshes are stored contiguously and referenced by integer handles. The names are only used to find a
+     *           handle, once at init, so that the traversal of the scene in each frame does not compare any string.
+     *           Meshes cannot be removed, so a handle never changes. References to the meshes are invalidated by add,
+     *           keep the handles instead.
+     */
+    class MeshRegistry
+    {
+    public:
+        /*!
+         *  \brief Get the value used for a name that is not in the registry
+         *  @return the invalid handle
+         */
+        static MeshHandle invalidHandle(void) noexcept;
+
+        /*!
+         *  \brief Add a mesh to the registry
+         *  @param pName is the name of the mesh, it must be unique
+         *  @param pMesh contains the mesh and its transforms
+         *  @return the handle of the new mesh, or invalidHandle() if there is already a mesh with this name
+         */
+        MeshHandle add(const std::string & pName, const MeshAndTransform & pMesh);
+
+        /*!
+         *  \brief Find a mesh by name
+         *  @param pName is the name used in add
+         *  @return the handle of the mesh, or invalidHandle() if there is no mesh with this name
+         */
+        MeshHandle handle(const std::string & pName) const;
+
+        /*!
+         *  \brief Get the name of a mesh
+         *  @param pHandle is a valid handle
+         *  @return the name used in add
+         */
+        const std::string & name(MeshHandle pHandle) const;
+
+        /*!
+         *  \brief Get a mesh and its transforms
+         *  @param pHandle is a valid handle
+         *  @return a reference on the mesh, valid until the next call to add
+         */
+        MeshAndTransform & operator[](MeshHandle pHandle);
+
+        /*!
+         *  \brief Get a mesh and its transforms (read only)
+         *  @param pHandle is a valid handle
+         *  @return a reference on the mesh, valid until the next call to add
+         */
+        const MeshAndTransform & operator[](MeshHandle pHandle) const;
+
+        /*!
+         *  \brief Get the number of meshes
+         *  @return the number of meshes added to the registry
+         */
+        unsigned int size(void) const noexcept;
+
+        /*!
+         *  \brief Compute the world and world-view-projection matrices of the transforms modified since the last call
+         *  @param pViewProjection is the product projection * view of the camera
+         *  @param pJobSystem splits the transforms of each mesh between several threads, or nullptr to use the calling thread
+         */
+        void updateTransforms(const mat4f & pViewProjection, JobSystem* pJobSystem = nullptr);
+
+        /*!
+         *  \brief Iterate over all the meshes
+         *  @return an iterator on the first mesh
+         */
+        std::vector<MeshAndTransform>::iterator begin(void) noexcept;
+
+        /*!
+         *  \brief Iterate over all the meshes
+         *  @return an iterator after the last mesh
+         */
+        std::vector<MeshAndTransform>::iterator end(void) noexcept;
+
+    private:
+        std::vector<MeshAndTransform> mMeshes;
+        std::vector<std::string> mNames;
+        std::unordered_map<std::string, MeshHandle> mHandles;
+
+    }; // class MeshRegistry
+
+    /*!
+     *  \brief   This class contains a list of mesh names resolved to handles in a MeshRegistry
+     *  \details The names are resolved the first time the meshes are requested, and again only if a name or a mesh is
+     *           added. The names that are not in the registry are ignored.
+     */
+    class MeshSelection
+    {
+    public:
+        /*!
+         *  \brief Add the name of a mesh
+         *  @param pName is the name of the mesh in the registry
+         */
+        void add(const std::string & pName);
+
+        /*!
+         *  \brief Remove all the names
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Get the names of the meshes
+         *  @return a reference on the names, in the order of add
+         */
+        const std::vector<std::string> & names(void) const noexcept;
+
+        /*!
+         *  \brief Get the handles of the meshes
+         *  @param pRegistry contains the meshes
+         *  @return a reference on the handles of the meshes found in pRegistry
+         */
+        const std::vector<MeshHandle> & handles(const MeshRegistry & pRegistry);
+
+        /*!
+         *  \brief Get the meshes
+         *  @param pRegistry contains the meshes
+         *  @return a reference on pointers to the meshes found in pRegistry, valid until the next call to MeshRegistry::add
+         */
+        const std::vector<const MeshAndTransform*> & meshes(const MeshRegistry & pRegistry);
+
+    private:
+        std::vector<std::string> mNames;
+        std::vector<MeshHandle> mHandles;
+        std::vector<const MeshAndTransform*> mMeshes;
+        const MeshRegistry* mRegistry = nullptr;
+        unsigned int mRegistrySize = 0;
+
+    }; // class MeshSelection
+
+} // namespace miniGL
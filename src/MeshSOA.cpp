@@ -10,6 +10,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <algorithm>
 
 #include "Constants.hpp"
 #include "Exceptions.hpp"
@@ -17,6 +18,10 @@
 #include "EnumClassCast.hpp"
 #include "GLUtils.hpp"
 #include "Transform.hpp"
+#include "GLStateCache.hpp"
+
+// Number of instanced draw calls of a mesh per frame before its ring buffer of draw commands grows
+#define MESH_SOA_RING_DRAWS 8
 
 using std::vector;
 using std::string;
@@ -29,7 +34,13 @@ using miniGL::Constants;
 using miniGL::Exceptions;
 using miniGL::Transform;
 using miniGL::CallbacksRender;
+using miniGL::DrawList;
+using miniGL::DrawPacket;
 using miniGL::VertexBoneData;
+using miniGL::PackedBoneData;
+using miniGL::GLStateCache;
+using miniGL::DynamicRingBuffer;
+using miniGL::StaticBatchBuilder;
 
 MeshSOA::MeshSOA(void)
 :MeshBase()
@@ -63,19 +74,23 @@ bool MeshSOA::load(const char* pFile, MeshBase::EOptions pOptions)
 
     string lFilename(pFile);
 
+    // The importer owns the scene: everything needed at runtime is copied before it goes out of scope
+    Importer lImporter;
+    const aiScene* lScene = nullptr;
+
     switch (pOptions)
     {
         case EOptions::UNSET:
         case EOptions::INSTANCE_RENDERING:
-            mScene = mImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs);
+            lScene = lImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs);
             break;
 
         case EOptions::COMPUTE_TANGENT_SPACE:
-            mScene = mImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+            lScene = lImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
             break;
 
         case EOptions::ADJACENCIES:
-            mScene = mImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
+            lScene = lImporter.ReadFile(lFilename.c_str(), aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
             mWithAdjacencies = true;
             break;
 
@@ -85,13 +100,13 @@ bool MeshSOA::load(const char* pFile, MeshBase::EOptions pOptions)
     }
 
 
-    if(!mScene)
-        throw Exceptions(mImporter.GetErrorString(), __FILE__, __LINE__);
+    if(!lScene)
+        throw Exceptions(lImporter.GetErrorString(), __FILE__, __LINE__);
 
-    // Copy root node transformation as inverse transformation
-    MeshBoneData::globalInverseTransform(mScene->mRootNode->mTransformation);
+    bool lResult = _initFromScene(lScene, lFilename);
 
-    bool lResult = _initFromScene(mScene, lFilename);
+    // Copy the hierarchy and the animation once the bones of all the entries are known
+    MeshBoneData::loadSkeleton(lScene);
 
     unbindVAO();
 
@@ -100,7 +115,15 @@ bool MeshSOA::load(const char* pFile, MeshBase::EOptions pOptions)
 
 void MeshSOA::render(EPrimitiveType pPrimitive, CallbacksRender* pRenderCallbacks)
 {
-    glFrontFace(mOrientation);
+    GLStateCache::frontFace(mOrientation);
+
+    // All the entries share the same buffers, only the callbacks need a draw call per entry
+    if (pPrimitive == EPrimitiveType::TRIANGLE && pRenderCallbacks == nullptr)
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mBuffers[toUT(EAttributes::DRAW_COMMAND_BUFFER)]);
+        _drawIndirect(mWithAdjacencies ? GL_TRIANGLES_ADJACENCY : GL_TRIANGLES, 0);
+        return;
+    }
 
     for (unsigned int i = 0; i < mEntries.size(); ++i)
     {
@@ -143,7 +166,7 @@ void MeshSOA::render(unsigned int pDrawIndex, unsigned int pPrimitiveIndex)
     /** \todo Method not tested yet */
     assert(pDrawIndex < mEntries.size() && "Wrong index ");
 
-    glFrontFace(mOrientation);
+    GLStateCache::frontFace(mOrientation);
 
     bindVAO(pDrawIndex);
     glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(pPrimitiveIndex * 3 * sizeof(GLuint)));
@@ -152,29 +175,144 @@ void MeshSOA::render(unsigned int pDrawIndex, unsigned int pPrimitiveIndex)
 
 void MeshSOA::render(unsigned int pCount, const mat4f* pWVPs, const mat4f* pWorlds)
 {
-    glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::WVP_MATRIX_INSTANCED_VERTEX_BUFFER)]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(mat4f) * pCount, pWVPs, GL_DYNAMIC_DRAW);
+    const GLuint lBaseInstance = uploadInstances(pCount, pWVPs, pWorlds);
 
-    glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::WORLD_MATRIX_INSTANCED_VERTEX_BUFFER)]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(mat4f) * pCount, pWorlds, GL_DYNAMIC_DRAW);
+    GLStateCache::frontFace(mOrientation);
 
-    glFrontFace(mOrientation);
+    // Same commands as the static ones, with the instances of this draw call
+    const DynamicRingBuffer::Allocation lAllocation = mInstancedCommands.allocate(sizeof(DrawCommand) * mDrawOrder.size(), sizeof(GLuint));
+    DrawCommand* rCommands = static_cast<DrawCommand*>(lAllocation.data);
 
-    for (unsigned int i = 0; i < mEntries.size(); ++i)
+    for (unsigned int i = 0; i < mDrawOrder.size(); ++i)
     {
-        bindVAO(i);
+        const MeshEntry & rEntry = mEntries[mDrawOrder[i]];
+        rCommands[i] = DrawCommand{ rEntry.numIndices, pCount, rEntry.baseIndex, rEntry.baseVertex, lBaseInstance };
+    }
 
+    mInstancedCommands.commit(lAllocation);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, lAllocation.buffer);
+    _drawIndirect(mWithAdjacencies ? GL_TRIANGLES_ADJACENCY : GL_TRIANGLES, lAllocation.offset);
+}
+
+void MeshSOA::record(DrawList::Recorder & pRecorder, DrawPacket pPacket) const
+{
+    pPacket.topology = mWithAdjacencies ? GL_TRIANGLES_ADJACENCY : GL_TRIANGLES;
+    pPacket.frontFace = mOrientation;
+
+    for (unsigned int i = 0; i < mEntries.size(); ++i)
+    {
         const unsigned int lMaterialIndex = mEntries[i].materialIndex;
 
-        assert(lMaterialIndex < mTextures.size() && "Material index out of boundaries in MeshSOA::render");
+        pPacket.vao = mVAOs[i];
+        pPacket.indexCount = mEntries[i].numIndices;
+        pPacket.baseIndex = mEntries[i].baseIndex;
+        pPacket.baseVertex = mEntries[i].baseVertex;
+        pPacket.colorTexture = lMaterialIndex < mTextures.size() && mTextures[lMaterialIndex] != nullptr ? mTextures[lMaterialIndex]->id() : 0;
 
-        if(lMaterialIndex < mTextures.size() && mTextures[lMaterialIndex] != nullptr)
-            mTextures[lMaterialIndex]->bind(COLOR_TEXTURE_UNIT);
+        pRecorder.draw(pPacket);
+    }
+}
+
+bool MeshSOA::batch(StaticBatchBuilder & pBuilder, const mat4f & pWorld) const
+{
+    // Only the vertices with a position, texture coordinates and a normal
+    if (mLoadOptions != EOptions::UNSET || mWithAdjacencies || MeshBoneData::boneCount() > 0 || mEntries.empty())
+        return false;
+
+    // The vertices are only on the GPU, they are read back once when building the batch. The copy target does not
+    // change the index buffer of the bound VAO.
+    GLint lSize = 0;
+    glBindBuffer(GL_COPY_READ_BUFFER, mBuffers[toUT(EAttributes::POSITION_VERTEX_BUFFER)]);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, & lSize);
+
+    const unsigned int lVertexCount = static_cast<unsigned int>(lSize / sizeof(vec3f));
+
+    vector<vec3f> lPositions(lVertexCount);
+    vector<vec2f> lTexCoords(lVertexCount);
+    vector<vec3f> lNormals(lVertexCount);
+    vector<unsigned int> lIndices(mEntries.back().baseIndex + mEntries.back().numIndices);
+
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(vec3f) * lVertexCount, lPositions.data());
+
+    glBindBuffer(GL_COPY_READ_BUFFER, mBuffers[toUT(EAttributes::TEXTURE_COORDINATE_VERTEX_BUFFER)]);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(vec2f) * lVertexCount, lTexCoords.data());
+
+    glBindBuffer(GL_COPY_READ_BUFFER, mBuffers[toUT(EAttributes::NORMAL_VERTEX_BUFFER)]);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(vec3f) * lVertexCount, lNormals.data());
+
+    glBindBuffer(GL_COPY_READ_BUFFER, mBuffers[toUT(EAttributes::INDEX_BUFFER)]);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(unsigned int) * lIndices.size(), lIndices.data());
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    checkOpenGLState;
 
-        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mEntries[i].numIndices, GL_UNSIGNED_INT, reinterpret_cast<void*>(sizeof(unsigned int) * mEntries[i].baseIndex), pCount, mEntries[i].baseVertex);
+    const unsigned int lBaseVertex = pBuilder.addVertices(lPositions.data(), lTexCoords.data(), lNormals.data(), lVertexCount, pWorld);
+
+    for (const MeshEntry & rEntry : mEntries)
+    {
+        const unsigned int lMaterialIndex = rEntry.materialIndex;
+        const GLuint lTexture = lMaterialIndex < mTextures.size() && mTextures[lMaterialIndex] != nullptr ? mTextures[lMaterialIndex]->id() : 0;
+
+        pBuilder.addTriangles(lIndices.data() + rEntry.baseIndex, rEntry.numIndices, lBaseVertex + rEntry.baseVertex, lTexture, mOrientation);
+    }
+
+    return true;
+}
+
+void MeshSOA::instanceAnimations(unsigned int pCount, const vec4f* pAnimations)
+{
+    assert(MeshBoneData::boneCount() > 0 && mLoadOptions == EOptions::INSTANCE_RENDERING && "Only the skinned meshes loaded for instance rendering have animated instances");
+
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::ANIMATION_INSTANCED_VERTEX_BUFFER)]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vec4f) * pCount, pAnimations, GL_DYNAMIC_DRAW);
+}
+
+void MeshSOA::skinOnCPU(const mat4f* pTransforms, JobSystem* pJobSystem)
+{
+    assert(MeshBoneData::boneCount() > 0 && "Only the meshes with bones can be skinned");
+
+    const bool lSkinned = pTransforms != nullptr;
+
+    if (lSkinned)
+    {
+        mCPUSkinning.skin(pTransforms, MeshBoneData::boneCount(), mSkinnedPositions.data(), mSkinnedNormals.data(), pJobSystem);
+
+        // Orphan the previous storage, so that the upload does not wait for the draw calls still reading it
+        const GLsizeiptr lSize = sizeof(vec3f) * mSkinnedPositions.size();
+
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::SKINNED_POSITION_VERTEX_BUFFER)]);
+        glBufferData(GL_ARRAY_BUFFER, lSize, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, lSize, mSkinnedPositions.data());
+
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::SKINNED_NORMAL_VERTEX_BUFFER)]);
+        glBufferData(GL_ARRAY_BUFFER, lSize, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, lSize, mSkinnedNormals.data());
+        checkOpenGLState;
+    }
+
+    if (lSkinned == mSkinnedOnCPU)
+        return;
+
+    // Switch the position and normal attributes of every entry between the bind pose and the skinned buffers
+    const GLuint lPositions = mBuffers[toUT(lSkinned ? EAttributes::SKINNED_POSITION_VERTEX_BUFFER : EAttributes::POSITION_VERTEX_BUFFER)];
+    const GLuint lNormals = mBuffers[toUT(lSkinned ? EAttributes::SKINNED_NORMAL_VERTEX_BUFFER : EAttributes::NORMAL_VERTEX_BUFFER)];
+
+    for (unsigned int i = 0; i < mVAOs.size(); ++i)
+    {
+        bindVAO(i);
+
+        glBindBuffer(GL_ARRAY_BUFFER, lPositions);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+        glBindBuffer(GL_ARRAY_BUFFER, lNormals);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, 0);
+        checkOpenGLState;
 
         unbindVAO();
     }
+
+    mSkinnedOnCPU = lSkinned;
 }
 
 void MeshSOA::clear(void)
@@ -203,6 +341,16 @@ void MeshSOA::clear(void)
     clearVAOs();
 
     mEntries.clear();
+    mDrawOrder.clear();
+    mDrawGroups.clear();
+    mInstancedCommands.clear();
+
+    MeshBoneData::clearBones();
+
+    mCPUSkinning.clear();
+    mSkinnedPositions.clear();
+    mSkinnedNormals.clear();
+    mSkinnedOnCPU = false;
 
     for (unsigned int i = 0; i < mBuffers.size(); ++i)
     {
@@ -223,7 +371,7 @@ bool MeshSOA::_initFromScene(const aiScene* pScene, const string & pFile)
     vector<vec3f> lNormals;
     vector<vec2f> lTexCoords;
     vector<vec3f> lTangents;
-    vector<VertexBoneData<4>> lBones;
+    vector<VertexBoneData<MAX_BONE_INFLUENCES>> lBones;
     vector<unsigned int> lIndices;
 
     unsigned int lVertexCount = 0;
@@ -306,63 +454,73 @@ bool MeshSOA::_initFromScene(const aiScene* pScene, const string & pFile)
             checkOpenGLState;
         }
 
-        // Add attributes for skinning if the model has bones
-        if (MeshBoneData::boneCount() > 0)
-        {
-            glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::BONE_VERTEX_BUFFER)]);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(VertexBoneData<4>) * lBones.size(), lBones.data(), GL_STATIC_DRAW);
-            glEnableVertexAttribArray(12);
-            glVertexAttribIPointer(12, 4, GL_INT, sizeof(VertexBoneData<4>), reinterpret_cast<const GLvoid*>(0));
-            glEnableVertexAttribArray(13);
-            glVertexAttribPointer(13, 4, GL_FLOAT, GL_FALSE, sizeof(VertexBoneData<4>), reinterpret_cast<const GLvoid*>(16));
-        }
-
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffers[toUT(EAttributes::INDEX_BUFFER)]);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * lIndices.size(), lIndices.data(), GL_STATIC_DRAW);
         checkOpenGLState;
 
-        if (mLoadOptions == MeshBase::EOptions::INSTANCE_RENDERING)
+        // Skinned instances read their pose from a baked animation texture, see BakedAnimation
+        if (mLoadOptions == MeshBase::EOptions::INSTANCE_RENDERING && MeshBoneData::boneCount() > 0)
         {
-            const GLuint lWVPLocation = 4;
-            const GLuint lWorldLocation = 8;
+            const GLuint lAnimationLocation = 14;
 
-            glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::WVP_MATRIX_INSTANCED_VERTEX_BUFFER)]);
+            glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::ANIMATION_INSTANCED_VERTEX_BUFFER)]);
+            glEnableVertexAttribArray(lAnimationLocation);
+            glVertexAttribPointer(lAnimationLocation, 4, GL_FLOAT, GL_FALSE, sizeof(vec4f), reinterpret_cast<GLvoid*>(0));
+            glVertexAttribDivisor(lAnimationLocation, 1);
+            checkOpenGLState;
+        }
 
-            for (GLuint i = 0; i < 4; ++i)
-            {
-                glEnableVertexAttribArray(lWVPLocation + i);
-                glVertexAttribPointer(lWVPLocation + i, 4, GL_FLOAT, GL_FALSE, sizeof(mat4f), reinterpret_cast<GLvoid*>(sizeof(GLfloat) * i * 4));
-                // The function glVertexAttribDivisor() is what makes this an instance data rather than vertex data. It takes two parameters - the first one is the vertex array attribute and the second tells OpenGL the rate by which the attribute advances during instanced rendering.
-                // It basically means the number of times the entire set of vertices is rendered before the attribute is updated from the buffer.
-                // By default, the divisor is zero. This causes regular vertex attributes to be updated from vertex to vertex. If the divisor is 10 it means that the first 10 instances will use the first piece of data from the buffer, the next 10 instances will use the second, etc.
-                // We want to have a dedicated WVP matrix for each instance so we use a divisor of 1. (http://ogldev.atspace.co.uk/www/tutorial33/tutorial33.html)
-                glVertexAttribDivisor(lWVPLocation + i, 1);
-                checkOpenGLState;
-            }
+        unbindVAO();
+    }
+
+    // The matrices of the instances are read at the same locations by all the instanced shaders
+    initInstanceStreams();
 
-            glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::WORLD_MATRIX_INSTANCED_VERTEX_BUFFER)]);
+    // Add attributes for skinning if the model has bones, once the number of bones of all the entries is known
+    if (MeshBoneData::boneCount() > 0)
+    {
+        PackedBoneData lPackedBones;
+        lPackedBones.pack(lBones, MeshBoneData::boneInfluences(), MeshBoneData::boneCount());
+
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[toUT(EAttributes::BONE_VERTEX_BUFFER)]);
+        glBufferData(GL_ARRAY_BUFFER, lPackedBones.byteSize(), lPackedBones.data(), GL_STATIC_DRAW);
+
+        // The shaders read the packed IDs and weights as 1 or 2 uvec4, see PackedBoneData
+        const GLsizei lStride = sizeof(GLuint) * lPackedBones.wordsPerVertex();
+
+        for (unsigned int i = 0; i < mEntries.size(); ++i)
+        {
+            bindVAO(i);
+
+            glEnableVertexAttribArray(12);
+            glVertexAttribIPointer(12, std::min(lPackedBones.wordsPerVertex(), 4u), GL_UNSIGNED_INT, lStride, reinterpret_cast<const GLvoid*>(0));
 
-            for (GLuint i = 0; i < 4; ++i)
+            if (lPackedBones.wordsPerVertex() > 4)
             {
-                // Note that unlike the other vertex attributes such as the position and the normal we don't upload any data into the buffers.
-                // The reason is that the WVP and world matrices are dynamic and will be updated every frame. (http://ogldev.atspace.co.uk/www/tutorial33/tutorial33.html)
-                glEnableVertexAttribArray(lWorldLocation + i);
-                glVertexAttribPointer(lWorldLocation + i, 4, GL_FLOAT, GL_FALSE, sizeof(mat4f), reinterpret_cast<GLvoid*>(sizeof(GLfloat) * i * 4));
-                glVertexAttribDivisor(lWorldLocation + i, 1);
-                checkOpenGLState;
+                glEnableVertexAttribArray(13);
+                glVertexAttribIPointer(13, 4, GL_UNSIGNED_INT, lStride, reinterpret_cast<const GLvoid*>(sizeof(GLuint) * 4));
             }
 
+            checkOpenGLState;
+            unbindVAO();
         }
 
-        unbindVAO();
+        // Keep the bind pose to deform the mesh on the CPU with skinOnCPU
+        mCPUSkinning.init(lPositions, lNormals, lPackedBones);
+        mSkinnedPositions = lPositions;
+        mSkinnedNormals = lNormals;
     }
 
+    _initDrawCommands();
+
+    initBounds(pScene);
+
     bool lResult = initMaterials(pScene, pFile);
 
     return lResult;
 }
 
-void MeshSOA::_initMesh(unsigned int pMeshIndex, const aiMesh* pMesh, vector<vec3f> & pPosition, vector<vec3f> & pNormals, vector<vec2f> & pTexCoords, vector<VertexBoneData<4>> & pBones, vector<unsigned int> & pIndices)
+void MeshSOA::_initMesh(unsigned int pMeshIndex, const aiMesh* pMesh, vector<vec3f> & pPosition, vector<vec3f> & pNormals, vector<vec2f> & pTexCoords, vector<VertexBoneData<MAX_BONE_INFLUENCES>> & pBones, vector<unsigned int> & pIndices)
 {
     const aiVector3D lZero3D(0.0f, 0.0f, 0.0f);
 
@@ -433,3 +591,73 @@ void MeshSOA::_initMesh(const aiMesh* pMesh, std::vector<vec3f> & pPosition, std
         pIndices.push_back(rFace.mIndices[2]);
     }
 }
+
+void MeshSOA::_initDrawCommands(void)
+{
+    mDrawOrder.resize(mEntries.size());
+
+    for (unsigned int i = 0; i < mEntries.size(); ++i)
+        mDrawOrder[i] = i;
+
+    // The entries of a material are drawn by the same multi draw call
+    std::stable_sort(mDrawOrder.begin(), mDrawOrder.end(), [this](unsigned int pA, unsigned int pB)
+    {
+        return mEntries[pA].materialIndex < mEntries[pB].materialIndex;
+    });
+
+    mDrawGroups.clear();
+
+    vector<DrawCommand> lCommands;
+    lCommands.reserve(mDrawOrder.size());
+
+    for (unsigned int i = 0; i < mDrawOrder.size(); ++i)
+    {
+        const MeshEntry & rEntry = mEntries[mDrawOrder[i]];
+
+        if (mDrawGroups.empty() || mDrawGroups.back().materialIndex != rEntry.materialIndex)
+            mDrawGroups.push_back(DrawGroup{ rEntry.materialIndex, i, 0 });
+
+        ++mDrawGroups.back().commandCount;
+
+        lCommands.push_back(DrawCommand{ rEntry.numIndices, 1, rEntry.baseIndex, rEntry.baseVertex, 0 });
+    }
+
+    // Commands of the draw calls without instances, they never change
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mBuffers[toUT(EAttributes::DRAW_COMMAND_BUFFER)]);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawCommand) * lCommands.size(), lCommands.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    checkOpenGLState;
+
+    mInstancedCommands.init(GL_DRAW_INDIRECT_BUFFER, std::max<GLsizeiptr>(sizeof(DrawCommand) * lCommands.size(), sizeof(DrawCommand)) * MESH_SOA_RING_DRAWS);
+}
+
+void MeshSOA::_drawIndirect(GLenum pTopology, GLintptr pOffset)
+{
+    static_assert(sizeof(DrawCommand) == 5 * sizeof(GLuint), "The draw commands must be tightly packed");
+
+    // Any VAO can draw all the entries, they read the same buffers
+    bindVAO(0);
+
+    for (const DrawGroup & rGroup : mDrawGroups)
+    {
+        assert(rGroup.materialIndex < mTextures.size() && "Material index out of boundaries in MeshSOA::render");
+
+        if (rGroup.materialIndex < mTextures.size() && mTextures[rGroup.materialIndex] != nullptr)
+            mTextures[rGroup.materialIndex]->bind(COLOR_TEXTURE_UNIT);
+
+        const GLintptr lOffset = pOffset + sizeof(DrawCommand) * rGroup.firstCommand;
+
+        // OpenGL 4.3, otherwise one indirect draw call per entry still avoids binding a VAO for each of them
+        if (GLEW_ARB_multi_draw_indirect)
+        {
+            glMultiDrawElementsIndirect(pTopology, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(lOffset), rGroup.commandCount, 0);
+        }
+        else
+        {
+            for (unsigned int i = 0; i < rGroup.commandCount; ++i)
+                glDrawElementsIndirect(pTopology, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(lOffset + sizeof(DrawCommand) * i));
+        }
+    }
+
+    unbindVAO();
+}
@@ -25,6 +25,7 @@
 #include "CallbacksRender.hpp"
 #include "Algebra.hpp"
 #include "VertexBoneData.hpp"
+#include "CPUSkinning.hpp"
 
 namespace miniGL
 {
@@ -71,6 +72,26 @@ namespace miniGL
          */
         virtual void render(unsigned int pCount, const mat4f* pWVPs, const mat4f* pWorlds) final;
 
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void record(DrawList::Recorder & pRecorder, DrawPacket pPacket) const final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase, only for the meshes loaded without option
+         */
+        virtual bool batch(StaticBatchBuilder & pBuilder, const mat4f & pWorld) const final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void instanceAnimations(unsigned int pCount, const vec4f* pAnimations) final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void skinOnCPU(const mat4f* pTransforms, JobSystem* pJobSystem = nullptr) final;
+
         /*!
          *  \brief Implementation of a virtual method from MeshBase
          */
@@ -81,11 +102,62 @@ namespace miniGL
          */
         virtual void boneTransform(float pTime, std::vector<mat4f> & pTransforms) final;
 
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void boneTransform(float pTime, std::vector<mat4f> & pTransforms, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms) final;
+
         /*!
          *  \brief Implementation of a virtual method from MeshBase
          */
         virtual unsigned int boneCount(void) const noexcept final;
 
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual void boneInfluences(unsigned int pCount) final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual unsigned int boneInfluences(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual unsigned int boneIndexBits(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual const Skeleton & skeleton(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual const CompressedClip & animationClip(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual unsigned int animationClipCount(void) const noexcept final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual const CompressedClip & animationClip(unsigned int pIndex) const final;
+
+        /*!
+         *  \brief Implementation of a virtual method from MeshBase
+         */
+        virtual int nodeIndex(const std::string & pName) const final;
+
+        /*!
+         *  \brief Get the positions computed by the last call to skinOnCPU, e.g. to update bounds or pick triangles on the CPU
+         *  @return a const reference on the deformed position of each vertex (empty if the mesh has no bones)
+         */
+        const std::vector<vec3f> & skinnedPositions(void) const noexcept;
+
     private:
         struct MeshEntry
         {
@@ -95,6 +167,24 @@ namespace miniGL
             unsigned int materialIndex;
         }; // struct MeshEntry
 
+        //! Layout of the commands read by glDrawElementsIndirect and glMultiDrawElementsIndirect
+        struct DrawCommand
+        {
+            GLuint count;
+            GLuint instanceCount;
+            GLuint firstIndex;
+            GLuint baseVertex;
+            GLuint baseInstance;
+        }; // struct DrawCommand
+
+        //! Consecutive draw commands of the entries sharing the same material
+        struct DrawGroup
+        {
+            unsigned int materialIndex;
+            unsigned int firstCommand;
+            unsigned int commandCount;
+        }; // struct DrawGroup
+
         enum class EAttributes
         {
             INDEX_BUFFER                            = 0,
@@ -102,9 +192,11 @@ namespace miniGL
             TEXTURE_COORDINATE_VERTEX_BUFFER        = 2,
             NORMAL_VERTEX_BUFFER                    = 3,
             TANGENT_VERTEX_BUFFER                   = 4,
-            WVP_MATRIX_INSTANCED_VERTEX_BUFFER      = 5,
-            WORLD_MATRIX_INSTANCED_VERTEX_BUFFER    = 6,
-            BONE_VERTEX_BUFFER                      = 7
+            BONE_VERTEX_BUFFER                      = 5,
+            ANIMATION_INSTANCED_VERTEX_BUFFER       = 6,
+            SKINNED_POSITION_VERTEX_BUFFER          = 7,
+            SKINNED_NORMAL_VERTEX_BUFFER            = 8,
+            DRAW_COMMAND_BUFFER                     = 9
         };
 
     private:
@@ -127,7 +219,7 @@ namespace miniGL
          *         to each vertex
          *  @param pIndices contain the list of indices to draw the vertices using draw elements
          */
-        void _initMesh(unsigned int pMeshIndex, const aiMesh* pMesh, std::vector<vec3f> & pPosition, std::vector<vec3f> & pNormals, std::vector<vec2f> & pTexCoords, std::vector<VertexBoneData<4>> & pBones, std::vector<unsigned int> & pIndices);
+        void _initMesh(unsigned int pMeshIndex, const aiMesh* pMesh, std::vector<vec3f> & pPosition, std::vector<vec3f> & pNormals, std::vector<vec2f> & pTexCoords, std::vector<VertexBoneData<MAX_BONE_INFLUENCES>> & pBones, std::vector<unsigned int> & pIndices);
 
         /*!
          *  \brief Helper method to load the vertices, indices and normals to openGL
@@ -139,15 +231,40 @@ namespace miniGL
          */
         void _initMesh(const aiMesh* pMesh, std::vector<vec3f> & pPosition, std::vector<vec3f> & pNormals, std::vector<vec2f> & pTexCoords, std::vector<vec3f> & pTangents, std::vector<unsigned int> & pIndices);
 
+        /*!
+         *  \brief Helper method to sort the entries by material and to create the buffer of their draw commands
+         */
+        void _initDrawCommands(void);
+
+        /*!
+         *  \brief Helper method to draw all the entries from the buffer bound to GL_DRAW_INDIRECT_BUFFER, with one
+         *         multi draw call per material
+         *  @param pTopology is the primitive type, e.g. GL_TRIANGLES
+         *  @param pOffset is the offset of the first command in the buffer, in bytes
+         */
+        void _drawIndirect(GLenum pTopology, GLintptr pOffset);
+
     private:
         std::vector<MeshEntry> mEntries;
-        std::array<GLuint, 8> mBuffers = {{0, 0, 0, 0, 0, 0, 0, 0}};
+        std::array<GLuint, 10> mBuffers = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+        std::vector<unsigned int> mDrawOrder;           //!< Index of the entry of each draw command, sorted by material
+        std::vector<DrawGroup> mDrawGroups;
+        DynamicRingBuffer mInstancedCommands;           //!< Draw commands of the instanced draw calls of each frame
+        CPUSkinning mCPUSkinning;
+        std::vector<vec3f> mSkinnedPositions;
+        std::vector<vec3f> mSkinnedNormals;
+        bool mSkinnedOnCPU = false;
 
     }; // class MeshSOA
 
     inline void MeshSOA::boneTransform(float pTime, std::vector<mat4f> & pTransforms)
     {
-        MeshBoneData::boneTransform(mScene, pTime, pTransforms);
+        MeshBoneData::boneTransform(pTime, pTransforms);
+    }
+
+    inline void MeshSOA::boneTransform(float pTime, std::vector<mat4f> & pTransforms, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms)
+    {
+        MeshBoneData::boneTransform(pTime, pTransforms, pCursor, pNodeTransforms);
     }
 
     inline unsigned int MeshSOA::boneCount(void) const noexcept
@@ -155,4 +272,49 @@ namespace miniGL
         return MeshBoneData::boneCount();
     }
 
+    inline void MeshSOA::boneInfluences(unsigned int pCount)
+    {
+        MeshBoneData::boneInfluences(pCount);
+    }
+
+    inline unsigned int MeshSOA::boneInfluences(void) const noexcept
+    {
+        return MeshBoneData::boneInfluences();
+    }
+
+    inline unsigned int MeshSOA::boneIndexBits(void) const noexcept
+    {
+        return MeshBoneData::boneIndexBits();
+    }
+
+    inline const Skeleton & MeshSOA::skeleton(void) const noexcept
+    {
+        return MeshBoneData::skeleton();
+    }
+
+    inline const CompressedClip & MeshSOA::animationClip(void) const noexcept
+    {
+        return MeshBoneData::animationClip();
+    }
+
+    inline unsigned int MeshSOA::animationClipCount(void) const noexcept
+    {
+        return MeshBoneData::animationClipCount();
+    }
+
+    inline const CompressedClip & MeshSOA::animationClip(unsigned int pIndex) const
+    {
+        return MeshBoneData::animationClip(pIndex);
+    }
+
+    inline int MeshSOA::nodeIndex(const std::string & pName) const
+    {
+        return MeshBoneData::nodeIndex(pName);
+    }
+
+    inline const std::vector<vec3f> & MeshSOA::skinnedPositions(void) const noexcept
+    {
+        return mSkinnedPositions;
+    }
+
 } // namespace miniGL
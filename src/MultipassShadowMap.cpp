@@ -45,6 +45,7 @@ void MultipassShadowMap::init(void)
     mWVPLocation = Program::uniformLocation("uWVP");
     mWorldLocation = Program::uniformLocation("uWorld");
     mLightWorldPositionLocation = Program::uniformLocation("uLightWorldPos");
+    mInstancedLocation = Program::uniformLocation("uInstanced");
 
     // Check if we correctly initialized the uniform variables
     if (!checkUniformLocations())
@@ -66,10 +67,16 @@ void MultipassShadowMap::lightPosition(const vec3f & pPos)
     glUniform3f(mLightWorldPositionLocation, pPos.x(), pPos.y(), pPos.z());
 }
 
+void MultipassShadowMap::instanced(bool pValue)
+{
+    glUniform1i(mInstancedLocation, pValue ? 1 : 0);
+}
+
 bool MultipassShadowMap::checkUniformLocations(void) const
 {
     return (mWVPLocation != Constants::invalidUniformLocation<GLuint>()               &&
             mWorldLocation != Constants::invalidUniformLocation<GLuint>()             &&
-            mLightWorldPositionLocation!= Constants::invalidUniformLocation<GLuint>() );
+            mLightWorldPositionLocation!= Constants::invalidUniformLocation<GLuint>() &&
+            mInstancedLocation != Constants::invalidUniformLocation<GLuint>()         );
 }
 
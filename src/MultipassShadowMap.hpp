@@ -46,6 +46,13 @@ namespace miniGL
          */
         void lightPosition(const vec3f & pPos);
 
+        /*!
+         *  \brief Choose where the vertex shader reads the matrices
+         *  @param pValue is true to read them from the instance streams of the mesh (see MeshBase::instancing),
+         *         false to read them from the uniforms
+         */
+        void instanced(bool pValue);
+
     protected:
         /*!
          *  \brief Implementation of a virtual method from Program
@@ -56,6 +63,7 @@ namespace miniGL
         GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mWorldLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mLightWorldPositionLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mInstancedLocation = Constants::invalidUniformLocation<GLuint>();
 
     }; // class MultipassShadowMap
 
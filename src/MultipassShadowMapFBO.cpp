@@ -13,45 +13,47 @@
 
 #include "GLUtils.hpp"
 #include "Exceptions.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::to_string;
 using miniGL::MultipassShadowMapFBO;
+using miniGL::GLStateCache;
 
 MultipassShadowMapFBO::~MultipassShadowMapFBO(void)
 {
     if (mFBO != 0)
-        glDeleteFramebuffers(1, & mFBO);
+        GLStateCache::deleteFramebuffers(1, & mFBO);
 
     if (mShadowMap != 0)
-        glDeleteTextures(1, & mShadowMap);
+        GLStateCache::deleteTextures(1, & mShadowMap);
 
     if (mDepth != 0)
-        glDeleteTextures(1, & mDepth);
+        GLStateCache::deleteTextures(1, & mDepth);
 }
 
 void MultipassShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
 {
     // Create the FBO
     glGenFramebuffers(1, & mFBO); checkOpenGLState;
-    glBindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
 
     auto lEdge = std::max(pWindowWidth, pWindowHeight);
 
     // Create the depth buffer
     glGenTextures(1, & mDepth); checkOpenGLState;
-    glBindTexture(GL_TEXTURE_2D, mDepth); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mDepth); checkOpenGLState;
     // Create the depth texture with same width and height to match the cube map, see below
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32, lEdge, lEdge, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL); checkOpenGLState;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); checkOpenGLState;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); checkOpenGLState;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); checkOpenGLState;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); checkOpenGLState;
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
 
     // Create the cubemap
     glGenTextures(1, & mShadowMap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, mShadowMap);
+    GLStateCache::bindTexture(GL_TEXTURE_CUBE_MAP, mShadowMap);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR); checkOpenGLState;
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR); checkOpenGLState;
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); checkOpenGLState;
@@ -81,18 +83,18 @@ void MultipassShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindow
         throw Exceptions(lMessage, __FILE__, __LINE__);
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0); checkOpenGLState;
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0); checkOpenGLState;
 }
 
 void MultipassShadowMapFBO::bindForWriting(GLenum pCubeFace)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, pCubeFace, mShadowMap, 0);
     glDrawBuffer(GL_COLOR_ATTACHMENT0);
 }
 
 void MultipassShadowMapFBO::bindForReading(GLenum pTextureUnit)
 {
-    glActiveTexture(pTextureUnit);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, mShadowMap);
+    GLStateCache::activeTexture(pTextureUnit);
+    GLStateCache::bindTexture(GL_TEXTURE_CUBE_MAP, mShadowMap);
 }
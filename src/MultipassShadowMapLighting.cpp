@@ -42,6 +42,7 @@ void MultipassShadowMapLighting::init(const string & pPathVS, const string & pPa
 
     mWVPLocation = Program::uniformLocation("uWVP");
     mWorldLocation = Program::uniformLocation("uWorld");
+    mInstancedLocation = Program::uniformLocation("uInstanced");
     mColorMapLocation = Program::uniformLocation("uSampler");
     mShadowMapLocation = Program::uniformLocation("uShadowMap");
     mEyeWorldPosLocation = Program::uniformLocation("uEyeWorldPos");
@@ -113,6 +114,11 @@ void MultipassShadowMapLighting::world(const mat4f & pWorld)
     glUniformMatrix4fv(mWorldLocation, 1, GL_TRUE, const_cast<mat4f&>(pWorld).data());
 }
 
+void MultipassShadowMapLighting::instanced(bool pValue)
+{
+    glUniform1i(mInstancedLocation, pValue ? 1 : 0);
+}
+
 void MultipassShadowMapLighting::eyeWorldPosition(const vec3f & pPos)
 {
     glUniform3f(mEyeWorldPosLocation, pPos.x(), pPos.y(), pPos.z());
@@ -152,6 +158,7 @@ bool MultipassShadowMapLighting::checkUniformLocations(void) const
 {
     bool lRes = (mWVPLocation != Constants::invalidUniformLocation<GLuint>()                       &&
                  mWorldLocation != Constants::invalidUniformLocation<GLuint>()                     &&
+                 mInstancedLocation != Constants::invalidUniformLocation<GLuint>()                 &&
                  mColorMapLocation != Constants::invalidUniformLocation<GLuint>()                  &&
                  mUseColorMapLocation != Constants::invalidUniformLocation<GLuint>()               &&
                  mUseNormalMapLocation != Constants::invalidUniformLocation<GLuint>()              &&
@@ -64,6 +64,13 @@ namespace miniGL
          */
         void world(const mat4f & pWorld);
 
+        /*!
+         *  \brief Choose where the vertex shader reads the matrices
+         *  @param pValue is true to read them from the instance streams of the mesh (see MeshBase::instancing),
+         *         false to read them from the uniforms
+         */
+        void instanced(bool pValue);
+
         /*!
          *  \brief Set the point of view in the scene
          *  @param pPos is the position of the camera
@@ -118,6 +125,7 @@ namespace miniGL
 
         GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mWorldLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mInstancedLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mColorMapLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mUseColorMapLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mUseNormalMapLocation = Constants::invalidUniformLocation<GLuint>();
@@ -10,8 +10,8 @@
 
 #include "EngineCommon.hpp"
 #include "GLUtils.hpp"
+#include "GLStateCache.hpp"
 
-using std::map;
 using std::vector;
 using std::string;
 using std::shared_ptr;
@@ -25,7 +25,9 @@ using std::numeric_limits;
 using miniGL::MultipassShadowMapTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
+using miniGL::GLStateCache;
 
 MultipassShadowMapTechnique::MultipassShadowMapTechnique(void)
 :RenderingTechniqueBase("MultipassShadowMapTechnique")
@@ -51,26 +53,27 @@ void MultipassShadowMapTechnique::init(unsigned int pPointLightCount, const tupl
 //    mMultipassShadowMap->use();
 
     // Setup opengl to use cube maps
-    glEnable(GL_TEXTURE_CUBE_MAP); checkOpenGLState;
+    GLStateCache::enable(GL_TEXTURE_CUBE_MAP); checkOpenGLState;
 }
 
-void MultipassShadowMapTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void MultipassShadowMapTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     // Find the meshes to render
-    auto lMeshReferences = findMeshesToRender(pMeshes);
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
 
     // Find the mesh representing the "floor"
-    auto lFloorIterator = pMeshes.find(mFloorMeshName);
-    assert(lFloorIterator != pMeshes.end());
+    const auto & rFloor = mFloorMesh.meshes(pMeshes);
+    assert(rFloor.size() == 1 && "The floor is not in the mesh registry");
 
     // Render the different elements
     _shadowPass(lMeshReferences, pLights);
-    _renderPass(lMeshReferences, lFloorIterator, pLights);
+    _renderPass(lMeshReferences, *rFloor[0], pLights);
 }
 
 void MultipassShadowMapTechnique::floor(const string & pName)
 {
-    mFloorMeshName = pName;
+    mFloorMesh.clear();
+    mFloorMesh.add(pName);
 }
 
 void MultipassShadowMapTechnique::pointLightIndex(unsigned int pIndex)
@@ -78,9 +81,9 @@ void MultipassShadowMapTechnique::pointLightIndex(unsigned int pIndex)
     mPointLightIndex = pIndex;
 }
 
-void MultipassShadowMapTechnique::_shadowPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, const vector<shared_ptr<BaseLight>> & pLights)
+void MultipassShadowMapTechnique::_shadowPass(const vector<const MeshAndTransform*> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
-    glCullFace(GL_FRONT);
+    GLStateCache::cullFace(GL_FRONT);
 
     mMultipassShadowMap->use();
 
@@ -114,30 +117,27 @@ void MultipassShadowMapTechnique::_shadowPass(vector<map<string, MeshAndTransfor
         lTmpCamera.lookAt(get<target>(lCameraDirections[i]));
         lTmpCamera.up(get<up>(lCameraDirections[i]));
 
-        for (auto it : pMeshIterators)
-        {
-            for (auto transformation : it->second.transform)
-            {
-                mat4f lWorld = transformation.final();
-                mat4f lWVP = lTmpCamera.projection() * lTmpCamera.view() * lWorld;
+        // Each face of the cube map only renders the meshes inside its own light frustum
+        const mat4f lLightViewProjection = lTmpCamera.viewProjection();
 
-                mMultipassShadowMap->WVP(lWVP);
-                mMultipassShadowMap->world(lWorld);
+        cull(pMeshes, lLightViewProjection, mVisibleTransforms);
 
-                it->second.mesh->render();
-            }
-        }
+        renderInstanced(mVisibleTransforms, lLightViewProjection, [this](bool pInstanced){ mMultipassShadowMap->instanced(pInstanced); }, [this](const mat4f & pWVP, const mat4f & pWorld)
+        {
+            mMultipassShadowMap->WVP(pWVP);
+            mMultipassShadowMap->world(pWorld);
+        });
     }
 }
 
-void MultipassShadowMapTechnique::_renderPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, map<string, MeshAndTransform>::const_iterator & pFloorIterator, const vector<shared_ptr<BaseLight>> & pLights)
+void MultipassShadowMapTechnique::_renderPass(const vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, const vector<shared_ptr<BaseLight>> & pLights)
 {
     /*! \bug The shadow is not correctly displayed if the window is not a square window (width = height) */
     /*! \bug The shadow is not correctly displayed if the light is moved toward the left or the right... */
 
-    glCullFace(GL_BACK);
+    GLStateCache::cullFace(GL_BACK);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
     // In the shadow pass, we have to set the clear color to max float to initialize the cube map, restore default value here
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
@@ -149,29 +149,27 @@ void MultipassShadowMapTechnique::_renderPass(vector<map<string, MeshAndTransfor
     mMultipassShadowMapLighting->updatePointLightState(static_pointer_cast<PointLight>(pLights.at(mPointLightIndex)));
 
     // Render the floor (and the wall)
-    for (auto transformation : pFloorIterator->second.transform)
+    mMultipassShadowMapLighting->instanced(false);
+
+    for (unsigned int j = 0; j < pFloor.transform.size(); ++j)
     {
-        mat4f lWorld = transformation.final();
-        mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+        mat4f lWorld = pFloor.transform.world(j);
+        mat4f lWVP = pFloor.transform.WVP(j);
 
         mMultipassShadowMapLighting->WVP(lWVP);
         mMultipassShadowMapLighting->world(lWorld);
 
-        pFloorIterator->second.mesh->render();
+        pFloor.mesh->render();
     }
 
     // Render the meshes
-    for (auto it : pMeshIterators)
-    {
-        for (auto transformation : it->second.transform)
-        {
-            mat4f lWorld = transformation.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    const mat4f lViewProjection = mCamera->viewProjection();
 
-            mMultipassShadowMapLighting->WVP(lWVP);
-            mMultipassShadowMapLighting->world(lWorld);
+    cull(pMeshes, lViewProjection, mVisibleTransforms);
 
-            it->second.mesh->render();
-        }
-    }
+    renderInstanced(mVisibleTransforms, lViewProjection, [this](bool pInstanced){ mMultipassShadowMapLighting->instanced(pInstanced); }, [this](const mat4f & pWVP, const mat4f & pWorld)
+    {
+        mMultipassShadowMapLighting->WVP(pWVP);
+        mMultipassShadowMapLighting->world(pWorld);
+    });
 }
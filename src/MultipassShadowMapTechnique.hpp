@@ -40,7 +40,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Set the name of the mesh representing the "floor"
@@ -59,18 +59,18 @@ namespace miniGL
         /*!
          *  \brief Helper method for the multipass shadow map render
          */
-        void _shadowPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void _shadowPass(const std::vector<const MeshAndTransform*> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Helper method for the multipass shadow map render
          */
-        void _renderPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::map<std::string, MeshAndTransform>::const_iterator & pFloorIterator, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void _renderPass(const std::vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
     private:
         std::unique_ptr<MultipassShadowMapFBO> mMultipassShadowMapFBO;
         std::unique_ptr<MultipassShadowMap> mMultipassShadowMap;
         std::unique_ptr<MultipassShadowMapLighting> mMultipassShadowMapLighting;
-        std::string mFloorMeshName;
+        MeshSelection mFloorMesh;
         unsigned int mPointLightIndex = Constants::invalidBufferIndex<unsigned int>();
 
     }; // class MultipassShadowMapTechnique
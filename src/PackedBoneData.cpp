@@ -0,0 +1,157 @@
+//===============================================================================================//
+/*!
+ *  \file      PackedBoneData.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "PackedBoneData.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <array>
+#include <algorithm>
+
+using std::vector;
+using std::array;
+using std::uint32_t;
+using miniGL::PackedBoneData;
+using miniGL::VertexBoneData;
+
+void PackedBoneData::pack(const vector<VertexBoneData<MAX_BONE_INFLUENCES>> & pBones, unsigned int pInfluences, unsigned int pBoneCount)
+{
+    assert((pInfluences == 4 || pInfluences == 8) && "The shaders read 4 or 8 bones per vertex");
+    assert(pBoneCount <= 65536 && "The bone IDs are stored on 16 bits at most");
+
+    mVertexCount = static_cast<unsigned int>(pBones.size());
+    mInfluences = pInfluences;
+    mIndexBits = indexBits(pBoneCount);
+
+    const unsigned int lWordsPerVertex = wordsPerVertex();
+    const unsigned int lMaxWeight = (1u << mIndexBits) - 1;
+
+    mWords.assign(mVertexCount * lWordsPerVertex, 0);
+
+    array<unsigned int, MAX_BONE_INFLUENCES> lOrder;
+
+    for (unsigned int i = 0; i < mVertexCount; ++i)
+    {
+        const VertexBoneData<MAX_BONE_INFLUENCES> & rBones = pBones[i];
+
+        // Keep the strongest bones
+        for (unsigned int j = 0; j < lOrder.size(); ++j)
+            lOrder[j] = j;
+
+        std::stable_sort(lOrder.begin(), lOrder.end(), [& rBones](unsigned int a, unsigned int b){ return rBones.weight(a) > rBones.weight(b); });
+
+        float lSum = 0.0f;
+
+        for (unsigned int j = 0; j < mInfluences; ++j)
+            lSum += rBones.weight(lOrder[j]);
+
+        // Quantize the normalized weights, the rounding error goes to the strongest bone so that the weights still sum to 1
+        array<unsigned int, MAX_BONE_INFLUENCES> lWeights;
+        lWeights.fill(0);
+
+        if (lSum > 0.0f)
+        {
+            unsigned int lQuantizedSum = 0;
+
+            for (unsigned int j = 0; j < mInfluences; ++j)
+            {
+                lWeights[j] = static_cast<unsigned int>(std::lround(rBones.weight(lOrder[j]) / lSum * lMaxWeight));
+                lQuantizedSum += lWeights[j];
+            }
+
+            lWeights[0] = lWeights[0] + lMaxWeight - lQuantizedSum;
+        }
+
+        uint32_t* rWords = mWords.data() + i * lWordsPerVertex;
+
+        for (unsigned int j = 0; j < mInfluences; ++j)
+        {
+            // The ID of an unused slot does not matter, but it must be a valid bone
+            const unsigned int lID = lWeights[j] > 0 ? rBones.id(lOrder[j]) : 0;
+
+            assert(lID < pBoneCount && "Bone ID out of boundaries");
+
+            _field(rWords, j, mIndexBits, lID);
+            _field(rWords, mInfluences + j, mIndexBits, lWeights[j]);
+        }
+    }
+}
+
+unsigned int PackedBoneData::vertexCount(void) const noexcept
+{
+    return mVertexCount;
+}
+
+unsigned int PackedBoneData::influences(void) const noexcept
+{
+    return mInfluences;
+}
+
+unsigned int PackedBoneData::indexBits(void) const noexcept
+{
+    return mIndexBits;
+}
+
+unsigned int PackedBoneData::wordsPerVertex(void) const noexcept
+{
+    // IDs and weights have the same size
+    return 2 * mInfluences * mIndexBits / 32;
+}
+
+const uint32_t* PackedBoneData::data(void) const noexcept
+{
+    return mWords.data();
+}
+
+std::size_t PackedBoneData::byteSize(void) const noexcept
+{
+    return mWords.size() * sizeof(uint32_t);
+}
+
+unsigned int PackedBoneData::id(unsigned int pVertex, unsigned int pIndex) const
+{
+    assert(pVertex < mVertexCount && pIndex < mInfluences && "Index out of boundaries");
+
+    return _field(mWords.data() + pVertex * wordsPerVertex(), pIndex, mIndexBits);
+}
+
+float PackedBoneData::weight(unsigned int pVertex, unsigned int pIndex) const
+{
+    assert(pVertex < mVertexCount && pIndex < mInfluences && "Index out of boundaries");
+
+    const unsigned int lMaxWeight = (1u << mIndexBits) - 1;
+
+    return static_cast<float>(_field(mWords.data() + pVertex * wordsPerVertex(), mInfluences + pIndex, mIndexBits)) / static_cast<float>(lMaxWeight);
+}
+
+void PackedBoneData::clear(void)
+{
+    mWords.clear();
+    mVertexCount = 0;
+}
+
+unsigned int PackedBoneData::indexBits(unsigned int pBoneCount) noexcept
+{
+    return pBoneCount > 256 ? 16 : 8;
+}
+
+unsigned int PackedBoneData::_field(const uint32_t* pWords, unsigned int pIndex, unsigned int pBits) noexcept
+{
+    const unsigned int lPerWord = 32 / pBits;
+    const unsigned int lShift = (pIndex % lPerWord) * pBits;
+
+    return (pWords[pIndex / lPerWord] >> lShift) & ((1u << pBits) - 1);
+}
+
+void PackedBoneData::_field(uint32_t* pWords, unsigned int pIndex, unsigned int pBits, unsigned int pValue) noexcept
+{
+    const unsigned int lPerWord = 32 / pBits;
+    const unsigned int lShift = (pIndex % lPerWord) * pBits;
+
+    pWords[pIndex / lPerWord] |= static_cast<uint32_t>(pValue) << lShift;
+}
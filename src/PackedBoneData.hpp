@@ -0,0 +1,131 @@
+//===============================================================================================//
+/*!
+ *  \file      PackedBoneData.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "VertexBoneData.hpp"
+
+// Maximum number of bones kept per vertex while loading a mesh
+#define MAX_BONE_INFLUENCES 8
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores the bone IDs and weights of the vertices in the compact format read by the skinning shaders
+     *  \details Each vertex keeps its 4 or 8 strongest bones, with weights normalized again after dropping the others.
+     *           The IDs use 8 bits (16 bits for meshes with more than 256 bones) and the weights are unsigned normalized
+     *           integers of the same size, so one vertex uses 2, 4 or 8 words of 32 bits: first the IDs, then the weights,
+     *           starting with the lowest bits of each word. The shaders read them as one or two uvec4 attributes.
+     */
+    class PackedBoneData
+    {
+    public:
+        /*!
+         *  \brief Pack the bones of the vertices
+         *  @param pBones contains the bone IDs and weights of each vertex
+         *  @param pInfluences is the number of bones kept per vertex, 4 or 8
+         *  @param pBoneCount is the number of bones in the mesh, used to choose the size of the IDs
+         */
+        void pack(const std::vector<VertexBoneData<MAX_BONE_INFLUENCES>> & pBones, unsigned int pInfluences, unsigned int pBoneCount);
+
+        /*!
+         *  \brief Get the number of vertices
+         *  @return the number of packed vertices
+         */
+        unsigned int vertexCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bones kept per vertex
+         *  @return 4 or 8
+         */
+        unsigned int influences(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bits of each ID and weight
+         *  @return 8 or 16
+         */
+        unsigned int indexBits(void) const noexcept;
+
+        /*!
+         *  \brief Get the size of one vertex
+         *  @return the number of 32 bit words per vertex, 2, 4 or 8
+         */
+        unsigned int wordsPerVertex(void) const noexcept;
+
+        /*!
+         *  \brief Get the packed data, to upload it to a vertex buffer
+         *  @return a pointer on vertexCount() * wordsPerVertex() words
+         */
+        const std::uint32_t* data(void) const noexcept;
+
+        /*!
+         *  \brief Get the memory used by the packed data
+         *  @return the size in bytes
+         */
+        std::size_t byteSize(void) const noexcept;
+
+        /*!
+         *  \brief Decode the ID of one of the bones of a vertex
+         *  @param pVertex is the index of the vertex
+         *  @param pIndex is in the range [0, influences())
+         *  @return the ID of the bone
+         */
+        unsigned int id(unsigned int pVertex, unsigned int pIndex) const;
+
+        /*!
+         *  \brief Decode the weight of one of the bones of a vertex
+         *  @param pVertex is the index of the vertex
+         *  @param pIndex is in the range [0, influences())
+         *  @return the weight in the range [0,1]
+         */
+        float weight(unsigned int pVertex, unsigned int pIndex) const;
+
+        /*!
+         *  \brief Remove all the vertices
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Get the number of bits needed by the IDs of a mesh
+         *  @param pBoneCount is the number of bones in the mesh
+         *  @return 8 for up to 256 bones, 16 otherwise
+         */
+        static unsigned int indexBits(unsigned int pBoneCount) noexcept;
+
+    private:
+        /*!
+         *  \brief Helper method to read a value packed in an array of words
+         *  @param pWords points to the first word
+         *  @param pIndex is the index of the value
+         *  @param pBits is the size of each value
+         *  @return the value
+         */
+        static unsigned int _field(const std::uint32_t* pWords, unsigned int pIndex, unsigned int pBits) noexcept;
+
+        /*!
+         *  \brief Helper method to write a value packed in an array of words (the bits must be 0)
+         *  @param pWords points to the first word
+         *  @param pIndex is the index of the value
+         *  @param pBits is the size of each value
+         *  @param pValue is the value, it must fit in pBits bits
+         */
+        static void _field(std::uint32_t* pWords, unsigned int pIndex, unsigned int pBits, unsigned int pValue) noexcept;
+
+    private:
+        std::vector<std::uint32_t> mWords;
+        unsigned int mVertexCount = 0;
+        unsigned int mInfluences = 4;
+        unsigned int mIndexBits = 8;
+
+    }; // class PackedBoneData
+
+} // namespace miniGL
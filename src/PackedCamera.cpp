@@ -0,0 +1,114 @@
+//===============================================================================================//
+/*!
+ *  \file      PackedCamera.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "PackedCamera.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#include "Frustum.hpp"
+#include "EnumClassCast.hpp"
+
+using miniGL::PackedCamera;
+using miniGL::Camera;
+using miniGL::Frustum;
+
+static_assert(sizeof(mat4f) == 64, "The matrices do not match the std140 layout");
+static_assert(offsetof(PackedCamera::Block, eyePosition) == 384, "The eye position does not match the std140 layout");
+static_assert(offsetof(PackedCamera::Block, time) == 512, "The time does not match the std140 layout");
+static_assert(sizeof(PackedCamera::Block) == 528, "The camera block does not match the std140 layout");
+
+PackedCamera::PackedCamera(void)
+{
+    // Also clears the padding, the values are compared byte by byte
+    std::memset(static_cast<void*>(& mBlock), 0, sizeof(Block));
+}
+
+bool PackedCamera::pack(Camera & pCamera, unsigned int pWidth, unsigned int pHeight, float pTime)
+{
+    bool lChanged = false;
+
+    const mat4f & lViewProjection = pCamera.viewProjection();
+
+    bool lMoved = _write(mBlock.view, pCamera.view());
+    lMoved |= _write(mBlock.projection, pCamera.projection());
+    lMoved |= _write(mBlock.viewProjection, lViewProjection);
+
+    // The inverses and the planes are only computed when the camera moved
+    if (lMoved)
+    {
+        _write(mBlock.inverseView, pCamera.view().inversed());
+        _write(mBlock.inverseProjection, pCamera.projection().inversed());
+        _write(mBlock.inverseViewProjection, lViewProjection.inversed());
+
+        const Frustum lFrustum(lViewProjection);
+
+        float lPlanes[6][4];
+
+        for (unsigned int i = 0; i < toUT(Frustum::EPlane::COUNT); ++i)
+        {
+            const vec4f lPlane = lFrustum.plane(static_cast<Frustum::EPlane>(i));
+
+            for (unsigned int j = 0; j < 4; ++j)
+                lPlanes[i][j] = lPlane[j];
+        }
+
+        _write(mBlock.frustumPlanes, lPlanes);
+
+        lChanged = true;
+    }
+
+    const vec3f & lPosition = pCamera.position();
+    const float lEyePosition[4] = { lPosition.x(), lPosition.y(), lPosition.z(), 1.0f };
+    const float lViewport[4] = { 0.0f, 0.0f, static_cast<float>(pWidth), static_cast<float>(pHeight) };
+
+    lChanged |= _write(mBlock.eyePosition, lEyePosition);
+    lChanged |= _write(mBlock.viewport, lViewport);
+    lChanged |= _write(mBlock.time, pTime);
+
+    return lChanged;
+}
+
+const PackedCamera::Block & PackedCamera::block(void) const noexcept
+{
+    return mBlock;
+}
+
+std::size_t PackedCamera::dirtyOffset(void) const noexcept
+{
+    return mDirtyBegin;
+}
+
+std::size_t PackedCamera::dirtySize(void) const noexcept
+{
+    return mDirtyEnd > mDirtyBegin ? mDirtyEnd - mDirtyBegin : 0;
+}
+
+void PackedCamera::clean(void) noexcept
+{
+    mDirtyBegin = sizeof(Block);
+    mDirtyEnd = 0;
+}
+
+template<typename T>
+bool PackedCamera::_write(T & pDestination, const T & pValue)
+{
+    if (std::memcmp(& pDestination, & pValue, sizeof(T)) == 0)
+        return false;
+
+    // The arrays of the block cannot be assigned
+    std::memcpy(static_cast<void*>(& pDestination), & pValue, sizeof(T));
+
+    const std::size_t lOffset = reinterpret_cast<const unsigned char*>(& pDestination) - reinterpret_cast<const unsigned char*>(& mBlock);
+
+    mDirtyBegin = std::min(mDirtyBegin, lOffset);
+    mDirtyEnd = std::max(mDirtyEnd, lOffset + sizeof(T));
+
+    return true;
+}
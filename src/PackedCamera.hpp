@@ -0,0 +1,99 @@
+//===============================================================================================//
+/*!
+ *  \file      PackedCamera.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <cstddef>
+
+#include "Algebra.hpp"
+#include "Camera.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores the matrices and parameters of a camera with the std140 layout of the CameraBlock uniform block
+     *  \details The block is packed once per frame for the main camera. The matrices keep the row major order of mat4f,
+     *           the shaders declare the block row_major. Like PackedLights, the bytes that changed since the last call to
+     *           clean form the dirty range, so a still camera only uploads the time. The class does not call OpenGL.
+     */
+    class PackedCamera
+    {
+    public:
+        //! std140 layout of the CameraBlock uniform block
+        struct Block
+        {
+            mat4f view;
+            mat4f projection;
+            mat4f viewProjection;
+            mat4f inverseView;
+            mat4f inverseProjection;
+            mat4f inverseViewProjection;
+            float eyePosition[4];       //!< w is 1
+            float frustumPlanes[6][4];  //!< Same order as Frustum::EPlane, the normals point inside
+            float viewport[4];          //!< x, y, width, height in pixels
+            float time;                 //!< Running time in seconds
+            float padding[3];
+        };
+
+    public:
+        /*!
+         *  \brief Constructor, the whole block is dirty
+         */
+        PackedCamera(void);
+
+        /*!
+         *  \brief Pack the parameters of a camera
+         *  @param pCamera is the camera, its matrices are updated if needed
+         *  @param pWidth is the width of the viewport in pixels
+         *  @param pHeight is the height of the viewport in pixels
+         *  @param pTime is the running time in seconds
+         *  @return true if the block changed
+         */
+        bool pack(Camera & pCamera, unsigned int pWidth, unsigned int pHeight, float pTime);
+
+        /*!
+         *  \brief Get the packed camera
+         *  @return a const reference on the block
+         */
+        const Block & block(void) const noexcept;
+
+        /*!
+         *  \brief Get the first byte that changed since the last call to clean
+         *  @return an offset in the block
+         */
+        std::size_t dirtyOffset(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bytes that changed since the last call to clean, from dirtyOffset
+         *  @return 0 if nothing changed
+         */
+        std::size_t dirtySize(void) const noexcept;
+
+        /*!
+         *  \brief Mark the block as uploaded
+         */
+        void clean(void) noexcept;
+
+    private:
+        /*!
+         *  \brief Helper method to copy a value in the block if it is different, extending the dirty range
+         *  @param pDestination is a member of mBlock
+         *  @param pValue is the new value
+         *  @return true if the value changed
+         */
+        template<typename T>
+        bool _write(T & pDestination, const T & pValue);
+
+    private:
+        Block mBlock;
+        std::size_t mDirtyBegin = 0;
+        std::size_t mDirtyEnd = sizeof(Block);
+
+    }; // class PackedCamera
+
+} // namespace miniGL
@@ -0,0 +1,170 @@
+//===============================================================================================//
+/*!
+ *  \file      PackedLights.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "PackedLights.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#include "DirectionalLight.hpp"
+#include "PointLight.hpp"
+#include "SpotLight.hpp"
+
+using std::vector;
+using std::shared_ptr;
+using miniGL::PackedLights;
+using miniGL::BaseLight;
+using miniGL::DirectionalLight;
+using miniGL::PointLight;
+using miniGL::SpotLight;
+
+static_assert(sizeof(PackedLights::DirectionalLightData) == 48, "The directional light does not match the std140 layout");
+static_assert(sizeof(PackedLights::PointLightData) == 64, "The point light does not match the std140 layout");
+static_assert(sizeof(PackedLights::SpotLightData) == 80, "The spot light does not match the std140 layout");
+static_assert(offsetof(PackedLights::Block, pointLightCount) == 48 + 64 * PACKED_LIGHTS_MAX_POINT_LIGHTS + 80 * PACKED_LIGHTS_MAX_SPOT_LIGHTS, "The light counts do not match the std140 layout");
+
+PackedLights::PackedLights(void)
+{
+    // Also clears the padding, the values are compared byte by byte
+    std::memset(& mBlock, 0, sizeof(Block));
+}
+
+bool PackedLights::pack(const vector<shared_ptr<BaseLight>> & pLights, const vector<unsigned int> & pIndices, unsigned int pMaxPointLights, unsigned int pMaxSpotLights)
+{
+    assert(pMaxPointLights <= PACKED_LIGHTS_MAX_POINT_LIGHTS && "Too many point lights for the light block");
+    assert(pMaxSpotLights <= PACKED_LIGHTS_MAX_SPOT_LIGHTS && "Too many spot lights for the light block");
+
+    // Without directional light in the selection, its slot is black
+    DirectionalLightData lDirectionalLight = {};
+    int lPointLightCount = 0;
+    int lSpotLightCount = 0;
+    bool lChanged = false;
+
+    for (unsigned int lIndex : pIndices)
+    {
+        assert(lIndex < pLights.size() && "Light index out of boundaries");
+        const BaseLight & rLight = *pLights[lIndex];
+
+        switch (rLight.type())
+        {
+            case BaseLight::EType::DIRECTIONAL:
+            {
+                const DirectionalLight & rDirectionalLight = static_cast<const DirectionalLight &>(rLight);
+
+                vec3f lDirection = rDirectionalLight.direction();
+                lDirection.normalize();
+
+                for (unsigned int i = 0; i < 3; ++i)
+                {
+                    lDirectionalLight.color[i] = rLight.color()[i];
+                    lDirectionalLight.direction[i] = lDirection[i];
+                }
+
+                lDirectionalLight.ambientIntensity = rLight.ambientIntensity();
+                lDirectionalLight.diffuseIntensity = rLight.diffuseIntensity();
+            }   break;
+
+            case BaseLight::EType::POINT:
+                if (static_cast<unsigned int>(lPointLightCount) < pMaxPointLights)
+                {
+                    PointLightData lPointLight = {};
+                    _pack(static_cast<const PointLight &>(rLight), lPointLight);
+
+                    lChanged |= _write(mBlock.pointLights[lPointLightCount++], lPointLight);
+                }
+                break;
+
+            case BaseLight::EType::SPOT:
+                if (static_cast<unsigned int>(lSpotLightCount) < pMaxSpotLights)
+                {
+                    const SpotLight & rSpotLight = static_cast<const SpotLight &>(rLight);
+
+                    SpotLightData lSpotLight = {};
+                    _pack(rSpotLight, lSpotLight.base);
+
+                    vec3f lDirection = rSpotLight.direction();
+                    lDirection.normalize();
+
+                    for (unsigned int i = 0; i < 3; ++i)
+                        lSpotLight.direction[i] = lDirection[i];
+
+                    lSpotLight.cutoff = cosf(rSpotLight.cutoff().toRadian());
+
+                    lChanged |= _write(mBlock.spotLights[lSpotLightCount++], lSpotLight);
+                }
+                break;
+
+            case BaseLight::EType::UNDEFINED:
+            default:
+                assert(false && "Undefined light type");
+                break;
+        }
+    }
+
+    // The slots after the counts are not read by the shaders, they keep their previous values
+    lChanged |= _write(mBlock.directionalLight, lDirectionalLight);
+    lChanged |= _write(mBlock.pointLightCount, lPointLightCount);
+    lChanged |= _write(mBlock.spotLightCount, lSpotLightCount);
+
+    return lChanged;
+}
+
+const PackedLights::Block & PackedLights::block(void) const noexcept
+{
+    return mBlock;
+}
+
+std::size_t PackedLights::dirtyOffset(void) const noexcept
+{
+    return mDirtyBegin;
+}
+
+std::size_t PackedLights::dirtySize(void) const noexcept
+{
+    return mDirtyEnd > mDirtyBegin ? mDirtyEnd - mDirtyBegin : 0;
+}
+
+void PackedLights::clean(void) noexcept
+{
+    mDirtyBegin = sizeof(Block);
+    mDirtyEnd = 0;
+}
+
+template<typename T>
+bool PackedLights::_write(T & pDestination, const T & pValue)
+{
+    if (std::memcmp(& pDestination, & pValue, sizeof(T)) == 0)
+        return false;
+
+    pDestination = pValue;
+
+    const std::size_t lOffset = reinterpret_cast<const unsigned char*>(& pDestination) - reinterpret_cast<const unsigned char*>(& mBlock);
+
+    mDirtyBegin = std::min(mDirtyBegin, lOffset);
+    mDirtyEnd = std::max(mDirtyEnd, lOffset + sizeof(T));
+
+    return true;
+}
+
+void PackedLights::_pack(const PointLight & pLight, PointLightData & pData)
+{
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        pData.color[i] = pLight.color()[i];
+        pData.position[i] = pLight.position()[i];
+    }
+
+    pData.ambientIntensity = pLight.ambientIntensity();
+    pData.diffuseIntensity = pLight.diffuseIntensity();
+    pData.constant = pLight.attenuation(PointLight::ATTENUATION_TYPE::CONSTANT);
+    pData.linear = pLight.attenuation(PointLight::ATTENUATION_TYPE::LINEAR);
+    pData.exponential = pLight.attenuation(PointLight::ATTENUATION_TYPE::EXPONENTIAL);
+}
@@ -0,0 +1,143 @@
+//===============================================================================================//
+/*!
+ *  \file      PackedLights.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "BaseLight.hpp"
+
+// Size of the light arrays of the LightBlock uniform block, must match maxPointLights and maxSpotLights in the shaders
+#define PACKED_LIGHTS_MAX_POINT_LIGHTS 4
+#define PACKED_LIGHTS_MAX_SPOT_LIGHTS 4
+
+namespace miniGL
+{
+    class PointLight;
+
+    /*!
+     *  \brief   This class stores the lights with the std140 layout of the LightBlock uniform block of the lighting shaders
+     *  \details Each light is packed in a temporary slot and only copied in the block if its values changed, so the
+     *           changes are tracked by comparing the values: the lights can also be edited through their non const
+     *           accessors, e.g. by the UI. The dirty range covers the bytes that changed since the last call to
+     *           clean, LightUniformBuffer only uploads this range. The class does not call OpenGL.
+     */
+    class PackedLights
+    {
+    public:
+        //! std140 layout of the DirectionalLight struct of the shaders
+        struct DirectionalLightData
+        {
+            float color[3];
+            float ambientIntensity;
+            float diffuseIntensity;
+            float padding0[3];
+            float direction[3];         //!< Normalized
+            float padding1;
+        };
+
+        //! std140 layout of the PointLight struct of the shaders
+        struct PointLightData
+        {
+            float color[3];
+            float ambientIntensity;
+            float diffuseIntensity;
+            float padding0[3];
+            float constant;
+            float linear;
+            float exponential;
+            float padding1;
+            float position[3];
+            float padding2;
+        };
+
+        //! std140 layout of the SpotLight struct of the shaders
+        struct SpotLightData
+        {
+            PointLightData base;
+            float direction[3];         //!< Normalized
+            float cutoff;               //!< Cosine of the cutoff angle
+        };
+
+        //! std140 layout of the LightBlock uniform block
+        struct Block
+        {
+            DirectionalLightData directionalLight;
+            PointLightData pointLights[PACKED_LIGHTS_MAX_POINT_LIGHTS];
+            SpotLightData spotLights[PACKED_LIGHTS_MAX_SPOT_LIGHTS];
+            int pointLightCount;
+            int spotLightCount;
+            int padding[2];
+        };
+
+    public:
+        /*!
+         *  \brief Constructor, the whole block is dirty
+         */
+        PackedLights(void);
+
+        /*!
+         *  \brief Pack the lights used by a program
+         *  @param pLights contains all the lights of the scene
+         *  @param pIndices are the indices in pLights of the lights to use, in order
+         *  @param pMaxPointLights is the number of point lights that the program uses at most
+         *  @param pMaxSpotLights is the number of spot lights that the program uses at most
+         *  @return true if the block changed
+         */
+        bool pack(const std::vector<std::shared_ptr<BaseLight>> & pLights, const std::vector<unsigned int> & pIndices, unsigned int pMaxPointLights, unsigned int pMaxSpotLights);
+
+        /*!
+         *  \brief Get the packed lights
+         *  @return a const reference on the block
+         */
+        const Block & block(void) const noexcept;
+
+        /*!
+         *  \brief Get the first byte that changed since the last call to clean
+         *  @return an offset in the block
+         */
+        std::size_t dirtyOffset(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bytes that changed since the last call to clean, from dirtyOffset
+         *  @return 0 if nothing changed
+         */
+        std::size_t dirtySize(void) const noexcept;
+
+        /*!
+         *  \brief Mark the block as uploaded
+         */
+        void clean(void) noexcept;
+
+    private:
+        /*!
+         *  \brief Helper method to copy a value in the block if it is different, extending the dirty range
+         *  @param pDestination is a member of mBlock
+         *  @param pValue is the new value
+         *  @return true if the value changed
+         */
+        template<typename T>
+        bool _write(T & pDestination, const T & pValue);
+
+        /*!
+         *  \brief Helper method to pack the parameters shared by the point and spot lights
+         *  @param pLight is the light to pack
+         *  @param pData receives the values
+         */
+        static void _pack(const PointLight & pLight, PointLightData & pData);
+
+    private:
+        Block mBlock;
+        std::size_t mDirtyBegin = 0;
+        std::size_t mDirtyEnd = sizeof(Block);
+
+    }; // class PackedLights
+
+} // namespace miniGL
@@ -12,10 +12,12 @@
 
 #include "GLUtils.hpp"
 #include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
 
 using std::vector;
 using std::make_unique;
 using miniGL::ParticleSystem;
+using miniGL::GLStateCache;
 
 ParticleSystem::~ParticleSystem(void)
 {
@@ -125,7 +127,7 @@ void ParticleSystem::_update(int pDeltaTime)
 
     mRandomTexture.bind(RANDOM_TEXTURE_UNIT);
 
-    glEnable(GL_RASTERIZER_DISCARD);
+    GLStateCache::enable(GL_RASTERIZER_DISCARD);
 
     glBindVertexArray(mVAO[mCurrentVB]);
 
@@ -170,14 +172,13 @@ void ParticleSystem::_render(const mat4f & pVP, const vec3f & pCameraPos)
     mBillbording.eyeWorldPosition(pCameraPos);
     mBillbording.VP(pVP);
 
-    glDisable(GL_RASTERIZER_DISCARD);
+    GLStateCache::disable(GL_RASTERIZER_DISCARD);
 
     // Save the current orientation
-    GLint lFrontFaceOrientation;
-    glGetIntegerv(GL_FRONT_FACE, & lFrontFaceOrientation);
+    const GLenum lFrontFaceOrientation = GLStateCache::frontFace();
 
     // Use the clockwise orientation to render the billboards
-    glFrontFace(GL_CW);
+    GLStateCache::frontFace(GL_CW);
 
     glBindVertexArray(mVAO[mCurrentTFB]);
 
@@ -190,5 +191,5 @@ void ParticleSystem::_render(const mat4f & pVP, const vec3f & pCameraPos)
     glBindVertexArray(0);
 
     // Restore the original orientation
-    glFrontFace(lFrontFaceOrientation);
+    GLStateCache::frontFace(lFrontFaceOrientation);
 }
@@ -12,12 +12,18 @@ using std::make_unique;
 using std::shared_ptr;
 using std::string;
 using std::string;
-using std::map;
 using std::get;
 using std::tuple;
 using miniGL::Picking3D;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::Camera;
+using miniGL::JobSystem;
+
+Picking3D::Picking3D(JobSystem & pJobSystem)
+:mJobSystem(pJobSystem)
+{
+}
 
 void Picking3D::init(const tuple<int, int> & pFramebufferDimensions, const tuple<int, int> & pWindowDimensions)
 {
@@ -37,21 +43,28 @@ void Picking3D::init(const tuple<int, int> & pFramebufferDimensions, const tuple
     mSimpleColor->init();
 }
 
-void Picking3D::pickingPhase(map<string, MeshAndTransform> & pMeshes)
+void Picking3D::pickingPhase(const MeshRegistry & pMeshes)
 {
     mPickingTexture.enableWritting();
 
     mPickingRender->use();
 
-    auto lMesh = pMeshes.at(mMeshToRenderName);
+    const auto & rMeshes = mMeshToRender.meshes(pMeshes);
+    assert(rMeshes.size() == 1 && "The mesh to pick is not in the mesh registry");
 
-    for (size_t i = 0; i < lMesh.transform.size(); ++i)
-    {
-        mPickingRender->objectIndex(static_cast<unsigned int>(i));
+    const MeshAndTransform & lMesh = *rMeshes[0];
 
-        mat4f lWVP = mCamera->projection() * mCamera->view() * lMesh.transform[i].final();
+    // The picking shaders do not skin the vertices, the mesh keeps this pose until render highlights the picked triangle
+    if (lMesh.mesh->boneCount() > 0)
+    {
+        lMesh.mesh->boneTransform(mRunningTime, mBoneTransforms, mCursor, mNodeTransforms);
+        lMesh.mesh->skinOnCPU(mBoneTransforms.data(), & mJobSystem);
+    }
 
-        mPickingRender->WVP(lWVP);
+    for (unsigned int i = 0; i < lMesh.transform.size(); ++i)
+    {
+        mPickingRender->objectIndex(i);
+        mPickingRender->WVP(lMesh.transform.WVP(i));
 
         lMesh.mesh->render(MeshBase::EPrimitiveType::TRIANGLE, mPickingRender.get());
     }
@@ -59,7 +72,7 @@ void Picking3D::pickingPhase(map<string, MeshAndTransform> & pMeshes)
     mPickingTexture.disableWritting();
 }
 
-void Picking3D::render(map<string, MeshAndTransform> & pMeshes, const vec2i & pMousePosition)
+void Picking3D::render(const MeshRegistry & pMeshes, const vec2i & pMousePosition)
 {
     const auto lMousePosInFrameBufferX = static_cast<unsigned int>(static_cast<double>(pMousePosition.x()) * mScaling.x());
     const auto lMousePosInFrameBufferY = get<1>(mFrameBufferDimensions) - static_cast<unsigned int>(static_cast<double>(pMousePosition.y()) * mScaling.y()) - 1;
@@ -68,15 +81,16 @@ void Picking3D::render(map<string, MeshAndTransform> & pMeshes, const vec2i & pM
 
     if (!(isnan(lPixelInfo.drawID) || isnan(lPixelInfo.objectID) || isnan(lPixelInfo.primitiveID)) && lPixelInfo.primitiveID != 0)
     {
-        auto lMesh = pMeshes.at(mMeshToRenderName);
+        const auto & rMeshes = mMeshToRender.meshes(pMeshes);
+        assert(rMeshes.size() == 1 && "The mesh to pick is not in the mesh registry");
+
+        const MeshAndTransform & lMesh = *rMeshes[0];
 
         mSimpleColor->use();
 
         assert(lPixelInfo.objectID < lMesh.transform.size());
 
-        mat4f lWVP = mCamera->projection() * mCamera->view() * lMesh.transform.at(static_cast<unsigned int>(lPixelInfo.objectID)).final();
-
-        mSimpleColor->WVP(lWVP);
+        mSimpleColor->WVP(lMesh.transform.WVP(static_cast<unsigned int>(lPixelInfo.objectID)));
         mSimpleColor->color(0.3f, 0.4f, 0.9f);
         // Compensate for the "artificial" increment of the primitive ID in the fragment shader
         lMesh.mesh->render(static_cast<unsigned int>(lPixelInfo.drawID), static_cast<unsigned int>(lPixelInfo.primitiveID) - 1);
@@ -90,5 +104,11 @@ void Picking3D::camera(const shared_ptr<Camera> pCamera)
 
 void Picking3D::meshToRender(const string & pName)
 {
-    mMeshToRenderName = pName;
+    mMeshToRender.clear();
+    mMeshToRender.add(pName);
+}
+
+void Picking3D::runningTime(float pRunningTime)
+{
+    mRunningTime = pRunningTime;
 }
@@ -8,16 +8,18 @@
 
 #pragma once
 
-#include <map>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "PickingRender.hpp"
 #include "PickingTexture.hpp"
 #include "SimpleColorRender.hpp"
-#include "MeshAndTransform.hpp"
+#include "MeshRegistry.hpp"
 #include "Camera.hpp"
 #include "Algebra.hpp"
+#include "AnimationCursor.hpp"
+#include "JobSystem.hpp"
 
 namespace miniGL
 {
@@ -28,6 +30,12 @@ namespace miniGL
     class Picking3D
     {
     public:
+        /*!
+         *  \brief Constructor
+         *  @param pJobSystem deforms a skinned mesh in parallel, it must outlive the technique
+         */
+        explicit Picking3D(JobSystem & pJobSystem);
+
         /*!
          *  \brief Initialize the rendering technique
          *  @param pFramebufferDimensions is the width and height of the framebuffer
@@ -39,14 +47,14 @@ namespace miniGL
          *  \brief Picking phase of the render, i.e. determine the triangles located "under" the mouse
          *  @param pMeshes is a container with all the meshes
          */
-        void pickingPhase(std::map<std::string, MeshAndTransform> & pMeshes);
+        void pickingPhase(const MeshRegistry & pMeshes);
 
         /*!
          *  \brief Render the meshes provided as parameter using this rendering technique
          *  @param pMeshes is a container with all the meshes
          *  @param pMousePosition contains the x and y coordinates of the mouse
          */
-        void render(std::map<std::string, MeshAndTransform> & pMeshes, const vec2i & pMousePosition);
+        void render(const MeshRegistry & pMeshes, const vec2i & pMousePosition);
 
         /*!
          *  \brief Set a copy of the camera
@@ -60,14 +68,25 @@ namespace miniGL
          */
         void meshToRender(const std::string & pName);
 
+        /*!
+         *  \brief Set the running time, i.e. the time since the application started, used to animate a skinned mesh
+         *  @param pRunningTime is the time in seconds
+         */
+        void runningTime(float pRunningTime);
+
     private:
         PickingTexture mPickingTexture;
         std::unique_ptr<PickingRender> mPickingRender;
         std::unique_ptr<SimpleColorRender> mSimpleColor;
         std::shared_ptr<Camera> mCamera;
-        std::string mMeshToRenderName;
+        MeshSelection mMeshToRender;
         vec2d mScaling;
         std::tuple<int, int> mFrameBufferDimensions = {0, 0};
+        JobSystem & mJobSystem;
+        AnimationCursor mCursor;
+        std::vector<mat4f> mNodeTransforms;
+        std::vector<mat4f> mBoneTransforms;
+        float mRunningTime = 0.0f;
 
     }; // class Picking3D
 
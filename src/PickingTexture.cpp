@@ -12,38 +12,40 @@
 
 #include "GLUtils.hpp"
 #include "Exceptions.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::to_string;
 using miniGL::PickingTexture;
+using miniGL::GLStateCache;
 
 PickingTexture::~PickingTexture(void)
 {
     if (mFBO != 0)
-        glDeleteFramebuffers(1, & mFBO);
+        GLStateCache::deleteFramebuffers(1, & mFBO);
 
     if (mPickingTexture != 0)
-        glDeleteTextures(1, & mPickingTexture);
+        GLStateCache::deleteTextures(1, & mPickingTexture);
 
     if (mDepthTexture != 0)
-        glDeleteTextures(1, & mDepthTexture);
+        GLStateCache::deleteTextures(1, & mDepthTexture);
 }
 
 void PickingTexture::init(unsigned int pFrameBufferWidth, unsigned int pFrameBufferHeight)
 {
     // Create the frame buffer object
     glGenFramebuffers(1, & mFBO); checkOpenGLState;
-    glBindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
 
     // Create a texture object to store the primitive information
     glGenTextures(1, & mPickingTexture); checkOpenGLState;
-    glBindTexture(GL_TEXTURE_2D, mPickingTexture); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mPickingTexture); checkOpenGLState;
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, pFrameBufferWidth, pFrameBufferHeight, 0, GL_RGB, GL_FLOAT, NULL); checkOpenGLState;
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mPickingTexture, 0); checkOpenGLState;
 
     // Create a texture for the depth buffer
     glGenTextures(1, & mDepthTexture); checkOpenGLState;
-    glBindTexture(GL_TEXTURE_2D, mDepthTexture); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mDepthTexture); checkOpenGLState;
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, pFrameBufferWidth, pFrameBufferHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL); checkOpenGLState;
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_COMPONENT, GL_TEXTURE_2D, mDepthTexture, 0); checkOpenGLState;
 
@@ -63,30 +65,30 @@ void PickingTexture::init(unsigned int pFrameBufferWidth, unsigned int pFrameBuf
     }
 
     // Restore default frame buffer
-    glBindTexture(GL_TEXTURE_2D, 0); checkOpenGLState;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0); checkOpenGLState;
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0); checkOpenGLState;
 }
 
 void PickingTexture::enableWritting(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
 }
 
 void PickingTexture::disableWritting(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 }
 
 PickingTexture::PixelInfo PickingTexture::readPixel(unsigned int pX, unsigned int pY)
 {
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, mFBO);
     glReadBuffer(GL_COLOR_ATTACHMENT0);
 
     PixelInfo lPixelInfo;
     glReadPixels(pX, pY, 1, 1, GL_RGB, GL_FLOAT, & lPixelInfo);
 
     glReadBuffer(GL_NONE);
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 
     return lPixelInfo;
 }
@@ -0,0 +1,272 @@
+//===============================================================================================//
+/*!
+ *  \file      PoseBlending.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "PoseBlending.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "EnumClassCast.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MINIGL_POSE_BLENDING_SSE2
+#endif
+
+// Index of the first translation, rotation and scaling component, see LocalPose::EComponent
+#define TRANSLATION 0
+#define ROTATION 3
+#define SCALING 7
+#define COMPONENT_COUNT 10
+
+using miniGL::PoseBlending;
+using miniGL::LocalPose;
+using miniGL::toUT;
+
+static_assert(COMPONENT_COUNT == toUT(LocalPose::EComponent::COUNT), "The kernels index the components of LocalPose");
+
+void PoseBlending::crossfade(const LocalPose & pFrom, const LocalPose & pTo, float pWeight, LocalPose & pResult, const float* pMask)
+{
+    assert(pFrom.nodeCount() == pTo.nodeCount() && "The poses must have the same number of nodes");
+
+    const unsigned int lNodeCount = pFrom.nodeCount();
+    pResult.resize(lNodeCount);
+
+    const float* lFrom[COMPONENT_COUNT];
+    const float* lTo[COMPONENT_COUNT];
+    float* lResult[COMPONENT_COUNT];
+
+    _components(pFrom, lFrom);
+    _components(pTo, lTo);
+    _components(pResult, lResult);
+
+    unsigned int lFirst = 0;
+
+#ifdef MINIGL_POSE_BLENDING_SSE2
+    const __m128 lWeight = _mm_set1_ps(pWeight);
+    const __m128 lSignMask = _mm_set1_ps(-0.0f);
+    const __m128 lOne = _mm_set1_ps(1.0f);
+
+    for (; lFirst + 4 <= lNodeCount; lFirst += 4)
+    {
+        const __m128 w = pMask != nullptr ? _mm_mul_ps(lWeight, _mm_loadu_ps(pMask + lFirst)) : lWeight;
+
+        for (unsigned int c = TRANSLATION; c < TRANSLATION + 3; ++c)
+        {
+            const __m128 a = _mm_loadu_ps(lFrom[c] + lFirst);
+            const __m128 b = _mm_loadu_ps(lTo[c] + lFirst);
+            _mm_storeu_ps(lResult[c] + lFirst, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), w)));
+        }
+
+        for (unsigned int c = SCALING; c < SCALING + 3; ++c)
+        {
+            const __m128 a = _mm_loadu_ps(lFrom[c] + lFirst);
+            const __m128 b = _mm_loadu_ps(lTo[c] + lFirst);
+            _mm_storeu_ps(lResult[c] + lFirst, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), w)));
+        }
+
+        __m128 a[4], b[4];
+
+        for (unsigned int c = 0; c < 4; ++c)
+        {
+            a[c] = _mm_loadu_ps(lFrom[ROTATION + c] + lFirst);
+            b[c] = _mm_loadu_ps(lTo[ROTATION + c] + lFirst);
+        }
+
+        // Flip the second quaternion when the dot product is negative to interpolate along the shortest arc
+        __m128 lDot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+        const __m128 lSign = _mm_and_ps(lDot, lSignMask);
+
+        __m128 q[4];
+
+        for (unsigned int c = 0; c < 4; ++c)
+            q[c] = _mm_add_ps(a[c], _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(b[c], lSign), a[c]), w));
+
+        lDot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(q[0], q[0]), _mm_mul_ps(q[1], q[1])), _mm_add_ps(_mm_mul_ps(q[2], q[2]), _mm_mul_ps(q[3], q[3])));
+        const __m128 lInvLength = _mm_div_ps(lOne, _mm_sqrt_ps(lDot));
+
+        for (unsigned int c = 0; c < 4; ++c)
+            _mm_storeu_ps(lResult[ROTATION + c] + lFirst, _mm_mul_ps(q[c], lInvLength));
+    }
+#endif
+
+    _crossfade(lFrom, lTo, pWeight, lResult, pMask, lFirst, lNodeCount);
+}
+
+void PoseBlending::additive(const LocalPose & pBase, const LocalPose & pAdditive, const LocalPose & pReference, float pWeight, LocalPose & pResult, const float* pMask)
+{
+    assert(pBase.nodeCount() == pAdditive.nodeCount() && pBase.nodeCount() == pReference.nodeCount() && "The poses must have the same number of nodes");
+
+    const unsigned int lNodeCount = pBase.nodeCount();
+    pResult.resize(lNodeCount);
+
+    const float* lBase[COMPONENT_COUNT];
+    const float* lAdditive[COMPONENT_COUNT];
+    const float* lReference[COMPONENT_COUNT];
+    float* lResult[COMPONENT_COUNT];
+
+    _components(pBase, lBase);
+    _components(pAdditive, lAdditive);
+    _components(pReference, lReference);
+    _components(pResult, lResult);
+
+    unsigned int lFirst = 0;
+
+#ifdef MINIGL_POSE_BLENDING_SSE2
+    const __m128 lWeight = _mm_set1_ps(pWeight);
+    const __m128 lSignMask = _mm_set1_ps(-0.0f);
+    const __m128 lOne = _mm_set1_ps(1.0f);
+
+    for (; lFirst + 4 <= lNodeCount; lFirst += 4)
+    {
+        const __m128 w = pMask != nullptr ? _mm_mul_ps(lWeight, _mm_loadu_ps(pMask + lFirst)) : lWeight;
+
+        for (unsigned int c = TRANSLATION; c < TRANSLATION + 3; ++c)
+        {
+            const __m128 lDelta = _mm_sub_ps(_mm_loadu_ps(lAdditive[c] + lFirst), _mm_loadu_ps(lReference[c] + lFirst));
+            _mm_storeu_ps(lResult[c] + lFirst, _mm_add_ps(_mm_loadu_ps(lBase[c] + lFirst), _mm_mul_ps(lDelta, w)));
+        }
+
+        for (unsigned int c = SCALING; c < SCALING + 3; ++c)
+        {
+            const __m128 lDelta = _mm_div_ps(_mm_loadu_ps(lAdditive[c] + lFirst), _mm_loadu_ps(lReference[c] + lFirst));
+            const __m128 lFactor = _mm_add_ps(lOne, _mm_mul_ps(_mm_sub_ps(lDelta, lOne), w));
+            _mm_storeu_ps(lResult[c] + lFirst, _mm_mul_ps(_mm_loadu_ps(lBase[c] + lFirst), lFactor));
+        }
+
+        __m128 r[4], a[4], b[4];
+
+        for (unsigned int c = 0; c < 4; ++c)
+        {
+            r[c] = _mm_loadu_ps(lReference[ROTATION + c] + lFirst);
+            a[c] = _mm_loadu_ps(lAdditive[ROTATION + c] + lFirst);
+            b[c] = _mm_loadu_ps(lBase[ROTATION + c] + lFirst);
+        }
+
+        // Difference conjugate(reference) * additive
+        __m128 d[4];
+        d[0] = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(r[3], a[0]), _mm_mul_ps(r[2], a[1])), _mm_add_ps(_mm_mul_ps(r[0], a[3]), _mm_mul_ps(r[1], a[2])));
+        d[1] = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(r[3], a[1]), _mm_mul_ps(r[0], a[2])), _mm_add_ps(_mm_mul_ps(r[1], a[3]), _mm_mul_ps(r[2], a[0])));
+        d[2] = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(r[3], a[2]), _mm_mul_ps(r[1], a[0])), _mm_add_ps(_mm_mul_ps(r[2], a[3]), _mm_mul_ps(r[0], a[1])));
+        d[3] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[3], a[3]), _mm_mul_ps(r[0], a[0])), _mm_add_ps(_mm_mul_ps(r[1], a[1]), _mm_mul_ps(r[2], a[2])));
+
+        // Scale the difference along the shortest arc from the identity
+        const __m128 lSign = _mm_and_ps(d[3], lSignMask);
+
+        for (unsigned int c = 0; c < 3; ++c)
+            d[c] = _mm_mul_ps(_mm_xor_ps(d[c], lSign), w);
+
+        d[3] = _mm_add_ps(lOne, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(d[3], lSign), lOne), w));
+
+        const __m128 lLength = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d[0], d[0]), _mm_mul_ps(d[1], d[1])), _mm_add_ps(_mm_mul_ps(d[2], d[2]), _mm_mul_ps(d[3], d[3])));
+        const __m128 lInvLength = _mm_div_ps(lOne, _mm_sqrt_ps(lLength));
+
+        for (unsigned int c = 0; c < 4; ++c)
+            d[c] = _mm_mul_ps(d[c], lInvLength);
+
+        // Base * difference
+        _mm_storeu_ps(lResult[ROTATION] + lFirst, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b[3], d[0]), _mm_mul_ps(b[0], d[3])), _mm_mul_ps(b[1], d[2])), _mm_mul_ps(b[2], d[1])));
+        _mm_storeu_ps(lResult[ROTATION + 1] + lFirst, _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(b[3], d[1]), _mm_mul_ps(b[1], d[3])), _mm_mul_ps(b[0], d[2])), _mm_mul_ps(b[2], d[0])));
+        _mm_storeu_ps(lResult[ROTATION + 2] + lFirst, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b[3], d[2]), _mm_mul_ps(b[2], d[3])), _mm_mul_ps(b[0], d[1])), _mm_mul_ps(b[1], d[0])));
+        _mm_storeu_ps(lResult[ROTATION + 3] + lFirst, _mm_sub_ps(_mm_mul_ps(b[3], d[3]), _mm_add_ps(_mm_add_ps(_mm_mul_ps(b[0], d[0]), _mm_mul_ps(b[1], d[1])), _mm_mul_ps(b[2], d[2]))));
+    }
+#endif
+
+    _additive(lBase, lAdditive, lReference, pWeight, lResult, pMask, lFirst, lNodeCount);
+}
+
+void PoseBlending::_crossfade(const float* const* pFrom, const float* const* pTo, float pWeight, float* const* pResult, const float* pMask, unsigned int pFirst, unsigned int pLast)
+{
+    for (unsigned int i = pFirst; i < pLast; ++i)
+    {
+        const float w = pMask != nullptr ? pWeight * pMask[i] : pWeight;
+
+        for (unsigned int c = TRANSLATION; c < TRANSLATION + 3; ++c)
+            pResult[c][i] = pFrom[c][i] + (pTo[c][i] - pFrom[c][i]) * w;
+
+        for (unsigned int c = SCALING; c < SCALING + 3; ++c)
+            pResult[c][i] = pFrom[c][i] + (pTo[c][i] - pFrom[c][i]) * w;
+
+        float lDot = 0.0f;
+
+        for (unsigned int c = ROTATION; c < ROTATION + 4; ++c)
+            lDot += pFrom[c][i] * pTo[c][i];
+
+        const float lSign = lDot < 0.0f ? -1.0f : 1.0f;
+        float q[4];
+        float lLength = 0.0f;
+
+        for (unsigned int c = 0; c < 4; ++c)
+        {
+            q[c] = pFrom[ROTATION + c][i] + (lSign * pTo[ROTATION + c][i] - pFrom[ROTATION + c][i]) * w;
+            lLength += q[c] * q[c];
+        }
+
+        lLength = std::sqrt(lLength);
+
+        for (unsigned int c = 0; c < 4; ++c)
+            pResult[ROTATION + c][i] = q[c] / lLength;
+    }
+}
+
+void PoseBlending::_additive(const float* const* pBase, const float* const* pAdditive, const float* const* pReference, float pWeight, float* const* pResult, const float* pMask, unsigned int pFirst, unsigned int pLast)
+{
+    for (unsigned int i = pFirst; i < pLast; ++i)
+    {
+        const float w = pMask != nullptr ? pWeight * pMask[i] : pWeight;
+
+        for (unsigned int c = TRANSLATION; c < TRANSLATION + 3; ++c)
+            pResult[c][i] = pBase[c][i] + (pAdditive[c][i] - pReference[c][i]) * w;
+
+        for (unsigned int c = SCALING; c < SCALING + 3; ++c)
+            pResult[c][i] = pBase[c][i] * (1.0f + (pAdditive[c][i] / pReference[c][i] - 1.0f) * w);
+
+        const float rx = pReference[ROTATION][i], ry = pReference[ROTATION + 1][i], rz = pReference[ROTATION + 2][i], rw = pReference[ROTATION + 3][i];
+        const float ax = pAdditive[ROTATION][i], ay = pAdditive[ROTATION + 1][i], az = pAdditive[ROTATION + 2][i], aw = pAdditive[ROTATION + 3][i];
+        const float bx = pBase[ROTATION][i], by = pBase[ROTATION + 1][i], bz = pBase[ROTATION + 2][i], bw = pBase[ROTATION + 3][i];
+
+        // Difference conjugate(reference) * additive
+        float dx = rw * ax + rz * ay - rx * aw - ry * az;
+        float dy = rw * ay + rx * az - ry * aw - rz * ax;
+        float dz = rw * az + ry * ax - rz * aw - rx * ay;
+        float dw = rw * aw + rx * ax + ry * ay + rz * az;
+
+        // Scale the difference along the shortest arc from the identity
+        const float lSign = dw < 0.0f ? -1.0f : 1.0f;
+
+        dx *= lSign * w;
+        dy *= lSign * w;
+        dz *= lSign * w;
+        dw = 1.0f + (lSign * dw - 1.0f) * w;
+
+        const float lLength = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+
+        dx /= lLength;
+        dy /= lLength;
+        dz /= lLength;
+        dw /= lLength;
+
+        // Base * difference
+        pResult[ROTATION][i] = bw * dx + bx * dw + by * dz - bz * dy;
+        pResult[ROTATION + 1][i] = bw * dy - bx * dz + by * dw + bz * dx;
+        pResult[ROTATION + 2][i] = bw * dz + bx * dy - by * dx + bz * dw;
+        pResult[ROTATION + 3][i] = bw * dw - bx * dx - by * dy - bz * dz;
+    }
+}
+
+void PoseBlending::_components(const LocalPose & pPose, const float** pComponents) noexcept
+{
+    for (unsigned int i = 0; i < COMPONENT_COUNT; ++i)
+        pComponents[i] = pPose.component(static_cast<LocalPose::EComponent>(i));
+}
+
+void PoseBlending::_components(LocalPose & pPose, float** pComponents) noexcept
+{
+    for (unsigned int i = 0; i < COMPONENT_COUNT; ++i)
+        pComponents[i] = pPose.component(static_cast<LocalPose::EComponent>(i));
+}
@@ -0,0 +1,90 @@
+//===============================================================================================//
+/*!
+ *  \file      PoseBlending.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include "LocalPose.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class contains the kernels used to blend the local poses of several animation clips
+     *  \details The poses are stored as structure of arrays, so each kernel processes 4 nodes at once with SSE2
+     *           instructions when they are available, and the remaining nodes with scalar code. The result may be
+     *           one of the input poses. A mask contains one weight per node in the range [0,1], multiplied by the
+     *           weight of the blend, e.g. to play an animation on the upper body only (see Skeleton::mask).
+     */
+    class PoseBlending
+    {
+    public:
+        /*!
+         *  \brief Interpolate between two poses: linearly for the translations and scalings, along the shortest arc for the rotations
+         *  @param pFrom is the pose for a weight of 0
+         *  @param pTo is the pose for a weight of 1
+         *  @param pWeight is the blending factor in the range [0,1]
+         *  @param pResult will contain the blended pose, it can be pFrom or pTo
+         *  @param pMask contains one weight per node, or nullptr to use the same weight for all the nodes
+         */
+        static void crossfade(const LocalPose & pFrom, const LocalPose & pTo, float pWeight, LocalPose & pResult, const float* pMask = nullptr);
+
+        /*!
+         *  \brief Add the difference between a pose and a reference pose on top of a base pose
+         *  \details For each node, the difference is reference^-1 * additive and the result is base * difference,
+         *           scaled by the weight. It is used for layers like breathing or aiming over a locomotion clip.
+         *  @param pBase is the pose on which the difference is added
+         *  @param pAdditive is the pose containing the motion to add
+         *  @param pReference is the pose subtracted from pAdditive, usually the first frame of the additive clip
+         *  @param pWeight is the amount of the difference added, in the range [0,1]
+         *  @param pResult will contain the layered pose, it can be pBase
+         *  @param pMask contains one weight per node, or nullptr to use the same weight for all the nodes
+         */
+        static void additive(const LocalPose & pBase, const LocalPose & pAdditive, const LocalPose & pReference, float pWeight, LocalPose & pResult, const float* pMask = nullptr);
+
+    private:
+        /*!
+         *  \brief Helper method to crossfade a range of nodes without SIMD instructions
+         *  @param pFrom points to the components of the pose for a weight of 0
+         *  @param pTo points to the components of the pose for a weight of 1
+         *  @param pWeight is the blending factor in the range [0,1]
+         *  @param pResult points to the components of the blended pose
+         *  @param pMask contains one weight per node, or nullptr
+         *  @param pFirst is the index of the first node to blend
+         *  @param pLast is the index after the last node to blend
+         */
+        static void _crossfade(const float* const* pFrom, const float* const* pTo, float pWeight, float* const* pResult, const float* pMask, unsigned int pFirst, unsigned int pLast);
+
+        /*!
+         *  \brief Helper method to add the difference between two poses on a range of nodes without SIMD instructions
+         *  @param pBase points to the components of the base pose
+         *  @param pAdditive points to the components of the additive pose
+         *  @param pReference points to the components of the reference pose
+         *  @param pWeight is the amount of the difference added, in the range [0,1]
+         *  @param pResult points to the components of the layered pose
+         *  @param pMask contains one weight per node, or nullptr
+         *  @param pFirst is the index of the first node to blend
+         *  @param pLast is the index after the last node to blend
+         */
+        static void _additive(const float* const* pBase, const float* const* pAdditive, const float* const* pReference, float pWeight, float* const* pResult, const float* pMask, unsigned int pFirst, unsigned int pLast);
+
+        /*!
+         *  \brief Helper method to get a pointer on each component of a pose
+         *  @param pPose is the pose
+         *  @param pComponents will contain LocalPose::EComponent::COUNT pointers
+         */
+        static void _components(const LocalPose & pPose, const float** pComponents) noexcept;
+
+        /*!
+         *  \brief Helper method to get a pointer on each component of a pose
+         *  @param pPose is the pose
+         *  @param pComponents will contain LocalPose::EComponent::COUNT pointers
+         */
+        static void _components(LocalPose & pPose, float** pComponents) noexcept;
+
+    }; // class PoseBlending
+
+} // namespace miniGL
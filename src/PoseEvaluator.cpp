@@ -0,0 +1,96 @@
+//===============================================================================================//
+/*!
+ *  \file      PoseEvaluator.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "PoseEvaluator.hpp"
+
+#include <cassert>
+
+using std::vector;
+using miniGL::PoseEvaluator;
+using miniGL::CompressedClip;
+using miniGL::Skeleton;
+using miniGL::JobSystem;
+
+void PoseEvaluator::skeleton(const Skeleton* pSkeleton)
+{
+    clear();
+    mSkeleton = pSkeleton;
+}
+
+unsigned int PoseEvaluator::addInstance(const CompressedClip* pClip, float pTime, float pSpeed)
+{
+    assert(mSkeleton != nullptr && "The skeleton must be set before adding instances");
+    assert(pClip != nullptr);
+
+    mInstances.push_back({pClip, pTime, pSpeed});
+    mWorkspaces.emplace_back();
+    mPalettes.resize(mInstances.size() * mSkeleton->boneCount(), mat4f(1.0f));
+
+    return static_cast<unsigned int>(mInstances.size()) - 1;
+}
+
+PoseEvaluator::Instance & PoseEvaluator::instance(unsigned int pIndex)
+{
+    assert(pIndex < mInstances.size() && "Instance index out of boundaries");
+    return mInstances[pIndex];
+}
+
+unsigned int PoseEvaluator::instanceCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mInstances.size());
+}
+
+unsigned int PoseEvaluator::boneCount(void) const noexcept
+{
+    return mSkeleton != nullptr ? mSkeleton->boneCount() : 0;
+}
+
+void PoseEvaluator::update(float pDeltaTime, JobSystem* pJobSystem)
+{
+    if (mSkeleton == nullptr || mSkeleton->boneCount() == 0)
+        return;
+
+    // The palettes were sized when adding the instances, so each thread only writes in its own part of the buffer
+    if (pJobSystem != nullptr)
+        pJobSystem->parallelFor(instanceCount(), [this, pDeltaTime](unsigned int pBegin, unsigned int pEnd){ _evaluate(pBegin, pEnd, pDeltaTime); });
+    else
+        _evaluate(0, instanceCount(), pDeltaTime);
+}
+
+const mat4f* PoseEvaluator::palette(unsigned int pIndex) const
+{
+    assert(pIndex < mInstances.size() && "Instance index out of boundaries");
+    return mPalettes.data() + pIndex * boneCount();
+}
+
+const vector<mat4f> & PoseEvaluator::palettes(void) const noexcept
+{
+    return mPalettes;
+}
+
+void PoseEvaluator::clear(void)
+{
+    mInstances.clear();
+    mWorkspaces.clear();
+    mPalettes.clear();
+}
+
+void PoseEvaluator::_evaluate(unsigned int pBegin, unsigned int pEnd, float pDeltaTime)
+{
+    const unsigned int lBoneCount = mSkeleton->boneCount();
+
+    for (unsigned int i = pBegin; i < pEnd; ++i)
+    {
+        Instance & rInstance = mInstances[i];
+        Workspace & rWorkspace = mWorkspaces[i];
+
+        rInstance.time += pDeltaTime * rInstance.speed;
+
+        mSkeleton->pose(*rInstance.clip, rInstance.clip->animationTime(rInstance.time), rWorkspace.cursor, rWorkspace.nodeTransforms, mPalettes.data() + i * lBoneCount);
+    }
+}
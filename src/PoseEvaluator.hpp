@@ -0,0 +1,122 @@
+//===============================================================================================//
+/*!
+ *  \file      PoseEvaluator.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include "Algebra.hpp"
+#include "CompressedClip.hpp"
+#include "AnimationCursor.hpp"
+#include "Skeleton.hpp"
+#include "JobSystem.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class animates many instances of the same skinned mesh independently
+     *  \details Each instance has its own clip, time and speed. The poses of all the instances are evaluated in
+     *           parallel and the bone transformations are written in a single buffer: the palette of instance i
+     *           starts at i * boneCount().
+     */
+    class PoseEvaluator
+    {
+    public:
+        struct Instance
+        {
+            const CompressedClip* clip;
+            float time;
+            float speed;
+        };
+
+    public:
+        /*!
+         *  \brief Set the skeleton shared by all the instances and remove the existing instances
+         *  @param pSkeleton is the skeleton of the mesh, it must stay alive as long as this object uses it
+         */
+        void skeleton(const Skeleton* pSkeleton);
+
+        /*!
+         *  \brief Add an animated instance
+         *  @param pClip is the animation played by the instance, it must reference nodes of the skeleton
+         *  @param pTime is the start time in seconds
+         *  @param pSpeed is multiplied by the elapsed time when advancing the animation
+         *  @return the index of the instance
+         */
+        unsigned int addInstance(const CompressedClip* pClip, float pTime = 0.0f, float pSpeed = 1.0f);
+
+        /*!
+         *  \brief Get the animation state of an instance
+         *  @param pIndex is the index of the instance
+         *  @return a reference on the state, to change the clip, time or speed
+         */
+        Instance & instance(unsigned int pIndex);
+
+        /*!
+         *  \brief Get the number of instances
+         *  @return the number of instances
+         */
+        unsigned int instanceCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bones in the palette of each instance
+         *  @return the number of bones in the skeleton
+         */
+        unsigned int boneCount(void) const noexcept;
+
+        /*!
+         *  \brief Advance the time of all the instances and evaluate their poses
+         *  @param pDeltaTime is the time elapsed since the last update, in seconds
+         *  @param pJobSystem runs the evaluation of the instances in parallel, or nullptr to use the calling thread
+         */
+        void update(float pDeltaTime, JobSystem* pJobSystem = nullptr);
+
+        /*!
+         *  \brief Get the bone transformations of an instance (read only)
+         *  @param pIndex is the index of the instance
+         *  @return a pointer on the first of the boneCount() matrices of the instance
+         */
+        const mat4f* palette(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the bone transformations of all the instances (read only)
+         *  @return the buffer with instanceCount() * boneCount() matrices
+         */
+        const std::vector<mat4f> & palettes(void) const noexcept;
+
+        /*!
+         *  \brief Remove all the instances
+         */
+        void clear(void);
+
+    private:
+        /*!
+         *  \brief Helper method to advance the time of some instances and evaluate their poses
+         *  @param pBegin is the index of the first instance
+         *  @param pEnd is the index after the last instance
+         *  @param pDeltaTime is the time elapsed since the last update, in seconds
+         */
+        void _evaluate(unsigned int pBegin, unsigned int pEnd, float pDeltaTime);
+
+        /*!
+         *  \brief Data modified by a single thread while evaluating the pose of an instance
+         */
+        struct Workspace
+        {
+            AnimationCursor cursor;
+            std::vector<mat4f> nodeTransforms;
+        };
+
+        const Skeleton* mSkeleton = nullptr;
+        std::vector<Instance> mInstances;
+        std::vector<Workspace> mWorkspaces;
+        std::vector<mat4f> mPalettes;
+
+    }; // class PoseEvaluator
+
+} // namespace miniGL
@@ -16,12 +16,16 @@
 #include "Constants.hpp"
 #include "Exceptions.hpp"
 #include "GLUtils.hpp"
+#include "GLStateCache.hpp"
+#include "CameraUniformBuffer.hpp"
 
 using std::string;
 using std::to_string;
 using miniGL::Program;
 using miniGL::Shader;
 using miniGL::Constants;
+using miniGL::GLStateCache;
+using miniGL::CameraUniformBuffer;
 
 Program::Program(void)
 :mProgram(0),
@@ -42,7 +46,7 @@ Program::~Program(void)
 {
     if (mProgram != 0)
     {
-        glDeleteProgram(mProgram);
+        GLStateCache::deleteProgram(mProgram);
         mProgram = 0;
         mProgramIsValid = false;
     }
@@ -66,6 +70,9 @@ void Program::link(void)
 {
     glLinkProgram(mProgram);
     _checkErrors(GL_LINK_STATUS);
+
+    // Every program declaring the CameraBlock uniform block reads the camera of the frame
+    CameraUniformBuffer::attach(mProgram);
 }
 
 void Program::validate(void)
@@ -77,7 +84,7 @@ void Program::validate(void)
 
 void Program::use(void) const
 {
-    glUseProgram(mProgram);
+    GLStateCache::useProgram(mProgram);
 }
 
 GLuint Program::id(void) const
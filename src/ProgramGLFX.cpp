@@ -16,9 +16,13 @@
 
 #include "Exceptions.hpp"
 #include "Constants.hpp"
+#include "GLStateCache.hpp"
+#include "CameraUniformBuffer.hpp"
 
 using std::string;
 using miniGL::ProgramGLFX;
+using miniGL::GLStateCache;
+using miniGL::CameraUniformBuffer;
 
 ProgramGLFX::ProgramGLFX(void)
 {
@@ -29,7 +33,7 @@ ProgramGLFX::~ProgramGLFX(void)
 {
     if (mProgram != 0)
     {
-        glDeleteProgram(mProgram);
+        GLStateCache::deleteProgram(mProgram);
         mProgram = 0;
     }
 
@@ -73,12 +77,15 @@ void ProgramGLFX::compileProgram(const string & pProgram)
         throw Exceptions(lMessage, __FILE__, __LINE__);
     }
 
+    // Same as Program::link
+    CameraUniformBuffer::attach(static_cast<GLuint>(mProgram));
+
     mProgramIsValid = true;
 }
 
 void ProgramGLFX::use(void) const
 {
-    glUseProgram(mProgram);
+    GLStateCache::useProgram(mProgram);
 }
 
 GLuint ProgramGLFX::id(void) const
@@ -14,17 +14,19 @@
 
 #include "Algebra.hpp"
 #include "GLUtils.hpp"
+#include "GLStateCache.hpp"
 
 using std::vector;
 using std::chrono::system_clock;
 using std::uniform_real_distribution;
 using std::default_random_engine;
 using miniGL::RandomTexture;
+using miniGL::GLStateCache;
 
 RandomTexture::~RandomTexture(void)
 {
     if (mTextureObject != 0)
-        glDeleteTextures(1, & mTextureObject);
+        GLStateCache::deleteTextures(1, & mTextureObject);
 }
 
 void RandomTexture::init(unsigned int pSize)
@@ -44,7 +46,7 @@ void RandomTexture::init(unsigned int pSize)
     }
 
     glGenTextures(1, & mTextureObject); checkOpenGLState;
-    glBindTexture(GL_TEXTURE_1D, mTextureObject); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_1D, mTextureObject); checkOpenGLState;
     glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB, pSize, 0, GL_RGB, GL_FLOAT, lRandomData.data()); checkOpenGLState;
     glTexParameterf(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); checkOpenGLState;
     glTexParameterf(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); checkOpenGLState;
@@ -55,8 +57,8 @@ void RandomTexture::init(unsigned int pSize)
 
 void RandomTexture::bind(GLenum pTextureUnit)
 {
-    glActiveTexture(pTextureUnit);
-    glBindTexture(GL_TEXTURE_1D, mTextureObject);
+    GLStateCache::activeTexture(pTextureUnit);
+    GLStateCache::bindTexture(GL_TEXTURE_1D, mTextureObject);
 }
 
 
@@ -0,0 +1,154 @@
+//===============================================================================================//
+/*!
+ *  \file      RenderQueue.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "RenderQueue.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+using std::uint64_t;
+using std::uint32_t;
+using miniGL::RenderQueue;
+using miniGL::DrawPacket;
+
+unsigned int RenderQueue::StateChanges::total(void) const noexcept
+{
+    return programs + vaos + frontFaces + textures;
+}
+
+uint64_t RenderQueue::sortKey(const DrawPacket & pPacket) noexcept
+{
+    // The bits of a positive float grow with its value, their 16 most significant bits give buckets that are
+    // thinner close to the camera
+    const float lDepth = std::max(pPacket.depth, 0.0f);
+    uint32_t lDepthBits = 0;
+    std::memcpy(& lDepthBits, & lDepth, sizeof(lDepthBits));
+
+    // pass: 4 bits, program: 12 bits, front face: 1 bit, VAO: 16 bits, texture: 15 bits, depth: 16 bits
+    return (static_cast<uint64_t>(std::min(pPacket.pass, 0xFu)) << 60)
+         | (static_cast<uint64_t>(pPacket.program & 0xFFFu) << 48)
+         | (static_cast<uint64_t>(pPacket.frontFace == GL_CW ? 1 : 0) << 47)
+         | (static_cast<uint64_t>(pPacket.vao & 0xFFFFu) << 31)
+         | (static_cast<uint64_t>(pPacket.colorTexture & 0x7FFFu) << 16)
+         | static_cast<uint64_t>(lDepthBits >> 16);
+}
+
+void RenderQueue::clear(void)
+{
+    mEntries.clear();
+    mKeys.clear();
+}
+
+void RenderQueue::push(const DrawPacket & pPacket, const mat4f* pMatrices)
+{
+    mEntries.push_back(Entry{ & pPacket, pMatrices });
+    mKeys.push_back(sortKey(pPacket));
+}
+
+void RenderQueue::sort(void)
+{
+    const unsigned int lCount = size();
+
+    if (lCount < 2)
+        return;
+
+    // Histograms of the 8 bytes of the keys in a single pass over the keys
+    unsigned int lHistograms[8][256] = {};
+
+    for (uint64_t lKey : mKeys)
+    {
+        for (unsigned int lByte = 0; lByte < 8; ++lByte)
+            ++lHistograms[lByte][(lKey >> (8 * lByte)) & 0xFF];
+    }
+
+    mScratchEntries.resize(lCount);
+    mScratchKeys.resize(lCount);
+
+    // Least significant byte first, each pass is stable so the previous ones stay sorted
+    for (unsigned int lByte = 0; lByte < 8; ++lByte)
+    {
+        unsigned int* rHistogram = lHistograms[lByte];
+
+        // All the keys have the same byte, e.g. the pass or the unused bits of the program
+        if (rHistogram[(mKeys[0] >> (8 * lByte)) & 0xFF] == lCount)
+            continue;
+
+        unsigned int lOffset = 0;
+
+        for (unsigned int i = 0; i < 256; ++i)
+        {
+            const unsigned int lBucketSize = rHistogram[i];
+            rHistogram[i] = lOffset;
+            lOffset += lBucketSize;
+        }
+
+        for (unsigned int i = 0; i < lCount; ++i)
+        {
+            const unsigned int lDestination = rHistogram[(mKeys[i] >> (8 * lByte)) & 0xFF]++;
+
+            mScratchKeys[lDestination] = mKeys[i];
+            mScratchEntries[lDestination] = mEntries[i];
+        }
+
+        mKeys.swap(mScratchKeys);
+        mEntries.swap(mScratchEntries);
+    }
+}
+
+unsigned int RenderQueue::size(void) const noexcept
+{
+    return static_cast<unsigned int>(mEntries.size());
+}
+
+const DrawPacket & RenderQueue::packet(unsigned int pIndex) const
+{
+    assert(pIndex < size() && "Draw packet index out of boundaries");
+
+    return *mEntries[pIndex].packet;
+}
+
+const mat4f* RenderQueue::matrices(unsigned int pIndex) const
+{
+    assert(pIndex < size() && "Draw packet index out of boundaries");
+
+    return mEntries[pIndex].matrices;
+}
+
+RenderQueue::StateChanges RenderQueue::stateChanges(void) const
+{
+    StateChanges lChanges;
+    const DrawPacket* rPrevious = nullptr;
+
+    // Same rules as DrawList::submit: a packet without texture keeps the current one
+    GLuint lTexture = 0;
+
+    for (const Entry & rEntry : mEntries)
+    {
+        const DrawPacket & rPacket = *rEntry.packet;
+
+        if (rPrevious == nullptr || rPacket.program != rPrevious->program)
+            ++lChanges.programs;
+
+        if (rPrevious == nullptr || rPacket.vao != rPrevious->vao)
+            ++lChanges.vaos;
+
+        if (rPrevious == nullptr || rPacket.frontFace != rPrevious->frontFace)
+            ++lChanges.frontFaces;
+
+        if (rPacket.colorTexture != 0 && rPacket.colorTexture != lTexture)
+        {
+            ++lChanges.textures;
+            lTexture = rPacket.colorTexture;
+        }
+
+        rPrevious = & rPacket;
+    }
+
+    return lChanges;
+}
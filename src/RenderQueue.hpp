@@ -0,0 +1,109 @@
+//===============================================================================================//
+/*!
+ *  \file      RenderQueue.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Algebra.hpp"
+#include "DrawPacket.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class orders the draw packets of a frame to minimize the changes of OpenGL state
+     *  \details Each packet gets a 64 bit key made of, from the most significant bits: the pass, the program, the front
+     *           face, the VAO, the texture and a depth bucket. A radix sort on the keys then groups the packets
+     *           sharing the most expensive states, and draws the packets sharing all of them front to back. The queue
+     *           only keeps pointers on the packets, they must stay alive until it is submitted.
+     */
+    class RenderQueue
+    {
+    public:
+        //! Number of times each state changes between 2 consecutive packets
+        struct StateChanges
+        {
+            unsigned int programs = 0;
+            unsigned int vaos = 0;
+            unsigned int frontFaces = 0;
+            unsigned int textures = 0;
+
+            /*!
+             *  \brief Get the number of changes of all the states
+             *  @return the sum of the changes
+             */
+            unsigned int total(void) const noexcept;
+        };
+
+    public:
+        /*!
+         *  \brief Compute the sort key of a packet
+         *  @param pPacket is the packet to sort
+         *  @return the key, the packets with the smallest keys are submitted first
+         */
+        static std::uint64_t sortKey(const DrawPacket & pPacket) noexcept;
+
+        /*!
+         *  \brief Remove all the packets, keeping the memory for the next frame
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Add a packet at the end of the queue
+         *  @param pPacket is the packet to add, it must stay alive until the queue is cleared
+         *  @param pMatrices points on the DrawPacket::matrixCount matrices of the packet
+         */
+        void push(const DrawPacket & pPacket, const mat4f* pMatrices);
+
+        /*!
+         *  \brief Sort the packets by key, the packets with the same key keep their order
+         */
+        void sort(void);
+
+        /*!
+         *  \brief Get the number of packets
+         *  @return the number of packets pushed since the last clear
+         */
+        unsigned int size(void) const noexcept;
+
+        /*!
+         *  \brief Get a packet, in submission order
+         *  @param pIndex is in the range [0, size())
+         *  @return a reference on the packet
+         */
+        const DrawPacket & packet(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the matrices of a packet
+         *  @param pIndex is in the range [0, size())
+         *  @return a pointer on the DrawPacket::matrixCount matrices of the packet
+         */
+        const mat4f* matrices(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Count the state changes when submitting the packets in the current order
+         *  @return the number of changes of each state, the first packet counting as a change
+         */
+        StateChanges stateChanges(void) const;
+
+    private:
+        struct Entry
+        {
+            const DrawPacket* packet;
+            const mat4f* matrices;
+        };
+
+        std::vector<Entry> mEntries;
+        std::vector<std::uint64_t> mKeys;
+        std::vector<Entry> mScratchEntries;
+        std::vector<std::uint64_t> mScratchKeys;
+
+    }; // class RenderQueue
+
+} // namespace miniGL
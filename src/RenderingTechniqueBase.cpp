@@ -8,13 +8,19 @@
 
 #include "RenderingTechniqueBase.hpp"
 
+#include <cmath>
+#include <algorithm>
+
 using std::shared_ptr;
 using std::string;
 using std::vector;
-using std::map;
+using std::function;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
+using miniGL::MeshHandle;
 using miniGL::Camera;
+using miniGL::Frustum;
 
 RenderingTechniqueBase::RenderingTechniqueBase(const string & pName)
 :mName(pName)
@@ -28,12 +34,17 @@ void RenderingTechniqueBase::camera(const shared_ptr<Camera> pCamera)
 
 void RenderingTechniqueBase::addMeshToRender(const string & pName)
 {
-    mMeshToRenderNames.push_back(pName);
+    mMeshesToRender.add(pName);
 }
 
 const vector<string> & RenderingTechniqueBase::meshToRenderNames(void) const
 {
-    return mMeshToRenderNames;
+    return mMeshesToRender.names();
+}
+
+const vector<MeshHandle> & RenderingTechniqueBase::meshToRenderHandles(const MeshRegistry & pMeshes)
+{
+    return mMeshesToRender.handles(pMeshes);
 }
 
 string RenderingTechniqueBase::name(void) const noexcept
@@ -41,26 +52,140 @@ string RenderingTechniqueBase::name(void) const noexcept
     return mName;
 }
 
+const RenderingTechniqueBase::CullingStats & RenderingTechniqueBase::cullingStats(void) const noexcept
+{
+    return mCullingStats;
+}
+
 void RenderingTechniqueBase::name(const string & pName)
 {
     mName = pName;
 }
 
-vector<map<string, MeshAndTransform>::const_iterator> RenderingTechniqueBase::findMeshesToRender(const map<string, MeshAndTransform> & pMeshes) const
+const vector<const MeshAndTransform*> & RenderingTechniqueBase::findMeshesToRender(const MeshRegistry & pMeshes)
+{
+    mCullingStats = CullingStats();
+
+    return mMeshesToRender.meshes(pMeshes);
+}
+
+void RenderingTechniqueBase::cull(const vector<const MeshAndTransform*> & pMeshes, const mat4f & pViewProjection, vector<VisibleTransform> & pVisible)
+{
+    mSphereX.clear();
+    mSphereY.clear();
+    mSphereZ.clear();
+    mSphereRadius.clear();
+    mCandidates.clear();
+
+    // Bounding sphere of each transformed box: transform the center and scale the radius by the largest axis of the world matrix
+    for (const auto rMesh : pMeshes)
+    {
+        const vec3f & rMin = rMesh->mesh->boundsMin();
+        const vec3f & rMax = rMesh->mesh->boundsMax();
+        const vec3f lCenter = (rMin + rMax) * 0.5f;
+        const float lRadius = static_cast<float>((rMax - rMin).length()) * 0.5f;
+
+        for (unsigned int i = 0; i < rMesh->transform.size(); ++i)
+        {
+            const mat4f lWorld = rMesh->transform.world(i);
+
+            float lScale = 0.0f;
+
+            for (unsigned int col = 0; col < 3; ++col)
+                lScale = std::max(lScale, lWorld(0,col) * lWorld(0,col) + lWorld(1,col) * lWorld(1,col) + lWorld(2,col) * lWorld(2,col));
+
+            mSphereX.push_back(lWorld(0,0) * lCenter.x() + lWorld(0,1) * lCenter.y() + lWorld(0,2) * lCenter.z() + lWorld(0,3));
+            mSphereY.push_back(lWorld(1,0) * lCenter.x() + lWorld(1,1) * lCenter.y() + lWorld(1,2) * lCenter.z() + lWorld(1,3));
+            mSphereZ.push_back(lWorld(2,0) * lCenter.x() + lWorld(2,1) * lCenter.y() + lWorld(2,2) * lCenter.z() + lWorld(2,3));
+            mSphereRadius.push_back(lRadius * std::sqrt(lScale));
+
+            mCandidates.push_back({rMesh, i});
+        }
+    }
+
+    const Frustum lFrustum(pViewProjection);
+    lFrustum.cullSpheres(mSphereX.data(), mSphereY.data(), mSphereZ.data(), mSphereRadius.data(), static_cast<unsigned int>(mCandidates.size()), mVisibleSpheres);
+
+    pVisible.clear();
+
+    // The spheres are loose around the boxes, test the world space box of the remaining transforms
+    for (auto lIndex : mVisibleSpheres)
+    {
+        const VisibleTransform & rCandidate = mCandidates[lIndex];
+        const vec3f & rMin = rCandidate.mesh->mesh->boundsMin();
+        const vec3f & rMax = rCandidate.mesh->mesh->boundsMax();
+        const vec3f lHalfSize = (rMax - rMin) * 0.5f;
+        const mat4f lWorld = rCandidate.mesh->transform.world(rCandidate.transform);
+
+        vec3f lMin, lMax;
+
+        for (unsigned int row = 0; row < 3; ++row)
+        {
+            float lExtent = 0.0f;
+
+            for (unsigned int col = 0; col < 3; ++col)
+                lExtent += std::fabs(lWorld(row,col)) * lHalfSize[col];
+
+            const float lCenter = row == 0 ? mSphereX[lIndex] : (row == 1 ? mSphereY[lIndex] : mSphereZ[lIndex]);
+
+            lMin[row] = lCenter - lExtent;
+            lMax[row] = lCenter + lExtent;
+        }
+
+        if (lFrustum.intersectAABB(lMin, lMax))
+            pVisible.push_back(rCandidate);
+    }
+
+    mCullingStats.visible += static_cast<unsigned int>(pVisible.size());
+    mCullingStats.culled += static_cast<unsigned int>(mCandidates.size() - pVisible.size());
+}
+
+void RenderingTechniqueBase::renderInstanced(const vector<VisibleTransform> & pVisible, const mat4f & pViewProjection, const function<void(bool)> & pInstanced, const function<void(const mat4f &, const mat4f &)> & pMatrices)
 {
-    vector<map<string, MeshAndTransform>::const_iterator> lMeshReferences;
-    lMeshReferences.reserve(mMeshToRenderNames.size());
+    size_t lBegin = 0;
 
-    for (auto it = pMeshes.cbegin(); it != pMeshes.cend(); it++)
+    while (lBegin < pVisible.size())
     {
-        for (const auto name : mMeshToRenderNames)
+        const MeshAndTransform & rMesh = *pVisible[lBegin].mesh;
+
+        // The transforms of the same mesh, consecutive after cull
+        size_t lEnd = lBegin + 1;
+
+        while (lEnd < pVisible.size() && pVisible[lEnd].mesh == & rMesh)
+            ++lEnd;
+
+        if (rMesh.mesh->instancing())
         {
-            if (it->first == name)
+            // The matrices are written directly in the instance streams of the mesh
+            const unsigned int lCount = static_cast<unsigned int>(lEnd - lBegin);
+            const MeshBase::InstanceStreams lStreams = rMesh.mesh->mapInstances(lCount);
+
+            for (unsigned int i = 0; i < lCount; ++i)
             {
-                lMeshReferences.push_back(it);
+                mat4f lWorld = rMesh.transform.world(pVisible[lBegin + i].transform);
+                mat4f lWVP = pViewProjection * lWorld;
+
+                // The instance streams are read as columns. The mapped memory is only written, reading it back is slow.
+                lStreams.worlds[i] = lWorld.transpose();
+                lStreams.WVPs[i] = lWVP.transpose();
             }
+
+            pInstanced(true);
+            rMesh.mesh->render(lCount, lStreams.WVPs, lStreams.worlds);
         }
-    }
+        else
+        {
+            pInstanced(false);
 
-    return lMeshReferences;
+            for (size_t i = lBegin; i < lEnd; ++i)
+            {
+                const mat4f & rWorld = rMesh.transform.world(pVisible[i].transform);
+
+                pMatrices(pViewProjection * rWorld, rWorld);
+                rMesh.mesh->render();
+            }
+        }
+
+        lBegin = lEnd;
+    }
 }
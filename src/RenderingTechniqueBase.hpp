@@ -10,19 +10,40 @@
 
 #include <vector>
 #include <string>
-#include <map>
+#include <functional>
 
 #include "Camera.hpp"
+#include "Frustum.hpp"
 #include "MeshAndTransform.hpp"
+#include "MeshRegistry.hpp"
 
 namespace miniGL
 {
     /*!
      *  \brief   This class contains common methods to all rendering techniques
-     *  \details It handles the camera, the names of meshes to render.
+     *  \details It handles the camera, the names of meshes to render and the frustum culling of their transforms.
      */
     class RenderingTechniqueBase
     {
+    public:
+        /*!
+         *  \brief One transform of a mesh that passed the culling test
+         */
+        struct VisibleTransform
+        {
+            const MeshAndTransform* mesh;
+            unsigned int transform;
+        };
+
+        /*!
+         *  \brief Number of transforms tested by cull since the last call to findMeshesToRender, i.e. in the current frame
+         */
+        struct CullingStats
+        {
+            unsigned int visible = 0;
+            unsigned int culled = 0;
+        };
+
     public:
         /*!
          *  \brief Prevent deriving classes to use the default contructor to force them use the one
@@ -55,12 +76,25 @@ namespace miniGL
          */
         const std::vector<std::string> & meshToRenderNames(void) const;
 
+        /*!
+         *  \brief Get the handles of the meshes to be rendered, the names are only resolved the first time
+         *  @param pMeshes is the registry containing the meshes
+         *  @return a reference on a vector with the handles of the meshes in pMeshes
+         */
+        const std::vector<MeshHandle> & meshToRenderHandles(const MeshRegistry & pMeshes);
+
         /*!
          *  \brief Get the name of the rendering technique
          *  @return the name of the class that will derive from this one
          */
         std::string name(void) const noexcept;
 
+        /*!
+         *  \brief Get the result of the culling tests of the current frame, summed over all the views (camera, lights...)
+         *  @return the number of visible and culled transforms
+         */
+        const CullingStats & cullingStats(void) const noexcept;
+
     protected:
         /*!
          *  \brief Set the name of the rendering technique
@@ -69,16 +103,48 @@ namespace miniGL
         void name(const std::string & pName);
 
         /*!
-         *  \brief Helper method to match the names of the meshes to render by this technique with
-         *         all the meshes in the input container
-         *  @param pMeshes is the container where this method will look for the meshes to render
+         *  \brief Helper method to get the meshes to render by this technique from the registry, without looking for
+         *         their names again
+         *  @param pMeshes is the registry containing the meshes to render
+         *  @return a reference on pointers to the meshes, valid until a mesh is added to pMeshes
+         *  \note The culling stats are reset, this method is called once at the beginning of each frame
+         */
+        const std::vector<const MeshAndTransform*> & findMeshesToRender(const MeshRegistry & pMeshes);
+
+        /*!
+         *  \brief Find the transforms of the meshes whose bounding box is (at least partially) inside a view frustum
+         *  @param pMeshes contains the meshes to test, e.g. returned by findMeshesToRender
+         *  @param pViewProjection is the projection * view matrix of the camera or of the light rendering the view
+         *  @param pVisible is cleared and filled with the visible transforms, in the order of pMeshes
          */
-        std::vector<std::map<std::string, MeshAndTransform>::const_iterator> findMeshesToRender(const std::map<std::string, MeshAndTransform> & pMeshes) const;
+        void cull(const std::vector<const MeshAndTransform*> & pMeshes, const mat4f & pViewProjection, std::vector<VisibleTransform> & pVisible);
+
+        /*!
+         *  \brief Draw the visible transforms with one instanced draw call per mesh, the meshes that cannot be
+         *         instanced (see MeshBase::instancing) are drawn once per transform
+         *  @param pVisible contains the transforms to draw, e.g. filled by cull, those of a mesh must be consecutive
+         *  @param pViewProjection is the projection * view matrix of the camera or of the light rendering the view
+         *  @param pInstanced is called with true before an instanced draw call and false before the other ones, so
+         *         that the program in use reads its matrices from the instance streams or from its uniforms
+         *  @param pMatrices is called before each draw call that is not instanced, with the WVP and world matrices
+         */
+        void renderInstanced(const std::vector<VisibleTransform> & pVisible, const mat4f & pViewProjection, const std::function<void(bool pInstanced)> & pInstanced, const std::function<void(const mat4f & pWVP, const mat4f & pWorld)> & pMatrices);
 
     protected:
-        std::vector<std::string> mMeshToRenderNames;
+        MeshSelection mMeshesToRender;
         std::shared_ptr<Camera> mCamera;
         std::string mName;
+        CullingStats mCullingStats;
+        std::vector<VisibleTransform> mVisibleTransforms;   //!< Result of cull for the view being rendered
+
+    private:
+        // Bounding spheres of the transforms tested by cull, stored by component for Frustum::cullSpheres
+        std::vector<float> mSphereX;
+        std::vector<float> mSphereY;
+        std::vector<float> mSphereZ;
+        std::vector<float> mSphereRadius;
+        std::vector<VisibleTransform> mCandidates;
+        std::vector<unsigned int> mVisibleSpheres;
 
     }; // class RenderingTechniqueBase
 
@@ -45,6 +45,7 @@ void SSAOGeometryPass::init(void)
     use();
 
     mWVPLocation = Program::uniformLocation("uWVP");
+    mInstancedLocation = Program::uniformLocation("uInstanced");
 
     // Check if we correctly initialized the uniform variables
     if (!checkUniformLocations())
@@ -56,7 +57,13 @@ void SSAOGeometryPass::WVP(const mat4f & pWVP)
     glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f &>(pWVP).data());
 }
 
+void SSAOGeometryPass::instanced(bool pValue)
+{
+    glUniform1i(mInstancedLocation, pValue ? 1 : 0);
+}
+
 bool SSAOGeometryPass::checkUniformLocations(void) const
 {
-    return (mWVPLocation != Constants::invalidUniformLocation<GLuint>());
+    return (mWVPLocation != Constants::invalidUniformLocation<GLuint>() &&
+            mInstancedLocation != Constants::invalidUniformLocation<GLuint>());
 }
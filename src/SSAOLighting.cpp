@@ -72,11 +72,9 @@ void SSAOLighting::init(unsigned int pPointLightCount, unsigned int pSpotLightCo
     // Init uniform locations
     mSamplerLocation = Program::uniformLocation("uSampler");
     mUseSamplerLocation = Program::uniformLocation("uUseSampler");
-    mEyeWorldPosLocation = Program::uniformLocation("uEyeWorldPos");
     mMaterialSpecularIntensityLocation = Program::uniformLocation("uMaterialSpecularIntensity");
     mMaterialSpecularPowerLocation = Program::uniformLocation("uMaterialSpecularPower");
 
-    mWVPLocation = Program::uniformLocation("uWVP");
     mWorldLocation = Program::uniformLocation("uWorld");
     mShaderTypeLocation = Program::uniformLocation("uShaderType");
     mScreenSizeLocation = Program::uniformLocation("uScreenSize");
@@ -96,11 +94,6 @@ void SSAOLighting::init(unsigned int pPointLightCount, unsigned int pSpotLightCo
     useSampler(true);
 }
 
-void SSAOLighting::WVP(const mat4f & pWVP)
-{
-    glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
-}
-
 void SSAOLighting::world(const mat4f & pWorld)
 {
     glUniformMatrix4fv(mWorldLocation, 1, GL_TRUE, const_cast<mat4f&>(pWorld).data());
@@ -132,10 +125,8 @@ bool SSAOLighting::checkUniformLocations(void) const
 
     lRes &= mSamplerLocation != Constants::invalidUniformLocation<GLuint>();
     lRes &= mUseSamplerLocation != Constants::invalidUniformLocation<GLuint>();
-    lRes &= mEyeWorldPosLocation != Constants::invalidUniformLocation<GLuint>();
     lRes &= mMaterialSpecularIntensityLocation != Constants::invalidUniformLocation<GLuint>();
     lRes &= mMaterialSpecularPowerLocation != Constants::invalidUniformLocation<GLuint>();
-    lRes &= mWVPLocation != Constants::invalidUniformLocation<GLuint>();
     lRes &= mWorldLocation != Constants::invalidUniformLocation<GLuint>();
     lRes &= mShaderTypeLocation != Constants::invalidUniformLocation<GLuint>();
     lRes &= mScreenSizeLocation != Constants::invalidUniformLocation<GLuint>();
@@ -34,12 +34,6 @@ namespace miniGL
          */
         virtual void init(unsigned int pPointLightCount, unsigned int pSpotLightCount);
 
-        /*!
-         *  \brief Set the world view projection matrix
-         *  @param pWVP is a 4x4 matrix
-         */
-        void WVP(const mat4f & pWVP);
-
         /*!
          *  \brief Set the world matrix
          *  @param pWorld is a 4x4 matrix
@@ -81,11 +75,9 @@ namespace miniGL
     private:
         GLuint mSamplerLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mUseSamplerLocation = Constants::invalidUniformLocation<GLuint>();
-        GLuint mEyeWorldPosLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mMaterialSpecularIntensityLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mMaterialSpecularPowerLocation = Constants::invalidUniformLocation<GLuint>();
 
-        GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mWorldLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mShaderTypeLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mScreenSizeLocation = Constants::invalidUniformLocation<GLuint>();
@@ -9,8 +9,8 @@
 #include "SSAOTechnique.hpp"
 
 #include "EnumClassCast.hpp"
+#include "GLStateCache.hpp"
 
-using std::map;
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -21,7 +21,9 @@ using std::tuple;
 using miniGL::SSAOTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
+using miniGL::GLStateCache;
 
 SSAOTechnique::SSAOTechnique(void)
 :RenderingTechniqueBase("SSAOTechnique")
@@ -67,10 +69,10 @@ void SSAOTechnique::init(unsigned int pPointLightCount, unsigned int pSpotLightC
     mQuad.frontFace(GL_CW);
 }
 
-void SSAOTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void SSAOTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     // Find the meshes to render
-    auto lMeshReferences = findMeshesToRender(pMeshes);
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
 
     // Summary of steps required to populate depth buffer
     //  - We begin with the object space position of a vertex and multiply it with the WVP matrix which is a combined transformations of local-to-world,
@@ -104,7 +106,7 @@ SSAOTechnique::EShaderType SSAOTechnique::shaderType(void) const noexcept
     return mSSAOShaderType;
 }
 
-void SSAOTechnique::_geometryPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators)
+void SSAOTechnique::_geometryPass(const vector<const MeshAndTransform*> & pMeshes)
 {
     mSSAOGeometryPass->use();
 
@@ -112,18 +114,14 @@ void SSAOTechnique::_geometryPass(vector<map<string, MeshAndTransform>::const_it
 
     glClear(GL_DEPTH_BUFFER_BIT);
 
-    for (auto it : pMeshIterators)
-    {
-        for (auto transformation : it->second.transform)
-        {
-            mat4f lWorld = transformation.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    const mat4f lViewProjection = mCamera->viewProjection();
 
-            mSSAOGeometryPass->WVP(lWVP);
+    cull(pMeshes, lViewProjection, mVisibleTransforms);
 
-            it->second.mesh->render();
-        }
-    }
+    renderInstanced(mVisibleTransforms, lViewProjection, [this](bool pInstanced){ mSSAOGeometryPass->instanced(pInstanced); }, [this](const mat4f & pWVP, const mat4f &)
+    {
+        mSSAOGeometryPass->WVP(pWVP);
+    });
 }
 
 void SSAOTechnique::_SSAOPass(void)
@@ -152,7 +150,7 @@ void SSAOTechnique::_blurPass(void)
     mQuad.render();
 }
 
-void SSAOTechnique::_lightingPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, const vector<shared_ptr<BaseLight>> & pLights)
+void SSAOTechnique::_lightingPass(const vector<const MeshAndTransform*> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     mSSAOLighting->use();
     mSSAOLighting->updateLightsState(pLights);
@@ -160,21 +158,19 @@ void SSAOTechnique::_lightingPass(vector<map<string, MeshAndTransform>::const_it
 
     mSSAOLighting->bindAOBuffer(mSSAOBlurBuffer);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    for (auto it : pMeshIterators)
+    // The camera did not move since the geometry pass, reuse its visible transforms
+    for (const auto & rVisible : mVisibleTransforms)
     {
-        for (auto transformation : it->second.transform)
-        {
-            mat4f lWorld = transformation.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+        const MeshAndTransform & rMesh = *rVisible.mesh;
+
+        mat4f lWorld = rMesh.transform.world(rVisible.transform);
 
-            mSSAOLighting->WVP(lWVP);
-            mSSAOLighting->world(lWorld);
+        mSSAOLighting->world(lWorld);
 
-            it->second.mesh->render();
-        }
+        rMesh.mesh->render();
     }
 }
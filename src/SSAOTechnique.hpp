@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "RenderingTechniqueBase.hpp"
@@ -54,7 +53,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Configure the shader type
@@ -93,7 +92,7 @@ namespace miniGL
         /*!
          *  \brief Intermediate step for the Screen Space Ambient Occlusion render
          */
-        void _geometryPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators);
+        void _geometryPass(const std::vector<const MeshAndTransform*> & pMeshes);
 
         /*!
          *  \brief Intermediate step for the Screen Space Ambient Occlusion render
@@ -108,7 +107,7 @@ namespace miniGL
         /*!
          *  \brief Intermediate step for the Screen Space Ambient Occlusion render
          */
-        void _lightingPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void _lightingPass(const std::vector<const MeshAndTransform*> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
     private:
         std::unique_ptr<SSAORender> mSSAORender;
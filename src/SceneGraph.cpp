@@ -0,0 +1,270 @@
+//===============================================================================================//
+/*!
+ *  \file      SceneGraph.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "SceneGraph.hpp"
+
+#include <cassert>
+#include <limits>
+#include <atomic>
+#include <algorithm>
+
+// Below this number of nodes in a level, waking up the threads costs more than computing the matrices
+#define SCENE_GRAPH_PARALLEL_MIN 1024
+
+using std::vector;
+using std::numeric_limits;
+using std::atomic;
+using miniGL::SceneGraph;
+using miniGL::SceneNodeHandle;
+using miniGL::JobSystem;
+
+SceneNodeHandle SceneGraph::invalidHandle(void) noexcept
+{
+    return numeric_limits<SceneNodeHandle>::max();
+}
+
+SceneNodeHandle SceneGraph::add(SceneNodeHandle pParent)
+{
+    assert((pParent == invalidHandle() || pParent < size()) && "Invalid parent node");
+
+    const SceneNodeHandle lHandle = size();
+    const unsigned int lDepth = pParent == invalidHandle() ? 0 : mDepths[pParent] + 1;
+
+    mParents.push_back(pParent);
+    mDepths.push_back(lDepth);
+    mSlots.push_back(lHandle);
+
+    // Appended at the end until the next update sorts the nodes again
+    mParentSlots.push_back(pParent == invalidHandle() ? invalidHandle() : mSlots[pParent]);
+    mLocals.push_back(mat4f(1.0f));
+    mWorlds.push_back(mat4f(1.0f));
+    mVersions.push_back(0);
+    mDirty.push_back(1);
+    mMoved.push_back(0);
+
+    mFirstDirtyDepth = mHasDirty ? std::min(mFirstDirtyDepth, lDepth) : lDepth;
+    mLastDirtyDepth = mHasDirty ? std::max(mLastDirtyDepth, lDepth) : lDepth;
+    mHasDirty = true;
+    mSorted = false;
+
+    return lHandle;
+}
+
+void SceneGraph::clear(void)
+{
+    mParents.clear();
+    mDepths.clear();
+    mSlots.clear();
+    mParentSlots.clear();
+    mLocals.clear();
+    mWorlds.clear();
+    mVersions.clear();
+    mDirty.clear();
+    mMoved.clear();
+    mLevelStarts.clear();
+
+    mHasDirty = false;
+    mSorted = true;
+}
+
+void SceneGraph::local(SceneNodeHandle pNode, const mat4f & pLocal)
+{
+    assert(pNode < size() && "Invalid node");
+
+    const unsigned int lSlot = mSlots[pNode];
+    const unsigned int lDepth = mDepths[pNode];
+
+    mLocals[lSlot] = pLocal;
+    mDirty[lSlot] = 1;
+
+    mFirstDirtyDepth = mHasDirty ? std::min(mFirstDirtyDepth, lDepth) : lDepth;
+    mLastDirtyDepth = mHasDirty ? std::max(mLastDirtyDepth, lDepth) : lDepth;
+    mHasDirty = true;
+}
+
+const mat4f & SceneGraph::local(SceneNodeHandle pNode) const
+{
+    assert(pNode < size() && "Invalid node");
+
+    return mLocals[mSlots[pNode]];
+}
+
+const mat4f & SceneGraph::world(SceneNodeHandle pNode) const
+{
+    assert(pNode < size() && "Invalid node");
+    assert(!mDirty[mSlots[pNode]] && "The node was modified after the last update");
+
+    return mWorlds[mSlots[pNode]];
+}
+
+unsigned int SceneGraph::version(SceneNodeHandle pNode) const
+{
+    assert(pNode < size() && "Invalid node");
+
+    return mVersions[mSlots[pNode]];
+}
+
+SceneNodeHandle SceneGraph::parent(SceneNodeHandle pNode) const
+{
+    assert(pNode < size() && "Invalid node");
+
+    return mParents[pNode];
+}
+
+unsigned int SceneGraph::depth(SceneNodeHandle pNode) const
+{
+    assert(pNode < size() && "Invalid node");
+
+    return mDepths[pNode];
+}
+
+unsigned int SceneGraph::size(void) const noexcept
+{
+    return static_cast<unsigned int>(mParents.size());
+}
+
+unsigned int SceneGraph::levelCount(void) const noexcept
+{
+    return mLevelStarts.empty() ? 0 : static_cast<unsigned int>(mLevelStarts.size()) - 1;
+}
+
+void SceneGraph::update(JobSystem* pJobSystem)
+{
+    if (!mSorted)
+        _sort();
+
+    if (!mHasDirty)
+        return;
+
+    for (unsigned int lLevel = mFirstDirtyDepth; lLevel < levelCount(); ++lLevel)
+    {
+        const unsigned int lBegin = mLevelStarts[lLevel];
+        const unsigned int lCount = mLevelStarts[lLevel + 1] - lBegin;
+        const bool lIgnoreParents = lLevel == mFirstDirtyDepth;
+        bool lMoved = false;
+
+        if (pJobSystem != nullptr && lCount >= SCENE_GRAPH_PARALLEL_MIN)
+        {
+            atomic<bool> lAnyMoved(false);
+
+            pJobSystem->parallelFor(lCount, [this, lBegin, lIgnoreParents, & lAnyMoved](unsigned int pBegin, unsigned int pEnd)
+            {
+                if (_update(lBegin + pBegin, lBegin + pEnd, lIgnoreParents))
+                    lAnyMoved.store(true, std::memory_order_relaxed);
+            });
+
+            lMoved = lAnyMoved.load();
+        }
+        else
+        {
+            lMoved = _update(lBegin, lBegin + lCount, lIgnoreParents);
+        }
+
+        // Nothing moved in this level and the deeper levels were not modified, so their world matrices are still valid
+        if (!lMoved && lLevel >= mLastDirtyDepth)
+            break;
+    }
+
+    mHasDirty = false;
+}
+
+void SceneGraph::_sort(void)
+{
+    const unsigned int lCount = size();
+
+    // Children of each node, in the order they were added
+    vector<SceneNodeHandle> lFirstChild(lCount, invalidHandle());
+    vector<SceneNodeHandle> lNextSibling(lCount, invalidHandle());
+    vector<SceneNodeHandle> lOrder;
+    lOrder.reserve(lCount);
+
+    for (unsigned int i = lCount; i-- > 0; )
+    {
+        if (mParents[i] == invalidHandle())
+        {
+            lOrder.push_back(i);
+        }
+        else
+        {
+            lNextSibling[i] = lFirstChild[mParents[i]];
+            lFirstChild[mParents[i]] = i;
+        }
+    }
+
+    // Breadth-first traversal, the roots first
+    std::reverse(lOrder.begin(), lOrder.end());
+
+    for (unsigned int i = 0; i < lOrder.size(); ++i)
+    {
+        for (SceneNodeHandle lChild = lFirstChild[lOrder[i]]; lChild != invalidHandle(); lChild = lNextSibling[lChild])
+            lOrder.push_back(lChild);
+    }
+
+    assert(lOrder.size() == lCount && "Each node must have a valid parent");
+
+    vector<mat4f> lLocals(lCount), lWorlds(lCount);
+    vector<unsigned int> lVersions(lCount);
+    vector<unsigned char> lDirty(lCount);
+
+    for (unsigned int i = 0; i < lCount; ++i)
+    {
+        const unsigned int lOldSlot = mSlots[lOrder[i]];
+
+        lLocals[i] = mLocals[lOldSlot];
+        lWorlds[i] = mWorlds[lOldSlot];
+        lVersions[i] = mVersions[lOldSlot];
+        lDirty[i] = mDirty[lOldSlot];
+    }
+
+    mLocals.swap(lLocals);
+    mWorlds.swap(lWorlds);
+    mVersions.swap(lVersions);
+    mDirty.swap(lDirty);
+    mMoved.assign(lCount, 0);
+
+    for (unsigned int i = 0; i < lCount; ++i)
+        mSlots[lOrder[i]] = i;
+
+    mLevelStarts.clear();
+
+    for (unsigned int i = 0; i < lCount; ++i)
+    {
+        const SceneNodeHandle lParent = mParents[lOrder[i]];
+        mParentSlots[i] = lParent == invalidHandle() ? invalidHandle() : mSlots[lParent];
+
+        if (mDepths[lOrder[i]] == mLevelStarts.size())
+            mLevelStarts.push_back(i);
+    }
+
+    mLevelStarts.push_back(lCount);
+
+    mSorted = true;
+}
+
+bool SceneGraph::_update(unsigned int pBegin, unsigned int pEnd, bool pIgnoreParents)
+{
+    bool lAnyMoved = false;
+
+    for (unsigned int i = pBegin; i < pEnd; ++i)
+    {
+        const unsigned int lParent = mParentSlots[i];
+        const bool lMoved = mDirty[i] != 0 || (!pIgnoreParents && lParent != invalidHandle() && mMoved[lParent] != 0);
+
+        mMoved[i] = lMoved ? 1 : 0;
+
+        if (!lMoved)
+            continue;
+
+        mWorlds[i] = lParent != invalidHandle() ? mWorlds[lParent] * mLocals[i] : mLocals[i];
+        ++mVersions[i];
+        mDirty[i] = 0;
+        lAnyMoved = true;
+    }
+
+    return lAnyMoved;
+}
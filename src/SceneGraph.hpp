@@ -0,0 +1,148 @@
+//===============================================================================================//
+/*!
+ *  \file      SceneGraph.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include "Algebra.hpp"
+#include "JobSystem.hpp"
+
+namespace miniGL
+{
+    //! Identifier of a node in a SceneGraph, it stays valid until the graph is cleared
+    using SceneNodeHandle = unsigned int;
+
+    /*!
+     *  \brief   This class stores a hierarchy of local transforms and computes their world matrices
+     *  \details The nodes are stored in flat arrays sorted in breadth-first order, so that the nodes of a level are
+     *           contiguous and their parents are all in the previous level. The world matrices are computed level by
+     *           level, starting at the shallowest modified node, and each level is split between the threads of a
+     *           JobSystem. Only the modified nodes and their descendants are computed again, and each of them gets a
+     *           new version number so that the objects attached to a node (e.g. the instances of a TransformStore) know
+     *           when to update.
+     */
+    class SceneGraph
+    {
+    public:
+        /*!
+         *  \brief Get the value used for "no node", e.g. the parent of a root
+         *  @return the invalid handle
+         */
+        static SceneNodeHandle invalidHandle(void) noexcept;
+
+        /*!
+         *  \brief Add a node with an identity local transform
+         *  @param pParent is the handle of an existing node, or invalidHandle() to add a root
+         *  @return the handle of the new node
+         */
+        SceneNodeHandle add(SceneNodeHandle pParent = invalidHandle());
+
+        /*!
+         *  \brief Remove all the nodes
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Set the transform of a node relative to its parent
+         *  @param pNode is a valid handle
+         *  @param pLocal is the local transform, e.g. Transform::final()
+         */
+        void local(SceneNodeHandle pNode, const mat4f & pLocal);
+
+        /*!
+         *  \brief Get the transform of a node relative to its parent
+         *  @param pNode is a valid handle
+         *  @return a reference on the local transform
+         */
+        const mat4f & local(SceneNodeHandle pNode) const;
+
+        /*!
+         *  \brief Get the world matrix of a node, computed by the last update
+         *  @param pNode is a valid handle
+         *  @return a reference on the product of the local transforms from the root to the node
+         */
+        const mat4f & world(SceneNodeHandle pNode) const;
+
+        /*!
+         *  \brief Get the number of times the world matrix of a node was computed
+         *  @param pNode is a valid handle
+         *  @return a number that changes each time the world matrix changes
+         */
+        unsigned int version(SceneNodeHandle pNode) const;
+
+        /*!
+         *  \brief Get the parent of a node
+         *  @param pNode is a valid handle
+         *  @return the handle of the parent, or invalidHandle() for a root
+         */
+        SceneNodeHandle parent(SceneNodeHandle pNode) const;
+
+        /*!
+         *  \brief Get the depth of a node
+         *  @param pNode is a valid handle
+         *  @return 0 for a root, 1 for its children, etc.
+         */
+        unsigned int depth(SceneNodeHandle pNode) const;
+
+        /*!
+         *  \brief Get the number of nodes
+         *  @return the number of nodes added since the last clear
+         */
+        unsigned int size(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of levels of the hierarchy
+         *  @return the depth of the deepest node + 1, as sorted by the last update
+         */
+        unsigned int levelCount(void) const noexcept;
+
+        /*!
+         *  \brief Compute the world matrices of the modified nodes and of their descendants
+         *  @param pJobSystem splits the nodes of each level between several threads, or nullptr to use the calling thread
+         */
+        void update(JobSystem* pJobSystem = nullptr);
+
+    private:
+        /*!
+         *  \brief Helper method to sort the nodes in breadth-first order after nodes were added
+         */
+        void _sort(void);
+
+        /*!
+         *  \brief Helper method to compute the world matrices of a range of nodes of the same level
+         *  @param pBegin is the index of the first node in the sorted arrays
+         *  @param pEnd is the index after the last node
+         *  @param pIgnoreParents is true for the first updated level, whose parents did not move
+         *  @return true if at least one world matrix was computed
+         */
+        bool _update(unsigned int pBegin, unsigned int pEnd, bool pIgnoreParents);
+
+    private:
+        // Indexed by handle
+        std::vector<SceneNodeHandle> mParents;
+        std::vector<unsigned int> mDepths;
+        std::vector<unsigned int> mSlots;           //!< Index of each node in the sorted arrays
+
+        // Indexed by slot, in breadth-first order
+        std::vector<unsigned int> mParentSlots;
+        std::vector<mat4f> mLocals;
+        std::vector<mat4f> mWorlds;
+        std::vector<unsigned int> mVersions;
+        std::vector<unsigned char> mDirty;          //!< The local transform changed since the last update
+        std::vector<unsigned char> mMoved;          //!< The world matrix changed during the last update
+        std::vector<unsigned int> mLevelStarts;     //!< First slot of each level, followed by the number of nodes
+
+        unsigned int mFirstDirtyDepth = 0;
+        unsigned int mLastDirtyDepth = 0;
+        bool mHasDirty = false;
+        bool mSorted = true;
+
+    }; // class SceneGraph
+
+} // namespace miniGL
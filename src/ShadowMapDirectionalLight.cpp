@@ -51,6 +51,7 @@ void ShadowMapDirectionalLight::init(const std::string & pPathVS, const std::str
     use();
 
     mWVPLocation = Program::uniformLocation("uWVP");
+    mInstancedLocation = Program::uniformLocation("uInstanced");
 
     // Check if we correctly initialized the uniform variables
     if (!checkUniformLocations())
@@ -62,7 +63,13 @@ void ShadowMapDirectionalLight::WVP(const mat4f & pWVP)
     glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f &>(pWVP).data());
 }
 
+void ShadowMapDirectionalLight::instanced(bool pValue)
+{
+    glUniform1i(mInstancedLocation, pValue ? 1 : 0);
+}
+
 bool ShadowMapDirectionalLight::checkUniformLocations(void) const
 {
-    return mWVPLocation != Constants::invalidUniformLocation<GLuint>();
+    return (mWVPLocation != Constants::invalidUniformLocation<GLuint>() &&
+            mInstancedLocation != Constants::invalidUniformLocation<GLuint>());
 }
@@ -44,6 +44,7 @@ void ShadowMapDirectionalLightLighting::init(const string & pPathVS, const strin
     use();
 
     mWVPLocation = Program::uniformLocation("uWVP");
+    mInstancedLocation = Program::uniformLocation("uInstanced");
     mLightWVPLocation = Program::uniformLocation("uLightWVP");
     mWorldLocation = Program::uniformLocation("uWorld");
     mColorMapLocation = Program::uniformLocation("uSampler");
@@ -72,6 +73,11 @@ void ShadowMapDirectionalLightLighting::WVP(const mat4f & pWVP)
     glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
 }
 
+void ShadowMapDirectionalLightLighting::instanced(bool pValue)
+{
+    glUniform1i(mInstancedLocation, pValue ? 1 : 0);
+}
+
 void ShadowMapDirectionalLightLighting::lightWVP(const mat4f & pWVP)
 {
     glUniformMatrix4fv(mLightWVPLocation, 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
@@ -137,6 +143,7 @@ bool ShadowMapDirectionalLightLighting::checkUniformLocations(void) const
             mDirectionalLightDirectionLocation != Constants::invalidUniformLocation<GLuint>()   &&
             mDirectionalLightDiffuseLocation != Constants::invalidUniformLocation<GLuint>()     &&
             mWVPLocation != Constants::invalidUniformLocation<GLuint>()                         &&
+            mInstancedLocation != Constants::invalidUniformLocation<GLuint>()                   &&
             mLightWVPLocation != Constants::invalidUniformLocation<GLuint>()                    &&
             mWorldLocation != Constants::invalidUniformLocation<GLuint>()                        &&
             mColorMapLocation != Constants::invalidUniformLocation<GLuint>()                    &&
@@ -43,6 +43,13 @@ namespace miniGL
          */
         void WVP(const mat4f & pWVP);
 
+        /*!
+         *  \brief Choose where the vertex shader reads the matrices
+         *  @param pValue is true to read them from the instance streams of the mesh (see MeshBase::instancing),
+         *         false to read them from the uniforms
+         */
+        void instanced(bool pValue);
+
         /*!
          *  \brief Set the world view projection matrix from the light point of view
          *  @param pLightWVP is a 4x4 matrix
@@ -111,6 +118,7 @@ namespace miniGL
         GLuint mDirectionalLightDiffuseLocation = Constants::invalidUniformLocation<GLuint>();
 
         GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mInstancedLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mLightWVPLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mWorldLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mColorMapLocation = Constants::invalidUniformLocation<GLuint>();
@@ -10,8 +10,8 @@
 #include "ShadowMapDirectionalLightTechnique.hpp"
 
 #include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
 
-using std::map;
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -25,8 +25,10 @@ using miniGL::ShadowMapDirectionalLight;
 using miniGL::ShadowMapDirectionalLightLighting;
 using miniGL::ShadowMapDirectionalLightTechnique;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
 using miniGL::DirectionalLight;
+using miniGL::GLStateCache;
 
 ShadowMapDirectionalLightTechnique::ShadowMapDirectionalLightTechnique(void)
 :RenderingTechniqueBase("ShadowMapDirectionalLightTechnique")
@@ -50,27 +52,28 @@ void ShadowMapDirectionalLightTechnique::init(const tuple<unsigned int, unsigned
     mShadowMapDirectionalLightLighting->materialSpecularPower(0.0f);
 }
 
-void ShadowMapDirectionalLightTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void ShadowMapDirectionalLightTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     // Find the meshes to render
-    auto lMeshReferences = findMeshesToRender(pMeshes);
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
 
     // Find the mesh representing the "floor"
-    auto lFloorIterator = pMeshes.find(mFloorMeshName);
-    assert(lFloorIterator != pMeshes.end());
+    const auto & rFloor = mFloorMesh.meshes(pMeshes);
+    assert(rFloor.size() == 1 && "The floor is not in the mesh registry");
 
     assert(pLights[0]->type() == BaseLight::EType::DIRECTIONAL);
 
     _shadowPass(lMeshReferences, static_pointer_cast<DirectionalLight>(pLights[0]));
-    _renderPass(lMeshReferences, lFloorIterator, static_pointer_cast<DirectionalLight>(pLights[0]));
+    _renderPass(lMeshReferences, *rFloor[0], static_pointer_cast<DirectionalLight>(pLights[0]));
 }
 
 void ShadowMapDirectionalLightTechnique::floor(const string & pName)
 {
-    mFloorMeshName = pName;
+    mFloorMesh.clear();
+    mFloorMesh.add(pName);
 }
 
-void ShadowMapDirectionalLightTechnique::_shadowPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, shared_ptr<DirectionalLight> pDirectionalLight)
+void ShadowMapDirectionalLightTechnique::_shadowPass(const vector<const MeshAndTransform*> & pMeshes, shared_ptr<DirectionalLight> pDirectionalLight)
 {
     mShadowMapFBO->bindForWriting();
     glClear(GL_DEPTH_BUFFER_BIT);
@@ -83,23 +86,20 @@ void ShadowMapDirectionalLightTechnique::_shadowPass(vector<map<string, MeshAndT
     lTmpCamera.lookAt(pDirectionalLight->direction());
     lTmpCamera.up(vec3f(0.0f, 1.0f, 0.0f));
 
-    for (auto it : pMeshIterators)
-    {
-        for (auto transform : it->second.transform)
-        {
-            mat4f lWorld = transform.final();
-            mat4f lWVP = lTmpCamera.orthogonalProjection(0) * lTmpCamera.view() * lWorld;
+    // Only render the meshes inside the light frustum
+    const mat4f lLightViewProjection = lTmpCamera.orthogonalProjection(0) * lTmpCamera.view();
 
-            mShadowMapDirectionalLight->WVP(lWVP);
+    cull(pMeshes, lLightViewProjection, mVisibleTransforms);
 
-            it->second.mesh->render();
-        }
-    }
+    renderInstanced(mVisibleTransforms, lLightViewProjection, [this](bool pInstanced){ mShadowMapDirectionalLight->instanced(pInstanced); }, [this](const mat4f & pWVP, const mat4f &)
+    {
+        mShadowMapDirectionalLight->WVP(pWVP);
+    });
 }
 
-void ShadowMapDirectionalLightTechnique::_renderPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, map<string, MeshAndTransform>::const_iterator & pFloorIterator, shared_ptr<DirectionalLight> pDirectionalLight)
+void ShadowMapDirectionalLightTechnique::_renderPass(const vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, shared_ptr<DirectionalLight> pDirectionalLight)
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     mShadowMapDirectionalLightLighting->use();
@@ -107,7 +107,7 @@ void ShadowMapDirectionalLightTechnique::_renderPass(vector<map<string, MeshAndT
 
     mShadowMapFBO->bindForReading(SHADOW_TEXTURE_UNIT);
 
-    assert(pFloorIterator->second.transform.size() == 1 && "Assumed the floor has only one tranform");
+    assert(pFloor.transform.size() == 1 && "Assumed the floor has only one tranform");
 
     // Set the tmp camera as the directional light
     Camera lTmpCamera = *mCamera;
@@ -116,7 +116,7 @@ void ShadowMapDirectionalLightTechnique::_renderPass(vector<map<string, MeshAndT
     lTmpCamera.up(vec3f(0.0f, 1.0f, 0.0f));
 
     // Configure the WVP for the light with the orthogonal projection
-    mat4f lWorld = pFloorIterator->second.transform[0].final();
+    mat4f lWorld = pFloor.transform.world(0);
     mat4f lLightWVP = lTmpCamera.orthogonalProjection(0) * lTmpCamera.view() * lWorld;
     mShadowMapDirectionalLightLighting->lightWVP(lLightWVP);
 
@@ -124,24 +124,21 @@ void ShadowMapDirectionalLightTechnique::_renderPass(vector<map<string, MeshAndT
     mShadowMapDirectionalLightLighting->updateDirectionalLightState(pDirectionalLight);
 
     // Configure the WVP for the quad, with the normal perspective projection of the camera
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    mat4f lWVP = pFloor.transform.WVP(0);
+    mShadowMapDirectionalLightLighting->instanced(false);
     mShadowMapDirectionalLightLighting->world(lWorld);
     mShadowMapDirectionalLightLighting->WVP(lWVP);
 
     // Render the shadow on the floor
-    pFloorIterator->second.mesh->render();
+    pFloor.mesh->render();
 
-    for (auto it : pMeshIterators)
-    {
-        for (auto transform : it->second.transform)
-        {
-            mat4f lWorld = transform.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view()  * lWorld;
+    const mat4f lViewProjection = mCamera->viewProjection();
 
-            mShadowMapDirectionalLightLighting->world(lWorld);
-            mShadowMapDirectionalLightLighting->WVP(lWVP);
+    cull(pMeshes, lViewProjection, mVisibleTransforms);
 
-            it->second.mesh->render();
-        }
-    }
+    renderInstanced(mVisibleTransforms, lViewProjection, [this](bool pInstanced){ mShadowMapDirectionalLightLighting->instanced(pInstanced); }, [this](const mat4f & pWVP, const mat4f & pWorld)
+    {
+        mShadowMapDirectionalLightLighting->world(pWorld);
+        mShadowMapDirectionalLightLighting->WVP(pWVP);
+    });
 }
@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "RenderingTechniqueBase.hpp"
@@ -43,7 +42,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Set the name of the mesh representing the "floor"
@@ -56,18 +55,18 @@ namespace miniGL
         /*!
          *  \brief Intermediate step to render a directional light with a shadow map
          */
-        void _shadowPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::shared_ptr<DirectionalLight> pDirectionalLight);
+        void _shadowPass(const std::vector<const MeshAndTransform*> & pMeshes, std::shared_ptr<DirectionalLight> pDirectionalLight);
 
         /*!
          *  \brief Intermediate step to render a directional light with a shadow map
          */
-        void _renderPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::map<std::string, MeshAndTransform>::const_iterator & pFloorIterator, std::shared_ptr<DirectionalLight> pDirectionalLight);
+        void _renderPass(const std::vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, std::shared_ptr<DirectionalLight> pDirectionalLight);
 
     private:
         std::unique_ptr<ShadowMapDirectionalLight> mShadowMapDirectionalLight;
         std::unique_ptr<ShadowMapDirectionalLightLighting> mShadowMapDirectionalLightLighting;
         std::unique_ptr<ShadowMapFBO> mShadowMapFBO;
-        std::string mFloorMeshName;
+        MeshSelection mFloorMesh;
     }; // class ShadowMapDirectionalLightTechnique
 
 } // namespace miniGL
@@ -13,11 +13,13 @@
 
 #include "Exceptions.hpp"
 #include "GLUtils.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::to_string;
 using miniGL::ShadowMapFBO;
 using miniGL::Exceptions;
+using miniGL::GLStateCache;
 
 ShadowMapFBO::ShadowMapFBO(void)
 :mFBO(0),
@@ -29,10 +31,10 @@ ShadowMapFBO::ShadowMapFBO(void)
 ShadowMapFBO::~ShadowMapFBO(void)
 {
     if (mFBO != 0)
-        glDeleteFramebuffers(1, & mFBO);
+        GLStateCache::deleteFramebuffers(1, & mFBO);
 
     if (mShadowMap != 0)
-        glDeleteTextures(1, & mShadowMap);
+        GLStateCache::deleteTextures(1, & mShadowMap);
 }
 
 void ShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
@@ -42,7 +44,7 @@ void ShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
 
     // Create the depth buffer
     glGenTextures(1, & mShadowMap); checkOpenGLState;
-    glBindTexture(GL_TEXTURE_2D, mShadowMap); checkOpenGLState;
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mShadowMap); checkOpenGLState;
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32, pWindowWidth, pWindowHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL); checkOpenGLState;
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); checkOpenGLState;
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); checkOpenGLState;
@@ -51,7 +53,7 @@ void ShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); checkOpenGLState;
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); checkOpenGLState;
 
-    glBindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, mFBO); checkOpenGLState;
 
     // Draw the result of the depth test into the texture associated to the frame buffer
     glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, mShadowMap, 0); checkOpenGLState;
@@ -72,11 +74,11 @@ void ShadowMapFBO::init(unsigned int pWindowWidth, unsigned int pWindowHeight)
 
 void ShadowMapFBO::bindForWriting(void)
 {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
+    GLStateCache::bindFramebuffer(GL_DRAW_FRAMEBUFFER, mFBO);
 }
 
 void ShadowMapFBO::bindForReading(GLenum pTextureUnit)
 {
-    glActiveTexture(pTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, mShadowMap);
+    GLStateCache::activeTexture(pTextureUnit);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mShadowMap);
 }
@@ -8,7 +8,8 @@
 
 #include "ShadowVolumeTechnique.hpp"
 
-using std::map;
+#include "GLStateCache.hpp"
+
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -21,10 +22,15 @@ using miniGL::ShadowVolumeTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::Lighting;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
+using miniGL::MeshHandle;
 using miniGL::BaseLight;
+using miniGL::GLStateCache;
+using miniGL::JobSystem;
 
-ShadowVolumeTechnique::ShadowVolumeTechnique(void)
-:RenderingTechniqueBase("ShadowVolumeTechnique")
+ShadowVolumeTechnique::ShadowVolumeTechnique(JobSystem & pJobSystem)
+:RenderingTechniqueBase("ShadowVolumeTechnique"),
+ mJobSystem(pJobSystem)
 {
 }
 
@@ -43,54 +49,52 @@ void ShadowVolumeTechnique::init(unsigned int pPointLightCount, const tuple<unsi
     mShadowVolume->init();
 }
 
-void ShadowVolumeTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void ShadowVolumeTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
-    // Find the meshes to render
-    vector<map<string, MeshAndTransform>::const_iterator> lMeshAdjacenciesReferences;
-    lMeshAdjacenciesReferences.reserve(mMeshToRenderNames.size());
+    // Find the graphical meshes to render, the culling stats are reset at the same time
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
 
-    for (auto it = pMeshes.cbegin(); it != pMeshes.cend(); it++)
-    {
-        for (const auto name : mMeshWithAdjacenciesNames)
-        {
-            if (it->first == name)
-            {
-                lMeshAdjacenciesReferences.push_back(it);
-            }
-        }
-    }
-
-    // Find the graphical meshes to render
-    auto lMeshReferences = findMeshesToRender(pMeshes);
+    // Find the meshes with adjacencies, used to render the shadow volumes
+    const auto & lMeshAdjacenciesReferences = mMeshesWithAdjacencies.meshes(pMeshes);
 
     // Find the mesh representing the "floor"
-    auto lFloorIterator = pMeshes.find(mFloorMeshName);
-    assert(lFloorIterator != pMeshes.end());
+    const auto & rFloor = mFloorMesh.meshes(pMeshes);
+    assert(rFloor.size() == 1 && "The floor is not in the mesh registry");
+
+    // Every pass draws the same pose
+    _skinMeshes(lMeshReferences);
+    _skinMeshes(lMeshAdjacenciesReferences);
 
-    glDepthMask(GL_TRUE);
+    GLStateCache::depthMask(GL_TRUE);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-    _renderSceneIntoDepth(lMeshAdjacenciesReferences, lFloorIterator);
-    glEnable(GL_STENCIL_TEST);
+    _renderSceneIntoDepth(lMeshAdjacenciesReferences, *rFloor[0]);
+    GLStateCache::enable(GL_STENCIL_TEST);
     _renderShadowVolumeIntoStencil(lMeshAdjacenciesReferences, pLights);
-    _renderShadowedScene(lMeshAdjacenciesReferences, lFloorIterator, pLights);
-    glDisable(GL_STENCIL_TEST);
-    _renderAmbientLight(lMeshReferences, lFloorIterator);
+    _renderShadowedScene(lMeshAdjacenciesReferences, *rFloor[0], pLights);
+    GLStateCache::disable(GL_STENCIL_TEST);
+    _renderAmbientLight(lMeshReferences, *rFloor[0]);
 }
 
 void ShadowVolumeTechnique::floor(const string & pName)
 {
-    mFloorMeshName = pName;
+    mFloorMesh.clear();
+    mFloorMesh.add(pName);
 }
 
 void ShadowVolumeTechnique::addMeshWithAdjacenciesToRender(const string & pName)
 {
-    mMeshWithAdjacenciesNames.push_back(pName);
+    mMeshesWithAdjacencies.add(pName);
 }
 
 const vector<string> & ShadowVolumeTechnique::meshWithAdjacenciesNames(void) const
 {
-    return mMeshWithAdjacenciesNames;
+    return mMeshesWithAdjacencies.names();
+}
+
+const vector<MeshHandle> & ShadowVolumeTechnique::meshWithAdjacenciesHandles(const MeshRegistry & pMeshes)
+{
+    return mMeshesWithAdjacencies.handles(pMeshes);
 }
 
 void ShadowVolumeTechnique::pointLightToUseDuringRender(unsigned int pIndex)
@@ -101,43 +105,59 @@ void ShadowVolumeTechnique::pointLightToUseDuringRender(unsigned int pIndex)
     mLighting->lightToUseDuringRender(pIndex);
 }
 
-void ShadowVolumeTechnique::_renderSceneIntoDepth(vector<map<string, MeshAndTransform>::const_iterator> & pMeshAdjacenciesIterators, map<string, MeshAndTransform>::const_iterator & pFloorIterator)
+void ShadowVolumeTechnique::runningTime(float pRunningTime)
+{
+    mRunningTime = pRunningTime;
+}
+
+void ShadowVolumeTechnique::_skinMeshes(const vector<const MeshAndTransform*> & pMeshes)
+{
+    for (const auto rMesh : pMeshes)
+    {
+        if (rMesh->mesh->boneCount() == 0)
+            continue;
+
+        Animation & rAnimation = mAnimations[rMesh->mesh.get()];
+
+        rMesh->mesh->boneTransform(mRunningTime, rAnimation.boneTransforms, rAnimation.cursor, rAnimation.nodeTransforms);
+        rMesh->mesh->skinOnCPU(rAnimation.boneTransforms.data(), & mJobSystem);
+    }
+}
+
+void ShadowVolumeTechnique::_renderSceneIntoDepth(const vector<const MeshAndTransform*> & pMeshesWithAdjacencies, const MeshAndTransform & pFloor)
 {
     glDrawBuffer(GL_NONE);
 
     mNullRender->use();
 
     // Render the meshes
-    for (auto it : pMeshAdjacenciesIterators)
+    const mat4f lViewProjection = mCamera->viewProjection();
+
+    cull(pMeshesWithAdjacencies, lViewProjection, mVisibleTransforms);
+
+    for (const auto & rVisible : mVisibleTransforms)
     {
-        for (auto transform : it->second.transform)
-        {
-            mat4f lWorld = transform.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+        const MeshAndTransform & rMesh = *rVisible.mesh;
 
-            mNullRender->WVP(lWVP);
+        mNullRender->WVP(rMesh.transform.WVP(rVisible.transform));
 
-            it->second.mesh->render();
-        }
+        rMesh.mesh->render();
     }
 
     // Render the "floor"
-    for (auto transform : pFloorIterator->second.transform)
+    for (unsigned int i = 0; i < pFloor.transform.size(); ++i)
     {
-        mat4f lWorld = transform.final();
-        mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+        mNullRender->WVP(pFloor.transform.WVP(i));
 
-        mNullRender->WVP(lWVP);
-
-        pFloorIterator->second.mesh->render();
+        pFloor.mesh->render();
     }
 }
 
-void ShadowVolumeTechnique::_renderShadowVolumeIntoStencil(vector<map<string, MeshAndTransform>::const_iterator> & pMeshAdjacenciesIterators, vector<shared_ptr<BaseLight>> pLights)
+void ShadowVolumeTechnique::_renderShadowVolumeIntoStencil(const vector<const MeshAndTransform*> & pMeshesWithAdjacencies, const vector<shared_ptr<BaseLight>> & pLights)
 {
-    glDepthMask(GL_FALSE);
-    glEnable(GL_DEPTH_CLAMP);
-    glDisable(GL_CULL_FACE);
+    GLStateCache::depthMask(GL_FALSE);
+    GLStateCache::enable(GL_DEPTH_CLAMP);
+    GLStateCache::disable(GL_CULL_FACE);
 
     // The stencil test must be enabled and always succeed.
     // Only the depth test matters
@@ -151,23 +171,22 @@ void ShadowVolumeTechnique::_renderShadowVolumeIntoStencil(vector<map<string, Me
     assert(pLights.at(mPointLightIndex)->type() == BaseLight::EType::POINT);
     mShadowVolume->lightPosition(static_pointer_cast<PointLight>(pLights.at(mPointLightIndex))->position());
 
-    // Render the occluder
-    for (auto it : pMeshAdjacenciesIterators)
+    // Render the occluders, without culling: the volume of an occluder outside of the view can shadow visible meshes
+    for (const auto rMesh : pMeshesWithAdjacencies)
     {
-        for (auto transform : it->second.transform)
+        for (unsigned int i = 0; i < rMesh->transform.size(); ++i)
         {
-            const auto lWorld = transform.final();
-            mShadowVolume->WVP(mCamera->projection() * mCamera->view() * lWorld);
-            it->second.mesh->render();
+            mShadowVolume->WVP(rMesh->transform.WVP(i));
+            rMesh->mesh->render();
         }
     }
 
     // Restore previous state
-    glDisable(GL_DEPTH_CLAMP);
-    glEnable(GL_CULL_FACE);
+    GLStateCache::disable(GL_DEPTH_CLAMP);
+    GLStateCache::enable(GL_CULL_FACE);
 }
 
-void ShadowVolumeTechnique::_renderShadowedScene(vector<map<string, MeshAndTransform>::const_iterator> & pMeshAdjacenciesIterators, map<string, MeshAndTransform>::const_iterator & pFloorIterator, vector<shared_ptr<BaseLight>> pLights)
+void ShadowVolumeTechnique::_renderShadowedScene(const vector<const MeshAndTransform*> & pMeshesWithAdjacencies, const MeshAndTransform & pFloor, const vector<shared_ptr<BaseLight>> & pLights)
 {
     glDrawBuffer(GL_BACK);
 
@@ -182,63 +201,56 @@ void ShadowVolumeTechnique::_renderShadowedScene(vector<map<string, MeshAndTrans
     mLighting->useShadowMap(false);
     mLighting->updateLightsState(pLights);
 
-    mLighting->eyeWorldPosition(mCamera->position());
-
-    for (auto it : pMeshAdjacenciesIterators)
+    // Same view as _renderSceneIntoDepth, reuse its visible transforms
+    for (const auto & rVisible : mVisibleTransforms)
     {
-        for (auto transformation : it->second.transform)
-        {
-            mat4f lWorld = transformation.final();
-            mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+        const MeshAndTransform & rMesh = *rVisible.mesh;
 
-            mLighting->worldMatrix(lWorld);
-            mLighting->WVP(lWVP);
+        mat4f lWorld = rMesh.transform.world(rVisible.transform);
 
-            it->second.mesh->render();
-        }
+        mLighting->worldMatrix(lWorld);
+
+        rMesh.mesh->render();
     }
 
-    assert(pFloorIterator->second.transform.size() == 1 && "Assumed the floor has only one tranform");
-    mat4f lWorld = pFloorIterator->second.transform[0].final();
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    assert(pFloor.transform.size() == 1 && "Assumed the floor has only one tranform");
+    mat4f lWorld = pFloor.transform.world(0);
 
     mLighting->worldMatrix(lWorld);
-    mLighting->WVP(lWVP);
 
     // Render the "floor" with the shadows from the spot light
-    pFloorIterator->second.mesh->render();
+    pFloor.mesh->render();
 
 }
 
-void ShadowVolumeTechnique::_renderAmbientLight(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, map<string, MeshAndTransform>::const_iterator & pFloorIterator)
+void ShadowVolumeTechnique::_renderAmbientLight(const vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor)
 {
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendEquation(GL_FUNC_ADD);
+    GLStateCache::blendFunc(GL_ONE, GL_ONE);
+
+    const mat4f lViewProjection = mCamera->viewProjection();
 
-    for (auto it : pMeshIterators)
+    cull(pMeshes, lViewProjection, mVisibleTransforms);
+
+    for (const auto & rVisible : mVisibleTransforms)
     {
-        for (auto transformation : it->second.transform)
-        {
-            mat4f lWorld2 = transformation.final();
-            mat4f lWVP2 = mCamera->projection() * mCamera->view() * lWorld2;
+        const MeshAndTransform & rMesh = *rVisible.mesh;
 
-            mLighting->worldMatrix(lWorld2);
-            mLighting->WVP(lWVP2);
+        mat4f lWorld2 = rMesh.transform.world(rVisible.transform);
 
-            it->second.mesh->render();
-        }
+        mLighting->worldMatrix(lWorld2);
+
+        rMesh.mesh->render();
     }
 
-    assert(pFloorIterator->second.transform.size() == 1 && "Assumed the floor has only one tranform");
-    mat4f lWorld = pFloorIterator->second.transform[0].final();
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    assert(pFloor.transform.size() == 1 && "Assumed the floor has only one tranform");
+    mat4f lWorld = pFloor.transform.world(0);
 
     mLighting->worldMatrix(lWorld);
-    mLighting->WVP(lWVP);
 
     // Render the "floor" with the shadows from the spot light
-    pFloorIterator->second.mesh->render();
+    pFloor.mesh->render();
 
-    glDisable(GL_BLEND);
+    GLStateCache::disable(GL_BLEND);
 }
@@ -18,6 +18,8 @@
 #include "ShadowVolumeRender.hpp"
 #include "NullRender.hpp"
 #include "Lighting.hpp"
+#include "AnimationCursor.hpp"
+#include "JobSystem.hpp"
 
 namespace miniGL
 {
@@ -29,9 +31,10 @@ namespace miniGL
     {
     public:
         /*!
-         *  \brief Default constructor
+         *  \brief Constructor
+         *  @param pJobSystem deforms the skinned meshes in parallel, it must outlive the technique
          */
-        ShadowVolumeTechnique(void);
+        explicit ShadowVolumeTechnique(JobSystem & pJobSystem);
 
         /*!
          *  \brief Initialize the rendering technique
@@ -46,7 +49,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Set the name of the mesh representing the "floor"
@@ -67,40 +70,71 @@ namespace miniGL
          */
         const std::vector<std::string> & meshWithAdjacenciesNames(void) const;
 
+        /*!
+         *  \brief Get the handles of the meshes with adjacencies, the names are only resolved the first time
+         *  @param pMeshes is the registry containing the meshes
+         *  @return a reference on a vector with the handles of the meshes in pMeshes
+         */
+        const std::vector<MeshHandle> & meshWithAdjacenciesHandles(const MeshRegistry & pMeshes);
+
         /*!
          *  \brief Index of the light which position will be used to compute the silhouette from
          *  @param pIndex is the index of a point light in the lights container
          */
         void pointLightToUseDuringRender(unsigned int pIndex);
 
+        /*!
+         *  \brief Set the running time, i.e. the time since the application started, used to animate the skinned meshes
+         *  @param pRunningTime is the time in seconds
+         */
+        void runningTime(float pRunningTime);
+
     private:
+        /*!
+         *  \brief   Helper method to deform the skinned meshes on the CPU, the shadow volume shaders do not skin the vertices
+         *  \details The instances of a mesh share the pose of the running time
+         *  @param pMeshes contains the meshes to deform, the meshes without bones are skipped
+         */
+        void _skinMeshes(const std::vector<const MeshAndTransform*> & pMeshes);
+
         /*!
          *  \brief Helper method for the Shadow Volume render
          */
-        void _renderSceneIntoDepth(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshAdjacenciesIterators, std::map<std::string, MeshAndTransform>::const_iterator & pFloorIterator);
+        void _renderSceneIntoDepth(const std::vector<const MeshAndTransform*> & pMeshesWithAdjacencies, const MeshAndTransform & pFloor);
 
         /*!
          *  \brief
          */
-        void _renderShadowVolumeIntoStencil(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshAdjacenciesIterators, std::vector<std::shared_ptr<BaseLight>> pLights);
+        void _renderShadowVolumeIntoStencil(const std::vector<const MeshAndTransform*> & pMeshesWithAdjacencies, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief
          */
-        void _renderShadowedScene(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshAdjacenciesIterators, std::map<std::string, MeshAndTransform>::const_iterator & pFloorIterator, std::vector<std::shared_ptr<BaseLight>> pLights);
+        void _renderShadowedScene(const std::vector<const MeshAndTransform*> & pMeshesWithAdjacencies, const MeshAndTransform & pFloor, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief
          */
-        void _renderAmbientLight(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::map<std::string, MeshAndTransform>::const_iterator & pFloorIterator);
+        void _renderAmbientLight(const std::vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor);
 
     private:
+        //! Animation state of a skinned mesh, kept by the technique so that it does not share the cursor of the mesh
+        struct Animation
+        {
+            AnimationCursor cursor;
+            std::vector<mat4f> nodeTransforms;
+            std::vector<mat4f> boneTransforms;
+        };
+
         std::unique_ptr<Lighting> mLighting;
         std::unique_ptr<ShadowVolumeRender> mShadowVolume;
         std::unique_ptr<NullRender> mNullRender;
-        std::vector<std::string> mMeshWithAdjacenciesNames;
-        std::string mFloorMeshName;
+        MeshSelection mMeshesWithAdjacencies;
+        MeshSelection mFloorMesh;
         unsigned int mPointLightIndex = Constants::invalidBufferIndex<unsigned int>();
+        JobSystem & mJobSystem;
+        std::map<const MeshBase*, Animation> mAnimations;
+        float mRunningTime = 0.0f;
 
     }; // class ShadowVolumeTechnique
 
@@ -8,10 +8,11 @@
 
 #include "SilhouetteTechnique.hpp"
 
+#include <functional>
+
 #include "PointLight.hpp"
 #include "SpotLight.hpp"
 
-using std::map;
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -23,7 +24,10 @@ using std::tuple;
 using miniGL::SilhouetteTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
+using miniGL::DrawList;
+using miniGL::DrawPacket;
 
 SilhouetteTechnique::SilhouetteTechnique(void)
 :RenderingTechniqueBase("SilhouetteTechnique")
@@ -34,43 +38,59 @@ void SilhouetteTechnique::init(void)
 {
     mSilhouetteRender = make_unique<SilhouetteRender>();
     mSilhouetteRender->init();
+
+    // Set by the draw list when replaying the packets
+    mWVPLocation = mSilhouetteRender->uniformLocation("uWVP");
+    mWorldLocation = mSilhouetteRender->uniformLocation("uWorld");
 }
 
-void SilhouetteTechnique::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void SilhouetteTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     mSilhouetteRender->use();
 
-    assert(mMeshToRenderNames.size() == 1 && "Rendering only one mesh for the moment");
+    assert(mMeshesToRender.names().size() == 1 && "Rendering only one mesh for the moment");
+
+    // The light is the same for all the transforms
+    if (pLights.at(mLightIndex)->type() == BaseLight::EType::POINT)
+        mSilhouetteRender->lightPosition(static_pointer_cast<PointLight>(pLights.at(mLightIndex))->position());
+    else if (pLights.at(mLightIndex)->type() == BaseLight::EType::SPOT)
+        mSilhouetteRender->lightPosition(static_pointer_cast<SpotLight>(pLights.at(mLightIndex))->position());
+    else
+        assert(false && "Light position must come from a point or a spot light");
 
-    for (auto it = pMeshes.begin(); it != pMeshes.end(); it++)
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
+
+    DrawPacket lPacket;
+    lPacket.program = mSilhouetteRender->id();
+    lPacket.matrixLocations[0] = mWVPLocation;
+    lPacket.matrixLocations[1] = mWorldLocation;
+    lPacket.matrixCount = 2;
+
+    auto lRecordItem = [& lMeshReferences, lPacket](unsigned int pItem, DrawList::Recorder & rRecorder)
     {
-        for (const auto name : mMeshToRenderNames)
+        const MeshAndTransform* rMesh = lMeshReferences[pItem];
+
+        // To be able to render the silhouette of the mesh, the latter needs to be loaded with adjacencies
+        assert(rMesh->mesh->loadOption() == MeshBase::EOptions::ADJACENCIES);
+
+        DrawPacket lMeshPacket = lPacket;
+
+        for (unsigned int j = 0; j < rMesh->transform.size(); ++j)
         {
-            if (it->first == name)
-            {
-                // To be able to render the silhouette of the mesh, the latter needs to be loaded with adjacencies
-                assert(it->second.mesh->loadOption() == MeshBase::EOptions::ADJACENCIES);
-
-                for (auto transformation : it->second.transform)
-                {
-                    mat4f lWorld = transformation.final();
-                    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
-
-                    mSilhouetteRender->WVP(lWVP);
-                    mSilhouetteRender->worldMatrix(lWorld);
-
-                    if (pLights.at(mLightIndex)->type() == BaseLight::EType::POINT)
-                        mSilhouetteRender->lightPosition(static_pointer_cast<PointLight>(pLights.at(mLightIndex))->position());
-                    else if (pLights.at(mLightIndex)->type() == BaseLight::EType::SPOT)
-                        mSilhouetteRender->lightPosition(static_pointer_cast<SpotLight>(pLights.at(mLightIndex))->position());
-                    else
-                        assert(false && "Light position must come from a point or a spot light");
-
-                    it->second.mesh->render();
-                }
-            }
+            const mat4f lMatrices[] = { rMesh->transform.WVP(j), rMesh->transform.world(j) };
+
+            lMeshPacket.depth = lMatrices[0](3,3);
+            lMeshPacket.matrixOffset = rRecorder.matrices(lMatrices, 2);
+            rMesh->mesh->record(rRecorder, lMeshPacket);
         }
-    }
+    };
+
+    // By reference, std::function would copy the captures on the heap
+    mDrawList.record(static_cast<unsigned int>(lMeshReferences.size()), std::cref(lRecordItem));
+
+    // Grouped by VAO and texture, then front to back
+    mDrawList.sort();
+    mDrawList.submit();
 }
 
 void SilhouetteTechnique::lightIndex(unsigned int pIndex)
@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "RenderingTechniqueBase.hpp"
@@ -16,6 +15,7 @@
 #include "BaseLight.hpp"
 #include "SilhouetteRender.hpp"
 #include "Constants.hpp"
+#include "DrawList.hpp"
 
 namespace miniGL
 {
@@ -42,7 +42,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Index of the light which position will be used to compute the silhouette from
@@ -53,6 +53,9 @@ namespace miniGL
     private:
         std::unique_ptr<SilhouetteRender> mSilhouetteRender;
         unsigned int mLightIndex = Constants::invalidBufferIndex<unsigned int>();
+        DrawList mDrawList;
+        GLint mWVPLocation = -1;
+        GLint mWorldLocation = -1;
 
     }; // class SilhouetteTechnique
 
@@ -8,11 +8,13 @@
 
 #include "SimpleLightingWithShadow.hpp"
 
+#include <functional>
+
 #include "SpotLight.hpp"
 #include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
 
 using std::vector;
-using std::map;
 using std::string;
 using std::make_unique;
 using std::shared_ptr;
@@ -21,10 +23,18 @@ using std::get;
 using miniGL::SimpleLightingWithShadow;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
+using miniGL::MeshHandle;
 using miniGL::BaseLight;
-
-SimpleLightingWithShadow::SimpleLightingWithShadow(void)
-:RenderingTechniqueBase("SimpleLightingWithShadow")
+using miniGL::JobSystem;
+using miniGL::DrawList;
+using miniGL::DrawPacket;
+using miniGL::GLStateCache;
+using miniGL::StaticBatchBuilder;
+
+SimpleLightingWithShadow::SimpleLightingWithShadow(JobSystem & pJobSystem)
+:RenderingTechniqueBase("SimpleLightingWithShadow"),
+ mJobSystem(pJobSystem)
 {
 }
 
@@ -43,19 +53,29 @@ void SimpleLightingWithShadow::init(unsigned int pPointLightCount, const std::tu
     mLighting->init(pPointLightCount, lSpotLightCount);
     mLighting->shadowMapSize(get<0>(pFramebufferDimensions), get<1>(pFramebufferDimensions));
 
+    // Set by the draw list when replaying the packets
+    mShadowWVPLocation = mShadowMap->uniformLocation("uWVP");
+    mWorldLocation = mLighting->uniformLocation("uWorld");
+    mLightWVPLocation = mLighting->uniformLocation("uLightWVP");
+    mUseNormalMapLocation = mLighting->uniformLocation("uUseNormalMap");
+
     /*! \todo This normal map should not be stored in this class! */
     mNormalMap.target(GL_TEXTURE_2D);
     mNormalMap.loadImage(R"(./normal_map.jpg)");
 }
 
-void SimpleLightingWithShadow::render(const map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void SimpleLightingWithShadow::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
+    // The static meshes that cannot be batched are added to the meshes to render
+    if (mStaticBatchDirty)
+        _buildStaticBatch(pMeshes);
+
     // Find the meshes to render
-    auto lMeshReferences = findMeshesToRender(pMeshes);
+    const auto & lMeshReferences = findMeshesToRender(pMeshes);
 
     // Find the mesh representing the "floor"
-    auto lFloorIterator = pMeshes.find(mFloorMeshName);
-    assert(lFloorIterator != pMeshes.end());
+    const auto & rFloor = mFloorMesh.meshes(pMeshes);
+    assert(rFloor.size() == 1 && "The floor is not in the mesh registry");
 
     // Find the first spot light among all the lights
     vector<shared_ptr<BaseLight>>::const_iterator lFirstSpotLightIterator = pLights.cbegin();
@@ -69,8 +89,8 @@ void SimpleLightingWithShadow::render(const map<string, MeshAndTransform> & pMes
     if (mUseShadowMap)
         _shadowMapPass(lMeshReferences, lFirstSpotLightIterator);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    _renderWithShadowAndBumpMapping(lMeshReferences, lFloorIterator, pLights, lFirstSpotLightIterator);
+    GLStateCache::bindFramebuffer(GL_FRAMEBUFFER, 0);
+    _renderWithShadowAndBumpMapping(lMeshReferences, *rFloor[0], pLights, lFirstSpotLightIterator);
 }
 
 void SimpleLightingWithShadow::useShadowMap(bool pActivate) noexcept
@@ -80,12 +100,47 @@ void SimpleLightingWithShadow::useShadowMap(bool pActivate) noexcept
 
 void SimpleLightingWithShadow::floor(const string & pName)
 {
-    mFloorMeshName = pName;
+    mFloorMesh.clear();
+    mFloorMesh.add(pName);
+}
+
+void SimpleLightingWithShadow::addStaticMeshToRender(const string & pName)
+{
+    mStaticMeshes.add(pName);
+    mStaticBatchDirty = true;
+}
+
+void SimpleLightingWithShadow::_buildStaticBatch(const MeshRegistry & pMeshes)
+{
+    StaticBatchBuilder lBuilder;
+
+    for (const string & rName : mStaticMeshes.names())
+    {
+        const MeshHandle lHandle = pMeshes.handle(rName);
+
+        if (lHandle == MeshRegistry::invalidHandle())
+            continue;
+
+        const MeshAndTransform & rMesh = pMeshes[lHandle];
+        bool lBatched = rMesh.transform.size() > 0;
+
+        // Only the first transform can fail, the format of the mesh is the same for all of them
+        for (unsigned int j = 0; j < rMesh.transform.size() && lBatched; ++j)
+            lBatched = rMesh.mesh->batch(lBuilder, rMesh.transform.world(j));
+
+        if (!lBatched)
+            addMeshToRender(rName);
+    }
+
+    lBuilder.build();
+    mStaticBatch.upload(lBuilder);
+
+    mStaticBatchDirty = false;
 }
 
-void SimpleLightingWithShadow::_shadowMapPass(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, vector<shared_ptr<BaseLight>>::const_iterator pSpotLightIterator)
+void SimpleLightingWithShadow::_shadowMapPass(const vector<const MeshAndTransform*> & pMeshes, vector<shared_ptr<BaseLight>>::const_iterator pSpotLightIterator)
 {
-    glCullFace(GL_FRONT);
+    GLStateCache::cullFace(GL_FRONT);
 
     mShadowMapFBO->bindForWriting();
 
@@ -99,39 +154,62 @@ void SimpleLightingWithShadow::_shadowMapPass(vector<map<string, MeshAndTransfor
     lTmpCamera.lookAt(static_pointer_cast<SpotLight>(*pSpotLightIterator)->direction());
     lTmpCamera.up(vec3f(0.0f, 1.0f, 0.0f));
 
-    for (auto it : pMeshIterators)
+    const mat4f lLightViewProjection = lTmpCamera.viewProjection();
+
+    DrawPacket lPacket;
+    lPacket.program = mShadowMap->id();
+    lPacket.matrixLocations[0] = mShadowWVPLocation;
+    lPacket.matrixCount = 1;
+
+    // The last item is the static batch, already in world space
+    const unsigned int lItemCount = static_cast<unsigned int>(pMeshes.size()) + (mStaticBatch.empty() ? 0 : 1);
+
+    auto lRecordItem = [this, & pMeshes, & lLightViewProjection, lPacket](unsigned int pItem, DrawList::Recorder & rRecorder)
     {
-        for (auto transform : it->second.transform)
+        DrawPacket lMeshPacket = lPacket;
+
+        if (pItem == pMeshes.size())
         {
-            mat4f lWorld = transform.final();
+            lMeshPacket.depth = lLightViewProjection(3,3);
+            lMeshPacket.matrixOffset = rRecorder.matrices(& lLightViewProjection, 1);
+            mStaticBatch.record(rRecorder, lMeshPacket);
+            return;
+        }
 
-            mat4f lWVP = lTmpCamera.projection() * lTmpCamera.view() * lWorld;
+        const MeshAndTransform* rMesh = pMeshes[pItem];
 
-            mShadowMap->setWVP(lWVP);
+        for (unsigned int j = 0; j < rMesh->transform.size(); ++j)
+        {
+            const mat4f lWVP = lLightViewProjection * rMesh->transform.world(j);
 
-            it->second.mesh->render();
+            lMeshPacket.depth = lWVP(3,3);
+            lMeshPacket.matrixOffset = rRecorder.matrices(& lWVP, 1);
+            rMesh->mesh->record(rRecorder, lMeshPacket);
         }
-    }
+    };
+
+    // By reference, std::function would copy the captures on the heap
+    mDrawList.record(lItemCount, std::cref(lRecordItem), & mJobSystem);
+
+    // Grouped by VAO and texture, then front to back
+    mDrawList.sort();
+    mDrawList.submit();
 }
 
-void SimpleLightingWithShadow::_renderWithShadowAndBumpMapping(vector<map<string, MeshAndTransform>::const_iterator> & pMeshIterators, map<string, MeshAndTransform>::const_iterator & pFloorIterator, vector<shared_ptr<BaseLight>> pLights, vector<shared_ptr<BaseLight>>::const_iterator pSpotLightIterator)
+void SimpleLightingWithShadow::_renderWithShadowAndBumpMapping(const vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, const vector<shared_ptr<BaseLight>> & pLights, vector<shared_ptr<BaseLight>>::const_iterator pSpotLightIterator)
 {
-    glCullFace(GL_BACK);
+    GLStateCache::cullFace(GL_BACK);
 
     mLighting->use();
     mLighting->useShadowMap(mUseShadowMap);
 
-    mLighting->eyeWorldPosition(mCamera->position());
-
     if (mUseShadowMap)
         mShadowMapFBO->bindForReading(SHADOW_TEXTURE_UNIT);
 
-    assert(pFloorIterator->second.transform.size() == 1 && "Assumed the floor has only one tranform");
-    mat4f lWorld = pFloorIterator->second.transform[0].final();
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    assert(pFloor.transform.size() == 1 && "Assumed the floor has only one tranform");
+    mat4f lWorld = pFloor.transform.world(0);
 
     mLighting->worldMatrix(lWorld);
-    mLighting->WVP(lWVP);
 
     // Set the camera at the spot light position
     Camera lLightCamera = *mCamera;
@@ -140,39 +218,67 @@ void SimpleLightingWithShadow::_renderWithShadowAndBumpMapping(vector<map<string
     lLightCamera.lookAt(static_pointer_cast<SpotLight>(*pSpotLightIterator)->direction());
     lLightCamera.up(vec3f(0.0f, 1.0f, 0.0f));
 
-    mat4f lLightWVP = lLightCamera.projection() * lLightCamera.view() * lWorld;
+    const mat4f lLightViewProjection = lLightCamera.viewProjection();
+    mat4f lLightWVP = lLightViewProjection * lWorld;
 
     mLighting->lightWVP(lLightWVP);
 
     mLighting->updateLightsState(pLights);
 
     // Render the "floor" with the shadows from the spot light
-    pFloorIterator->second.mesh->render();
+    pFloor.mesh->render();
 
     mLighting->useShadowMap(false);
 
-    for (auto it : pMeshIterators)
+    // Only the meshes with a tangent space use it, the packets switch the normal mapping on and off
+    mNormalMap.bind(NORMAL_TEXTURE_UNIT);
+
+    DrawPacket lPacket;
+    lPacket.program = mLighting->id();
+    lPacket.matrixLocations[0] = mWorldLocation;
+    lPacket.matrixLocations[1] = mLightWVPLocation;
+    lPacket.matrixCount = 2;
+    lPacket.flagLocation = mUseNormalMapLocation;
+
+    const mat4f lViewProjection = mCamera->viewProjection();
+
+    // The last item is the static batch, already in world space
+    const unsigned int lItemCount = static_cast<unsigned int>(pMeshes.size()) + (mStaticBatch.empty() ? 0 : 1);
+
+    auto lRecordItem = [this, & pMeshes, & lLightViewProjection, & lViewProjection, lPacket](unsigned int pItem, DrawList::Recorder & rRecorder)
     {
-        if(it->second.mesh->loadOption() == MeshBase::EOptions::COMPUTE_TANGENT_SPACE)
+        DrawPacket lMeshPacket = lPacket;
+
+        if (pItem == pMeshes.size())
         {
-            mLighting->useNormalMap(true);
-            mNormalMap.bind(NORMAL_TEXTURE_UNIT);
+            const mat4f lMatrices[] = { mat4f(1.0f), lLightViewProjection };
+
+            lMeshPacket.flagValue = 0;
+            lMeshPacket.depth = lViewProjection(3,3);
+            lMeshPacket.matrixOffset = rRecorder.matrices(lMatrices, 2);
+            mStaticBatch.record(rRecorder, lMeshPacket);
+            return;
         }
-        else
-            mLighting->useNormalMap(false);
 
-        for (auto transformation : it->second.transform)
-        {
-            mat4f lWorld2 = transformation.final();
-            mat4f lWVP2 = mCamera->projection() * mCamera->view() * lWorld2;
+        const MeshAndTransform* rMesh = pMeshes[pItem];
 
-            mLighting->worldMatrix(lWorld2);
-            mLighting->WVP(lWVP2);
+        lMeshPacket.flagValue = rMesh->mesh->loadOption() == MeshBase::EOptions::COMPUTE_TANGENT_SPACE ? 1 : 0;
 
-            mat4f lLightWVP2 = lLightCamera.projection() * lLightCamera.view() * lWorld2;
-            mLighting->lightWVP(lLightWVP2);
+        for (unsigned int j = 0; j < rMesh->transform.size(); ++j)
+        {
+            // The view projection matrix of the camera is in the CameraBlock uniform block
+            const mat4f lMatrices[] = { rMesh->transform.world(j), lLightViewProjection * rMesh->transform.world(j) };
 
-            it->second.mesh->render();
+            lMeshPacket.depth = rMesh->transform.WVP(j)(3,3);
+            lMeshPacket.matrixOffset = rRecorder.matrices(lMatrices, 2);
+            rMesh->mesh->record(rRecorder, lMeshPacket);
         }
-    }
+    };
+
+    // By reference, std::function would copy the captures on the heap
+    mDrawList.record(lItemCount, std::cref(lRecordItem), & mJobSystem);
+
+    // Grouped by VAO and texture, then front to back
+    mDrawList.sort();
+    mDrawList.submit();
 }
@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "RenderingTechniqueBase.hpp"
@@ -18,21 +17,27 @@
 #include "Lighting.hpp"
 #include "BaseLight.hpp"
 #include "Texture.hpp"
+#include "JobSystem.hpp"
+#include "DrawList.hpp"
+#include "StaticBatch.hpp"
 
 namespace miniGL
 {
     /*!
      *  \brief  This class encapsulate all the classes used to provide a light renderer that can compute shadows from a single spot light.
      *  \details The rendering technique supports a directional light, up to 4 point lights and 1 spot light. The shadow is computed using a shadow map.
-     *           The shadow map uses Percentage Closer Filtering.
+     *           The shadow map uses Percentage Closer Filtering. The draw calls of the meshes are recorded in parallel
+     *           in a DrawList, and submitted on the calling thread. The meshes that never move can be merged in a
+     *           StaticBatch, drawn with one draw call per texture.
      */
     class SimpleLightingWithShadow : public RenderingTechniqueBase
     {
     public:
         /*!
-         *  \brief Default constructor
+         *  \brief Constructor
+         *  @param pJobSystem records the draw calls in parallel, it must outlive the technique
          */
-        SimpleLightingWithShadow(void);
+        explicit SimpleLightingWithShadow(JobSystem & pJobSystem);
 
         /*!
          *  \brief Initialize the rendering technique
@@ -47,7 +52,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Render with shadows from a spot light
@@ -62,6 +67,13 @@ namespace miniGL
          */
         void floor(const std::string & pName);
 
+        /*!
+         *  \brief Add the name of a mesh that never moves, it is merged with the other static meshes on the next call to render
+         *  @param pName is the name of the mesh in the mesh container. Its transforms are only read once, and a mesh
+         *         that cannot be batched is rendered as if it was added with addMeshToRender
+         */
+        void addStaticMeshToRender(const std::string & pName);
+
         /*!
          *  \brief Set the indices of the lights that will be used when rendering using a specific technique
          *  @param pFirstIndex is the index of the first light to be added to the rendering technique
@@ -84,22 +96,36 @@ namespace miniGL
         }
 
     private:
+        /*!
+         *  \brief Helper method to merge the static meshes in the static batch
+         */
+        void _buildStaticBatch(const MeshRegistry & pMeshes);
+
         /*!
          *  \brief Helper method to render the shadow in a frame buffer object
          */
-        void _shadowMapPass(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::vector<std::shared_ptr<BaseLight>>::const_iterator pSpotLightIterator);
+        void _shadowMapPass(const std::vector<const MeshAndTransform*> & pMeshes, std::vector<std::shared_ptr<BaseLight>>::const_iterator pSpotLightIterator);
 
         /*!
          *  \brief Helper method to render the meshes using the shadow information
          */
-        void _renderWithShadowAndBumpMapping(std::vector<std::map<std::string, MeshAndTransform>::const_iterator> & pMeshIterators, std::map<std::string, MeshAndTransform>::const_iterator & pFloorIterator, std::vector<std::shared_ptr<BaseLight>> pLights, std::vector<std::shared_ptr<BaseLight>>::const_iterator pSpotLightIterator);
+        void _renderWithShadowAndBumpMapping(const std::vector<const MeshAndTransform*> & pMeshes, const MeshAndTransform & pFloor, const std::vector<std::shared_ptr<BaseLight>> & pLights, std::vector<std::shared_ptr<BaseLight>>::const_iterator pSpotLightIterator);
 
     private:
         Texture mNormalMap;
         std::unique_ptr<ShadowMap> mShadowMap;
         std::unique_ptr<ShadowMapFBO> mShadowMapFBO;
         std::unique_ptr<Lighting> mLighting;
-        std::string mFloorMeshName;
+        JobSystem & mJobSystem;
+        DrawList mDrawList;
+        GLint mShadowWVPLocation = -1;
+        GLint mWorldLocation = -1;
+        GLint mLightWVPLocation = -1;
+        GLint mUseNormalMapLocation = -1;
+        MeshSelection mFloorMesh;
+        MeshSelection mStaticMeshes;
+        StaticBatch mStaticBatch;
+        bool mStaticBatchDirty = false;
         bool mUseShadowMap = true;
     }; // class SimpleLightingWithShadow
 
@@ -0,0 +1,155 @@
+//===============================================================================================//
+/*!
+ *  \file      Skeleton.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "Skeleton.hpp"
+
+#include <cassert>
+
+using std::vector;
+using miniGL::Skeleton;
+using miniGL::AnimationClip;
+using miniGL::AnimationCursor;
+using miniGL::CompressedClip;
+using miniGL::LocalPose;
+
+unsigned int Skeleton::addNode(int pParent, const mat4f & pTransform)
+{
+    assert(pParent < static_cast<int>(mNodes.size()) && "The parent node must be added before its children");
+
+    mNodes.push_back({pTransform, pParent});
+
+    const unsigned int lIndex = static_cast<unsigned int>(mNodes.size()) - 1;
+
+    mBindPose.resize(lIndex + 1);
+    mBindPose.transform(lIndex, pTransform);
+
+    return lIndex;
+}
+
+unsigned int Skeleton::addBone(const mat4f & pOffset)
+{
+    mBoneOffsets.push_back(pOffset);
+    mBoneNodes.push_back(-1);
+
+    return static_cast<unsigned int>(mBoneOffsets.size()) - 1;
+}
+
+void Skeleton::boneNode(unsigned int pBone, unsigned int pNode)
+{
+    assert(pBone < mBoneNodes.size() && pNode < mNodes.size());
+    mBoneNodes[pBone] = static_cast<int>(pNode);
+}
+
+void Skeleton::globalInverseTransform(const mat4f & pTransform) noexcept
+{
+    mGlobalInverseTransform = pTransform;
+}
+
+unsigned int Skeleton::nodeCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mNodes.size());
+}
+
+unsigned int Skeleton::boneCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mBoneOffsets.size());
+}
+
+void Skeleton::pose(const AnimationClip & pClip, float pAnimationTime, AnimationCursor & pCursor, vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const
+{
+    _pose(pClip, pAnimationTime, pCursor, pNodeTransforms, pTransforms);
+}
+
+void Skeleton::pose(const CompressedClip & pClip, float pAnimationTime, AnimationCursor & pCursor, vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const
+{
+    _pose(pClip, pAnimationTime, pCursor, pNodeTransforms, pTransforms);
+}
+
+void Skeleton::pose(const LocalPose & pPose, vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const
+{
+    assert(pPose.nodeCount() == mNodes.size() && "The pose must contain all the nodes of the skeleton");
+
+    pNodeTransforms.resize(mNodes.size());
+
+    for (unsigned int i = 0; i < mNodes.size(); ++i)
+        pNodeTransforms[i] = pPose.transform(i);
+
+    _palette(pNodeTransforms, pTransforms);
+}
+
+const LocalPose & Skeleton::bindPose(void) const noexcept
+{
+    return mBindPose;
+}
+
+void Skeleton::mask(unsigned int pRoot, float pWeight, vector<float> & pMask) const
+{
+    assert(pRoot < mNodes.size() && "Node index out of boundaries");
+
+    pMask.resize(mNodes.size(), 0.0f);
+
+    // The children come after their parent, so a single loop from the root finds the whole branch
+    vector<bool> lInBranch(mNodes.size(), false);
+    lInBranch[pRoot] = true;
+    pMask[pRoot] = pWeight;
+
+    for (unsigned int i = pRoot + 1; i < mNodes.size(); ++i)
+    {
+        if (mNodes[i].parent >= 0 && lInBranch[mNodes[i].parent])
+        {
+            lInBranch[i] = true;
+            pMask[i] = pWeight;
+        }
+    }
+}
+
+void Skeleton::clear(void)
+{
+    mNodes.clear();
+    mBoneOffsets.clear();
+    mBoneNodes.clear();
+    mGlobalInverseTransform = mat4f(1.0f);
+    mBindPose.resize(0);
+}
+
+template<typename Clip>
+void Skeleton::_pose(const Clip & pClip, float pAnimationTime, AnimationCursor & pCursor, vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const
+{
+    if (pCursor.channelCount() != pClip.channelCount())
+        pCursor.reset(pClip.channelCount());
+
+    pNodeTransforms.resize(mNodes.size());
+
+    for (unsigned int i = 0; i < mNodes.size(); ++i)
+        pNodeTransforms[i] = mNodes[i].transform;
+
+    // Replace the transformation of the animated nodes
+    for (unsigned int i = 0; i < pClip.channelCount(); ++i)
+        pNodeTransforms[pClip.channelNode(i)] = pClip.localTransform(i, pAnimationTime, pCursor);
+
+    _palette(pNodeTransforms, pTransforms);
+}
+
+void Skeleton::_palette(vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const
+{
+    // The parents come first, so their global transformation is already known
+    for (unsigned int i = 0; i < mNodes.size(); ++i)
+    {
+        if (mNodes[i].parent >= 0)
+            pNodeTransforms[i] = pNodeTransforms[mNodes[i].parent] * pNodeTransforms[i];
+    }
+
+    for (unsigned int i = 0; i < mBoneOffsets.size(); ++i)
+    {
+        // A bone that does not match any node keeps its bind pose
+        if (mBoneNodes[i] < 0)
+            pTransforms[i] = mat4f(1.0f);
+        else
+            pTransforms[i] = mGlobalInverseTransform * pNodeTransforms[mBoneNodes[i]] * mBoneOffsets[i];
+    }
+}
@@ -0,0 +1,152 @@
+//===============================================================================================//
+/*!
+ *  \file      Skeleton.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include "Algebra.hpp"
+#include "AnimationClip.hpp"
+#include "CompressedClip.hpp"
+#include "AnimationCursor.hpp"
+#include "LocalPose.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores the node hierarchy and the bones of a skinned mesh
+     *  \details The nodes are stored in a flat array where each parent comes before its children, so that the
+     *           global transformations are computed with a single loop instead of a recursive traversal. Each
+     *           bone references a node and stores the offset matrix from the mesh space to the bone space.
+     */
+    class Skeleton
+    {
+    public:
+        /*!
+         *  \brief Add a node to the hierarchy
+         *  @param pParent is the index of the parent node (it must already be in the skeleton), or -1 for a root node
+         *  @param pTransform is the transformation of the node relative to its parent
+         *  @return the index of the new node
+         */
+        unsigned int addNode(int pParent, const mat4f & pTransform);
+
+        /*!
+         *  \brief Add a bone
+         *  @param pOffset is the transformation from the mesh space to the bone space
+         *  @return the index of the new bone
+         */
+        unsigned int addBone(const mat4f & pOffset);
+
+        /*!
+         *  \brief Attach a bone to a node of the hierarchy
+         *  @param pBone is the index of the bone
+         *  @param pNode is the index of the node
+         */
+        void boneNode(unsigned int pBone, unsigned int pNode);
+
+        /*!
+         *  \brief Set the global inverse transform
+         *  @param pTransform is the inverse of the root node transformation
+         */
+        void globalInverseTransform(const mat4f & pTransform) noexcept;
+
+        /*!
+         *  \brief Get the number of nodes in the hierarchy
+         *  @return the number of nodes
+         */
+        unsigned int nodeCount(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of bones
+         *  @return the number of bones
+         */
+        unsigned int boneCount(void) const noexcept;
+
+        /*!
+         *  \brief Compute the transformation of each bone without allocating memory once the buffers have the right size
+         *  @param pClip is the animation to sample, its channels must reference nodes of this skeleton
+         *  @param pAnimationTime is the time stamp in the animation (in ticks)
+         *  @param pCursor keeps the keys used during the previous call for the same animated instance
+         *  @param pNodeTransforms is a buffer used to store the global transformation of each node
+         *  @param pTransforms points to an array with room for boneCount() matrices
+         */
+        void pose(const AnimationClip & pClip, float pAnimationTime, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const;
+
+        /*!
+         *  \brief Compute the transformation of each bone for a time stamp of a compressed animation clip
+         *  @param pClip is the animation to sample, its channels must reference nodes of this skeleton
+         *  @param pAnimationTime is the time stamp in the animation (in ticks)
+         *  @param pCursor keeps the keys used during the previous call for the same animated instance
+         *  @param pNodeTransforms is a buffer used to store the global transformation of each node
+         *  @param pTransforms points to an array with room for boneCount() matrices
+         */
+        void pose(const CompressedClip & pClip, float pAnimationTime, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const;
+
+        /*!
+         *  \brief Compute the transformation of each bone from the local transformation of each node
+         *  \details It is the last step after sampling and blending several clips, the pose is converted to matrices only once
+         *  @param pPose contains the local transformation of all the nodes of this skeleton
+         *  @param pNodeTransforms is a buffer used to store the global transformation of each node
+         *  @param pTransforms points to an array with room for boneCount() matrices
+         */
+        void pose(const LocalPose & pPose, std::vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const;
+
+        /*!
+         *  \brief Get the local transformation of each node when no animation is applied
+         *  @return a const reference on the bind pose, a good starting point before sampling clips that do not animate all the nodes
+         */
+        const LocalPose & bindPose(void) const noexcept;
+
+        /*!
+         *  \brief Set the weight of a node and all its descendants in a blending mask
+         *  @param pRoot is the index of the first node of the branch, e.g. the spine to blend only the upper body
+         *  @param pWeight is the weight of the nodes of the branch
+         *  @param pMask contains one weight per node, it is resized to nodeCount() with a weight of 0 for the new nodes
+         */
+        void mask(unsigned int pRoot, float pWeight, std::vector<float> & pMask) const;
+
+        /*!
+         *  \brief Remove all the nodes and bones
+         */
+        void clear(void);
+
+    private:
+        /*!
+         *  \brief Helper method to compute the transformation of each bone, for any type of clip
+         *  @param pClip is the animation to sample, it provides channelCount(), channelNode() and localTransform()
+         *  @param pAnimationTime is the time stamp in the animation (in ticks)
+         *  @param pCursor keeps the keys used during the previous call for the same animated instance
+         *  @param pNodeTransforms is a buffer used to store the global transformation of each node
+         *  @param pTransforms points to an array with room for boneCount() matrices
+         */
+        template<typename Clip>
+        void _pose(const Clip & pClip, float pAnimationTime, AnimationCursor & pCursor, std::vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const;
+
+        /*!
+         *  \brief Helper method to combine the local transformations of the nodes with their parents and compute the bone transformations
+         *  @param pNodeTransforms contains the local transformation of each node, replaced by its global transformation
+         *  @param pTransforms points to an array with room for boneCount() matrices
+         */
+        void _palette(std::vector<mat4f> & pNodeTransforms, mat4f* pTransforms) const;
+
+    private:
+        struct Node
+        {
+            mat4f transform;
+            int parent;
+        };
+
+        std::vector<Node> mNodes;
+        std::vector<mat4f> mBoneOffsets;
+        std::vector<int> mBoneNodes;
+        mat4f mGlobalInverseTransform = mat4f(1.0f);
+        LocalPose mBindPose;
+
+    }; // class Skeleton
+
+} // namespace miniGL
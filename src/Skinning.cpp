@@ -47,16 +47,19 @@ bool Skinning::checkUniformLocations(void) const
 {
     bool lRes = true;
 
-    lRes &= mWVPLocation != Constants::invalidUniformLocation<GLuint>();
     lRes &= mWorldLocation != Constants::invalidUniformLocation<GLuint>();
 
-    for(const auto location : mBoneLocations)
-        lRes &= (location != Constants::invalidUniformLocation<GLuint>());
+    lRes &= mBonePaletteLocation != Constants::invalidUniformLocation<GLuint>();
+    lRes &= mBoneCountLocation != Constants::invalidUniformLocation<GLuint>();
+    lRes &= mPaletteInstanceLocation != Constants::invalidUniformLocation<GLuint>();
+    lRes &= mPaletteOffsetLocation != Constants::invalidUniformLocation<GLuint>();
+    lRes &= mBoneInfluencesLocation != Constants::invalidUniformLocation<GLuint>();
+    lRes &= mBoneIndexBitsLocation != Constants::invalidUniformLocation<GLuint>();
 
     if (mUsePreviousBones)
     {
-        for(const auto location : mPreviousBoneLocations)
-            lRes &= (location != Constants::invalidUniformLocation<GLuint>());
+        lRes &= mPreviousBonePaletteLocation != Constants::invalidUniformLocation<GLuint>();
+        lRes &= mPreviousPaletteOffsetLocation != Constants::invalidUniformLocation<GLuint>();
     }
 
     return lRes;
@@ -95,14 +98,12 @@ void Skinning::init(unsigned int pPointLightCount, unsigned int pSpotLightCount,
     LightingBase::initLightParametersLocations();
 
     // Init the location of uniform variables
-    mWVPLocation = Program::uniformLocation("uWVP");
     mWorldLocation = Program::uniformLocation("uWorld");
     mLightWVPLocation = Program::uniformLocation("uLightWVP");
 
     mSamplerLocation = Program::uniformLocation("uSampler");
     mShadowMapLocation = Program::uniformLocation("uShadowMap");
     mNormalMapLocation = Program::uniformLocation("uNormalMap");
-    mEyeWorldPosLocation = Program::uniformLocation("uEyeWorldPos");
     mMaterialSpecularIntensityLocation = Program::uniformLocation("uMaterialSpecularIntensity");
     mMaterialSpecularPowerLocation = Program::uniformLocation("uMaterialSpecularPower");
 
@@ -119,28 +120,26 @@ void Skinning::init(unsigned int pPointLightCount, unsigned int pSpotLightCount,
     glUniform1i(mShadowMapLocation, SHADOW_TEXTURE_UNIT_INDEX); checkOpenGLState;
     glUniform1i(mNormalMapLocation, NORMAL_TEXTURE_UNIT_INDEX); checkOpenGLState;
 
-    mBoneLocations.assign(100, Constants::invalidUniformLocation<GLuint>());
-    for (unsigned int i = 0; i < mBoneLocations.size(); ++i)
-    {
-        string lBone("uBone[");
-        lBone.append(to_string(i));
-        lBone.append("]");
-        mBoneLocations[i] = Program::uniformLocation(lBone.c_str());
-    }
+    // The bone palettes are read from texture buffers
+    mBonePaletteLocation = Program::uniformLocation("uBonePalette");
+    mBoneCountLocation = Program::uniformLocation("uBoneCount");
+    mPaletteInstanceLocation = Program::uniformLocation("uPaletteInstance");
+    mPaletteOffsetLocation = Program::uniformLocation("uPaletteOffset");
+
+    // The bone IDs and weights of the vertices are packed
+    mBoneInfluencesLocation = Program::uniformLocation("uBoneInfluences");
+    mBoneIndexBitsLocation = Program::uniformLocation("uBoneIndexBits");
+
+    glUniform1i(mBonePaletteLocation, BONE_PALETTE_TEXTURE_UNIT_INDEX); checkOpenGLState;
 
     // We need to use the previous bones to be able to render motion blur
     mUsePreviousBones = pActivateMotionBlur;
 
     if (mUsePreviousBones)
     {
-        mPreviousBoneLocations.assign(100, Constants::invalidUniformLocation<GLuint>());
-        for (unsigned int i = 0; i < mBoneLocations.size(); ++i)
-        {
-            string lBone("uPreviousBone[");
-            lBone.append(to_string(i));
-            lBone.append("]");
-            mPreviousBoneLocations[i] = Program::uniformLocation(lBone.c_str());
-        }
+        mPreviousBonePaletteLocation = Program::uniformLocation("uPreviousBonePalette");
+        mPreviousPaletteOffsetLocation = Program::uniformLocation("uPreviousPaletteOffset");
+        glUniform1i(mPreviousBonePaletteLocation, PREVIOUS_BONE_PALETTE_TEXTURE_UNIT_INDEX); checkOpenGLState;
     }
 
     // Check if we correctly initialized the uniform variables
@@ -151,11 +150,6 @@ void Skinning::init(unsigned int pPointLightCount, unsigned int pSpotLightCount,
     useSampler(true);
 }
 
-void Skinning::WVP(const mat4f & pWVP)
-{
-    glUniformMatrix4fv(mWVPLocation, 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
-}
-
 void Skinning::worldMatrix(const mat4f & pWorld)
 {
     glUniformMatrix4fv(mWorldLocation, 1, GL_TRUE, const_cast<mat4f&>(pWorld).data());
@@ -166,11 +160,6 @@ void Skinning::lightWVP(const mat4f & pWVP)
     glUniformMatrix4fv(mLightWVPLocation, 1, GL_TRUE, const_cast<mat4f&>(pWVP).data());
 }
 
-void Skinning::eyeWorldPosition(const vec3f & pEyeWorldPos)
-{
-    glUniform3f(mEyeWorldPosLocation, pEyeWorldPos.x(), pEyeWorldPos.y(), pEyeWorldPos.z());
-}
-
 void Skinning::materialSpecularIntensity(float pValue)
 {
     glUniform1f(mMaterialSpecularIntensityLocation, pValue);
@@ -196,13 +185,26 @@ void Skinning::useNormalMap(bool pActivate)
     glUniform1i(mUseNormalMapLocation, pActivate?1:0);
 }
 
-void Skinning::boneTransforms(unsigned int pIndex, const mat4f & pTransform)
+void Skinning::boneCount(unsigned int pCount)
+{
+    glUniform1i(mBoneCountLocation, static_cast<GLint>(pCount));
+}
+
+void Skinning::boneFormat(unsigned int pInfluences, unsigned int pIndexBits)
 {
-    glUniformMatrix4fv(mBoneLocations[pIndex], 1, GL_TRUE, const_cast<mat4f&>(pTransform).data());
+    glUniform1i(mBoneInfluencesLocation, static_cast<GLint>(pInfluences));
+    glUniform1i(mBoneIndexBitsLocation, static_cast<GLint>(pIndexBits));
 }
 
-void Skinning::previousBoneTransforms(unsigned int pIndex, mat4f & pTransform)
+void Skinning::paletteInstance(unsigned int pInstance)
 {
+    glUniform1i(mPaletteInstanceLocation, static_cast<GLint>(pInstance));
+}
+
+void Skinning::paletteOffsets(unsigned int pOffset, unsigned int pPreviousOffset)
+{
+    glUniform1i(mPaletteOffsetLocation, static_cast<GLint>(pOffset));
+
     if (mUsePreviousBones)
-        glUniformMatrix4fv(mPreviousBoneLocations[pIndex], 1, GL_TRUE, pTransform.data());
+        glUniform1i(mPreviousPaletteOffsetLocation, static_cast<GLint>(pPreviousOffset));
 }
@@ -42,12 +42,6 @@ namespace miniGL
          */
         void init(unsigned int pPointLightCount, unsigned int pSpotLightCount, bool pActivateMotionBlur = false, const std::string & pPathVS = std::string(R"(./Shaders/Skinning.vert)"), const std::string & pPathFS = std::string(R"(./Shaders/Skinning.frag)"));
 
-        /*!
-         *  \brief Set the world view projection matrix
-         *  @param pWVP is a 4x4 matrix
-         */
-        void WVP(const mat4f & pWVP);
-
         /*!
          *  \brief Set the world matrix
          *  @param pWorld is a 4x4 matrix
@@ -60,12 +54,6 @@ namespace miniGL
          */
         void lightWVP(const mat4f & pLightWVP);
 
-        /*!
-         *  \brief Set the position of the camera to calculate the specular component
-         *  @param pPos is the position of the camera
-         */
-        void eyeWorldPosition(const vec3f & pPos);
-
         /*!
          *  \brief Set material specular intensity
          *  @param pValue is a parameter in the range [0,1]
@@ -98,18 +86,32 @@ namespace miniGL
         void useNormalMap(bool pActivate);
 
         /*!
-         *  \brief Set the transformation associated to a specific bone in the mesh
-         *  @param pIndex is the bone index
-         *  @param pTransform is a 4x4 matrix
+         *  \brief Set the number of bones in the palette of each instance
+         *  @param pCount is the number of bones of the mesh
+         */
+        void boneCount(unsigned int pCount);
+
+        /*!
+         *  \brief Set the format of the packed bone IDs and weights of the mesh (see PackedBoneData)
+         *  @param pInfluences is the number of bones per vertex, 4 or 8
+         *  @param pIndexBits is the number of bits of each ID and weight, 8 or 16
+         */
+        void boneFormat(unsigned int pInfluences, unsigned int pIndexBits);
+
+        /*!
+         *  \brief Set the index of the palette used by the next draw call. With instanced draws, gl_InstanceID is
+         *         added to this index.
+         *  @param pInstance is the index of the first instance in the bone palette buffer
          */
-        void boneTransforms(unsigned int pIndex, const mat4f & pTransform);
+        void paletteInstance(unsigned int pInstance);
 
         /*!
-         *  \brief Set the transformation associated to a specific bone in the mesh for a previous frame
-         *  @param pIndex is the bone index
-         *  @param pTransform is a 4x4 matrix
+         *  \brief Set where the palettes of this frame start in the bone palette buffers
+         *  @param pOffset is BonePaletteBuffer::offset of the current palettes
+         *  @param pPreviousOffset is BonePaletteBuffer::offset of the palettes of the previous frame, only used with
+         *         motion blur
          */
-        void previousBoneTransforms(unsigned int pIndex, mat4f & pTransform);
+        void paletteOffsets(unsigned int pOffset, unsigned int pPreviousOffset);
 
     private:
         /*!
@@ -118,7 +120,6 @@ namespace miniGL
         virtual bool checkUniformLocations(void) const final;
 
     private:
-        GLuint mWVPLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mWorldLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mLightWVPLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mSamplerLocation = Constants::invalidUniformLocation<GLuint>();
@@ -127,13 +128,18 @@ namespace miniGL
         GLuint mUseShadowMapLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mNormalMapLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mUseNormalMapLocation = Constants::invalidUniformLocation<GLuint>();
-        GLuint mEyeWorldPosLocation = Constants::invalidUniformLocation<GLuint>();
 
         GLuint mMaterialSpecularIntensityLocation = Constants::invalidUniformLocation<GLuint>();
         GLuint mMaterialSpecularPowerLocation = Constants::invalidUniformLocation<GLuint>();
 
-        std::vector<GLuint> mBoneLocations;
-        std::vector<GLuint> mPreviousBoneLocations;
+        GLuint mBonePaletteLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mPreviousBonePaletteLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mBoneCountLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mPaletteInstanceLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mPaletteOffsetLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mPreviousPaletteOffsetLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mBoneInfluencesLocation = Constants::invalidUniformLocation<GLuint>();
+        GLuint mBoneIndexBitsLocation = Constants::invalidUniformLocation<GLuint>();
 
         bool mUsePreviousBones = false;
 
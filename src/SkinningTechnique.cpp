@@ -9,8 +9,8 @@
 #include "SkinningTechnique.hpp"
 
 #include "MeshSOA.hpp"
+#include "EngineCommon.hpp"
 
-using std::map;
 using std::vector;
 using std::string;
 using std::make_unique;
@@ -22,10 +22,14 @@ using miniGL::SkinningTechnique;
 using miniGL::RenderingTechniqueBase;
 using miniGL::MeshSOA;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
+using miniGL::MeshBase;
+using miniGL::JobSystem;
 
-SkinningTechnique::SkinningTechnique(void)
-:RenderingTechniqueBase("SkinningTechnique")
+SkinningTechnique::SkinningTechnique(JobSystem & pJobSystem)
+:RenderingTechniqueBase("SkinningTechnique"),
+ mJobSystem(pJobSystem)
 {
 }
 
@@ -58,9 +62,12 @@ void SkinningTechnique::init(unsigned int pPointLightCount, unsigned int pSpotLi
     {
         mSkinning->init(pPointLightCount, pSpotLightCount);
     }
+
+    for (auto & rPalette : mBonePalettes)
+        rPalette.init();
 }
 
-void SkinningTechnique::render(const std::map<std::string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void SkinningTechnique::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
     // The rendering follows two "different paths" according to the value of mActivateMotionBlur
     // If we render WITHOUT motion blur, then we directly render to screen
@@ -76,51 +83,68 @@ void SkinningTechnique::render(const std::map<std::string, MeshAndTransform> & p
     mSkinning->useNormalMap(false);
     mSkinning->useShadowMap(false);
 
-    mSkinning->eyeWorldPosition(mCamera->position());
-
     mSkinning->updateLightsState(pLights);
 
-    assert(mMeshToRenderNames.size() == 1 && "Rendering only one mesh for the moment");
+    assert(mMeshesToRender.names().size() == 1 && "Rendering only one mesh for the moment");
 
-    for (auto it = pMeshes.cbegin(); it != pMeshes.cend(); it++)
+    for (const auto rMeshAndTransform : findMeshesToRender(pMeshes))
     {
-        for (const auto name : mMeshToRenderNames)
+        const MeshBase* rMesh = rMeshAndTransform->mesh.get();
+        const auto & rTransforms = rMeshAndTransform->transform;
+
+        // Create one animated instance per transformation when the mesh or the number of instances changes
+        const bool lNewInstances = rMesh != mAnimatedMesh || mPoses.instanceCount() != rTransforms.size();
+
+        if (lNewInstances)
         {
-            if (it->first == name)
+            mAnimatedMesh = rMesh;
+            mPoses.skeleton(& rMesh->skeleton());
+
+            for (unsigned int i = 0; i < rTransforms.size(); ++i)
             {
-                // The following code is ran only once during the first call to render to initialize the previous transformations with time t = 0.
-                // This works because we are assuming only 1 mesh to render. If we wanted to render multiple meshes with this technique, we would need an array of bools
-                // to ensure each one gets its transforms initialized
-                if (mActivateMotionBlur && mInitializePreviousTransforms)
-                {
-                    it->second.mesh->boneTransform(0.0f, mPreviousBoneTransforms);
-                    mInitializePreviousTransforms = false;
-                }
-
-                // Update and get all the bone transform matrices from the mesh
-                vector<mat4f> lTransforms;
-                it->second.mesh->boneTransform(mRunningTime, lTransforms);
-
-                // Update all bone transform matrices in the shader
-                for (unsigned int i = 0; i < lTransforms.size(); ++i)
-                {
-                    mSkinning->boneTransforms(i, lTransforms[i]);
-
-                    if (mActivateMotionBlur)
-                        mSkinning->previousBoneTransforms(i, mPreviousBoneTransforms[i]);
-                }
-
-                for (auto transformation : it->second.transform)
-                {
-                    mat4f lWorld = transformation.final();
-                    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
-
-                    mSkinning->worldMatrix(lWorld);
-                    mSkinning->WVP(lWVP);
-
-                    it->second.mesh->render();
-                }
+                const auto lAnimation = i < mInstanceAnimations.size() ? mInstanceAnimations[i] : tuple<float, float>(0.0f, 1.0f);
+                mPoses.addInstance(& rMesh->animationClip(), mRunningTime + get<0>(lAnimation), get<1>(lAnimation));
             }
+
+            mLastUpdateTime = mRunningTime;
+        }
+
+        // Evaluate the poses of all the instances in parallel
+        mPoses.update(mRunningTime - mLastUpdateTime, & mJobSystem);
+        mLastUpdateTime = mRunningTime;
+
+        // The palette of the previous frame stays in the other buffer for the motion blur
+        mCurrentPalette = (mCurrentPalette + 1) % mBonePalettes.size();
+
+        const auto & rPalettes = mPoses.palettes();
+        mBonePalettes[mCurrentPalette].update(rPalettes.data(), static_cast<unsigned int>(rPalettes.size()));
+        mBonePalettes[mCurrentPalette].bind(BONE_PALETTE_TEXTURE_UNIT);
+
+        if (mActivateMotionBlur)
+        {
+            const unsigned int lPrevious = (mCurrentPalette + 1) % mBonePalettes.size();
+
+            if (lNewInstances)
+                mBonePalettes[lPrevious].update(rPalettes.data(), static_cast<unsigned int>(rPalettes.size()));
+
+            mBonePalettes[lPrevious].bind(PREVIOUS_BONE_PALETTE_TEXTURE_UNIT);
+        }
+
+        const unsigned int lPreviousOffset = mBonePalettes[(mCurrentPalette + 1) % mBonePalettes.size()].offset();
+        mSkinning->paletteOffsets(mBonePalettes[mCurrentPalette].offset(), lPreviousOffset);
+
+        mSkinning->boneCount(mPoses.boneCount());
+        mSkinning->boneFormat(rMesh->boneInfluences(), rMesh->boneIndexBits());
+
+        for (unsigned int j = 0; j < rTransforms.size(); ++j)
+        {
+            mSkinning->paletteInstance(j);
+
+            mat4f lWorld = rTransforms.world(j);
+
+            mSkinning->worldMatrix(lWorld);
+
+            rMeshAndTransform->mesh->render();
         }
     }
 
@@ -141,3 +165,18 @@ void SkinningTechnique::runningTime(float pRunningTime)
 {
     mRunningTime = pRunningTime;
 }
+
+void SkinningTechnique::instanceAnimation(unsigned int pInstance, float pTimeOffset, float pSpeed)
+{
+    if (pInstance >= mInstanceAnimations.size())
+        mInstanceAnimations.resize(pInstance + 1, tuple<float, float>(0.0f, 1.0f));
+
+    mInstanceAnimations[pInstance] = tuple<float, float>(pTimeOffset, pSpeed);
+
+    // Apply the new state directly if the instance is already animated
+    if (pInstance < mPoses.instanceCount())
+    {
+        mPoses.instance(pInstance).time = mRunningTime + pTimeOffset;
+        mPoses.instance(pInstance).speed = pSpeed;
+    }
+}
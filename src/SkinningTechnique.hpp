@@ -8,8 +8,8 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
+#include <array>
 
 #include "RenderingTechniqueBase.hpp"
 #include "MeshAndTransform.hpp"
@@ -17,6 +17,9 @@
 #include "Skinning.hpp"
 #include "MotionBlur.hpp"
 #include "IntermediateBuffer.hpp"
+#include "PoseEvaluator.hpp"
+#include "JobSystem.hpp"
+#include "BonePaletteBuffer.hpp"
 
 namespace miniGL
 {
@@ -28,9 +31,10 @@ namespace miniGL
     {
     public:
         /*!
-         *  \brief Default constructor
+         *  \brief Constructor
+         *  @param pJobSystem evaluates the poses of the instances in parallel, it must outlive the technique
          */
-        SkinningTechnique(void);
+        explicit SkinningTechnique(JobSystem & pJobSystem);
 
         /*!
          *  \brief Initialize the rendering technique
@@ -47,7 +51,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(const std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Set the running time, i.e. the time since the application started
@@ -55,6 +59,14 @@ namespace miniGL
          */
         void runningTime(float pRunningTime);
 
+        /*!
+         *  \brief Set the animation state of an instance of the mesh, so that the instances do not move in lockstep
+         *  @param pInstance is the index of the transformation of the instance in MeshAndTransform
+         *  @param pTimeOffset is added to the running time of the instance, in seconds
+         *  @param pSpeed is the playback speed of the instance (1 for the original speed)
+         */
+        void instanceAnimation(unsigned int pInstance, float pTimeOffset, float pSpeed = 1.0f);
+
         /*!
          *  \brief Set the indices of the lights that will be used when rendering using a specific technique
          *  @param pFirstIndex is the index of the first light to be added to the rendering technique
@@ -80,11 +92,16 @@ namespace miniGL
         std::unique_ptr<Skinning> mSkinning;
         std::unique_ptr<MotionBlur> mMotionBlur;
         IntermediateBuffer mIntermediateBuffer;
-        std::vector<mat4f> mPreviousBoneTransforms;
+        JobSystem & mJobSystem;
+        PoseEvaluator mPoses;
+        const MeshBase* mAnimatedMesh = nullptr;
+        std::vector<std::tuple<float, float>> mInstanceAnimations;
+        std::array<BonePaletteBuffer, 2> mBonePalettes;
+        unsigned int mCurrentPalette = 0;
         MeshAndTransform mQuad;
         float mRunningTime = 0.0f;
+        float mLastUpdateTime = 0.0f;
         bool mActivateMotionBlur = false;
-        bool mInitializePreviousTransforms = true;
 
     }; // class SkinningTechnique
 
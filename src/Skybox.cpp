@@ -12,6 +12,7 @@
 
 #include "Transform.hpp"
 #include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
 
 using std::make_unique;
 using std::shared_ptr;
@@ -23,6 +24,7 @@ using miniGL::CubemapTexture;
 using miniGL::MeshAOS;
 using miniGL::Transform;
 using miniGL::Camera;
+using miniGL::GLStateCache;
 
 SkyBox::SkyBox(shared_ptr<Camera> pCamera)
 :mCamera(pCamera)
@@ -57,17 +59,15 @@ void SkyBox::render(void)
 {
     mRenderer->use();
 
-    GLint lOldCullFaceMode;
-    glGetIntegerv(GL_CULL_FACE_MODE, & lOldCullFaceMode);
+    const GLenum lOldCullFaceMode = GLStateCache::cullFace();
 
-    GLint lOldDepthMode;
-    glGetIntegerv(GL_DEPTH_FUNC, & lOldDepthMode);
+    const GLenum lOldDepthMode = GLStateCache::depthFunc();
 
 //    glEnable(GL_CULL_FACE);
 
     // Using front face culling makes the skybox disapear -> go normal back face culling
     //glCullFace(GL_FRONT);
-    glDepthFunc(GL_LEQUAL);
+    GLStateCache::depthFunc(GL_LEQUAL);
 
     Transform lTransformation;
 
@@ -75,13 +75,13 @@ void SkyBox::render(void)
 
     mat4f lWorld = lTransformation.final();
 
-    mat4f lWVP = mCamera->projection() * mCamera->view() * lWorld;
+    mat4f lWVP = mCamera->viewProjection() * lWorld;
 
     mRenderer->WVP(lWVP);
     mCubemapTexture->bind(COLOR_TEXTURE_UNIT);
     mBox->render();
 
-    glCullFace(lOldCullFaceMode);
-    glDepthFunc(lOldDepthMode);
+    GLStateCache::cullFace(lOldCullFaceMode);
+    GLStateCache::depthFunc(lOldDepthMode);
 //    glDisable(GL_CULL_FACE);
 }
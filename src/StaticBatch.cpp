@@ -0,0 +1,132 @@
+//===============================================================================================//
+/*!
+ *  \file      StaticBatch.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "StaticBatch.hpp"
+
+#include <cassert>
+
+#include "EngineCommon.hpp"
+#include "GLUtils.hpp"
+#include "GLStateCache.hpp"
+
+using miniGL::StaticBatch;
+using miniGL::StaticBatchBuilder;
+using miniGL::DrawList;
+using miniGL::DrawPacket;
+using miniGL::GLStateCache;
+
+StaticBatch::~StaticBatch(void)
+{
+    clear();
+}
+
+void StaticBatch::upload(const StaticBatchBuilder & pBuilder)
+{
+    clear();
+
+    if (pBuilder.indices().empty())
+        return;
+
+    glGenVertexArrays(1, & mVAO);
+    glBindVertexArray(mVAO);
+
+    glGenBuffers(mBuffers.size(), mBuffers.data());
+
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vec3f) * pBuilder.positions().size(), pBuilder.positions().data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    checkOpenGLState;
+
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffers[1]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vec2f) * pBuilder.texCoords().size(), pBuilder.texCoords().data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    checkOpenGLState;
+
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffers[2]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vec3f) * pBuilder.normals().size(), pBuilder.normals().data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    checkOpenGLState;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBuffers[3]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * pBuilder.indices().size(), pBuilder.indices().data(), GL_STATIC_DRAW);
+    checkOpenGLState;
+
+    glBindVertexArray(0);
+
+    mRanges = pBuilder.ranges();
+}
+
+void StaticBatch::render(void) const
+{
+    assert(!empty() && "The static batch was not uploaded");
+
+    // StaticBatchBuilder stores all the triangles counter clockwise
+    GLStateCache::frontFace(GL_CCW);
+
+    glBindVertexArray(mVAO);
+
+    for (const StaticBatchBuilder::Range & rRange : mRanges)
+    {
+        if (rRange.texture != 0)
+        {
+            GLStateCache::activeTexture(COLOR_TEXTURE_UNIT);
+            GLStateCache::bindTexture(GL_TEXTURE_2D, rRange.texture);
+        }
+
+        glDrawElements(GL_TRIANGLES, rRange.indexCount, GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(sizeof(unsigned int) * rRange.firstIndex));
+    }
+
+    glBindVertexArray(0);
+}
+
+void StaticBatch::record(DrawList::Recorder & pRecorder, DrawPacket pPacket) const
+{
+    pPacket.vao = mVAO;
+    pPacket.topology = GL_TRIANGLES;
+    pPacket.frontFace = GL_CCW;
+    pPacket.baseVertex = 0;
+
+    for (const StaticBatchBuilder::Range & rRange : mRanges)
+    {
+        pPacket.indexCount = rRange.indexCount;
+        pPacket.baseIndex = rRange.firstIndex;
+        pPacket.colorTexture = rRange.texture;
+
+        pRecorder.draw(pPacket);
+    }
+}
+
+void StaticBatch::clear(void)
+{
+    if (mVAO != 0)
+    {
+        glDeleteVertexArrays(1, & mVAO);
+        mVAO = 0;
+    }
+
+    if (mBuffers[0] != 0)
+    {
+        glDeleteBuffers(mBuffers.size(), mBuffers.data());
+        mBuffers = {{0, 0, 0, 0}};
+    }
+
+    mRanges.clear();
+}
+
+bool StaticBatch::empty(void) const noexcept
+{
+    return mRanges.empty();
+}
+
+unsigned int StaticBatch::drawCount(void) const noexcept
+{
+    return static_cast<unsigned int>(mRanges.size());
+}
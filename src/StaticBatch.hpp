@@ -0,0 +1,79 @@
+//===============================================================================================//
+/*!
+ *  \file      StaticBatch.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "StaticBatchBuilder.hpp"
+#include "DrawList.hpp"
+#include "DrawPacket.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class draws the geometry merged by a StaticBatchBuilder with one draw call per texture
+     *  \details The vertices are read at the same locations as the meshes (position 0, texture coordinates 1, normal 2) and
+     *           are already in world space: the programs must use an identity world matrix and the view projection matrix
+     *           as WVP. The textures are those of the merged meshes, which must outlive the batch.
+     */
+    class StaticBatch
+    {
+    public:
+        /*!
+         *  \brief Destructor, see clear
+         */
+        ~StaticBatch(void);
+
+        /*!
+         *  \brief Create the buffers and the VAO of the merged geometry, replacing the previous ones
+         *  @param pBuilder contains the geometry, once its build method was called
+         */
+        void upload(const StaticBatchBuilder & pBuilder);
+
+        /*!
+         *  \brief Draw the batch
+         */
+        void render(void) const;
+
+        /*!
+         *  \brief Record the draw calls of the batch, it does not call OpenGL
+         *  @param pRecorder receives one packet per texture
+         *  @param pPacket has the program and the uniforms set by the technique, the batch completes the geometry
+         *         and the texture
+         */
+        void record(DrawList::Recorder & pRecorder, DrawPacket pPacket) const;
+
+        /*!
+         *  \brief Free the buffers and the VAO
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Check if there is something to draw
+         *  @return true if the batch has no triangles
+         */
+        bool empty(void) const noexcept;
+
+        /*!
+         *  \brief Get the number of draw calls of the batch
+         *  @return the number of textures of the merged meshes
+         */
+        unsigned int drawCount(void) const noexcept;
+
+    private:
+        GLuint mVAO = 0;
+        std::array<GLuint, 4> mBuffers = {{0, 0, 0, 0}};     //!< Positions, texture coordinates, normals and indices
+        std::vector<StaticBatchBuilder::Range> mRanges;
+
+    }; // class StaticBatch
+
+} // namespace miniGL
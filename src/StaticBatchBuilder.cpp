@@ -0,0 +1,142 @@
+//===============================================================================================//
+/*!
+ *  \file      StaticBatchBuilder.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "StaticBatchBuilder.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+using std::vector;
+using miniGL::StaticBatchBuilder;
+
+unsigned int StaticBatchBuilder::addVertices(const vec3f* pPositions, const vec2f* pTexCoords, const vec3f* pNormals, unsigned int pCount, const mat4f & pWorld)
+{
+    const unsigned int lBaseVertex = static_cast<unsigned int>(mPositions.size());
+
+    // The normals are transformed by the inverse transpose, so that they stay orthogonal to the surface with a
+    // non uniform scaling
+    const mat4f lInverse = pWorld.inversed();
+
+    mMirrored = pWorld.determinant() < 0.0;
+
+    for (unsigned int i = 0; i < pCount; ++i)
+    {
+        const vec3f & rPosition = pPositions[i];
+        const vec3f & rNormal = pNormals[i];
+
+        vec3f lPosition;
+        vec3f lNormal;
+
+        for (unsigned int lRow = 0; lRow < 3; ++lRow)
+        {
+            lPosition[lRow] = pWorld(lRow,0) * rPosition.x() + pWorld(lRow,1) * rPosition.y() + pWorld(lRow,2) * rPosition.z() + pWorld(lRow,3);
+            lNormal[lRow] = lInverse(0,lRow) * rNormal.x() + lInverse(1,lRow) * rNormal.y() + lInverse(2,lRow) * rNormal.z();
+        }
+
+        lNormal.normalize();
+
+        mPositions.push_back(lPosition);
+        mTexCoords.push_back(pTexCoords[i]);
+        mNormals.push_back(lNormal);
+    }
+
+    return lBaseVertex;
+}
+
+void StaticBatchBuilder::addTriangles(const unsigned int* pIndices, unsigned int pCount, unsigned int pBaseVertex, GLuint pTexture, GLenum pFrontFace)
+{
+    assert(pCount % 3 == 0 && "A static batch only stores triangles");
+
+    Range lPart;
+    lPart.texture = pTexture;
+    lPart.firstIndex = static_cast<unsigned int>(mIndices.size());
+    lPart.indexCount = pCount;
+
+    mParts.push_back(lPart);
+
+    // The world matrix can reverse the orientation of the triangles too
+    const bool lFlip = (pFrontFace == GL_CW) != mMirrored;
+
+    for (unsigned int i = 0; i < pCount; i += 3)
+    {
+        assert(pBaseVertex + std::max(pIndices[i], std::max(pIndices[i + 1], pIndices[i + 2])) < mPositions.size() && "Index out of the vertices of the batch");
+
+        mIndices.push_back(pBaseVertex + pIndices[i]);
+        mIndices.push_back(pBaseVertex + pIndices[lFlip ? i + 2 : i + 1]);
+        mIndices.push_back(pBaseVertex + pIndices[lFlip ? i + 1 : i + 2]);
+    }
+}
+
+void StaticBatchBuilder::build(void)
+{
+    // Stable, so that the triangles of a texture keep the order in which they were added
+    std::stable_sort(mParts.begin(), mParts.end(), [](const Range & pA, const Range & pB)
+    {
+        return pA.texture < pB.texture;
+    });
+
+    vector<unsigned int> lIndices;
+    lIndices.reserve(mIndices.size());
+
+    mRanges.clear();
+
+    for (const Range & rPart : mParts)
+    {
+        if (mRanges.empty() || mRanges.back().texture != rPart.texture)
+        {
+            Range lRange;
+            lRange.texture = rPart.texture;
+            lRange.firstIndex = static_cast<unsigned int>(lIndices.size());
+
+            mRanges.push_back(lRange);
+        }
+
+        lIndices.insert(lIndices.end(), mIndices.begin() + rPart.firstIndex, mIndices.begin() + rPart.firstIndex + rPart.indexCount);
+        mRanges.back().indexCount += rPart.indexCount;
+    }
+
+    // The parts are now the ranges, building again gives the same result
+    mIndices.swap(lIndices);
+    mParts = mRanges;
+}
+
+void StaticBatchBuilder::clear(void)
+{
+    mPositions.clear();
+    mTexCoords.clear();
+    mNormals.clear();
+    mIndices.clear();
+    mParts.clear();
+    mRanges.clear();
+    mMirrored = false;
+}
+
+const vector<vec3f> & StaticBatchBuilder::positions(void) const noexcept
+{
+    return mPositions;
+}
+
+const vector<vec2f> & StaticBatchBuilder::texCoords(void) const noexcept
+{
+    return mTexCoords;
+}
+
+const vector<vec3f> & StaticBatchBuilder::normals(void) const noexcept
+{
+    return mNormals;
+}
+
+const vector<unsigned int> & StaticBatchBuilder::indices(void) const noexcept
+{
+    return mIndices;
+}
+
+const vector<StaticBatchBuilder::Range> & StaticBatchBuilder::ranges(void) const noexcept
+{
+    return mRanges;
+}
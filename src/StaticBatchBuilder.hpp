@@ -0,0 +1,110 @@
+//===============================================================================================//
+/*!
+ *  \file      StaticBatchBuilder.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "Algebra.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class merges the geometry of static meshes, so that they can be drawn with one draw call per material
+     *  \details The vertices are transformed to world space when they are added, so the merged geometry is drawn with an
+     *           identity world matrix. The triangles are then grouped by texture by build: each Range is a contiguous
+     *           part of the index buffer. All the triangles are stored counter clockwise. The class does not call OpenGL,
+     *           StaticBatch uploads its result.
+     */
+    class StaticBatchBuilder
+    {
+    public:
+        //! Triangles sharing the same texture, contiguous in indices()
+        struct Range
+        {
+            GLuint texture = 0;
+            unsigned int firstIndex = 0;
+            unsigned int indexCount = 0;
+        };
+
+    public:
+        /*!
+         *  \brief Add the vertices of a mesh
+         *  @param pPositions points on pCount positions, in the space of the mesh
+         *  @param pTexCoords points on pCount texture coordinates
+         *  @param pNormals points on pCount normals, in the space of the mesh
+         *  @param pCount is the number of vertices
+         *  @param pWorld is the world matrix of the mesh
+         *  @return the index of the first vertex in the batch, to pass to addTriangles
+         */
+        unsigned int addVertices(const vec3f* pPositions, const vec2f* pTexCoords, const vec3f* pNormals, unsigned int pCount, const mat4f & pWorld);
+
+        /*!
+         *  \brief Add triangles reading the vertices added by the last call to addVertices
+         *  @param pIndices points on pCount indices, 3 per triangle, relative to pBaseVertex
+         *  @param pCount is the number of indices
+         *  @param pBaseVertex was returned by addVertices
+         *  @param pTexture is the color texture of the triangles, 0 if they have none
+         *  @param pFrontFace is the orientation of the front faces of the mesh, GL_CW or GL_CCW
+         */
+        void addTriangles(const unsigned int* pIndices, unsigned int pCount, unsigned int pBaseVertex, GLuint pTexture, GLenum pFrontFace);
+
+        /*!
+         *  \brief Group the triangles added so far by texture
+         */
+        void build(void);
+
+        /*!
+         *  \brief Remove all the geometry
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Get the positions of the vertices
+         *  @return a const reference on the positions, in world space
+         */
+        const std::vector<vec3f> & positions(void) const noexcept;
+
+        /*!
+         *  \brief Get the texture coordinates of the vertices
+         *  @return a const reference on the texture coordinates
+         */
+        const std::vector<vec2f> & texCoords(void) const noexcept;
+
+        /*!
+         *  \brief Get the normals of the vertices
+         *  @return a const reference on the unit normals, in world space
+         */
+        const std::vector<vec3f> & normals(void) const noexcept;
+
+        /*!
+         *  \brief Get the indices of the triangles, sorted by texture after build
+         *  @return a const reference on the indices
+         */
+        const std::vector<unsigned int> & indices(void) const noexcept;
+
+        /*!
+         *  \brief Get the groups of triangles computed by build
+         *  @return a const reference on the ranges, one per texture
+         */
+        const std::vector<Range> & ranges(void) const noexcept;
+
+    private:
+        std::vector<vec3f> mPositions;
+        std::vector<vec2f> mTexCoords;
+        std::vector<vec3f> mNormals;
+        std::vector<unsigned int> mIndices;
+        std::vector<Range> mParts;          //!< Triangles in the order of addTriangles, merged by build
+        std::vector<Range> mRanges;
+        bool mMirrored = false;             //!< The world matrix of the last vertices reverses the orientation
+
+    }; // class StaticBatchBuilder
+
+} // namespace miniGL
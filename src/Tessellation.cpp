@@ -9,16 +9,18 @@
 #include "Tessellation.hpp"
 
 #include "EngineCommon.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using std::shared_ptr;
 using std::make_unique;
-using std::map;
 using std::vector;
 using miniGL::Camera;
 using miniGL::Tessellation;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
+using miniGL::GLStateCache;
 
 void Tessellation::init(unsigned int pPointLightCount, const string & pDisplacementMapFilename)
 {
@@ -37,30 +39,14 @@ void Tessellation::init(unsigned int pPointLightCount, const string & pDisplacem
     mDisplacementMap.bind(DISPLACEMENT_TEXTURE_UNIT);
 }
 
-void Tessellation::render(map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void Tessellation::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
-    // Find the meshes to render
-    vector<map<string, MeshAndTransform>::iterator> lMeshReferences;
-    lMeshReferences.reserve(mMeshToRenderNames.size());
-
-    for (auto it = pMeshes.begin(); it != pMeshes.end(); it++)
-    {
-        for (const auto name : mMeshToRenderNames)
-        {
-            if (it->first == name)
-            {
-                lMeshReferences.push_back(it);
-            }
-        }
-    }
+    // Find the meshes to render, the names are only resolved the first time
+    const auto & lMeshReferences = mMeshesToRender.meshes(pMeshes);
 
     mTessellationLighting->use();
-    mTessellationLighting->eyeWorldPosition(mCamera->position());
     mTessellationLighting->maxDistanceToCameraCoeff(10.0f);
 
-    mat4f lVP = mCamera->projection() * mCamera->view();
-    mTessellationLighting->VP(lVP);
-
     mTessellationLighting->displacementFactor(mDisplacementFactor);
 
     mTessellationLighting->updateLightsState(pLights);
@@ -68,20 +54,20 @@ void Tessellation::render(map<string, MeshAndTransform> & pMeshes, const vector<
     mDisplacementMap.bind(DISPLACEMENT_TEXTURE_UNIT);
 
     // Disable face culling for tessalation as apparently, we cannot garantee the orientation of the generated triangles
-    glDisable(GL_CULL_FACE);
+    GLStateCache::disable(GL_CULL_FACE);
 
-    for (auto it : lMeshReferences)
+    for (const auto rMesh : lMeshReferences)
     {
-        for (auto transformation : it->second.transform)
+        for (unsigned int j = 0; j < rMesh->transform.size(); ++j)
         {
-            mat4f lWorld = transformation.final();
+            mat4f lWorld = rMesh->transform.world(j);
             mTessellationLighting->worldMatrix(lWorld);
 
-            it->second.mesh->render(MeshBase::EPrimitiveType::PATCH);
+            rMesh->mesh->render(MeshBase::EPrimitiveType::PATCH);
         }
     }
 
-    glEnable(GL_CULL_FACE);
+    GLStateCache::enable(GL_CULL_FACE);
 }
 
 void Tessellation::camera(const shared_ptr<Camera> pCamera)
@@ -91,7 +77,7 @@ void Tessellation::camera(const shared_ptr<Camera> pCamera)
 
 void Tessellation::addMeshToRender(const string & pName)
 {
-    mMeshToRenderNames.push_back(pName);
+    mMeshesToRender.add(pName);
 }
 
 void Tessellation::displacementFactor(float pValue) noexcept
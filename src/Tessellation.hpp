@@ -9,12 +9,11 @@
 #pragma once
 
 #include <string>
-#include <map>
 #include <vector>
 
 #include "BaseLight.hpp"
 #include "Camera.hpp"
-#include "MeshAndTransform.hpp"
+#include "MeshRegistry.hpp"
 #include "TessellationLighting.hpp"
 #include "Texture.hpp"
 
@@ -40,7 +39,7 @@ namespace miniGL
          *  @param pMeshes is a container with all the meshes
          *  @param pLights is a container with all the lights
          */
-        void render(std::map<std::string, MeshAndTransform> & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
+        void render(const MeshRegistry & pMeshes, const std::vector<std::shared_ptr<BaseLight>> & pLights);
 
         /*!
          *  \brief Set a copy of the camera
@@ -88,7 +87,7 @@ namespace miniGL
         }
 
     private:
-        std::vector<std::string> mMeshToRenderNames;
+        MeshSelection mMeshesToRender;
         std::unique_ptr<TessellationLighting> mTessellationLighting;
         std::shared_ptr<Camera> mCamera;
         Texture mDisplacementMap;
@@ -126,7 +126,6 @@ void TessellationLighting::init(unsigned int pPointLightCount, unsigned int pSpo
     LightingBase::initLightParametersLocations();
 
     // General parameters
-    initUniformLocation(GENERAL_LIGHTING_PARAM::VP, "uVP");
     initUniformLocation(GENERAL_LIGHTING_PARAM::WORLD_MATRIX, "uWorld");
     initUniformLocation(GENERAL_LIGHTING_PARAM::SAMPLER, "uSampler");
 
@@ -148,7 +147,6 @@ void TessellationLighting::init(unsigned int pPointLightCount, unsigned int pSpo
     }
 
 
-    initUniformLocation(GENERAL_LIGHTING_PARAM::EYE_WORLD_POS, "uEyeWorldPos");
     initUniformLocation(GENERAL_LIGHTING_PARAM::MATERIAL_SPECULAR_INTENSITY, "uMaterialSpecularIntensity");
     initUniformLocation(GENERAL_LIGHTING_PARAM::MATERIAL_SPECULAR_POWER, "uMaterialSpecularPower");
 
@@ -170,21 +168,11 @@ void TessellationLighting::init(unsigned int pPointLightCount, unsigned int pSpo
         maxDistanceToCameraCoeff(10.0f);
 }
 
-void TessellationLighting::VP(const mat4f & pVP)
-{
-    glUniformMatrix4fv(mGeneralParameterLocations[toUT(GENERAL_LIGHTING_PARAM::VP)], 1, GL_TRUE, const_cast<mat4f&>(pVP).data());
-}
-
 void TessellationLighting::worldMatrix(const mat4f & pWorld)
 {
     glUniformMatrix4fv(mGeneralParameterLocations[toUT(GENERAL_LIGHTING_PARAM::WORLD_MATRIX)], 1, GL_TRUE, const_cast<mat4f&>(pWorld).data());
 }
 
-void TessellationLighting::eyeWorldPosition(const vec3f & pEyeWorldPos)
-{
-    glUniform3f(mGeneralParameterLocations[toUT(GENERAL_LIGHTING_PARAM::EYE_WORLD_POS)], pEyeWorldPos.x(), pEyeWorldPos.y(), pEyeWorldPos.z());
-}
-
 void TessellationLighting::textureUnit(GENERAL_LIGHTING_PARAM pParam, unsigned int pTexUnit)
 {
     switch (pParam)
@@ -36,17 +36,15 @@ namespace miniGL
 
         enum class GENERAL_LIGHTING_PARAM : size_t
         {
-            VP                                = 0,
-            WORLD_MATRIX                    = 1,
-            SAMPLER                            = 2,
-            MAX_DISTANCE_TO_CAMERA_COEFF    = 3,
-            DISPLACEMENT_MAP                = 4,
-            DISPLACEMENT_FACTOR                = 5,
-            TESSELLATION_LEVEL                = 6,
-            USE_SAMPLER                        = 7,
-            EYE_WORLD_POS                    = 8,
-            MATERIAL_SPECULAR_INTENSITY        = 9,
-            MATERIAL_SPECULAR_POWER            = 10
+            WORLD_MATRIX                    = 0,
+            SAMPLER                         = 1,
+            MAX_DISTANCE_TO_CAMERA_COEFF    = 2,
+            DISPLACEMENT_MAP                = 3,
+            DISPLACEMENT_FACTOR             = 4,
+            TESSELLATION_LEVEL              = 5,
+            USE_SAMPLER                     = 6,
+            MATERIAL_SPECULAR_INTENSITY     = 7,
+            MATERIAL_SPECULAR_POWER         = 8
         };
 
     public:
@@ -77,24 +75,12 @@ namespace miniGL
                   const std::string & pPathES = std::string(R"(./Shaders/TessellationLighting.eval)"),
                   const std::string & pPathFS = std::string(R"(./Shaders/TessellationLighting.frag)"));
 
-        /*!
-         *  \brief Set the view projection matrix
-         *  @param pVP is a 4x4 matrix
-         */
-        void VP(const mat4f & pVP);
-
         /*!
          *  \brief Set the world matrix
          *  @param pWorld is a 4x4 matrix
          */
         void worldMatrix(const mat4f & pWorld);
 
-        /*!
-         *  \brief Set the position of the camera to calculate the specular component
-         *  @param pPos is the position of the camera
-         */
-        void eyeWorldPosition(const vec3f & pPos);
-
         /*!
          *  \brief Set the texture unit
          *  @param pParam is a general parameter corresponding to a texture
@@ -153,7 +139,7 @@ namespace miniGL
         GLint initUniformLocation(GENERAL_LIGHTING_PARAM pParam, const char* pName);
 
     private:
-        std::array<GLuint, 11> mGeneralParameterLocations;
+        std::array<GLuint, 9> mGeneralParameterLocations;
         const EMode mMode;
 
     }; // class TessellationLighting
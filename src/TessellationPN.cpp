@@ -14,11 +14,11 @@
 using std::string;
 using std::shared_ptr;
 using std::make_unique;
-using std::map;
 using std::vector;
 using miniGL::Camera;
 using miniGL::TessellationPN;
 using miniGL::MeshAndTransform;
+using miniGL::MeshRegistry;
 using miniGL::BaseLight;
 
 void TessellationPN::init(unsigned int pPointLightCount)
@@ -35,42 +35,26 @@ void TessellationPN::init(unsigned int pPointLightCount)
     //    _validateShaderWithMesh(mTessellationPNLighting, lName);
 }
 
-void TessellationPN::render(map<string, MeshAndTransform> & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
+void TessellationPN::render(const MeshRegistry & pMeshes, const vector<shared_ptr<BaseLight>> & pLights)
 {
-    // Find the meshes to render
-    vector<map<string, MeshAndTransform>::iterator> lMeshReferences;
-    lMeshReferences.reserve(mMeshToRenderNames.size());
-
-    for (auto it = pMeshes.begin(); it != pMeshes.end(); it++)
-    {
-        for (const auto name : mMeshToRenderNames)
-        {
-            if (it->first == name)
-            {
-                lMeshReferences.push_back(it);
-            }
-        }
-    }
+    // Find the meshes to render, the names are only resolved the first time
+    const auto & lMeshReferences = mMeshesToRender.meshes(pMeshes);
 
     mTessellationLighting->use();
-    mTessellationLighting->eyeWorldPosition(mCamera->position());
     mTessellationLighting->useSampler(false);
 
-    mat4f lVP = mCamera->projection() * mCamera->view();
-    mTessellationLighting->VP(lVP);
-
     mTessellationLighting->updateLightsState(pLights);
 
     unsigned int i = 0;
-    for (auto it : lMeshReferences)
+    for (const auto rMesh : lMeshReferences)
     {
-        for (auto transformation : it->second.transform)
+        for (unsigned int j = 0; j < rMesh->transform.size(); ++j)
         {
-            mat4f lWorld = transformation.final();
+            mat4f lWorld = rMesh->transform.world(j);
             mTessellationLighting->worldMatrix(lWorld);
 
             mTessellationLighting->tessellationLevel(mTessellationLevel.at(i++));
-            it->second.mesh->render(MeshBase::EPrimitiveType::PATCH);
+            rMesh->mesh->render(MeshBase::EPrimitiveType::PATCH);
         }
     }
 }
@@ -82,7 +66,7 @@ void TessellationPN::camera(const shared_ptr<Camera> pCamera)
 
 void TessellationPN::addMeshToRender(const string & pName)
 {
-    mMeshToRenderNames.push_back(pName);
+    mMeshesToRender.add(pName);
 }
 
 void TessellationPN::addTessellationLevel(float pValue)
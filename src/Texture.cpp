@@ -12,10 +12,12 @@
 
 #include "GLUtils.hpp"
 #include "Log.hpp"
+#include "GLStateCache.hpp"
 
 using std::string;
 using miniGL::Texture;
 using miniGL::Log;
+using miniGL::GLStateCache;
 
 Texture::Texture()
 :mTextureTarget(-1),
@@ -42,7 +44,7 @@ Texture::~Texture(void)
     lMessage.append(__FUNCTION__);
     Log::consoleMessage(lMessage);
 
-    glDeleteTextures(1, &mTextureObject); checkOpenGLState;
+    GLStateCache::deleteTextures(1, &mTextureObject); checkOpenGLState;
 
     lMessage.assign("Deleting ");
     lMessage.append(mPath);
@@ -70,7 +72,7 @@ bool Texture::loadImage(const string & pPath)
     }
 
     glGenTextures(1, &mTextureObject); checkOpenGLState;
-    glBindTexture(mTextureTarget, mTextureObject); checkOpenGLState;
+    GLStateCache::bindTexture(mTextureTarget, mTextureObject); checkOpenGLState;
 
     switch (mTextureTarget)
     {
@@ -95,7 +97,7 @@ bool Texture::loadImage(const string & pPath)
 
     glTexParameterf(mTextureTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR); checkOpenGLState;
     glTexParameterf(mTextureTarget, GL_TEXTURE_MAG_FILTER, GL_LINEAR); checkOpenGLState;
-    glBindTexture(mTextureTarget, 0); checkOpenGLState;
+    GLStateCache::bindTexture(mTextureTarget, 0); checkOpenGLState;
 
     mImageLoaded = true;
 
@@ -14,6 +14,8 @@
 
 #include <Magick++.h>
 
+#include "GLStateCache.hpp"
+
 namespace miniGL
 {
     /*!
@@ -64,6 +66,12 @@ namespace miniGL
          */
         void bind(GLenum pTextureUnit);
 
+        /*!
+         *  \brief Get the texture object
+         *  @return the handle of the texture in openGL, e.g. to bind it later from a DrawPacket
+         */
+        GLuint id(void) const noexcept;
+
         /*!
          *  \brief Check if an image was already loaded to the texture
          *  @return true if an image was already loaded, false otherwise
@@ -92,8 +100,13 @@ namespace miniGL
 
     inline void Texture::bind(GLenum pTextureUnit)
     {
-        glActiveTexture(pTextureUnit);
-        glBindTexture(mTextureTarget, mTextureObject);
+        GLStateCache::activeTexture(pTextureUnit);
+        GLStateCache::bindTexture(mTextureTarget, mTextureObject);
+    }
+
+    inline GLuint Texture::id(void) const noexcept
+    {
+        return mTextureObject;
     }
 
     inline bool Texture::isLoaded() const noexcept
@@ -33,28 +33,7 @@ void Transform::scaling(float pFactorX, float pFactorY, float pFactorZ)
 
 void Transform::rotation(degreef pAngleX, degreef pAngleY, degreef pAngleZ)
 {
-    mat4f lRotX, lRotY, lRotZ;
-
-    const float lX = pAngleX.toRadian();
-    const float lY = pAngleY.toRadian();
-    const float lZ = pAngleZ.toRadian();
-
-    lRotX(0,0) = 1.0f;         lRotX(0,1) = 0.0f;         lRotX(0,2) = 0.0f;         lRotX(0,3) = 0.0f;
-    lRotX(1,0) = 0.0f;         lRotX(1,1) = cosf(lX);     lRotX(1,2) = -sinf(lX);    lRotX(1,3) = 0.0f;
-    lRotX(2,0) = 0.0f;         lRotX(2,1) = sinf(lX);     lRotX(2,2) = cosf(lX);     lRotX(2,3) = 0.0f;
-    lRotX(3,0) = 0.0f;         lRotX(3,1) = 0.0f;         lRotX(3,2) = 0.0f;         lRotX(3,3) = 1.0f;
-
-    lRotY(0,0) = cosf(lY);     lRotY(0,1) = 0.0f;         lRotY(0,2) = -sinf(lY);    lRotY(0,3) = 0.0f;
-    lRotY(1,0) = 0.0f;         lRotY(1,1) = 1.0f;         lRotY(1,2) = 0.0f;         lRotY(1,3) = 0.0f;
-    lRotY(2,0) = sinf(lY);     lRotY(2,1) = 0.0f;         lRotY(2,2) = cosf(lY);     lRotY(2,3) = 0.0f;
-    lRotY(3,0) = 0.0f;         lRotY(3,1) = 0.0f;         lRotY(3,2) = 0.0f;         lRotY(3,3) = 1.0f;
-
-    lRotZ(0,0) = cosf(lZ);     lRotZ(0,1) = -sinf(lZ);    lRotZ(0,2) = 0.0f;         lRotZ(0,3) = 0.0f;
-    lRotZ(1,0) = sinf(lZ);     lRotZ(1,1) = cosf(lZ);     lRotZ(1,2) = 0.0f;         lRotZ(1,3) = 0.0f;
-    lRotZ(2,0) = 0.0f;         lRotZ(2,1) = 0.0f;         lRotZ(2,2) = 1.0f;         lRotZ(2,3) = 0.0f;
-    lRotZ(3,0) = 0.0f;         lRotZ(3,1) = 0.0f;         lRotZ(3,2) = 0.0f;         lRotZ(3,3) = 1.0f;
-
-    mRotation = lRotZ * lRotY * lRotX;
+    mRotation = rotationMatrix(pAngleX, pAngleY, pAngleZ);
 
     mUpdated = true;
 }
@@ -114,3 +93,29 @@ mat4f Transform::final(void) const noexcept
 
     return mFinal;
 }
+
+mat4f Transform::rotationMatrix(degreef pAngleX, degreef pAngleY, degreef pAngleZ)
+{
+    mat4f lRotX, lRotY, lRotZ;
+
+    const float lX = pAngleX.toRadian();
+    const float lY = pAngleY.toRadian();
+    const float lZ = pAngleZ.toRadian();
+
+    lRotX(0,0) = 1.0f;         lRotX(0,1) = 0.0f;         lRotX(0,2) = 0.0f;         lRotX(0,3) = 0.0f;
+    lRotX(1,0) = 0.0f;         lRotX(1,1) = cosf(lX);     lRotX(1,2) = -sinf(lX);    lRotX(1,3) = 0.0f;
+    lRotX(2,0) = 0.0f;         lRotX(2,1) = sinf(lX);     lRotX(2,2) = cosf(lX);     lRotX(2,3) = 0.0f;
+    lRotX(3,0) = 0.0f;         lRotX(3,1) = 0.0f;         lRotX(3,2) = 0.0f;         lRotX(3,3) = 1.0f;
+
+    lRotY(0,0) = cosf(lY);     lRotY(0,1) = 0.0f;         lRotY(0,2) = -sinf(lY);    lRotY(0,3) = 0.0f;
+    lRotY(1,0) = 0.0f;         lRotY(1,1) = 1.0f;         lRotY(1,2) = 0.0f;         lRotY(1,3) = 0.0f;
+    lRotY(2,0) = sinf(lY);     lRotY(2,1) = 0.0f;         lRotY(2,2) = cosf(lY);     lRotY(2,3) = 0.0f;
+    lRotY(3,0) = 0.0f;         lRotY(3,1) = 0.0f;         lRotY(3,2) = 0.0f;         lRotY(3,3) = 1.0f;
+
+    lRotZ(0,0) = cosf(lZ);     lRotZ(0,1) = -sinf(lZ);    lRotZ(0,2) = 0.0f;         lRotZ(0,3) = 0.0f;
+    lRotZ(1,0) = sinf(lZ);     lRotZ(1,1) = cosf(lZ);     lRotZ(1,2) = 0.0f;         lRotZ(1,3) = 0.0f;
+    lRotZ(2,0) = 0.0f;         lRotZ(2,1) = 0.0f;         lRotZ(2,2) = 1.0f;         lRotZ(2,3) = 0.0f;
+    lRotZ(3,0) = 0.0f;         lRotZ(3,1) = 0.0f;         lRotZ(3,2) = 0.0f;         lRotZ(3,3) = 1.0f;
+
+    return lRotZ * lRotY * lRotX;
+}
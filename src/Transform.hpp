@@ -94,6 +94,15 @@ namespace miniGL
          */
         mat4f final(void) const noexcept;
 
+        /*!
+         * \brief Compute a rotation matrix from 3 rotation angles, applied around x, then y, then z
+         * @param pAngleX is the angle of the rotation around the x axis in degrees
+         * @param pAngleY is the angle of the rotation around the y axis in degrees
+         * @param pAngleZ is the angle of the rotation around the z axis in degrees
+         * @return a 4x4 matrix corresponding to the product rotZ * rotY * rotX
+         */
+        static mat4f rotationMatrix(degreef pAngleX, degreef pAngleY, degreef pAngleZ);
+
     private:
         mat4f mScaling;
         mat4f mRotation;
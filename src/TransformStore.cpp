@@ -0,0 +1,236 @@
+//===============================================================================================//
+/*!
+ *  \file      TransformStore.cpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#include "TransformStore.hpp"
+
+#include <cassert>
+
+// Below this number of transforms, waking up the threads costs more than updating the matrices
+#define TRANSFORM_STORE_PARALLEL_MIN 1024
+
+using miniGL::TransformStore;
+using miniGL::Transform;
+using miniGL::JobSystem;
+
+void TransformStore::Reference::scaling(float pFactorX, float pFactorY, float pFactorZ)
+{
+    mStore->mScalings[mIndex] = vec3f(pFactorX, pFactorY, pFactorZ);
+    mStore->_touch(mIndex);
+}
+
+void TransformStore::Reference::rotation(const mat4f & pRotationMatrix)
+{
+    mStore->mRotations[mIndex] = pRotationMatrix;
+    mStore->_touch(mIndex);
+}
+
+void TransformStore::Reference::rotation(degreef pAngleX, degreef pAngleY, degreef pAngleZ)
+{
+    mStore->mRotations[mIndex] = Transform::rotationMatrix(pAngleX, pAngleY, pAngleZ);
+    mStore->_touch(mIndex);
+}
+
+void TransformStore::Reference::translation(float pX, float pY, float pZ)
+{
+    mStore->mTranslations[mIndex] = vec3f(pX, pY, pZ);
+    mStore->_touch(mIndex);
+}
+
+void TransformStore::Reference::parent(const SceneGraph* pSceneGraph, SceneNodeHandle pNode)
+{
+    assert((mStore->mSceneGraph == nullptr || mStore->mSceneGraph == pSceneGraph) && "All the transforms of a store must use the same scene graph");
+
+    mStore->mSceneGraph = pSceneGraph;
+    mStore->mParents[mIndex] = pNode;
+    mStore->_touch(mIndex);
+}
+
+vec3f TransformStore::Reference::scaling(void) const
+{
+    return mStore->mScalings[mIndex];
+}
+
+mat4f TransformStore::Reference::rotation(void) const
+{
+    return mStore->mRotations[mIndex];
+}
+
+vec3f TransformStore::Reference::translation(void) const
+{
+    return mStore->mTranslations[mIndex];
+}
+
+TransformStore::Reference::Reference(TransformStore* pStore, unsigned int pIndex) noexcept
+:mStore(pStore),
+ mIndex(pIndex)
+{
+}
+
+void TransformStore::emplace_back(void)
+{
+    mScalings.push_back(vec3f(1.0f, 1.0f, 1.0f));
+    mRotations.push_back(mat4f(1.0f));
+    mTranslations.push_back(vec3f(0.0f, 0.0f, 0.0f));
+    mWorlds.push_back(mat4f(1.0f));
+    mWVPs.push_back(mat4f(1.0f));
+    mDirty.push_back(1);
+    mParents.push_back(SceneGraph::invalidHandle());
+    mParentVersions.push_back(0);
+
+    mHasDirty = true;
+}
+
+void TransformStore::push_back(const Transform & pTransform)
+{
+    emplace_back();
+
+    const mat4f lScaling = pTransform.scaling();
+    const mat4f lTranslation = pTransform.translation();
+
+    mScalings.back() = vec3f(lScaling(0,0), lScaling(1,1), lScaling(2,2));
+    mRotations.back() = pTransform.rotation();
+    mTranslations.back() = vec3f(lTranslation(0,3), lTranslation(1,3), lTranslation(2,3));
+}
+
+void TransformStore::clear(void)
+{
+    mScalings.clear();
+    mRotations.clear();
+    mTranslations.clear();
+    mWorlds.clear();
+    mWVPs.clear();
+    mDirty.clear();
+    mParents.clear();
+    mParentVersions.clear();
+
+    mSceneGraph = nullptr;
+    mHasDirty = false;
+}
+
+unsigned int TransformStore::size(void) const noexcept
+{
+    return static_cast<unsigned int>(mDirty.size());
+}
+
+TransformStore::Reference TransformStore::operator[](unsigned int pIndex)
+{
+    assert(pIndex < size() && "Transform index out of boundaries");
+
+    return Reference(this, pIndex);
+}
+
+TransformStore::Reference TransformStore::back(void)
+{
+    assert(size() > 0 && "No transform in the store");
+
+    return Reference(this, size() - 1);
+}
+
+void TransformStore::update(const mat4f & pViewProjection, JobSystem* pJobSystem)
+{
+    const bool lViewProjectionChanged = !mHasViewProjection || !_equal(mViewProjection, pViewProjection);
+
+    // Nothing moved since the last update, e.g. when several techniques are rendered in the same frame
+    if (!lViewProjectionChanged && !mHasDirty && mSceneGraph == nullptr)
+        return;
+
+    mViewProjection = pViewProjection;
+    mHasViewProjection = true;
+
+    if (pJobSystem != nullptr && size() >= TRANSFORM_STORE_PARALLEL_MIN)
+        pJobSystem->parallelFor(size(), [this, lViewProjectionChanged](unsigned int pBegin, unsigned int pEnd){ _update(pBegin, pEnd, lViewProjectionChanged); });
+    else
+        _update(0, size(), lViewProjectionChanged);
+
+    mHasDirty = false;
+}
+
+const mat4f & TransformStore::world(unsigned int pIndex) const
+{
+    assert(pIndex < size() && "Transform index out of boundaries");
+    assert(!mDirty[pIndex] && "The transform was modified after the last update");
+
+    return mWorlds[pIndex];
+}
+
+const mat4f & TransformStore::WVP(unsigned int pIndex) const
+{
+    assert(pIndex < size() && "Transform index out of boundaries");
+    assert(!mDirty[pIndex] && "The transform was modified after the last update");
+
+    return mWVPs[pIndex];
+}
+
+bool TransformStore::dirty(unsigned int pIndex) const
+{
+    assert(pIndex < size() && "Transform index out of boundaries");
+
+    return mDirty[pIndex] != 0;
+}
+
+void TransformStore::_touch(unsigned int pIndex) noexcept
+{
+    mDirty[pIndex] = 1;
+    mHasDirty = true;
+}
+
+void TransformStore::_update(unsigned int pBegin, unsigned int pEnd, bool pViewProjectionChanged)
+{
+    for (unsigned int i = pBegin; i < pEnd; ++i)
+    {
+        const SceneNodeHandle lParent = mParents[i];
+        const bool lParentMoved = lParent != SceneGraph::invalidHandle() && mSceneGraph->version(lParent) != mParentVersions[i];
+
+        if (mDirty[i] == 0 && !lParentMoved && !pViewProjectionChanged)
+            continue;
+
+        if (mDirty[i] != 0 || lParentMoved)
+        {
+            // translation * rotation * scaling without the 2 full matrix products: the translation adds to the first 3 rows
+            // a multiple of the last one, and the scaling multiplies the first 3 columns
+            const mat4f & rRotation = mRotations[i];
+            const vec3f & rScaling = mScalings[i];
+            const vec3f & rTranslation = mTranslations[i];
+            mat4f & rWorld = mWorlds[i];
+
+            for (unsigned int col = 0; col < 4; ++col)
+            {
+                const float lScale = col < 3 ? rScaling[col] : 1.0f;
+
+                for (unsigned int row = 0; row < 3; ++row)
+                    rWorld(row, col) = (rRotation(row, col) + rTranslation[row] * rRotation(3, col)) * lScale;
+
+                rWorld(3, col) = rRotation(3, col) * lScale;
+            }
+
+            if (lParent != SceneGraph::invalidHandle())
+            {
+                rWorld = mSceneGraph->world(lParent) * rWorld;
+                mParentVersions[i] = mSceneGraph->version(lParent);
+            }
+
+            mDirty[i] = 0;
+        }
+
+        mWVPs[i] = mViewProjection * mWorlds[i];
+    }
+}
+
+bool TransformStore::_equal(const mat4f & pA, const mat4f & pB) noexcept
+{
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+        for (unsigned int col = 0; col < 4; ++col)
+        {
+            if (pA(row, col) != pB(row, col))
+                return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,218 @@
+//===============================================================================================//
+/*!
+ *  \file      TransformStore.hpp
+ *  \author    Loïc Corenthy
+ *  \version   1.0
+ */
+//===============================================================================================//
+
+#pragma once
+
+#include <vector>
+
+#include "Algebra.hpp"
+#include "Angle.hpp"
+#include "Transform.hpp"
+#include "JobSystem.hpp"
+#include "SceneGraph.hpp"
+
+namespace miniGL
+{
+    /*!
+     *  \brief   This class stores the transforms of the instances of a mesh in separate arrays
+     *  \details The scalings, rotations and translations are stored in their own arrays, with a dirty flag per instance.
+     *           Once per frame, update computes the world matrix of the dirty instances and the world-view-projection
+     *           matrix of the instances that changed or of all of them if the view-projection changed, optionally in
+     *           parallel chunks. The techniques then read the precomputed matrices by index instead of copying a
+     *           Transform and multiplying the matrices again for each pass. A transform can be attached to a node of a
+     *           SceneGraph, its world matrix is then relative to the node and follows it.
+     */
+    class TransformStore
+    {
+    public:
+        /*!
+         *  \brief   Reference on one transform of the store
+         *  \details It has the same setters as Transform and marks the transform as dirty. It stays valid as long as the
+         *           store is not resized.
+         */
+        class Reference
+        {
+        public:
+            /*!
+             * \brief Set the scaling factor in each direction
+             * @param pFactorX is the scaling factor in x
+             * @param pFactorY is the scaling factor in y
+             * @param pFactorZ is the scaling factor in z
+             */
+            void scaling(float pFactorX, float pFactorY, float pFactorZ);
+
+            /*!
+             * \brief Set the rotation matrix
+             * @param pRotationMatrix is a 4x4 matrix defining the rotation transformation
+             */
+            void rotation(const mat4f & pRotationMatrix);
+
+            /*!
+             * \brief Set the rotation as 3 rotation angles
+             * @param pAngleX is the angle of the rotation around the x axis in degrees
+             * @param pAngleY is the angle of the rotation around the y axis in degrees
+             * @param pAngleZ is the angle of the rotation around the z axis in degrees
+             */
+            void rotation(degreef pAngleX, degreef pAngleY, degreef pAngleZ);
+
+            /*!
+             * \brief Set the translation
+             * @param pX is the translation in x
+             * @param pY is the translation in y
+             * @param pZ is the translation in z
+             */
+            void translation(float pX, float pY, float pZ);
+
+            /*!
+             * \brief Attach the transform to a node of a scene graph, so that it moves with the node
+             * @param pSceneGraph is the scene graph containing the node, all the transforms of a store must use the same
+             *        one and it must be updated before the store
+             * @param pNode is a node of pSceneGraph, or SceneGraph::invalidHandle() to detach the transform
+             */
+            void parent(const SceneGraph* pSceneGraph, SceneNodeHandle pNode);
+
+            /*!
+             * \brief Get the scaling factors
+             * @return the scaling factor in each direction
+             */
+            vec3f scaling(void) const;
+
+            /*!
+             * \brief Get the rotation matrix
+             * @return a 4x4 matrix corresponding to the rotation that have been previously defined (identity matrix otherwise)
+             */
+            mat4f rotation(void) const;
+
+            /*!
+             * \brief Get the translation
+             * @return a 3D vector describing the translation
+             */
+            vec3f translation(void) const;
+
+        private:
+            friend class TransformStore;
+
+            /*!
+             * \brief Constructor, only the store creates references
+             * @param pStore is the store containing the transform
+             * @param pIndex is the index of the transform in the store
+             */
+            Reference(TransformStore* pStore, unsigned int pIndex) noexcept;
+
+        private:
+            TransformStore* mStore;
+            unsigned int mIndex;
+
+        }; // class Reference
+
+    public:
+        /*!
+         *  \brief Add an identity transform
+         */
+        void emplace_back(void);
+
+        /*!
+         *  \brief Add a transform
+         *  @param pTransform is the transform to copy, its scaling matrix must be diagonal and its translation matrix
+         *         must only have a translation
+         */
+        void push_back(const Transform & pTransform);
+
+        /*!
+         *  \brief Remove all the transforms
+         */
+        void clear(void);
+
+        /*!
+         *  \brief Get the number of transforms
+         *  @return the number of transforms in the store
+         */
+        unsigned int size(void) const noexcept;
+
+        /*!
+         *  \brief Access a transform to modify it
+         *  @param pIndex is in the range [0, size())
+         *  @return a reference on the transform
+         */
+        Reference operator[](unsigned int pIndex);
+
+        /*!
+         *  \brief Access the last transform to modify it
+         *  @return a reference on the last transform
+         */
+        Reference back(void);
+
+        /*!
+         *  \brief Compute the world and world-view-projection matrices that changed since the last update
+         *  @param pViewProjection is the product projection * view of the camera
+         *  @param pJobSystem splits the transforms between several threads, or nullptr to update them on the calling thread
+         */
+        void update(const mat4f & pViewProjection, JobSystem* pJobSystem = nullptr);
+
+        /*!
+         *  \brief Get the world matrix of a transform, computed by the last update
+         *  @param pIndex is in the range [0, size())
+         *  @return a reference on the product parent * translation * rotation * scaling, the parent being the world
+         *          matrix of the scene graph node or the identity
+         */
+        const mat4f & world(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the world-view-projection matrix of a transform, computed by the last update
+         *  @param pIndex is in the range [0, size())
+         *  @return a reference on the product viewProjection * world
+         */
+        const mat4f & WVP(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Check if a transform was modified after the last update
+         *  @param pIndex is in the range [0, size())
+         *  @return true if world and WVP are not up to date for this transform
+         */
+        bool dirty(unsigned int pIndex) const;
+
+    private:
+        /*!
+         *  \brief Helper method to mark a transform as modified
+         *  @param pIndex is the index of the transform
+         */
+        void _touch(unsigned int pIndex) noexcept;
+
+        /*!
+         *  \brief Helper method to update a range of transforms
+         *  @param pBegin is the index of the first transform
+         *  @param pEnd is the index after the last transform
+         *  @param pViewProjectionChanged is true if all the WVP matrices must be computed again
+         */
+        void _update(unsigned int pBegin, unsigned int pEnd, bool pViewProjectionChanged);
+
+        /*!
+         *  \brief Helper method to compare two matrices (Matrix::operator== is not const)
+         *  @param pA is the first matrix
+         *  @param pB is the second matrix
+         *  @return true if all the elements are equal
+         */
+        static bool _equal(const mat4f & pA, const mat4f & pB) noexcept;
+
+    private:
+        std::vector<vec3f> mScalings;
+        std::vector<mat4f> mRotations;
+        std::vector<vec3f> mTranslations;
+        std::vector<mat4f> mWorlds;
+        std::vector<mat4f> mWVPs;
+        std::vector<unsigned char> mDirty;  //!< Not a vector<bool>, so that threads can write neighbouring flags
+        std::vector<SceneNodeHandle> mParents;
+        std::vector<unsigned int> mParentVersions;
+        const SceneGraph* mSceneGraph = nullptr;
+        mat4f mViewProjection = mat4f(0.0f);
+        bool mHasDirty = false;
+        bool mHasViewProjection = false;
+
+    }; // class TransformStore
+
+} // namespace miniGL
@@ -14,7 +14,9 @@ namespace miniGL
 {
     /*!
      *  \brief Simple class to keep bone parameters
-     *  \details Parameters: ID and weight for each bone
+     *  \details Parameters: ID and weight for each bone. When a vertex is influenced by more than SIZE bones,
+     *           the strongest ones are kept. It is only used while loading a mesh, see PackedBoneData for the
+     *           format sent to the GPU.
      */
     template <unsigned int SIZE>
     class VertexBoneData
@@ -26,12 +28,31 @@ namespace miniGL
         VertexBoneData(void);
 
         /*!
-         *  \brief Add bone parameter for a vertex
+         *  \brief Add bone parameter for a vertex, replacing the weakest bone if all the slots are used
          *  @param pBoneID is the ID of the bone
          *  @param pWeight is the weight associated to the bone for a particular vertex
          */
         void addBoneData(unsigned int pBoneID, float pWeight);
 
+        /*!
+         *  \brief Scale the weights so that their sum is 1 (nothing is done for a vertex without bones)
+         */
+        void normalize(void);
+
+        /*!
+         *  \brief Get the ID of one of the bones influencing the vertex
+         *  @param pIndex is in the range [0, SIZE)
+         *  @return the ID of the bone (0 if the slot is not used)
+         */
+        unsigned int id(unsigned int pIndex) const;
+
+        /*!
+         *  \brief Get the weight of one of the bones influencing the vertex
+         *  @param pIndex is in the range [0, SIZE)
+         *  @return the weight of the bone (0 if the slot is not used)
+         */
+        float weight(unsigned int pIndex) const;
+
     private:
         /*!
          *  \brief Reset the parameters
@@ -47,17 +68,49 @@ namespace miniGL
     template <unsigned int SIZE>
     void VertexBoneData<SIZE>::addBoneData(unsigned int pBoneID, float pWeight)
     {
-        for (unsigned int i = 0; i < mID.size(); ++i)
+        // An empty slot has a weight of 0, so it is always the weakest one
+        unsigned int lWeakest = 0;
+
+        for (unsigned int i = 1; i < mID.size(); ++i)
         {
-            if (mWeight[i] == 0.0f)
-            {
-                mID[i] = pBoneID;
-                mWeight[i] = pWeight;
-                return;
-            }
+            if (mWeight[i] < mWeight[lWeakest])
+                lWeakest = i;
+        }
+
+        if (pWeight > mWeight[lWeakest])
+        {
+            mID[lWeakest] = pBoneID;
+            mWeight[lWeakest] = pWeight;
         }
     }
 
+    template <unsigned int SIZE>
+    void VertexBoneData<SIZE>::normalize(void)
+    {
+        float lSum = 0.0f;
+
+        for (auto w : mWeight)
+            lSum += w;
+
+        if (lSum <= 0.0f)
+            return;
+
+        for (auto & w : mWeight)
+            w /= lSum;
+    }
+
+    template <unsigned int SIZE>
+    unsigned int VertexBoneData<SIZE>::id(unsigned int pIndex) const
+    {
+        return mID[pIndex];
+    }
+
+    template <unsigned int SIZE>
+    float VertexBoneData<SIZE>::weight(unsigned int pIndex) const
+    {
+        return mWeight[pIndex];
+    }
+
     template <unsigned int SIZE>
     VertexBoneData<SIZE>::VertexBoneData(void)
     {
@@ -67,11 +120,8 @@ namespace miniGL
     template <unsigned int SIZE>
     void VertexBoneData<SIZE>::reset(void)
     {
-        for (auto id : mID)
-            id = 0;
-
-        for ( auto w : mWeight)
-            w = 0.0f;
+        mID.fill(0);
+        mWeight.fill(0.0f);
     }
 
 } // namespace miniGL
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <AnimationCursor.hpp>
+
+using std::vector;
+using miniGL::AnimationCursor;
+
+//===============================================================================================//
+// Test fixtures 
+//===============================================================================================//
+
+class AnimationCursorTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		mTimes = { 0.0f, 1.0f, 2.0f, 4.0f, 8.0f };
+		mCursor.reset(2);
+	}
+
+	virtual void TearDown(void) final {}
+
+public:
+	vector<float> mTimes;
+	AnimationCursor mCursor;
+};
+
+//===============================================================================================//
+// Tests 
+//===============================================================================================//
+
+TEST (AnimationCursorConstructor, default)
+{
+	AnimationCursor c;
+
+	ASSERT_EQ(c.channelCount(), 0u);
+}
+
+TEST (AnimationCursorConstructor, withChannelCount)
+{
+	AnimationCursor c(3);
+
+	ASSERT_EQ(c.channelCount(), 3u);
+}
+
+TEST_F (AnimationCursorTest, forwardPlayback)
+{
+	EXPECT_EQ(mCursor.positionKey(0, mTimes, 0.0f), 0u);
+	EXPECT_EQ(mCursor.positionKey(0, mTimes, 0.5f), 0u);
+	EXPECT_EQ(mCursor.positionKey(0, mTimes, 1.0f), 1u) << "A time equal to a key time should use this key";
+	EXPECT_EQ(mCursor.positionKey(0, mTimes, 1.5f), 1u);
+	EXPECT_EQ(mCursor.positionKey(0, mTimes, 3.0f), 2u);
+	EXPECT_EQ(mCursor.positionKey(0, mTimes, 7.9f), 3u);
+}
+
+TEST_F (AnimationCursorTest, seekAndLoop)
+{
+	EXPECT_EQ(mCursor.rotationKey(0, mTimes, 5.0f), 3u) << "A jump over several keys should find the key with a binary search";
+	EXPECT_EQ(mCursor.rotationKey(0, mTimes, 0.2f), 0u) << "Looping back to the start should find the first key";
+	EXPECT_EQ(mCursor.rotationKey(0, mTimes, 2.5f), 2u);
+	EXPECT_EQ(mCursor.rotationKey(0, mTimes, 1.5f), 1u) << "Playing backward should find the previous key";
+}
+
+TEST_F (AnimationCursorTest, clampOutOfRange)
+{
+	EXPECT_EQ(mCursor.scalingKey(0, mTimes, -1.0f), 0u) << "A time before the first key should use the first key";
+	EXPECT_EQ(mCursor.scalingKey(0, mTimes, 8.0f), 3u) << "A time on the last key should use the last interval";
+	EXPECT_EQ(mCursor.scalingKey(0, mTimes, 20.0f), 3u) << "A time after the last key should use the last interval";
+}
+
+TEST_F (AnimationCursorTest, independentChannels)
+{
+	EXPECT_EQ(mCursor.positionKey(0, mTimes, 6.0f), 3u);
+	EXPECT_EQ(mCursor.positionKey(1, mTimes, 0.5f), 0u);
+	EXPECT_EQ(mCursor.rotationKey(0, mTimes, 0.5f), 0u) << "Position, rotation and scaling keys should be stored separately";
+}
+
+TEST (AnimationCursorFindKey, matchesLinearSearch)
+{
+	const vector<float> lTimes = { 0.0f, 0.25f, 0.5f, 1.0f, 1.25f, 3.0f, 3.5f, 6.0f };
+
+	for (unsigned int lPrevious = 0; lPrevious < lTimes.size() - 1; ++lPrevious)
+	{
+		for (float t = 0.0f; t < 6.0f; t += 0.125f)
+		{
+			unsigned int lExpected = 0;
+			for (unsigned int i = 0; i < lTimes.size() - 1; ++i)
+			{
+				if (t < lTimes[i + 1])
+				{
+					lExpected = i;
+					break;
+				}
+			}
+
+			EXPECT_EQ(AnimationCursor::findKey(lTimes, t, lPrevious), lExpected) << "findKey should not depend on the previous key";
+		}
+	}
+}
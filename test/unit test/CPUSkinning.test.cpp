@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <AnimationClip.hpp>
+#include <CPUSkinning.hpp>
+#include <PackedBoneData.hpp>
+#include <JobSystem.hpp>
+#include <VertexBoneData.hpp>
+
+#include "UnitTestHelperFunctions.hpp"
+
+using std::vector;
+using miniGL::AnimationClip;
+using miniGL::CPUSkinning;
+using miniGL::PackedBoneData;
+using miniGL::JobSystem;
+using miniGL::VertexBoneData;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class CPUSkinningTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		for (unsigned int i = 0; i < 8; ++i)
+		{
+			const float lAngle = 0.4f * static_cast<float>(i);
+			const float lSin = sin(lAngle * 0.5f) / sqrt(3.0f);
+
+			mBones.push_back(AnimationClip::compose(vec3f(static_cast<float>(i), 1.0f, -2.0f), quatf(lSin, lSin, -lSin, cos(lAngle * 0.5f)), vec3f(1.0f, 1.0f + 0.1f * i, 1.0f)));
+		}
+	}
+
+	virtual void TearDown(void) final {}
+
+	void addVertices(unsigned int pCount)
+	{
+		for (unsigned int i = 0; i < pCount; ++i)
+		{
+			const float t = static_cast<float>(i);
+
+			mPositions.push_back(vec3f(cos(t), sin(t), t * 0.01f));
+			mNormals.push_back(vec3f(0.0f, sin(t), cos(t)));
+
+			// 1 to 4 influences per vertex, the weights sum to 1
+			VertexBoneData<MAX_BONE_INFLUENCES> lBoneData;
+			const unsigned int lInfluences = i % 4 + 1;
+
+			for (unsigned int j = 0; j < lInfluences; ++j)
+				lBoneData.addBoneData((i + j * 3) % mBones.size(), 1.0f / lInfluences);
+
+			mBoneData.push_back(lBoneData);
+		}
+
+		mPackedBones.pack(mBoneData, 4, static_cast<unsigned int>(mBones.size()));
+	}
+
+	vec3f expectedPosition(unsigned int pVertex) const
+	{
+		vec3f lRes(0.0f, 0.0f, 0.0f);
+		const vec3f & rP = mPositions[pVertex];
+
+		for (unsigned int j = 0; j < 4; ++j)
+		{
+			const mat4f & rM = mBones[mPackedBones.id(pVertex, j)];
+			const float w = mPackedBones.weight(pVertex, j);
+
+			lRes = lRes + vec3f(rM(0,0) * rP.x() + rM(0,1) * rP.y() + rM(0,2) * rP.z() + rM(0,3),
+								rM(1,0) * rP.x() + rM(1,1) * rP.y() + rM(1,2) * rP.z() + rM(1,3),
+								rM(2,0) * rP.x() + rM(2,1) * rP.y() + rM(2,2) * rP.z() + rM(2,3)) * w;
+		}
+
+		return lRes;
+	}
+
+public:
+	vector<mat4f> mBones;
+	vector<vec3f> mPositions;
+	vector<vec3f> mNormals;
+	vector<VertexBoneData<MAX_BONE_INFLUENCES>> mBoneData;
+	PackedBoneData mPackedBones;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (CPUSkinningTest, identity)
+{
+	addVertices(5);
+
+	CPUSkinning lSkinning;
+	lSkinning.init(mPositions, mNormals, mPackedBones);
+
+	const vector<mat4f> lIdentity(mBones.size(), mat4f(1.0f));
+	vector<vec3f> lPositions(5), lNormals(5);
+
+	lSkinning.skin(lIdentity.data(), static_cast<unsigned int>(lIdentity.size()), lPositions.data(), lNormals.data());
+
+	for (unsigned int i = 0; i < 5; ++i)
+	{
+		for (unsigned int c = 0; c < 3; ++c)
+		{
+			EXPECT_NEAR(lPositions[i][c], mPositions[i][c], 0.00001f) << "Vertex " << i;
+			EXPECT_NEAR(lNormals[i][c], mNormals[i][c], 0.00001f) << "Vertex " << i;
+		}
+	}
+}
+
+TEST_F (CPUSkinningTest, blendedBones)
+{
+	// An odd number of vertices to check the vertices processed one by one
+	addVertices(1001);
+
+	CPUSkinning lSkinning;
+	lSkinning.init(mPositions, mNormals, mPackedBones);
+
+	JobSystem lJobSystem(4);
+	vector<vec3f> lPositions(mPositions.size()), lNormals(mNormals.size());
+
+	lSkinning.skin(mBones.data(), static_cast<unsigned int>(mBones.size()), lPositions.data(), lNormals.data(), & lJobSystem);
+
+	for (unsigned int i = 0; i < lPositions.size(); ++i)
+	{
+		const vec3f lExpected = expectedPosition(i);
+
+		for (unsigned int c = 0; c < 3; ++c)
+			EXPECT_NEAR(lPositions[i][c], lExpected[c], 0.0001f) << "Vertex " << i;
+	}
+}
+
+TEST_F (CPUSkinningTest, benchmark)
+{
+	addVertices(200000);
+
+	CPUSkinning lSkinning;
+	lSkinning.init(mPositions, mNormals, mPackedBones);
+
+	vector<vec3f> lPositions(mPositions.size()), lNormals(mNormals.size());
+	JobSystem lJobSystem;
+
+	const unsigned int lRepeat = 20;
+
+	for (JobSystem* rJobSystem : { static_cast<JobSystem*>(nullptr), & lJobSystem })
+	{
+		const auto lStart = std::chrono::steady_clock::now();
+
+		for (unsigned int i = 0; i < lRepeat; ++i)
+			lSkinning.skin(mBones.data(), static_cast<unsigned int>(mBones.size()), lPositions.data(), lNormals.data(), rJobSystem);
+
+		const std::chrono::duration<double> lDuration = std::chrono::steady_clock::now() - lStart;
+		const double lVerticesPerSecond = lRepeat * mPositions.size() / lDuration.count();
+
+		std::ostringstream lMessage;
+		lMessage << "CPU skinning on " << (rJobSystem != nullptr ? rJobSystem->threadCount() : 1) << " thread(s): " << lVerticesPerSecond / 1.0e6 << " million vertices per second";
+		TEST_COUT(lMessage.str().c_str());
+
+		EXPECT_GT(lVerticesPerSecond, 0.0);
+	}
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <AnimationClip.hpp>
+#include <AnimationCursor.hpp>
+#include <CompressedClip.hpp>
+
+using std::vector;
+using miniGL::AnimationClip;
+using miniGL::AnimationCursor;
+using miniGL::CompressedClip;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class CompressedClipTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		mClip = AnimationClip(25.0f, 100.0f);
+
+		// A node moving along a straight line and turning around the z axis at constant speed, with a constant scaling
+		AnimationClip::Channel lLinear;
+		lLinear.node = 0;
+
+		// A node following a curve, with a rotation around an arbitrary axis
+		AnimationClip::Channel lCurve;
+		lCurve.node = 1;
+
+		for (unsigned int i = 0; i <= 100; ++i)
+		{
+			const float t = static_cast<float>(i);
+			const float lAngle = t * 0.02f;
+
+			lLinear.positionTimes.push_back(t);
+			lLinear.positions.push_back(vec3f(t * 0.5f, -2.0f, 1.0f + t * 0.1f));
+			lLinear.rotationTimes.push_back(t);
+			lLinear.rotations.push_back(quatf(0.0f, 0.0f, sin(lAngle * 0.5f), cos(lAngle * 0.5f)));
+			lLinear.scalingTimes.push_back(t);
+			lLinear.scalings.push_back(vec3f(1.0f, 1.0f, 1.0f));
+
+			const float lSin = sin(lAngle * 0.5f) / sqrt(3.0f);
+
+			lCurve.positionTimes.push_back(t);
+			lCurve.positions.push_back(vec3f(cos(lAngle), sin(lAngle), t * 0.01f));
+			lCurve.rotationTimes.push_back(t);
+			lCurve.rotations.push_back(quatf(lSin, -lSin, lSin, cos(lAngle * 0.5f)));
+			lCurve.scalingTimes.push_back(t);
+			lCurve.scalings.push_back(vec3f(1.0f + 0.5f * sin(lAngle), 1.0f, 2.0f));
+		}
+
+		mClip.addChannel(std::move(lLinear));
+		mClip.addChannel(std::move(lCurve));
+	}
+
+	virtual void TearDown(void) final {}
+
+public:
+	AnimationClip mClip;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST (CompressedClipConstructor, default)
+{
+	CompressedClip c;
+
+	ASSERT_EQ(c.channelCount(), 0u);
+	ASSERT_EQ(c.keyCount(), 0u);
+}
+
+TEST_F (CompressedClipTest, parameters)
+{
+	CompressedClip c(mClip);
+
+	ASSERT_EQ(c.channelCount(), 2u);
+	EXPECT_EQ(c.channelNode(0), 0u);
+	EXPECT_EQ(c.channelNode(1), 1u);
+	EXPECT_FLOAT_EQ(c.ticksPerSecond(), 25.0f);
+	EXPECT_FLOAT_EQ(c.duration(), 100.0f);
+	EXPECT_FLOAT_EQ(c.animationTime(5.0f), mClip.animationTime(5.0f));
+}
+
+TEST_F (CompressedClipTest, keyReduction)
+{
+	CompressedClip c(mClip);
+
+	// Linear channel: 2 position keys, 2 rotation keys, 1 scaling key. The curve keeps more keys.
+	EXPECT_LT(c.keyCount(), 303u) << "The redundant keys should be removed";
+	EXPECT_LT(c.byteSize() * 10, mClip.byteSize()) << "The memory should drop by an order of magnitude";
+}
+
+TEST_F (CompressedClipTest, samplingWithinTolerance)
+{
+	const CompressedClip::Tolerances lTolerances(0.001f, 0.001f, 0.001f);
+	CompressedClip c(mClip, lTolerances);
+
+	AnimationCursor lCursor(mClip.channelCount());
+	AnimationCursor lCompressedCursor(c.channelCount());
+
+	for (float t = 0.0f; t <= 100.0f; t += 0.37f)
+	{
+		for (unsigned int i = 0; i < c.channelCount(); ++i)
+		{
+			const mat4f lExpected = mClip.localTransform(i, t, lCursor);
+			const mat4f lResult = c.localTransform(i, t, lCompressedCursor);
+
+			for (unsigned int row = 0; row < 3; ++row)
+			{
+				for (unsigned int col = 0; col < 4; ++col)
+					EXPECT_NEAR(lResult(row, col), lExpected(row, col), 0.01f) << "Channel " << i << " at time " << t;
+			}
+		}
+	}
+}
+
+TEST_F (CompressedClipTest, decodedKeys)
+{
+	CompressedClip c(mClip);
+	AnimationCursor lCursor(c.channelCount());
+
+	// The cursor keeps the decoded keys while playing forward, then the clip loops and the time goes backwards
+	vector<float> lTimes;
+
+	for (float t = 0.0f; t <= 100.0f; t += 0.37f)
+		lTimes.push_back(t);
+
+	lTimes.insert(lTimes.end(), {3.0f, 2.9f, 80.0f, 0.0f, 100.0f, 50.0f});
+
+	for (float t : lTimes)
+	{
+		for (unsigned int i = 0; i < c.channelCount(); ++i)
+		{
+			AnimationCursor lFreshCursor(c.channelCount());
+
+			const mat4f lExpected = c.localTransform(i, t, lFreshCursor);
+			const mat4f lResult = c.localTransform(i, t, lCursor);
+
+			for (unsigned int row = 0; row < 3; ++row)
+			{
+				for (unsigned int col = 0; col < 4; ++col)
+					ASSERT_FLOAT_EQ(lResult(row, col), lExpected(row, col)) << "Channel " << i << " at time " << t;
+			}
+		}
+	}
+
+	// A reset forgets the decoded keys
+	lCursor.reset(c.channelCount());
+	EXPECT_EQ(lCursor.decodedKeys(0).rotationKey, ANIMATION_CURSOR_NO_KEY);
+}
+
+TEST (CompressedClipRotation, smallestThree)
+{
+	AnimationClip lClip(1.0f, 1.0f);
+
+	// One key per possible largest component, with a negative largest component to check the sign flip
+	const vector<quatf> lRotations = { quatf(-0.8f, 0.36f, 0.0f, 0.48f), quatf(0.1f, 0.9f, -0.3f, 0.3f), quatf(0.5f, -0.5f, -0.5f, 0.5f), quatf(0.0f, 0.0f, 0.0f, -1.0f) };
+
+	for (unsigned int i = 0; i < lRotations.size(); ++i)
+	{
+		quatf q = lRotations[i];
+		const float lLength = sqrt(q.x() * q.x() + q.y() * q.y() + q.z() * q.z() + q.w() * q.w());
+		q = quatf(q.x() / lLength, q.y() / lLength, q.z() / lLength, q.w() / lLength);
+
+		AnimationClip::Channel lChannel;
+		lChannel.node = i;
+		lChannel.positionTimes = { 0.0f };
+		lChannel.positions = { vec3f(0.0f, 0.0f, 0.0f) };
+		lChannel.rotationTimes = { 0.0f };
+		lChannel.rotations = { q };
+		lChannel.scalingTimes = { 0.0f };
+		lChannel.scalings = { vec3f(1.0f, 1.0f, 1.0f) };
+
+		lClip.addChannel(std::move(lChannel));
+	}
+
+	CompressedClip c(lClip);
+	AnimationCursor lCursor(lClip.channelCount());
+	AnimationCursor lCompressedCursor(c.channelCount());
+
+	for (unsigned int i = 0; i < c.channelCount(); ++i)
+	{
+		const mat4f lExpected = lClip.localTransform(i, 0.0f, lCursor);
+		const mat4f lResult = c.localTransform(i, 0.0f, lCompressedCursor);
+
+		for (unsigned int row = 0; row < 3; ++row)
+		{
+			for (unsigned int col = 0; col < 3; ++col)
+				EXPECT_NEAR(lResult(row, col), lExpected(row, col), 0.001f) << "Rotation " << i;
+		}
+	}
+}
@@ -0,0 +1,355 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Algebra.hpp>
+#include <FrameArena.hpp>
+#include <Camera.hpp>
+#include <DirectionalLight.hpp>
+#include <PointLight.hpp>
+#include <PackedLights.hpp>
+#include <LightClusters.hpp>
+#include <SceneGraph.hpp>
+#include <TransformStore.hpp>
+#include <RenderQueue.hpp>
+#include <AnimationClip.hpp>
+#include <CompressedClip.hpp>
+#include <AnimationCursor.hpp>
+#include <Skeleton.hpp>
+#include <PoseEvaluator.hpp>
+#include <JobSystem.hpp>
+
+using std::vector;
+using std::shared_ptr;
+using std::make_shared;
+using std::uintptr_t;
+using miniGL::FrameArena;
+using miniGL::ArenaAllocator;
+using miniGL::ArenaVector;
+using miniGL::BaseLight;
+using miniGL::DirectionalLight;
+using miniGL::PointLight;
+using miniGL::Camera;
+using miniGL::PackedLights;
+using miniGL::LightClusters;
+using miniGL::SceneGraph;
+using miniGL::SceneNodeHandle;
+using miniGL::TransformStore;
+using miniGL::DrawPacket;
+using miniGL::RenderQueue;
+using miniGL::AnimationClip;
+using miniGL::CompressedClip;
+using miniGL::AnimationCursor;
+using miniGL::Skeleton;
+using miniGL::PoseEvaluator;
+using miniGL::JobSystem;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class FrameArenaTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final {}
+
+	virtual void TearDown(void) final {}
+
+	// Temporary data of a frame similar to the one of a rendering technique
+	static float simulateFrame(FrameArena & pArena, unsigned int pCount)
+	{
+		const ArenaAllocator<mat4f> lAllocator(pArena);
+
+		ArenaVector<mat4f> lMatrices(lAllocator);
+		lMatrices.reserve(pCount);
+
+		for (unsigned int i = 0; i < pCount; ++i)
+			lMatrices.emplace_back(static_cast<float>(i));
+
+		ArenaVector<unsigned int> lIndices(pCount, 0u, lAllocator);
+
+		float lSum = 0.0f;
+
+		for (unsigned int i = 0; i < pCount; ++i)
+		{
+			lIndices[i] = pCount - i - 1;
+			lSum += lMatrices[lIndices[i]](0,0);
+		}
+
+		return lSum;
+	}
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (FrameArenaTest, alignment)
+{
+	FrameArena lArena(256);
+
+	lArena.allocate(1, 1);
+
+	for (std::size_t lAlignment : {4u, 16u, 64u, 256u})
+	{
+		const void* lPointer = lArena.allocate(3, lAlignment);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(lPointer) % lAlignment, 0u);
+	}
+
+	const mat4f* lMatrices = lArena.allocate<mat4f>(4);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(lMatrices) % alignof(mat4f), 0u);
+}
+
+TEST_F (FrameArenaTest, growKeepsAllocations)
+{
+	FrameArena lArena(64);
+
+	unsigned int* lFirst = lArena.allocate<unsigned int>(8);
+
+	for (unsigned int i = 0; i < 8; ++i)
+		lFirst[i] = i;
+
+	// Does not fit in the first block
+	unsigned int* lSecond = lArena.allocate<unsigned int>(1000);
+	lSecond[999] = 42;
+
+	EXPECT_GE(lArena.capacity(), 1000 * sizeof(unsigned int));
+	EXPECT_GE(lArena.used(), 1008 * sizeof(unsigned int));
+
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(lFirst[i], i);
+
+	// After the reset, the same allocations fit in the last block
+	lArena.reset();
+	EXPECT_EQ(lArena.used(), 0u);
+
+	const std::size_t lCapacity = lArena.capacity();
+	lArena.allocate<unsigned int>(8);
+	lArena.allocate<unsigned int>(1000);
+
+	EXPECT_EQ(lArena.capacity(), lCapacity);
+}
+
+TEST_F (FrameArenaTest, nextFrameResets)
+{
+	FrameArena lArena(1024);
+
+	lArena.allocate(100, 4);
+	lArena.allocate(100, 4);
+	EXPECT_GE(lArena.used(), 200u);
+
+	// The arena resets itself on its first allocation of the new frame
+	FrameArena::nextFrame();
+	lArena.allocate(100, 4);
+
+	EXPECT_EQ(lArena.used(), 100u);
+}
+
+TEST_F (FrameArenaTest, localArenas)
+{
+	FrameArena* lMainArena = & FrameArena::local();
+	FrameArena* lOtherArena = nullptr;
+
+	std::thread lThread([& lOtherArena]()
+	{
+		lOtherArena = & FrameArena::local();
+		lOtherArena->allocate<float>(16);
+	});
+
+	lThread.join();
+
+	EXPECT_EQ(& FrameArena::local(), lMainArena);
+	EXPECT_NE(lOtherArena, lMainArena);
+	EXPECT_NE(& FrameArena::frame(), lMainArena);
+}
+
+TEST_F (FrameArenaTest, countsHeapAllocations)
+{
+	const unsigned long long lHeapAllocations = FrameArena::heapAllocations();
+
+	// The tests are built with MINIGL_COUNT_HEAP_ALLOCATIONS, otherwise the counter stays at 0
+	vector<unsigned int> lValues(16, 0u);
+	EXPECT_GT(FrameArena::heapAllocations(), lHeapAllocations);
+	EXPECT_EQ(lValues.size(), 16u);
+}
+
+TEST_F (FrameArenaTest, steadyFramesDoNotAllocate)
+{
+	FrameArena lArena;
+
+	// The first frames grow the block
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		FrameArena::nextFrame();
+		simulateFrame(lArena, 10000);
+	}
+
+	const unsigned long long lHeapAllocations = FrameArena::heapAllocations();
+
+	float lSum = 0.0f;
+
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		FrameArena::nextFrame();
+		lSum += simulateFrame(lArena, 10000);
+	}
+
+	EXPECT_EQ(FrameArena::heapAllocations(), lHeapAllocations);
+	EXPECT_GT(lSum, 0.0f);
+}
+
+TEST_F (FrameArenaTest, steadyApplicationFrame)
+{
+	// The CPU work of a frame of the application split between the jobs: scene graph, transforms, lights, animations and draw packets
+	SceneGraph lGraph;
+	TransformStore lTransforms;
+	vector<SceneNodeHandle> lNodes;
+
+	for (unsigned int i = 0; i < 200; ++i)
+	{
+		lNodes.push_back(lGraph.add(i == 0 ? SceneGraph::invalidHandle() : lNodes[(i - 1) / 4]));
+
+		lTransforms.emplace_back();
+		lTransforms.back().parent(& lGraph, lNodes.back());
+	}
+
+	vector<shared_ptr<BaseLight>> lLights;
+	vector<unsigned int> lIndices;
+
+	lLights.emplace_back(make_shared<DirectionalLight>(vec3f(1.0f, 1.0f, 1.0f), vec3f(0.0f, -2.0f, 0.0f), 0.1f, 0.8f));
+	lIndices.push_back(0);
+
+	for (unsigned int i = 0; i < 64; ++i)
+	{
+		lLights.emplace_back(make_shared<PointLight>(vec3f(1.0f, 0.5f, 0.0f), vec3f(static_cast<float>(i % 8) * 4.0f - 16.0f, 1.0f, static_cast<float>(i / 8) * 4.0f), 0.0f, 1.0f, 1.0f, 0.0f, 2.0f));
+		lIndices.push_back(i + 1);
+	}
+
+	Camera lCamera;
+	lCamera.position(vec3f(0.0f, 2.0f, -10.0f));
+	lCamera.lookAt(vec3f(0.0f, 0.0f, 1.0f));
+	lCamera.up(vec3f(0.0f, 1.0f, 0.0f));
+	lCamera.verticalFoV(radianf(1.0f));
+	lCamera.nearPlane(0.1f);
+	lCamera.farPlane(100.0f);
+	lCamera.frameBufferDimensions(1280, 720);
+
+	PackedLights lPackedLights;
+	LightClusters lClusters;
+	RenderQueue lQueue;
+	vector<DrawPacket> lPackets(lTransforms.size());
+
+	for (unsigned int i = 0; i < lPackets.size(); ++i)
+	{
+		lPackets[i].program = 1 + i % 3;
+		lPackets[i].vao = 1 + i % 17;
+	}
+
+	// A skinned mesh: a chain of bones played by several instances, and one instance posed by the caller
+	Skeleton lSkeleton;
+	AnimationClip lClip(25.0f, 50.0f);
+
+	for (unsigned int i = 0; i < 16; ++i)
+	{
+		const unsigned int lNode = lSkeleton.addNode(static_cast<int>(i) - 1, mat4f(1.0f));
+		lSkeleton.boneNode(lSkeleton.addBone(mat4f(1.0f)), lNode);
+
+		AnimationClip::Channel lChannel;
+		lChannel.node = lNode;
+
+		for (unsigned int j = 0; j <= 10; ++j)
+		{
+			const float t = static_cast<float>(j) * 5.0f;
+
+			lChannel.positionTimes.push_back(t);
+			lChannel.positions.push_back(vec3f(0.0f, 0.1f * t, 0.0f));
+			lChannel.rotationTimes.push_back(t);
+			lChannel.rotations.push_back(quatf(sin(t * 0.01f), 0.0f, 0.0f, cos(t * 0.01f)));
+			lChannel.scalingTimes.push_back(t);
+			lChannel.scalings.push_back(vec3f(1.0f, 1.0f, 1.0f));
+		}
+
+		lClip.addChannel(std::move(lChannel));
+	}
+
+	// The meshes keep their clips compressed, the cursors keep the decoded keys
+	const CompressedClip lCompressedClip(lClip);
+
+	PoseEvaluator lPoses;
+	lPoses.skeleton(& lSkeleton);
+
+	for (unsigned int i = 0; i < 64; ++i)
+		lPoses.addInstance(& lCompressedClip, 0.1f * static_cast<float>(i), 1.0f);
+
+	AnimationCursor lCursor;
+	vector<mat4f> lNodeTransforms;
+	vector<mat4f> lBoneTransforms(lSkeleton.boneCount());
+
+	JobSystem lJobSystem(2);
+	vector<float> lSums(lPackets.size(), 0.0f);
+
+	auto lFrame = [&](unsigned int pFrame)
+	{
+		FrameArena::nextFrame();
+
+		const float lTime = static_cast<float>(pFrame) / 60.0f;
+
+		// Some nodes, one light and the camera move
+		mat4f lLocal(1.0f);
+		lLocal(0,3) = lTime;
+
+		for (unsigned int i = 0; i < lNodes.size(); i += 7)
+			lGraph.local(lNodes[i], lLocal);
+
+		static_cast<PointLight &>(*lLights[1]).position(vec3f(lTime, 1.0f, 0.0f));
+		lCamera.position(vec3f(lTime, 2.0f, -10.0f));
+
+		lGraph.update(& lJobSystem);
+		lTransforms.update(lCamera.viewProjection(), & lJobSystem);
+
+		lPackedLights.pack(lLights, lIndices, 4, 4);
+		lPackedLights.clean();
+		lClusters.build(lCamera.view(), lCamera.projection(), lCamera.nearPlane(), lCamera.farPlane(), lLights, lIndices, & lJobSystem);
+
+		// The animations are evaluated by the jobs, and by the caller with its own workspace
+		lPoses.update(1.0f / 60.0f, & lJobSystem);
+		lSkeleton.pose(lCompressedClip, lCompressedClip.animationTime(lTime), lCursor, lNodeTransforms, lBoneTransforms.data());
+
+		lJobSystem.parallelFor(static_cast<unsigned int>(lSums.size()), [&lSums, &lTransforms](unsigned int pBegin, unsigned int pEnd)
+		{
+			for (unsigned int i = pBegin; i < pEnd; ++i)
+				lSums[i] = lTransforms.world(i)(0,3);
+		});
+
+		// Temporary data of the frame comes from the arena
+		ArenaVector<mat4f> lWorlds(lTransforms.size(), mat4f(1.0f));
+
+		lQueue.clear();
+
+		for (unsigned int i = 0; i < lPackets.size(); ++i)
+		{
+			lPackets[i].depth = static_cast<float>((i * 7 + pFrame) % 100);
+			lWorlds[i] = lTransforms.world(i);
+			lQueue.push(lPackets[i], & lWorlds[i]);
+		}
+
+		lQueue.sort();
+	};
+
+	// The first frames give the containers their final size
+	for (unsigned int i = 0; i < 3; ++i)
+		lFrame(i);
+
+	const unsigned long long lHeapAllocations = FrameArena::heapAllocations();
+
+	for (unsigned int i = 3; i < 13; ++i)
+		lFrame(i);
+
+	EXPECT_EQ(FrameArena::heapAllocations(), lHeapAllocations) << "A steady frame allocated from the heap";
+	EXPECT_EQ(lQueue.size(), lPackets.size());
+	EXPECT_EQ(lPoses.palettes().size(), 64 * lSkeleton.boneCount());
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <Frustum.hpp>
+
+using std::vector;
+using miniGL::Frustum;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class FrustumTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		// Same projection as the Camera class: 90 degrees vertical field of view, square aspect ratio, looking toward +z
+		const float lNear = 1.0f, lFar = 100.0f;
+		const float lOneOverRange = 1.0f / (lNear - lFar);
+
+		mProjection = mat4f(0.0f);
+		mProjection(0,0) = 1.0f;
+		mProjection(1,1) = 1.0f;
+		mProjection(2,2) = (-lNear - lFar) * lOneOverRange;
+		mProjection(2,3) = 2.0f * lFar * lNear * lOneOverRange;
+		mProjection(3,2) = 1.0f;
+	}
+
+	virtual void TearDown(void) final {}
+
+public:
+	mat4f mProjection;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (FrustumTest, planes)
+{
+	Frustum lFrustum(mProjection);
+
+	const vec4f lNear = lFrustum.plane(Frustum::EPlane::NEAR);
+	EXPECT_NEAR(lNear.z(), 1.0f, 0.0001f);
+	EXPECT_NEAR(lNear.w(), -1.0f, 0.0001f);
+
+	const vec4f lFar = lFrustum.plane(Frustum::EPlane::FAR);
+	EXPECT_NEAR(lFar.z(), -1.0f, 0.0001f);
+	EXPECT_NEAR(lFar.w(), 100.0f, 0.001f);
+
+	const vec4f lLeft = lFrustum.plane(Frustum::EPlane::LEFT);
+	EXPECT_NEAR(lLeft.x(), sqrt(0.5f), 0.0001f);
+	EXPECT_NEAR(lLeft.z(), sqrt(0.5f), 0.0001f);
+}
+
+TEST_F (FrustumTest, spheres)
+{
+	Frustum lFrustum(mProjection);
+
+	EXPECT_TRUE(lFrustum.intersectSphere(vec3f(0.0f, 0.0f, 10.0f), 1.0f));
+	EXPECT_FALSE(lFrustum.intersectSphere(vec3f(0.0f, 0.0f, -10.0f), 1.0f));
+	EXPECT_FALSE(lFrustum.intersectSphere(vec3f(0.0f, 0.0f, 120.0f), 1.0f));
+	EXPECT_FALSE(lFrustum.intersectSphere(vec3f(50.0f, 0.0f, 10.0f), 1.0f));
+	EXPECT_TRUE(lFrustum.intersectSphere(vec3f(10.5f, 0.0f, 10.0f), 1.0f));
+	EXPECT_TRUE(lFrustum.intersectSphere(vec3f(0.0f, 0.0f, 0.5f), 1.0f));
+}
+
+TEST_F (FrustumTest, boxes)
+{
+	Frustum lFrustum(mProjection);
+
+	EXPECT_TRUE(lFrustum.intersectAABB(vec3f(-1.0f, -1.0f, 9.0f), vec3f(1.0f, 1.0f, 11.0f)));
+	EXPECT_TRUE(lFrustum.intersectAABB(vec3f(-100.0f, -100.0f, 9.0f), vec3f(100.0f, 100.0f, 11.0f)));
+	EXPECT_FALSE(lFrustum.intersectAABB(vec3f(-1.0f, -1.0f, -11.0f), vec3f(1.0f, 1.0f, -9.0f)));
+	EXPECT_FALSE(lFrustum.intersectAABB(vec3f(20.0f, -1.0f, 9.0f), vec3f(22.0f, 1.0f, 11.0f)));
+}
+
+TEST_F (FrustumTest, cullSpheres)
+{
+	Frustum lFrustum(mProjection);
+
+	// An odd number of spheres to check the spheres tested one by one
+	vector<float> lX, lY, lZ, lRadius;
+
+	for (unsigned int i = 0; i < 1003; ++i)
+	{
+		const float t = static_cast<float>(i);
+
+		lX.push_back(60.0f * sin(t * 1.3f));
+		lY.push_back(60.0f * cos(t * 0.7f));
+		lZ.push_back(70.0f * sin(t * 0.3f) + 40.0f);
+		lRadius.push_back(static_cast<float>(i % 5));
+	}
+
+	vector<unsigned int> lVisible;
+	lFrustum.cullSpheres(lX.data(), lY.data(), lZ.data(), lRadius.data(), static_cast<unsigned int>(lX.size()), lVisible);
+
+	vector<unsigned int> lExpected;
+
+	for (unsigned int i = 0; i < lX.size(); ++i)
+	{
+		if (lFrustum.intersectSphere(vec3f(lX[i], lY[i], lZ[i]), lRadius[i]))
+			lExpected.push_back(i);
+	}
+
+	EXPECT_EQ(lVisible, lExpected);
+	EXPECT_GT(lVisible.size(), 0u);
+	EXPECT_LT(lVisible.size(), lX.size());
+}
+
+TEST_F (FrustumTest, defaultFrustum)
+{
+	Frustum lFrustum;
+
+	EXPECT_TRUE(lFrustum.intersectSphere(vec3f(1000.0f, -1000.0f, 1000.0f), 0.0f));
+	EXPECT_TRUE(lFrustum.intersectAABB(vec3f(-1.0f, -1.0f, -1.0f), vec3f(1.0f, 1.0f, 1.0f)));
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <JobSystem.hpp>
+
+using std::vector;
+using std::atomic;
+using miniGL::JobSystem;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class JobSystemTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final {}
+
+	virtual void TearDown(void) final {}
+
+	// Some arithmetic that the compiler cannot remove
+	static float work(unsigned int pIndex)
+	{
+		float lValue = static_cast<float>(pIndex);
+
+		for (unsigned int i = 0; i < 64; ++i)
+			lValue = std::sqrt(lValue * 1.01f + 1.0f);
+
+		return lValue;
+	}
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (JobSystemTest, parallelFor)
+{
+	JobSystem lJobSystem(4);
+	EXPECT_EQ(lJobSystem.threadCount(), 4u);
+
+	vector<unsigned int> lVisits(10007, 0);
+
+	lJobSystem.parallelFor(static_cast<unsigned int>(lVisits.size()), [& lVisits](unsigned int pBegin, unsigned int pEnd)
+	{
+		for (unsigned int i = pBegin; i < pEnd; ++i)
+			++lVisits[i];
+	});
+
+	for (unsigned int i = 0; i < lVisits.size(); ++i)
+		EXPECT_EQ(lVisits[i], 1u) << "Item " << i;
+
+	// Nothing to do
+	lJobSystem.parallelFor(0, [](unsigned int, unsigned int){ FAIL(); });
+}
+
+TEST_F (JobSystemTest, nestedParallelFor)
+{
+	JobSystem lJobSystem(4);
+	atomic<unsigned int> lSum(0);
+
+	lJobSystem.parallelFor(16, [& lJobSystem, & lSum](unsigned int pBegin, unsigned int pEnd)
+	{
+		for (unsigned int i = pBegin; i < pEnd; ++i)
+		{
+			lJobSystem.parallelFor(100, [& lSum](unsigned int pBegin, unsigned int pEnd){ lSum += pEnd - pBegin; });
+		}
+	});
+
+	EXPECT_EQ(lSum.load(), 1600u);
+}
+
+TEST_F (JobSystemTest, dependencies)
+{
+	JobSystem lJobSystem(4);
+
+	JobSystem::Counter lFirst;
+	JobSystem::Counter lSecond;
+	atomic<unsigned int> lFirstDone(0);
+	atomic<unsigned int> lErrors(0);
+
+	for (unsigned int i = 0; i < 50; ++i)
+	{
+		lJobSystem.schedule([& lFirstDone]()
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			++lFirstDone;
+		}, & lFirst);
+	}
+
+	// Each job of the second group must see all the jobs of the first group done
+	for (unsigned int i = 0; i < 50; ++i)
+	{
+		lJobSystem.schedule([& lFirstDone, & lErrors]()
+		{
+			if (lFirstDone.load() != 50)
+				++lErrors;
+		}, & lSecond, & lFirst);
+	}
+
+	lJobSystem.wait(lSecond);
+
+	EXPECT_TRUE(lFirst.done());
+	EXPECT_EQ(lErrors.load(), 0u);
+
+	// A dependency that is already done does not delay the job
+	JobSystem::Counter lThird;
+	lJobSystem.schedule([](){}, & lThird, & lFirst);
+	lJobSystem.wait(lThird);
+}
+
+TEST_F (JobSystemTest, mainThreadLane)
+{
+	JobSystem lJobSystem(4);
+	JobSystem::Counter lCounter;
+
+	const std::thread::id lMainThread = std::this_thread::get_id();
+	atomic<unsigned int> lWrongThread(0);
+	atomic<unsigned int> lMainThreadJobs(0);
+
+	// The workers schedule jobs on the main thread, like a decoding job asking for an OpenGL upload
+	lJobSystem.parallelFor(20, [& lJobSystem, & lCounter, & lWrongThread, & lMainThreadJobs, lMainThread](unsigned int pBegin, unsigned int pEnd)
+	{
+		for (unsigned int i = pBegin; i < pEnd; ++i)
+		{
+			lJobSystem.scheduleOnMainThread([& lWrongThread, & lMainThreadJobs, lMainThread]()
+			{
+				if (std::this_thread::get_id() != lMainThread)
+					++lWrongThread;
+
+				++lMainThreadJobs;
+			}, & lCounter);
+		}
+	});
+
+	EXPECT_FALSE(lCounter.done());
+
+	lJobSystem.runMainThreadJobs();
+
+	EXPECT_TRUE(lCounter.done());
+	EXPECT_EQ(lMainThreadJobs.load(), 20u);
+	EXPECT_EQ(lWrongThread.load(), 0u);
+}
+
+TEST_F (JobSystemTest, manySmallJobs)
+{
+	const unsigned int lJobCount = 100000;
+	vector<float> lResults(lJobCount, -1.0f);
+
+	// Many more jobs than the queues of the workers hold at once
+	JobSystem lJobSystem(4);
+	JobSystem::Counter lCounter;
+
+	for (unsigned int i = 0; i < lJobCount; ++i)
+		lJobSystem.schedule([& lResults, i](){ lResults[i] = work(i); }, & lCounter);
+
+	lJobSystem.wait(lCounter);
+
+	for (unsigned int i = 0; i < lJobCount; ++i)
+		ASSERT_FLOAT_EQ(lResults[i], work(i)) << "Job " << i;
+}
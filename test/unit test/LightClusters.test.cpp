@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Algebra.hpp>
+#include <Camera.hpp>
+#include <DirectionalLight.hpp>
+#include <PointLight.hpp>
+#include <SpotLight.hpp>
+#include <JobSystem.hpp>
+#include <LightClusters.hpp>
+
+using std::vector;
+using std::shared_ptr;
+using std::make_shared;
+using miniGL::BaseLight;
+using miniGL::DirectionalLight;
+using miniGL::PointLight;
+using miniGL::SpotLight;
+using miniGL::Camera;
+using miniGL::JobSystem;
+using miniGL::LightClusters;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class LightClustersTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		// Same parameters as the camera of the application
+		mCamera.position(vec3f(0.0f, 2.0f, -10.0f));
+		mCamera.lookAt(vec3f(0.0f, 0.0f, 1.0f));
+		mCamera.up(vec3f(0.0f, 1.0f, 0.0f));
+		mCamera.verticalFoV(radianf(1.0f));
+		mCamera.nearPlane(0.1f);
+		mCamera.farPlane(100.0f);
+		mCamera.frameBufferDimensions(1280, 720);
+	}
+
+	virtual void TearDown(void) final {}
+
+	// Point and spot lights in front of the camera, with a reach of a few units
+	void createLights(unsigned int pCount)
+	{
+		std::mt19937 lGenerator(42);
+		std::uniform_real_distribution<float> lX(-30.0f, 30.0f);
+		std::uniform_real_distribution<float> lY(-5.0f, 10.0f);
+		std::uniform_real_distribution<float> lZ(-15.0f, 60.0f);
+		std::uniform_real_distribution<float> lExponential(1.0f, 20.0f);
+
+		mLights.clear();
+		mIndices.clear();
+
+		mLights.emplace_back(make_shared<DirectionalLight>(vec3f(1.0f, 1.0f, 1.0f), vec3f(0.0f, -2.0f, 0.0f), 0.1f, 0.8f));
+		mIndices.push_back(0);
+
+		for (unsigned int i = 0; i < pCount; ++i)
+		{
+			const vec3f lPosition(lX(lGenerator), lY(lGenerator), lZ(lGenerator));
+
+			if (i % 4 == 3)
+				mLights.emplace_back(make_shared<SpotLight>(vec3f(0.0f, 0.0f, 1.0f), lPosition, vec3f(0.0f, -1.0f, 0.0f), 0.0f, 1.0f, 1.0f, 0.0f, lExponential(lGenerator), 30.0f));
+			else
+				mLights.emplace_back(make_shared<PointLight>(vec3f(1.0f, 0.5f, 0.0f), lPosition, 0.0f, 1.0f, 1.0f, 0.0f, lExponential(lGenerator)));
+
+			mIndices.push_back(i + 1);
+		}
+	}
+
+	void build(LightClusters & pClusters, JobSystem* pJobSystem)
+	{
+		pClusters.build(mCamera.view(), mCamera.projection(), mCamera.nearPlane(), mCamera.farPlane(), mLights, mIndices, pJobSystem);
+	}
+
+	Camera mCamera;
+	vector<shared_ptr<BaseLight>> mLights;
+	vector<unsigned int> mIndices;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (LightClustersTest, range)
+{
+	// The contribution of the light falls under LIGHT_CLUSTERS_THRESHOLD at the range
+	const PointLight lLinear(vec3f(1.0f, 1.0f, 1.0f), vec3f(0.0f, 0.0f, 0.0f), 0.0f, 1.0f, 1.0f, 0.1f, 0.0f);
+	EXPECT_NEAR(LightClusters::range(lLinear), 2550.0f, 1.0e-1f);
+
+	const PointLight lExponential(vec3f(1.0f, 0.5f, 0.0f), vec3f(0.0f, 0.0f, 0.0f), 0.5f, 0.5f, 1.0f, 0.0f, 0.01f);
+	EXPECT_NEAR(LightClusters::range(lExponential), std::sqrt(25500.0f), 1.0e-2f);
+
+	// Too dim to light anything
+	const PointLight lBlack(vec3f(0.0f, 0.0f, 0.0f), vec3f(0.0f, 0.0f, 0.0f), 0.0f, 1.0f, 1.0f, 0.1f, 0.0f);
+	EXPECT_FLOAT_EQ(LightClusters::range(lBlack), 0.0f);
+
+	// Not attenuated
+	const PointLight lConstant(vec3f(1.0f, 1.0f, 1.0f), vec3f(0.0f, 0.0f, 0.0f), 0.0f, 1.0f, 1.0f, 0.0f, 0.0f);
+	EXPECT_FLOAT_EQ(LightClusters::range(lConstant), std::numeric_limits<float>::max());
+}
+
+TEST_F (LightClustersTest, lights)
+{
+	createLights(8);
+
+	LightClusters lClusters;
+	build(lClusters, nullptr);
+
+	// The directional light is not in the clusters
+	ASSERT_EQ(lClusters.lights().size(), 8u);
+
+	// The point lights cannot pass the test of the cutoff angle
+	EXPECT_FLOAT_EQ(lClusters.lights()[0].cutoff, -2.0f);
+	EXPECT_FLOAT_EQ(lClusters.lights()[0].diffuseIntensity, 1.0f);
+
+	EXPECT_NEAR(lClusters.lights()[3].cutoff, std::cos(30.0f * 3.14159265f / 180.0f), 1.0e-5f);
+	EXPECT_FLOAT_EQ(lClusters.lights()[3].direction[1], -1.0f);
+	EXPECT_FLOAT_EQ(lClusters.lights()[3].color[2], 1.0f);
+}
+
+TEST_F (LightClustersTest, conservative)
+{
+	createLights(500);
+
+	LightClusters lClusters;
+	build(lClusters, nullptr);
+
+	const mat4f & rView = mCamera.view();
+	const mat4f & rProjection = mCamera.projection();
+	const vector<unsigned int> & rItems = lClusters.items();
+
+	std::mt19937 lGenerator(7);
+	std::uniform_real_distribution<float> lX(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> lY(-5.0f, 10.0f);
+	std::uniform_real_distribution<float> lZ(-10.0f, 60.0f);
+
+	unsigned int lTested = 0;
+
+	// Every light reaching a point must be in the list of the cluster of the point
+	for (unsigned int i = 0; i < 5000; ++i)
+	{
+		const vec3f lPoint(lX(lGenerator), lY(lGenerator), lZ(lGenerator));
+
+		const float lViewX = rView(0,0) * lPoint.x() + rView(0,1) * lPoint.y() + rView(0,2) * lPoint.z() + rView(0,3);
+		const float lViewY = rView(1,0) * lPoint.x() + rView(1,1) * lPoint.y() + rView(1,2) * lPoint.z() + rView(1,3);
+		const float lDepth = rView(2,0) * lPoint.x() + rView(2,1) * lPoint.y() + rView(2,2) * lPoint.z() + rView(2,3);
+
+		const float lNDCX = lViewX * rProjection(0,0) / lDepth;
+		const float lNDCY = lViewY * rProjection(1,1) / lDepth;
+
+		if (lDepth < mCamera.nearPlane() || lDepth > mCamera.farPlane() || std::fabs(lNDCX) > 1.0f || std::fabs(lNDCY) > 1.0f)
+			continue;
+
+		const unsigned int lCluster = lClusters.cluster(lNDCX, lNDCY, lDepth);
+		const unsigned int lFirst = rItems[2 * lCluster];
+		const unsigned int lCount = rItems[2 * lCluster + 1];
+
+		for (unsigned int j = 1; j < mLights.size(); ++j)
+		{
+			const PointLight & rLight = static_cast<const PointLight &>(*mLights[j]);
+			const float lDX = rLight.position().x() - lPoint.x();
+			const float lDY = rLight.position().y() - lPoint.y();
+			const float lDZ = rLight.position().z() - lPoint.z();
+
+			if (std::sqrt(lDX * lDX + lDY * lDY + lDZ * lDZ) > 0.999f * LightClusters::range(rLight))
+				continue;
+
+			bool lFound = false;
+
+			for (unsigned int k = lFirst; k < lFirst + lCount && !lFound; ++k)
+				lFound = rItems[k] == j - 1;
+
+			EXPECT_TRUE(lFound) << "Light " << j - 1 << " is missing from cluster " << lCluster;
+		}
+
+		++lTested;
+	}
+
+	EXPECT_GT(lTested, 500u);
+}
+
+TEST_F (LightClustersTest, parallelBuild)
+{
+	createLights(1000);
+
+	LightClusters lSerial;
+	build(lSerial, nullptr);
+
+	JobSystem lJobSystem(4);
+	LightClusters lParallel;
+	build(lParallel, & lJobSystem);
+
+	EXPECT_EQ(lSerial.items(), lParallel.items());
+
+	// Without light, the clusters are empty
+	mIndices = {0};
+	build(lParallel, & lJobSystem);
+
+	EXPECT_TRUE(lParallel.lights().empty());
+	EXPECT_EQ(lParallel.items().size(), 2u * LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z);
+
+	for (unsigned int i = 1; i < lParallel.items().size(); i += 2)
+		EXPECT_EQ(lParallel.items()[i], 0u);
+}
+
+TEST_F (LightClustersTest, thousandsOfLights)
+{
+	createLights(4096);
+
+	LightClusters lClusters;
+	JobSystem lJobSystem(4);
+	build(lClusters, & lJobSystem);
+
+	const unsigned int lClusterCount = LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z;
+	const unsigned int lListed = static_cast<unsigned int>(lClusters.items().size()) - 2 * lClusterCount;
+
+	// A fragment shades a small part of the lights
+	EXPECT_LT(lListed, lClusterCount * 4096u / 10u);
+}
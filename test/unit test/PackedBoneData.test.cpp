@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <PackedBoneData.hpp>
+#include <VertexBoneData.hpp>
+
+using std::vector;
+using miniGL::PackedBoneData;
+using miniGL::VertexBoneData;
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST (PackedBoneDataTest, strongestBones)
+{
+	// 6 bones on one vertex, only the 4 strongest are kept
+	VertexBoneData<MAX_BONE_INFLUENCES> lBoneData;
+	lBoneData.addBoneData(1, 0.05f);
+	lBoneData.addBoneData(2, 0.3f);
+	lBoneData.addBoneData(3, 0.1f);
+	lBoneData.addBoneData(4, 0.25f);
+	lBoneData.addBoneData(5, 0.02f);
+	lBoneData.addBoneData(6, 0.2f);
+
+	PackedBoneData lPacked;
+	lPacked.pack(vector<VertexBoneData<MAX_BONE_INFLUENCES>>(1, lBoneData), 4, 10);
+
+	EXPECT_EQ(lPacked.vertexCount(), 1u);
+	EXPECT_EQ(lPacked.indexBits(), 8u);
+	EXPECT_EQ(lPacked.wordsPerVertex(), 2u);
+
+	const unsigned int lIDs[4] = { 2, 4, 6, 3 };
+	const float lSum = 0.3f + 0.25f + 0.2f + 0.1f;
+	const float lWeights[4] = { 0.3f / lSum, 0.25f / lSum, 0.2f / lSum, 0.1f / lSum };
+
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(lPacked.id(0, i), lIDs[i]);
+		EXPECT_NEAR(lPacked.weight(0, i), lWeights[i], 1.0f / 255.0f);
+	}
+}
+
+TEST (PackedBoneDataTest, normalizedWeights)
+{
+	vector<VertexBoneData<MAX_BONE_INFLUENCES>> lBones(100);
+
+	for (unsigned int i = 0; i < lBones.size(); ++i)
+	{
+		for (unsigned int j = 0; j < i % MAX_BONE_INFLUENCES + 1; ++j)
+			lBones[i].addBoneData((i + j) % 32, 0.1f + 0.37f * static_cast<float>((i * 7 + j * 3) % 11));
+	}
+
+	for (unsigned int lInfluences : { 4u, 8u })
+	{
+		PackedBoneData lPacked;
+		lPacked.pack(lBones, lInfluences, 32);
+
+		// The quantized weights still sum exactly to 1
+		for (unsigned int i = 0; i < lPacked.vertexCount(); ++i)
+		{
+			unsigned int lSum = 0;
+
+			for (unsigned int j = 0; j < lInfluences; ++j)
+				lSum += static_cast<unsigned int>(lPacked.weight(i, j) * 255.0f + 0.5f);
+
+			EXPECT_EQ(lSum, 255u) << "Vertex " << i;
+		}
+	}
+}
+
+TEST (PackedBoneDataTest, largeSkeleton)
+{
+	vector<VertexBoneData<MAX_BONE_INFLUENCES>> lBones(3);
+
+	for (unsigned int i = 0; i < lBones.size(); ++i)
+	{
+		for (unsigned int j = 0; j < MAX_BONE_INFLUENCES; ++j)
+			lBones[i].addBoneData(300 + i * 100 + j, 1.0f + static_cast<float>(j));
+	}
+
+	PackedBoneData lPacked;
+	lPacked.pack(lBones, 8, 600);
+
+	EXPECT_EQ(lPacked.indexBits(), 16u);
+	EXPECT_EQ(lPacked.wordsPerVertex(), 8u);
+
+	for (unsigned int i = 0; i < lBones.size(); ++i)
+	{
+		for (unsigned int j = 0; j < MAX_BONE_INFLUENCES; ++j)
+		{
+			// The strongest bone is the last one added
+			EXPECT_EQ(lPacked.id(i, j), 300 + i * 100 + MAX_BONE_INFLUENCES - 1 - j);
+			EXPECT_NEAR(lPacked.weight(i, j), static_cast<float>(MAX_BONE_INFLUENCES - j) / 36.0f, 1.0f / 65535.0f);
+		}
+	}
+}
+
+TEST (PackedBoneDataTest, memory)
+{
+	vector<VertexBoneData<MAX_BONE_INFLUENCES>> lBones(1000);
+
+	for (unsigned int i = 0; i < lBones.size(); ++i)
+		lBones[i].addBoneData(i % 64, 1.0f);
+
+	PackedBoneData lPacked;
+	lPacked.pack(lBones, 4, 64);
+
+	// 4 int IDs and 4 float weights per vertex before packing
+	EXPECT_EQ(lPacked.byteSize() * 4, lBones.size() * sizeof(VertexBoneData<4>));
+
+	lPacked.clear();
+	EXPECT_EQ(lPacked.vertexCount(), 0u);
+	EXPECT_EQ(lPacked.byteSize(), 0u);
+}
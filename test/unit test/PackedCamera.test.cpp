@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include <Algebra.hpp>
+#include <Camera.hpp>
+#include <Frustum.hpp>
+#include <PackedCamera.hpp>
+
+using miniGL::Camera;
+using miniGL::Frustum;
+using miniGL::PackedCamera;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class PackedCameraTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		// Same parameters as the camera of the application
+		mCamera.position(vec3f(0.0f, 2.0f, -10.0f));
+		mCamera.lookAt(vec3f(0.0f, 0.0f, 1.0f));
+		mCamera.up(vec3f(0.0f, 1.0f, 0.0f));
+		mCamera.verticalFoV(radianf(1.0f));
+		mCamera.nearPlane(0.1f);
+		mCamera.farPlane(100.0f);
+		mCamera.frameBufferDimensions(1280, 720);
+	}
+
+	virtual void TearDown(void) final {}
+
+	static void expectNear(const mat4f & pLeft, const mat4f & pRight, float pTolerance)
+	{
+		for (unsigned int i = 0; i < 4; ++i)
+			for (unsigned int j = 0; j < 4; ++j)
+				EXPECT_NEAR(pLeft(i,j), pRight(i,j), pTolerance);
+	}
+
+	Camera mCamera;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (PackedCameraTest, std140Layout)
+{
+	// Offsets of the members of the CameraBlock uniform block with the std140 layout
+	EXPECT_EQ(offsetof(PackedCamera::Block, viewProjection), 128u);
+	EXPECT_EQ(offsetof(PackedCamera::Block, inverseViewProjection), 320u);
+	EXPECT_EQ(offsetof(PackedCamera::Block, eyePosition), 384u);
+	EXPECT_EQ(offsetof(PackedCamera::Block, frustumPlanes), 400u);
+	EXPECT_EQ(offsetof(PackedCamera::Block, viewport), 496u);
+	EXPECT_EQ(offsetof(PackedCamera::Block, time), 512u);
+}
+
+TEST_F (PackedCameraTest, packedValues)
+{
+	PackedCamera lPacked;
+	EXPECT_TRUE(lPacked.pack(mCamera, 1280, 720, 1.5f));
+
+	const PackedCamera::Block & rBlock = lPacked.block();
+
+	// The view projection matrix is cached by the camera
+	const mat4f lViewProjection = mCamera.projection() * mCamera.view();
+	expectNear(rBlock.viewProjection, lViewProjection, 1.0e-6f);
+	EXPECT_EQ(& mCamera.viewProjection(), & mCamera.viewProjection());
+
+	expectNear(rBlock.inverseViewProjection * lViewProjection, mat4f(1.0f), 1.0e-4f);
+	expectNear(rBlock.inverseView * mCamera.view(), mat4f(1.0f), 1.0e-4f);
+
+	EXPECT_FLOAT_EQ(rBlock.eyePosition[1], 2.0f);
+	EXPECT_FLOAT_EQ(rBlock.eyePosition[2], -10.0f);
+	EXPECT_FLOAT_EQ(rBlock.eyePosition[3], 1.0f);
+	EXPECT_FLOAT_EQ(rBlock.viewport[2], 1280.0f);
+	EXPECT_FLOAT_EQ(rBlock.viewport[3], 720.0f);
+	EXPECT_FLOAT_EQ(rBlock.time, 1.5f);
+
+	// Same planes as the frustum used to cull the meshes
+	const Frustum lFrustum(lViewProjection);
+	const vec4f lNear = lFrustum.plane(Frustum::EPlane::NEAR);
+
+	for (unsigned int i = 0; i < 4; ++i)
+		EXPECT_FLOAT_EQ(rBlock.frustumPlanes[static_cast<unsigned int>(Frustum::EPlane::NEAR)][i], lNear[i]);
+}
+
+TEST_F (PackedCameraTest, dirtyRange)
+{
+	PackedCamera lPacked;
+
+	// Everything is uploaded the first time
+	EXPECT_EQ(lPacked.dirtyOffset(), 0u);
+	EXPECT_EQ(lPacked.dirtySize(), sizeof(PackedCamera::Block));
+
+	lPacked.pack(mCamera, 1280, 720, 1.0f);
+	lPacked.clean();
+
+	EXPECT_FALSE(lPacked.pack(mCamera, 1280, 720, 1.0f));
+	EXPECT_EQ(lPacked.dirtySize(), 0u);
+
+	// The camera did not move, only the time changed
+	EXPECT_TRUE(lPacked.pack(mCamera, 1280, 720, 2.0f));
+	EXPECT_EQ(lPacked.dirtyOffset(), offsetof(PackedCamera::Block, time));
+	EXPECT_EQ(lPacked.dirtySize(), sizeof(float));
+
+	// Moving the camera changes the matrices, the planes and the eye position
+	lPacked.clean();
+	mCamera.position(vec3f(1.0f, 2.0f, -10.0f));
+
+	EXPECT_TRUE(lPacked.pack(mCamera, 1280, 720, 2.0f));
+	EXPECT_EQ(lPacked.dirtyOffset(), 0u);
+	EXPECT_EQ(lPacked.dirtySize(), offsetof(PackedCamera::Block, viewport));
+	EXPECT_FLOAT_EQ(lPacked.block().eyePosition[0], 1.0f);
+}
+
+TEST_F (PackedCameraTest, steadyFrames)
+{
+	PackedCamera lPacked;
+
+	std::size_t lUploaded = 0;
+
+	// The camera moves every 100 frames
+	for (unsigned int i = 0; i < 10000; ++i)
+	{
+		if (i % 100 == 0)
+			mCamera.position(vec3f(static_cast<float>(i), 2.0f, -10.0f));
+
+		lPacked.pack(mCamera, 1280, 720, static_cast<float>(i) / 60.0f);
+		lUploaded += lPacked.dirtySize();
+		lPacked.clean();
+	}
+
+	// Only the time changes in most frames
+	EXPECT_LT(lUploaded, 10000 * sizeof(PackedCamera::Block) / 10);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <Algebra.hpp>
+#include <DirectionalLight.hpp>
+#include <PointLight.hpp>
+#include <SpotLight.hpp>
+#include <PackedLights.hpp>
+
+using std::vector;
+using std::shared_ptr;
+using std::make_shared;
+using miniGL::BaseLight;
+using miniGL::DirectionalLight;
+using miniGL::PointLight;
+using miniGL::SpotLight;
+using miniGL::PackedLights;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class PackedLightsTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		// Same lights as the simple lighting scene: 1 directional light, 2 point lights, 1 spot light
+		mLights.emplace_back(make_shared<DirectionalLight>(vec3f(1.0f, 1.0f, 1.0f), vec3f(0.0f, -2.0f, 0.0f), 0.1f, 0.8f));
+		mLights.emplace_back(make_shared<PointLight>(vec3f(1.0f, 0.0f, 0.0f), vec3f(1.0f, 2.0f, 3.0f), 0.2f, 0.5f, 1.0f, 0.1f, 0.01f));
+		mLights.emplace_back(make_shared<PointLight>(vec3f(0.0f, 1.0f, 0.0f), vec3f(-1.0f, 2.0f, -3.0f), 0.2f, 0.5f, 1.0f, 0.1f, 0.01f));
+		mLights.emplace_back(make_shared<SpotLight>(vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 5.0f, 0.0f), vec3f(0.0f, 0.0f, -3.0f), 0.1f, 0.9f, 1.0f, 0.0f, 0.0f, 60.0f));
+
+		mIndices = {0, 1, 2, 3};
+	}
+
+	virtual void TearDown(void) final {}
+
+	PointLight & pointLight(unsigned int pIndex)
+	{
+		return static_cast<PointLight &>(*mLights[pIndex]);
+	}
+
+	vector<shared_ptr<BaseLight>> mLights;
+	vector<unsigned int> mIndices;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (PackedLightsTest, std140Layout)
+{
+	// Offsets of the members of the LightBlock uniform block with the std140 layout
+	EXPECT_EQ(offsetof(PackedLights::DirectionalLightData, direction), 32u);
+	EXPECT_EQ(offsetof(PackedLights::PointLightData, constant), 32u);
+	EXPECT_EQ(offsetof(PackedLights::PointLightData, position), 48u);
+	EXPECT_EQ(offsetof(PackedLights::SpotLightData, direction), 64u);
+	EXPECT_EQ(offsetof(PackedLights::SpotLightData, cutoff), 76u);
+
+	EXPECT_EQ(offsetof(PackedLights::Block, pointLights), 48u);
+	EXPECT_EQ(offsetof(PackedLights::Block, spotLights), 304u);
+	EXPECT_EQ(offsetof(PackedLights::Block, pointLightCount), 624u);
+	EXPECT_EQ(offsetof(PackedLights::Block, spotLightCount), 628u);
+}
+
+TEST_F (PackedLightsTest, packedValues)
+{
+	PackedLights lPacked;
+	EXPECT_TRUE(lPacked.pack(mLights, mIndices, 4, 4));
+
+	const PackedLights::Block & rBlock = lPacked.block();
+
+	EXPECT_EQ(rBlock.pointLightCount, 2);
+	EXPECT_EQ(rBlock.spotLightCount, 1);
+
+	// The directions are normalized
+	EXPECT_FLOAT_EQ(rBlock.directionalLight.direction[1], -1.0f);
+	EXPECT_FLOAT_EQ(rBlock.directionalLight.diffuseIntensity, 0.8f);
+	EXPECT_FLOAT_EQ(rBlock.spotLights[0].direction[2], -1.0f);
+
+	// The shaders compare the cosine of the cutoff angle
+	EXPECT_NEAR(rBlock.spotLights[0].cutoff, 0.5f, 1.0e-6f);
+
+	EXPECT_FLOAT_EQ(rBlock.pointLights[1].color[1], 1.0f);
+	EXPECT_FLOAT_EQ(rBlock.pointLights[1].position[2], -3.0f);
+	EXPECT_FLOAT_EQ(rBlock.pointLights[1].exponential, 0.01f);
+	EXPECT_FLOAT_EQ(rBlock.spotLights[0].base.position[1], 5.0f);
+}
+
+TEST_F (PackedLightsTest, counts)
+{
+	PackedLights lPacked;
+
+	// The program uses at most 1 point light and no spot light
+	lPacked.pack(mLights, mIndices, 1, 0);
+	EXPECT_EQ(lPacked.block().pointLightCount, 1);
+	EXPECT_EQ(lPacked.block().spotLightCount, 0);
+	EXPECT_FLOAT_EQ(lPacked.block().pointLights[0].color[0], 1.0f);
+
+	// Without directional light, its slot is black
+	lPacked.pack(mLights, {1, 3}, 4, 4);
+	EXPECT_EQ(lPacked.block().pointLightCount, 1);
+	EXPECT_EQ(lPacked.block().spotLightCount, 1);
+	EXPECT_FLOAT_EQ(lPacked.block().directionalLight.color[0], 0.0f);
+	EXPECT_FLOAT_EQ(lPacked.block().directionalLight.diffuseIntensity, 0.0f);
+}
+
+TEST_F (PackedLightsTest, dirtyRange)
+{
+	PackedLights lPacked;
+
+	// Everything is uploaded the first time
+	EXPECT_EQ(lPacked.dirtyOffset(), 0u);
+	EXPECT_EQ(lPacked.dirtySize(), sizeof(PackedLights::Block));
+
+	lPacked.pack(mLights, mIndices, 4, 4);
+	lPacked.clean();
+
+	// Same lights, nothing to upload
+	EXPECT_FALSE(lPacked.pack(mLights, mIndices, 4, 4));
+	EXPECT_EQ(lPacked.dirtySize(), 0u);
+
+	// Only the slot of the second point light changed
+	pointLight(2).position()[0] = 10.0f;
+
+	EXPECT_TRUE(lPacked.pack(mLights, mIndices, 4, 4));
+	EXPECT_EQ(lPacked.dirtyOffset(), offsetof(PackedLights::Block, pointLights) + sizeof(PackedLights::PointLightData));
+	EXPECT_EQ(lPacked.dirtySize(), sizeof(PackedLights::PointLightData));
+
+	// Removing a light only changes the counts
+	lPacked.clean();
+	lPacked.pack(mLights, {0, 1, 2}, 4, 4);
+	EXPECT_EQ(lPacked.dirtyOffset(), offsetof(PackedLights::Block, spotLightCount));
+	EXPECT_EQ(lPacked.dirtySize(), sizeof(int));
+}
+
+TEST_F (PackedLightsTest, steadyFrames)
+{
+	PackedLights lPacked;
+	lPacked.pack(mLights, mIndices, 4, 4);
+	lPacked.clean();
+
+	std::size_t lUploaded = 0;
+
+	// One light moves every 10 frames, the others do not move
+	for (unsigned int i = 0; i < 10000; ++i)
+	{
+		if (i % 10 == 0)
+			pointLight(1).position()[1] = static_cast<float>(i);
+
+		lPacked.pack(mLights, mIndices, 4, 4);
+		lUploaded += lPacked.dirtySize();
+		lPacked.clean();
+	}
+
+	// Only the moving light is uploaded
+	EXPECT_EQ(lUploaded, 1000 * sizeof(PackedLights::PointLightData));
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <AnimationClip.hpp>
+#include <LocalPose.hpp>
+#include <PoseBlending.hpp>
+
+using std::vector;
+using miniGL::AnimationClip;
+using miniGL::LocalPose;
+using miniGL::PoseBlending;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class PoseBlendingTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		// 7 nodes: 4 are blended with SIMD instructions (when available) and 3 with scalar code
+		mFrom.resize(7);
+		mTo.resize(7);
+
+		for (unsigned int i = 0; i < 7; ++i)
+		{
+			const float lAngle = 0.3f * static_cast<float>(i);
+
+			mFrom.transform(i, vec3f(static_cast<float>(i), 0.0f, 1.0f), axisAngle(vec3f(0.0f, 0.0f, 1.0f), lAngle), vec3f(1.0f, 1.0f, 1.0f));
+			mTo.transform(i, vec3f(0.0f, static_cast<float>(i), -1.0f), axisAngle(vec3f(1.0f, 1.0f, 0.0f), -lAngle - 0.5f), vec3f(2.0f, 1.0f, 0.5f));
+		}
+	}
+
+	virtual void TearDown(void) final {}
+
+	static quatf axisAngle(const vec3f & pAxis, float pAngle)
+	{
+		const float lLength = static_cast<float>(pAxis.length());
+		const float lSin = sin(pAngle * 0.5f) / lLength;
+
+		return quatf(pAxis.x() * lSin, pAxis.y() * lSin, pAxis.z() * lSin, cos(pAngle * 0.5f));
+	}
+
+	static void expectNear(const mat4f & pResult, const mat4f & pExpected, float pTolerance, unsigned int pNode)
+	{
+		for (unsigned int row = 0; row < 3; ++row)
+		{
+			for (unsigned int col = 0; col < 4; ++col)
+				EXPECT_NEAR(pResult(row, col), pExpected(row, col), pTolerance) << "Node " << pNode;
+		}
+	}
+
+public:
+	LocalPose mFrom;
+	LocalPose mTo;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST (LocalPoseTransform, matrixDecomposition)
+{
+	LocalPose lPose;
+	lPose.resize(1);
+
+	const mat4f lExpected = AnimationClip::compose(vec3f(1.0f, -2.0f, 3.0f), PoseBlendingTest::axisAngle(vec3f(1.0f, 2.0f, -1.0f), 2.5f), vec3f(0.5f, 2.0f, 1.5f));
+	lPose.transform(0, lExpected);
+
+	PoseBlendingTest::expectNear(lPose.transform(0), lExpected, 0.0001f, 0);
+}
+
+TEST (LocalPoseResize, keepNodes)
+{
+	LocalPose lPose;
+	lPose.resize(2);
+	lPose.transform(1, vec3f(1.0f, 2.0f, 3.0f), quatf(0.0f, 1.0f, 0.0f, 0.0f), vec3f(4.0f, 5.0f, 6.0f));
+	lPose.resize(5);
+
+	ASSERT_EQ(lPose.nodeCount(), 5u);
+	EXPECT_FLOAT_EQ(lPose.translation(1).z(), 3.0f);
+	EXPECT_FLOAT_EQ(lPose.rotation(1).y(), 1.0f);
+	EXPECT_FLOAT_EQ(lPose.scaling(1).x(), 4.0f);
+	EXPECT_FLOAT_EQ(lPose.rotation(4).w(), 1.0f);
+	EXPECT_FLOAT_EQ(lPose.scaling(4).y(), 1.0f);
+}
+
+TEST_F (PoseBlendingTest, crossfadeLimits)
+{
+	LocalPose lResult;
+
+	PoseBlending::crossfade(mFrom, mTo, 0.0f, lResult);
+
+	for (unsigned int i = 0; i < 7; ++i)
+		expectNear(lResult.transform(i), mFrom.transform(i), 0.0001f, i);
+
+	PoseBlending::crossfade(mFrom, mTo, 1.0f, lResult);
+
+	for (unsigned int i = 0; i < 7; ++i)
+		expectNear(lResult.transform(i), mTo.transform(i), 0.0001f, i);
+}
+
+TEST_F (PoseBlendingTest, crossfadeHalfway)
+{
+	LocalPose lResult;
+	PoseBlending::crossfade(mFrom, mTo, 0.5f, lResult);
+
+	for (unsigned int i = 0; i < 7; ++i)
+	{
+		const mat4f lExpected = AnimationClip::compose((mFrom.translation(i) + mTo.translation(i)) * 0.5f,
+													   AnimationClip::slerp(mFrom.rotation(i), mTo.rotation(i), 0.5f),
+													   (mFrom.scaling(i) + mTo.scaling(i)) * 0.5f);
+
+		// Halfway between two rotations, the normalized linear interpolation matches the spherical one
+		expectNear(lResult.transform(i), lExpected, 0.001f, i);
+	}
+}
+
+TEST_F (PoseBlendingTest, crossfadeMask)
+{
+	const vector<float> lMask = { 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f };
+	const LocalPose lFrom = mFrom;
+
+	// The result is one of the input poses
+	PoseBlending::crossfade(mFrom, mTo, 1.0f, mFrom, lMask.data());
+
+	for (unsigned int i = 0; i < 7; ++i)
+		expectNear(mFrom.transform(i), lMask[i] > 0.0f ? mTo.transform(i) : lFrom.transform(i), 0.0001f, i);
+}
+
+TEST_F (PoseBlendingTest, additive)
+{
+	// With the identity as reference, the additive pose is applied on top of the base pose
+	LocalPose lReference;
+	lReference.resize(7);
+
+	LocalPose lResult;
+	PoseBlending::additive(mFrom, mTo, lReference, 1.0f, lResult);
+
+	for (unsigned int i = 0; i < 7; ++i)
+	{
+		const mat4f lRotation = AnimationClip::compose(vec3f(0.0f, 0.0f, 0.0f), mFrom.rotation(i), vec3f(1.0f, 1.0f, 1.0f)) * AnimationClip::compose(vec3f(0.0f, 0.0f, 0.0f), mTo.rotation(i), vec3f(1.0f, 1.0f, 1.0f));
+		const mat4f lResultRotation = AnimationClip::compose(vec3f(0.0f, 0.0f, 0.0f), lResult.rotation(i), vec3f(1.0f, 1.0f, 1.0f));
+
+		expectNear(lResultRotation, lRotation, 0.0001f, i);
+		EXPECT_NEAR(lResult.translation(i).y(), mFrom.translation(i).y() + mTo.translation(i).y(), 0.0001f);
+		EXPECT_NEAR(lResult.scaling(i).x(), mFrom.scaling(i).x() * mTo.scaling(i).x(), 0.0001f);
+	}
+
+	// Adding the difference between a pose and itself does not change the base pose
+	PoseBlending::additive(mFrom, mTo, mTo, 0.7f, lResult);
+
+	for (unsigned int i = 0; i < 7; ++i)
+		expectNear(lResult.transform(i), mFrom.transform(i), 0.0001f, i);
+}
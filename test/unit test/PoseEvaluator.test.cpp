@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <AnimationClip.hpp>
+#include <CompressedClip.hpp>
+#include <AnimationCursor.hpp>
+#include <JobSystem.hpp>
+#include <Skeleton.hpp>
+#include <PoseEvaluator.hpp>
+
+using std::vector;
+using miniGL::AnimationClip;
+using miniGL::CompressedClip;
+using miniGL::AnimationCursor;
+using miniGL::JobSystem;
+using miniGL::Skeleton;
+using miniGL::PoseEvaluator;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class PoseEvaluatorTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		// A chain of 3 nodes, one bone per node
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			mat4f lTransform(1.0f);
+			lTransform(1,3) = 1.0f;
+
+			mat4f lOffset(1.0f);
+			lOffset(1,3) = -static_cast<float>(i);
+
+			const unsigned int lNode = mSkeleton.addNode(static_cast<int>(i) - 1, lTransform);
+			mSkeleton.boneNode(mSkeleton.addBone(lOffset), lNode);
+		}
+
+		// Two clips animating the last 2 nodes at different rates, compressed like the clips of the meshes
+		for (unsigned int c = 0; c < 2; ++c)
+		{
+			AnimationClip lClip(25.0f, 50.0f);
+
+			for (unsigned int lNode = 1; lNode < 3; ++lNode)
+			{
+				AnimationClip::Channel lChannel;
+				lChannel.node = lNode;
+
+				for (unsigned int i = 0; i <= 10; ++i)
+				{
+					const float t = static_cast<float>(i) * 5.0f;
+					const float lAngle = t * 0.05f * static_cast<float>(c + lNode);
+
+					lChannel.positionTimes.push_back(t);
+					lChannel.positions.push_back(vec3f(0.1f * t, 1.0f, 0.0f));
+					lChannel.rotationTimes.push_back(t);
+					lChannel.rotations.push_back(quatf(sin(lAngle * 0.5f), 0.0f, 0.0f, cos(lAngle * 0.5f)));
+					lChannel.scalingTimes.push_back(t);
+					lChannel.scalings.push_back(vec3f(1.0f, 1.0f + 0.01f * t, 1.0f));
+				}
+
+				lClip.addChannel(std::move(lChannel));
+			}
+
+			mClips.emplace_back(lClip);
+		}
+	}
+
+	virtual void TearDown(void) final {}
+
+	// Instances playing both clips with different start times and speeds
+	void addInstances(PoseEvaluator & pEvaluator, unsigned int pCount) const
+	{
+		pEvaluator.skeleton(& mSkeleton);
+
+		for (unsigned int i = 0; i < pCount; ++i)
+			pEvaluator.addInstance(& mClips[i % 2], 0.07f * static_cast<float>(i), 0.5f + 0.25f * static_cast<float>(i % 4));
+	}
+
+	// Compare the palette of each instance with the pose computed by the skeleton
+	void expectSkeletonPoses(PoseEvaluator & pEvaluator) const
+	{
+		vector<mat4f> lNodeTransforms;
+		vector<mat4f> lExpected(mSkeleton.boneCount());
+
+		for (unsigned int i = 0; i < pEvaluator.instanceCount(); ++i)
+		{
+			const PoseEvaluator::Instance & rInstance = pEvaluator.instance(i);
+			AnimationCursor lCursor;
+
+			mSkeleton.pose(*rInstance.clip, rInstance.clip->animationTime(rInstance.time), lCursor, lNodeTransforms, lExpected.data());
+
+			const mat4f* rPalette = pEvaluator.palette(i);
+
+			for (unsigned int j = 0; j < pEvaluator.boneCount(); ++j)
+			{
+				for (unsigned int row = 0; row < 4; ++row)
+				{
+					for (unsigned int col = 0; col < 4; ++col)
+						EXPECT_NEAR(rPalette[j](row, col), lExpected[j](row, col), 1.0e-5f) << "Instance " << i << ", bone " << j;
+				}
+			}
+		}
+	}
+
+public:
+	Skeleton mSkeleton;
+	vector<CompressedClip> mClips;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST (PoseEvaluatorConstructor, default)
+{
+	PoseEvaluator e;
+
+	ASSERT_EQ(e.instanceCount(), 0u);
+	ASSERT_EQ(e.boneCount(), 0u);
+	ASSERT_TRUE(e.palettes().empty());
+}
+
+TEST_F (PoseEvaluatorTest, palettes)
+{
+	PoseEvaluator e;
+	addInstances(e, 5);
+
+	ASSERT_EQ(e.instanceCount(), 5u);
+	ASSERT_EQ(e.boneCount(), 3u);
+	ASSERT_EQ(e.palettes().size(), 15u);
+	EXPECT_EQ(e.palette(2), e.palettes().data() + 6) << "The palette of instance i should start at i * boneCount()";
+}
+
+TEST_F (PoseEvaluatorTest, sameAsSkeleton)
+{
+	PoseEvaluator e;
+	addInstances(e, 37);
+
+	for (unsigned int i = 0; i < 20; ++i)
+	{
+		e.update(0.13f);
+		expectSkeletonPoses(e);
+	}
+}
+
+TEST_F (PoseEvaluatorTest, parallelUpdate)
+{
+	PoseEvaluator lSerial, lParallel;
+	addInstances(lSerial, 1000);
+	addInstances(lParallel, 1000);
+
+	JobSystem lJobSystem(4);
+
+	for (unsigned int i = 0; i < 20; ++i)
+	{
+		lSerial.update(0.13f);
+		lParallel.update(0.13f, & lJobSystem);
+	}
+
+	expectSkeletonPoses(lParallel);
+
+	// Each instance is evaluated by a single thread, the results do not depend on the number of threads
+	ASSERT_EQ(lParallel.palettes().size(), lSerial.palettes().size());
+
+	for (unsigned int i = 0; i < lSerial.palettes().size(); ++i)
+	{
+		for (unsigned int row = 0; row < 4; ++row)
+		{
+			for (unsigned int col = 0; col < 4; ++col)
+				ASSERT_FLOAT_EQ(lParallel.palettes()[i](row, col), lSerial.palettes()[i](row, col)) << "Matrix " << i;
+		}
+	}
+}
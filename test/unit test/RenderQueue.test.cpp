@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <RenderQueue.hpp>
+
+using std::vector;
+using std::uint64_t;
+using miniGL::DrawPacket;
+using miniGL::RenderQueue;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class RenderQueueTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final {}
+
+	virtual void TearDown(void) final {}
+
+	// Packets of a scene with a few programs, many meshes and fewer textures, in random order
+	static vector<DrawPacket> randomPackets(unsigned int pCount, unsigned int pSeed)
+	{
+		std::mt19937 lGenerator(pSeed);
+		std::uniform_int_distribution<unsigned int> lPass(0, 1);
+		std::uniform_int_distribution<GLuint> lProgram(1, 3);
+		std::uniform_int_distribution<GLuint> lVAO(1, 64);
+		std::uniform_int_distribution<GLuint> lTexture(1, 16);
+		std::uniform_real_distribution<float> lDepth(0.1f, 100.0f);
+
+		vector<DrawPacket> lPackets(pCount);
+
+		for (DrawPacket & rPacket : lPackets)
+		{
+			rPacket.pass = lPass(lGenerator);
+			rPacket.program = lProgram(lGenerator);
+			rPacket.vao = lVAO(lGenerator);
+			rPacket.colorTexture = lTexture(lGenerator);
+			rPacket.frontFace = (rPacket.vao % 4 == 0) ? GL_CW : GL_CCW;
+			rPacket.depth = lDepth(lGenerator);
+		}
+
+		return lPackets;
+	}
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (RenderQueueTest, sortKey)
+{
+	DrawPacket lReference;
+	lReference.pass = 1;
+	lReference.program = 2;
+	lReference.vao = 3;
+	lReference.colorTexture = 4;
+	lReference.depth = 10.0f;
+
+	const uint64_t lKey = RenderQueue::sortKey(lReference);
+
+	// Each state dominates all the ones after it
+	DrawPacket lPacket = lReference;
+	lPacket.pass = 0;
+	lPacket.program = 100;
+	EXPECT_LT(RenderQueue::sortKey(lPacket), lKey);
+
+	lPacket = lReference;
+	lPacket.program = 1;
+	lPacket.vao = 100;
+	EXPECT_LT(RenderQueue::sortKey(lPacket), lKey);
+
+	lPacket = lReference;
+	lPacket.frontFace = GL_CW;
+	lPacket.vao = 1;
+	EXPECT_GT(RenderQueue::sortKey(lPacket), lKey);
+
+	lPacket = lReference;
+	lPacket.vao = 2;
+	lPacket.colorTexture = 100;
+	EXPECT_LT(RenderQueue::sortKey(lPacket), lKey);
+
+	lPacket = lReference;
+	lPacket.colorTexture = 3;
+	lPacket.depth = 1000.0f;
+	EXPECT_LT(RenderQueue::sortKey(lPacket), lKey);
+
+	// Front to back, and the packets behind the camera come first
+	lPacket = lReference;
+	lPacket.depth = 5.0f;
+	EXPECT_LT(RenderQueue::sortKey(lPacket), lKey);
+
+	lPacket.depth = -5.0f;
+	DrawPacket lOrigin = lReference;
+	lOrigin.depth = 0.0f;
+	EXPECT_EQ(RenderQueue::sortKey(lPacket), RenderQueue::sortKey(lOrigin));
+}
+
+TEST_F (RenderQueueTest, sort)
+{
+	const vector<DrawPacket> lPackets = randomPackets(5000, 1);
+	vector<mat4f> lMatrices(lPackets.size());
+
+	RenderQueue lQueue;
+
+	for (unsigned int i = 0; i < lPackets.size(); ++i)
+		lQueue.push(lPackets[i], & lMatrices[i]);
+
+	// Same order as a stable sort on the keys
+	vector<unsigned int> lExpected(lPackets.size());
+
+	for (unsigned int i = 0; i < lExpected.size(); ++i)
+		lExpected[i] = i;
+
+	std::stable_sort(lExpected.begin(), lExpected.end(), [& lPackets](unsigned int pA, unsigned int pB)
+	{
+		return RenderQueue::sortKey(lPackets[pA]) < RenderQueue::sortKey(lPackets[pB]);
+	});
+
+	lQueue.sort();
+
+	ASSERT_EQ(lQueue.size(), lPackets.size());
+
+	for (unsigned int i = 0; i < lQueue.size(); ++i)
+	{
+		EXPECT_EQ(& lQueue.packet(i), & lPackets[lExpected[i]]) << "Packet " << i;
+		EXPECT_EQ(lQueue.matrices(i), & lMatrices[lExpected[i]]) << "Packet " << i;
+	}
+
+	// The memory is kept, the queue is empty
+	lQueue.clear();
+	EXPECT_EQ(lQueue.size(), 0u);
+	lQueue.sort();
+}
+
+TEST_F (RenderQueueTest, stateChanges)
+{
+	const vector<DrawPacket> lPackets = randomPackets(10000, 2);
+
+	RenderQueue lQueue;
+
+	for (const DrawPacket & rPacket : lPackets)
+		lQueue.push(rPacket, nullptr);
+
+	const RenderQueue::StateChanges lBefore = lQueue.stateChanges();
+	lQueue.sort();
+	const RenderQueue::StateChanges lAfter = lQueue.stateChanges();
+
+	// At most one change per program in each pass
+	EXPECT_LE(lAfter.programs, 2u * 3u);
+	EXPECT_LE(lAfter.vaos, 2u * 3u * 64u);
+	EXPECT_LT(lAfter.total(), lBefore.total() / 4);
+}
+
+TEST_F (RenderQueueTest, refill)
+{
+	const vector<DrawPacket> lPackets = randomPackets(10000, 3);
+
+	RenderQueue lQueue;
+
+	// The queue keeps its memory from one frame to the next, the keys of the previous frame are not reused
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		lQueue.clear();
+
+		for (const DrawPacket & rPacket : lPackets)
+			lQueue.push(rPacket, nullptr);
+
+		lQueue.sort();
+	}
+
+	ASSERT_EQ(lQueue.size(), lPackets.size());
+
+	for (unsigned int i = 1; i < lQueue.size(); ++i)
+		EXPECT_LE(RenderQueue::sortKey(lQueue.packet(i - 1)), RenderQueue::sortKey(lQueue.packet(i)));
+}
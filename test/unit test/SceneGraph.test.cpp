@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <JobSystem.hpp>
+#include <Transform.hpp>
+#include <TransformStore.hpp>
+#include <SceneGraph.hpp>
+
+using std::vector;
+using miniGL::JobSystem;
+using miniGL::Transform;
+using miniGL::TransformStore;
+using miniGL::SceneGraph;
+using miniGL::SceneNodeHandle;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class SceneGraphTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final {}
+
+	virtual void TearDown(void) final {}
+
+	static mat4f localTransform(unsigned int pIndex)
+	{
+		const float t = static_cast<float>(pIndex % 17);
+
+		Transform lTransform;
+		lTransform.rotation(2.0f * t, -1.0f * t, 0.5f * t);
+		lTransform.translation(0.1f * t, 0.2f, -0.05f * t);
+
+		return lTransform.final();
+	}
+
+	// Each node has pBranching children, added level by level so that the handles are not in breadth-first order
+	void buildTree(unsigned int pCount, unsigned int pBranching)
+	{
+		for (unsigned int i = 0; i < pCount; ++i)
+		{
+			const SceneNodeHandle lParent = i == 0 ? SceneGraph::invalidHandle() : (i - 1) / pBranching;
+			const SceneNodeHandle lNode = mGraph.add(lParent);
+			mGraph.local(lNode, localTransform(i));
+		}
+	}
+
+	// Product of the local transforms from the root, without the scene graph
+	mat4f expectedWorld(SceneNodeHandle pNode) const
+	{
+		mat4f lWorld = mGraph.local(pNode);
+
+		for (SceneNodeHandle lNode = mGraph.parent(pNode); lNode != SceneGraph::invalidHandle(); lNode = mGraph.parent(lNode))
+			lWorld = mGraph.local(lNode) * lWorld;
+
+		return lWorld;
+	}
+
+	static void expectNear(const mat4f & pA, const mat4f & pB, unsigned int pIndex)
+	{
+		for (unsigned int row = 0; row < 4; ++row)
+		{
+			for (unsigned int col = 0; col < 4; ++col)
+				EXPECT_NEAR(pA(row, col), pB(row, col), 0.0001f) << "Node " << pIndex << " (" << row << "," << col << ")";
+		}
+	}
+
+public:
+	SceneGraph mGraph;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (SceneGraphTest, chain)
+{
+	const SceneNodeHandle lRoot = mGraph.add();
+	const SceneNodeHandle lChild = mGraph.add(lRoot);
+	const SceneNodeHandle lGrandChild = mGraph.add(lChild);
+
+	Transform lTransform;
+	lTransform.translation(1.0f, 0.0f, 0.0f);
+	mGraph.local(lRoot, lTransform.final());
+
+	lTransform.translation(0.0f, 2.0f, 0.0f);
+	mGraph.local(lChild, lTransform.final());
+
+	lTransform.translation(0.0f, 0.0f, 3.0f);
+	mGraph.local(lGrandChild, lTransform.final());
+
+	mGraph.update();
+
+	EXPECT_EQ(mGraph.levelCount(), 3u);
+	EXPECT_EQ(mGraph.depth(lGrandChild), 2u);
+	EXPECT_EQ(mGraph.parent(lRoot), SceneGraph::invalidHandle());
+	EXPECT_FLOAT_EQ(mGraph.world(lGrandChild)(0,3), 1.0f);
+	EXPECT_FLOAT_EQ(mGraph.world(lGrandChild)(1,3), 2.0f);
+	EXPECT_FLOAT_EQ(mGraph.world(lGrandChild)(2,3), 3.0f);
+
+	mGraph.clear();
+	EXPECT_EQ(mGraph.size(), 0u);
+}
+
+TEST_F (SceneGraphTest, sameAsProduct)
+{
+	buildTree(500, 3);
+
+	mGraph.update();
+
+	for (unsigned int i = 0; i < mGraph.size(); ++i)
+		expectNear(mGraph.world(i), expectedWorld(i), i);
+}
+
+TEST_F (SceneGraphTest, dirtySubtree)
+{
+	// Root 0, children 1 and 2, grand children 3 and 4 under 1 and 5 and 6 under 2
+	buildTree(7, 2);
+	mGraph.update();
+
+	vector<unsigned int> lVersions;
+
+	for (unsigned int i = 0; i < mGraph.size(); ++i)
+		lVersions.push_back(mGraph.version(i));
+
+	mGraph.local(1, localTransform(42));
+	mGraph.update();
+
+	for (SceneNodeHandle lNode : { 1u, 3u, 4u })
+		EXPECT_NE(mGraph.version(lNode), lVersions[lNode]) << "Node " << lNode;
+
+	for (SceneNodeHandle lNode : { 0u, 2u, 5u, 6u })
+		EXPECT_EQ(mGraph.version(lNode), lVersions[lNode]) << "Node " << lNode;
+
+	for (unsigned int i = 0; i < mGraph.size(); ++i)
+		expectNear(mGraph.world(i), expectedWorld(i), i);
+
+	// A node added after the first update is sorted in its level
+	const SceneNodeHandle lNode = mGraph.add(6);
+	mGraph.local(lNode, localTransform(3));
+	mGraph.update();
+
+	EXPECT_EQ(mGraph.levelCount(), 4u);
+	expectNear(mGraph.world(lNode), expectedWorld(lNode), lNode);
+}
+
+TEST_F (SceneGraphTest, attachedTransforms)
+{
+	const SceneNodeHandle lRoot = mGraph.add();
+	const SceneNodeHandle lChild = mGraph.add(lRoot);
+	mGraph.local(lChild, localTransform(5));
+
+	TransformStore lStore;
+	lStore.emplace_back();
+	lStore.back().translation(1.0f, 2.0f, 3.0f);
+	lStore.back().parent(& mGraph, lChild);
+	lStore.emplace_back();
+	lStore.back().translation(1.0f, 2.0f, 3.0f);
+
+	mGraph.update();
+	lStore.update(mat4f(1.0f));
+
+	Transform lTransform;
+	lTransform.translation(1.0f, 2.0f, 3.0f);
+
+	expectNear(lStore.world(0), mGraph.world(lChild) * lTransform.final(), 0);
+	expectNear(lStore.world(1), lTransform.final(), 1);
+
+	// Moving the root moves the transform, without touching it
+	mGraph.local(lRoot, localTransform(11));
+	mGraph.update();
+	lStore.update(mat4f(1.0f));
+
+	expectNear(lStore.world(0), localTransform(11) * localTransform(5) * lTransform.final(), 0);
+	expectNear(lStore.world(1), lTransform.final(), 1);
+}
+
+TEST_F (SceneGraphTest, parallelUpdate)
+{
+	buildTree(20000, 4);
+
+	JobSystem lJobSystem(4);
+	mGraph.update(& lJobSystem);
+
+	for (unsigned int i = 0; i < mGraph.size(); i += 13)
+		expectNear(mGraph.world(i), expectedWorld(i), i);
+
+	mGraph.local(2, localTransform(7));
+	mGraph.update(& lJobSystem);
+
+	for (unsigned int i = 0; i < mGraph.size(); i += 13)
+		expectNear(mGraph.world(i), expectedWorld(i), i);
+}
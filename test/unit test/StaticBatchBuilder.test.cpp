@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <StaticBatchBuilder.hpp>
+
+using std::vector;
+using miniGL::StaticBatchBuilder;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class StaticBatchBuilderTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		// A unit quad in the xy plane, facing +z, counter clockwise
+		mPositions = { vec3f(0.0f, 0.0f, 0.0f), vec3f(1.0f, 0.0f, 0.0f), vec3f(1.0f, 1.0f, 0.0f), vec3f(0.0f, 1.0f, 0.0f) };
+		mTexCoords = { vec2f(0.0f, 0.0f), vec2f(1.0f, 0.0f), vec2f(1.0f, 1.0f), vec2f(0.0f, 1.0f) };
+		mNormals = { vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 0.0f, 1.0f), vec3f(0.0f, 0.0f, 1.0f) };
+		mIndices = { 0, 1, 2, 0, 2, 3 };
+	}
+
+	virtual void TearDown(void) final {}
+
+	static mat4f translation(float pX, float pY, float pZ)
+	{
+		mat4f lMatrix(1.0f);
+		lMatrix(0,3) = pX;
+		lMatrix(1,3) = pY;
+		lMatrix(2,3) = pZ;
+		return lMatrix;
+	}
+
+	static mat4f scaling(float pX, float pY, float pZ)
+	{
+		mat4f lMatrix(1.0f);
+		lMatrix(0,0) = pX;
+		lMatrix(1,1) = pY;
+		lMatrix(2,2) = pZ;
+		return lMatrix;
+	}
+
+	// Normal of the triangle starting at pFirstIndex, from its winding
+	static vec3f windingNormal(const StaticBatchBuilder & pBuilder, unsigned int pFirstIndex)
+	{
+		const vec3f & rA = pBuilder.positions()[pBuilder.indices()[pFirstIndex]];
+		const vec3f & rB = pBuilder.positions()[pBuilder.indices()[pFirstIndex + 1]];
+		const vec3f & rC = pBuilder.positions()[pBuilder.indices()[pFirstIndex + 2]];
+
+		const vec3f lAB(rB.x() - rA.x(), rB.y() - rA.y(), rB.z() - rA.z());
+		const vec3f lAC(rC.x() - rA.x(), rC.y() - rA.y(), rC.z() - rA.z());
+
+		return vec3f(lAB.y() * lAC.z() - lAB.z() * lAC.y(), lAB.z() * lAC.x() - lAB.x() * lAC.z(), lAB.x() * lAC.y() - lAB.y() * lAC.x());
+	}
+
+	void addQuad(StaticBatchBuilder & pBuilder, const mat4f & pWorld, GLuint pTexture, GLenum pFrontFace = GL_CCW) const
+	{
+		const unsigned int lBaseVertex = pBuilder.addVertices(mPositions.data(), mTexCoords.data(), mNormals.data(), 4, pWorld);
+		pBuilder.addTriangles(mIndices.data(), 6, lBaseVertex, pTexture, pFrontFace);
+	}
+
+	vector<vec3f> mPositions;
+	vector<vec2f> mTexCoords;
+	vector<vec3f> mNormals;
+	vector<unsigned int> mIndices;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (StaticBatchBuilderTest, worldSpaceVertices)
+{
+	StaticBatchBuilder lBuilder;
+
+	addQuad(lBuilder, translation(2.0f, 3.0f, 4.0f) * scaling(2.0f, 2.0f, 2.0f), 1);
+
+	ASSERT_EQ(lBuilder.positions().size(), 4u);
+	EXPECT_NEAR(lBuilder.positions()[2].x(), 4.0f, 0.0001f);
+	EXPECT_NEAR(lBuilder.positions()[2].y(), 5.0f, 0.0001f);
+	EXPECT_NEAR(lBuilder.positions()[2].z(), 4.0f, 0.0001f);
+
+	// The texture coordinates are copied
+	EXPECT_FLOAT_EQ(lBuilder.texCoords()[2].x(), 1.0f);
+	EXPECT_FLOAT_EQ(lBuilder.texCoords()[2].y(), 1.0f);
+
+	// The normals stay unit vectors
+	EXPECT_NEAR(lBuilder.normals()[0].z(), 1.0f, 0.0001f);
+}
+
+TEST_F (StaticBatchBuilderTest, nonUniformScalingNormals)
+{
+	StaticBatchBuilder lBuilder;
+
+	const vec3f lPosition[] = { vec3f(0.0f, 0.0f, 0.0f) };
+	const vec2f lTexCoord[] = { vec2f(0.0f, 0.0f) };
+	const vec3f lNormal[] = { vec3f(sqrt(0.5f), sqrt(0.5f), 0.0f) };
+
+	// Stretching along x flattens a 45 degrees slope, so the normal turns towards y
+	lBuilder.addVertices(lPosition, lTexCoord, lNormal, 1, scaling(2.0f, 1.0f, 1.0f));
+
+	const vec3f & rNormal = lBuilder.normals()[0];
+	EXPECT_NEAR(rNormal.x(), 1.0f / sqrt(5.0f), 0.0001f);
+	EXPECT_NEAR(rNormal.y(), 2.0f / sqrt(5.0f), 0.0001f);
+	EXPECT_NEAR(rNormal.z(), 0.0f, 0.0001f);
+}
+
+TEST_F (StaticBatchBuilderTest, counterClockwiseWinding)
+{
+	StaticBatchBuilder lBuilder;
+
+	// Same front faces for a counter clockwise mesh, a clockwise mesh and a mirrored mesh
+	addQuad(lBuilder, mat4f(1.0f), 1, GL_CCW);
+
+	std::swap(mIndices[1], mIndices[2]);
+	std::swap(mIndices[4], mIndices[5]);
+	addQuad(lBuilder, mat4f(1.0f), 1, GL_CW);
+
+	std::swap(mIndices[1], mIndices[2]);
+	std::swap(mIndices[4], mIndices[5]);
+	addQuad(lBuilder, scaling(-1.0f, 1.0f, 1.0f), 1, GL_CCW);
+
+	ASSERT_EQ(lBuilder.indices().size(), 18u);
+
+	for (unsigned int i = 0; i < 18; i += 3)
+	{
+		const vec3f lFaceNormal = windingNormal(lBuilder, i);
+		const vec3f & rNormal = lBuilder.normals()[lBuilder.indices()[i]];
+
+		EXPECT_GT(lFaceNormal.x() * rNormal.x() + lFaceNormal.y() * rNormal.y() + lFaceNormal.z() * rNormal.z(), 0.0f);
+	}
+}
+
+TEST_F (StaticBatchBuilderTest, rangesByTexture)
+{
+	StaticBatchBuilder lBuilder;
+
+	addQuad(lBuilder, translation(0.0f, 0.0f, 0.0f), 7);
+	addQuad(lBuilder, translation(1.0f, 0.0f, 0.0f), 3);
+	addQuad(lBuilder, translation(2.0f, 0.0f, 0.0f), 7);
+	addQuad(lBuilder, translation(3.0f, 0.0f, 0.0f), 3);
+
+	lBuilder.build();
+
+	const auto & rRanges = lBuilder.ranges();
+	ASSERT_EQ(rRanges.size(), 2u);
+
+	EXPECT_EQ(rRanges[0].texture, 3u);
+	EXPECT_EQ(rRanges[0].firstIndex, 0u);
+	EXPECT_EQ(rRanges[0].indexCount, 12u);
+
+	EXPECT_EQ(rRanges[1].texture, 7u);
+	EXPECT_EQ(rRanges[1].firstIndex, 12u);
+	EXPECT_EQ(rRanges[1].indexCount, 12u);
+
+	// The quads keep their order within a texture, and read their own vertices
+	EXPECT_EQ(lBuilder.indices()[0], 4u);
+	EXPECT_EQ(lBuilder.indices()[6], 12u);
+	EXPECT_EQ(lBuilder.indices()[12], 0u);
+	EXPECT_EQ(lBuilder.indices()[18], 8u);
+
+	// Building again does not change anything
+	const vector<unsigned int> lIndices = lBuilder.indices();
+	lBuilder.build();
+
+	EXPECT_EQ(lBuilder.indices(), lIndices);
+	EXPECT_EQ(lBuilder.ranges().size(), 2u);
+}
+
+TEST_F (StaticBatchBuilderTest, clear)
+{
+	StaticBatchBuilder lBuilder;
+
+	addQuad(lBuilder, scaling(-1.0f, 1.0f, 1.0f), 1);
+	lBuilder.build();
+	lBuilder.clear();
+
+	EXPECT_TRUE(lBuilder.positions().empty());
+	EXPECT_TRUE(lBuilder.indices().empty());
+	EXPECT_TRUE(lBuilder.ranges().empty());
+
+	// The orientation of the previous world matrix is forgotten too
+	lBuilder.addVertices(mPositions.data(), mTexCoords.data(), mNormals.data(), 4, mat4f(1.0f));
+	lBuilder.addTriangles(mIndices.data(), 6, 0, 1, GL_CCW);
+
+	EXPECT_GT(windingNormal(lBuilder, 0).z(), 0.0f);
+}
+
+TEST_F (StaticBatchBuilderTest, manyMeshes)
+{
+	const unsigned int lQuadCount = 10000;
+	const unsigned int lTextureCount = 8;
+
+	StaticBatchBuilder lBuilder;
+
+	for (unsigned int i = 0; i < lQuadCount; ++i)
+		addQuad(lBuilder, translation(static_cast<float>(i), 0.0f, 0.0f), 1 + i % lTextureCount);
+
+	lBuilder.build();
+
+	// One draw call per texture
+	ASSERT_EQ(lBuilder.ranges().size(), lTextureCount);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <JobSystem.hpp>
+#include <Transform.hpp>
+#include <TransformStore.hpp>
+
+using std::vector;
+using miniGL::JobSystem;
+using miniGL::Transform;
+using miniGL::TransformStore;
+
+//===============================================================================================//
+// Test fixtures
+//===============================================================================================//
+
+class TransformStoreTest : public ::testing::Test
+{
+public:
+	virtual void SetUp(void) final
+	{
+		mViewProjection = mat4f(0.0f);
+		mViewProjection(0,0) = 1.5f;
+		mViewProjection(1,1) = 2.0f;
+		mViewProjection(2,2) = 1.02f;
+		mViewProjection(2,3) = -2.02f;
+		mViewProjection(3,2) = 1.0f;
+		mViewProjection(0,3) = 0.5f;
+	}
+
+	virtual void TearDown(void) final {}
+
+	void addTransforms(unsigned int pCount)
+	{
+		for (unsigned int i = 0; i < pCount; ++i)
+		{
+			const float t = static_cast<float>(i);
+
+			Transform lTransform;
+			lTransform.scaling(1.0f + 0.1f * (i % 3), 0.5f, 2.0f);
+			lTransform.rotation(10.0f * t, 3.0f * t, -7.0f * t);
+			lTransform.translation(t, -2.0f * t, 0.5f * t);
+
+			mTransforms.push_back(lTransform);
+			mStore.push_back(lTransform);
+		}
+	}
+
+	static void expectNear(const mat4f & pA, const mat4f & pB, unsigned int pIndex)
+	{
+		for (unsigned int row = 0; row < 4; ++row)
+		{
+			for (unsigned int col = 0; col < 4; ++col)
+				EXPECT_NEAR(pA(row, col), pB(row, col), 0.0001f) << "Transform " << pIndex << " (" << row << "," << col << ")";
+		}
+	}
+
+public:
+	vector<Transform> mTransforms;
+	TransformStore mStore;
+	mat4f mViewProjection;
+};
+
+//===============================================================================================//
+// Tests
+//===============================================================================================//
+
+TEST_F (TransformStoreTest, sameAsTransform)
+{
+	addTransforms(10);
+
+	mStore.update(mViewProjection);
+
+	for (unsigned int i = 0; i < mStore.size(); ++i)
+	{
+		expectNear(mStore.world(i), mTransforms[i].final(), i);
+		expectNear(mStore.WVP(i), mViewProjection * mTransforms[i].final(), i);
+	}
+}
+
+TEST_F (TransformStoreTest, dirtyTransforms)
+{
+	addTransforms(4);
+
+	mStore.update(mViewProjection);
+
+	mStore[2].rotation(0.0f, 45.0f, 0.0f);
+	mTransforms[2].rotation(0.0f, 45.0f, 0.0f);
+
+	EXPECT_FALSE(mStore.dirty(1));
+	EXPECT_TRUE(mStore.dirty(2));
+
+	mStore.update(mViewProjection);
+
+	EXPECT_FALSE(mStore.dirty(2));
+	expectNear(mStore.world(2), mTransforms[2].final(), 2);
+	expectNear(mStore.WVP(2), mViewProjection * mTransforms[2].final(), 2);
+
+	// A new view-projection updates the WVP of all the transforms
+	mViewProjection(0,3) = -3.0f;
+	mStore.update(mViewProjection);
+
+	for (unsigned int i = 0; i < mStore.size(); ++i)
+		expectNear(mStore.WVP(i), mViewProjection * mTransforms[i].final(), i);
+}
+
+TEST_F (TransformStoreTest, references)
+{
+	mStore.emplace_back();
+	mStore.back().scaling(2.0f, 3.0f, 4.0f);
+	mStore.back().translation(1.0f, 2.0f, 3.0f);
+
+	EXPECT_FLOAT_EQ(mStore[0].scaling().y(), 3.0f);
+	EXPECT_FLOAT_EQ(mStore[0].translation().z(), 3.0f);
+	EXPECT_FLOAT_EQ(mStore[0].rotation()(1,1), 1.0f);
+
+	mStore.update(mat4f(1.0f));
+
+	EXPECT_FLOAT_EQ(mStore.world(0)(0,0), 2.0f);
+	EXPECT_FLOAT_EQ(mStore.world(0)(2,2), 4.0f);
+	EXPECT_FLOAT_EQ(mStore.world(0)(1,3), 2.0f);
+	EXPECT_FLOAT_EQ(mStore.world(0)(3,3), 1.0f);
+
+	mStore.clear();
+	EXPECT_EQ(mStore.size(), 0u);
+}
+
+TEST_F (TransformStoreTest, parallelUpdate)
+{
+	addTransforms(5000);
+
+	JobSystem lJobSystem(4);
+	mStore.update(mViewProjection, & lJobSystem);
+
+	for (unsigned int i = 0; i < mStore.size(); i += 7)
+	{
+		expectNear(mStore.world(i), mTransforms[i].final(), i);
+		expectNear(mStore.WVP(i), mViewProjection * mTransforms[i].final(), i);
+	}
+}